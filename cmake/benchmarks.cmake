@@ -0,0 +1,154 @@
+##############################
+# Dependencies
+##############################
+
+set(BENCHMARK_ENABLE_TESTING OFF)
+set(BENCHMARK_ENABLE_GTEST_TESTS OFF)
+set(BENCHMARK_ENABLE_INSTALL OFF)
+FetchContent_Declare(
+    benchmark
+    URL "https://github.com/google/benchmark/archive/refs/tags/v1.8.3.tar.gz"
+    URL_HASH "SHA256=6bc180a57d23d4d9515519f92b0c83d61b05b5bab188961f36ac7b06b0d9e9ce"
+    FIND_PACKAGE_ARGS)
+
+include("${CMAKE_SOURCE_DIR}/cmake/testing_plugins.cmake")
+
+FetchContent_MakeAvailable(benchmark testing-plugins)
+
+
+##############################
+# General Settings
+##############################
+
+set(LOOT_SRC_BENCHMARKS_GUI_CPP_FILES
+"${CMAKE_SOURCE_DIR}/src/benchmarks/gui/main.cpp")
+
+set(LOOT_SRC_BENCHMARKS_GUI_H_FILES
+"${CMAKE_SOURCE_DIR}/src/benchmarks/gui/plugin_item_benchmarks.h"
+"${CMAKE_SOURCE_DIR}/src/benchmarks/gui/qt/card_sizing_cache_benchmarks.h"
+"${CMAKE_SOURCE_DIR}/src/benchmarks/gui/qt/rendering_benchmarks.h"
+"${CMAKE_SOURCE_DIR}/src/benchmarks/gui/query_benchmarks.h"
+"${CMAKE_SOURCE_DIR}/src/benchmarks/gui/state/config_benchmarks.h"
+"${CMAKE_SOURCE_DIR}/src/benchmarks/gui/state/game/detection_benchmarks.h"
+"${CMAKE_SOURCE_DIR}/src/benchmarks/gui/synthetic_game.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/detection/test_registry.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/synthetic_load_order.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/test_helpers.h")
+
+source_group(TREE "${CMAKE_SOURCE_DIR}/src/benchmarks/gui"
+    PREFIX "Header Files"
+    FILES ${LOOT_SRC_BENCHMARKS_GUI_H_FILES})
+
+source_group(TREE "${CMAKE_SOURCE_DIR}/src/benchmarks/gui"
+    PREFIX "Source Files"
+    FILES ${LOOT_SRC_BENCHMARKS_GUI_CPP_FILES})
+
+# The benchmarks use the application's code, but have their own main().
+set(LOOT_BENCHMARKS_GUI_APP_CPP_FILES ${LOOT_SRC_GUI_CPP_FILES})
+list(REMOVE_ITEM LOOT_BENCHMARKS_GUI_APP_CPP_FILES
+    "${CMAKE_SOURCE_DIR}/src/gui/qt/main.cpp")
+
+set(LOOT_GUI_BENCHMARKS_ALL_SOURCES
+    ${LOOT_SRC_BENCHMARKS_GUI_CPP_FILES}
+    ${LOOT_SRC_BENCHMARKS_GUI_H_FILES}
+    ${LOOT_BENCHMARKS_GUI_APP_CPP_FILES}
+    ${LOOT_SRC_GUI_H_FILES}
+    "${CMAKE_BINARY_DIR}/generated/version.cpp"
+    "${CMAKE_SOURCE_DIR}/resources/resources.qrc")
+
+##############################
+# Define Targets
+##############################
+
+# Build application benchmarks.
+add_executable(loot_bench ${LOOT_GUI_BENCHMARKS_ALL_SOURCES})
+target_link_libraries(loot_bench PRIVATE
+    Qt::Widgets Qt::Network Qt::Concurrent
+    Boost::headers Boost::locale
+    benchmark::benchmark
+    spdlog::spdlog_header_only
+    tomlplusplus::tomlplusplus)
+
+##############################
+# Set Target-Specific Flags
+##############################
+
+if(libloot_FOUND)
+    target_link_libraries(loot_bench PRIVATE libloot::loot)
+else()
+    add_dependencies(loot_bench libloot)
+
+    target_include_directories(loot_bench SYSTEM PRIVATE ${LIBLOOT_INCLUDE_DIRS})
+
+    if(CMAKE_SYSTEM_NAME STREQUAL "Windows")
+        target_link_libraries(loot_bench PRIVATE ${LIBLOOT_STATIC_LIBRARY})
+    else()
+        target_link_libraries(loot_bench PRIVATE ${LIBLOOT_SHARED_LIBRARY})
+    endif()
+endif()
+
+if(ZLIB_FOUND)
+    target_link_libraries(loot_bench PRIVATE MINIZIP::minizip ZLIB::ZLIB)
+else()
+    add_dependencies(loot_bench minizip-ng)
+    target_link_libraries(loot_bench PRIVATE ${MINIZIP_NG_LIBRARIES})
+    target_include_directories(loot_bench SYSTEM PRIVATE ${MINIZIP_NG_INCLUDE_DIRS})
+endif()
+
+if(OGDF_FOUND)
+    target_link_libraries(loot_bench PRIVATE OGDF)
+else()
+    add_dependencies(loot_bench OGDF)
+    target_link_libraries(loot_bench PRIVATE ${OGDF_LIBRARIES})
+    target_include_directories(loot_bench SYSTEM PRIVATE ${OGDF_INCLUDE_DIRS})
+endif()
+
+target_include_directories(loot_bench PRIVATE "${CMAKE_SOURCE_DIR}/src")
+
+if(CMAKE_SYSTEM_NAME STREQUAL "Windows")
+    target_compile_definitions(loot_bench PRIVATE
+        UNICODE _UNICODE NOMINMAX BOOST_UUID_FORCE_AUTO_LINK)
+
+    if(NOT CMAKE_HOST_SYSTEM_NAME STREQUAL "Windows")
+        target_compile_definitions(loot_bench PRIVATE LOOT_STATIC)
+
+        target_link_libraries(loot_bench PRIVATE tbb_static bz2)
+    endif()
+else()
+    target_link_libraries(loot_bench PRIVATE X11 ${ICU_TARGETS})
+endif()
+
+if(CMAKE_COMPILER_IS_GNUCXX)
+    set_target_properties(loot_bench
+        PROPERTIES
+            INSTALL_RPATH "${CMAKE_INSTALL_RPATH};."
+            BUILD_WITH_INSTALL_RPATH ON)
+endif()
+
+if(MSVC)
+    target_compile_options(loot_bench PRIVATE "/permissive-" "/W4" "/bigobj")
+endif()
+
+##############################
+# Post-Build Steps
+##############################
+
+if(CMAKE_SYSTEM_NAME STREQUAL "Windows" AND CMAKE_HOST_SYSTEM_NAME STREQUAL "Windows")
+    # Copy Qt binaries and resources.
+    add_custom_command(TARGET loot_bench POST_BUILD
+        COMMAND ${QT_DIR}/bin/windeployqt $<TARGET_FILE:loot_bench>
+        COMMENT "Running windeployqt...")
+endif()
+
+# Copy the API binary to the build directory.
+get_filename_component(LIBLOOT_SHARED_LIBRARY_FILENAME ${LIBLOOT_SHARED_LIBRARY} NAME)
+add_custom_command(TARGET loot_bench POST_BUILD
+    COMMAND ${CMAKE_COMMAND} -E copy_if_different
+        ${LIBLOOT_SHARED_LIBRARY}
+        "$<TARGET_FILE_DIR:loot_bench>/${LIBLOOT_SHARED_LIBRARY_FILENAME}")
+
+# Copy testing plugins
+add_custom_command(TARGET loot_bench POST_BUILD
+    COMMAND ${CMAKE_COMMAND} -E copy_directory
+        ${testing-plugins_SOURCE_DIR}
+        $<TARGET_FILE_DIR:loot_bench>)
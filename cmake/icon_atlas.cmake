@@ -0,0 +1,75 @@
+##############################
+# General Settings
+##############################
+
+# The icons that IconFactory uses, which are all the SVG icons listed in
+# resources.qrc apart from LOOT's own icon.
+file(STRINGS "${CMAKE_SOURCE_DIR}/resources/resources.qrc" LOOT_ICON_ATLAS_QRC_LINES
+    REGEX "<file>icons/.*\\.svg</file>")
+
+set(LOOT_ICON_ATLAS_ICONS "")
+foreach(LINE ${LOOT_ICON_ATLAS_QRC_LINES})
+    string(REGEX REPLACE ".*<file>(.*)</file>.*" "\\1" ICON_PATH "${LINE}")
+    if(NOT ICON_PATH STREQUAL "icons/loot.svg")
+        list(APPEND LOOT_ICON_ATLAS_ICONS "${ICON_PATH}")
+    endif()
+endforeach()
+
+list(TRANSFORM LOOT_ICON_ATLAS_ICONS
+    PREPEND "${CMAKE_SOURCE_DIR}/resources/"
+    OUTPUT_VARIABLE LOOT_ICON_ATLAS_ICON_FILES)
+
+set(LOOT_ICON_ATLAS_DIR "${CMAKE_BINARY_DIR}/generated/icon-atlas")
+set(LOOT_ICON_ATLAS_IMAGE "${LOOT_ICON_ATLAS_DIR}/atlas.png")
+set(LOOT_ICON_ATLAS_INDEX "${LOOT_ICON_ATLAS_DIR}/atlas.json")
+set(LOOT_ICON_ATLAS_QRC "${CMAKE_BINARY_DIR}/generated/icon_atlas.qrc")
+set(LOOT_ICON_ATLAS_RCC_SOURCE "${CMAKE_BINARY_DIR}/generated/icon_atlas_rc.cpp")
+
+file(WRITE "${LOOT_ICON_ATLAS_QRC}"
+"<!DOCTYPE RCC>
+<RCC version=\"1.0\">
+  <qresource prefix=\"/\">
+    <file>icon-atlas/atlas.png</file>
+    <file>icon-atlas/atlas.json</file>
+  </qresource>
+</RCC>
+")
+
+##############################
+# Define Targets
+##############################
+
+# The generator needs to run on the build machine.
+add_executable(loot_icon_atlas_generator
+    "${CMAKE_SOURCE_DIR}/src/tools/icon_atlas_generator.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/qt/icon_atlas.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/qt/icon_atlas.h")
+target_include_directories(loot_icon_atlas_generator PRIVATE "${CMAKE_SOURCE_DIR}/src")
+target_link_libraries(loot_icon_atlas_generator PRIVATE Qt::Gui)
+
+add_custom_command(
+    OUTPUT "${LOOT_ICON_ATLAS_IMAGE}" "${LOOT_ICON_ATLAS_INDEX}"
+    COMMAND ${CMAKE_COMMAND} -E make_directory "${LOOT_ICON_ATLAS_DIR}"
+    COMMAND loot_icon_atlas_generator
+        "${CMAKE_SOURCE_DIR}/resources"
+        "${LOOT_ICON_ATLAS_IMAGE}"
+        "${LOOT_ICON_ATLAS_INDEX}"
+        ${LOOT_ICON_ATLAS_ICONS}
+    DEPENDS loot_icon_atlas_generator ${LOOT_ICON_ATLAS_ICON_FILES}
+    COMMENT "Pre-rendering icon atlas..."
+    VERBATIM)
+
+# The atlas is generated during the build, so compile its resources
+# explicitly instead of relying on AUTORCC, which lists them at configure time.
+add_custom_command(
+    OUTPUT "${LOOT_ICON_ATLAS_RCC_SOURCE}"
+    COMMAND Qt6::rcc
+        --name icon_atlas
+        --output "${LOOT_ICON_ATLAS_RCC_SOURCE}"
+        "${LOOT_ICON_ATLAS_QRC}"
+    DEPENDS "${LOOT_ICON_ATLAS_QRC}" "${LOOT_ICON_ATLAS_IMAGE}" "${LOOT_ICON_ATLAS_INDEX}"
+    COMMENT "Compiling icon atlas resources..."
+    VERBATIM)
+
+set_source_files_properties("${LOOT_ICON_ATLAS_RCC_SOURCE}"
+    PROPERTIES GENERATED TRUE SKIP_AUTOGEN TRUE)
@@ -0,0 +1,12 @@
+##############################
+# Dependencies
+##############################
+
+# The tests and benchmarks both use the testing plugins, so they share this
+# declaration.
+include_guard(GLOBAL)
+
+FetchContent_Declare(
+    testing-plugins
+    URL "https://github.com/Ortham/testing-plugins/archive/1.6.2.tar.gz"
+    URL_HASH "SHA256=f6e5b55e2669993ab650ba470424b725d1fab71ace979134a77de3373bd55620")
@@ -12,10 +12,7 @@ FetchContent_Declare(
     URL_HASH "SHA256=8ad598c73ad796e0d8280b082cebd82a630d73e73cd3c70057938a6501bba5d7"
     FIND_PACKAGE_ARGS)
 
-FetchContent_Declare(
-    testing-plugins
-    URL "https://github.com/Ortham/testing-plugins/archive/1.6.2.tar.gz"
-    URL_HASH "SHA256=f6e5b55e2669993ab650ba470424b725d1fab71ace979134a77de3373bd55620")
+include("${CMAKE_SOURCE_DIR}/cmake/testing_plugins.cmake")
 
 FetchContent_MakeAvailable(GTest testing-plugins)
 
@@ -29,31 +26,65 @@ set(LOOT_SRC_TESTS_GUI_CPP_FILES
 "${CMAKE_SOURCE_DIR}/src/tests/gui/qt/tasks/non_blocking_test_task.cpp")
 
 set(LOOT_SRC_TESTS_GUI_H_FILES
+"${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/active_plugins_snapshot_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/data_paths_snapshot_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/directory_listing_test.h"
 "${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/detection/common_test.h"
 "${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/detection/detail_test.h"
 "${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/detection/epic_games_store_test.h"
 "${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/detection/generic_test.h"
 "${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/detection/gog_test.h"
 "${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/detection/heroic_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/detection/install_cache_test.h"
 "${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/detection/microsoft_store_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/detection/registry_test.h"
 "${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/detection/steam_test.h"
 "${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/detection/test_registry.h"
 "${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/detection_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/game_data_snapshot_test.h"
 "${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/game_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/file_content_hash_cache_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/file_io_scheduler_test.h"
 "${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/game_settings_test.h"
 "${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/games_manager_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/group_graph_test.h"
 "${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/group_node_positions_test.h"
 "${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/helpers_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/plugin_dependents_index_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/plugin_file_cache_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/record_overlap_index_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/sort_result_cache_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/state/game/synthetic_load_order_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/state/diagnostics_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/state/download_mirrors_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/state/log_archive_test.h"
 "${CMAKE_SOURCE_DIR}/src/tests/gui/state/loot_paths_test.h"
 "${CMAKE_SOURCE_DIR}/src/tests/gui/state/loot_settings_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/state/performance_history_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/state/run_metrics_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/state/thread_pool_test.h"
 "${CMAKE_SOURCE_DIR}/src/tests/gui/state/unapplied_change_counter_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/state/update_check_cache_test.h"
 "${CMAKE_SOURCE_DIR}/src/tests/gui/qt/helpers_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/qt/icon_atlas_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/qt/instance_server_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/qt/startup_scheduler_test.h"
 "${CMAKE_SOURCE_DIR}/src/tests/gui/qt/tasks/non_blocking_test_task.h"
 "${CMAKE_SOURCE_DIR}/src/tests/gui/qt/tasks/tasks_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/query/types/apply_sort_query_test.h"
 "${CMAKE_SOURCE_DIR}/src/tests/gui/backup_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/cancellation_token_test.h"
 "${CMAKE_SOURCE_DIR}/src/tests/gui/helpers_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/interned_string_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/plugin_items_snapshot_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/plugin_name_prefix_index_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/shared_string_test.h"
 "${CMAKE_SOURCE_DIR}/src/tests/gui/sourced_message_test.h"
-"${CMAKE_SOURCE_DIR}/src/tests/gui/test_helpers.h")
+"${CMAKE_SOURCE_DIR}/src/tests/gui/synthetic_load_order.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/tag_set_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/test_helpers.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/translation_cache_test.h"
+"${CMAKE_SOURCE_DIR}/src/tests/gui/user_metadata_changes_test.h")
 
 source_group(TREE "${CMAKE_SOURCE_DIR}/src/tests/gui"
     PREFIX "Header Files"
@@ -69,34 +100,81 @@ set(LOOT_GUI_TESTS_ALL_SOURCES
     "${CMAKE_BINARY_DIR}/generated/version.cpp"
     "${CMAKE_SOURCE_DIR}/src/gui/backup.cpp"
     "${CMAKE_SOURCE_DIR}/src/gui/helpers.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/interned_string.cpp"
     "${CMAKE_SOURCE_DIR}/src/gui/plugin_item.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/plugin_items_snapshot.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/plugin_name_prefix_index.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/shared_string.cpp"
     "${CMAKE_SOURCE_DIR}/src/gui/sourced_message.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/tag_set.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/translation_cache.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/user_metadata_changes.cpp"
     "${CMAKE_SOURCE_DIR}/src/gui/qt/helpers.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/qt/icon_atlas.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/qt/instance_server.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/qt/startup_scheduler.cpp"
     "${CMAKE_SOURCE_DIR}/src/gui/qt/tasks/tasks.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/diagnostics.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/download_mirrors.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/game/active_plugins_snapshot.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/game/data_paths_snapshot.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/game/directory_listing.cpp"
     "${CMAKE_SOURCE_DIR}/src/gui/state/game/detection/common.cpp"
     "${CMAKE_SOURCE_DIR}/src/gui/state/game/detection/detail.cpp"
     "${CMAKE_SOURCE_DIR}/src/gui/state/game/detection/epic_games_store.cpp"
     "${CMAKE_SOURCE_DIR}/src/gui/state/game/detection/generic.cpp"
     "${CMAKE_SOURCE_DIR}/src/gui/state/game/detection/gog.cpp"
     "${CMAKE_SOURCE_DIR}/src/gui/state/game/detection/heroic.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/game/detection/install_cache.cpp"
     "${CMAKE_SOURCE_DIR}/src/gui/state/game/detection/microsoft_store.cpp"
     "${CMAKE_SOURCE_DIR}/src/gui/state/game/detection/registry.cpp"
     "${CMAKE_SOURCE_DIR}/src/gui/state/game/detection/steam.cpp"
     "${CMAKE_SOURCE_DIR}/src/gui/state/game/detection.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/game/file_content_hash_cache.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/game/file_io_scheduler.cpp"
     "${CMAKE_SOURCE_DIR}/src/gui/state/game/game.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/game/game_data_snapshot.cpp"
     "${CMAKE_SOURCE_DIR}/src/gui/state/game/game_settings.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/game/group_graph.cpp"
     "${CMAKE_SOURCE_DIR}/src/gui/state/game/group_node_positions.cpp"
     "${CMAKE_SOURCE_DIR}/src/gui/state/game/helpers.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/game/plugin_dependents_index.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/game/plugin_file_cache.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/game/record_overlap_index.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/game/sort_result_cache.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/log_archive.cpp"
     "${CMAKE_SOURCE_DIR}/src/gui/state/logging.cpp"
     "${CMAKE_SOURCE_DIR}/src/gui/state/loot_paths.cpp"
     "${CMAKE_SOURCE_DIR}/src/gui/state/loot_settings.cpp"
     "${CMAKE_SOURCE_DIR}/src/gui/state/loot_state.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/memory_accounting.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/performance_history.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/run_metrics.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/thread_pool.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/timing.cpp"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/update_check_cache.cpp"
     "${CMAKE_SOURCE_DIR}/src/gui/backup.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/cancellation_token.h"
     "${CMAKE_SOURCE_DIR}/src/gui/helpers.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/interned_string.h"
     "${CMAKE_SOURCE_DIR}/src/gui/plugin_item.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/plugin_items_snapshot.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/plugin_name_prefix_index.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/shared_string.h"
     "${CMAKE_SOURCE_DIR}/src/gui/sourced_message.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/tag_set.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/translation_cache.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/user_metadata_changes.h"
     "${CMAKE_SOURCE_DIR}/src/gui/qt/helpers.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/qt/icon_atlas.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/qt/instance_server.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/qt/startup_scheduler.h"
     "${CMAKE_SOURCE_DIR}/src/gui/qt/tasks/tasks.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/diagnostics.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/download_mirrors.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/game/active_plugins_snapshot.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/game/data_paths_snapshot.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/game/directory_listing.h"
     "${CMAKE_SOURCE_DIR}/src/gui/state/game/detection/common.h"
     "${CMAKE_SOURCE_DIR}/src/gui/state/game/detection/detail.h"
     "${CMAKE_SOURCE_DIR}/src/gui/state/game/detection/epic_games_store.h"
@@ -104,19 +182,35 @@ set(LOOT_GUI_TESTS_ALL_SOURCES
     "${CMAKE_SOURCE_DIR}/src/gui/state/game/detection/generic.h"
     "${CMAKE_SOURCE_DIR}/src/gui/state/game/detection/gog.h"
     "${CMAKE_SOURCE_DIR}/src/gui/state/game/detection/heroic.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/game/detection/install_cache.h"
     "${CMAKE_SOURCE_DIR}/src/gui/state/game/detection/microsoft_store.h"
     "${CMAKE_SOURCE_DIR}/src/gui/state/game/detection/registry.h"
     "${CMAKE_SOURCE_DIR}/src/gui/state/game/detection/steam.h"
     "${CMAKE_SOURCE_DIR}/src/gui/state/game/detection.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/game/file_content_hash_cache.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/game/file_io_scheduler.h"
     "${CMAKE_SOURCE_DIR}/src/gui/state/game/game.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/game/game_data_snapshot.h"
     "${CMAKE_SOURCE_DIR}/src/gui/state/game/game_settings.h"
     "${CMAKE_SOURCE_DIR}/src/gui/state/game/games_manager.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/game/group_graph.h"
     "${CMAKE_SOURCE_DIR}/src/gui/state/game/group_node_positions.h"
     "${CMAKE_SOURCE_DIR}/src/gui/state/game/helpers.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/game/plugin_dependents_index.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/game/plugin_file_cache.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/game/record_overlap_index.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/game/sort_result_cache.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/log_archive.h"
     "${CMAKE_SOURCE_DIR}/src/gui/state/loot_paths.h"
     "${CMAKE_SOURCE_DIR}/src/gui/state/loot_settings.h"
     "${CMAKE_SOURCE_DIR}/src/gui/state/loot_state.h"
-    "${CMAKE_SOURCE_DIR}/src/gui/state/unapplied_change_counter.h")
+    "${CMAKE_SOURCE_DIR}/src/gui/state/memory_accounting.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/performance_history.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/run_metrics.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/thread_pool.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/timing.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/unapplied_change_counter.h"
+    "${CMAKE_SOURCE_DIR}/src/gui/state/update_check_cache.h")
 
 ##############################
 # Define Targets
@@ -124,7 +218,6 @@ set(LOOT_GUI_TESTS_ALL_SOURCES
 
 # Build application tests.
 add_executable(loot_gui_tests ${LOOT_GUI_TESTS_ALL_SOURCES})
-add_dependencies(loot_gui_tests ValveFileVDF)
 target_link_libraries(loot_gui_tests PRIVATE
     Qt::Widgets Qt::Network Qt::Concurrent Qt::Test
     Boost::headers Boost::locale
@@ -151,7 +244,7 @@ else()
 endif()
 
 if(ZLIB_FOUND)
-    target_link_libraries(loot_gui_tests PRIVATE MINIZIP::minizip)
+    target_link_libraries(loot_gui_tests PRIVATE MINIZIP::minizip ZLIB::ZLIB)
 else()
     add_dependencies(loot_gui_tests minizip-ng)
     target_link_libraries(loot_gui_tests PRIVATE ${MINIZIP_NG_LIBRARIES})
@@ -159,8 +252,6 @@ else()
 endif()
 
 target_include_directories(loot_gui_tests PRIVATE "${CMAKE_SOURCE_DIR}/src")
-target_include_directories(loot_gui_tests SYSTEM PRIVATE
-    ${VALVE_FILE_VDF_INCLUDE_DIRS})
 
 if(CMAKE_SYSTEM_NAME STREQUAL "Windows")
     target_compile_definitions(loot_gui_tests PRIVATE
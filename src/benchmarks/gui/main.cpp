@@ -0,0 +1,175 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifdef _MSC_VER
+// Qt typedef's a uint type in the global namespace that spdlog shadows, just
+// disable the warning.
+#pragma warning(disable : 4459)
+#include <spdlog/sinks/null_sink.h>
+#include <spdlog/spdlog.h>
+#pragma warning(default : 4459)
+#else
+#include <spdlog/sinks/null_sink.h>
+#include <spdlog/spdlog.h>
+#endif
+
+#include <benchmark/benchmark.h>
+
+#include <QtWidgets/QApplication>
+#include <boost/algorithm/string.hpp>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "benchmarks/gui/plugin_item_benchmarks.h"
+#include "benchmarks/gui/qt/card_sizing_cache_benchmarks.h"
+#include "benchmarks/gui/qt/rendering_benchmarks.h"
+#include "benchmarks/gui/query_benchmarks.h"
+#include "benchmarks/gui/state/config_benchmarks.h"
+#include "benchmarks/gui/state/game/detection_benchmarks.h"
+
+namespace {
+// The synthetic load order sizes can be overridden using a comma-separated
+// list in this environment variable.
+constexpr const char* PLUGIN_COUNTS_VARIABLE = "LOOT_BENCHMARK_PLUGIN_COUNTS";
+const std::vector<int64_t> DEFAULT_PLUGIN_COUNTS{100, 1000};
+// The numbers of installed apps, games or groups in the files that are given
+// to the detection and config parsers.
+const std::vector<int64_t> PARSER_ENTRY_COUNTS{50, 500};
+
+std::vector<int64_t> getPluginCounts() {
+  const auto value = std::getenv(PLUGIN_COUNTS_VARIABLE);
+  if (value == nullptr) {
+    return DEFAULT_PLUGIN_COUNTS;
+  }
+
+  const std::string list(value);
+  std::vector<std::string> elements;
+  boost::split(elements, list, boost::is_any_of(","));
+
+  std::vector<int64_t> counts;
+  for (const auto& element : elements) {
+    const auto trimmed = boost::trim_copy(element);
+    if (!trimmed.empty()) {
+      counts.push_back(std::stoll(trimmed));
+    }
+  }
+
+  return counts;
+}
+
+void registerBenchmark(const char* name,
+                       void (*function)(::benchmark::State&),
+                       const std::vector<int64_t>& pluginCounts) {
+  auto benchmark = ::benchmark::RegisterBenchmark(name, function);
+  benchmark->ArgName("plugins")->Unit(::benchmark::kMillisecond);
+
+  for (const auto count : pluginCounts) {
+    benchmark->Arg(count);
+  }
+}
+
+void registerParserBenchmark(const char* name,
+                             void (*function)(::benchmark::State&)) {
+  auto benchmark = ::benchmark::RegisterBenchmark(name, function);
+  benchmark->ArgName("entries")->Unit(::benchmark::kMicrosecond);
+
+  for (const auto count : PARSER_ENTRY_COUNTS) {
+    benchmark->Arg(count);
+  }
+}
+}
+
+// Run this from the build directory so that the testing plugins can be
+// found. Pass --benchmark_out=<file> --benchmark_out_format=json to record the
+// results for comparison.
+int main(int argc, char** argv) {
+  // Set the logger to use a null sink.
+  spdlog::create<spdlog::sinks::null_sink_st>("loot_logger");
+
+  // The GUI benchmarks need widgets, but they can be rendered offscreen.
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+  }
+
+  QApplication app(argc, argv);
+
+  using namespace loot::bench;
+
+  const auto pluginCounts = getPluginCounts();
+  registerBenchmark(
+      "GetGameDataQuery", benchmarkGetGameDataQuery, pluginCounts);
+  registerBenchmark(
+      "SortPluginsQuery", benchmarkSortPluginsQuery, pluginCounts);
+  registerBenchmark("GetOverlappingPluginsQuery",
+                    benchmarkGetOverlappingPluginsQuery,
+                    pluginCounts);
+  registerBenchmark("GetPluginItems", benchmarkGetPluginItems, pluginCounts);
+  registerBenchmark("PluginItem::containsText",
+                    benchmarkPluginItemContainsText,
+                    pluginCounts);
+  registerBenchmark("PluginItem content regex match",
+                    benchmarkPluginItemMatchesRegex,
+                    pluginCounts);
+  registerBenchmark("CardSizingCache::update",
+                    benchmarkCardSizingCacheUpdate,
+                    pluginCounts);
+  registerBenchmark("CardDelegate::sizeHint",
+                    benchmarkCardDelegateSizeHint,
+                    pluginCounts);
+  registerBenchmark(
+      "Cards view scrolling", benchmarkCardsViewScrolling, pluginCounts);
+  registerBenchmark("Cards view scrolling (uncached)",
+                    benchmarkCardsViewScrollingUncached,
+                    pluginCounts);
+  registerBenchmark(
+      "Sidebar scrolling", benchmarkSidebarScrolling, pluginCounts);
+  registerBenchmark(
+      "MessagesWidget update", benchmarkMessagesWidgetUpdate, pluginCounts);
+
+  registerParserBenchmark("steam::GetSteamLibraryPaths",
+                          benchmarkGetSteamLibraryPaths);
+  registerParserBenchmark("steam::FindGameInstall",
+                          benchmarkSteamFindGameInstall);
+  registerParserBenchmark("steam::FindGameInstalls",
+                          benchmarkSteamFindGameInstalls);
+  registerParserBenchmark("Heroic installed games",
+                          benchmarkHeroicGetInstalledGames);
+  registerParserBenchmark("epic::FindGameInstalls",
+                          benchmarkEgsFindGameInstalls);
+  registerParserBenchmark("LootSettings::load", benchmarkLootSettingsLoad);
+  registerParserBenchmark("LoadGroupNodePositions",
+                          benchmarkLoadGroupNodePositions);
+
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+
+  ::benchmark::RunSpecifiedBenchmarks();
+  ::benchmark::Shutdown();
+
+  return 0;
+}
@@ -0,0 +1,87 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_BENCHMARKS_GUI_PLUGIN_ITEM_BENCHMARKS
+#define LOOT_BENCHMARKS_GUI_PLUGIN_ITEM_BENCHMARKS
+
+#include <benchmark/benchmark.h>
+
+#include <QtCore/QRegularExpression>
+
+#include "benchmarks/gui/query_benchmarks.h"
+
+namespace loot {
+namespace bench {
+// Only some plugins have the note, so some searches match and some don't.
+static constexpr const char* SEARCH_TEXT = "Synthetic Note";
+
+void benchmarkPluginItemContainsText(::benchmark::State& state) {
+  auto& game = getLoadedGame(state);
+  const auto items = GetPluginItems(game.GetLoadOrder(), game, LANGUAGE);
+
+  for (auto _ : state) {
+    size_t matches = 0;
+    for (const auto& item : items) {
+      if (item.containsText(SEARCH_TEXT)) {
+        matches += 1;
+      }
+    }
+    ::benchmark::DoNotOptimize(matches);
+  }
+
+  setPluginsProcessed(state, game);
+}
+
+// This matches items in the same way as the content filter does when it's
+// given a regular expression, but without its cache of results.
+void benchmarkPluginItemMatchesRegex(::benchmark::State& state) {
+  auto& game = getLoadedGame(state);
+  const auto items = GetPluginItems(game.GetLoadOrder(), game, LANGUAGE);
+  const QRegularExpression regex("synthetic (note|plugin 1\\d+)",
+                                 QRegularExpression::CaseInsensitiveOption);
+
+  for (auto _ : state) {
+    size_t matches = 0;
+    for (const auto& item : items) {
+      const auto isMatch =
+          item.anyLowercaseSearchField([&regex](std::string_view field) {
+            return regex
+                .match(QString::fromUtf8(field.data(),
+                                         static_cast<qsizetype>(field.size())))
+                .hasMatch();
+          });
+      if (isMatch) {
+        matches += 1;
+      }
+    }
+    ::benchmark::DoNotOptimize(matches);
+  }
+
+  setPluginsProcessed(state, game);
+}
+}
+}
+
+#endif
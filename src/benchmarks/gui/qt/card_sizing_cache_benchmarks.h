@@ -0,0 +1,66 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_BENCHMARKS_GUI_QT_CARD_SIZING_CACHE_BENCHMARKS
+#define LOOT_BENCHMARKS_GUI_QT_CARD_SIZING_CACHE_BENCHMARKS
+
+#include <benchmark/benchmark.h>
+
+#include <QtCore/QCoreApplication>
+#include <QtWidgets/QWidget>
+
+#include "benchmarks/gui/query_benchmarks.h"
+#include "gui/qt/card_delegate.h"
+#include "gui/qt/plugin_item_model.h"
+
+namespace loot {
+namespace bench {
+void benchmarkCardSizingCacheUpdate(::benchmark::State& state) {
+  auto& game = getLoadedGame(state);
+
+  PluginItemModel model(nullptr);
+  model.setPluginItems(GetPluginItems(game.GetLoadOrder(), game, LANGUAGE));
+
+  for (auto _ : state) {
+    // Use a new cache each time so that no cards are reused.
+    state.PauseTiming();
+    QWidget parent;
+    CardSizingCache cache(&parent);
+    state.ResumeTiming();
+
+    cache.update(&model);
+
+    // The cache updates its queued rows in batches from the event loop.
+    while (cache.hasQueuedRows()) {
+      QCoreApplication::processEvents();
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * model.rowCount());
+}
+}
+}
+
+#endif
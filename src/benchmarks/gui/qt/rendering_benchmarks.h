@@ -0,0 +1,233 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_BENCHMARKS_GUI_QT_RENDERING_BENCHMARKS
+#define LOOT_BENCHMARKS_GUI_QT_RENDERING_BENCHMARKS
+
+#include <benchmark/benchmark.h>
+
+#include <QtCore/QCoreApplication>
+#include <QtGui/QImage>
+#include <QtWidgets/QHeaderView>
+#include <QtWidgets/QListView>
+#include <QtWidgets/QScrollBar>
+#include <QtWidgets/QTableView>
+#include <QtWidgets/QWidget>
+
+#include "benchmarks/gui/query_benchmarks.h"
+#include "gui/qt/card_delegate.h"
+#include "gui/qt/messages_widget.h"
+#include "gui/qt/plugin_item_model.h"
+#include "gui/qt/sidebar_plugin_name_delegate.h"
+
+namespace loot {
+namespace bench {
+static constexpr int VIEW_WIDTH = 800;
+static constexpr int VIEW_HEIGHT = 600;
+
+void setPluginItems(PluginItemModel& model, const gui::Game& game) {
+  model.setPluginItems(GetPluginItems(game.GetLoadOrder(), game, LANGUAGE));
+}
+
+void showView(QAbstractItemView& view) {
+  view.resize(VIEW_WIDTH, VIEW_HEIGHT);
+  view.show();
+  QCoreApplication::processEvents();
+}
+
+// Each iteration scrolls the view down by a page, wrapping back to the top,
+// and then paints its viewport, so the time per iteration is the time taken to
+// scroll and render one frame.
+template<typename BeforeFrame>
+void benchmarkScrollingFrames(::benchmark::State& state,
+                              QAbstractItemView& view,
+                              BeforeFrame beforeFrame) {
+  auto viewport = view.viewport();
+  QImage image(viewport->size(), QImage::Format_ARGB32_Premultiplied);
+  auto scrollBar = view.verticalScrollBar();
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    beforeFrame();
+    state.ResumeTiming();
+
+    auto value = scrollBar->value() + scrollBar->pageStep();
+    if (value > scrollBar->maximum()) {
+      value = scrollBar->minimum();
+    }
+    scrollBar->setValue(value);
+
+    viewport->render(&image);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  state.SetLabel("frames");
+}
+
+// The cards view set up as it is in the main window, with all cards created
+// up front.
+class CardsView {
+public:
+  explicit CardsView(const gui::Game& game) :
+      model_(nullptr), cardSizingCache_(&cardParent_) {
+    setPluginItems(model_, game);
+
+    cardSizingCache_.update(&model_);
+    while (cardSizingCache_.hasQueuedRows()) {
+      QCoreApplication::processEvents();
+    }
+
+    view_.setModel(&model_);
+    view_.setModelColumn(PluginItemModel::CARDS_COLUMN);
+    view_.setSelectionMode(QAbstractItemView::NoSelection);
+    view_.setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    view_.setResizeMode(QListView::Adjust);
+    view_.setWordWrap(true);
+
+    delegate_ = new CardDelegate(&view_, cardSizingCache_);
+    view_.setItemDelegate(delegate_);
+
+    showView(view_);
+  }
+
+  QListView& view() { return view_; }
+
+  CardDelegate& delegate() { return *delegate_; }
+
+  const PluginItemModel& model() const { return model_; }
+
+private:
+  PluginItemModel model_;
+  QWidget cardParent_;
+  CardSizingCache cardSizingCache_;
+  QListView view_;
+  CardDelegate* delegate_{nullptr};
+};
+
+void benchmarkCardsViewScrolling(::benchmark::State& state) {
+  CardsView cardsView(getLoadedGame(state));
+
+  benchmarkScrollingFrames(state, cardsView.view(), []() {});
+}
+
+// Discard rendered cards before each frame so that every visible card is
+// painted from scratch, as happens when the cards' content or styling changes.
+void benchmarkCardsViewScrollingUncached(::benchmark::State& state) {
+  CardsView cardsView(getLoadedGame(state));
+
+  benchmarkScrollingFrames(state, cardsView.view(), [&]() {
+    cardsView.delegate().clearRenderedCards();
+  });
+}
+
+// Alternate between two widths so that cached size hints are never valid, as
+// happens when the window is resized.
+void benchmarkCardDelegateSizeHint(::benchmark::State& state) {
+  CardsView cardsView(getLoadedGame(state));
+  auto& delegate = cardsView.delegate();
+  const auto& model = cardsView.model();
+
+  QStyleOptionViewItem option;
+  option.initFrom(cardsView.view().viewport());
+
+  int width = VIEW_WIDTH;
+  for (auto _ : state) {
+    width = width == VIEW_WIDTH ? VIEW_WIDTH + 1 : VIEW_WIDTH;
+    option.rect = QRect(0, 0, width, VIEW_HEIGHT);
+
+    for (int row = 0; row < model.rowCount(); row += 1) {
+      auto size = delegate.sizeHint(
+          option, model.index(row, PluginItemModel::CARDS_COLUMN));
+      ::benchmark::DoNotOptimize(size);
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * model.rowCount());
+}
+
+void benchmarkSidebarScrolling(::benchmark::State& state) {
+  PluginItemModel model(nullptr);
+  setPluginItems(model, getLoadedGame(state));
+
+  QTableView view;
+  view.setModel(&model);
+  view.setShowGrid(false);
+  view.hideRow(0);
+  view.hideColumn(PluginItemModel::CARDS_COLUMN);
+  view.verticalHeader()->setDefaultSectionSize(getSidebarRowHeight(false));
+  view.verticalHeader()->hide();
+  view.setItemDelegateForColumn(PluginItemModel::SIDEBAR_NAME_COLUMN,
+                                new SidebarPluginNameDelegate(&view));
+
+  showView(view);
+
+  benchmarkScrollingFrames(state, view, []() {});
+}
+
+// Alternate between plugins' messages and no messages so that the widget's
+// content changes with every update, as many plugins have the same messages.
+void benchmarkMessagesWidgetUpdate(::benchmark::State& state) {
+  const auto& game = getLoadedGame(state);
+  std::vector<std::vector<SourcedMessage>> messages;
+  for (const auto& item :
+       GetPluginItems(game.GetLoadOrder(), game, LANGUAGE)) {
+    if (!item.messages.empty()) {
+      messages.push_back(item.messages);
+    }
+  }
+
+  if (messages.empty()) {
+    state.SkipWithError("No plugins have messages");
+    return;
+  }
+
+  QWidget parent;
+  parent.resize(VIEW_WIDTH, VIEW_HEIGHT);
+  auto widget = new MessagesWidget(&parent);
+  parent.show();
+  QCoreApplication::processEvents();
+
+  QImage image(parent.size(), QImage::Format_ARGB32_Premultiplied);
+  const std::vector<SourcedMessage> noMessages;
+  size_t index = 0;
+
+  for (auto _ : state) {
+    if (index % 2 == 0) {
+      widget->setMessages(messages.at((index / 2) % messages.size()));
+    } else {
+      widget->setMessages(noMessages);
+    }
+    widget->adjustSize();
+    parent.render(&image);
+
+    index += 1;
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+}
+}
+
+#endif
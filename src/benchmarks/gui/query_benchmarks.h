@@ -0,0 +1,117 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_BENCHMARKS_GUI_QUERY_BENCHMARKS
+#define LOOT_BENCHMARKS_GUI_QUERY_BENCHMARKS
+
+#include <benchmark/benchmark.h>
+
+#include "benchmarks/gui/synthetic_game.h"
+#include "gui/query/types/get_game_data_query.h"
+#include "gui/query/types/get_overlapping_plugins_query.h"
+#include "gui/query/types/sort_plugins_query.h"
+
+namespace loot {
+namespace bench {
+static const std::string LANGUAGE = MessageContent::DEFAULT_LANGUAGE;
+
+void ignoreProgress(std::string) {}
+
+// Get a synthetic game that has had its data loaded, as it would be once LOOT
+// has started.
+gui::Game& getLoadedGame(const ::benchmark::State& state) {
+  auto& synthetic = SyntheticGame::get(static_cast<size_t>(state.range(0)));
+
+  if (synthetic.game().GetPlugins().empty()) {
+    GetGameDataQuery(synthetic.game(), LANGUAGE, ignoreProgress)
+        .executeLogic();
+  }
+
+  return synthetic.game();
+}
+
+void setPluginsProcessed(::benchmark::State& state, const gui::Game& game) {
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<int64_t>(game.GetLoadOrder().size()));
+}
+
+void benchmarkGetGameDataQuery(::benchmark::State& state) {
+  auto& game = getLoadedGame(state);
+
+  for (auto _ : state) {
+    GetGameDataQuery query(game, LANGUAGE, ignoreProgress);
+    auto result = query.executeLogic();
+    ::benchmark::DoNotOptimize(result);
+  }
+
+  setPluginsProcessed(state, game);
+}
+
+void benchmarkSortPluginsQuery(::benchmark::State& state) {
+  auto& game = getLoadedGame(state);
+  UnappliedChangeCounter counter;
+
+  for (auto _ : state) {
+    SortPluginsQuery query(game, counter, LANGUAGE, ignoreProgress);
+    auto result = query.executeLogic();
+    ::benchmark::DoNotOptimize(result);
+  }
+
+  setPluginsProcessed(state, game);
+}
+
+void benchmarkGetOverlappingPluginsQuery(::benchmark::State& state) {
+  auto& game = getLoadedGame(state);
+
+  // The first query fully loads the plugins and builds the overlap index, so
+  // run it once up front to measure the steady state.
+  const auto pluginName = game.GetLoadOrder().back();
+  GetOverlappingPluginsQuery(game, LANGUAGE, pluginName, false)
+      .executeLogic();
+
+  for (auto _ : state) {
+    GetOverlappingPluginsQuery query(game, LANGUAGE, pluginName, false);
+    auto result = query.executeLogic();
+    ::benchmark::DoNotOptimize(result);
+  }
+
+  setPluginsProcessed(state, game);
+}
+
+void benchmarkGetPluginItems(::benchmark::State& state) {
+  auto& game = getLoadedGame(state);
+  const auto loadOrder = game.GetLoadOrder();
+
+  for (auto _ : state) {
+    auto items = GetPluginItems(loadOrder, game, LANGUAGE);
+    ::benchmark::DoNotOptimize(items);
+  }
+
+  setPluginsProcessed(state, game);
+}
+}
+}
+
+#endif
@@ -0,0 +1,159 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_BENCHMARKS_GUI_STATE_CONFIG_BENCHMARKS
+#define LOOT_BENCHMARKS_GUI_STATE_CONFIG_BENCHMARKS
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gui/state/game/group_node_positions.h"
+#include "gui/state/loot_settings.h"
+#include "tests/gui/test_helpers.h"
+
+namespace loot {
+namespace bench {
+// LOOT's settings with the given number of game entries, and saved group node
+// positions for the given number of groups.
+class SyntheticConfigFiles {
+public:
+  explicit SyntheticConfigFiles(size_t entryCount) :
+      rootPath_(test::getTempPath()),
+      settingsPath_(rootPath_ / "settings.toml"),
+      groupNodePositionsPath_(rootPath_ / "group_node_positions.bin") {
+    std::filesystem::create_directories(rootPath_);
+
+    writeSettings(entryCount);
+    writeGroupNodePositions(entryCount);
+  }
+
+  SyntheticConfigFiles(const SyntheticConfigFiles&) = delete;
+  SyntheticConfigFiles(SyntheticConfigFiles&&) = delete;
+
+  ~SyntheticConfigFiles() {
+    std::error_code ec;
+    std::filesystem::remove_all(rootPath_, ec);
+  }
+
+  SyntheticConfigFiles& operator=(const SyntheticConfigFiles&) = delete;
+  SyntheticConfigFiles& operator=(SyntheticConfigFiles&&) = delete;
+
+  static SyntheticConfigFiles& get(size_t entryCount) {
+    static std::map<size_t, std::unique_ptr<SyntheticConfigFiles>> files;
+
+    auto& configFiles = files[entryCount];
+    if (!configFiles) {
+      configFiles = std::make_unique<SyntheticConfigFiles>(entryCount);
+    }
+
+    return *configFiles;
+  }
+
+  const std::filesystem::path& settingsPath() const { return settingsPath_; }
+
+  const std::filesystem::path& groupNodePositionsPath() const {
+    return groupNodePositionsPath_;
+  }
+
+private:
+  void writeSettings(size_t gameCount) const {
+    static const std::vector<GameId> GAME_IDS{GameId::tes3,
+                                              GameId::tes4,
+                                              GameId::tes5,
+                                              GameId::tes5se,
+                                              GameId::fo3,
+                                              GameId::fonv,
+                                              GameId::fo4,
+                                              GameId::starfield};
+
+    // Each game has its paths set, as they are once detected.
+    std::vector<GameSettings> gameSettings;
+    for (size_t i = 0; i < gameCount; i += 1) {
+      const auto id = std::to_string(i);
+      gameSettings.push_back(
+          GameSettings(GAME_IDS[i % GAME_IDS.size()], "Synthetic Game " + id)
+              .SetName("Synthetic Game " + id)
+              .SetGamePath(rootPath_ / "games" / id)
+              .SetGameLocalPath(rootPath_ / "local" / id));
+    }
+
+    LootSettings settings;
+    settings.storeGameSettings(gameSettings);
+    settings.save(settingsPath_);
+  }
+
+  void writeGroupNodePositions(size_t groupCount) const {
+    std::vector<GroupNodePosition> positions;
+    for (size_t i = 0; i < groupCount; i += 1) {
+      GroupNodePosition position;
+      position.groupName = "Synthetic Group " + std::to_string(i);
+      position.x = static_cast<double>(i) * 150.0;
+      position.y = static_cast<double>(i % 10) * 80.0;
+      positions.push_back(position);
+    }
+
+    SaveGroupNodePositions(groupNodePositionsPath_, positions);
+  }
+
+  const std::filesystem::path rootPath_;
+  const std::filesystem::path settingsPath_;
+  const std::filesystem::path groupNodePositionsPath_;
+};
+
+const SyntheticConfigFiles& getConfigFiles(const ::benchmark::State& state) {
+  return SyntheticConfigFiles::get(static_cast<size_t>(state.range(0)));
+}
+
+void benchmarkLootSettingsLoad(::benchmark::State& state) {
+  const auto& files = getConfigFiles(state);
+
+  for (auto _ : state) {
+    LootSettings settings;
+    settings.load(files.settingsPath());
+    ::benchmark::DoNotOptimize(settings);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void benchmarkLoadGroupNodePositions(::benchmark::State& state) {
+  const auto& files = getConfigFiles(state);
+
+  for (auto _ : state) {
+    auto positions = LoadGroupNodePositions(files.groupNodePositionsPath());
+    ::benchmark::DoNotOptimize(positions);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+}
+}
+
+#endif
@@ -0,0 +1,368 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_BENCHMARKS_GUI_STATE_GAME_DETECTION_BENCHMARKS
+#define LOOT_BENCHMARKS_GUI_STATE_GAME_DETECTION_BENCHMARKS
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gui/state/game/detection/epic_games_store.h"
+#include "gui/state/game/detection/heroic.h"
+#include "gui/state/game/detection/steam.h"
+#include "tests/gui/state/game/detection/test_registry.h"
+#include "tests/gui/test_helpers.h"
+
+namespace loot {
+namespace bench {
+// Launcher data for the given number of installed apps, most of which are not
+// games that LOOT supports, laid out as the Steam, Heroic and Epic Games
+// launchers store it.
+class SyntheticLauncherData {
+public:
+  explicit SyntheticLauncherData(size_t appCount) :
+      rootPath_(test::getTempPath()),
+      steamPath_(rootPath_ / "Steam"),
+      steamLibraryPath_(rootPath_ / "SteamLibrary"),
+      heroicConfigPath_(rootPath_ / "heroic"),
+      egsDataPath_(rootPath_ / "EpicGamesLauncher" / "Data") {
+    writeSteamLibraryFolders(appCount);
+    writeSteamAppManifests(appCount);
+    writeHeroicGogInstalled(appCount);
+    writeHeroicEgsInstalled(appCount);
+    writeEgsManifests(appCount);
+
+    egsRegistry_.SetStringValue("Software\\Epic Games\\EpicGamesLauncher",
+                                egsDataPath_.u8string());
+  }
+
+  SyntheticLauncherData(const SyntheticLauncherData&) = delete;
+  SyntheticLauncherData(SyntheticLauncherData&&) = delete;
+
+  ~SyntheticLauncherData() {
+    std::error_code ec;
+    std::filesystem::remove_all(rootPath_, ec);
+  }
+
+  SyntheticLauncherData& operator=(const SyntheticLauncherData&) = delete;
+  SyntheticLauncherData& operator=(SyntheticLauncherData&&) = delete;
+
+  // Writing the launcher data is slow, so each size is only created once.
+  static SyntheticLauncherData& get(size_t appCount) {
+    static std::map<size_t, std::unique_ptr<SyntheticLauncherData>> data;
+
+    auto& launcherData = data[appCount];
+    if (!launcherData) {
+      launcherData = std::make_unique<SyntheticLauncherData>(appCount);
+    }
+
+    return *launcherData;
+  }
+
+  const std::filesystem::path& steamPath() const { return steamPath_; }
+
+  const std::filesystem::path& steamLibraryPath() const {
+    return steamLibraryPath_;
+  }
+
+  const std::vector<std::filesystem::path>& steamAppManifestPaths() const {
+    return steamAppManifestPaths_;
+  }
+
+  const std::filesystem::path& heroicConfigPath() const {
+    return heroicConfigPath_;
+  }
+
+  const RegistryInterface& egsRegistry() const { return egsRegistry_; }
+
+private:
+  // One supported game is installed through each launcher, so that parsers
+  // with shortcuts for files that can't hold supported games don't take them.
+  static constexpr const char* STEAM_SKYRIM_SE_APP_ID = "489830";
+  static constexpr const char* GOG_MORROWIND_APP_NAME = "1435828767";
+  static constexpr const char* EGS_SKYRIM_SE_APP_NAME =
+      "ac82db5035584c7f8a2c548d98c86b2c";
+  // Steam libraries typically hold many apps across a few folders.
+  static constexpr size_t STEAM_LIBRARY_FOLDER_COUNT = 4;
+
+  static std::string getAppId(size_t index) {
+    return index == 0 ? STEAM_SKYRIM_SE_APP_ID
+                      : std::to_string(1000000 + index * 10);
+  }
+
+  void writeSteamLibraryFolders(size_t appCount) const {
+    const auto filePath = steamPath_ / "config" / "libraryfolders.vdf";
+    std::filesystem::create_directories(filePath.parent_path());
+
+    std::ofstream out(filePath);
+    out << "\"libraryfolders\"\n{\n";
+    for (size_t folder = 0; folder < STEAM_LIBRARY_FOLDER_COUNT; folder += 1) {
+      out << "\t\"" << folder << "\"\n\t{\n"
+          << "\t\t\"path\"\t\t\"D:\\\\Games\\\\SteamLibrary" << folder
+          << "\"\n"
+          << "\t\t\"label\"\t\t\"\"\n"
+          << "\t\t\"contentid\"\t\t\"1137098260226172853\"\n"
+          << "\t\t\"totalsize\"\t\t\"252496048128\"\n"
+          << "\t\t\"update_clean_bytes_tally\"\t\t\"3302272801\"\n"
+          << "\t\t\"time_last_update_corruption\"\t\t\"0\"\n"
+          << "\t\t\"apps\"\n\t\t{\n";
+      for (size_t i = folder; i < appCount; i += STEAM_LIBRARY_FOLDER_COUNT) {
+        out << "\t\t\t\"" << getAppId(i) << "\"\t\t\"181169252\"\n";
+      }
+      out << "\t\t}\n\t}\n";
+    }
+    out << "}\n";
+  }
+
+  void writeSteamAppManifests(size_t appCount) {
+    const auto steamAppsPath = steamLibraryPath_ / "steamapps";
+    std::filesystem::create_directories(steamAppsPath);
+
+    for (size_t i = 0; i < appCount; i += 1) {
+      const auto appId = getAppId(i);
+      const auto filePath = steamAppsPath / ("appmanifest_" + appId + ".acf");
+
+      std::ofstream out(filePath);
+      out << "\"AppState\"\n{\n"
+          << "\t\"appid\"\t\t\"" << appId << "\"\n"
+          << "\t\"universe\"\t\t\"1\"\n"
+          << "\t\"LauncherPath\"\t\t\"C:\\\\Program Files "
+             "(x86)\\\\Steam\\\\steam.exe\"\n"
+          << "\t\"name\"\t\t\"Synthetic App " << appId << "\"\n"
+          << "\t\"StateFlags\"\t\t\"4\"\n"
+          << "\t\"installdir\"\t\t\"Synthetic App " << appId << "\"\n"
+          << "\t\"LastUpdated\"\t\t\"1700000000\"\n"
+          << "\t\"SizeOnDisk\"\t\t\"15345519558\"\n"
+          << "\t\"StagingSize\"\t\t\"0\"\n"
+          << "\t\"buildid\"\t\t\"12345678\"\n"
+          << "\t\"LastOwner\"\t\t\"76561198000000000\"\n"
+          << "\t\"AutoUpdateBehavior\"\t\t\"0\"\n"
+          << "\t\"AllowOtherDownloadsWhileRunning\"\t\t\"0\"\n"
+          << "\t\"ScheduledAutoUpdate\"\t\t\"0\"\n"
+          << "\t\"InstalledDepots\"\n\t{\n"
+          << "\t\t\"" << appId << "1\"\n\t\t{\n"
+          << "\t\t\t\"manifest\"\t\t\"1234567890123456789\"\n"
+          << "\t\t\t\"size\"\t\t\"15345519558\"\n"
+          << "\t\t}\n\t}\n"
+          << "\t\"UserConfig\"\n\t{\n"
+          << "\t\t\"language\"\t\t\"english\"\n\t}\n"
+          << "\t\"MountedConfig\"\n\t{\n"
+          << "\t\t\"language\"\t\t\"english\"\n\t}\n"
+          << "}\n";
+
+      steamAppManifestPaths_.push_back(filePath);
+    }
+  }
+
+  void writeHeroicGogInstalled(size_t appCount) const {
+    const auto filePath = heroicConfigPath_ / "gog_store" / "installed.json";
+    std::filesystem::create_directories(filePath.parent_path());
+
+    std::ofstream out(filePath);
+    out << "{\"installed\": [";
+    for (size_t i = 0; i < appCount; i += 1) {
+      const auto appName =
+          i == 0 ? GOG_MORROWIND_APP_NAME : std::to_string(2000000000 + i);
+      out << (i == 0 ? "" : ",") << "\n  {\n"
+          << "    \"platform\": \"windows\",\n"
+          << "    \"executable\": \"\",\n"
+          << "    \"install_path\": \"/home/user/Games/Heroic/Synthetic App "
+          << i << "\",\n"
+          << "    \"install_size\": \"12.34 GiB\",\n"
+          << "    \"is_dlc\": false,\n"
+          << "    \"version\": \"1.0.0\",\n"
+          << "    \"appName\": \"" << appName << "\",\n"
+          << "    \"installedWithDLCs\": false,\n"
+          << "    \"language\": \"en-US\",\n"
+          << "    \"versionEtag\": \"\\\"0123456789abcdef\\\"\",\n"
+          << "    \"buildId\": \"12345678901234567\"\n"
+          << "  }";
+    }
+    out << "\n]}\n";
+  }
+
+  void writeHeroicEgsInstalled(size_t appCount) const {
+    const auto filePath =
+        heroicConfigPath_ / "legendaryConfig" / "legendary" / "installed.json";
+    std::filesystem::create_directories(filePath.parent_path());
+
+    std::ofstream out(filePath);
+    out << "{";
+    for (size_t i = 0; i < appCount; i += 1) {
+      const auto appName = i == 0 ? std::string(EGS_SKYRIM_SE_APP_NAME)
+                                  : "SyntheticApp" + std::to_string(i);
+      out << (i == 0 ? "" : ",") << "\n  \"" << appName << "\": {\n"
+          << "    \"app_name\": \"" << appName << "\",\n"
+          << "    \"base_urls\": [\"https://example.com/Builds\"],\n"
+          << "    \"can_run_offline\": true,\n"
+          << "    \"egl_guid\": \"\",\n"
+          << "    \"executable\": \"Synthetic.exe\",\n"
+          << "    \"install_path\": \"/home/user/Games/Heroic/Synthetic App "
+          << i << "\",\n"
+          << "    \"install_size\": 13250000000,\n"
+          << "    \"install_tags\": [],\n"
+          << "    \"is_dlc\": false,\n"
+          << "    \"launch_parameters\": \"\",\n"
+          << "    \"manifest_path\": null,\n"
+          << "    \"needs_verification\": false,\n"
+          << "    \"platform\": \"Windows\",\n"
+          << "    \"prereq_info\": null,\n"
+          << "    \"requires_ot\": false,\n"
+          << "    \"save_path\": null,\n"
+          << "    \"title\": \"Synthetic App " << i << "\",\n"
+          << "    \"version\": \"1.0.0\"\n"
+          << "  }";
+    }
+    out << "\n}\n";
+  }
+
+  void writeEgsManifests(size_t appCount) const {
+    const auto manifestsPath = egsDataPath_ / "Manifests";
+    std::filesystem::create_directories(manifestsPath);
+
+    // None of the manifests are for the game being looked for, so they all
+    // get read, as they would be if it wasn't installed.
+    for (size_t i = 0; i < appCount; i += 1) {
+      const auto id = std::to_string(i);
+      std::ofstream out(manifestsPath / ("SYNTHETIC" + id + ".item"));
+      out << "{\n"
+          << "  \"FormatVersion\": 0,\n"
+          << "  \"bIsIncompleteInstall\": false,\n"
+          << "  \"LaunchCommand\": \"\",\n"
+          << "  \"LaunchExecutable\": \"Synthetic.exe\",\n"
+          << "  \"ManifestLocation\": \"C:\\\\ProgramData\\\\Epic\\\\"
+             "EpicGamesLauncher\\\\Data\\\\Manifests\",\n"
+          << "  \"bIsApplication\": true,\n"
+          << "  \"bIsExecutable\": true,\n"
+          << "  \"bIsManaged\": false,\n"
+          << "  \"bNeedsValidation\": false,\n"
+          << "  \"bRequiresAuth\": true,\n"
+          << "  \"bAllowMultipleInstances\": false,\n"
+          << "  \"bCanRunOffline\": true,\n"
+          << "  \"DisplayName\": \"Synthetic App " << id << "\",\n"
+          << "  \"InstallationGuid\": \"0123456789ABCDEF0123456789ABCDEF\",\n"
+          << "  \"InstallLocation\": \"C:\\\\Program Files\\\\Epic Games\\\\"
+             "SyntheticApp"
+          << id << "\",\n"
+          << "  \"InstallSize\": 13250000000,\n"
+          << "  \"InstallTags\": [],\n"
+          << "  \"CatalogNamespace\": \"synthetic\",\n"
+          << "  \"CatalogItemId\": \"0123456789abcdef0123456789abcdef\",\n"
+          << "  \"AppName\": \"SyntheticApp" << id << "\",\n"
+          << "  \"AppVersionString\": \"1.0.0\",\n"
+          << "  \"MainGameCatalogNamespace\": \"synthetic\",\n"
+          << "  \"MainGameCatalogItemId\": "
+             "\"0123456789abcdef0123456789abcdef\",\n"
+          << "  \"MainGameAppName\": \"SyntheticApp" << id << "\"\n"
+          << "}\n";
+    }
+  }
+
+  const std::filesystem::path rootPath_;
+  const std::filesystem::path steamPath_;
+  const std::filesystem::path steamLibraryPath_;
+  const std::filesystem::path heroicConfigPath_;
+  const std::filesystem::path egsDataPath_;
+  std::vector<std::filesystem::path> steamAppManifestPaths_;
+  test::TestRegistry egsRegistry_;
+};
+
+const SyntheticLauncherData& getLauncherData(const ::benchmark::State& state) {
+  return SyntheticLauncherData::get(static_cast<size_t>(state.range(0)));
+}
+
+void setAppsProcessed(::benchmark::State& state) {
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void benchmarkGetSteamLibraryPaths(::benchmark::State& state) {
+  const auto& data = getLauncherData(state);
+
+  for (auto _ : state) {
+    auto paths = steam::GetSteamLibraryPaths(data.steamPath());
+    ::benchmark::DoNotOptimize(paths);
+  }
+
+  setAppsProcessed(state);
+}
+
+void benchmarkSteamFindGameInstall(::benchmark::State& state) {
+  const auto& data = getLauncherData(state);
+
+  for (auto _ : state) {
+    for (const auto& manifestPath : data.steamAppManifestPaths()) {
+      auto install = steam::FindGameInstall(manifestPath);
+      ::benchmark::DoNotOptimize(install);
+    }
+  }
+
+  setAppsProcessed(state);
+}
+
+void benchmarkSteamFindGameInstalls(::benchmark::State& state) {
+  const auto& data = getLauncherData(state);
+
+  for (auto _ : state) {
+    auto installs = steam::FindGameInstalls(data.steamLibraryPath());
+    ::benchmark::DoNotOptimize(installs);
+  }
+
+  setAppsProcessed(state);
+}
+
+void benchmarkHeroicGetInstalledGames(::benchmark::State& state) {
+  const auto& data = getLauncherData(state);
+
+  for (auto _ : state) {
+    auto gogGames = heroic::GetInstalledGogGames(data.heroicConfigPath());
+    auto egsGames = heroic::GetInstalledEgsGames(data.heroicConfigPath());
+    ::benchmark::DoNotOptimize(gogGames);
+    ::benchmark::DoNotOptimize(egsGames);
+  }
+
+  setAppsProcessed(state);
+}
+
+void benchmarkEgsFindGameInstalls(::benchmark::State& state) {
+  const auto& data = getLauncherData(state);
+
+  for (auto _ : state) {
+    auto install =
+        epic::FindGameInstalls(data.egsRegistry(), GameId::tes5se, {});
+    ::benchmark::DoNotOptimize(install);
+  }
+
+  setAppsProcessed(state);
+}
+}
+}
+
+#endif
@@ -0,0 +1,109 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_BENCHMARKS_GUI_SYNTHETIC_GAME
+#define LOOT_BENCHMARKS_GUI_SYNTHETIC_GAME
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gui/state/game/game.h"
+#include "tests/gui/synthetic_load_order.h"
+#include "tests/gui/test_helpers.h"
+
+namespace loot {
+namespace bench {
+// A Skyrim Special Edition install in a temporary directory with a synthetic
+// load order of the given number of plugins, plus masterlist and userlist
+// metadata for them.
+class SyntheticGame {
+public:
+  explicit SyntheticGame(size_t pluginCount) :
+      rootPath_(test::getTempPath()),
+      gamePath_(rootPath_ / "game"),
+      localPath_(rootPath_ / "local"),
+      lootDataPath_(rootPath_ / "LOOT") {
+    const test::SyntheticLoadOrder syntheticLoadOrder(GAME_ID, pluginCount);
+    syntheticLoadOrder.write(gamePath_, localPath_);
+    loadOrder_ = syntheticLoadOrder.loadOrder();
+
+    std::filesystem::create_directories(lootDataPath_);
+    game_ = std::make_unique<gui::Game>(GameSettings(GAME_ID, "Skyrim SE")
+                                            .SetGamePath(gamePath_)
+                                            .SetGameLocalPath(localPath_),
+                                        lootDataPath_,
+                                        "");
+    game_->Init();
+
+    syntheticLoadOrder.writeMasterlist(game_->MasterlistPath());
+    syntheticLoadOrder.writeUserlist(game_->UserlistPath());
+  }
+
+  SyntheticGame(const SyntheticGame&) = delete;
+  SyntheticGame(SyntheticGame&&) = delete;
+
+  ~SyntheticGame() {
+    game_.reset();
+
+    std::error_code ec;
+    std::filesystem::remove_all(rootPath_, ec);
+  }
+
+  SyntheticGame& operator=(const SyntheticGame&) = delete;
+  SyntheticGame& operator=(SyntheticGame&&) = delete;
+
+  // Creating a synthetic game is slow, so each size is only created once.
+  static SyntheticGame& get(size_t pluginCount) {
+    static std::map<size_t, std::unique_ptr<SyntheticGame>> games;
+
+    auto& game = games[pluginCount];
+    if (!game) {
+      game = std::make_unique<SyntheticGame>(pluginCount);
+    }
+
+    return *game;
+  }
+
+  gui::Game& game() { return *game_; }
+
+  const std::vector<std::string>& loadOrder() const { return loadOrder_; }
+
+private:
+  static constexpr GameId GAME_ID = GameId::tes5se;
+
+  const std::filesystem::path rootPath_;
+  const std::filesystem::path gamePath_;
+  const std::filesystem::path localPath_;
+  const std::filesystem::path lootDataPath_;
+  std::vector<std::string> loadOrder_;
+  std::unique_ptr<gui::Game> game_;
+};
+}
+}
+
+#endif
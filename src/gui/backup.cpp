@@ -29,10 +29,456 @@
 #include <mz_strm.h>
 #include <mz_zip.h>
 #include <mz_zip_rw.h>
+#include <toml++/toml.h>
+#include <zlib.h>
 
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
+#include <algorithm>
 #include <cstdint>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <set>
+#include <vector>
 
 #include "gui/state/logging.h"
+#include "gui/state/thread_pool.h"
+
+namespace {
+using loot::getLogger;
+using loot::parallelFor;
+
+constexpr const char* BACKUP_OBJECTS_FOLDER = "objects";
+constexpr const char* COMPRESSED_OBJECT_EXTENSION = ".gz";
+constexpr const char* BACKUP_MANIFEST_EXTENSION = ".toml";
+constexpr const char* MANIFEST_FILES_KEY = "files";
+constexpr const char* MANIFEST_PATH_KEY = "path";
+constexpr const char* MANIFEST_HASH_KEY = "hash";
+constexpr const char* MANIFEST_SIZE_KEY = "size";
+constexpr const char* MANIFEST_WRITE_TIME_KEY = "write_time";
+
+struct BackupEntry {
+  std::string path;
+  std::string hash;
+  int64_t size{0};
+  int64_t writeTime{0};
+};
+
+void forEachFileToBackup(
+    const std::filesystem::path& sourceDir,
+    const std::function<void(const std::filesystem::path&)>& callback) {
+  auto logger = getLogger();
+
+  for (auto it = std::filesystem::recursive_directory_iterator(sourceDir);
+       it != std::filesystem::recursive_directory_iterator();
+       ++it) {
+    auto path = it->path();
+    auto filename = path.filename().u8string();
+
+    if (filename == ".git" ||
+        (it.depth() == 0 && (filename == "backups" || filename == "logs"))) {
+      // Don't recurse into .git folders or the root backups and old logs
+      // folders.
+      if (logger) {
+        logger->debug("Not recursing into directory {} at depth {}",
+                      filename,
+                      it.depth());
+      }
+      it.disable_recursion_pending();
+    }
+
+    if (!it->is_regular_file() ||
+        (it.depth() == 0 && filename == "LOOTDebugLog.txt")) {
+      // Skip copying the debug log and anything that isn't a normal file.
+      if (logger) {
+        logger->debug(
+            "Skipping directory entry {} at depth {}", filename, it.depth());
+      }
+      continue;
+    }
+
+    callback(path);
+  }
+}
+
+int64_t getWriteTime(const std::filesystem::path& filePath) {
+  return static_cast<int64_t>(
+      std::filesystem::last_write_time(filePath).time_since_epoch().count());
+}
+
+// Unlike the Git blob hashes used for masterlists, this hashes the file's
+// exact bytes, as the backup must preserve line endings.
+std::string calculateContentHash(const std::filesystem::path& filePath) {
+  QFile file(QString::fromStdString(filePath.u8string()));
+  if (!file.open(QIODevice::ReadOnly)) {
+    throw std::runtime_error(filePath.u8string() + " could not be read");
+  }
+
+  auto hasher = QCryptographicHash(QCryptographicHash::Sha1);
+  if (!hasher.addData(&file)) {
+    throw std::runtime_error(filePath.u8string() + " could not be read");
+  }
+
+  return QString(hasher.result().toHex()).toStdString();
+}
+
+toml::table readManifest(const std::filesystem::path& manifestPath) {
+  // Don't use toml::parse_file() as it just uses a std stream,
+  // which don't support UTF-8 paths on Windows.
+  std::ifstream in(manifestPath);
+  if (!in.is_open()) {
+    throw std::runtime_error(manifestPath.u8string() +
+                             " could not be opened for parsing");
+  }
+
+  return toml::parse(in, manifestPath.u8string());
+}
+
+std::vector<BackupEntry> readManifestEntries(
+    const std::filesystem::path& manifestPath) {
+  const auto manifest = readManifest(manifestPath);
+
+  const auto files = manifest[MANIFEST_FILES_KEY].as_array();
+  if (files == nullptr) {
+    throw std::runtime_error(manifestPath.u8string() +
+                             " does not contain a files array");
+  }
+
+  std::vector<BackupEntry> entries;
+  for (const auto& file : *files) {
+    const auto path = file.at_path(MANIFEST_PATH_KEY).value<std::string>();
+    const auto hash = file.at_path(MANIFEST_HASH_KEY).value<std::string>();
+    const auto size = file.at_path(MANIFEST_SIZE_KEY).value<int64_t>();
+    const auto writeTime =
+        file.at_path(MANIFEST_WRITE_TIME_KEY).value<int64_t>();
+
+    if (!path.has_value() || !hash.has_value() || !size.has_value() ||
+        !writeTime.has_value()) {
+      throw std::runtime_error(manifestPath.u8string() +
+                               " contains an invalid file entry");
+    }
+
+    entries.push_back(BackupEntry{
+        path.value(), hash.value(), size.value(), writeTime.value()});
+  }
+
+  return entries;
+}
+
+// Get the entries of the most recently written manifest, so that files that
+// haven't changed since then don't need to be read again.
+std::map<std::string, BackupEntry> readLatestManifestEntries(
+    const std::filesystem::path& backupsDir) {
+  std::optional<std::filesystem::path> latestManifestPath;
+  std::filesystem::file_time_type latestWriteTime;
+
+  std::error_code errorCode;
+  for (const auto& entry :
+       std::filesystem::directory_iterator(backupsDir, errorCode)) {
+    if (!entry.is_regular_file() ||
+        entry.path().extension() != BACKUP_MANIFEST_EXTENSION) {
+      continue;
+    }
+
+    const auto writeTime = entry.last_write_time();
+    if (!latestManifestPath.has_value() || writeTime > latestWriteTime) {
+      latestManifestPath = entry.path();
+      latestWriteTime = writeTime;
+    }
+  }
+
+  std::map<std::string, BackupEntry> entries;
+  if (!latestManifestPath.has_value()) {
+    return entries;
+  }
+
+  try {
+    for (auto& entry : readManifestEntries(latestManifestPath.value())) {
+      auto path = entry.path;
+      entries.emplace(path, std::move(entry));
+    }
+  } catch (const std::exception& e) {
+    // The previous backup is only an optimisation, so carry on without it.
+    auto logger = getLogger();
+    if (logger) {
+      logger->warn("Failed to read the backup manifest at {}: {}",
+                   latestManifestPath.value().u8string(),
+                   e.what());
+    }
+  }
+
+  return entries;
+}
+
+std::filesystem::path getCompressedObjectPath(
+    const std::filesystem::path& objectsDir,
+    const std::string& hash) {
+  auto path = objectsDir / hash;
+  path += COMPRESSED_OBJECT_EXTENSION;
+  return path;
+}
+
+// An object may be stored compressed or uncompressed depending on the
+// compression level that was used when it was first stored.
+std::optional<std::filesystem::path> findObject(
+    const std::filesystem::path& objectsDir,
+    const std::string& hash) {
+  auto path = objectsDir / hash;
+  if (std::filesystem::exists(path)) {
+    return path;
+  }
+
+  path = getCompressedObjectPath(objectsDir, hash);
+  if (std::filesystem::exists(path)) {
+    return path;
+  }
+
+  return std::nullopt;
+}
+
+// Objects are compressed as gzip files so that they can also be
+// decompressed using standard tools.
+constexpr int GZIP_WINDOW_BITS = 15 + 16;
+constexpr qint64 COMPRESSION_CHUNK_SIZE = 64 * 1024;
+
+// Stream the input through zlib in fixed-size chunks, so that large files
+// don't need to be held in memory. The process function calls deflate() or
+// inflate().
+void transformFile(z_stream& stream,
+                   const std::function<int(z_stream&, int)>& process,
+                   const std::filesystem::path& inputPath,
+                   const std::filesystem::path& outputPath) {
+  QFile input(QString::fromStdString(inputPath.u8string()));
+  if (!input.open(QIODevice::ReadOnly)) {
+    throw std::runtime_error(inputPath.u8string() + " could not be read");
+  }
+
+  QSaveFile output(QString::fromStdString(outputPath.u8string()));
+  if (!output.open(QIODevice::WriteOnly)) {
+    throw std::runtime_error("Failed to write " + outputPath.u8string());
+  }
+
+  std::vector<char> inputBuffer(COMPRESSION_CHUNK_SIZE);
+  std::vector<char> outputBuffer(COMPRESSION_CHUNK_SIZE);
+
+  int result = Z_OK;
+  int flush = Z_NO_FLUSH;
+  do {
+    const auto bytesRead =
+        input.read(inputBuffer.data(), COMPRESSION_CHUNK_SIZE);
+    if (bytesRead < 0) {
+      throw std::runtime_error(inputPath.u8string() + " could not be read");
+    }
+
+    flush = input.atEnd() ? Z_FINISH : Z_NO_FLUSH;
+    stream.next_in = reinterpret_cast<Bytef*>(inputBuffer.data());
+    stream.avail_in = static_cast<uInt>(bytesRead);
+
+    do {
+      stream.next_out = reinterpret_cast<Bytef*>(outputBuffer.data());
+      stream.avail_out = static_cast<uInt>(COMPRESSION_CHUNK_SIZE);
+
+      result = process(stream, flush);
+      if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR) {
+        throw std::runtime_error(inputPath.u8string() +
+                                 " could not be processed, zlib error " +
+                                 std::to_string(result));
+      }
+
+      const auto bytesOut = COMPRESSION_CHUNK_SIZE - stream.avail_out;
+      if (output.write(outputBuffer.data(), bytesOut) != bytesOut) {
+        throw std::runtime_error("Failed to write " + outputPath.u8string());
+      }
+    } while (stream.avail_out == 0);
+  } while (result != Z_STREAM_END && flush != Z_FINISH);
+
+  if (result != Z_STREAM_END) {
+    throw std::runtime_error(inputPath.u8string() + " is truncated");
+  }
+
+  if (!output.commit()) {
+    throw std::runtime_error("Failed to write " + outputPath.u8string());
+  }
+}
+
+void compressFile(const std::filesystem::path& inputPath,
+                  const std::filesystem::path& outputPath,
+                  int compressionLevel) {
+  z_stream stream{};
+  if (deflateInit2(&stream,
+                   compressionLevel,
+                   Z_DEFLATED,
+                   GZIP_WINDOW_BITS,
+                   8,
+                   Z_DEFAULT_STRATEGY) != Z_OK) {
+    throw std::runtime_error("Failed to initialise compression");
+  }
+
+  try {
+    transformFile(
+        stream,
+        [](z_stream& zStream, int flush) { return deflate(&zStream, flush); },
+        inputPath,
+        outputPath);
+  } catch (...) {
+    deflateEnd(&stream);
+    throw;
+  }
+
+  deflateEnd(&stream);
+}
+
+void decompressFile(const std::filesystem::path& inputPath,
+                    const std::filesystem::path& outputPath) {
+  z_stream stream{};
+  if (inflateInit2(&stream, GZIP_WINDOW_BITS) != Z_OK) {
+    throw std::runtime_error("Failed to initialise decompression");
+  }
+
+  try {
+    transformFile(
+        stream,
+        [](z_stream& zStream, int flush) { return inflate(&zStream, flush); },
+        inputPath,
+        outputPath);
+  } catch (...) {
+    inflateEnd(&stream);
+    throw;
+  }
+
+  inflateEnd(&stream);
+}
+
+// Copy the file into the objects folder, then hash the copy so that the
+// object's name is correct even if the source file changes while it's being
+// copied. The temporary name must be unique to the worker storing the file.
+std::string storeObject(const std::filesystem::path& filePath,
+                        const std::filesystem::path& objectsDir,
+                        const std::string& tempName,
+                        int compressionLevel) {
+  const auto tempPath = objectsDir / tempName;
+
+  std::filesystem::copy_file(
+      filePath, tempPath, std::filesystem::copy_options::overwrite_existing);
+
+  const auto hash = calculateContentHash(tempPath);
+
+  if (findObject(objectsDir, hash).has_value()) {
+    std::filesystem::remove(tempPath);
+  } else if (compressionLevel > 0 && std::filesystem::file_size(tempPath) > 0) {
+    compressFile(tempPath,
+                 getCompressedObjectPath(objectsDir, hash),
+                 compressionLevel);
+    std::filesystem::remove(tempPath);
+  } else {
+    std::filesystem::rename(tempPath, objectsDir / hash);
+  }
+
+  return hash;
+}
+
+// Store the files for the entries at the given indices concurrently, as much
+// of the time is spent hashing and compressing.
+void storeObjects(const std::filesystem::path& sourceDir,
+                  const std::filesystem::path& objectsDir,
+                  int compressionLevel,
+                  const std::vector<size_t>& indices,
+                  std::vector<BackupEntry>& entries) {
+  parallelFor(indices.size(), [&](size_t index) {
+    // Each object gets its own temporary file so that concurrent writes
+    // can't clash.
+    const auto tempName = ".incoming-" + std::to_string(index);
+    auto& entry = entries[indices[index]];
+    const auto filePath = sourceDir / std::filesystem::u8path(entry.path);
+
+    entry.hash = storeObject(filePath, objectsDir, tempName, compressionLevel);
+  });
+}
+
+struct StoredBackup {
+  std::filesystem::path path;
+  std::filesystem::file_time_type writeTime;
+  uintmax_t size{0};
+};
+
+// Only incremental backups are found, as zip backups may have been created by
+// older versions of LOOT and are left for the user to manage.
+std::vector<StoredBackup> findStoredBackups(
+    const std::filesystem::path& backupsDir) {
+  std::vector<StoredBackup> backups;
+
+  for (const auto& entry : std::filesystem::directory_iterator(backupsDir)) {
+    if (entry.is_regular_file() &&
+        entry.path().extension() == BACKUP_MANIFEST_EXTENSION) {
+      backups.push_back(StoredBackup{
+          entry.path(), entry.last_write_time(), entry.file_size()});
+    }
+  }
+
+  // Sort the backups from newest to oldest.
+  std::sort(backups.begin(),
+            backups.end(),
+            [](const StoredBackup& lhs, const StoredBackup& rhs) {
+              return lhs.writeTime > rhs.writeTime;
+            });
+
+  return backups;
+}
+
+std::map<std::string, uintmax_t> getObjectSizes(
+    const std::filesystem::path& objectsDir) {
+  std::map<std::string, uintmax_t> sizes;
+
+  std::error_code errorCode;
+  for (const auto& entry :
+       std::filesystem::directory_iterator(objectsDir, errorCode)) {
+    if (!entry.is_regular_file()) {
+      continue;
+    }
+
+    auto hash = entry.path().filename().u8string();
+    if (entry.path().extension() == COMPRESSED_OBJECT_EXTENSION) {
+      hash = entry.path().stem().u8string();
+    }
+
+    sizes[hash] += entry.file_size();
+  }
+
+  return sizes;
+}
+
+void writeManifest(const std::filesystem::path& manifestPath,
+                   const std::vector<BackupEntry>& entries) {
+  toml::array files;
+  for (const auto& entry : entries) {
+    files.push_back(toml::table{
+        {MANIFEST_PATH_KEY, entry.path},
+        {MANIFEST_HASH_KEY, entry.hash},
+        {MANIFEST_SIZE_KEY, entry.size},
+        {MANIFEST_WRITE_TIME_KEY, entry.writeTime},
+    });
+  }
+
+  const toml::table manifest{{MANIFEST_FILES_KEY, files}};
+
+  // Write to a temporary file first so that an interrupted backup doesn't
+  // leave a truncated manifest.
+  auto tempPath = manifestPath;
+  tempPath += ".tmp";
+
+  std::ofstream out(tempPath);
+  out << manifest;
+  out.close();
+
+  if (out.fail()) {
+    throw std::runtime_error("Failed to write " + tempPath.u8string());
+  }
+
+  std::filesystem::rename(tempPath, manifestPath);
+}
+}
 
 namespace loot {
 std::filesystem::path compressDirectory(const std::filesystem::path& dir) {
@@ -93,42 +539,195 @@ void createBackup(const std::filesystem::path& sourceDir,
                   destDir.u8string());
   }
 
-  for (auto it = std::filesystem::recursive_directory_iterator(sourceDir);
-       it != std::filesystem::recursive_directory_iterator();
-       ++it) {
-    auto path = it->path();
-    auto filename = path.filename().u8string();
+  forEachFileToBackup(sourceDir, [&](const std::filesystem::path& path) {
+    auto destPath = destDir / path.lexically_relative(sourceDir);
 
-    if (filename == ".git" || (it.depth() == 0 && filename == "backups")) {
-      // Don't recurse into .git folders or the root backups folder.
-      if (logger) {
-        logger->debug("Not recursing into directory {} at depth {}",
-                      filename,
-                      it.depth());
-      }
-      it.disable_recursion_pending();
+    std::filesystem::create_directories(destPath.parent_path());
+
+    std::filesystem::copy(path, destPath);
+  });
+
+  if (logger) {
+    logger->info(
+        "Backup of {} created in {}", sourceDir.u8string(), destDir.u8string());
+  }
+}
+
+std::optional<std::filesystem::path> createIncrementalBackup(
+    const std::filesystem::path& sourceDir,
+    const std::filesystem::path& backupsDir,
+    const std::string& backupName,
+    int compressionLevel) {
+  auto logger = getLogger();
+  if (logger) {
+    logger->trace("Creating incremental backup of {} in {}",
+                  sourceDir.u8string(),
+                  backupsDir.u8string());
+  }
+
+  const auto previousEntries = readLatestManifestEntries(backupsDir);
+  const auto objectsDir = backupsDir / BACKUP_OBJECTS_FOLDER;
+
+  std::vector<BackupEntry> entries;
+  std::vector<size_t> changedIndices;
+  forEachFileToBackup(sourceDir, [&](const std::filesystem::path& path) {
+    if (entries.empty()) {
+      std::filesystem::create_directories(objectsDir);
     }
 
-    if (!it->is_regular_file() ||
-        (it.depth() == 0 && filename == "LOOTDebugLog.txt")) {
-      // Skip copying the debug log and anything that isn't a normal file.
+    BackupEntry entry;
+    entry.path = path.lexically_relative(sourceDir).generic_u8string();
+    entry.size = static_cast<int64_t>(std::filesystem::file_size(path));
+    entry.writeTime = getWriteTime(path);
+
+    // Assume that the file is unchanged if its size and write time are the
+    // same as in the previous backup.
+    const auto previous = previousEntries.find(entry.path);
+    if (previous != previousEntries.end() &&
+        previous->second.size == entry.size &&
+        previous->second.writeTime == entry.writeTime &&
+        findObject(objectsDir, previous->second.hash).has_value()) {
+      entry.hash = previous->second.hash;
+    } else {
+      changedIndices.push_back(entries.size());
+    }
+
+    entries.push_back(entry);
+  });
+
+  if (entries.empty()) {
+    return std::nullopt;
+  }
+
+  storeObjects(
+      sourceDir, objectsDir, compressionLevel, changedIndices, entries);
+
+  auto manifestPath = backupsDir / std::filesystem::u8path(backupName);
+  manifestPath += BACKUP_MANIFEST_EXTENSION;
+
+  writeManifest(manifestPath, entries);
+
+  if (logger) {
+    logger->info(
+        "Backup of {} created in {}, {} of {} files were read and stored",
+        sourceDir.u8string(),
+        manifestPath.u8string(),
+        changedIndices.size(),
+        entries.size());
+  }
+
+  return manifestPath;
+}
+
+size_t enforceBackupRetentionPolicy(const std::filesystem::path& backupsDir,
+                                    const BackupRetentionPolicy& policy) {
+  if (!std::filesystem::exists(backupsDir)) {
+    return 0;
+  }
+
+  const auto objectsDir = backupsDir / BACKUP_OBJECTS_FOLDER;
+  const auto objectSizes = getObjectSizes(objectsDir);
+  const auto backups = findStoredBackups(backupsDir);
+  const auto now = std::filesystem::file_time_type::clock::now();
+
+  // Keep backups from newest to oldest until one exceeds a limit. Content
+  // that's shared between backups only counts towards the size of the first
+  // backup it appears in.
+  std::set<std::string> referencedHashes;
+  bool canCollectObjects = true;
+  uintmax_t totalSize = 0;
+  size_t keptCount = 0;
+  for (const auto& backup : backups) {
+    auto backupSize = backup.size;
+    std::vector<std::string> backupHashes;
+    try {
+      for (const auto& entry : readManifestEntries(backup.path)) {
+        if (referencedHashes.count(entry.hash) == 0) {
+          const auto objectSize = objectSizes.find(entry.hash);
+          if (objectSize != objectSizes.end()) {
+            backupSize += objectSize->second;
+          }
+        }
+        backupHashes.push_back(entry.hash);
+      }
+    } catch (const std::exception& e) {
+      // Without knowing what the manifest references, no content can be
+      // safely deleted.
+      canCollectObjects = false;
+
+      auto logger = getLogger();
       if (logger) {
-        logger->debug(
-            "Skipping directory entry {} at depth {}", filename, it.depth());
+        logger->warn("Failed to read the backup manifest at {}: {}",
+                     backup.path.u8string(),
+                     e.what());
       }
-      continue;
     }
 
-    auto destPath = destDir / path.lexically_relative(sourceDir);
+    const auto isWithinLimits =
+        (policy.maxCount == 0 || keptCount < policy.maxCount) &&
+        (policy.maxTotalSize == 0 ||
+         totalSize + backupSize <= policy.maxTotalSize) &&
+        (policy.maxAge.count() == 0 || now - backup.writeTime <= policy.maxAge);
 
-    std::filesystem::create_directories(destPath.parent_path());
+    if (keptCount > 0 && !isWithinLimits) {
+      break;
+    }
 
-    std::filesystem::copy(path, destPath);
+    referencedHashes.insert(backupHashes.begin(), backupHashes.end());
+    totalSize += backupSize;
+    keptCount += 1;
+  }
+
+  auto logger = getLogger();
+  for (size_t i = keptCount; i < backups.size(); i += 1) {
+    if (logger) {
+      logger->info("Deleting old backup {}", backups[i].path.u8string());
+    }
+    std::filesystem::remove(backups[i].path);
   }
 
+  if (canCollectObjects) {
+    for (const auto& [hash, size] : objectSizes) {
+      if (referencedHashes.count(hash) == 0) {
+        std::filesystem::remove(objectsDir / hash);
+        std::filesystem::remove(getCompressedObjectPath(objectsDir, hash));
+      }
+    }
+  }
+
+  return backups.size() - keptCount;
+}
+
+void restoreIncrementalBackup(const std::filesystem::path& manifestPath,
+                              const std::filesystem::path& destDir) {
+  auto logger = getLogger();
   if (logger) {
-    logger->info(
-        "Backup of {} created in {}", sourceDir.u8string(), destDir.u8string());
+    logger->trace("Restoring backup {} to {}",
+                  manifestPath.u8string(),
+                  destDir.u8string());
+  }
+
+  const auto objectsDir = manifestPath.parent_path() / BACKUP_OBJECTS_FOLDER;
+
+  for (const auto& entry : readManifestEntries(manifestPath)) {
+    const auto objectPath = findObject(objectsDir, entry.hash);
+    if (!objectPath.has_value()) {
+      throw std::runtime_error("The backup object for " + entry.path +
+                               " is missing");
+    }
+
+    const auto destPath = destDir / std::filesystem::u8path(entry.path);
+
+    std::filesystem::create_directories(destPath.parent_path());
+
+    if (objectPath.value().extension() == COMPRESSED_OBJECT_EXTENSION) {
+      decompressFile(objectPath.value(), destPath);
+    } else {
+      std::filesystem::copy_file(
+          objectPath.value(),
+          destPath,
+          std::filesystem::copy_options::overwrite_existing);
+    }
   }
 }
 }
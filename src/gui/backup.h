@@ -26,13 +26,49 @@
 #ifndef LOOT_GUI_BACKUP
 #define LOOT_GUI_BACKUP
 
+#include <chrono>
+#include <cstdint>
 #include <filesystem>
+#include <optional>
+#include <string>
 
 namespace loot {
+// Limits of zero are not enforced.
+struct BackupRetentionPolicy {
+  size_t maxCount{0};
+  uintmax_t maxTotalSize{0};
+  std::chrono::hours maxAge{0};
+};
+
 std::filesystem::path compressDirectory(const std::filesystem::path& dir);
 
 void createBackup(const std::filesystem::path& sourceDir,
                   const std::filesystem::path& destDir);
+
+// Backs up the same files as createBackup(), but stores each distinct file
+// content only once in an objects folder inside backupsDir, so files that are
+// unchanged since a previous backup aren't copied again. The files in the
+// backup are listed in a manifest file named after the backup, and its path is
+// returned. Returns nothing if there were no files to back up.
+//
+// A compression level from 1 to 9 deflates newly-stored content at that
+// level, while 0 stores it uncompressed.
+std::optional<std::filesystem::path> createIncrementalBackup(
+    const std::filesystem::path& sourceDir,
+    const std::filesystem::path& backupsDir,
+    const std::string& backupName,
+    int compressionLevel = 0);
+
+void restoreIncrementalBackup(const std::filesystem::path& manifestPath,
+                              const std::filesystem::path& destDir);
+
+// Deletes the oldest incremental backups in backupsDir until the remaining
+// backups are within the given limits, then deletes any stored content that is
+// no longer referenced. The most recent backup is always kept, and zip backups
+// are never deleted or counted towards the limits.
+// Returns the number of backups that were deleted.
+size_t enforceBackupRetentionPolicy(const std::filesystem::path& backupsDir,
+                                    const BackupRetentionPolicy& policy);
 }
 
 #endif
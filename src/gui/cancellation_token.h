@@ -0,0 +1,60 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_CANCELLATION_TOKEN
+#define LOOT_GUI_CANCELLATION_TOKEN
+
+#include <atomic>
+#include <stdexcept>
+
+namespace loot {
+class CancelledError : public std::runtime_error {
+public:
+  CancelledError() : std::runtime_error("The operation was cancelled") {}
+};
+
+// Lets one thread ask an operation running on another thread to stop early.
+// Cancellation is cooperative: the operation checks the token between units
+// of work, and throws a CancelledError once the token has been cancelled.
+class CancellationToken {
+public:
+  void cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+
+  bool isCancelled() const {
+    return cancelled_.load(std::memory_order_relaxed);
+  }
+
+  void throwIfCancelled() const {
+    if (isCancelled()) {
+      throw CancelledError();
+    }
+  }
+
+private:
+  std::atomic<bool> cancelled_{false};
+};
+}
+
+#endif
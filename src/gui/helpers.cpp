@@ -38,8 +38,11 @@
 #include <shlobj.h>
 #include <shlwapi.h>
 #include <windows.h>
+#include <winioctl.h>
 #else
 #include <mntent.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
 #include <unicode/uchar.h>
 #include <unicode/unistr.h>
 
@@ -50,8 +53,12 @@
 #include <spdlog/fmt/ranges.h>
 
 #include <boost/algorithm/string.hpp>
+#include <algorithm>
 #include <boost/locale.hpp>
 #include <fstream>
+#include <future>
+#include <optional>
+#include <thread>
 
 #include "gui/state/logging.h"
 
@@ -143,6 +150,54 @@ const char* getDriveTypeText(UINT driveType) {
   }
 }
 #endif
+
+bool IsAscii(unsigned char c) { return c < 0x80; }
+
+// Map ASCII letters to the same case that CompareFilenames' Unicode-aware
+// comparison compares them in, so that the ASCII comparison orders names the
+// same way.
+unsigned char FoldAsciiCase(unsigned char c) {
+#ifdef _WIN32
+  return c >= 'a' && c <= 'z' ? c - ('a' - 'A') : c;
+#else
+  return c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c;
+#endif
+}
+
+// Returns std::nullopt if the strings contain non-ASCII characters that could
+// affect the result.
+std::optional<int> CompareAsciiFilenames(const std::string& lhs,
+                                         const std::string& rhs) {
+  const auto commonSize = std::min(lhs.size(), rhs.size());
+  for (size_t i = 0; i < commonSize; ++i) {
+    const auto lhsChar = static_cast<unsigned char>(lhs[i]);
+    const auto rhsChar = static_cast<unsigned char>(rhs[i]);
+    if (!IsAscii(lhsChar) || !IsAscii(rhsChar)) {
+      return std::nullopt;
+    }
+
+    const auto lhsFolded = FoldAsciiCase(lhsChar);
+    const auto rhsFolded = FoldAsciiCase(rhsChar);
+    if (lhsFolded != rhsFolded) {
+      return lhsFolded < rhsFolded ? -1 : 1;
+    }
+  }
+
+  // The longer string is greater, but only if its remaining characters are
+  // valid, so check that they're ASCII too.
+  const auto& longer = lhs.size() < rhs.size() ? rhs : lhs;
+  for (size_t i = commonSize; i < longer.size(); ++i) {
+    if (!IsAscii(static_cast<unsigned char>(longer[i]))) {
+      return std::nullopt;
+    }
+  }
+
+  if (lhs.size() == rhs.size()) {
+    return 0;
+  }
+
+  return lhs.size() < rhs.size() ? -1 : 1;
+}
 }
 
 namespace loot {
@@ -438,7 +493,181 @@ std::optional<std::filesystem::path> FindXboxGamingRootPath(
   return driveRootPath / relativePath;
 }
 
+std::vector<XboxGamingRootProbeResult> FindXboxGamingRootPaths(
+    const std::vector<std::filesystem::path>& driveRootPaths,
+    std::chrono::milliseconds timeout) {
+  std::vector<std::future<std::optional<std::filesystem::path>>> futures;
+
+  for (const auto& driveRootPath : driveRootPaths) {
+    std::promise<std::optional<std::filesystem::path>> promise;
+    futures.push_back(promise.get_future());
+
+    // Use a detached thread instead of std::async, as the future returned by
+    // std::async blocks on destruction until its task completes, and a probe
+    // of an unresponsive drive may never complete.
+    std::thread([promise = std::move(promise), driveRootPath]() mutable {
+      try {
+        promise.set_value(FindXboxGamingRootPath(driveRootPath));
+      } catch (...) {
+        promise.set_exception(std::current_exception());
+      }
+    }).detach();
+  }
+
+  const auto logger = getLogger();
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+  std::vector<XboxGamingRootProbeResult> results;
+  for (size_t i = 0; i < futures.size(); i += 1) {
+    XboxGamingRootProbeResult result;
+    result.driveRootPath = driveRootPaths.at(i);
+
+    if (futures.at(i).wait_until(deadline) != std::future_status::ready) {
+      if (logger) {
+        logger->warn(
+            "Timed out while looking for an Xbox gaming root on drive {}",
+            result.driveRootPath.u8string());
+      }
+
+      result.timedOut = true;
+    } else {
+      try {
+        result.gamingRootPath = futures.at(i).get();
+      } catch (const std::exception& e) {
+        if (logger) {
+          logger->error(
+              "Failed to look for an Xbox gaming root on drive {}: {}",
+              result.driveRootPath.u8string(),
+              e.what());
+        }
+      }
+    }
+
+    results.push_back(result);
+  }
+
+  return results;
+}
+
+std::string GetDriveId(const std::filesystem::path& path) {
+#ifdef _WIN32
+  std::wstring volumePath(MAX_PATH, 0);
+  if (!GetVolumePathName(path.wstring().c_str(),
+                         volumePath.data(),
+                         static_cast<DWORD>(volumePath.size()))) {
+    return std::string();
+  }
+
+  volumePath.resize(wcslen(volumePath.c_str()));
+
+  return FromWinWide(volumePath);
+#else
+  struct stat pathStat {};
+  if (stat(path.c_str(), &pathStat) != 0) {
+    return std::string();
+  }
+
+  return fmt::format("{}:{}", major(pathStat.st_dev), minor(pathStat.st_dev));
+#endif
+}
+
+bool IsRotationalDrive(const std::string& driveId) {
+  if (driveId.empty()) {
+    return false;
+  }
+
+  const auto logger = getLogger();
+
+#ifdef _WIN32
+  // The volume path is something like "C:\", but opening the volume requires
+  // a device path like "\\.\C:".
+  auto devicePath = L"\\\\.\\" + ToWinWide(driveId);
+  if (!devicePath.empty() && devicePath.back() == L'\\') {
+    devicePath.pop_back();
+  }
+
+  const auto handle = CreateFile(devicePath.c_str(),
+                                 0,
+                                 FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                 nullptr,
+                                 OPEN_EXISTING,
+                                 0,
+                                 nullptr);
+  if (handle == INVALID_HANDLE_VALUE) {
+    if (logger) {
+      logger->debug("Failed to open the volume {} to query its seek penalty",
+                    driveId);
+    }
+    return false;
+  }
+
+  STORAGE_PROPERTY_QUERY query{};
+  query.PropertyId = StorageDeviceSeekPenaltyProperty;
+  query.QueryType = PropertyStandardQuery;
+
+  DEVICE_SEEK_PENALTY_DESCRIPTOR descriptor{};
+  DWORD bytesReturned = 0;
+  const auto result = DeviceIoControl(handle,
+                                      IOCTL_STORAGE_QUERY_PROPERTY,
+                                      &query,
+                                      sizeof(query),
+                                      &descriptor,
+                                      sizeof(descriptor),
+                                      &bytesReturned,
+                                      nullptr);
+  CloseHandle(handle);
+
+  if (!result) {
+    if (logger) {
+      logger->debug("Failed to query the seek penalty of the volume {}",
+                    driveId);
+    }
+    return false;
+  }
+
+  const auto isRotational = descriptor.IncursSeekPenalty != FALSE;
+#else
+  // The device may be a partition, in which case its queue information is
+  // held by its parent device.
+  const auto devicePath = std::filesystem::path("/sys/dev/block") / driveId;
+  std::error_code errorCode;
+  auto rotationalPath = devicePath / "queue" / "rotational";
+  if (!std::filesystem::exists(rotationalPath, errorCode)) {
+    rotationalPath =
+        std::filesystem::canonical(devicePath, errorCode).parent_path() /
+        "queue" / "rotational";
+  }
+
+  std::ifstream in(rotationalPath);
+  int rotational = 0;
+  if (!(in >> rotational)) {
+    if (logger) {
+      logger->debug("Failed to read whether the device {} is rotational",
+                    driveId);
+    }
+    return false;
+  }
+
+  const auto isRotational = rotational != 0;
+#endif
+
+  if (logger) {
+    logger->debug("The drive {} is {}",
+                  driveId,
+                  isRotational ? "rotational" : "not rotational");
+  }
+
+  return isRotational;
+}
+
 int CompareFilenames(const std::string& lhs, const std::string& rhs) {
+  // Nearly all plugin filenames are ASCII, and comparing them doesn't need
+  // any conversions.
+  const auto asciiResult = CompareAsciiFilenames(lhs, rhs);
+  if (asciiResult.has_value()) {
+    return asciiResult.value();
+  }
+
 #ifdef _WIN32
   // On Windows, use CompareStringOrdinal as that will perform case conversion
   // using the operating system uppercase table information, which (I think)
@@ -463,6 +692,17 @@ int CompareFilenames(const std::string& lhs, const std::string& rhs) {
 #endif
 }
 
+std::string NormalisePluginName(const std::string& pluginName) {
+  const auto isAscii = std::all_of(pluginName.begin(),
+                                   pluginName.end(),
+                                   [](char c) { return IsAscii(c); });
+  if (!isAscii) {
+    return boost::locale::to_lower(pluginName);
+  }
+
+  return boost::to_lower_copy(pluginName, std::locale::classic());
+}
+
 std::filesystem::path getExecutableDirectory() {
 #ifdef _WIN32
   // Despite its name, paths can be longer than MAX_PATH, just not by default.
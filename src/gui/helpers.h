@@ -27,8 +27,10 @@
 
 #include <loot/enum/message_type.h>
 
+#include <chrono>
 #include <filesystem>
 #include <optional>
+#include <string>
 #include <vector>
 
 #include "gui/sourced_message.h"
@@ -47,12 +49,42 @@ std::vector<std::filesystem::path> GetDriveRootPaths();
 std::optional<std::filesystem::path> FindXboxGamingRootPath(
     const std::filesystem::path& driveRootPath);
 
+struct XboxGamingRootProbeResult {
+  std::filesystem::path driveRootPath;
+  bool timedOut{false};
+  std::optional<std::filesystem::path> gamingRootPath;
+};
+
+// Look for Xbox gaming roots on all the given drives concurrently, waiting no
+// longer than the given timeout in total. Probes of drives that don't respond
+// in time are left to finish in the background and their results are marked
+// as timed out. The results are in the same order as the given drives.
+std::vector<XboxGamingRootProbeResult> FindXboxGamingRootPaths(
+    const std::vector<std::filesystem::path>& driveRootPaths,
+    std::chrono::milliseconds timeout);
+
+// Get an identifier for the drive that the given path is on. Paths on the same
+// drive have the same identifier. Returns an empty string if the drive can't
+// be identified.
+std::string GetDriveId(const std::filesystem::path& path);
+
+// Check if the drive with the given identifier (as returned by GetDriveId())
+// incurs a seek penalty, i.e. is a rotational disk. Returns false if that
+// can't be determined.
+bool IsRotationalDrive(const std::string& driveId);
+
 // Compare strings as if they're filenames, respecting filesystem case
 // insensitivity on Windows. Returns -1 if lhs < rhs, 0 if lhs == rhs, and 1 if
 // lhs > rhs. The comparison may give different results on Linux, but is still
 // locale-invariant.
 int CompareFilenames(const std::string& lhs, const std::string& rhs);
 
+// Lowercase the given plugin name for use as a case-insensitive lookup key.
+// ASCII names are lowercased directly, which is much cheaper than going
+// through Boost.Locale, so keys and the names looked up must both be
+// normalised using this function.
+std::string NormalisePluginName(const std::string& pluginName);
+
 std::filesystem::path getExecutableDirectory();
 
 std::filesystem::path getUserProfilePath();
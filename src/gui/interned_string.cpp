@@ -0,0 +1,80 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/interned_string.h"
+
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace {
+struct StringPool {
+  std::shared_mutex mutex;
+  // Deque elements never move when more are added at the end, so pointers to
+  // them and views of their contents stay valid as more strings are added.
+  std::deque<std::string> strings;
+  // Indexing the strings by views of themselves means that looking up a
+  // string that's already pooled doesn't need to copy the value into a key.
+  std::unordered_map<std::string_view, const std::string*> index;
+};
+
+StringPool& getStringPool() {
+  static StringPool pool;
+  return pool;
+}
+
+const std::string* intern(std::string_view value) {
+  auto& pool = getStringPool();
+
+  {
+    std::shared_lock lock(pool.mutex);
+    const auto it = pool.index.find(value);
+    if (it != pool.index.end()) {
+      return it->second;
+    }
+  }
+
+  std::unique_lock lock(pool.mutex);
+
+  // Another thread may have added the value while the lock was released.
+  const auto it = pool.index.find(value);
+  if (it != pool.index.end()) {
+    return it->second;
+  }
+
+  const auto& string = pool.strings.emplace_back(value);
+  pool.index.emplace(std::string_view(string), &string);
+
+  return &string;
+}
+}
+
+namespace loot {
+InternedString::InternedString() : InternedString(std::string_view()) {}
+
+InternedString::InternedString(std::string_view value) :
+    value_(intern(value)) {}
+}
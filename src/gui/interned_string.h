@@ -0,0 +1,75 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_INTERNED_STRING
+#define LOOT_GUI_INTERNED_STRING
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace loot {
+// A string that's stored once in a process-wide pool, so that copies are
+// pointer-sized and equality checks are pointer comparisons. Intended for
+// values that come from a small vocabulary, such as Bash Tag, group and
+// cleaning utility names. Pooled strings are never freed.
+class InternedString {
+public:
+  InternedString();
+  explicit InternedString(std::string_view value);
+
+  const std::string& str() const noexcept { return *value_; }
+
+  operator const std::string&() const noexcept { return *value_; }
+
+  bool empty() const noexcept { return value_->empty(); }
+
+private:
+  const std::string* value_;
+
+  friend bool operator==(const InternedString& lhs,
+                         const InternedString& rhs) noexcept {
+    return lhs.value_ == rhs.value_;
+  }
+
+  friend bool operator!=(const InternedString& lhs,
+                         const InternedString& rhs) noexcept {
+    return lhs.value_ != rhs.value_;
+  }
+};
+}
+
+namespace std {
+template<>
+struct hash<loot::InternedString> {
+  size_t operator()(const loot::InternedString& value) const noexcept {
+    // Equal interned strings share the same pooled string, so its address
+    // identifies the value.
+    return hash<const std::string*>()(&value.str());
+  }
+};
+}
+
+#endif
@@ -28,14 +28,23 @@
 #include <spdlog/fmt/fmt.h>
 
 #include <boost/algorithm/string.hpp>
-#include <boost/locale.hpp>
+#include <map>
+#include <string_view>
 #include <variant>
 
 #include "gui/helpers.h"
+#include "gui/state/diagnostics.h"
 #include "gui/state/game/helpers.h"
 #include "gui/state/logging.h"
+#include "gui/state/timing.h"
+#include "gui/translation_cache.h"
 
 namespace loot {
+// Separates the fields in an item's lowercase search text.
+static constexpr char SEARCH_FIELD_SEPARATOR = '\0';
+
+static CacheCounter reusedPluginItemsCounter("Reused plugin items");
+
 std::variant<std::optional<PluginMetadata>, SourcedMessage>
 evaluateMasterlistMetadata(const gui::Game& game,
                            const std::string& pluginName) {
@@ -54,12 +63,11 @@ evaluateMasterlistMetadata(const gui::Game& game,
     return CreatePlainTextSourcedMessage(
         MessageType::error,
         MessageSource::caughtException,
-        fmt::format(boost::locale::translate(
-                        "\"{0}\" contains a condition that could not be "
-                        "evaluated. Details: {1}")
-                        .str(),
-                    pluginName,
-                    e.what()));
+        fmt::format(
+            TranslateCached("\"{0}\" contains a condition that could not be "
+                            "evaluated. Details: {1}"),
+            pluginName,
+            e.what()));
   }
 }
 
@@ -80,12 +88,11 @@ evaluateUserlistMetadata(const gui::Game& game, const std::string& pluginName) {
     return CreatePlainTextSourcedMessage(
         MessageType::error,
         MessageSource::caughtException,
-        fmt::format(boost::locale::translate(
-                        "\"{0}\" contains a condition that could not be "
-                        "evaluated. Details: {1}")
-                        .str(),
-                    pluginName,
-                    e.what()));
+        fmt::format(
+            TranslateCached("\"{0}\" contains a condition that could not be "
+                            "evaluated. Details: {1}"),
+            pluginName,
+            e.what()));
   }
 }
 
@@ -123,6 +130,102 @@ std::pair<PluginMetadata, std::vector<SourcedMessage>> evaluateMetadata(
   return {metadata, evalErrors};
 }
 
+// Check if the given item was derived from the same plugin data, active state
+// and game evaluation state, which covers the other plugins and files that
+// conditions and validity checks depend on. Metadata isn't compared, as the
+// item would have been updated when the metadata changed.
+bool hasSamePluginData(const PluginItem& item,
+                       const PluginInterface& plugin,
+                       const gui::Game& game,
+                       bool isActive,
+                       uint64_t evaluationStateHash) {
+  // A missing CRC means that the item was derived from the plugin's header
+  // only and its CRC wasn't cached, so it's out of date if the plugin has
+  // since been fully loaded.
+  if (item.evaluationStateHash != evaluationStateHash ||
+      !item.crc.has_value() || item.crc != game.GetPluginCrc(plugin) ||
+      item.isActive != isActive || item.version != plugin.GetVersion() ||
+      item.isEmpty != plugin.IsEmpty() || item.isMaster != plugin.IsMaster() ||
+      item.isLightPlugin != plugin.IsLightPlugin() ||
+      item.isMediumPlugin != plugin.IsMediumPlugin() ||
+      item.loadsArchive != plugin.LoadsArchive()) {
+    return false;
+  }
+
+  const auto tags = plugin.GetBashTags();
+  return std::equal(item.currentTags.begin(),
+                    item.currentTags.end(),
+                    tags.begin(),
+                    tags.end(),
+                    [](const InternedString& tagName, const Tag& tag) {
+                      return tagName.str() == tag.GetName();
+                    });
+}
+
+void appendJoinedNames(std::string& text,
+                       const std::vector<InternedString>& names) {
+  for (size_t i = 0; i < names.size(); i += 1) {
+    if (i > 0) {
+      text += ", ";
+    }
+    text += names[i].str();
+  }
+}
+
+// Get the length of the given names when joined with appendJoinedNames().
+size_t namesSize(const std::vector<InternedString>& names) {
+  size_t size = 0;
+  for (const auto& name : names) {
+    size += name.str().size() + 2;
+  }
+
+  return size;
+}
+
+// Join the fields with null characters, which the search text won't contain,
+// so that a match can't span two fields. Fields can contain line breaks (e.g.
+// in messages), so they can't be used as the separator.
+std::string buildLowercaseSearchText(const PluginItem& item) {
+  std::string text = item.name;
+
+  const auto appendField = [&](const std::string& field) {
+    text += SEARCH_FIELD_SEPARATOR;
+    text += field;
+  };
+
+  if (item.version.has_value()) {
+    appendField(item.version.value());
+  }
+
+  if (item.crc.has_value()) {
+    appendField(crcToString(item.crc.value()));
+  }
+
+  for (const auto& tag : item.currentTags) {
+    appendField(tag);
+  }
+
+  for (const auto& tag : item.addTags) {
+    appendField(tag);
+  }
+
+  for (const auto& tag : item.removeTags) {
+    appendField(tag);
+  }
+
+  for (const auto& message : item.messages) {
+    appendField(message.text);
+  }
+
+  for (const auto& location : item.locations) {
+    appendField(location.GetName());
+  }
+
+  boost::to_lower(text);
+
+  return text;
+}
+
 PluginItem::PluginItem(GameId gameId,
                        const PluginInterface& plugin,
                        const gui::Game& game,
@@ -132,7 +235,7 @@ PluginItem::PluginItem(GameId gameId,
     gameId(gameId),
     name(plugin.GetName()),
     loadOrderIndex(loadOrderIndex),
-    crc(plugin.GetCRC()),
+    crc(game.GetPluginCrc(plugin)),
     version(plugin.GetVersion()),
     isActive(isActive),
     isEmpty(plugin.IsEmpty()),
@@ -140,7 +243,8 @@ PluginItem::PluginItem(GameId gameId,
     isLightPlugin(plugin.IsLightPlugin()),
     isMediumPlugin(plugin.IsMediumPlugin()),
     loadsArchive(plugin.LoadsArchive()),
-    isCreationClubPlugin(game.IsCreationClubPlugin(plugin.GetName())) {
+    isCreationClubPlugin(game.IsCreationClubPlugin(plugin.GetName())),
+    isOfficial(IsOfficialPlugin(gameId, plugin.GetName())) {
   auto userMetadata = game.GetUserMetadata(plugin.GetName());
   if (userMetadata.has_value()) {
     hasUserMetadata =
@@ -151,7 +255,10 @@ PluginItem::PluginItem(GameId gameId,
       evaluateMetadata(game, plugin.GetName());
 
   isDirty = !evaluatedMetadata.GetDirtyInfo().empty();
-  group = evaluatedMetadata.GetGroup();
+  const auto evaluatedGroup = evaluatedMetadata.GetGroup();
+  if (evaluatedGroup.has_value()) {
+    group = InternedString(evaluatedGroup.value());
+  }
 
   messages.insert(messages.end(), evalErrors.begin(), evalErrors.end());
 
@@ -168,19 +275,19 @@ PluginItem::PluginItem(GameId gameId,
       messages.end(), validityMessages.begin(), validityMessages.end());
 
   if (!evaluatedMetadata.GetCleanInfo().empty()) {
-    cleaningUtility =
-        evaluatedMetadata.GetCleanInfo().begin()->GetCleaningUtility();
+    cleaningUtility = InternedString(
+        evaluatedMetadata.GetCleanInfo().begin()->GetCleaningUtility());
   }
 
   for (const auto& tag : plugin.GetBashTags()) {
-    currentTags.push_back(tag.GetName());
+    currentTags.emplace_back(tag.GetName());
   }
 
   for (const auto& tag : evaluatedMetadata.GetTags()) {
     if (tag.IsAddition()) {
-      addTags.push_back(tag.GetName());
+      addTags.emplace_back(tag.GetName());
     } else {
-      removeTags.push_back(tag.GetName());
+      removeTags.emplace_back(tag.GetName());
     }
   }
 
@@ -189,142 +296,111 @@ PluginItem::PluginItem(GameId gameId,
   // Set numbered names for locations with no existing name so that URLs
   // don't appear in the UI.
   if (locations.size() == 1 && locations[0].GetName().empty()) {
-    locations[0] =
-        Location(locations[0].GetURL(), boost::locale::translate("Location"));
+    locations[0] = Location(locations[0].GetURL(), TranslateCached("Location"));
   } else if (locations.size() > 1) {
     for (size_t i = 0; i < locations.size(); i += 1) {
       if (locations[i].GetName().empty()) {
         const auto locationName =
-            fmt::format(boost::locale::translate("Location {0}").str(), i + 1);
+            fmt::format(TranslateCached("Location {0}"), i + 1);
         locations[i] = Location(locations[i].GetURL(), locationName);
       }
     }
   }
-}
-
-bool PluginItem::containsText(const std::string& text) const {
-  if (boost::icontains(name, text)) {
-    return true;
-  }
-
-  if (version.has_value() && boost::icontains(version.value(), text)) {
-    return true;
-  }
-
-  if (crc.has_value()) {
-    auto crcText = crcToString(crc.value());
-    if (boost::icontains(crcText, text)) {
-      return true;
-    }
-  }
 
-  for (const auto& tag : currentTags) {
-    if (boost::icontains(tag, text)) {
-      return true;
-    }
-  }
-
-  for (const auto& tag : addTags) {
-    if (boost::icontains(tag, text)) {
-      return true;
-    }
-  }
-
-  for (const auto& tag : removeTags) {
-    if (boost::icontains(tag, text)) {
-      return true;
-    }
-  }
+  updateLowercaseSearchText();
+  messagesHash = HashMessages(messages);
+}
 
-  for (const auto& message : messages) {
-    if (boost::icontains(message.text, text)) {
-      return true;
-    }
-  }
+void PluginItem::updateLowercaseSearchText() {
+  lowercaseName = NormalisePluginName(name);
+  lowercaseSearchText = buildLowercaseSearchText(*this);
+}
 
-  for (const auto& location : locations) {
-    if (boost::icontains(location.GetName(), text)) {
-      return true;
-    }
-  }
+void PluginItem::updateMessagesHash() { messagesHash = HashMessages(messages); }
+
+bool operator==(const PluginItem& lhs, const PluginItem& rhs) {
+  return lhs.gameId == rhs.gameId && lhs.name == rhs.name &&
+         lhs.loadOrderIndex == rhs.loadOrderIndex && lhs.crc == rhs.crc &&
+         lhs.version == rhs.version && lhs.group == rhs.group &&
+         lhs.cleaningUtility == rhs.cleaningUtility &&
+         lhs.isActive == rhs.isActive && lhs.isDirty == rhs.isDirty &&
+         lhs.isEmpty == rhs.isEmpty && lhs.isMaster == rhs.isMaster &&
+         lhs.isLightPlugin == rhs.isLightPlugin &&
+         lhs.isMediumPlugin == rhs.isMediumPlugin &&
+         lhs.loadsArchive == rhs.loadsArchive &&
+         lhs.hasUserMetadata == rhs.hasUserMetadata &&
+         lhs.isCreationClubPlugin == rhs.isCreationClubPlugin &&
+         lhs.isOfficial == rhs.isOfficial &&
+         lhs.currentTags == rhs.currentTags && lhs.addTags == rhs.addTags &&
+         lhs.removeTags == rhs.removeTags && lhs.messages == rhs.messages &&
+         lhs.locations == rhs.locations;
+}
 
-  return false;
+bool operator!=(const PluginItem& lhs, const PluginItem& rhs) {
+  return !(lhs == rhs);
 }
 
-bool PluginItem::containsMatchingText(const std::regex& regex) const {
-  if (std::regex_search(name, regex)) {
-    return true;
-  }
+bool PluginItem::containsText(const std::string& text) const {
+  // std::string::find() is typically implemented using memchr() and
+  // memcmp(), which are vectorised.
+  return lowercaseSearchText.find(boost::to_lower_copy(text)) !=
+         std::string::npos;
+}
 
-  if (version.has_value() && std::regex_search(version.value(), regex)) {
-    return true;
-  }
+bool PluginItem::anyLowercaseSearchField(
+    const std::function<bool(std::string_view)>& predicate) const {
+  const std::string_view text = lowercaseSearchText;
 
-  if (crc.has_value()) {
-    auto crcText = crcToString(crc.value());
-    if (std::regex_search(crcText, regex)) {
+  size_t fieldStart = 0;
+  while (true) {
+    const auto fieldEnd = text.find(SEARCH_FIELD_SEPARATOR, fieldStart);
+    if (predicate(text.substr(fieldStart, fieldEnd - fieldStart))) {
       return true;
     }
-  }
 
-  for (const auto& tag : currentTags) {
-    if (std::regex_search(tag, regex)) {
-      return true;
+    if (fieldEnd == std::string_view::npos) {
+      return false;
     }
-  }
 
-  for (const auto& tag : addTags) {
-    if (std::regex_search(tag, regex)) {
-      return true;
-    }
+    fieldStart = fieldEnd + 1;
   }
+}
 
-  for (const auto& tag : removeTags) {
-    if (std::regex_search(tag, regex)) {
-      return true;
-    }
-  }
+std::string PluginItem::contentToSearch() const {
+  const auto versionText = version.value_or(std::string());
+  const auto crcText = crc.has_value() ? crcToString(crc.value()) : "";
 
+  size_t size = name.size() + versionText.size() + crcText.size() +
+                namesSize(currentTags) + namesSize(addTags) +
+                namesSize(removeTags);
   for (const auto& message : messages) {
-    if (std::regex_search(message.text, regex)) {
-      return true;
-    }
+    size += message.text.str().size();
   }
-
   for (const auto& location : locations) {
-    if (std::regex_search(location.GetName(), regex)) {
-      return true;
-    }
+    size += location.GetName().size();
   }
 
-  return false;
-}
-
-std::string PluginItem::contentToSearch() const {
-  auto text = name;
-
-  if (version.has_value()) {
-    text += version.value();
-  }
+  std::string text;
+  text.reserve(size);
 
-  if (crc.has_value()) {
-    text += crcToString(crc.value());
-  }
+  text += name;
+  text += versionText;
+  text += crcText;
 
   for (const auto& tag : currentTags) {
-    text += tag;
+    text += tag.str();
   }
 
   for (const auto& tag : addTags) {
-    text += tag;
+    text += tag.str();
   }
 
   for (const auto& tag : removeTags) {
-    text += tag;
+    text += tag.str();
   }
 
   for (const auto& message : messages) {
-    text += message.text;
+    text += message.text.str();
   }
 
   for (const auto& location : locations) {
@@ -335,21 +411,39 @@ std::string PluginItem::contentToSearch() const {
 }
 
 std::string PluginItem::getMarkdownContent() const {
-  std::string content = "# " + name + "\n\n";
+  std::string content;
+  content.reserve(estimateMarkdownContentSize());
+
+  appendMarkdownContent(content);
+
+  return content;
+}
+
+void PluginItem::appendMarkdownContent(std::string& content) const {
+  const auto appendLine = [&content](std::string_view label,
+                                     std::string_view value) {
+    content += label;
+    content += value;
+    content += '\n';
+  };
+
+  content += "# ";
+  content += name;
+  content += "\n\n";
 
   if (version.has_value()) {
-    content += "- Version: " + version.value() + "\n";
+    appendLine("- Version: ", version.value());
   }
 
   if (crc.has_value()) {
-    content += "- CRC: " + crcToString(crc.value()) + "\n";
+    appendLine("- CRC: ", crcToString(crc.value()));
   }
 
   if (loadOrderIndex.has_value()) {
-    content += "- Load Order Index: " + loadOrderIndexText() + "\n";
+    appendLine("- Load Order Index: ", loadOrderIndexText());
   }
 
-  std::vector<std::string> attributes;
+  std::vector<std::string_view> attributes;
   if (isActive) {
     attributes.push_back("Active");
   }
@@ -387,49 +481,94 @@ std::string PluginItem::getMarkdownContent() const {
   }
 
   if (!attributes.empty()) {
-    std::string attributesText;
-    for (const auto& attribute : attributes) {
-      attributesText += attribute + ", ";
+    content += "- Attributes: ";
+    for (size_t i = 0; i < attributes.size(); i += 1) {
+      if (i > 0) {
+        content += ", ";
+      }
+      content += attributes[i];
     }
-    content += "- Attributes: " +
-               attributesText.substr(0, attributesText.length() - 2) + "\n";
+    content += '\n';
   }
 
   if (cleaningUtility.has_value()) {
-    content += "- Verified clean by: " + cleaningUtility.value() + "\n";
+    appendLine("- Verified clean by: ", cleaningUtility.value().str());
   }
 
   if (group.has_value()) {
-    content += "- Group: " + group.value() + "\n";
+    appendLine("- Group: ", group.value().str());
   }
 
   if (!currentTags.empty()) {
-    content += "- Current Bash Tags: " + boost::join(currentTags, ", ") + "\n";
+    content += "- Current Bash Tags: ";
+    appendJoinedNames(content, currentTags);
+    content += '\n';
   }
 
   if (!addTags.empty()) {
-    content += "- Add Bash Tags: " + boost::join(addTags, ", ") + "\n";
+    content += "- Add Bash Tags: ";
+    appendJoinedNames(content, addTags);
+    content += '\n';
   }
 
   if (!removeTags.empty()) {
-    content += "- Remove Bash Tags: " + boost::join(removeTags, ", ") + "\n";
+    content += "- Remove Bash Tags: ";
+    appendJoinedNames(content, removeTags);
+    content += '\n';
   }
 
   if (!messages.empty()) {
-    content += "\n" + MessagesAsMarkdown(messages);
+    content += '\n';
+    AppendMessagesAsMarkdown(content, messages);
   }
 
   if (!locations.empty()) {
     content += "\n## Locations\n\n";
 
     for (const auto& location : locations) {
-      content += "- [" + location.GetName() + "](" + location.GetURL() + ")\n";
+      content += "- [";
+      content += location.GetName();
+      content += "](";
+      content += location.GetURL();
+      content += ")\n";
     }
   }
 
-  content += "\n";
+  content += '\n';
+}
 
-  return content;
+size_t PluginItem::estimateMarkdownContentSize() const {
+  // The lengths of the fixed text are overestimated, so that the estimate is
+  // an upper bound without having to count every label's characters.
+  static constexpr size_t HEADER_SIZE = 256;
+  static constexpr size_t LINE_OVERHEAD = 32;
+  static constexpr size_t LOCATION_OVERHEAD = 8;
+
+  size_t size = HEADER_SIZE + name.size();
+
+  if (version.has_value()) {
+    size += version.value().size() + LINE_OVERHEAD;
+  }
+
+  if (cleaningUtility.has_value()) {
+    size += cleaningUtility.value().str().size() + LINE_OVERHEAD;
+  }
+
+  if (group.has_value()) {
+    size += group.value().str().size() + LINE_OVERHEAD;
+  }
+
+  size += namesSize(currentTags) + namesSize(addTags) + namesSize(removeTags) +
+          3 * LINE_OVERHEAD;
+
+  size += EstimateMessagesAsMarkdownSize(messages);
+
+  for (const auto& location : locations) {
+    size += location.GetName().size() + location.GetURL().size() +
+            LOCATION_OVERHEAD;
+  }
+
+  return size;
 }
 
 std::string PluginItem::loadOrderIndexText() const {
@@ -452,18 +591,123 @@ std::string PluginItem::loadOrderIndexText() const {
 std::vector<PluginItem> GetPluginItems(
     const std::vector<std::string>& pluginNames,
     const gui::Game& game,
-    const std::string& language) {
+    const std::string& language,
+    const CancellationToken* cancellationToken,
+    const std::function<void(std::vector<PluginItem>)>& sendBatch,
+    bool activeItemsFirst) {
+  // Timing each plugin's item would take the timing lock from every worker
+  // thread for every plugin, so time them all together.
+  ScopedTimer timer("GetPluginItems");
+
+  const auto evaluationStateHash = game.GetEvaluationStateHash();
+
   const std::function<PluginItem(
       const PluginInterface* const, std::optional<short>, bool)>
       mapper = [&](const PluginInterface* const plugin,
                    std::optional<short> loadOrderIndex,
                    bool isActive) {
-        return PluginItem(game.GetSettings().Id(),
-                          *plugin,
-                          game,
-                          loadOrderIndex,
-                          isActive,
-                          language);
+        PluginItem item(game.GetSettings().Id(),
+                        *plugin,
+                        game,
+                        loadOrderIndex,
+                        isActive,
+                        language);
+        item.evaluationStateHash = evaluationStateHash;
+        return item;
+      };
+
+  return MapFromLoadOrderData(game,
+                              pluginNames,
+                              mapper,
+                              cancellationToken,
+                              sendBatch,
+                              activeItemsFirst);
+}
+
+std::vector<PluginItem> GetPluginItems(
+    const std::vector<std::string>& pluginNames,
+    const gui::Game& game,
+    const std::string& language,
+    const std::vector<PluginItem>& existingItems,
+    const CancellationToken* cancellationToken) {
+  ScopedTimer timer("GetPluginItems");
+
+  std::map<std::string, const PluginItem*> existingItemsByName;
+  for (const auto& item : existingItems) {
+    existingItemsByName.emplace(item.name, &item);
+  }
+
+  const auto evaluationStateHash = game.GetEvaluationStateHash();
+
+  const std::function<PluginItem(
+      const PluginInterface* const, std::optional<short>, bool)>
+      mapper = [&](const PluginInterface* const plugin,
+                   std::optional<short> loadOrderIndex,
+                   bool isActive) {
+        const auto it = existingItemsByName.find(plugin->GetName());
+        const auto canReuseItem =
+            it != existingItemsByName.end() &&
+            hasSamePluginData(
+                *it->second, *plugin, game, isActive, evaluationStateHash);
+        reusedPluginItemsCounter.recordLookup(canReuseItem);
+        if (canReuseItem) {
+          auto item = *it->second;
+          item.loadOrderIndex = loadOrderIndex;
+          return item;
+        }
+
+        PluginItem item(game.GetSettings().Id(),
+                        *plugin,
+                        game,
+                        loadOrderIndex,
+                        isActive,
+                        language);
+        item.evaluationStateHash = evaluationStateHash;
+        return item;
+      };
+
+  return MapFromLoadOrderData(game, pluginNames, mapper, cancellationToken);
+}
+
+std::vector<PluginItem> GetPluginItems(
+    const std::vector<std::string>& pluginNames,
+    const gui::Game& game,
+    const std::string& language,
+    const std::vector<PluginItem>& existingItems,
+    const std::unordered_set<std::string>& pluginsToRebuild) {
+  ScopedTimer timer("GetPluginItems");
+
+  std::map<std::string, const PluginItem*> existingItemsByName;
+  for (const auto& item : existingItems) {
+    existingItemsByName.emplace(item.name, &item);
+  }
+
+  const auto evaluationStateHash = game.GetEvaluationStateHash();
+
+  const std::function<PluginItem(
+      const PluginInterface* const, std::optional<short>, bool)>
+      mapper = [&](const PluginInterface* const plugin,
+                   std::optional<short> loadOrderIndex,
+                   bool isActive) {
+        const auto it = existingItemsByName.find(plugin->GetName());
+        const auto canReuseItem =
+            it != existingItemsByName.end() &&
+            pluginsToRebuild.count(plugin->GetName()) == 0;
+        reusedPluginItemsCounter.recordLookup(canReuseItem);
+        if (canReuseItem) {
+          auto item = *it->second;
+          item.loadOrderIndex = loadOrderIndex;
+          return item;
+        }
+
+        PluginItem item(game.GetSettings().Id(),
+                        *plugin,
+                        game,
+                        loadOrderIndex,
+                        isActive,
+                        language);
+        item.evaluationStateHash = evaluationStateHash;
+        return item;
       };
 
   return MapFromLoadOrderData(game, pluginNames, mapper);
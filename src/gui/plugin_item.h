@@ -29,10 +29,14 @@
 #include <loot/metadata/group.h>
 #include <loot/plugin_interface.h>
 
+#include <functional>
 #include <optional>
-#include <regex>
 #include <string>
+#include <string_view>
+#include <unordered_set>
 
+#include "gui/cancellation_token.h"
+#include "gui/interned_string.h"
 #include "gui/sourced_message.h"
 #include "gui/state/game/game.h"
 
@@ -51,8 +55,8 @@ struct PluginItem {
   std::optional<short> loadOrderIndex;
   std::optional<uint32_t> crc;
   std::optional<std::string> version;
-  std::optional<std::string> group;
-  std::optional<std::string> cleaningUtility;
+  std::optional<InternedString> group;
+  std::optional<InternedString> cleaningUtility;
 
   bool isActive{false};
   bool isDirty{false};
@@ -63,16 +67,51 @@ struct PluginItem {
   bool loadsArchive{false};
   bool hasUserMetadata{false};
   bool isCreationClubPlugin{false};
+  // Whether the plugin is one of the game's official plugins, which is
+  // checked once so that filtering cleaning messages doesn't need to.
+  bool isOfficial{false};
 
-  std::vector<std::string> currentTags;
-  std::vector<std::string> addTags;
-  std::vector<std::string> removeTags;
+  std::vector<InternedString> currentTags;
+  std::vector<InternedString> addTags;
+  std::vector<InternedString> removeTags;
 
   std::vector<SourcedMessage> messages;
   std::vector<Location> locations;
 
+  // The name lowercased in the same way as other plugin name lookups, stored
+  // so that filtering doesn't need to lowercase every item's name each time.
+  std::string lowercaseName;
+
+  // The text that content filters search, built and lowercased once so that
+  // filtering doesn't need to format and case-fold every field of every
+  // item each time the filter text changes.
+  std::string lowercaseSearchText;
+
+  // The game's evaluation state hash when the item was derived, as its
+  // messages and evaluated metadata depend on other plugins and files.
+  uint64_t evaluationStateHash{0};
+
+  // A hash of the messages, calculated once so that cards can check whether
+  // the messages that they display have changed without comparing them.
+  uint64_t messagesHash{0};
+
+  // Rebuilds lowercaseName and lowercaseSearchText from the other fields, for
+  // items that weren't created from a plugin or whose content was changed
+  // after they were created.
+  void updateLowercaseSearchText();
+
+  // Recalculates messagesHash, for items whose messages were changed after
+  // they were created.
+  void updateMessagesHash();
+
   bool containsText(const std::string& text) const;
-  bool containsMatchingText(const std::regex& regex) const;
+
+  // Calls the predicate with each field of lowercaseSearchText in turn, and
+  // returns true as soon as it does. This allows a regular expression to be
+  // matched against each field separately, so that a match can't span two
+  // fields.
+  bool anyLowercaseSearchField(
+      const std::function<bool(std::string_view)>& predicate) const;
 
   // QAbstractItemModel has a match() function that operates on items' strings,
   // so build a string that contains all the text that would be displayed for
@@ -81,13 +120,58 @@ struct PluginItem {
 
   std::string getMarkdownContent() const;
 
+  // Appends the same text as getMarkdownContent() to the given string, so that
+  // the content of many items can be built in a single buffer.
+  void appendMarkdownContent(std::string& content) const;
+
+  // Get an upper bound on the length of the text that getMarkdownContent()
+  // produces, for reserving space.
+  size_t estimateMarkdownContentSize() const;
+
   std::string loadOrderIndexText() const;
 };
 
+// lowercaseName and lowercaseSearchText aren't compared as they're derived
+// from the other fields.
+bool operator==(const PluginItem& lhs, const PluginItem& rhs);
+
+bool operator!=(const PluginItem& lhs, const PluginItem& rhs);
+
+// If a cancellation token is given, a CancelledError is thrown if it's
+// cancelled before all the items have been created.
+//
+// If a batch callback is given, it's called with each batch of items in load
+// order as they are created, so that they can be displayed before all the
+// items have been created. If activeItemsFirst is true, the items for active
+// plugins are all created and sent before the items for inactive plugins.
+// Either way, the returned items are in load order.
+std::vector<PluginItem> GetPluginItems(
+    const std::vector<std::string>& pluginNames,
+    const gui::Game& game,
+    const std::string& language,
+    const CancellationToken* cancellationToken = nullptr,
+    const std::function<void(std::vector<PluginItem>)>& sendBatch = nullptr,
+    bool activeItemsFirst = false);
+
+// Get plugin items for the given plugins, reusing existing items for plugins
+// whose data and active state are unchanged, so that only their load order
+// indices need to be updated.
+std::vector<PluginItem> GetPluginItems(
+    const std::vector<std::string>& pluginNames,
+    const gui::Game& game,
+    const std::string& language,
+    const std::vector<PluginItem>& existingItems,
+    const CancellationToken* cancellationToken = nullptr);
+
+// Get plugin items for the given plugins, rebuilding the items for the plugins
+// that are in pluginsToRebuild and reusing the existing items for the others,
+// so that only their load order indices need to be updated.
 std::vector<PluginItem> GetPluginItems(
     const std::vector<std::string>& pluginNames,
     const gui::Game& game,
-    const std::string& language);
+    const std::string& language,
+    const std::vector<PluginItem>& existingItems,
+    const std::unordered_set<std::string>& pluginsToRebuild);
 }
 
 #endif
@@ -0,0 +1,334 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/plugin_items_snapshot.h"
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace {
+using loot::InternedString;
+
+constexpr uint32_t LPIS_MAGIC_NUMBER = 0x5349504C;
+constexpr uint8_t LPIS_FORMAT_VERSION = 2;
+// Guards against allocating huge strings when reading a corrupt file.
+constexpr uint32_t MAX_STRING_LENGTH = 16 * 1024 * 1024;
+
+template<typename T>
+void ReadValue(std::istream& in, T& value) {
+  in.read(reinterpret_cast<char*>(&value), sizeof value);
+}
+
+template<typename T>
+void WriteValue(std::ostream& out, const T& value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof value);
+}
+
+std::string ReadString(std::istream& in) {
+  uint32_t length{0};
+  ReadValue(in, length);
+
+  if (!in.good() || length > MAX_STRING_LENGTH) {
+    in.setstate(std::ios_base::failbit);
+    return std::string();
+  }
+
+  std::string value(length, '\0');
+  in.read(value.data(), length);
+
+  return value;
+}
+
+void WriteString(std::ostream& out, const std::string& value) {
+  if (value.size() > MAX_STRING_LENGTH) {
+    throw std::runtime_error("Failed to write plugin items snapshot: string "
+                             "is too long");
+  }
+
+  WriteValue(out, static_cast<uint32_t>(value.size()));
+  out.write(value.c_str(), value.size());
+}
+
+template<typename T, typename F>
+std::optional<T> ReadOptional(std::istream& in, F readValue) {
+  uint8_t hasValue{0};
+  ReadValue(in, hasValue);
+
+  if (hasValue == 0) {
+    return std::nullopt;
+  }
+
+  return readValue();
+}
+
+std::vector<InternedString> ReadInternedStrings(std::istream& in) {
+  uint32_t count{0};
+  ReadValue(in, count);
+
+  std::vector<InternedString> values;
+  for (uint32_t i = 0; i < count && in.good(); ++i) {
+    values.push_back(InternedString(ReadString(in)));
+  }
+
+  return values;
+}
+
+void WriteInternedStrings(std::ostream& out,
+                          const std::vector<InternedString>& values) {
+  WriteValue(out, static_cast<uint32_t>(values.size()));
+  for (const auto& value : values) {
+    WriteString(out, value);
+  }
+}
+
+// The order of the flags must not change without changing the format version.
+uint16_t GetFlags(const loot::PluginItem& item) {
+  const bool flags[] = {item.isActive,
+                        item.isDirty,
+                        item.isEmpty,
+                        item.isMaster,
+                        item.isLightPlugin,
+                        item.isMediumPlugin,
+                        item.loadsArchive,
+                        item.hasUserMetadata,
+                        item.isCreationClubPlugin,
+                        item.isOfficial};
+
+  uint16_t value = 0;
+  for (size_t i = 0; i < std::size(flags); ++i) {
+    if (flags[i]) {
+      value |= static_cast<uint16_t>(1 << i);
+    }
+  }
+
+  return value;
+}
+
+void SetFlags(loot::PluginItem& item, uint16_t value) {
+  bool* flags[] = {&item.isActive,
+                   &item.isDirty,
+                   &item.isEmpty,
+                   &item.isMaster,
+                   &item.isLightPlugin,
+                   &item.isMediumPlugin,
+                   &item.loadsArchive,
+                   &item.hasUserMetadata,
+                   &item.isCreationClubPlugin,
+                   &item.isOfficial};
+
+  for (size_t i = 0; i < std::size(flags); ++i) {
+    *flags[i] = (value & (1 << i)) != 0;
+  }
+}
+
+loot::PluginItem ReadPluginItem(std::istream& in, loot::GameId gameId) {
+  loot::PluginItem item;
+  item.gameId = gameId;
+  item.name = ReadString(in);
+
+  item.loadOrderIndex = ReadOptional<short>(in, [&]() {
+    int16_t value{0};
+    ReadValue(in, value);
+    return static_cast<short>(value);
+  });
+  item.crc = ReadOptional<uint32_t>(in, [&]() {
+    uint32_t value{0};
+    ReadValue(in, value);
+    return value;
+  });
+  item.version =
+      ReadOptional<std::string>(in, [&]() { return ReadString(in); });
+  item.group = ReadOptional<InternedString>(
+      in, [&]() { return InternedString(ReadString(in)); });
+  item.cleaningUtility = ReadOptional<InternedString>(
+      in, [&]() { return InternedString(ReadString(in)); });
+
+  uint16_t flags{0};
+  ReadValue(in, flags);
+  SetFlags(item, flags);
+
+  item.currentTags = ReadInternedStrings(in);
+  item.addTags = ReadInternedStrings(in);
+  item.removeTags = ReadInternedStrings(in);
+
+  uint32_t messageCount{0};
+  ReadValue(in, messageCount);
+  for (uint32_t i = 0; i < messageCount && in.good(); ++i) {
+    uint8_t type{0};
+    ReadValue(in, type);
+    uint8_t source{0};
+    ReadValue(in, source);
+
+    item.messages.push_back(
+        loot::SourcedMessage{static_cast<loot::MessageType>(type),
+                             static_cast<loot::MessageSource>(source),
+                             ReadString(in)});
+  }
+
+  uint32_t locationCount{0};
+  ReadValue(in, locationCount);
+  for (uint32_t i = 0; i < locationCount && in.good(); ++i) {
+    auto url = ReadString(in);
+    auto name = ReadString(in);
+    item.locations.push_back(loot::Location(url, name));
+  }
+
+  item.updateLowercaseSearchText();
+  item.updateMessagesHash();
+
+  return item;
+}
+
+void WritePluginItem(std::ostream& out, const loot::PluginItem& item) {
+  WriteString(out, item.name);
+
+  WriteValue(out, static_cast<uint8_t>(item.loadOrderIndex.has_value()));
+  if (item.loadOrderIndex.has_value()) {
+    WriteValue(out, static_cast<int16_t>(item.loadOrderIndex.value()));
+  }
+
+  WriteValue(out, static_cast<uint8_t>(item.crc.has_value()));
+  if (item.crc.has_value()) {
+    WriteValue(out, item.crc.value());
+  }
+
+  WriteValue(out, static_cast<uint8_t>(item.version.has_value()));
+  if (item.version.has_value()) {
+    WriteString(out, item.version.value());
+  }
+
+  WriteValue(out, static_cast<uint8_t>(item.group.has_value()));
+  if (item.group.has_value()) {
+    WriteString(out, item.group.value());
+  }
+
+  WriteValue(out, static_cast<uint8_t>(item.cleaningUtility.has_value()));
+  if (item.cleaningUtility.has_value()) {
+    WriteString(out, item.cleaningUtility.value());
+  }
+
+  WriteValue(out, GetFlags(item));
+
+  WriteInternedStrings(out, item.currentTags);
+  WriteInternedStrings(out, item.addTags);
+  WriteInternedStrings(out, item.removeTags);
+
+  WriteValue(out, static_cast<uint32_t>(item.messages.size()));
+  for (const auto& message : item.messages) {
+    WriteValue(out, static_cast<uint8_t>(message.type));
+    WriteValue(out, static_cast<uint8_t>(message.source));
+    WriteString(out, message.text);
+  }
+
+  WriteValue(out, static_cast<uint32_t>(item.locations.size()));
+  for (const auto& location : item.locations) {
+    WriteString(out, location.GetURL());
+    WriteString(out, location.GetName());
+  }
+}
+}
+
+namespace loot {
+std::optional<std::vector<PluginItem>> LoadPluginItemsSnapshot(
+    const std::filesystem::path& filePath,
+    GameId gameId,
+    const std::string& language) {
+  if (!std::filesystem::exists(filePath)) {
+    return std::nullopt;
+  }
+
+  std::ifstream in(filePath, std::ios_base::in | std::ios_base::binary);
+  if (!in.is_open()) {
+    throw std::runtime_error(filePath.u8string() +
+                             " could not be opened for parsing");
+  }
+
+  uint32_t magicNumber{0};
+  ReadValue(in, magicNumber);
+
+  if (magicNumber != LPIS_MAGIC_NUMBER) {
+    throw std::runtime_error("Failed to parse " + filePath.u8string() +
+                             ": wrong magic number");
+  }
+
+  uint8_t formatVersion{0};
+  ReadValue(in, formatVersion);
+
+  if (formatVersion != LPIS_FORMAT_VERSION) {
+    throw std::runtime_error("Failed to parse " + filePath.u8string() +
+                             ": unrecognised format version");
+  }
+
+  uint32_t fileGameId{0};
+  ReadValue(in, fileGameId);
+  const auto fileLanguage = ReadString(in);
+
+  if (in.good() && (fileGameId != static_cast<uint32_t>(gameId) ||
+                    fileLanguage != language)) {
+    return std::nullopt;
+  }
+
+  uint32_t itemCount{0};
+  ReadValue(in, itemCount);
+
+  std::vector<PluginItem> items;
+  for (uint32_t i = 0; i < itemCount && in.good(); ++i) {
+    items.push_back(ReadPluginItem(in, gameId));
+  }
+
+  if (in.fail()) {
+    throw std::runtime_error("Failed to parse " + filePath.u8string() +
+                             ": unexpected end of file");
+  }
+
+  return items;
+}
+
+void SavePluginItemsSnapshot(const std::filesystem::path& filePath,
+                             GameId gameId,
+                             const std::string& language,
+                             const std::vector<PluginItem>& items) {
+  // Don't care about endianness because the files don't need to be portable.
+
+  std::ofstream out(
+      filePath,
+      std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+  if (!out.is_open()) {
+    throw std::runtime_error(filePath.u8string() +
+                             " could not be opened for writing");
+  }
+
+  WriteValue(out, LPIS_MAGIC_NUMBER);
+  WriteValue(out, LPIS_FORMAT_VERSION);
+  WriteValue(out, static_cast<uint32_t>(gameId));
+  WriteString(out, language);
+  WriteValue(out, static_cast<uint32_t>(items.size()));
+
+  for (const auto& item : items) {
+    WritePluginItem(out, item);
+  }
+}
+}
@@ -0,0 +1,54 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_PLUGIN_ITEMS_SNAPSHOT
+#define LOOT_GUI_PLUGIN_ITEMS_SNAPSHOT
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "gui/plugin_item.h"
+
+namespace loot {
+// A snapshot of the plugin items that were last displayed for a game, so that
+// they can be displayed straight away the next time LOOT starts, while the
+// game's data is loaded again.
+//
+// Returns std::nullopt if the file does not exist, or if it was written for a
+// different game or language.
+std::optional<std::vector<PluginItem>> LoadPluginItemsSnapshot(
+    const std::filesystem::path& filePath,
+    GameId gameId,
+    const std::string& language);
+
+void SavePluginItemsSnapshot(const std::filesystem::path& filePath,
+                             GameId gameId,
+                             const std::string& language,
+                             const std::vector<PluginItem>& items);
+}
+
+#endif
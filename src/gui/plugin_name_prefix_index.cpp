@@ -0,0 +1,65 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/plugin_name_prefix_index.h"
+
+#include <algorithm>
+
+namespace loot {
+PluginNamePrefixIndex::PluginNamePrefixIndex(
+    std::vector<std::pair<std::string, int>>&& foldedNameRows) :
+    foldedNameRows_(std::move(foldedNameRows)) {
+  std::sort(foldedNameRows_.begin(), foldedNameRows_.end());
+}
+
+std::optional<int> PluginNamePrefixIndex::FindFirstRow(
+    std::string_view foldedPrefix,
+    const std::function<bool(int)>& acceptRow) const {
+  auto it = std::lower_bound(
+      foldedNameRows_.begin(),
+      foldedNameRows_.end(),
+      foldedPrefix,
+      [](const auto& entry, std::string_view prefix) {
+        return std::string_view(entry.first) < prefix;
+      });
+
+  for (; it != foldedNameRows_.end(); ++it) {
+    // All names that start with the prefix sort together, so the first name
+    // that doesn't is the end of the matches.
+    if (std::string_view(it->first).substr(0, foldedPrefix.size()) !=
+        foldedPrefix) {
+      break;
+    }
+
+    if (acceptRow(it->second)) {
+      return it->second;
+    }
+  }
+
+  return std::nullopt;
+}
+
+size_t PluginNamePrefixIndex::size() const { return foldedNameRows_.size(); }
+}
@@ -0,0 +1,62 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_PLUGIN_NAME_PREFIX_INDEX
+#define LOOT_GUI_PLUGIN_NAME_PREFIX_INDEX
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace loot {
+// Plugin names sorted in case-folded order, so that the plugins whose names
+// start with a given prefix can be found with a binary search instead of
+// comparing the prefix against every plugin's name.
+class PluginNamePrefixIndex {
+public:
+  PluginNamePrefixIndex() = default;
+  // The names must already be case-folded, and each is paired with the row
+  // of its plugin.
+  explicit PluginNamePrefixIndex(
+      std::vector<std::pair<std::string, int>>&& foldedNameRows);
+
+  // Get the row of the first plugin, in case-folded name order, whose name
+  // starts with the given case-folded prefix and whose row is accepted by the
+  // given predicate. Returns std::nullopt if there is no such plugin.
+  std::optional<int> FindFirstRow(
+      std::string_view foldedPrefix,
+      const std::function<bool(int)>& acceptRow) const;
+
+  size_t size() const;
+
+private:
+  std::vector<std::pair<std::string, int>> foldedNameRows_;
+};
+}
+
+#endif
@@ -25,35 +25,99 @@
 
 #include "gui/qt/card_delegate.h"
 
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QTimer>
+#include <algorithm>
+#include <functional>
+#include <string_view>
+#include <unordered_set>
+
 #include "gui/qt/counters.h"
 #include "gui/qt/plugin_item_model.h"
+#include "gui/state/diagnostics.h"
 #include "gui/state/logging.h"
+#include "gui/state/memory_accounting.h"
+#include "gui/state/thread_pool.h"
+#include "gui/state/timing.h"
 
 namespace loot {
-std::vector<std::string> getMessageTexts(
-    const std::vector<SourcedMessage>& messages) {
-  std::vector<std::string> texts;
+// The memory budget for rendered cards, in KiB.
+static constexpr qsizetype RENDERED_CARD_CACHE_MAX_COST = 64 * 1024;
+// How long each batch of queued card sizing cache rows may take to update.
+static constexpr qint64 CARD_SIZING_BATCH_DURATION_MS = 10;
+// Cards that haven't been sized yet are given a height of this many lines.
+static constexpr int ESTIMATED_CARD_LINE_COUNT = 4;
+// How many cards that no row uses are kept for reuse.
+static constexpr size_t MAX_UNUSED_CARDS = 512;
+// How many widths to cache each card's size hint for.
+static constexpr size_t MAX_CACHED_SIZE_HINTS_PER_CARD = 4;
+// How long the view's width must stay the same before card heights are
+// calculated for it, rather than estimated.
+static constexpr int RESIZE_SETTLED_DELAY_MS = 150;
+
+static CacheCounter renderedCardCacheCounter("Rendered plugin cards");
+static CacheCounter sizeHintCacheCounter("Card size hints");
+
+class ContentHasher {
+public:
+  void add(std::size_t value) {
+    // This is the same combination as boost::hash_combine() uses.
+    static constexpr std::uint64_t GOLDEN_RATIO = 0x9e3779b97f4a7c15;
+    hash ^= value + GOLDEN_RATIO + (hash << 6) + (hash >> 2);
+  }
+
+  void add(std::string_view value) {
+    add(std::hash<std::string_view>()(value));
+  }
+
+  void add(const QString& value) {
+    add(static_cast<std::size_t>(qHash(value)));
+  }
+
+  std::uint64_t get() const { return hash; }
+
+private:
+  std::uint64_t hash{0};
+};
+
+void addMessageTexts(ContentHasher& hasher,
+                     const std::vector<SourcedMessage>& messages) {
+  hasher.add(messages.size());
   for (const auto& message : messages) {
-    texts.push_back(message.text);
+    hasher.add(message.text.str());
   }
+}
 
-  return texts;
+void addTagNames(ContentHasher& hasher,
+                 std::vector<InternedString>& keyTags,
+                 const std::vector<InternedString>& tags,
+                 bool hideTags) {
+  if (hideTags) {
+    hasher.add(std::size_t{0});
+    return;
+  }
+
+  hasher.add(tags.size());
+  for (const auto& tag : tags) {
+    hasher.add(tag.str());
+  }
+  keyTags = tags;
 }
 
-std::vector<std::string> getLocationNames(
-    const std::vector<Location>& locations,
-    bool hideLocations) {
+void addLocationNames(ContentHasher& hasher,
+                      std::vector<std::string>& keyTexts,
+                      const std::vector<Location>& locations,
+                      bool hideLocations) {
   if (hideLocations) {
-    return {};
+    hasher.add(std::size_t{0});
+    return;
   }
 
-  std::vector<std::string> names;
-  std::transform(locations.begin(),
-                 locations.end(),
-                 std::back_inserter(names),
-                 [](const auto& location) { return location.GetName(); });
-
-  return names;
+  hasher.add(locations.size());
+  for (const auto& location : locations) {
+    hasher.add(location.GetName());
+    keyTexts.push_back(location.GetName());
+  }
 }
 
 QString getLongestString(std::initializer_list<std::string> list) {
@@ -75,6 +139,34 @@ QString getLongestString(std::initializer_list<std::string> list) {
   return QString::fromStdString(*longestString);
 }
 
+SizeHintCacheKey getSizeHintCacheKey(const PluginItem& pluginItem,
+                                     const CardContentFiltersState& filters) {
+  SizeHintCacheKey key;
+
+  ContentHasher hasher;
+  addTagNames(
+      hasher, key.currentTags, pluginItem.currentTags, filters.hideBashTags);
+  addTagNames(hasher, key.addTags, pluginItem.addTags, filters.hideBashTags);
+  addTagNames(
+      hasher, key.removeTags, pluginItem.removeTags, filters.hideBashTags);
+  hasher.add(getFilteredMessagesHash(pluginItem, filters));
+  addLocationNames(
+      hasher, key.texts, pluginItem.locations, filters.hideLocations);
+
+  // Store what getFilteredMessagesHash() depends on.
+  key.hideAllMessages = filters.hideAllPluginMessages;
+  if (!key.hideAllMessages) {
+    key.messages = pluginItem.messages;
+    key.hideNotes = filters.hideNotes;
+    key.hideCleaningMessages =
+        filters.hideOfficialPluginsCleaningMessages && pluginItem.isOfficial;
+  }
+
+  key.contentHash = hasher.get();
+
+  return key;
+}
+
 SizeHintCacheKey getSizeHintCacheKey(const QModelIndex& index) {
   if (index.row() == 0) {
     auto generalInfo = index.data(RawDataRole).value<GeneralInformation>();
@@ -97,27 +189,74 @@ SizeHintCacheKey getSizeHintCacheKey(const QModelIndex& index) {
       pluginTypeRowCount += 1;
     }
 
-    return SizeHintCacheKey(secondColumnString,
-                            fourthColumnString,
-                            sixthColumnString,
-                            getMessageTexts(generalInfo.generalMessages),
-                            {std::to_string(pluginTypeRowCount)},
-                            true);
+    ContentHasher hasher;
+    hasher.add(secondColumnString);
+    hasher.add(fourthColumnString);
+    hasher.add(sixthColumnString);
+    addMessageTexts(hasher, generalInfo.generalMessages);
+    hasher.add(static_cast<std::size_t>(pluginTypeRowCount));
+
+    SizeHintCacheKey key;
+    key.contentHash = hasher.get();
+    key.isGeneralInfoCard = true;
+    key.texts = {secondColumnString.toStdString(),
+                 fourthColumnString.toStdString(),
+                 sixthColumnString.toStdString(),
+                 std::to_string(pluginTypeRowCount)};
+    key.messages = std::move(generalInfo.generalMessages);
+
+    return key;
   } else {
     auto pluginItem = index.data(RawDataRole).value<PluginItem>();
     auto filters =
         index.data(CardContentFiltersRole).value<CardContentFiltersState>();
 
-    return SizeHintCacheKey(
-        getTagsText(pluginItem.currentTags, filters.hideBashTags),
-        getTagsText(pluginItem.addTags, filters.hideBashTags),
-        getTagsText(pluginItem.removeTags, filters.hideBashTags),
-        getMessageTexts(filterMessages(pluginItem, filters)),
-        getLocationNames(pluginItem.locations, filters.hideLocations),
-        false);
+    return getSizeHintCacheKey(pluginItem, filters);
   }
 }
 
+bool operator==(const SizeHintCacheKey& lhs, const SizeHintCacheKey& rhs) {
+  // Compare the hashes first, as they differ for nearly all unequal keys.
+  return lhs.contentHash == rhs.contentHash &&
+         lhs.isGeneralInfoCard == rhs.isGeneralInfoCard &&
+         lhs.hideAllMessages == rhs.hideAllMessages &&
+         lhs.hideNotes == rhs.hideNotes &&
+         lhs.hideCleaningMessages == rhs.hideCleaningMessages &&
+         lhs.texts == rhs.texts && lhs.currentTags == rhs.currentTags &&
+         lhs.addTags == rhs.addTags && lhs.removeTags == rhs.removeTags &&
+         lhs.messages == rhs.messages;
+}
+
+std::size_t SizeHintCacheKeyHash::operator()(
+    const SizeHintCacheKey& key) const {
+  return static_cast<std::size_t>(key.contentHash) ^
+         static_cast<std::size_t>(key.isGeneralInfoCard);
+}
+
+QString getRenderedCardCacheKey(const QString& pluginName,
+                                const SearchResultData& searchResult) {
+  // Search results are styled differently, so each search state of a card is
+  // cached separately. This means that changing the search results doesn't
+  // invalidate any rendered cards. The prefix has a fixed length so that keys
+  // can't collide whatever the plugin name is.
+  const auto searchState = !searchResult.isResult        ? QChar('0')
+                           : searchResult.isCurrentResult ? QChar('2')
+                                                          : QChar('1');
+
+  return searchState + pluginName;
+}
+
+QString getRenderedCardCacheKey(const QModelIndex& index) {
+  const auto pluginName =
+      index.siblingAtColumn(PluginItemModel::SIDEBAR_NAME_COLUMN)
+          .data(DragRole)
+          .toString();
+  const auto searchResult =
+      index.data(SearchResultRole).value<SearchResultData>();
+
+  return getRenderedCardCacheKey(pluginName, searchResult);
+}
+
 void prepareWidget(QWidget* widget) {
   auto sizePolicy = widget->sizePolicy();
   sizePolicy.setRetainSizeWhenHidden(true);
@@ -218,6 +357,9 @@ CardSizingCache::CardSizingCache(QWidget* cardParentWidget) :
     cardParentWidget(cardParentWidget) {}
 
 void CardSizingCache::update(const QAbstractItemModel* model) {
+  // All rows are being queued, so none need to stay deferred.
+  deferredRows.clear();
+
   update(model, 0, model->rowCount());
 }
 
@@ -229,11 +371,13 @@ void CardSizingCache::update(const QModelIndex& topLeft,
 void CardSizingCache::update(const QAbstractItemModel* model,
                              int firstRow,
                              int lastRow) {
+  queuedRowsModel = model;
   for (int row = firstRow; row <= lastRow; row += 1) {
-    const auto index = model->index(row, PluginItemModel::CARDS_COLUMN);
-
-    update(index);
+    queuedRows.insert(row);
+    deferredRows.erase(row);
   }
+
+  scheduleBatch();
 }
 
 QWidget* CardSizingCache::update(const QModelIndex& index) {
@@ -255,23 +399,33 @@ QWidget* CardSizingCache::update(const QModelIndex& index) {
       // Just return the key's card. It should never be null but handle that
       // for safety.
       return newCardCacheIt == cardCache.end() ? nullptr
-                                               : newCardCacheIt->second.first;
+                                               : newCardCacheIt->second.card;
     } else {
       // The cache key has changed, get the old key's card cache entry and
       // reduce its count by 1.
       const auto oldCardCacheIt = cardCache.find(*oldCacheKey);
       if (oldCardCacheIt != cardCache.end()) {
-        oldCardCacheIt->second.second -= 1;
+        oldCardCacheIt->second.count -= 1;
 
         // If the old key's count is now 0, remove it from the card cache.
-        if (oldCardCacheIt->second.second == 0) {
-          cardCache.erase(oldCardCacheIt);
+        if (oldCardCacheIt->second.count == 0) {
+          retireCard(oldCardCacheIt);
         }
       }
     }
   }
 
-  // If there is no entry for the new cache key, create one.
+  // If there is no entry for the new cache key, reuse an unused card for it
+  // or create one.
+  if (newCardCacheIt == cardCache.end()) {
+    auto unusedCard = reuseCard(newCacheKey);
+    if (unusedCard.has_value()) {
+      cardMinWidths.insert(unusedCard.value().minWidth);
+      newCardCacheIt =
+          cardCache.emplace(newCacheKey, unusedCard.value()).first;
+    }
+  }
+
   if (newCardCacheIt == cardCache.end()) {
     QWidget* widget = nullptr;
     if (index.row() == 0) {
@@ -283,12 +437,16 @@ QWidget* CardSizingCache::update(const QModelIndex& index) {
 
     prepareWidget(widget);
 
+    const auto minWidth = widget->layout()->minimumSize().width();
+    cardMinWidths.insert(minWidth);
+
     newCardCacheIt =
-        cardCache.emplace(newCacheKey, std::make_pair(widget, 0)).first;
+        cardCache.emplace(newCacheKey, CardCacheEntry{widget, 0, minWidth})
+            .first;
   }
 
   // Increase the new cache key's usage count by 1.
-  newCardCacheIt->second.second += 1;
+  newCardCacheIt->second.count += 1;
 
   if (keyCacheIt == keyCache.end()) {
     // This row has no cached key, add a pointer to the new key.
@@ -299,28 +457,131 @@ QWidget* CardSizingCache::update(const QModelIndex& index) {
   }
 
   // Return the new cache key entry's card.
-  return newCardCacheIt->second.first;
+  return newCardCacheIt->second.card;
+}
+
+void CardSizingCache::prioritise(int firstRow, int lastRow) {
+  priorityRows = std::make_pair(firstRow, lastRow);
+}
+
+void CardSizingCache::setIsRowHidden(std::function<bool(int)> isRowHidden) {
+  this->isRowHidden = std::move(isRowHidden);
+}
+
+void CardSizingCache::updateDeferredRows() {
+  if (deferredRows.empty()) {
+    return;
+  }
+
+  queuedRows.merge(deferredRows);
+  deferredRows.clear();
+
+  scheduleBatch();
+}
+
+void CardSizingCache::updateDeferredRow(int row) {
+  if (deferredRows.erase(row) == 0) {
+    return;
+  }
+
+  queuedRows.insert(row);
+
+  scheduleBatch();
+}
+
+bool CardSizingCache::hasQueuedRows() const { return !queuedRows.empty(); }
+
+void CardSizingCache::scheduleBatch() {
+  if (isBatchScheduled || queuedRows.empty()) {
+    return;
+  }
+
+  isBatchScheduled = true;
+  QTimer::singleShot(0, this, &CardSizingCache::updateQueuedRows);
+}
+
+void CardSizingCache::updateQueuedRows() {
+  isBatchScheduled = false;
+
+  ScopedTimer scopedTimer("CardSizingCache::updateQueuedRows");
+  ScopedMemoryMeter memoryMeter("CardSizingCache::updateQueuedRows");
+
+  QElapsedTimer timer;
+  timer.start();
+
+  std::optional<int> firstUpdatedRow;
+  std::optional<int> lastUpdatedRow;
+  while (!queuedRows.empty() &&
+         timer.elapsed() < CARD_SIZING_BATCH_DURATION_MS) {
+    auto it = queuedRows.lower_bound(priorityRows.first);
+    if (it == queuedRows.end() || *it > priorityRows.second) {
+      it = queuedRows.begin();
+    }
+
+    const auto row = *it;
+    queuedRows.erase(it);
+
+    if (isRowHidden && isRowHidden(row)) {
+      deferredRows.insert(row);
+      continue;
+    }
+
+    update(queuedRowsModel->index(row, PluginItemModel::CARDS_COLUMN));
+
+    firstUpdatedRow = std::min(firstUpdatedRow.value_or(row), row);
+    lastUpdatedRow = std::max(lastUpdatedRow.value_or(row), row);
+  }
+
+  scheduleBatch();
+
+  if (firstUpdatedRow.has_value()) {
+    emit cardsUpdated(firstUpdatedRow.value(), lastUpdatedRow.value());
+  }
+}
+
+void CardSizingCache::retireCard(
+    std::unordered_map<SizeHintCacheKey, CardCacheEntry, SizeHintCacheKeyHash>::
+        iterator it) {
+  cardMinWidths.erase(cardMinWidths.find(it->second.minWidth));
+
+  auto entry = it->second;
+  entry.count = 0;
+  unusedCards.emplace_back(it->first, entry);
+  unusedCardsIndex.insert_or_assign(it->first, std::prev(unusedCards.end()));
+  cardCache.erase(it);
+
+  if (unusedCards.size() > MAX_UNUSED_CARDS) {
+    unusedCards.front().second.card->deleteLater();
+    unusedCardsIndex.erase(unusedCards.front().first);
+    unusedCards.pop_front();
+  }
+}
+
+std::optional<CardSizingCache::CardCacheEntry> CardSizingCache::reuseCard(
+    const SizeHintCacheKey& key) {
+  const auto indexIt = unusedCardsIndex.find(key);
+  if (indexIt == unusedCardsIndex.end()) {
+    return std::nullopt;
+  }
+
+  const auto entry = indexIt->second->second;
+  unusedCards.erase(indexIt->second);
+  unusedCardsIndex.erase(indexIt);
+
+  return entry;
 }
 
 QWidget* CardSizingCache::getCard(const SizeHintCacheKey& key) const {
   auto it = cardCache.find(key);
   if (it != cardCache.end()) {
-    return it->second.first;
+    return it->second.card;
   }
 
   return nullptr;
 }
 
 int CardSizingCache::getLargestMinWidth() const {
-  int largest = 0;
-  for (const auto& [key, value] : cardCache) {
-    const auto minWidth = value.first->layout()->minimumSize().width();
-    if (minWidth > largest) {
-      largest = minWidth;
-    }
-  }
-
-  return largest;
+  return cardMinWidths.empty() ? 0 : *cardMinWidths.rbegin();
 }
 
 CardDelegate::CardDelegate(QListView* parent,
@@ -328,16 +589,31 @@ CardDelegate::CardDelegate(QListView* parent,
     QStyledItemDelegate(parent),
     generalInfoCard(new GeneralInfoCard(parent->viewport())),
     pluginCard(new PluginCard(parent->viewport())),
-    cardSizingCache(&cardSizingCache) {
+    cardSizingCache(&cardSizingCache),
+    renderedCardCache(RENDERED_CARD_CACHE_MAX_COST) {
   prepareWidget(generalInfoCard);
   prepareWidget(pluginCard);
+
+  heightEstimator = CardHeightEstimator::calibrate(*pluginCard);
+
+  resizeSettledTimer->setSingleShot(true);
+  resizeSettledTimer->setInterval(RESIZE_SETTLED_DELAY_MS);
+
+  connect(resizeSettledTimer,
+          &QTimer::timeout,
+          this,
+          &CardDelegate::handleResizeSettled);
 }
 
-void CardDelegate::setIcons() { pluginCard->setIcons(); }
+void CardDelegate::setIcons() {
+  pluginCard->setIcons();
+  clearRenderedCards();
+}
 
 void CardDelegate::refreshMessages() {
   generalInfoCard->refreshMessages();
   pluginCard->refreshMessages();
+  clearRenderedCards();
 }
 
 void CardDelegate::refreshStyling() {
@@ -346,8 +622,81 @@ void CardDelegate::refreshStyling() {
 
   pluginCard->setVisible(true);
   pluginCard->setVisible(false);
+
+  // The styling may have changed fonts and margins.
+  heightEstimator = CardHeightEstimator::calibrate(*pluginCard);
+  estimatedSizeHints.clear();
+
+  clearRenderedCards();
+}
+
+void CardDelegate::estimateSizes(const std::vector<PluginItem>& items,
+                                 const CardContentFiltersState& filters,
+                                 int width) {
+  ScopedTimer timer("CardDelegate::estimateSizes");
+
+  if (!heightEstimator.isCalibrated() || width <= 0) {
+    return;
+  }
+
+  // Cards of the same size share a key, so only estimate each key once.
+  std::vector<SizeHintCacheKey> keys(items.size());
+  parallelTransform(items.begin(),
+                    items.end(),
+                    keys.begin(),
+                    [&](const PluginItem& item) {
+                      return getSizeHintCacheKey(item, filters);
+                    });
+
+  std::vector<PluginItem> itemsToEstimate;
+  std::vector<SizeHintCacheKey> keysToEstimate;
+  std::unordered_set<SizeHintCacheKey, SizeHintCacheKeyHash> seenKeys;
+  for (size_t i = 0; i < items.size(); i += 1) {
+    const auto& key = keys.at(i);
+    const auto cachedIt = sizeHintCache.find(key);
+    const auto isSized =
+        cachedIt != sizeHintCache.end() && !cachedIt->second.empty();
+    if (!isSized && seenKeys.insert(key).second) {
+      itemsToEstimate.push_back(items.at(i));
+      keysToEstimate.push_back(key);
+    }
+  }
+
+  const auto heights = heightEstimator.estimateHeights(
+      itemsToEstimate,
+      filters,
+      std::max(width, cardSizingCache->getLargestMinWidth()));
+
+  for (size_t i = 0; i < keysToEstimate.size(); i += 1) {
+    estimatedSizeHints.insert_or_assign(
+        keysToEstimate.at(i),
+        CachedSizeHint{width, QSize(width, heights.at(i))});
+  }
 }
 
+void CardDelegate::invalidateRenderedCards(const QModelIndex& topLeft,
+                                           const QModelIndex& bottomRight) {
+  // Row 0 is the general information card, which isn't cached.
+  for (int row = std::max(topLeft.row(), 1); row <= bottomRight.row();
+       row += 1) {
+    const auto pluginName =
+        topLeft.siblingAtRow(row)
+            .siblingAtColumn(PluginItemModel::SIDEBAR_NAME_COLUMN)
+            .data(DragRole)
+            .toString();
+
+    // The card may have been rendered in any search state.
+    for (const auto& searchResult : {SearchResultData(false, false),
+                                     SearchResultData(true, false),
+                                     SearchResultData(true, true)}) {
+      renderedCardCache.remove(
+          getRenderedCardCacheKey(pluginName, searchResult));
+    }
+  }
+}
+
+void CardDelegate::clearRenderedCards() { renderedCardCache.clear(); }
+
 void CardDelegate::paint(QPainter* painter,
                          const QStyleOptionViewItem& option,
                          const QModelIndex& index) const {
@@ -362,9 +711,31 @@ void CardDelegate::paint(QPainter* painter,
   // indicate when an item is hovered over or selected.
   styleOption.widget->style()->drawControl(
       QStyle::CE_ItemViewItem, &styleOption, painter, styleOption.widget);
-  painter->save();
 
-  painter->translate(styleOption.rect.topLeft());
+  // Rendering a card through its widget is slow, and cards are repainted
+  // whenever the view is scrolled or hovered over, so reuse previously
+  // rendered cards if they were rendered for the same item size and device
+  // pixel ratio. Their content is invalidated when their model data changes.
+  const auto isCacheable = index.row() != 0;
+  const auto cacheKey =
+      isCacheable ? getRenderedCardCacheKey(index) : QString();
+  const auto devicePixelRatio = painter->device()->devicePixelRatio();
+  const auto pixmapSize = styleOption.rect.size() * devicePixelRatio;
+
+  const auto cachedPixmap =
+      isCacheable ? renderedCardCache.object(cacheKey) : nullptr;
+  const auto isCachedPixmapValid =
+      cachedPixmap != nullptr &&
+      cachedPixmap->devicePixelRatio() == devicePixelRatio &&
+      cachedPixmap->size() == pixmapSize;
+  if (isCacheable) {
+    renderedCardCacheCounter.recordLookup(isCachedPixmapValid);
+  }
+
+  if (isCachedPixmapValid) {
+    painter->drawPixmap(styleOption.rect.topLeft(), *cachedPixmap);
+    return;
+  }
 
   QWidget* widget = nullptr;
 
@@ -379,9 +750,22 @@ void CardDelegate::paint(QPainter* painter,
 
   widget->setFixedSize(sizeHint);
 
-  widget->render(painter, QPoint(), QRegion(), QWidget::DrawChildren);
+  auto pixmap = QPixmap(sizeHint * devicePixelRatio);
+  pixmap.setDevicePixelRatio(devicePixelRatio);
+  pixmap.fill(Qt::transparent);
+
+  widget->render(&pixmap, QPoint(), QRegion(), QWidget::DrawChildren);
 
-  painter->restore();
+  painter->drawPixmap(styleOption.rect.topLeft(), pixmap);
+
+  // Only cache the pixmap if it matches the item size, as otherwise it would
+  // never be reused.
+  if (isCacheable && pixmap.size() == pixmapSize) {
+    static constexpr int BITS_PER_KIB = 8 * 1024;
+    const auto cost = static_cast<qsizetype>(pixmap.width()) *
+                      pixmap.height() * pixmap.depth() / BITS_PER_KIB;
+    renderedCardCache.insert(cacheKey, new QPixmap(std::move(pixmap)), cost);
+  }
 }
 
 QSize CardDelegate::sizeHint(const QStyleOptionViewItem& option,
@@ -398,23 +782,56 @@ QSize CardDelegate::sizeHint(const QStyleOptionViewItem& option,
   }
 
   const auto cacheKey = getSizeHintCacheKey(index);
-
-  auto it = sizeHintCache.find(cacheKey);
-  if (it != sizeHintCache.end()) {
-    // Found a cached size, check if its width matches the current available
-    // width.
-    if (it->second.width() == styleOption.rect.width()) {
-      // The cached size is valid, return it.
-      return it->second;
-    }
-  } else {
-    // Store an invalid size so that it can be replaced below.
-    it = sizeHintCache.emplace(cacheKey, QSize()).first;
+  const auto rectWidth = styleOption.rect.width();
+
+  auto& cachedSizeHints = sizeHintCache[cacheKey];
+  const auto cachedIt = std::find_if(
+      cachedSizeHints.begin(),
+      cachedSizeHints.end(),
+      [&](const CachedSizeHint& cached) {
+        return cached.rectWidth == rectWidth;
+      });
+  if (cachedIt != cachedSizeHints.end()) {
+    // Move the size hint to the front so that it's the last to be evicted.
+    std::rotate(cachedSizeHints.begin(), cachedIt, std::next(cachedIt));
+    sizeHintCacheCounter.recordLookup(true);
+    return cachedSizeHints.front().size;
   }
 
+  sizeHintCacheCounter.recordLookup(false);
+
   auto card = cardSizingCache->getCard(cacheKey);
+
+  if (rectWidth != settledWidth && !cachedSizeHints.empty()) {
+    // The view is probably being resized, so wait until it stops before
+    // calculating sizes for its new width.
+    latestWidth = rectWidth;
+    resizeSettledTimer->start();
+
+    // Text wraps, so a card's height is roughly inversely proportional to
+    // the width available for its text.
+    const auto& cached = cachedSizeHints.front();
+    const auto largestMinCardWidth = cardSizingCache->getLargestMinWidth();
+    const auto cachedWidthForHeight =
+        std::max(cached.rectWidth, largestMinCardWidth);
+    const auto widthForHeight = std::max(rectWidth, largestMinCardWidth);
+    const auto height = static_cast<int>(
+        static_cast<qint64>(cached.size.height()) * cachedWidthForHeight /
+        std::max(widthForHeight, 1));
+    const auto minCardWidth =
+        card == nullptr ? 0 : card->layout()->minimumSize().width();
+
+    return QSize(std::max(rectWidth, minCardWidth), height);
+  }
+
+  if (card == nullptr && cardSizingCache->hasQueuedRows()) {
+    // The card probably hasn't been created yet, so estimate its size. The
+    // size hint will be recalculated once the card has been created.
+    return estimateSize(styleOption, index, cacheKey);
+  }
+
   if (card == nullptr) {
-    const auto logger = getLogger();
+    const auto logger = getLogger(LogCategory::ui);
     logger->warn(
         "No cached card exists for row {}, card sizes may not be calculated "
         "correctly",
@@ -425,11 +842,63 @@ QSize CardDelegate::sizeHint(const QStyleOptionViewItem& option,
   const auto sizeHint =
       calculateSize(card, styleOption, cardSizingCache->getLargestMinWidth());
 
-  it->second = sizeHint;
+  if (cachedSizeHints.size() == MAX_CACHED_SIZE_HINTS_PER_CARD) {
+    cachedSizeHints.pop_back();
+  }
+  cachedSizeHints.insert(cachedSizeHints.begin(),
+                         CachedSizeHint{rectWidth, sizeHint});
 
   return sizeHint;
 }
 
+QSize CardDelegate::estimateSize(const QStyleOptionViewItem& option,
+                                 const QModelIndex& index,
+                                 const SizeHintCacheKey& cacheKey) const {
+  const auto rectWidth = option.rect.width();
+  const auto largestMinCardWidth = cardSizingCache->getLargestMinWidth();
+  const auto widthForHeight = std::max(rectWidth, largestMinCardWidth);
+
+  const auto estimatedIt = estimatedSizeHints.find(cacheKey);
+  if (estimatedIt != estimatedSizeHints.end()) {
+    // Scale the estimate in the same way as cached sizes are scaled while
+    // the view is resized.
+    const auto& estimated = estimatedIt->second;
+    const auto estimatedWidthForHeight =
+        std::max(estimated.rectWidth, largestMinCardWidth);
+    const auto height = static_cast<int>(
+        static_cast<qint64>(estimated.size.height()) *
+        estimatedWidthForHeight / std::max(widthForHeight, 1));
+
+    return QSize(rectWidth, height);
+  }
+
+  if (index.row() != 0 && heightEstimator.isCalibrated()) {
+    const auto pluginItem = index.data(RawDataRole).value<PluginItem>();
+    const auto filters =
+        index.data(CardContentFiltersRole).value<CardContentFiltersState>();
+
+    const auto height =
+        heightEstimator.estimateHeight(pluginItem, filters, widthForHeight);
+    estimatedSizeHints.insert_or_assign(
+        cacheKey, CachedSizeHint{rectWidth, QSize(rectWidth, height)});
+
+    return QSize(rectWidth, height);
+  }
+
+  return QSize(rectWidth,
+               option.fontMetrics.lineSpacing() * ESTIMATED_CARD_LINE_COUNT);
+}
+
+void CardDelegate::handleResizeSettled() {
+  settledWidth = latestWidth;
+
+  // Lay out the cards again so that their estimated heights are replaced.
+  const auto view = qobject_cast<QListView*>(parent());
+  if (view != nullptr) {
+    view->doItemsLayout();
+  }
+}
+
 QWidget* CardDelegate::createEditor(QWidget* parent,
                                     const QStyleOptionViewItem&,
                                     const QModelIndex& index) const {
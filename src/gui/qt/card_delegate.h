@@ -26,21 +26,37 @@
 #ifndef LOOT_GUI_QT_CARD_DELEGATE
 #define LOOT_GUI_QT_CARD_DELEGATE
 
+#include <QtCore/QCache>
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
 #include <QtGui/QPainter>
+#include <QtGui/QPixmap>
 #include <QtWidgets/QListView>
 #include <QtWidgets/QStyledItemDelegate>
 #include <QtWidgets/QWidget>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
+#include "gui/qt/card_height_estimator.h"
 #include "gui/qt/general_info_card.h"
 #include "gui/qt/plugin_card.h"
 #include "gui/qt/plugin_item_model.h"
 
 namespace loot {
-// SizeHintCacheKey contains all the data that the card size could depend on,
+// SizeHintCacheKey identifies all the data that the card size could depend on,
 // aside from the available width, and so it means that different plugins with
-// cards of the same size can share cached size data.
+// cards of the same size can share cached size data. The data is hashed so
+// that keys are cheap to look up, and kept so that keys with the same hash but
+// different data aren't treated as equal. Message texts are shared and tags
+// are interned, so keeping them doesn't copy their strings.
 //
-// In order of appearance, the tuple fields are:
+// In order of hashing, the data is:
 //
 //   General info card:
 //
@@ -49,7 +65,6 @@ namespace loot {
 //   3. Longest text in sixth table column (total plugins count)
 //   4. Message texts
 //   5. How many types of plugins supported by the game have count rows
-//   6. true
 //
 //   Plugin card:
 //
@@ -58,23 +73,44 @@ namespace loot {
 //   3. Remove bash tags
 //   4. Message texts
 //   5. Location info
-//   6. false
 //
-typedef std::tuple<QString,
-                   QString,
-                   QString,
-                   std::vector<std::string>,
-                   std::vector<std::string>,
-                   bool>
-    SizeHintCacheKey;
+struct SizeHintCacheKey {
+  std::uint64_t contentHash{0};
+  bool isGeneralInfoCard{false};
+
+  // The general info card's column texts, or the plugin's location names.
+  std::vector<std::string> texts;
+  std::vector<InternedString> currentTags;
+  std::vector<InternedString> addTags;
+  std::vector<InternedString> removeTags;
+  // A plugin card's messages are stored unfiltered along with the filters
+  // that apply to them, as that's what the hash is calculated from.
+  std::vector<SourcedMessage> messages;
+  bool hideAllMessages{false};
+  bool hideNotes{false};
+  bool hideCleaningMessages{false};
+};
+
+bool operator==(const SizeHintCacheKey& lhs, const SizeHintCacheKey& rhs);
+
+struct SizeHintCacheKeyHash {
+  std::size_t operator()(const SizeHintCacheKey& key) const;
+};
 
 /**
  * Whenever the model's raw data changes, this cache needs to be updated for the
  * affected indexes. This update needs to happen before the delegate's paint or
  * size hint methods are called so that they are given the correct largest min
  * width value.
+ *
+ * Updating a range of rows queues them to be updated in short batches on the
+ * UI thread's event loop, so that loading or sorting lots of plugins doesn't
+ * block the UI while their cards are created. Until a row is updated, card
+ * sizes are estimated, and cardsUpdated is emitted after each batch so that
+ * the sizes can be recalculated.
  */
-class CardSizingCache {
+class CardSizingCache : public QObject {
+  Q_OBJECT
 public:
   explicit CardSizingCache(QWidget* cardParentWidget);
 
@@ -83,14 +119,71 @@ public:
   void update(const QAbstractItemModel*, int firstRow, int lastRow);
   QWidget* update(const QModelIndex& index);
 
+  // Update the given rows before other queued rows, e.g. because they're
+  // visible.
+  void prioritise(int firstRow, int lastRow);
+
+  // Queued rows for which the given function returns true, e.g. because
+  // they're filtered out of the view, aren't updated until they're queued
+  // again by updateDeferredRows(), so that cards aren't created for rows that
+  // can't be seen.
+  void setIsRowHidden(std::function<bool(int)> isRowHidden);
+
+  // Queue the rows that were skipped because they were hidden, e.g. because
+  // the filters have changed.
+  void updateDeferredRows();
+  void updateDeferredRow(int row);
+
+  bool hasQueuedRows() const;
+
   QWidget* getCard(const SizeHintCacheKey& key) const;
 
   int getLargestMinWidth() const;
 
+signals:
+  void cardsUpdated(int firstRow, int lastRow);
+
 private:
+  struct CardCacheEntry {
+    QWidget* card{nullptr};
+    // The number of rows that use the card.
+    unsigned int count{0};
+    // Recorded when the card is created so that it can be removed from
+    // cardMinWidths even if the card's layout has since changed.
+    int minWidth{0};
+  };
+
   QWidget* cardParentWidget{nullptr};
   std::map<int, const SizeHintCacheKey*> keyCache;
-  std::map<SizeHintCacheKey, std::pair<QWidget*, unsigned int>> cardCache;
+  std::unordered_map<SizeHintCacheKey, CardCacheEntry, SizeHintCacheKeyHash>
+      cardCache;
+  // The minimum widths of the cards in cardCache, so that the largest can be
+  // found without checking every card.
+  std::multiset<int> cardMinWidths;
+  // Cards that are no longer used by any row, least recently used first.
+  // Toggling a card content filter changes the keys of the cards that it
+  // affects, so keeping their old cards means that toggling it back doesn't
+  // need them to be created again.
+  std::list<std::pair<SizeHintCacheKey, CardCacheEntry>> unusedCards;
+  std::unordered_map<
+      SizeHintCacheKey,
+      std::list<std::pair<SizeHintCacheKey, CardCacheEntry>>::iterator,
+      SizeHintCacheKeyHash>
+      unusedCardsIndex;
+
+  const QAbstractItemModel* queuedRowsModel{nullptr};
+  std::set<int> queuedRows;
+  std::set<int> deferredRows;
+  std::function<bool(int)> isRowHidden;
+  std::pair<int, int> priorityRows{0, -1};
+  bool isBatchScheduled{false};
+
+  void scheduleBatch();
+  void updateQueuedRows();
+  void retireCard(std::unordered_map<SizeHintCacheKey,
+                                     CardCacheEntry,
+                                     SizeHintCacheKeyHash>::iterator it);
+  std::optional<CardCacheEntry> reuseCard(const SizeHintCacheKey& key);
 };
 
 class CardDelegate : public QStyledItemDelegate {
@@ -102,6 +195,19 @@ public:
   void refreshMessages();
   void refreshStyling();
 
+  // Estimate the sizes of the cards for the given items on worker threads, so
+  // that cards that haven't been created yet can be given sizes that are
+  // close to their real sizes. Real sizes replace the estimates as cards are
+  // created, starting with the visible cards.
+  void estimateSizes(const std::vector<PluginItem>& items,
+                     const CardContentFiltersState& filters,
+                     int width);
+
+  // Discard the rendered cards for the given range of source model rows.
+  void invalidateRenderedCards(const QModelIndex& topLeft,
+                               const QModelIndex& bottomRight);
+  void clearRenderedCards();
+
   void paint(QPainter* painter,
              const QStyleOptionViewItem& option,
              const QModelIndex& index) const override;
@@ -119,11 +225,45 @@ public:
                     QAbstractItemModel* model,
                     const QModelIndex& index) const override;
 
+private slots:
+  void handleResizeSettled();
+
 private:
+  struct CachedSizeHint {
+    // The width of the item rect that the size was calculated for.
+    int rectWidth{0};
+    QSize size;
+  };
+
   GeneralInfoCard* generalInfoCard{nullptr};
   PluginCard* pluginCard{nullptr};
   CardSizingCache* cardSizingCache;
-  mutable std::map<SizeHintCacheKey, QSize> sizeHintCache;
+  // Each card's most recently used size hints, most recent first, so that
+  // resizing the view back and forth doesn't recalculate them.
+  mutable std::unordered_map<SizeHintCacheKey,
+                             std::vector<CachedSizeHint>,
+                             SizeHintCacheKeyHash>
+      sizeHintCache;
+  CardHeightEstimator heightEstimator;
+  // Estimated sizes for cards that haven't been sized yet.
+  mutable std::unordered_map<SizeHintCacheKey,
+                             CachedSizeHint,
+                             SizeHintCacheKeyHash>
+      estimatedSizeHints;
+  // While the view is being resized, card heights for a new width are
+  // estimated from their cached sizes, and are only calculated once the width
+  // has stopped changing.
+  mutable int settledWidth{0};
+  mutable int latestWidth{0};
+  QTimer* resizeSettledTimer{new QTimer(this)};
+  // Rendered plugin cards keyed by search state and plugin name, with costs in
+  // KiB. The general information card isn't cached because its counts are
+  // derived from all rows' data.
+  mutable QCache<QString, QPixmap> renderedCardCache;
+
+  QSize estimateSize(const QStyleOptionViewItem& option,
+                     const QModelIndex& index,
+                     const SizeHintCacheKey& cacheKey) const;
 };
 }
 
@@ -0,0 +1,247 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/qt/card_height_estimator.h"
+
+#include <QtGui/QFontMetrics>
+#include <QtGui/QTextLayout>
+#include <QtWidgets/QLayout>
+#include <QtWidgets/QStyle>
+#include <algorithm>
+#include <boost/locale.hpp>
+
+#include "gui/qt/helpers.h"
+#include "gui/qt/plugin_card.h"
+#include "gui/state/thread_pool.h"
+
+namespace {
+using loot::CardContentFiltersState;
+using loot::PluginCard;
+using loot::PluginItem;
+
+// Wide enough that none of the calibration text wraps.
+constexpr int CALIBRATION_WIDTH = 1000;
+
+int measureHeight(PluginCard& card, const PluginItem& item) {
+  card.setContent(item, CardContentFiltersState());
+  return card.layout()->minimumHeightForWidth(CALIBRATION_WIDTH);
+}
+
+// Messages are displayed as rendered Markdown, in which links only show their
+// text, so drop link destinations and brackets to get roughly the text that's
+// displayed.
+QString getDisplayedMessageText(const std::string& markdown) {
+  std::string text;
+  text.reserve(markdown.size());
+
+  for (size_t i = 0; i < markdown.size(); i += 1) {
+    const auto character = markdown[i];
+    if (character == ']' && i + 1 < markdown.size() &&
+        markdown[i + 1] == '(') {
+      const auto end = markdown.find(')', i + 2);
+      if (end != std::string::npos) {
+        i = end;
+        continue;
+      }
+    }
+
+    if (character != '[' && character != ']' && character != '*' &&
+        character != '`') {
+      text += character;
+    }
+  }
+
+  return QString::fromStdString(text);
+}
+
+QString getLocationsText(const PluginItem& item) {
+  std::string text = item.locations.size() == 1
+                         ? boost::locale::translate("Source:")
+                         : boost::locale::translate("Sources:");
+  text += "  ";
+
+  for (size_t i = 0; i < item.locations.size(); i += 1) {
+    if (i > 0) {
+      text += u8" \uFF5C ";
+    }
+    text += item.locations.at(i).GetName();
+  }
+
+  return QString::fromStdString(text);
+}
+}
+
+namespace loot {
+CardHeightEstimator CardHeightEstimator::calibrate(PluginCard& card) {
+  CardHeightEstimator estimator;
+  estimator.font = card.font();
+
+  const QFontMetrics fontMetrics(estimator.font);
+  estimator.lineSpacing = fontMetrics.lineSpacing();
+
+  PluginItem item;
+  item.name = "Calibration.esp";
+  estimator.baseHeight = measureHeight(card, item);
+
+  const auto message = CreatePlainTextSourcedMessage(
+      MessageType::say, MessageSource::messageMetadata, "Calibration");
+  item.messages = {message};
+  item.updateMessagesHash();
+  const auto oneMessageHeight = measureHeight(card, item);
+  item.messages.push_back(message);
+  item.updateMessagesHash();
+  const auto twoMessagesHeight = measureHeight(card, item);
+  item.messages.clear();
+  item.updateMessagesHash();
+
+  estimator.firstMessageHeight = oneMessageHeight - estimator.baseHeight;
+  estimator.nextMessageHeight = twoMessagesHeight - oneMessageHeight;
+
+  item.currentTags = {InternedString("Delev")};
+  const auto oneTagRowHeight = measureHeight(card, item);
+  item.addTags = {InternedString("Relev")};
+  const auto twoTagRowsHeight = measureHeight(card, item);
+  item.currentTags.clear();
+  item.addTags.clear();
+
+  estimator.firstTagRowHeight = oneTagRowHeight - estimator.baseHeight;
+  estimator.nextTagRowHeight = twoTagRowsHeight - oneTagRowHeight;
+
+  item.locations = {Location("https://loot.github.io", "Calibration")};
+  estimator.locationsHeight = measureHeight(card, item) - estimator.baseHeight;
+
+  // Leave the card without content that its next user might not expect.
+  measureHeight(card, PluginItem());
+
+  // Text widths can't be measured in the same way, as they only affect
+  // heights when text wraps, so derive them from the layouts' margins and
+  // the widths of the labels that come before the text on each line.
+  const auto style = card.style();
+  const auto cardMargins = card.layout()->contentsMargins();
+  const auto cardInset = cardMargins.left() + cardMargins.right();
+  const auto labelInset = style->pixelMetric(QStyle::PM_LayoutLeftMargin) +
+                          style->pixelMetric(QStyle::PM_LayoutRightMargin);
+  const auto spacing =
+      std::max(style->pixelMetric(QStyle::PM_LayoutHorizontalSpacing), 0);
+
+  const auto tagHeaderWidth =
+      std::max({fontMetrics.horizontalAdvance(translate("Current")),
+                fontMetrics.horizontalAdvance(translate("Add")),
+                fontMetrics.horizontalAdvance(translate("Remove"))});
+
+  const auto bulletPointWidth =
+      fontMetrics.horizontalAdvance(QString(u8"\u2022"));
+
+  estimator.messageTextInset = cardInset + 2 * labelInset + bulletPointWidth;
+  estimator.tagTextInset = cardInset + labelInset + tagHeaderWidth + spacing;
+  estimator.locationsTextInset = cardInset;
+
+  return estimator;
+}
+
+bool CardHeightEstimator::isCalibrated() const { return baseHeight > 0; }
+
+int CardHeightEstimator::estimateHeight(const PluginItem& item,
+                                        const CardContentFiltersState& filters,
+                                        int width) const {
+  auto height = baseHeight;
+
+  const auto messages = filterMessages(item, filters);
+  for (size_t i = 0; i < messages.size(); i += 1) {
+    const auto lineCount =
+        countLines(getDisplayedMessageText(messages.at(i).text),
+                   width - messageTextInset);
+
+    height += i == 0 ? firstMessageHeight : nextMessageHeight;
+    height += (lineCount - 1) * lineSpacing;
+  }
+
+  auto tagRowCount = 0;
+  for (const auto* tags :
+       {&item.currentTags, &item.addTags, &item.removeTags}) {
+    const auto text = getTagsText(*tags, filters.hideBashTags);
+    if (text.isEmpty()) {
+      continue;
+    }
+
+    const auto lineCount = countLines(text, width - tagTextInset);
+
+    height += tagRowCount == 0 ? firstTagRowHeight : nextTagRowHeight;
+    height += (lineCount - 1) * lineSpacing;
+    tagRowCount += 1;
+  }
+
+  if (!item.locations.empty() && !filters.hideLocations) {
+    const auto lineCount =
+        countLines(getLocationsText(item), width - locationsTextInset);
+
+    height += locationsHeight + (lineCount - 1) * lineSpacing;
+  }
+
+  return height;
+}
+
+std::vector<int> CardHeightEstimator::estimateHeights(
+    const std::vector<PluginItem>& items,
+    const CardContentFiltersState& filters,
+    int width) const {
+  std::vector<int> heights(items.size());
+
+  parallelTransform(items.begin(),
+                    items.end(),
+                    heights.begin(),
+                    [&](const PluginItem& item) {
+                      return estimateHeight(item, filters, width);
+                    });
+
+  return heights;
+}
+
+int CardHeightEstimator::countLines(const QString& text, int width) const {
+  if (text.isEmpty()) {
+    return 1;
+  }
+
+  QTextOption textOption;
+  textOption.setWrapMode(QTextOption::WrapAtWordBoundaryOrAnywhere);
+
+  QTextLayout layout(text, font);
+  layout.setTextOption(textOption);
+
+  // Always lay out at least one character per line.
+  const auto lineWidth = static_cast<qreal>(std::max(width, 1));
+
+  auto lineCount = 0;
+  layout.beginLayout();
+  for (auto line = layout.createLine(); line.isValid();
+       line = layout.createLine()) {
+    line.setLineWidth(lineWidth);
+    lineCount += 1;
+  }
+  layout.endLayout();
+
+  return std::max(lineCount, 1);
+}
+}
@@ -0,0 +1,90 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_QT_CARD_HEIGHT_ESTIMATOR
+#define LOOT_GUI_QT_CARD_HEIGHT_ESTIMATOR
+
+#include <QtGui/QFont>
+#include <vector>
+
+#include "gui/plugin_item.h"
+#include "gui/qt/filters_states.h"
+
+namespace loot {
+class PluginCard;
+
+// Estimates the heights of plugin cards from font metrics, without creating
+// or laying out any widgets, so that many cards can be sized on worker
+// threads. The estimates reproduce the card layout (the header, the message
+// list, the Bash Tags rows and the locations) closely enough that the list
+// doesn't jump around much when the real cards are created and sized.
+//
+// An estimator must be calibrated against a real card on the UI thread, but
+// after that its functions are safe to call from any thread.
+class CardHeightEstimator {
+public:
+  CardHeightEstimator() = default;
+
+  // Measures the given card with different content to find the heights of
+  // its parts. The card's content is overwritten.
+  static CardHeightEstimator calibrate(PluginCard& card);
+
+  bool isCalibrated() const;
+
+  // The width is the width of the card.
+  int estimateHeight(const PluginItem& item,
+                     const CardContentFiltersState& filters,
+                     int width) const;
+
+  // Estimates the heights of the given items concurrently.
+  std::vector<int> estimateHeights(const std::vector<PluginItem>& items,
+                                   const CardContentFiltersState& filters,
+                                   int width) const;
+
+private:
+  QFont font;
+  int lineSpacing{0};
+
+  // The height of a card that only has a header.
+  int baseHeight{0};
+  // The heights that the first and any subsequent single-line messages, tag
+  // rows and the locations line add to a card.
+  int firstMessageHeight{0};
+  int nextMessageHeight{0};
+  int firstTagRowHeight{0};
+  int nextTagRowHeight{0};
+  int locationsHeight{0};
+
+  // The horizontal space around each kind of text, which isn't available for
+  // it to wrap within.
+  int messageTextInset{0};
+  int tagTextInset{0};
+  int locationsTextInset{0};
+
+  int countLines(const QString& text, int width) const;
+};
+}
+
+#endif
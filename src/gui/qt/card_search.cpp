@@ -0,0 +1,115 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/qt/card_search.h"
+
+#include <QtConcurrent/QtConcurrent>
+#include <QtCore/QPromise>
+#include <QtCore/QRegularExpression>
+
+namespace loot {
+CardSearch::CardSearch(QObject* parent) : QObject(parent) {}
+
+CardSearch::~CardSearch() { cancel(); }
+
+void CardSearch::search(const QVariant& text,
+                        std::vector<int>&& rows,
+                        const ContentSearchTexts& contentTexts) {
+  cancel();
+
+  const auto isRegex = text.userType() == QMetaType::QRegularExpression;
+  const auto regex =
+      isRegex ? text.toRegularExpression() : QRegularExpression();
+  const auto string = isRegex ? QString() : text.toString();
+
+  // A string that contains the last search's string can only be found in
+  // the content that the last search's string was found in.
+  auto candidateRows = rows;
+  if (!isRegex && lastSearch.has_value() &&
+      lastSearch->contentTexts == contentTexts && lastSearch->rows == rows &&
+      string.contains(lastSearch->text, Qt::CaseInsensitive)) {
+    candidateRows = lastSearch->resultRows;
+  }
+
+  future = QtConcurrent::run(
+      [candidateRows, contentTexts, isRegex, regex, string](
+          QPromise<std::vector<int>>& promise) {
+        std::vector<int> resultRows;
+        for (const auto row : candidateRows) {
+          if (promise.isCanceled()) {
+            return;
+          }
+
+          const auto textsIndex = static_cast<size_t>(row - 1);
+          if (row < 1 || textsIndex >= contentTexts->size()) {
+            continue;
+          }
+
+          const auto& content = contentTexts->at(textsIndex);
+          const auto isMatch =
+              isRegex ? regex.match(content).hasMatch()
+                      : content.contains(string, Qt::CaseInsensitive);
+          if (isMatch) {
+            resultRows.push_back(row);
+          }
+        }
+
+        promise.addResult(std::move(resultRows));
+      });
+
+  currentSearchId += 1;
+
+  // Only plain text searches can be narrowed, so don't record regex
+  // searches.
+  std::optional<CompletedSearch> completedSearch;
+  if (!isRegex) {
+    completedSearch =
+        CompletedSearch{string, std::move(rows), contentTexts, {}};
+  }
+
+  future.then(this,
+              [this,
+               searchId = currentSearchId,
+               completedSearch = std::move(completedSearch),
+               contentTexts](std::vector<int> resultRows) mutable {
+                if (searchId != currentSearchId) {
+                  // A newer search has started.
+                  return;
+                }
+
+                if (completedSearch.has_value()) {
+                  completedSearch->resultRows = resultRows;
+                }
+                lastSearch = std::move(completedSearch);
+
+                emit searchFinished(resultRows, contentTexts);
+              });
+}
+
+void CardSearch::cancel() {
+  future.cancel();
+  currentSearchId += 1;
+}
+}
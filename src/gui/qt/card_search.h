@@ -0,0 +1,78 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_QT_CARD_SEARCH
+#define LOOT_GUI_QT_CARD_SEARCH
+
+#include <QtCore/QFuture>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QVariant>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace loot {
+typedef std::shared_ptr<const std::vector<QString>> ContentSearchTexts;
+
+// Searches the text content of plugin cards on a worker thread, so that
+// typing search text doesn't block the UI. Starting a search cancels any
+// search that is still running, and if the new search text contains the
+// text of the last search over the same rows, only that search's results are
+// searched again.
+class CardSearch : public QObject {
+  Q_OBJECT
+public:
+  explicit CardSearch(QObject* parent);
+  ~CardSearch() override;
+
+  // The text is either a QString to search for case-insensitively or a
+  // QRegularExpression. The rows are source model rows, which are used to
+  // index contentTexts with an offset of one, as the zeroth row is the
+  // general information card.
+  void search(const QVariant& text,
+              std::vector<int>&& rows,
+              const ContentSearchTexts& contentTexts);
+  void cancel();
+
+signals:
+  void searchFinished(const std::vector<int>& resultRows,
+                      const ContentSearchTexts& contentTexts);
+
+private:
+  struct CompletedSearch {
+    QString text;
+    std::vector<int> rows;
+    ContentSearchTexts contentTexts;
+    std::vector<int> resultRows;
+  };
+
+  QFuture<std::vector<int>> future;
+  unsigned int currentSearchId{0};
+  std::optional<CompletedSearch> lastSearch;
+};
+}
+
+#endif
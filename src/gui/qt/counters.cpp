@@ -25,35 +25,56 @@
 
 #include "gui/qt/counters.h"
 
-#include "gui/state/game/helpers.h"
-
 namespace loot {
 GeneralInformationCounters::GeneralInformationCounters(
     const std::vector<SourcedMessage>& generalMessages,
     const std::vector<PluginItem>& plugins) {
-  countMessages(generalMessages);
-
-  totalPlugins = plugins.size();
+  addMessages(generalMessages);
 
   for (const auto& plugin : plugins) {
-    if (plugin.isActive) {
-      if (plugin.isLightPlugin) {
-        activeLight += 1;
-      } else if (plugin.isMediumPlugin) {
-        activeMedium += 1;
-      } else {
-        activeFull += 1;
-      }
-    }
-    if (plugin.isDirty) {
-      dirty += 1;
+    addPlugin(plugin);
+  }
+}
+
+void GeneralInformationCounters::addPlugin(const PluginItem& plugin) {
+  if (plugin.isActive) {
+    if (plugin.isLightPlugin) {
+      activeLight += 1;
+    } else if (plugin.isMediumPlugin) {
+      activeMedium += 1;
+    } else {
+      activeFull += 1;
     }
+  }
+  if (plugin.isDirty) {
+    dirty += 1;
+  }
 
-    countMessages(plugin.messages);
+  totalPlugins += 1;
+
+  addMessages(plugin.messages);
+}
+
+void GeneralInformationCounters::removePlugin(const PluginItem& plugin) {
+  if (plugin.isActive) {
+    if (plugin.isLightPlugin) {
+      activeLight -= 1;
+    } else if (plugin.isMediumPlugin) {
+      activeMedium -= 1;
+    } else {
+      activeFull -= 1;
+    }
+  }
+  if (plugin.isDirty) {
+    dirty -= 1;
   }
+
+  totalPlugins -= 1;
+
+  removeMessages(plugin.messages);
 }
 
-void GeneralInformationCounters::countMessages(
+void GeneralInformationCounters::addMessages(
     const std::vector<SourcedMessage>& messages) {
   for (const auto& message : messages) {
     if (message.type == MessageType::warn) {
@@ -66,7 +87,75 @@ void GeneralInformationCounters::countMessages(
   totalMessages += messages.size();
 }
 
-bool shouldFilterMessage(const std::string& pluginName,
+void GeneralInformationCounters::removeMessages(
+    const std::vector<SourcedMessage>& messages) {
+  for (const auto& message : messages) {
+    if (message.type == MessageType::warn) {
+      warnings -= 1;
+    } else if (message.type == MessageType::error) {
+      errors -= 1;
+    }
+  }
+
+  totalMessages -= messages.size();
+}
+
+HiddenMessageCounts::HiddenMessageCounts(const PluginItem& plugin) :
+    total(plugin.messages.size()) {
+  for (const auto& message : plugin.messages) {
+    const auto isNote = message.type == MessageType::say;
+    if (isNote) {
+      notes += 1;
+    }
+
+    if (message.source == MessageSource::cleaningMetadata &&
+        plugin.isOfficial) {
+      officialCleaning += 1;
+      if (isNote) {
+        officialCleaningNotes += 1;
+      }
+    }
+  }
+}
+
+void HiddenMessageCounts::add(const HiddenMessageCounts& counts) {
+  total += counts.total;
+  notes += counts.notes;
+  officialCleaning += counts.officialCleaning;
+  officialCleaningNotes += counts.officialCleaningNotes;
+}
+
+void HiddenMessageCounts::remove(const HiddenMessageCounts& counts) {
+  total -= counts.total;
+  notes -= counts.notes;
+  officialCleaning -= counts.officialCleaning;
+  officialCleaningNotes -= counts.officialCleaningNotes;
+}
+
+size_t HiddenMessageCounts::count(
+    const CardContentFiltersState& filters) const {
+  if (filters.hideAllPluginMessages) {
+    return total;
+  }
+
+  size_t hidden = 0;
+
+  if (filters.hideNotes) {
+    hidden += notes;
+  }
+
+  if (filters.hideOfficialPluginsCleaningMessages) {
+    // Official cleaning messages that are notes have already been counted.
+    hidden += officialCleaning;
+    if (filters.hideNotes) {
+      hidden -= officialCleaningNotes;
+    }
+  }
+
+  return hidden;
+}
+
+bool shouldFilterMessage(const PluginItem& plugin,
                          const SourcedMessage& message,
                          const CardContentFiltersState& filters) {
   if (message.type == MessageType::say && filters.hideNotes) {
@@ -74,32 +163,18 @@ bool shouldFilterMessage(const std::string& pluginName,
   }
 
   if (filters.hideOfficialPluginsCleaningMessages &&
-      message.source == MessageSource::cleaningMetadata &&
-      IsOfficialPlugin(filters.gameId, pluginName)) {
+      message.source == MessageSource::cleaningMetadata && plugin.isOfficial) {
     return true;
   }
 
   return false;
 }
 
-size_t countHiddenMessages(const std::vector<PluginItem>& plugins,
-                           const CardContentFiltersState& filters) {
-  size_t hidden = 0;
-
-  for (const auto& plugin : plugins) {
-    if (filters.hideAllPluginMessages) {
-      hidden += plugin.messages.size();
-      continue;
-    }
-
-    hidden += std::count_if(plugin.messages.begin(),
-                            plugin.messages.end(),
-                            [&](const SourcedMessage& message) {
-                              return shouldFilterMessage(
-                                  plugin.name, message, filters);
-                            });
-  }
-
-  return hidden;
+bool hideSameMessages(const CardContentFiltersState& lhs,
+                      const CardContentFiltersState& rhs) {
+  return lhs.hideNotes == rhs.hideNotes &&
+         lhs.hideOfficialPluginsCleaningMessages ==
+             rhs.hideOfficialPluginsCleaningMessages &&
+         lhs.hideAllPluginMessages == rhs.hideAllPluginMessages;
 }
 }
@@ -36,6 +36,14 @@ struct GeneralInformationCounters {
   GeneralInformationCounters(const std::vector<SourcedMessage>& generalMessages,
                              const std::vector<PluginItem>& plugins);
 
+  // Add or remove a plugin's contribution to the counts, so that they can be
+  // kept up to date as individual plugins change.
+  void addPlugin(const PluginItem& plugin);
+  void removePlugin(const PluginItem& plugin);
+
+  void addMessages(const std::vector<SourcedMessage>& messages);
+  void removeMessages(const std::vector<SourcedMessage>& messages);
+
   size_t warnings{0};
   size_t errors{0};
   size_t totalMessages{0};
@@ -45,17 +53,35 @@ struct GeneralInformationCounters {
   size_t activeFull{0};
   size_t dirty{0};
   size_t totalPlugins{0};
+};
+
+// Counts of the plugin messages that card content filters may hide, which
+// are independent of the filters' values so that the number of hidden
+// messages can be recalculated without rescanning messages when the filters
+// are toggled.
+struct HiddenMessageCounts {
+  HiddenMessageCounts() = default;
+  explicit HiddenMessageCounts(const PluginItem& plugin);
+
+  void add(const HiddenMessageCounts& counts);
+  void remove(const HiddenMessageCounts& counts);
+
+  // Get the number of messages hidden by the given filters.
+  size_t count(const CardContentFiltersState& filters) const;
 
-private:
-  void countMessages(const std::vector<SourcedMessage>& messages);
+  size_t total{0};
+  size_t notes{0};
+  size_t officialCleaning{0};
+  size_t officialCleaningNotes{0};
 };
 
-bool shouldFilterMessage(const std::string& pluginName,
+bool shouldFilterMessage(const PluginItem& plugin,
                          const SourcedMessage& message,
                          const CardContentFiltersState& filters);
 
-size_t countHiddenMessages(const std::vector<PluginItem>& plugins,
-                           const CardContentFiltersState& filters);
+// Returns true if the two filter states hide the same plugin messages.
+bool hideSameMessages(const CardContentFiltersState& lhs,
+                      const CardContentFiltersState& rhs);
 }
 
 Q_DECLARE_METATYPE(loot::GeneralInformationCounters);
@@ -0,0 +1,316 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/qt/diagnostics_dialog.h"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <QtGui/QFontDatabase>
+#include <QtWidgets/QDialogButtonBox>
+#include <QtWidgets/QVBoxLayout>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+#include "gui/qt/helpers.h"
+#include "gui/state/diagnostics.h"
+#include "gui/state/memory_accounting.h"
+#include "gui/state/performance_history.h"
+#include "gui/state/timing.h"
+#include "gui/version.h"
+
+namespace {
+using loot::CacheStats;
+using loot::OperationTiming;
+using loot::StageMemoryUsage;
+
+constexpr int DIALOG_WIDTH = 800;
+constexpr int DIALOG_HEIGHT = 600;
+constexpr double BYTES_PER_MIB = 1024.0 * 1024.0;
+// The number of most recent records to list for each game and metric.
+constexpr size_t PERFORMANCE_HISTORY_DISPLAYED_COUNT = 5;
+// Records that took at least this many times longer than the median of the
+// records before them are flagged as slower.
+constexpr double PERFORMANCE_REGRESSION_FACTOR = 1.5;
+
+double toMilliseconds(std::chrono::microseconds duration) {
+  return static_cast<double>(duration.count()) / 1000.0;
+}
+
+template<typename T>
+double toMiB(T bytes) {
+  return static_cast<double>(bytes) / BYTES_PER_MIB;
+}
+
+void writePluginCounts(std::ostream& out, const loot::gui::Game& game) {
+  // Read the snapshot, as the game may be being refreshed in the background.
+  size_t loadedCount = 0;
+  size_t activeCount = 0;
+  size_t masterCount = 0;
+  size_t lightCount = 0;
+  size_t mediumCount = 0;
+  const auto snapshot = game.GetDataSnapshot();
+  for (const auto& plugin : snapshot->GetPlugins()) {
+    if (!plugin->isLoaded) {
+      continue;
+    }
+
+    loadedCount += 1;
+    if (plugin->isActive) {
+      activeCount += 1;
+    }
+    if (plugin->isMaster) {
+      masterCount += 1;
+    }
+    if (plugin->isLightPlugin) {
+      lightCount += 1;
+    } else if (plugin->isMediumPlugin) {
+      mediumCount += 1;
+    }
+  }
+
+  out << "Game: " << game.GetSettings().Name() << std::endl
+      << "Plugins: " << loadedCount << " loaded, " << activeCount
+      << " active, " << masterCount << " masters, " << lightCount
+      << " light, " << mediumCount << " medium" << std::endl;
+}
+
+void writeTimings(std::ostream& out,
+                  const std::vector<OperationTiming>& timings) {
+  out << "Timings (count, last, longest and total durations in ms):"
+      << std::endl;
+
+  if (timings.empty()) {
+    out << "  None recorded" << std::endl;
+  }
+
+  for (const auto& timing : timings) {
+    out << fmt::format("  {}: {} times, {:.1f} last, {:.1f} longest, "
+                       "{:.1f} total",
+                       timing.operationName,
+                       timing.count,
+                       toMilliseconds(timing.lastDuration),
+                       toMilliseconds(timing.maxDuration),
+                       toMilliseconds(timing.totalDuration))
+        << std::endl;
+  }
+}
+
+void writeStageMemoryUsage(std::ostream& out,
+                           const std::vector<StageMemoryUsage>& usages) {
+  out << "Memory by stage (count, MiB allocated, allocations, last and "
+         "largest resident change in MiB, total peak increase in MiB):"
+      << std::endl;
+
+  if (usages.empty()) {
+    out << "  None recorded, as memory is only measured while debug logging "
+           "is enabled"
+        << std::endl;
+  }
+
+  const auto countAllocations = loot::isAllocationCountingEnabled();
+  for (const auto& usage : usages) {
+    const auto allocated =
+        countAllocations
+            ? fmt::format("{:.1f}", toMiB(usage.totalAllocatedBytes))
+            : std::string("n/a");
+    const auto allocations = countAllocations
+                                 ? std::to_string(usage.totalAllocationCount)
+                                 : std::string("n/a");
+
+    out << fmt::format("  {}: {} times, {} allocated, {} allocations, "
+                       "{:.1f} last, {:.1f} largest, {:.1f} peak",
+                       usage.stageName,
+                       usage.count,
+                       allocated,
+                       allocations,
+                       toMiB(usage.lastResidentDelta),
+                       toMiB(usage.maxResidentDelta),
+                       toMiB(usage.totalPeakIncrease))
+        << std::endl;
+  }
+}
+
+void writeCacheStats(std::ostream& out, const std::vector<CacheStats>& stats) {
+  out << "Caches:" << std::endl;
+
+  for (const auto& cache : stats) {
+    const auto lookups = cache.hits + cache.misses;
+    const auto hitRate =
+        lookups == 0 ? 0.0 : 100.0 * static_cast<double>(cache.hits) / lookups;
+
+    out << fmt::format("  {}: {} hits, {} misses ({:.1f}% hit rate)",
+                       cache.cacheName,
+                       cache.hits,
+                       cache.misses,
+                       hitRate)
+        << std::endl;
+  }
+}
+
+void writePerformanceHistory(std::ostream& out,
+                             const std::filesystem::path& historyPath) {
+  out << "Performance history (most recent last, durations in ms):"
+      << std::endl;
+
+  std::vector<loot::PerformanceRecord> records;
+  try {
+    records = loot::LoadPerformanceHistory(historyPath);
+  } catch (const std::exception& e) {
+    out << "  Could not be read: " << e.what() << std::endl;
+    return;
+  }
+
+  if (records.empty()) {
+    out << "  None recorded" << std::endl;
+    return;
+  }
+
+  for (const auto& series : loot::GetPerformanceSeries(records)) {
+    out << "  " << series.gameFolderName << " - "
+        << loot::ToString(series.metric) << ":" << std::endl;
+
+    const auto firstIndex =
+        series.records.size() > PERFORMANCE_HISTORY_DISPLAYED_COUNT
+            ? series.records.size() - PERFORMANCE_HISTORY_DISPLAYED_COUNT
+            : 0;
+    for (auto i = firstIndex; i < series.records.size(); i += 1) {
+      const auto& record = series.records[i];
+      const auto recordedAt =
+          std::chrono::system_clock::to_time_t(record.recordedAt);
+
+      out << "    " << std::put_time(std::localtime(&recordedAt), "%F %R")
+          << fmt::format(": {}, {} plugins",
+                         record.duration.count(),
+                         record.pluginCount);
+
+      const auto relativeDuration = loot::GetRelativeDuration(series, i);
+      if (relativeDuration.has_value()) {
+        out << fmt::format(", {:+.0f}% vs. earlier median",
+                           100.0 * (relativeDuration.value() - 1.0));
+        if (relativeDuration.value() >= PERFORMANCE_REGRESSION_FACTOR) {
+          out << " (slower)";
+        }
+      }
+      out << std::endl;
+    }
+  }
+}
+
+// The report is intended to be copied into bug reports, so it isn't
+// translated.
+std::string getDiagnosticsReport(const loot::LootState& state) {
+  std::ostringstream out;
+
+  out << "LOOT " << loot::gui::Version::string() << " (build "
+      << loot::gui::Version::revision << ")" << std::endl;
+
+  const auto memoryUsage = loot::getProcessMemoryUsage();
+  if (memoryUsage.has_value()) {
+    out << fmt::format("Memory usage: {:.1f} MiB", toMiB(memoryUsage.value()))
+        << std::endl;
+  } else {
+    out << "Memory usage: unknown" << std::endl;
+  }
+
+  const auto peakMemoryUsage = loot::getProcessPeakMemoryUsage();
+  if (peakMemoryUsage.has_value()) {
+    out << fmt::format("Peak memory usage: {:.1f} MiB",
+                       toMiB(peakMemoryUsage.value()))
+        << std::endl;
+  }
+
+  if (state.HasCurrentGame()) {
+    writePluginCounts(out, state.GetCurrentGame());
+  }
+
+  out << std::endl;
+  writeTimings(out, loot::getOperationTimings());
+
+  out << std::endl;
+  writeStageMemoryUsage(out, loot::getStageMemoryUsage());
+
+  out << std::endl;
+  writeCacheStats(out, loot::getCacheStats());
+
+  out << std::endl;
+  writePerformanceHistory(out, state.getPerformanceHistoryPath());
+
+  return out.str();
+}
+}
+
+namespace loot {
+DiagnosticsDialog::DiagnosticsDialog(QWidget* parent, LootState& state) :
+    QDialog(parent), state(state) {
+  setupUi();
+}
+
+void DiagnosticsDialog::refresh() {
+  reportText->setPlainText(
+      QString::fromStdString(getDiagnosticsReport(state)));
+}
+
+void DiagnosticsDialog::setupUi() {
+  refreshButton->setObjectName("refreshButton");
+  copyButton->setObjectName("copyButton");
+
+  reportText->setReadOnly(true);
+  reportText->setLineWrapMode(QPlainTextEdit::NoWrap);
+  reportText->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+
+  auto buttonBox = new QDialogButtonBox(QDialogButtonBox::Close, this);
+  buttonBox->addButton(refreshButton, QDialogButtonBox::ActionRole);
+  buttonBox->addButton(copyButton, QDialogButtonBox::ActionRole);
+
+  auto dialogLayout = new QVBoxLayout();
+
+  dialogLayout->addWidget(reportText);
+  dialogLayout->addWidget(buttonBox);
+
+  setLayout(dialogLayout);
+
+  resize(DIALOG_WIDTH, DIALOG_HEIGHT);
+
+  translateUi();
+
+  connect(buttonBox, &QDialogButtonBox::rejected, this, &QDialog::reject);
+
+  QMetaObject::connectSlotsByName(this);
+}
+
+void DiagnosticsDialog::translateUi() {
+  setWindowTitle(translate("Performance Diagnostics"));
+
+  refreshButton->setText(translate("Refresh"));
+  copyButton->setText(translate("Copy to Clipboard"));
+}
+
+void DiagnosticsDialog::on_refreshButton_clicked() { refresh(); }
+
+void DiagnosticsDialog::on_copyButton_clicked() {
+  CopyToClipboard(reportText->toPlainText().toStdString());
+}
+}
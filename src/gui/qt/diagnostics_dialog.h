@@ -0,0 +1,63 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_QT_DIAGNOSTICS_DIALOG
+#define LOOT_GUI_QT_DIAGNOSTICS_DIALOG
+
+#include <QtWidgets/QDialog>
+#include <QtWidgets/QPlainTextEdit>
+#include <QtWidgets/QPushButton>
+#include <QtWidgets/QWidget>
+
+#include "gui/state/loot_state.h"
+
+namespace loot {
+// Shows the recorded timings of LOOT's operations, the current game's plugin
+// counts, cache hit rates and process memory usage as plain text that can be
+// copied into a bug report.
+class DiagnosticsDialog : public QDialog {
+  Q_OBJECT
+public:
+  DiagnosticsDialog(QWidget *parent, LootState &state);
+
+  void refresh();
+
+private:
+  LootState &state;
+
+  QPlainTextEdit *reportText{new QPlainTextEdit(this)};
+  QPushButton *refreshButton{new QPushButton(this)};
+  QPushButton *copyButton{new QPushButton(this)};
+
+  void setupUi();
+  void translateUi();
+
+private slots:
+  void on_refreshButton_clicked();
+  void on_copyButton_clicked();
+};
+}
+
+#endif
@@ -27,12 +27,12 @@
 #define LOOT_GUI_QT_FILTERS_STATES
 
 #include <QtCore/QMetaType>
+#include <QtCore/QRegularExpression>
 #include <optional>
-#include <regex>
 #include <string>
 #include <variant>
 
-#include "gui/state/game/detection/game_install.h"
+#include "gui/interned_string.h"
 
 namespace loot {
 struct CardContentFiltersState {
@@ -43,8 +43,6 @@ struct CardContentFiltersState {
   bool hideNotes{false};
   bool hideOfficialPluginsCleaningMessages{false};
   bool hideAllPluginMessages{false};
-
-  GameId gameId{GameId::tes3};
 };
 
 struct PluginFiltersState {
@@ -53,8 +51,12 @@ struct PluginFiltersState {
   bool hideCreationClubPlugins{false};
   bool showOnlyEmptyPlugins{false};
   std::optional<std::string> overlapPluginName;
-  std::optional<std::string> groupName;
-  std::variant<std::monostate, std::string, std::regex> content;
+  // If set, only the plugins that depend on this plugin are shown.
+  std::optional<std::string> dependencyPluginName;
+  std::optional<InternedString> groupName;
+  // If true, plugins in groups that load after groupName are also shown.
+  bool includeLaterGroups{false};
+  std::variant<std::monostate, std::string, QRegularExpression> content;
 };
 }
 
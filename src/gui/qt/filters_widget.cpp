@@ -33,19 +33,77 @@
 #include "gui/qt/helpers.h"
 #include "gui/state/logging.h"
 
+namespace {
+using loot::CardContentFiltersState;
+using loot::PluginFiltersState;
+
+// How long to wait after a change to the content filter text before applying
+// it, so that it isn't applied for every character typed.
+constexpr int TEXT_FILTER_CHANGE_DELAY_MS = 250;
+// How long to wait after any other filter change before applying it, so that
+// rapid clicks are applied together.
+constexpr int FILTER_CHANGE_DELAY_MS = 50;
+
+bool isSameState(const CardContentFiltersState& lhs,
+                 const CardContentFiltersState& rhs) {
+  return lhs.hideVersionNumbers == rhs.hideVersionNumbers &&
+         lhs.hideCRCs == rhs.hideCRCs && lhs.hideBashTags == rhs.hideBashTags &&
+         lhs.hideLocations == rhs.hideLocations &&
+         lhs.hideNotes == rhs.hideNotes &&
+         lhs.hideOfficialPluginsCleaningMessages ==
+             rhs.hideOfficialPluginsCleaningMessages &&
+         lhs.hideAllPluginMessages == rhs.hideAllPluginMessages;
+}
+
+bool isSameState(const PluginFiltersState& lhs,
+                 const PluginFiltersState& rhs) {
+  return lhs.hideInactivePlugins == rhs.hideInactivePlugins &&
+         lhs.hideMessagelessPlugins == rhs.hideMessagelessPlugins &&
+         lhs.hideCreationClubPlugins == rhs.hideCreationClubPlugins &&
+         lhs.showOnlyEmptyPlugins == rhs.showOnlyEmptyPlugins &&
+         lhs.overlapPluginName == rhs.overlapPluginName &&
+         lhs.dependencyPluginName == rhs.dependencyPluginName &&
+         lhs.groupName == rhs.groupName &&
+         lhs.includeLaterGroups == rhs.includeLaterGroups &&
+         lhs.content == rhs.content;
+}
+}
+
 namespace loot {
-FiltersWidget::FiltersWidget(QWidget* parent) : QFrame(parent) { setupUi(); }
+FiltersWidget::FiltersWidget(QWidget* parent) : QFrame(parent) {
+  filterChangeTimer->setSingleShot(true);
+  connect(filterChangeTimer,
+          &QTimer::timeout,
+          this,
+          &FiltersWidget::applyFilterChanges);
 
-void FiltersWidget::setGameId(const GameId newGameId) { gameId = newGameId; }
+  setupUi();
+}
 
 void FiltersWidget::setPlugins(const std::vector<std::string>& pluginNames) {
   setComboBoxItems(overlapFilter, pluginNames);
+  setComboBoxItems(dependentsFilter, pluginNames);
 }
 
 void FiltersWidget::setGroups(const std::vector<std::string>& groupNames) {
   setComboBoxItems(groupPluginsFilter, groupNames);
 }
 
+void FiltersWidget::setGroupPluginCounts(
+    const std::unordered_map<InternedString, size_t>& counts) {
+  // Skip the "No group selected" item.
+  for (int i = 1; i < groupPluginsFilter->count(); i += 1) {
+    const auto groupName = groupPluginsFilter->itemData(i).toString();
+    const auto it = counts.find(InternedString(groupName.toStdString()));
+    const auto count = it == counts.end() ? 0 : it->second;
+
+    const auto text = groupName % " (" % QString::number(count) % ")";
+    if (groupPluginsFilter->itemText(i) != text) {
+      groupPluginsFilter->setItemText(i, text);
+    }
+  }
+}
+
 void FiltersWidget::setMessageCounts(size_t hidden, size_t total) {
   hiddenMessagesCountLabel->setText(QString::number(hidden) % " / " %
                                     QString::number(total));
@@ -58,9 +116,17 @@ void FiltersWidget::setPluginCounts(size_t hidden, size_t total) {
 
 void FiltersWidget::resetOverlapAndGroupsFilters() {
   overlapFilter->setCurrentIndex(0);
+  dependentsFilter->setCurrentIndex(0);
   groupPluginsFilter->setCurrentIndex(0);
 
-  emit pluginFilterChanged(getPluginFiltersState());
+  // The overlap filter has been reset along with the others, and the plugin
+  // filters must be applied again even if they're unchanged, as the plugins
+  // they're applied to may have changed.
+  isOverlapFilterChangePending = false;
+  appliedOverlapPluginName = std::nullopt;
+  appliedPluginFiltersState = std::nullopt;
+
+  applyFilterChanges();
 }
 
 void FiltersWidget::showCreationClubPluginsFilter(bool show) {
@@ -131,12 +197,10 @@ void FiltersWidget::setFilterStates(const LootSettings::Filters& filters) {
 
   updateWarningsAndErrorsFilterState();
 
-  if (hasContentFilterChanged) {
-    emit cardContentFilterChanged(getCardContentFiltersState());
-  }
-
-  if (hasPluginFilterChanged) {
-    emit pluginFilterChanged(getPluginFiltersState());
+  // Apply the new states straight away, as they're set when the filters are
+  // first loaded and the caller relies on them being applied.
+  if (hasContentFilterChanged || hasPluginFilterChanged) {
+    applyFilterChanges();
   }
 }
 
@@ -164,7 +228,9 @@ void FiltersWidget::setupUi() {
   static constexpr int SPACER_HEIGHT = 40;
 
   overlapFilter->setObjectName("overlapFilter");
+  dependentsFilter->setObjectName("dependentsFilter");
   groupPluginsFilter->setObjectName("groupPluginsFilter");
+  laterGroupsCheckbox->setObjectName("laterGroupsCheckbox");
   contentFilter->setObjectName("contentFilter");
   contentRegexCheckbox->setObjectName("contentRegexCheckbox");
   versionNumbersFilter->setObjectName("versionNumbersFilter");
@@ -208,8 +274,11 @@ void FiltersWidget::setupUi() {
 
   verticalLayout->addWidget(overlapFilterLabel);
   verticalLayout->addWidget(overlapFilter);
+  verticalLayout->addWidget(dependentsFilterLabel);
+  verticalLayout->addWidget(dependentsFilter);
   verticalLayout->addWidget(groupPluginsFilterLabel);
   verticalLayout->addWidget(groupPluginsFilter);
+  verticalLayout->addWidget(laterGroupsCheckbox, 0, Qt::AlignRight);
   verticalLayout->addWidget(contentFilterLabel);
   verticalLayout->addWidget(contentFilter);
   verticalLayout->addWidget(contentRegexCheckbox, 0, Qt::AlignRight);
@@ -245,7 +314,10 @@ void FiltersWidget::setupUi() {
 
 void FiltersWidget::translateUi() {
   overlapFilterLabel->setText(translate("Show only overlapping plugins for"));
+  dependentsFilterLabel->setText(
+      translate("Show only plugins that depend on"));
   groupPluginsFilterLabel->setText(translate("Show only plugins in group"));
+  laterGroupsCheckbox->setText(translate("Include groups that load after it"));
   contentFilterLabel->setText(
       translate("Show only plugins with cards that contain"));
   contentRegexCheckbox->setText(translate("Use regular expression"));
@@ -273,6 +345,12 @@ void FiltersWidget::translateUi() {
     overlapFilter->setItemText(0, overlapItemText);
   }
 
+  if (dependentsFilter->count() == 0) {
+    dependentsFilter->addItem(overlapItemText);
+  } else {
+    dependentsFilter->setItemText(0, overlapItemText);
+  }
+
   auto groupsItemText = translate("No group selected");
   if (groupPluginsFilter->count() == 0) {
     groupPluginsFilter->addItem(groupsItemText);
@@ -285,6 +363,10 @@ void FiltersWidget::translateUi() {
   contentRegexCheckbox->setToolTip(
       translate("If checked, interprets the content filter text as a regular "
                 "expression."));
+
+  laterGroupsCheckbox->setToolTip(
+      translate("If checked, also shows plugins in groups that load after "
+                "the selected group."));
 }
 
 bool FiltersWidget::updateWarningsAndErrorsFilterState() {
@@ -303,8 +385,9 @@ bool FiltersWidget::updateWarningsAndErrorsFilterState() {
 void FiltersWidget::setComboBoxItems(QComboBox* comboBox,
                                      const std::vector<std::string>& items) {
   // If an item is already selected and it's still present in the new
-  // list, preserve the selection.
-  auto currentItem = comboBox->currentText();
+  // list, preserve the selection. Items store their names as data because
+  // their text may have extra information appended.
+  auto currentItem = comboBox->currentData().toString();
 
   while (comboBox->count() > 1) {
     comboBox->removeItem(1);
@@ -313,7 +396,7 @@ void FiltersWidget::setComboBoxItems(QComboBox* comboBox,
   auto indexSet = false;
   for (const auto& item : items) {
     auto qItem = QString::fromStdString(item);
-    comboBox->addItem(qItem);
+    comboBox->addItem(qItem, qItem);
 
     if (!indexSet && qItem == currentItem) {
       comboBox->setCurrentIndex(comboBox->count() - 1);
@@ -333,7 +416,6 @@ CardContentFiltersState FiltersWidget::getCardContentFiltersState() const {
   filters.hideOfficialPluginsCleaningMessages =
       officialPluginsCleaningMessagesFilter->isChecked();
   filters.hideAllPluginMessages = pluginMessagesFilter->isChecked();
-  filters.gameId = gameId;
 
   return filters;
 }
@@ -350,26 +432,39 @@ PluginFiltersState FiltersWidget::getPluginFiltersState() const {
     filters.overlapPluginName = overlapFilter->currentText().toStdString();
   }
 
+  if (dependentsFilter->currentIndex() > 0) {
+    filters.dependencyPluginName =
+        dependentsFilter->currentText().toStdString();
+  }
+
   if (groupPluginsFilter->currentIndex() > 0) {
-    filters.groupName = groupPluginsFilter->currentText().toStdString();
+    filters.groupName = InternedString(
+        groupPluginsFilter->currentData().toString().toStdString());
+    filters.includeLaterGroups = laterGroupsCheckbox->isChecked();
   }
 
   if (!contentFilter->text().isEmpty()) {
-    auto contentFilterText = contentFilter->text().toStdString();
     if (contentRegexCheckbox->isChecked()) {
-      try {
-        filters.content = std::regex(
-            contentFilterText, std::regex::ECMAScript | std::regex::icase);
-      } catch (const std::exception& e) {
-        auto logger = getLogger();
+      // Searched text is lowercased, so the pattern must be case-insensitive.
+      // Lines are used to separate the different parts of a card's content.
+      QRegularExpression regex(contentFilter->text(),
+                               QRegularExpression::CaseInsensitiveOption |
+                                   QRegularExpression::MultilineOption);
+      if (regex.isValid()) {
+        // Compile the pattern now instead of when it's first used to filter.
+        regex.optimize();
+        filters.content = regex;
+      } else {
+        const auto details = regex.errorString().toStdString();
+        auto logger = getLogger(LogCategory::ui);
         if (logger) {
-          logger->error("Invalid content filter regex: {}", e.what());
+          logger->error("Invalid content filter regex: {}", details);
         }
 
-        showInvalidRegexTooltip(*contentFilter, e.what());
+        showInvalidRegexTooltip(*contentFilter, details);
       }
     } else {
-      filters.content = contentFilterText;
+      filters.content = contentFilter->text().toStdString();
     }
   }
 
@@ -377,22 +472,30 @@ PluginFiltersState FiltersWidget::getPluginFiltersState() const {
 }
 
 void FiltersWidget::on_overlapFilter_activated() {
-  // Don't emit pluginFilterChanged even though this is a plugin filter,
-  // because overlap filtering is slow and requires a progress dialog,
-  // and we don't want that to happen for the other plugin filters.
-  if (overlapFilter->currentIndex() == 0) {
-    emit overlapFilterChanged(std::nullopt);
-  } else {
-    emit overlapFilterChanged(overlapFilter->currentText().toStdString());
-  }
+  // Emit overlapFilterChanged instead of pluginFilterChanged even though this
+  // is a plugin filter, because overlap filtering is slow and requires a
+  // progress dialog, and we don't want that to happen for the other plugin
+  // filters.
+  isOverlapFilterChangePending = true;
+  scheduleFilterChange();
+}
+
+void FiltersWidget::on_dependentsFilter_activated() {
+  // Unlike overlap filtering, this uses the game's dependents index, so it's
+  // fast enough to apply straight away.
+  scheduleFilterChange();
 }
 
 void FiltersWidget::on_groupPluginsFilter_activated() {
-  emit pluginFilterChanged(getPluginFiltersState());
+  scheduleFilterChange();
+}
+
+void FiltersWidget::on_laterGroupsCheckbox_clicked() {
+  scheduleFilterChange();
 }
 
 void FiltersWidget::on_contentFilter_textEdited() {
-  emit pluginFilterChanged(getPluginFiltersState());
+  scheduleFilterChange(TEXT_FILTER_CHANGE_DELAY_MS);
 }
 
 void FiltersWidget::on_contentFilter_textChanged() {
@@ -400,15 +503,15 @@ void FiltersWidget::on_contentFilter_textChanged() {
 }
 
 void FiltersWidget::on_contentRegexCheckbox_clicked() {
-  emit pluginFilterChanged(getPluginFiltersState());
+  scheduleFilterChange();
 }
 
 void FiltersWidget::on_versionNumbersFilter_clicked() {
-  emit cardContentFilterChanged(getCardContentFiltersState());
+  scheduleFilterChange();
 }
 
 void FiltersWidget::on_crcsFilter_clicked() {
-  emit cardContentFilterChanged(getCardContentFiltersState());
+  scheduleFilterChange();
 }
 
 void FiltersWidget::on_bashTagsFilter_clicked(bool checked) {
@@ -419,7 +522,7 @@ void FiltersWidget::on_bashTagsFilter_clicked(bool checked) {
     warningsAndErrorFilterMemory.hideBashTags = false;
   }
 
-  emit cardContentFilterChanged(getCardContentFiltersState());
+  scheduleFilterChange();
 }
 
 void FiltersWidget::on_locationsFilter_clicked(bool checked) {
@@ -430,7 +533,7 @@ void FiltersWidget::on_locationsFilter_clicked(bool checked) {
     warningsAndErrorFilterMemory.hideLocations = false;
   }
 
-  emit cardContentFilterChanged(getCardContentFiltersState());
+  scheduleFilterChange();
 }
 
 void FiltersWidget::on_notesFilter_clicked(bool checked) {
@@ -441,19 +544,19 @@ void FiltersWidget::on_notesFilter_clicked(bool checked) {
     warningsAndErrorFilterMemory.hideNotes = false;
   }
 
-  emit cardContentFilterChanged(getCardContentFiltersState());
+  scheduleFilterChange();
 }
 
 void FiltersWidget::on_officialPluginsCleaningMessagesFilter_clicked() {
-  emit cardContentFilterChanged(getCardContentFiltersState());
+  scheduleFilterChange();
 }
 
 void FiltersWidget::on_pluginMessagesFilter_clicked() {
-  emit cardContentFilterChanged(getCardContentFiltersState());
+  scheduleFilterChange();
 }
 
 void FiltersWidget::on_inactivePluginsFilter_clicked() {
-  emit pluginFilterChanged(getPluginFiltersState());
+  scheduleFilterChange();
 }
 
 void FiltersWidget::on_messagelessPluginsFilter_clicked(bool checked) {
@@ -464,15 +567,15 @@ void FiltersWidget::on_messagelessPluginsFilter_clicked(bool checked) {
     warningsAndErrorFilterMemory.hideMessagelessPlugins = false;
   }
 
-  emit pluginFilterChanged(getPluginFiltersState());
+  scheduleFilterChange();
 }
 
 void FiltersWidget::on_creationClubPluginsFilter_clicked() {
-  emit pluginFilterChanged(getPluginFiltersState());
+  scheduleFilterChange();
 }
 
 void FiltersWidget::on_showOnlyEmptyPluginsFilter_clicked() {
-  emit pluginFilterChanged(getPluginFiltersState());
+  scheduleFilterChange();
 }
 
 void FiltersWidget::on_showOnlyWarningsAndErrorsFilter_clicked(bool checked) {
@@ -520,12 +623,55 @@ void FiltersWidget::on_showOnlyWarningsAndErrorsFilter_clicked(bool checked) {
     hasPluginFilterChanged = true;
   }
 
-  if (hasContentFilterChanged) {
-    emit cardContentFilterChanged(getCardContentFiltersState());
+  if (hasContentFilterChanged || hasPluginFilterChanged) {
+    scheduleFilterChange();
+  }
+}
+
+void FiltersWidget::scheduleFilterChange(int delayMs) {
+  // Don't postpone changes that are already due to be applied sooner.
+  if (filterChangeTimer->isActive() &&
+      filterChangeTimer->remainingTime() <= delayMs) {
+    return;
+  }
+
+  filterChangeTimer->start(delayMs);
+}
+
+void FiltersWidget::scheduleFilterChange() {
+  scheduleFilterChange(FILTER_CHANGE_DELAY_MS);
+}
+
+void FiltersWidget::applyFilterChanges() {
+  filterChangeTimer->stop();
+
+  const auto cardContentFiltersState = getCardContentFiltersState();
+  if (!appliedCardContentFiltersState.has_value() ||
+      !isSameState(appliedCardContentFiltersState.value(),
+                   cardContentFiltersState)) {
+    appliedCardContentFiltersState = cardContentFiltersState;
+    emit cardContentFilterChanged(cardContentFiltersState);
+  }
+
+  auto pluginFiltersState = getPluginFiltersState();
+
+  if (isOverlapFilterChangePending) {
+    isOverlapFilterChangePending = false;
+
+    if (pluginFiltersState.overlapPluginName != appliedOverlapPluginName) {
+      // Handling an overlap filter change also applies the other plugin
+      // filters, so there's no need to emit pluginFilterChanged too.
+      appliedOverlapPluginName = pluginFiltersState.overlapPluginName;
+      appliedPluginFiltersState = pluginFiltersState;
+      emit overlapFilterChanged(pluginFiltersState.overlapPluginName);
+      return;
+    }
   }
 
-  if (hasPluginFilterChanged) {
-    emit pluginFilterChanged(getPluginFiltersState());
+  if (!appliedPluginFiltersState.has_value() ||
+      !isSameState(appliedPluginFiltersState.value(), pluginFiltersState)) {
+    appliedPluginFiltersState = pluginFiltersState;
+    emit pluginFilterChanged(std::move(pluginFiltersState));
   }
 }
 }
@@ -26,13 +26,17 @@
 #ifndef LOOT_GUI_QT_FILTERS_WIDGET
 #define LOOT_GUI_QT_FILTERS_WIDGET
 
+#include <QtCore/QTimer>
 #include <QtWidgets/QCheckBox>
 #include <QtWidgets/QComboBox>
 #include <QtWidgets/QFrame>
 #include <QtWidgets/QLabel>
 #include <QtWidgets/QLineEdit>
 #include <QtWidgets/QWidget>
+#include <optional>
+#include <unordered_map>
 
+#include "gui/interned_string.h"
 #include "gui/qt/filters_states.h"
 #include "gui/state/loot_settings.h"
 
@@ -42,9 +46,10 @@ class FiltersWidget : public QFrame {
 public:
   explicit FiltersWidget(QWidget *parent);
 
-  void setGameId(const GameId gameId);
   void setPlugins(const std::vector<std::string> &pluginNames);
   void setGroups(const std::vector<std::string> &groupNames);
+  void setGroupPluginCounts(
+      const std::unordered_map<InternedString, size_t> &counts);
 
   void setMessageCounts(size_t hidden, size_t total);
   void setPluginCounts(size_t hidden, size_t total);
@@ -67,8 +72,11 @@ signals:
 private:
   QLabel *overlapFilterLabel{new QLabel(this)};
   QComboBox *overlapFilter{new QComboBox(this)};
+  QLabel *dependentsFilterLabel{new QLabel(this)};
+  QComboBox *dependentsFilter{new QComboBox(this)};
   QLabel *groupPluginsFilterLabel{new QLabel(this)};
   QComboBox *groupPluginsFilter{new QComboBox(this)};
+  QCheckBox *laterGroupsCheckbox{new QCheckBox(this)};
   QLabel *contentFilterLabel{new QLabel(this)};
   QLineEdit *contentFilter{new QLineEdit(this)};
   QCheckBox *contentRegexCheckbox{new QCheckBox(this)};
@@ -90,10 +98,24 @@ private:
   QLabel *hiddenMessagesCountLabel{new QLabel(this)};
 
   LootSettings::Filters warningsAndErrorFilterMemory;
-  GameId gameId{GameId::tes3};
+
+  // Filter changes are applied after a short delay, so that a burst of
+  // changes (e.g. typing in the content filter) is applied once.
+  QTimer *filterChangeTimer{new QTimer(this)};
+  bool isOverlapFilterChangePending{false};
+  // The states that were last emitted, so that changes that leave the
+  // filters as they were aren't applied.
+  std::optional<CardContentFiltersState> appliedCardContentFiltersState;
+  std::optional<PluginFiltersState> appliedPluginFiltersState;
+  std::optional<std::string> appliedOverlapPluginName;
 
   void setupUi();
 
+  void scheduleFilterChange(int delayMs);
+  void scheduleFilterChange();
+
+  void applyFilterChanges();
+
   void translateUi();
 
   bool updateWarningsAndErrorsFilterState();
@@ -103,7 +125,9 @@ private:
 
 private slots:
   void on_overlapFilter_activated();
+  void on_dependentsFilter_activated();
   void on_groupPluginsFilter_activated();
+  void on_laterGroupsCheckbox_clicked();
   void on_contentFilter_textChanged();
   void on_contentFilter_textEdited();
   void on_contentRegexCheckbox_clicked();
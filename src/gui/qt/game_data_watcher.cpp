@@ -0,0 +1,290 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/qt/game_data_watcher.h"
+
+#include <QtCore/QDir>
+
+#include "gui/state/game/directory_listing.h"
+#include "gui/state/game/helpers.h"
+#include "gui/state/logging.h"
+
+namespace {
+using loot::GHOST_EXTENSION;
+
+// Wait for a burst of filesystem events to end before reporting changes.
+constexpr int DEBOUNCE_INTERVAL_MS = 500;
+
+QString toCleanPath(const std::filesystem::path& path) {
+  return QDir::cleanPath(QString::fromStdString(path.u8string()));
+}
+
+std::filesystem::path toPath(const QString& path) {
+  return std::filesystem::u8path(path.toStdString());
+}
+
+std::string trimGhostExtension(const std::string& filename) {
+  const auto ghostExtension = std::string(GHOST_EXTENSION);
+  if (filename.size() > ghostExtension.size() &&
+      filename.compare(filename.size() - ghostExtension.size(),
+                       ghostExtension.size(),
+                       ghostExtension) == 0) {
+    return filename.substr(0, filename.size() - ghostExtension.size());
+  }
+
+  return filename;
+}
+}
+
+namespace loot {
+GameDataWatcher::GameDataWatcher(QObject* parent) : QObject(parent) {
+  timer->setSingleShot(true);
+  timer->setInterval(DEBOUNCE_INTERVAL_MS);
+
+  connect(timer, &QTimer::timeout, this, &GameDataWatcher::gameDataChanged);
+  connect(watcher,
+          &QFileSystemWatcher::directoryChanged,
+          this,
+          &GameDataWatcher::onDirectoryChanged);
+  connect(watcher,
+          &QFileSystemWatcher::fileChanged,
+          this,
+          &GameDataWatcher::onFileChanged);
+}
+
+void GameDataWatcher::watch(const gui::Game& game) {
+  unwatch();
+
+  for (const auto& path : game.ExternalDataPaths()) {
+    addDirectoryPath(path);
+  }
+  addDirectoryPath(game.GetSettings().DataPath());
+
+  const auto activePluginsFilePath = game.GetActivePluginsFilePath();
+  addFilePath(activePluginsFilePath);
+  addFilePath(activePluginsFilePath.parent_path() / "loadorder.txt");
+
+  masterlistPath = toCleanPath(game.MasterlistPath());
+  userlistPath = toCleanPath(game.UserlistPath());
+  addFilePath(game.MasterlistPath());
+  addFilePath(game.UserlistPath());
+}
+
+void GameDataWatcher::unwatch() {
+  timer->stop();
+
+  const auto directories = watcher->directories();
+  if (!directories.isEmpty()) {
+    watcher->removePaths(directories);
+  }
+
+  const auto files = watcher->files();
+  if (!files.isEmpty()) {
+    watcher->removePaths(files);
+  }
+
+  directoryStates.clear();
+  fileStates.clear();
+  masterlistPath.clear();
+  userlistPath.clear();
+  changedDirectoryPaths.clear();
+  changedFilePaths.clear();
+}
+
+GameDataChanges GameDataWatcher::takeChanges() {
+  timer->stop();
+
+  GameDataChanges changes;
+
+  for (const auto& path : changedDirectoryPaths) {
+    const auto it = directoryStates.find(path);
+    if (it == directoryStates.end()) {
+      continue;
+    }
+
+    auto newState = readDirectoryState(toPath(path));
+
+    for (const auto& [pluginName, fileState] : newState) {
+      const auto oldIt = it->second.find(pluginName);
+      if (oldIt == it->second.end() || !(oldIt->second == fileState)) {
+        changes.changedPlugins.insert(pluginName);
+      }
+    }
+
+    for (const auto& [pluginName, fileState] : it->second) {
+      if (newState.count(pluginName) == 0) {
+        changes.removedPlugins.insert(pluginName);
+      }
+    }
+
+    it->second = std::move(newState);
+  }
+  changedDirectoryPaths.clear();
+
+  for (const auto& path : changedFilePaths) {
+    const auto it = fileStates.find(path);
+    if (it == fileStates.end()) {
+      continue;
+    }
+
+    auto newState = readFileState(toPath(path));
+    if (newState == it->second) {
+      continue;
+    }
+
+    it->second = std::move(newState);
+
+    if (path == masterlistPath || path == userlistPath) {
+      changes.metadataChanged = true;
+    } else {
+      changes.loadOrderChanged = true;
+    }
+  }
+  changedFilePaths.clear();
+
+  return changes;
+}
+
+void GameDataWatcher::deferChanges() { timer->start(); }
+
+void GameDataWatcher::acceptOwnChanges() {
+  for (auto& [path, state] : fileStates) {
+    state = readFileState(toPath(path));
+  }
+
+  // Setting the load order of games that use timestamps and redating plugins
+  // change plugins' timestamps but not their sizes. Other changes to plugins
+  // are left to be reported.
+  for (auto& [path, state] : directoryStates) {
+    const auto newState = readDirectoryState(toPath(path));
+    for (auto& [pluginName, fileState] : state) {
+      const auto it = newState.find(pluginName);
+      if (it != newState.end() && it->second.fileSize == fileState.fileSize) {
+        fileState.lastWriteTime = it->second.lastWriteTime;
+      }
+    }
+  }
+}
+
+GameDataWatcher::DirectoryState GameDataWatcher::readDirectoryState(
+    const std::filesystem::path& directory) {
+  DirectoryState state;
+
+  std::vector<DirectoryEntry> entries;
+  try {
+    entries = ListDirectory(directory, HasPossiblyGhostedPluginFileExtension);
+  } catch (const std::filesystem::filesystem_error&) {
+    // Treat an unreadable directory as empty.
+    return state;
+  }
+
+  for (const auto& entry : entries) {
+    if (!entry.isRegularFile) {
+      continue;
+    }
+
+    FileState fileState;
+    fileState.fileSize = entry.fileSize.value_or(0);
+    if (entry.lastWriteTime.has_value()) {
+      fileState.lastWriteTime = entry.lastWriteTime.value();
+    }
+
+    state.emplace(trimGhostExtension(entry.filename), fileState);
+  }
+
+  return state;
+}
+
+std::optional<GameDataWatcher::FileState> GameDataWatcher::readFileState(
+    const std::filesystem::path& path) {
+  std::error_code ec;
+  FileState state;
+  state.fileSize = std::filesystem::file_size(path, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+
+  state.lastWriteTime = std::filesystem::last_write_time(path, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+
+  return state;
+}
+
+void GameDataWatcher::addDirectoryPath(const std::filesystem::path& path) {
+  if (!std::filesystem::is_directory(path)) {
+    return;
+  }
+
+  const auto cleanPath = toCleanPath(path);
+  if (watcher->addPath(cleanPath)) {
+    directoryStates[cleanPath] = readDirectoryState(path);
+  }
+}
+
+void GameDataWatcher::addFilePath(const std::filesystem::path& path) {
+  const auto cleanPath = toCleanPath(path);
+  if (std::filesystem::exists(path) && watcher->addPath(cleanPath)) {
+    fileStates[cleanPath] = readFileState(path);
+  }
+}
+
+void GameDataWatcher::onDirectoryChanged(const QString& path) {
+  const auto cleanPath = QDir::cleanPath(path);
+  if (directoryStates.count(cleanPath) == 0) {
+    return;
+  }
+
+  changedDirectoryPaths.insert(cleanPath);
+
+  timer->start();
+}
+
+void GameDataWatcher::onFileChanged(const QString& path) {
+  const auto cleanPath = QDir::cleanPath(path);
+  const auto filePath = toPath(cleanPath);
+  if (fileStates.count(cleanPath) == 0) {
+    return;
+  }
+
+  // Files that are replaced rather than written to stop being watched, so
+  // start watching them again. Their recorded state is kept so that the
+  // change can be detected.
+  if (!watcher->files().contains(cleanPath) &&
+      std::filesystem::exists(filePath)) {
+    watcher->addPath(cleanPath);
+  }
+
+  changedFilePaths.insert(cleanPath);
+
+  auto logger = getLogger(LogCategory::ui);
+  if (logger) {
+    logger->debug("Detected a change to {}", filePath.u8string());
+  }
+
+  timer->start();
+}
+}
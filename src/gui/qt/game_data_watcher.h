@@ -0,0 +1,108 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_QT_GAME_DATA_WATCHER
+#define LOOT_GUI_QT_GAME_DATA_WATCHER
+
+#include <QtCore/QFileSystemWatcher>
+#include <QtCore/QString>
+#include <QtCore/QTimer>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+
+#include "gui/state/game/game.h"
+#include "gui/state/game/game_data_changes.h"
+
+namespace loot {
+// Watches a game's data paths, load order files and metadata files for
+// changes, and records which plugins have been affected. Changes are batched
+// so that a burst of filesystem events only results in one signal, and what
+// changed is only worked out when the changes are taken, so that LOOT can
+// accept its own changes first.
+class GameDataWatcher : public QObject {
+  Q_OBJECT
+public:
+  explicit GameDataWatcher(QObject* parent);
+
+  void watch(const gui::Game& game);
+  void unwatch();
+
+  // Returns what has changed since the last call.
+  GameDataChanges takeChanges();
+
+  // Emit gameDataChanged() again later, without clearing the recorded
+  // changes.
+  void deferChanges();
+
+  // Treat the current state of the load order and metadata files, and the
+  // timestamps of plugins that haven't otherwise changed, as unchanged. Call
+  // this after LOOT writes to them so that its own writes aren't reported.
+  void acceptOwnChanges();
+
+signals:
+  void gameDataChanged();
+
+private:
+  struct FileState {
+    uintmax_t fileSize{0};
+    std::filesystem::file_time_type lastWriteTime;
+
+    bool operator==(const FileState& other) const {
+      return fileSize == other.fileSize && lastWriteTime == other.lastWriteTime;
+    }
+  };
+
+  typedef std::map<std::string, FileState> DirectoryState;
+
+  QFileSystemWatcher* watcher{new QFileSystemWatcher(this)};
+  QTimer* timer{new QTimer(this)};
+  // Keyed by clean paths, as QFileSystemWatcher may not preserve separators.
+  std::map<QString, DirectoryState> directoryStates;
+  // Missing files have no state.
+  std::map<QString, std::optional<FileState>> fileStates;
+  QString masterlistPath;
+  QString userlistPath;
+  // The paths that have had events since the changes were last taken.
+  std::set<QString> changedDirectoryPaths;
+  std::set<QString> changedFilePaths;
+
+  static DirectoryState readDirectoryState(
+      const std::filesystem::path& directory);
+  static std::optional<FileState> readFileState(
+      const std::filesystem::path& path);
+
+  void addDirectoryPath(const std::filesystem::path& path);
+  void addFilePath(const std::filesystem::path& path);
+
+private slots:
+  void onDirectoryChanged(const QString& path);
+  void onFileChanged(const QString& path);
+};
+}
+
+#endif
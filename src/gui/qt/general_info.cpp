@@ -41,9 +41,7 @@ std::string GeneralInformation::getMarkdownContent() const {
   content += "- ID: " + preludeRevision.id + "\n";
   content += "- Update Date: " + preludeRevision.date + "\n\n";
 
-  if (!generalMessages.empty()) {
-    content += MessagesAsMarkdown(generalMessages);
-  }
+  AppendMessagesAsMarkdown(content, generalMessages);
 
   content += "\n";
 
@@ -29,6 +29,7 @@
 #include <QtGui/QPainter>
 #include <QtMath>
 #include <QtWidgets/QGraphicsScene>
+#include <QtWidgets/QStyleOption>
 
 #include "gui/qt/groups_editor/graph_view.h"
 #include "gui/qt/groups_editor/node.h"
@@ -72,6 +73,8 @@ void Edge::adjust() {
     sourcePoint = line.p1();
     destPoint = line.p1();
   }
+
+  polygon = createLineWithArrow(sourcePoint, destPoint);
 }
 
 QRectF Edge::boundingRect() const {
@@ -89,21 +92,25 @@ QRectF Edge::boundingRect() const {
 }
 
 void Edge::paint(QPainter *painter,
-                 const QStyleOptionGraphicsItem *,
+                 const QStyleOptionGraphicsItem *option,
                  QWidget *) {
-  if (!source || !dest) {
+  if (!source || !dest || polygon.isEmpty()) {
     return;
   }
 
-  auto polygon = createLineWithArrow(sourcePoint, destPoint);
+  const auto graphView = qobject_cast<GraphView *>(scene()->parent());
+  const auto color = getDefaultColor(*graphView, isUserMetadata_);
 
-  if (polygon.isEmpty()) {
+  const auto levelOfDetail =
+      option->levelOfDetailFromTransform(painter->worldTransform());
+  if (levelOfDetail < ARROW_MIN_LEVEL_OF_DETAIL) {
+    // Arrowheads are too small to see at this zoom level.
+    painter->setRenderHint(QPainter::Antialiasing, false);
+    painter->setPen(QPen(color, 0));
+    painter->drawLine(sourcePoint, destPoint);
     return;
   }
 
-  const auto graphView = qobject_cast<GraphView *>(scene()->parent());
-  const auto color = getDefaultColor(*graphView, isUserMetadata_);
-
   painter->setPen(
       QPen(color, LINE_WIDTH, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
   painter->setBrush(color);
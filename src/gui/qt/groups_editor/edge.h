@@ -58,11 +58,16 @@ protected:
   void mousePressEvent(QGraphicsSceneMouseEvent *event) override;
 
 private:
+  // Below this level of detail, edges are drawn as plain lines without
+  // arrowheads or antialiasing.
+  static constexpr qreal ARROW_MIN_LEVEL_OF_DETAIL = 0.4;
+
   Node *source{nullptr};
   Node *dest{nullptr};
 
   QPointF sourcePoint;
   QPointF destPoint;
+  QPolygonF polygon;
 
   bool isUserMetadata_{false};
 };
@@ -27,10 +27,13 @@
 
 #include <math.h>
 
+#include <QtConcurrent/QtConcurrent>
+#include <QtCore/QPromise>
 #include <QtCore/QRandomGenerator>
 #include <QtGui/QGuiApplication>
 #include <QtGui/QKeyEvent>
 #include <QtWidgets/QStyle>
+#include <algorithm>
 #include <set>
 
 #include "gui/qt/groups_editor/edge.h"
@@ -39,6 +42,11 @@
 #include "gui/state/logging.h"
 
 namespace loot {
+// The graph hash includes node sizes, which depend on the font and display
+// scaling, so keep a few layouts to avoid recalculating one when switching
+// between them.
+static constexpr size_t MAX_CACHED_LAYOUTS = 8;
+
 std::map<std::string, Node *>::iterator insertNode(
     GraphView *graphView,
     std::map<std::string, Node *> &map,
@@ -107,15 +115,37 @@ GraphView::GraphView(QWidget *parent) :
   scale(INITIAL_SCALING_FACTOR, INITIAL_SCALING_FACTOR);
   setMinimumSize(MIN_VIEW_SIZE, MIN_VIEW_SIZE);
   setBackgroundBrush(QBrush(backgroundColor));
+
+  layoutAnimation->setDuration(LAYOUT_ANIMATION_DURATION_MS);
+  layoutAnimation->setStartValue(0.0);
+  layoutAnimation->setEndValue(1.0);
+  layoutAnimation->setEasingCurve(QEasingCurve::InOutQuad);
+
+  connect(layoutAnimation,
+          &QVariantAnimation::valueChanged,
+          this,
+          &GraphView::handleLayoutAnimationValueChanged);
+  connect(layoutAnimation, &QVariantAnimation::finished, this, [this]() {
+    nodeAnimations.clear();
+  });
+}
+
+GraphView::~GraphView() {
+  // Don't use cancelLayout() as it can emit a signal.
+  layoutFuture.cancel();
 }
 
 void GraphView::setGroups(const std::vector<Group> &masterlistGroups,
                           const std::vector<Group> &userGroups,
                           const std::set<std::string> &installedPluginGroups,
-                          const std::vector<GroupNodePosition> &nodePositions) {
-  // Remove all existing items.
+                          const std::vector<GroupNodePosition> &nodePositions,
+                          const std::filesystem::path &layoutCachePath) {
+  // Stop any layout or animation that refers to the existing items, then
+  // remove them.
+  cancelLayout();
   scene()->clear();
   hasUnsavedLayoutChanges_ = false;
+  this->layoutCachePath = layoutCachePath;
 
   // Now add the given groups.
   std::map<std::string, Node *> groupNameNodeMap;
@@ -217,7 +247,16 @@ void GraphView::setGroupContainsInstalledPlugins(
 }
 
 void GraphView::autoLayout() {
-  doLayout({});
+  auto input = getGraphLayoutInput(getNodes());
+  const auto graphHash = getGraphLayoutHash(input);
+
+  const auto cachedPositions = loadCachedLayout(graphHash);
+  if (cachedPositions.has_value()) {
+    cancelLayout();
+    animateLayout(cachedPositions.value());
+  } else {
+    startLayout(std::move(input), graphHash);
+  }
 
   // Reset unsaved change tracker because all user customisations have been
   // removed (while the auto layout results can vary, they're all pretty
@@ -225,6 +264,19 @@ void GraphView::autoLayout() {
   hasUnsavedLayoutChanges_ = false;
 }
 
+void GraphView::cancelLayout() {
+  layoutFuture.cancel();
+  currentLayoutId += 1;
+
+  layoutAnimation->stop();
+  nodeAnimations.clear();
+
+  if (isLayoutRunning) {
+    isLayoutRunning = false;
+    emit layoutFinished();
+  }
+}
+
 void GraphView::registerUserLayoutChange() { hasUnsavedLayoutChanges_ = true; }
 
 std::vector<Group> GraphView::getUserGroups() const {
@@ -256,6 +308,33 @@ std::vector<Group> GraphView::getUserGroups() const {
   return userGroups;
 }
 
+bool GraphView::wouldCreateCycle(const Node *fromNode,
+                                 const Node *toNode) const {
+  if (fromNode == toNode) {
+    return true;
+  }
+
+  std::set<const Node *> visited{toNode};
+  std::vector<const Node *> nodesToVisit{toNode};
+  while (!nodesToVisit.empty()) {
+    const auto node = nodesToVisit.back();
+    nodesToVisit.pop_back();
+
+    for (const auto edge : node->outEdges()) {
+      const auto nextNode = edge->destNode();
+      if (nextNode == fromNode) {
+        return true;
+      }
+
+      if (visited.insert(nextNode).second) {
+        nodesToVisit.push_back(nextNode);
+      }
+    }
+  }
+
+  return false;
+}
+
 std::vector<GroupNodePosition> GraphView::getNodePositions() const {
   std::vector<GroupNodePosition> nodePositions;
 
@@ -292,6 +371,15 @@ bool GraphView::isUserGroup(const std::string &name) const {
 }
 
 void GraphView::handleGroupRemoved(const QString &name) {
+  // The removed node is about to be deleted, so stop animating it.
+  nodeAnimations.erase(
+      std::remove_if(nodeAnimations.begin(),
+                     nodeAnimations.end(),
+                     [&](const NodeAnimation &animation) {
+                       return animation.node->getName() == name;
+                     }),
+      nodeAnimations.end());
+
   emit groupRemoved(name);
 }
 
@@ -331,7 +419,7 @@ void GraphView::wheelEvent(QWheelEvent *event) {
 }
 #endif
 
-void GraphView::doLayout(const std::vector<GroupNodePosition> &nodePositions) {
+std::vector<Node *> GraphView::getNodes() const {
   std::vector<Node *> nodes;
   for (const auto item : scene()->items()) {
     auto node = qgraphicsitem_cast<Node *>(item);
@@ -340,34 +428,228 @@ void GraphView::doLayout(const std::vector<GroupNodePosition> &nodePositions) {
     }
   }
 
-  const auto logger = getLogger();
+  return nodes;
+}
+
+void GraphView::doLayout(const std::vector<GroupNodePosition> &nodePositions) {
+  const auto nodes = getNodes();
+
+  const auto logger = getLogger(LogCategory::ui);
 
   if (!nodePositions.empty()) {
-    try {
-      const auto nodePositionsMap = convertNodePositions(nodePositions);
+    const auto nodePositionsMap = convertNodePositions(nodePositions);
+
+    std::vector<Node *> unpositionedNodes;
+    for (const auto node : nodes) {
+      const auto it = nodePositionsMap.find(node->getName().toStdString());
+      if (it == nodePositionsMap.end()) {
+        unpositionedNodes.push_back(node);
+      } else {
+        node->setPosition(it->second);
+      }
+    }
+
+    if (unpositionedNodes.size() < nodes.size()) {
+      // Place groups that have been added since the positions were saved
+      // next to their neighbours, instead of discarding the saved layout.
+      const auto newPositions =
+          calculateIncrementalLayout(nodes, unpositionedNodes);
+      for (const auto &[node, position] : newPositions) {
+        node->setPosition(position);
+      }
+
+      if (logger) {
+        logger->debug(
+            "Graph layout loaded from saved node positions, {} nodes were "
+            "placed incrementally",
+            unpositionedNodes.size());
+      }
+
+      return;
+    }
+
+    if (logger) {
+      logger->warn("None of the stored node positions match the groups");
+    }
+  }
+
+  auto input = getGraphLayoutInput(nodes);
+  const auto graphHash = getGraphLayoutHash(input);
 
-      setNodePositions(nodes, nodePositionsMap);
+  const auto cachedPositions = loadCachedLayout(graphHash);
+  if (cachedPositions.has_value()) {
+    try {
+      setNodePositions(nodes, cachedPositions.value());
 
       if (logger) {
-        logger->debug("Graph layout loaded from saved node positions");
+        logger->debug("Graph layout loaded from the layout cache");
       }
 
       return;
     } catch (const std::exception &e) {
       if (logger) {
-        logger->warn("Failed to set node positions from stored data: {}",
+        logger->warn("Failed to set node positions from cached layout: {}",
                      e.what());
       }
     }
   }
 
+  // Spread the nodes out so that they're usable while the graph layout is
+  // calculated.
+  for (const auto &[node, position] : calculateGridLayout(nodes)) {
+    node->setPosition(position);
+  }
+
+  startLayout(std::move(input), graphHash);
+}
+
+void GraphView::startLayout(GraphLayoutInput &&input, uint64_t graphHash) {
+  cancelLayout();
+
+  const auto logger = getLogger(LogCategory::ui);
   if (logger) {
     logger->debug("Calculating new graph layout");
   }
 
-  const auto calculatedNodePositions = calculateGraphLayout(nodes);
-  for (const auto &[node, position] : calculatedNodePositions) {
-    node->setPosition(position);
+  // The input is a copy of the graph data, so the worker thread doesn't
+  // access the scene.
+  layoutFuture = QtConcurrent::run(
+      [input = std::move(input)](
+          QPromise<std::map<std::string, QPointF>> &promise) {
+        if (promise.isCanceled()) {
+          return;
+        }
+
+        auto nodePositions = calculateGraphLayout(input);
+
+        // The layout calculation can't be interrupted, but its result can
+        // still be discarded.
+        if (!promise.isCanceled()) {
+          promise.addResult(std::move(nodePositions));
+        }
+      });
+
+  currentLayoutId += 1;
+  isLayoutRunning = true;
+  emit layoutStarted();
+
+  layoutFuture
+      .then(this,
+            [this, layoutId = currentLayoutId, graphHash](
+                std::map<std::string, QPointF> nodePositions) {
+              if (layoutId != currentLayoutId) {
+                // The layout was cancelled or a newer layout has started.
+                return;
+              }
+
+              isLayoutRunning = false;
+              saveCachedLayout(graphHash, nodePositions);
+              animateLayout(nodePositions);
+              emit layoutFinished();
+            })
+      .onFailed(this,
+                [this, layoutId = currentLayoutId](const std::exception &e) {
+                  const auto logger = getLogger(LogCategory::ui);
+                  if (logger) {
+                    logger->error("Failed to calculate graph layout: {}",
+                                  e.what());
+                  }
+
+                  if (layoutId == currentLayoutId) {
+                    isLayoutRunning = false;
+                    emit layoutFinished();
+                  }
+                });
+}
+
+void GraphView::animateLayout(
+    const std::map<std::string, QPointF> &nodePositions) {
+  layoutAnimation->stop();
+  nodeAnimations.clear();
+
+  for (const auto node : getNodes()) {
+    const auto it = nodePositions.find(node->getName().toStdString());
+    if (it != nodePositions.end()) {
+      nodeAnimations.push_back(NodeAnimation{node, node->pos(), it->second});
+    }
+  }
+
+  layoutAnimation->start();
+}
+
+std::optional<std::map<std::string, QPointF>> GraphView::loadCachedLayout(
+    uint64_t graphHash) const {
+  if (layoutCachePath.empty()) {
+    return std::nullopt;
+  }
+
+  try {
+    for (const auto &layout : LoadGroupLayouts(layoutCachePath)) {
+      if (layout.graphHash == graphHash) {
+        return convertNodePositions(layout.positions);
+      }
+    }
+  } catch (const std::exception &e) {
+    const auto logger = getLogger(LogCategory::ui);
+    if (logger) {
+      logger->warn("Failed to load the group layout cache: {}", e.what());
+    }
+  }
+
+  return std::nullopt;
+}
+
+void GraphView::saveCachedLayout(
+    uint64_t graphHash,
+    const std::map<std::string, QPointF> &nodePositions) const {
+  if (layoutCachePath.empty()) {
+    return;
+  }
+
+  GroupLayout layout{graphHash, {}};
+  for (const auto &[name, position] : nodePositions) {
+    layout.positions.push_back(
+        GroupNodePosition{name, position.x(), position.y()});
+  }
+
+  // Keep the most recently calculated layouts, newest first.
+  std::vector<GroupLayout> layouts;
+  layouts.push_back(std::move(layout));
+
+  try {
+    for (auto &cachedLayout : LoadGroupLayouts(layoutCachePath)) {
+      if (layouts.size() == MAX_CACHED_LAYOUTS) {
+        break;
+      }
+
+      if (cachedLayout.graphHash != graphHash) {
+        layouts.push_back(std::move(cachedLayout));
+      }
+    }
+  } catch (const std::exception &e) {
+    // Replace the cache if it can't be read.
+    const auto logger = getLogger(LogCategory::ui);
+    if (logger) {
+      logger->warn("Failed to load the group layout cache: {}", e.what());
+    }
+  }
+
+  try {
+    SaveGroupLayouts(layoutCachePath, layouts);
+  } catch (const std::exception &e) {
+    const auto logger = getLogger(LogCategory::ui);
+    if (logger) {
+      logger->warn("Failed to save the group layout cache: {}", e.what());
+    }
+  }
+}
+
+void GraphView::handleLayoutAnimationValueChanged(const QVariant &value) {
+  const auto progress = value.toReal();
+
+  for (const auto &animation : nodeAnimations) {
+    animation.node->setPosition(animation.start +
+                                (animation.end - animation.start) * progress);
   }
 }
 }
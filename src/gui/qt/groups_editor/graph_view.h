@@ -28,9 +28,15 @@
 
 #include <loot/metadata/group.h>
 
+#include <QtCore/QFuture>
+#include <QtCore/QVariantAnimation>
 #include <QtWidgets/QGraphicsView>
+#include <filesystem>
+#include <map>
+#include <optional>
 #include <set>
 
+#include "gui/qt/groups_editor/layout.h"
 #include "gui/state/game/group_node_positions.h"
 
 namespace loot {
@@ -45,23 +51,33 @@ class GraphView : public QGraphicsView {
 
 public:
   explicit GraphView(QWidget *parent = nullptr);
+  ~GraphView() override;
 
   void setGroups(const std::vector<Group> &masterlistGroups,
                  const std::vector<Group> &userGroups,
                  const std::set<std::string> &installedPluginGroups,
-                 const std::vector<GroupNodePosition> &nodePositions);
+                 const std::vector<GroupNodePosition> &nodePositions,
+                 const std::filesystem::path &layoutCachePath);
 
   bool addGroup(const std::string &name);
   void renameGroup(const std::string &oldName, const std::string &newName);
   void setGroupContainsInstalledPlugins(const std::string &name,
                                         bool containsInstalledPlugins);
+  // Calculates a new layout on a worker thread, and animates the nodes from
+  // their current positions to their new positions once it's ready. If the
+  // layout cache holds a layout for the current graph, that's used instead.
   void autoLayout();
+  void cancelLayout();
   void registerUserLayoutChange();
 
   std::vector<Group> getUserGroups() const;
   std::vector<GroupNodePosition> getNodePositions() const;
   bool hasUnsavedLayoutChanges() const;
   bool isUserGroup(const std::string &name) const;
+  // Adding an edge from one node to another creates a cycle if the first node
+  // can already be reached from the second by following existing edges.
+  // Only the nodes reachable from toNode are visited.
+  bool wouldCreateCycle(const Node *fromNode, const Node *toNode) const;
 
   void handleGroupRemoved(const QString &name);
   void handleGroupSelected(const QString &name);
@@ -73,6 +89,8 @@ public:
 signals:
   void groupRemoved(const QString name);
   void groupSelected(const QString &name);
+  void layoutStarted();
+  void layoutFinished();
 
 protected:
 #if QT_CONFIG(wheelevent)
@@ -81,13 +99,36 @@ protected:
 
 private:
   static constexpr qreal SCALE_CONSTANT = qreal(1.2);
+  static constexpr int LAYOUT_ANIMATION_DURATION_MS = 400;
+
+  struct NodeAnimation {
+    Node *node{nullptr};
+    QPointF start;
+    QPointF end;
+  };
 
   QColor masterColor;
   QColor userColor;
   QColor backgroundColor;
   bool hasUnsavedLayoutChanges_{false};
 
+  std::filesystem::path layoutCachePath;
+  QFuture<std::map<std::string, QPointF>> layoutFuture;
+  unsigned int currentLayoutId{0};
+  bool isLayoutRunning{false};
+  QVariantAnimation *layoutAnimation{new QVariantAnimation(this)};
+  std::vector<NodeAnimation> nodeAnimations;
+
+  std::vector<Node *> getNodes() const;
   void doLayout(const std::vector<GroupNodePosition> &nodePositions);
+  void startLayout(GraphLayoutInput &&input, uint64_t graphHash);
+  void animateLayout(const std::map<std::string, QPointF> &nodePositions);
+  std::optional<std::map<std::string, QPointF>> loadCachedLayout(
+      uint64_t graphHash) const;
+  void saveCachedLayout(
+      uint64_t graphHash,
+      const std::map<std::string, QPointF> &nodePositions) const;
+  void handleLayoutAnimationValueChanged(const QVariant &value);
 };
 }
 
@@ -78,9 +78,13 @@ void GroupsEditorDialog::setGroups(
     const std::vector<Group>& masterlistGroups,
     const std::vector<Group>& userGroups,
     const std::set<std::string>& installedPluginGroups,
-    const std::vector<GroupNodePosition>& nodePositions) {
-  graphView->setGroups(
-      masterlistGroups, userGroups, installedPluginGroups, nodePositions);
+    const std::vector<GroupNodePosition>& nodePositions,
+    const std::filesystem::path& layoutCachePath) {
+  graphView->setGroups(masterlistGroups,
+                       userGroups,
+                       installedPluginGroups,
+                       nodePositions,
+                       layoutCachePath);
 
   // Reset UI elements.
   groupPluginsTitle->setVisible(false);
@@ -94,6 +98,11 @@ void GroupsEditorDialog::setGroups(
   initialNodePositions = nodePositions;
   selectedGroupName = std::nullopt;
   newPluginGroups.clear();
+
+  groupPluginCounts.clear();
+  for (const auto& plugin : pluginItemModel->getPluginItems()) {
+    groupPluginCounts[getPluginGroup(plugin)] += 1;
+  }
 }
 
 std::vector<Group> loot::GroupsEditorDialog::getUserGroups() const {
@@ -159,6 +168,12 @@ void GroupsEditorDialog::setupUi() {
 
   autoArrangeButton->setObjectName("autoArrangeButton");
 
+  // The layout algorithm doesn't report its progress, so show a busy
+  // indicator while it runs.
+  layoutProgressBar->setRange(0, 0);
+  layoutProgressBar->setTextVisible(false);
+  layoutProgressBar->setVisible(false);
+
   auto buttonBox = new QDialogButtonBox(
       QDialogButtonBox::Save | QDialogButtonBox::Cancel, this);
   buttonBox->setObjectName("dialogButtons");
@@ -181,6 +196,7 @@ void GroupsEditorDialog::setupUi() {
   sidebarLayout->addLayout(formLayout);
   sidebarLayout->addWidget(divider2);
   sidebarLayout->addWidget(autoArrangeButton);
+  sidebarLayout->addWidget(layoutProgressBar);
   sidebarLayout->addLayout(formLayout);
 
   mainLayout->addWidget(graphView, 1);
@@ -224,6 +240,13 @@ void GroupsEditorDialog::closeEvent(QCloseEvent* event) {
   QDialog::closeEvent(event);
 }
 
+void GroupsEditorDialog::done(int result) {
+  // Don't move nodes around once the dialog is closed.
+  graphView->cancelLayout();
+
+  QDialog::done(result);
+}
+
 bool GroupsEditorDialog::askShouldDiscardChanges() {
   auto button = QMessageBox::question(
       this,
@@ -317,45 +340,36 @@ void GroupsEditorDialog::refreshPluginLists() {
 
 const PluginItem* GroupsEditorDialog::getPluginItem(
     const std::string& pluginName) const {
-  for (const auto& plugin : pluginItemModel->getPluginItems()) {
-    if (CompareFilenames(plugin.name, pluginName) == 0) {
-      return &plugin;
-    }
+  const auto row = pluginItemModel->getPluginRow(pluginName);
+  if (!row.has_value()) {
+    return nullptr;
   }
 
-  return nullptr;
+  // Row 0 is the general information card, which has no plugin item.
+  return &pluginItemModel->getPluginItems().at(row.value() - 1);
 }
 
 const std::string GroupsEditorDialog::getPluginGroup(
     const PluginItem& pluginItem) const {
   auto newPluginGroupIt = newPluginGroups.find(pluginItem.name);
 
-  return newPluginGroupIt == newPluginGroups.end()
-             ? pluginItem.group.value_or(Group::DEFAULT_NAME)
-             : newPluginGroupIt->second;
+  if (newPluginGroupIt != newPluginGroups.end()) {
+    return newPluginGroupIt->second;
+  }
+
+  return pluginItem.group.has_value() ? pluginItem.group.value().str()
+                                      : Group::DEFAULT_NAME;
 }
 
 bool GroupsEditorDialog::containsMoreThanOnePlugin(
     const std::string& groupName) const {
-  size_t pluginsCount = 0;
-
-  for (const auto& plugin : pluginItemModel->getPluginItems()) {
-    const auto pluginGroup = getPluginGroup(plugin);
+  const auto it = groupPluginCounts.find(groupName);
 
-    if (pluginGroup == groupName) {
-      if (pluginsCount == 1) {
-        return true;
-      }
-
-      pluginsCount += 1;
-    }
-  }
-
-  return false;
+  return it != groupPluginCounts.end() && it->second > 1;
 }
 
 void GroupsEditorDialog::handleException(const std::exception& exception) {
-  const auto logger = getLogger();
+  const auto logger = getLogger(LogCategory::ui);
   if (logger) {
     logger->error("Caught an exception: {}", exception.what());
   }
@@ -436,6 +450,16 @@ void GroupsEditorDialog::on_graphView_groupSelected(const QString& name) {
   renameGroupButton->setEnabled(shouldEnableRenameGroup);
 }
 
+void GroupsEditorDialog::on_graphView_layoutStarted() {
+  autoArrangeButton->setDisabled(true);
+  layoutProgressBar->setVisible(true);
+}
+
+void GroupsEditorDialog::on_graphView_layoutFinished() {
+  autoArrangeButton->setEnabled(true);
+  layoutProgressBar->setVisible(false);
+}
+
 void GroupsEditorDialog::on_groupPluginsList_customContextMenuRequested(
     const QPoint& position) {
   menuPluginsList->exec(groupPluginsList->mapToGlobal(position));
@@ -467,15 +491,17 @@ void GroupsEditorDialog::on_addPluginButton_clicked() {
     return;
   }
 
-  const auto pluginName = pluginComboBox->currentText().toStdString();
   const auto groupName = selectedGroupName.value();
 
-  // Get the plugin's item.
-  const auto pluginItem = getPluginItem(pluginName);
+  // Get the plugin's item. The entered text may not match the case of the
+  // plugin's name, so use the name from the item.
+  const auto pluginItem =
+      getPluginItem(pluginComboBox->currentText().toStdString());
   if (!pluginItem) {
     // Shouldn't be possible.
     return;
   }
+  const auto pluginName = pluginItem->name;
 
   // Get the plugin's current group.
   const auto currentPluginGroup = getPluginGroup(*pluginItem);
@@ -495,6 +521,12 @@ void GroupsEditorDialog::on_addPluginButton_clicked() {
     newPluginGroups.insert_or_assign(pluginName, groupName);
   }
 
+  const auto currentGroupCountIt = groupPluginCounts.find(currentPluginGroup);
+  if (currentGroupCountIt != groupPluginCounts.end()) {
+    currentGroupCountIt->second -= 1;
+  }
+  groupPluginCounts[groupName] += 1;
+
   // Refresh the group's plugin list.
   refreshPluginLists();
 
@@ -551,6 +583,13 @@ void GroupsEditorDialog::on_renameGroupButton_clicked() {
     }
   }
 
+  const auto oldCountIt = groupPluginCounts.find(oldName);
+  if (oldCountIt != groupPluginCounts.end()) {
+    const auto count = oldCountIt->second;
+    groupPluginCounts.erase(oldCountIt);
+    groupPluginCounts[newName] += count;
+  }
+
   // Update the stored selected group name.
   selectedGroupName = newName;
 
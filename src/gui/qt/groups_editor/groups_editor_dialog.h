@@ -33,6 +33,7 @@
 #include <QtWidgets/QLineEdit>
 #include <QtWidgets/QListWidget>
 #include <QtWidgets/QMenu>
+#include <QtWidgets/QProgressBar>
 #include <QtWidgets/QPushButton>
 #include <QtWidgets/QWidget>
 #include <set>
@@ -49,7 +50,8 @@ public:
   void setGroups(const std::vector<Group> &masterlistGroups,
                  const std::vector<Group> &userGroups,
                  const std::set<std::string> &installedPluginGroups,
-                 const std::vector<GroupNodePosition> &nodePositions);
+                 const std::vector<GroupNodePosition> &nodePositions,
+                 const std::filesystem::path &layoutCachePath);
 
   std::vector<Group> getUserGroups() const;
   std::vector<GroupNodePosition> getNodePositions() const;
@@ -65,6 +67,7 @@ private:
   QPushButton *addPluginButton{new QPushButton(this)};
 
   QPushButton *autoArrangeButton{new QPushButton(this)};
+  QProgressBar *layoutProgressBar{new QProgressBar(this)};
 
   QLabel *groupNameInputLabel{new QLabel(this)};
   QLineEdit *groupNameInput{new QLineEdit(this)};
@@ -80,11 +83,16 @@ private:
   std::vector<GroupNodePosition> initialNodePositions;
   std::optional<std::string> selectedGroupName;
   std::unordered_map<std::string, std::string> newPluginGroups;
+  // The number of plugins in each group, including unsaved changes to
+  // plugins' groups, so that they don't need to be counted again each time a
+  // plugin is moved.
+  std::unordered_map<std::string, size_t> groupPluginCounts;
 
   void setupUi();
   void translateUi();
 
   void closeEvent(QCloseEvent *event) override;
+  void done(int result) override;
 
   bool askShouldDiscardChanges();
   bool hasUnsavedChanges();
@@ -100,6 +108,8 @@ private slots:
   void on_actionCopyPluginNames_triggered();
   void on_graphView_groupRemoved(const QString name);
   void on_graphView_groupSelected(const QString &name);
+  void on_graphView_layoutStarted();
+  void on_graphView_layoutFinished();
   void on_groupPluginsList_customContextMenuRequested(const QPoint &position);
   void on_pluginComboBox_editTextChanged(const QString &text);
   void on_groupNameInput_textChanged(const QString &text);
@@ -25,19 +25,108 @@
 
 #include "gui/qt/groups_editor/layout.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <ogdf/basic/GraphAttributes.h>
 #include <ogdf/layered/MedianHeuristic.h>
 #include <ogdf/layered/OptimalHierarchyLayout.h>
 #include <ogdf/layered/OptimalRanking.h>
 #include <ogdf/layered/SugiyamaLayout.h>
+#include <optional>
+#include <set>
 
 #include "gui/qt/groups_editor/edge.h"
 
 namespace loot {
 constexpr double LAYER_SPACING = 30.0;
 
-std::map<Node *, QPointF> calculateGraphLayout(
-    const std::vector<Node *> &nodes) {
+GraphLayoutInput getGraphLayoutInput(const std::vector<Node *> &nodes) {
+  GraphLayoutInput input;
+
+  std::map<Node *, size_t> nodeIndices;
+  for (const auto node : nodes) {
+    const auto boundingRect =
+        node->boundingRect().marginsRemoved(Node::MARGINS);
+
+    nodeIndices.emplace(node, input.nodeNames.size());
+    input.nodeNames.push_back(node->getName().toStdString());
+    input.nodeSizes.push_back(boundingRect.size());
+  }
+
+  // Now add all edges, without having to worry if the nodes have been seen
+  // yet or not.
+  for (const auto node : nodes) {
+    const auto fromIndex = nodeIndices.find(node);
+    if (fromIndex == nodeIndices.end()) {
+      throw std::logic_error("Node is not in graph");
+    }
+
+    for (const auto outEdge : node->outEdges()) {
+      const auto toIndex = nodeIndices.find(outEdge->destNode());
+      if (toIndex == nodeIndices.end()) {
+        throw std::logic_error("Node is not in graph");
+      }
+
+      input.edges.emplace_back(fromIndex->second, toIndex->second);
+    }
+  }
+
+  return input;
+}
+
+uint64_t getGraphLayoutHash(const GraphLayoutInput &input) {
+  // Use FNV-1a instead of qHash() because qHash() is seeded differently in
+  // each session.
+  static constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325;
+  static constexpr uint64_t FNV_PRIME = 0x100000001b3;
+
+  uint64_t hash = FNV_OFFSET_BASIS;
+  const auto addBytes = [&](const std::string &bytes) {
+    for (const auto byte : bytes) {
+      hash ^= static_cast<uint8_t>(byte);
+      hash *= FNV_PRIME;
+    }
+    // Separate values so that their boundaries affect the hash.
+    hash ^= 0xff;
+    hash *= FNV_PRIME;
+  };
+
+  // Sort the nodes and edges by name so that their order doesn't matter.
+  // Sizes are rounded to whole pixels to avoid floating point noise.
+  std::vector<std::string> nodes;
+  for (size_t i = 0; i < input.nodeNames.size(); ++i) {
+    const auto size = input.nodeSizes.at(i).toSize();
+
+    nodes.push_back(input.nodeNames.at(i) + '\n' +
+                    std::to_string(size.width()) + 'x' +
+                    std::to_string(size.height()));
+  }
+  std::sort(nodes.begin(), nodes.end());
+
+  std::vector<std::string> edges;
+  for (const auto &[fromIndex, toIndex] : input.edges) {
+    edges.push_back(input.nodeNames.at(fromIndex) + '\n' +
+                    input.nodeNames.at(toIndex));
+  }
+  std::sort(edges.begin(), edges.end());
+
+  for (const auto &node : nodes) {
+    addBytes(node);
+  }
+
+  // Separate the nodes from the edges.
+  addBytes(std::string());
+
+  for (const auto &edge : edges) {
+    addBytes(edge);
+  }
+
+  return hash;
+}
+
+std::map<std::string, QPointF> calculateGraphLayout(
+    const GraphLayoutInput &input) {
   ogdf::Graph graph;
   ogdf::GraphAttributes graphAttributes(
       graph,
@@ -50,39 +139,24 @@ std::map<Node *, QPointF> calculateGraphLayout(
   graphAttributes.directed() = true;
 
   // Add all nodes to the graph.
-  std::map<Node *, ogdf::node> graphNodes;
-  std::map<ogdf::node, Node *> sceneNodes;
-  for (const auto node : nodes) {
+  std::vector<ogdf::node> graphNodes;
+  std::map<ogdf::node, size_t> nodeIndices;
+  for (size_t i = 0; i < input.nodeSizes.size(); ++i) {
     const auto graphNode = graph.newNode();
-    const auto boundingRect =
-        node->boundingRect().marginsRemoved(Node::MARGINS);
+    const auto &size = input.nodeSizes.at(i);
 
     // The height and width are transposed because the layout algorithm
     // arranges layers vertically, and the result is then rotated to get a
     // horizontal layout.
-    graphAttributes.width(graphNode) = boundingRect.height();
-    graphAttributes.height(graphNode) = boundingRect.width();
+    graphAttributes.width(graphNode) = size.height();
+    graphAttributes.height(graphNode) = size.width();
 
-    graphNodes.emplace(node, graphNode);
-    sceneNodes.emplace(graphNode, node);
+    graphNodes.push_back(graphNode);
+    nodeIndices.emplace(graphNode, i);
   }
 
-  // Now add all edges to the graph, without having to worry if the nodes
-  // already exist or not.
-  for (const auto node : nodes) {
-    const auto fromGraphNode = graphNodes.find(node);
-    if (fromGraphNode == graphNodes.end()) {
-      throw std::logic_error("Node is not in graph");
-    }
-
-    for (const auto outEdge : node->outEdges()) {
-      const auto toGraphNode = graphNodes.find(outEdge->destNode());
-      if (toGraphNode == graphNodes.end()) {
-        throw std::logic_error("Node is not in graph");
-      }
-
-      graph.newEdge(fromGraphNode->second, toGraphNode->second);
-    }
+  for (const auto &[fromIndex, toIndex] : input.edges) {
+    graph.newEdge(graphNodes.at(fromIndex), graphNodes.at(toIndex));
   }
 
   ogdf::SugiyamaLayout SL;
@@ -99,17 +173,170 @@ std::map<Node *, QPointF> calculateGraphLayout(
   // Now rotate the layout to get a layers arranged horizontally.
   graphAttributes.rotateLeft90();
 
-  std::map<Node *, QPointF> nodePositions;
+  std::map<std::string, QPointF> nodePositions;
 
   for (const auto node : graph.nodes) {
     QPointF position(graphAttributes.x(node), graphAttributes.y(node));
 
-    const auto sceneNode = sceneNodes.find(node);
-    if (sceneNode == sceneNodes.end()) {
+    const auto nodeIndex = nodeIndices.find(node);
+    if (nodeIndex == nodeIndices.end()) {
       throw std::logic_error("Node is not in scene");
     }
 
-    nodePositions.emplace(sceneNode->second, position);
+    nodePositions.emplace(input.nodeNames.at(nodeIndex->second), position);
+  }
+
+  return nodePositions;
+}
+
+QRectF getNodeRect(const Node *node, const QPointF &position) {
+  return node->boundingRect()
+      .marginsRemoved(Node::MARGINS)
+      .translated(position);
+}
+
+bool hasPositionedNeighbour(const Node *node,
+                            const std::map<Node *, QPointF> &positions) {
+  for (const auto edge : node->edges()) {
+    const auto neighbour =
+        edge->sourceNode() == node ? edge->destNode() : edge->sourceNode();
+    if (positions.count(neighbour) > 0) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+QPointF getIncrementalPosition(const Node *node,
+                               const std::map<Node *, QPointF> &positions) {
+  const auto halfWidth = getNodeRect(node, QPointF()).width() / 2;
+
+  std::optional<qreal> predecessorsRight;
+  std::optional<qreal> successorsLeft;
+  qreal neighboursY = 0;
+  int neighbourCount = 0;
+
+  for (const auto edge : node->inEdges()) {
+    const auto it = positions.find(edge->sourceNode());
+    if (it != positions.end()) {
+      const auto right = getNodeRect(it->first, it->second).right();
+      predecessorsRight = std::max(predecessorsRight.value_or(right), right);
+      neighboursY += it->second.y();
+      neighbourCount += 1;
+    }
+  }
+
+  for (const auto edge : node->outEdges()) {
+    const auto it = positions.find(edge->destNode());
+    if (it != positions.end()) {
+      const auto left = getNodeRect(it->first, it->second).left();
+      successorsLeft = std::min(successorsLeft.value_or(left), left);
+      neighboursY += it->second.y();
+      neighbourCount += 1;
+    }
+  }
+
+  if (predecessorsRight.has_value()) {
+    return QPointF(predecessorsRight.value() + LAYER_SPACING + halfWidth,
+                   neighboursY / neighbourCount);
+  }
+
+  if (successorsLeft.has_value()) {
+    return QPointF(successorsLeft.value() - LAYER_SPACING - halfWidth,
+                   neighboursY / neighbourCount);
+  }
+
+  // The node has no positioned neighbours, so put it below all the
+  // positioned nodes.
+  if (positions.empty()) {
+    return QPointF();
+  }
+
+  qreal left = std::numeric_limits<qreal>::max();
+  qreal bottom = std::numeric_limits<qreal>::lowest();
+  for (const auto &[positionedNode, position] : positions) {
+    const auto rect = getNodeRect(positionedNode, position);
+    left = std::min(left, rect.left());
+    bottom = std::max(bottom, rect.bottom());
+  }
+
+  return QPointF(left + halfWidth, bottom + NODE_SPACING);
+}
+
+std::map<Node *, QPointF> calculateIncrementalLayout(
+    const std::vector<Node *> &nodes,
+    const std::vector<Node *> &nodesToPlace) {
+  const std::set<Node *> nodesToPlaceSet(nodesToPlace.begin(),
+                                         nodesToPlace.end());
+
+  std::map<Node *, QPointF> positions;
+  for (const auto node : nodes) {
+    if (nodesToPlaceSet.count(node) == 0) {
+      positions.emplace(node, node->pos());
+    }
+  }
+
+  std::map<Node *, QPointF> newPositions;
+  auto remainingNodes = nodesToPlace;
+  while (!remainingNodes.empty()) {
+    // Place nodes next to positioned neighbours first, so that a chain of
+    // new nodes gets placed outwards from the existing nodes.
+    auto it = std::find_if(
+        remainingNodes.begin(), remainingNodes.end(), [&](const Node *node) {
+          return hasPositionedNeighbour(node, positions);
+        });
+    if (it == remainingNodes.end()) {
+      it = remainingNodes.begin();
+    }
+
+    const auto node = *it;
+    remainingNodes.erase(it);
+
+    auto position = getIncrementalPosition(node, positions);
+
+    const auto overlapsPositionedNode = [&]() {
+      const auto rect = getNodeRect(node, position);
+      return std::any_of(positions.begin(),
+                         positions.end(),
+                         [&](const std::pair<Node *const, QPointF> &entry) {
+                           return getNodeRect(entry.first, entry.second)
+                               .intersects(rect);
+                         });
+    };
+
+    while (overlapsPositionedNode()) {
+      position.ry() += NODE_SPACING;
+    }
+
+    positions.emplace(node, position);
+    newPositions.emplace(node, position);
+  }
+
+  return newPositions;
+}
+
+std::map<Node *, QPointF> calculateGridLayout(
+    const std::vector<Node *> &nodes) {
+  qreal cellWidth = 0;
+  qreal cellHeight = 0;
+  for (const auto node : nodes) {
+    const auto boundingRect =
+        node->boundingRect().marginsRemoved(Node::MARGINS);
+    cellWidth = std::max(cellWidth, boundingRect.width() + NODE_SPACING);
+    cellHeight = std::max(cellHeight, boundingRect.height() + LAYER_SPACING);
+  }
+
+  const auto columnCount = static_cast<size_t>(
+      std::ceil(std::sqrt(static_cast<double>(nodes.size()))));
+
+  std::map<Node *, QPointF> nodePositions;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    const auto column = static_cast<qreal>(i % columnCount);
+    const auto row = static_cast<qreal>(i / columnCount);
+
+    nodePositions.emplace(nodes.at(i),
+                          QPointF(column * cellWidth, row * cellHeight));
   }
 
   return nodePositions;
@@ -27,7 +27,11 @@
 #define LOOT_GUI_QT_GROUPS_EDITOR_LAYOUT
 
 #include <QtCore/QPoint>
+#include <QtCore/QSizeF>
+#include <cstdint>
 #include <map>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "gui/qt/groups_editor/node.h"
@@ -35,7 +39,38 @@
 namespace loot {
 constexpr qreal NODE_SPACING = 70;
 
-std::map<Node*, QPointF> calculateGraphLayout(const std::vector<Node*>& nodes);
+// A copy of the graph data that the layout algorithm needs, so that the layout
+// can be calculated without accessing the scene's items.
+struct GraphLayoutInput {
+  std::vector<std::string> nodeNames;
+  std::vector<QSizeF> nodeSizes;
+  // Each edge is a pair of indices into the node vectors.
+  std::vector<std::pair<size_t, size_t>> edges;
+};
+
+GraphLayoutInput getGraphLayoutInput(const std::vector<Node*>& nodes);
+
+// The hash doesn't depend on the order of the nodes or edges, and is stable
+// across sessions, so it can be used to identify a cached layout.
+uint64_t getGraphLayoutHash(const GraphLayoutInput& input);
+
+// This does not access any Qt objects, so it can be called from a worker
+// thread. The positions are mapped by node name.
+std::map<std::string, QPointF> calculateGraphLayout(
+    const GraphLayoutInput& input);
+
+// Positions the given nodes next to their neighbours without moving any other
+// nodes. Each node is placed one layer after its rightmost positioned
+// predecessor (or one layer before its leftmost positioned successor), at the
+// mean height of its positioned neighbours, and is then moved down until it
+// doesn't overlap any other node.
+std::map<Node*, QPointF> calculateIncrementalLayout(
+    const std::vector<Node*>& nodes,
+    const std::vector<Node*>& nodesToPlace);
+
+// A quick layout that arranges the nodes in a grid, for use while a graph
+// layout is calculated.
+std::map<Node*, QPointF> calculateGridLayout(const std::vector<Node*>& nodes);
 }
 
 #endif
@@ -25,12 +25,15 @@
 
 #include "gui/qt/groups_editor/node.h"
 
+#include <spdlog/fmt/fmt.h>
+
 #include <QtGui/QGuiApplication>
 #include <QtGui/QPainter>
 #include <QtWidgets/QGraphicsScene>
 #include <QtWidgets/QGraphicsSceneMouseEvent>
 #include <QtWidgets/QMessageBox>
 #include <QtWidgets/QStyleOption>
+#include <boost/locale.hpp>
 
 #include "gui/qt/groups_editor/edge.h"
 #include "gui/qt/groups_editor/graph_view.h"
@@ -53,6 +56,12 @@ NodeLabel::NodeLabel(const GraphView &graphView,
 void NodeLabel::paint(QPainter *painter,
                       const QStyleOptionGraphicsItem *option,
                       QWidget *widget) {
+  const auto levelOfDetail =
+      option->levelOfDetailFromTransform(painter->worldTransform());
+  if (levelOfDetail < MIN_LEVEL_OF_DETAIL) {
+    return;
+  }
+
   const auto backgroundColor =
       qobject_cast<GraphView *>(scene()->parent())->getBackgroundColor();
 
@@ -204,7 +213,7 @@ void Node::mousePressEvent(QGraphicsSceneMouseEvent *event) {
 
   if (isUserMetadata_ && !containsInstalledPlugins &&
       event->button() == Qt::RightButton) {
-    auto logger = getLogger();
+    auto logger = getLogger(LogCategory::ui);
     if (logger) {
       logger->info("Removing node for group {}",
                    textItem->text().toStdString());
@@ -267,13 +276,29 @@ void Node::mouseReleaseEvent(QGraphicsSceneMouseEvent *event) {
   const auto mousePos = event->scenePos();
   auto itemsUnderMouse = scene()->items(mousePos);
 
-  auto logger = getLogger();
+  const auto graphView = qobject_cast<GraphView *>(scene()->parent());
+  auto logger = getLogger(LogCategory::ui);
+  Node *cyclicNode = nullptr;
   for (const auto item : itemsUnderMouse) {
     auto node = qgraphicsitem_cast<Node *>(item);
     if (!node || node == this) {
       continue;
     }
 
+    // Check for a cycle as the edge is added, so that the user finds out
+    // now instead of when sorting next fails.
+    if (graphView->wouldCreateCycle(this, node)) {
+      if (logger) {
+        logger->warn(
+            "Not adding edge from {} to {} as it would create a cycle",
+            textItem->text().toStdString(),
+            node->textItem->text().toStdString());
+      }
+
+      cyclicNode = node;
+      continue;
+    }
+
     if (logger) {
       logger->info("Adding edge from {} to {}",
                    textItem->text().toStdString(),
@@ -286,6 +311,18 @@ void Node::mouseReleaseEvent(QGraphicsSceneMouseEvent *event) {
 
   drawEdgeToCursor = false;
   removeEdgeToCursor();
+
+  if (cyclicNode != nullptr) {
+    const auto message = fmt::format(
+        boost::locale::translate(
+            "The group \"{0}\" cannot load after \"{1}\", because "
+            "\"{1}\" already loads after \"{0}\".")
+            .str(),
+        cyclicNode->getName().toStdString(),
+        getName().toStdString());
+
+    QMessageBox::critical(graphView, "LOOT", QString::fromStdString(message));
+  }
 }
 
 void Node::mouseDoubleClickEvent(QGraphicsSceneMouseEvent *event) {
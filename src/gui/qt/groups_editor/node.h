@@ -45,6 +45,11 @@ public:
   void paint(QPainter *painter,
              const QStyleOptionGraphicsItem *option,
              QWidget *widget) override;
+
+private:
+  // Below this level of detail, labels are too small to read, so they're not
+  // drawn.
+  static constexpr qreal MIN_LEVEL_OF_DETAIL = 0.3;
 };
 
 class Node : public QGraphicsItem {
@@ -0,0 +1,348 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/qt/headless_sort.h"
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <set>
+
+#include "gui/qt/counters.h"
+#include "gui/qt/tasks/tasks.h"
+#include "gui/qt/tasks/update_masterlist_task.h"
+#include "gui/query/types/apply_sort_query.h"
+#include "gui/query/types/get_game_data_query.h"
+#include "gui/query/types/sort_plugins_query.h"
+#include "gui/state/thread_pool.h"
+
+namespace {
+using loot::LootState;
+using loot::MessageType;
+using loot::PluginItem;
+using loot::runConcurrently;
+using loot::SourcedMessage;
+
+QString toString(MessageType type) {
+  switch (type) {
+    case MessageType::warn:
+      return "warn";
+    case MessageType::error:
+      return "error";
+    default:
+      return "say";
+  }
+}
+
+QJsonArray toJson(const std::vector<SourcedMessage>& messages) {
+  QJsonArray array;
+  for (const auto& message : messages) {
+    // Notes are only informative, so leave them out of the summary.
+    if (message.type == MessageType::say) {
+      continue;
+    }
+
+    array.append(QJsonObject{{"type", toString(message.type)},
+                             {"text", QString::fromStdString(message.text)}});
+  }
+
+  return array;
+}
+
+QJsonArray toJson(const std::vector<std::string>& strings) {
+  QJsonArray array;
+  for (const auto& string : strings) {
+    array.append(QString::fromStdString(string));
+  }
+
+  return array;
+}
+
+// The state of sorting one game. The current game is owned by LootState, but
+// any other games are created for the headless run.
+struct GameSort {
+  std::string folderName;
+  std::unique_ptr<loot::gui::Game> ownedGame;
+  loot::gui::Game* game{nullptr};
+  loot::UnappliedChangeCounter counter;
+  std::optional<std::string> error;
+  QString result{"failed"};
+  std::optional<std::vector<std::string>> loadOrder;
+};
+
+std::vector<SourcedMessage> getGeneralMessages(const LootState& state,
+                                               const GameSort& sort) {
+  auto messages = state.getInitMessages();
+
+  if (sort.game != nullptr && sort.game->IsInitialised()) {
+    const auto gameMessages = sort.game->GetMessages(
+        state.getSettings().getLanguage(),
+        state.getSettings().isWarnOnCaseSensitiveGamePathsEnabled());
+    messages.insert(messages.end(), gameMessages.begin(), gameMessages.end());
+  }
+
+  return messages;
+}
+
+bool hasErrorMessages(const std::vector<SourcedMessage>& messages) {
+  return std::any_of(
+      messages.begin(), messages.end(), [](const SourcedMessage& message) {
+        return message.type == MessageType::error;
+      });
+}
+
+std::vector<std::string> getPluginNames(const std::vector<PluginItem>& items) {
+  std::vector<std::string> names;
+  names.reserve(items.size());
+  for (const auto& item : items) {
+    names.push_back(item.name);
+  }
+
+  return names;
+}
+
+void logProgress(const std::string& message) {
+  const auto logger = loot::getLogger();
+  if (logger) {
+    logger->info("{}", message);
+  }
+}
+
+void logError(const GameSort& sort, const std::string& error) {
+  const auto logger = loot::getLogger();
+  if (logger) {
+    logger->error("Headless sort failed for {}: {}", sort.folderName, error);
+  }
+}
+
+// Runs the given function for each sort that hasn't failed yet, concurrently,
+// recording any exception as that sort's error.
+template<typename Function>
+void forEachSortConcurrently(std::vector<std::unique_ptr<GameSort>>& sorts,
+                             Function function) {
+  std::vector<std::function<void()>> functions;
+  for (auto& sort : sorts) {
+    if (sort->error.has_value() || sort->game == nullptr) {
+      continue;
+    }
+
+    functions.push_back([&sort = *sort, &function]() {
+      try {
+        function(sort);
+      } catch (const std::exception& e) {
+        logError(sort, e.what());
+        sort.error = e.what();
+      }
+    });
+  }
+
+  runConcurrently(functions);
+}
+
+std::vector<std::unique_ptr<GameSort>> createGameSorts(
+    LootState& state,
+    const std::vector<std::string>& gameFolderNames) {
+  std::vector<std::unique_ptr<GameSort>> sorts;
+  std::set<std::string> seenFolderNames;
+
+  for (const auto& folderName : gameFolderNames) {
+    if (!seenFolderNames.insert(folderName).second) {
+      continue;
+    }
+
+    auto sort = std::make_unique<GameSort>();
+    sort->folderName = folderName;
+
+    if (state.HasCurrentGame() &&
+        state.GetCurrentGame().GetSettings().FolderName() == folderName) {
+      sort->game = &state.GetCurrentGame();
+    } else {
+      const auto& gamesSettings = state.getSettings().getGameSettings();
+      const auto it = std::find_if(gamesSettings.begin(),
+                                   gamesSettings.end(),
+                                   [&](const loot::GameSettings& settings) {
+                                     return settings.FolderName() == folderName;
+                                   });
+
+      if (it == gamesSettings.end() || !state.IsGameInstalled(folderName)) {
+        sort->error = "The game with folder \"" + folderName +
+                      "\" cannot be found.";
+      } else {
+        sort->ownedGame = std::make_unique<loot::gui::Game>(
+            *it, state.getLootDataPath(), state.getPreludePath());
+        sort->game = sort->ownedGame.get();
+      }
+    }
+
+    sorts.push_back(std::move(sort));
+  }
+
+  return sorts;
+}
+
+void updateMasterlists(LootState& state,
+                       std::vector<std::unique_ptr<GameSort>>& sorts) {
+  // The prelude is shared by all games, so it only needs updating once. The
+  // network tasks run on their own worker thread, so it's fine to block the
+  // main thread while waiting for them.
+  const auto preludeTask = new loot::UpdatePreludeTask(state);
+  auto preludeFuture = loot::executeBackgroundTask(preludeTask);
+
+  std::vector<std::pair<GameSort*, QFuture<loot::QueryResult>>> futures;
+  for (auto& sort : sorts) {
+    if (!sort->error.has_value() && sort->game != nullptr) {
+      const auto task =
+          new loot::UpdateMasterlistTask(*sort->game, state.getSettings());
+      futures.emplace_back(sort.get(), loot::executeBackgroundTask(task));
+    }
+  }
+
+  std::optional<std::string> preludeError;
+  try {
+    preludeFuture.result();
+  } catch (const std::exception& e) {
+    preludeError = e.what();
+  }
+
+  for (auto& [sort, future] : futures) {
+    try {
+      future.result();
+    } catch (const std::exception& e) {
+      logError(*sort, e.what());
+      sort->error = e.what();
+    }
+
+    if (preludeError.has_value() && !sort->error.has_value()) {
+      logError(*sort, preludeError.value());
+      sort->error = preludeError;
+    }
+  }
+}
+
+void sortAndApply(const LootState& state, GameSort& sort) {
+  auto& game = *sort.game;
+  const auto language = state.getSettings().getLanguage();
+
+  // Loading the game data for the first time also loads the masterlist, so
+  // there's no need to reload metadata after updating it.
+  loot::GetGameDataQuery gameDataQuery(game, language, logProgress);
+  auto pluginItems = std::get<loot::PluginItems>(gameDataQuery.executeLogic());
+
+  const auto counters = loot::GeneralInformationCounters(
+      getGeneralMessages(state, sort), pluginItems);
+  if (counters.errors != 0) {
+    // This is consistent with --auto-sort.
+    sort.result = "cancelled";
+    return;
+  }
+
+  loot::SortPluginsQuery sortQuery(game, sort.counter, language, logProgress);
+  sortQuery.setCurrentPluginItems(std::move(pluginItems));
+
+  const auto sortedPlugins =
+      std::get<loot::PluginItems>(sortQuery.executeLogic());
+  if (sortedPlugins.empty()) {
+    // The cause of the sorting failure is given in the general messages.
+    return;
+  }
+
+  sort.loadOrder = getPluginNames(sortedPlugins);
+
+  if (game.GetLoadOrder() == sort.loadOrder.value()) {
+    sort.counter.DecrementUnappliedChangeCounter();
+    sort.result = "unchanged";
+    return;
+  }
+
+  loot::ApplySortQuery<> applyQuery(game, sort.counter, sort.loadOrder.value());
+  try {
+    applyQuery.executeLogic();
+  } catch (const std::exception& e) {
+    logError(sort, e.what());
+    throw std::runtime_error(applyQuery.getErrorMessage());
+  }
+
+  sort.result = "applied";
+}
+
+QJsonObject toJson(const LootState& state, const GameSort& sort) {
+  QJsonObject summary{{"game", QString::fromStdString(sort.folderName)},
+                      {"result", sort.result}};
+
+  if (sort.loadOrder.has_value()) {
+    summary["loadOrder"] = toJson(sort.loadOrder.value());
+  }
+
+  summary["messages"] = toJson(getGeneralMessages(state, sort));
+
+  if (sort.error.has_value()) {
+    summary["error"] = QString::fromStdString(sort.error.value());
+  }
+
+  return summary;
+}
+}
+
+namespace loot {
+int runHeadlessSort(LootState& state,
+                    const std::vector<std::string>& gameFolderNames) {
+  auto sorts = createGameSorts(state, gameFolderNames);
+
+  if (!hasErrorMessages(state.getInitMessages())) {
+    // Each game has its own instance, so they can be loaded and sorted in
+    // parallel. Initialising the current game here means that if it fails,
+    // the failure is recorded for that game and the others are still sorted.
+    forEachSortConcurrently(sorts, [](GameSort& sort) { sort.game->Init(); });
+
+    if (state.getSettings().isMasterlistUpdateBeforeSortEnabled()) {
+      logProgress("Updating masterlists and prelude.");
+      updateMasterlists(state, sorts);
+    }
+
+    forEachSortConcurrently(
+        sorts, [&state](GameSort& sort) { sortAndApply(state, sort); });
+  }
+
+  auto exitCode = EXIT_SUCCESS;
+  for (const auto& sort : sorts) {
+    if (sort->result != "applied" && sort->result != "unchanged") {
+      exitCode = EXIT_FAILURE;
+    }
+
+    std::cout << QJsonDocument(toJson(state, *sort))
+                     .toJson(QJsonDocument::Compact)
+                     .constData()
+              << std::endl;
+  }
+
+  return exitCode;
+}
+}
@@ -0,0 +1,47 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_QT_HEADLESS_SORT
+#define LOOT_GUI_QT_HEADLESS_SORT
+
+#include <string>
+#include <vector>
+
+#include "gui/state/loot_state.h"
+
+namespace loot {
+// Sorts the load orders of the games with the given LOOT folder names and
+// applies them without creating any widgets, then writes a single-line JSON
+// summary of the outcome for each game to stdout. The current game is sorted
+// using its existing instance, and other games get their own instances so
+// that all games can be loaded and sorted in parallel. Returns EXIT_SUCCESS
+// if every game's sorted load order was applied or sorting made no changes,
+// and EXIT_FAILURE otherwise. This must be called from the main thread after
+// a QCoreApplication has been created.
+int runHeadlessSort(LootState& state,
+                    const std::vector<std::string>& gameFolderNames);
+}
+
+#endif
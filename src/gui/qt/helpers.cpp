@@ -33,6 +33,7 @@
 #include <QtCore/QDate>
 #include <QtCore/QFile>
 #include <QtCore/QPoint>
+#include <QtCore/QSaveFile>
 #include <QtCore/QUrl>
 #include <QtGui/QClipboard>
 #include <QtGui/QDesktopServices>
@@ -40,7 +41,12 @@
 #include <QtWidgets/QToolTip>
 #include <QtWidgets/QWidget>
 #include <boost/locale.hpp>
+#include <chrono>
+#include <cstdint>
 #include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
 
 #ifndef _WIN32
 #include <QtCore/QProcess>
@@ -52,16 +58,129 @@ namespace loot {
 static constexpr const char* METADATA_PATH_SUFFIX = ".metadata.toml";
 static constexpr const char* METADATA_ID_KEY = "blob_sha1";
 static constexpr const char* METADATA_DATE_KEY = "update_timestamp";
+static constexpr const char* METADATA_ETAG_KEY = "etag";
+static constexpr const char* METADATA_LAST_MODIFIED_KEY = "last_modified";
+static constexpr const char* METADATA_FILE_SIZE_KEY = "file_size";
+static constexpr const char* METADATA_FILE_WRITE_TIME_KEY = "file_write_time";
+static constexpr const char* METADATA_SOURCE_PATH_KEY = "source_path";
+static constexpr const char* METADATA_SOURCE_SIZE_KEY = "source_file_size";
+static constexpr const char* METADATA_SOURCE_WRITE_TIME_KEY =
+    "source_file_write_time";
 static constexpr int SHORT_HASH_LENGTH = 7;
 
+// Shared download cache entries that were checked against their source longer
+// ago than this are revalidated with the source before they're used.
+static constexpr std::chrono::hours SHARED_CACHE_ENTRY_MAX_AGE{1};
+
+// The sizes and write times of a file and its metadata file, which must be
+// unchanged for a cached revision summary of the file to be used.
+struct FileRevisionStamp {
+  uintmax_t fileSize{0};
+  int64_t fileWriteTime{0};
+  uintmax_t metadataSize{0};
+  int64_t metadataWriteTime{0};
+
+  bool operator==(const FileRevisionStamp& other) const {
+    return fileSize == other.fileSize &&
+           fileWriteTime == other.fileWriteTime &&
+           metadataSize == other.metadataSize &&
+           metadataWriteTime == other.metadataWriteTime;
+  }
+};
+
+struct CachedFileRevisionSummary {
+  FileRevisionStamp stamp;
+  FileRevisionSummary summary;
+};
+
+// Revision summaries are cached so that refreshing the general information
+// doesn't need to hash the masterlist and prelude and parse their metadata
+// every time. Summaries may be got and written from different threads.
+static std::mutex fileRevisionSummariesMutex;
+static std::map<std::filesystem::path, CachedFileRevisionSummary>
+    fileRevisionSummaries;
+
 std::filesystem::path getFileMetadataPath(std::filesystem::path filePath) {
   filePath += METADATA_PATH_SUFFIX;
   return filePath;
 }
 
-void writeFileRevision(const std::filesystem::path& filePath,
-                       const std::string& id,
-                       const std::string& date) {
+int64_t getFileWriteTime(const std::filesystem::path& filePath) {
+  return static_cast<int64_t>(
+      std::filesystem::last_write_time(filePath).time_since_epoch().count());
+}
+
+std::optional<FileRevisionStamp> getFileRevisionStamp(
+    const std::filesystem::path& filePath) {
+  const auto metadataPath = getFileMetadataPath(filePath);
+
+  FileRevisionStamp stamp;
+  std::error_code errorCode;
+
+  stamp.fileSize = std::filesystem::file_size(filePath, errorCode);
+  if (errorCode) {
+    return std::nullopt;
+  }
+
+  const auto fileWriteTime =
+      std::filesystem::last_write_time(filePath, errorCode);
+  if (errorCode) {
+    return std::nullopt;
+  }
+
+  stamp.metadataSize = std::filesystem::file_size(metadataPath, errorCode);
+  if (errorCode) {
+    return std::nullopt;
+  }
+
+  const auto metadataWriteTime =
+      std::filesystem::last_write_time(metadataPath, errorCode);
+  if (errorCode) {
+    return std::nullopt;
+  }
+
+  stamp.fileWriteTime =
+      static_cast<int64_t>(fileWriteTime.time_since_epoch().count());
+  stamp.metadataWriteTime =
+      static_cast<int64_t>(metadataWriteTime.time_since_epoch().count());
+
+  return stamp;
+}
+
+std::optional<FileRevisionSummary> findCachedFileRevisionSummary(
+    const std::filesystem::path& filePath,
+    const FileRevisionStamp& stamp) {
+  std::lock_guard<std::mutex> guard(fileRevisionSummariesMutex);
+
+  const auto it = fileRevisionSummaries.find(filePath);
+  if (it == fileRevisionSummaries.end() || !(it->second.stamp == stamp)) {
+    return std::nullopt;
+  }
+
+  return it->second.summary;
+}
+
+void cacheFileRevisionSummary(const std::filesystem::path& filePath,
+                              const FileRevisionStamp& stamp,
+                              const FileRevisionSummary& summary) {
+  std::lock_guard<std::mutex> guard(fileRevisionSummariesMutex);
+
+  fileRevisionSummaries.insert_or_assign(
+      filePath, CachedFileRevisionSummary{stamp, summary});
+}
+
+void forgetFileRevisionSummary(const std::filesystem::path& filePath) {
+  std::lock_guard<std::mutex> guard(fileRevisionSummariesMutex);
+
+  fileRevisionSummaries.erase(filePath);
+}
+
+void writeFileRevision(
+    const std::filesystem::path& filePath,
+    const std::string& id,
+    const std::string& date,
+    const HttpCacheValidators& validators = {},
+    const std::optional<std::filesystem::path>& sourcePath = std::nullopt) {
   auto metadataPath = getFileMetadataPath(filePath);
 
   auto logger = getLogger();
@@ -72,8 +191,38 @@ void writeFileRevision(const std::filesystem::path& filePath,
                  date);
   }
 
-  const auto table =
-      toml::table{{METADATA_ID_KEY, id}, {METADATA_DATE_KEY, date}};
+  auto table = toml::table{{METADATA_ID_KEY, id}, {METADATA_DATE_KEY, date}};
+
+  if (!validators.etag.empty()) {
+    table.insert(METADATA_ETAG_KEY, validators.etag);
+  }
+
+  if (!validators.lastModified.empty()) {
+    table.insert(METADATA_LAST_MODIFIED_KEY, validators.lastModified);
+  }
+
+  // The ID is the hash of the file as it is now, so record the file's size
+  // and write time so that the file doesn't need to be hashed again until it
+  // changes.
+  std::error_code errorCode;
+  const auto fileSize = std::filesystem::file_size(filePath, errorCode);
+  if (!errorCode) {
+    table.insert(METADATA_FILE_SIZE_KEY, static_cast<int64_t>(fileSize));
+    table.insert(METADATA_FILE_WRITE_TIME_KEY, getFileWriteTime(filePath));
+  }
+
+  // If the file was copied from a local source, record the source's size and
+  // write time so that it doesn't need to be hashed again until it changes.
+  if (sourcePath.has_value()) {
+    const auto sourceSize =
+        std::filesystem::file_size(sourcePath.value(), errorCode);
+    if (!errorCode) {
+      table.insert(METADATA_SOURCE_PATH_KEY, sourcePath.value().u8string());
+      table.insert(METADATA_SOURCE_SIZE_KEY, static_cast<int64_t>(sourceSize));
+      table.insert(METADATA_SOURCE_WRITE_TIME_KEY,
+                   getFileWriteTime(sourcePath.value()));
+    }
+  }
 
   std::ofstream out(metadataPath);
   if (!out.is_open()) {
@@ -82,6 +231,11 @@ void writeFileRevision(const std::filesystem::path& filePath,
   }
 
   out << table;
+  out.close();
+
+  // The metadata file's write time may not have changed if its resolution is
+  // coarse, so don't rely on the stamp to invalidate the cached summary.
+  forgetFileRevisionSummary(filePath);
 }
 
 FileRevisionSummary::FileRevisionSummary(const FileRevision& fileRevision) :
@@ -129,6 +283,54 @@ std::string calculateGitBlobHash(const QByteArray& data) {
   return QString(hasher.result().toHex()).toStdString();
 }
 
+// Read the file in chunks, replacing CRLF line endings with LF, and pass each
+// chunk of normalised content to the given callback.
+void readNormalisedChunks(QFile& file,
+                          const std::function<void(QByteArrayView)>& onChunk) {
+  static constexpr qint64 CHUNK_SIZE = 64 * 1024;
+
+  std::vector<char> buffer(CHUNK_SIZE);
+  std::vector<char> normalised;
+  normalised.reserve(CHUNK_SIZE);
+
+  // A CR at the end of a chunk may be followed by an LF in the next chunk.
+  bool hasPendingCR = false;
+
+  while (true) {
+    const auto bytesRead = file.read(buffer.data(), CHUNK_SIZE);
+    if (bytesRead < 0) {
+      throw FileAccessError(file.fileName().toStdString() +
+                            " could not be read");
+    }
+    if (bytesRead == 0) {
+      break;
+    }
+
+    normalised.clear();
+    for (qint64 i = 0; i < bytesRead; i += 1) {
+      const auto character = buffer[i];
+      if (hasPendingCR) {
+        hasPendingCR = false;
+        if (character != '\n') {
+          normalised.push_back('\r');
+        }
+      }
+
+      if (character == '\r') {
+        hasPendingCR = true;
+      } else {
+        normalised.push_back(character);
+      }
+    }
+
+    onChunk(QByteArrayView(normalised.data(), normalised.size()));
+  }
+
+  if (hasPendingCR) {
+    onChunk(QByteArrayView("\r", 1));
+  }
+}
+
 std::string calculateGitBlobHash(const std::filesystem::path& filePath) {
   QFile file(QString::fromStdString(filePath.u8string()));
 
@@ -137,23 +339,38 @@ std::string calculateGitBlobHash(const std::filesystem::path& filePath) {
     throw FileAccessError(filePath.u8string() + " is not a regular file");
   }
 
-  QByteArray fileContent = file.readAll();
-
   // Files in LOOT's repositories are committed with LF line endings, but if the
   // file being read is from the working directory of a local Git repository
   // that has autocrlf enabled, it will have CRLF line endings, so the
   // hash won't match the value calculated by Git unless the line endings
   // are replaced.
-  fileContent.replace(QByteArray("\r\n"), QByteArray("\n"));
+  //
+  // The blob header includes the size of the normalised content, so read the
+  // file twice in chunks instead of holding all of it in memory: first to get
+  // the size and then to hash the content.
+  qint64 normalisedSize = 0;
+  readNormalisedChunks(
+      file, [&](QByteArrayView chunk) { normalisedSize += chunk.size(); });
+
+  if (!file.seek(0)) {
+    throw FileAccessError(filePath.u8string() + " could not be read");
+  }
 
-  return calculateGitBlobHash(fileContent);
-}
+  const auto sizeString = std::to_string(normalisedSize);
+  auto hasher = QCryptographicHash(QCryptographicHash::Sha1);
 
-FileRevision getFileRevision(const std::filesystem::path& filePath) {
-  FileRevision revision;
+  static constexpr QByteArrayView HEADER_PREFIX = QByteArrayView("blob ");
 
-  revision.id = calculateGitBlobHash(filePath);
+  hasher.addData(HEADER_PREFIX);
+  hasher.addData(QByteArrayView(sizeString.c_str(), sizeString.size() + 1));
+
+  readNormalisedChunks(file,
+                       [&](QByteArrayView chunk) { hasher.addData(chunk); });
 
+  return QString(hasher.result().toHex()).toStdString();
+}
+
+toml::table readFileMetadata(const std::filesystem::path& filePath) {
   auto metadataPath = getFileMetadataPath(filePath);
 
   if (!std::filesystem::is_regular_file(filePath)) {
@@ -168,7 +385,105 @@ FileRevision getFileRevision(const std::filesystem::path& filePath) {
                              " could not be opened for parsing");
   }
 
-  const auto metadata = toml::parse(in, metadataPath.u8string());
+  return toml::parse(in, metadataPath.u8string());
+}
+
+// Get the hash recorded in the file's metadata if the file's size and write
+// time haven't changed since it was recorded.
+std::optional<std::string> getRecordedGitBlobHash(
+    const std::filesystem::path& filePath) {
+  try {
+    const auto metadata = readFileMetadata(filePath);
+
+    const auto hash = metadata[METADATA_ID_KEY].value<std::string>();
+    const auto fileSize = metadata[METADATA_FILE_SIZE_KEY].value<int64_t>();
+    const auto writeTime =
+        metadata[METADATA_FILE_WRITE_TIME_KEY].value<int64_t>();
+
+    if (!hash.has_value() || !fileSize.has_value() || !writeTime.has_value()) {
+      return std::nullopt;
+    }
+
+    if (fileSize.value() !=
+            static_cast<int64_t>(std::filesystem::file_size(filePath)) ||
+        writeTime.value() != getFileWriteTime(filePath)) {
+      return std::nullopt;
+    }
+
+    return hash;
+  } catch (const std::exception&) {
+    return std::nullopt;
+  }
+}
+
+// Get the recorded hash of a file that was copied from the given source if
+// neither the file nor the source have changed since it was recorded.
+std::optional<std::string> getRecordedGitBlobHash(
+    const std::filesystem::path& filePath,
+    const std::filesystem::path& sourcePath) {
+  try {
+    const auto metadata = readFileMetadata(filePath);
+
+    const auto recordedSourcePath =
+        metadata[METADATA_SOURCE_PATH_KEY].value<std::string>();
+    const auto sourceSize = metadata[METADATA_SOURCE_SIZE_KEY].value<int64_t>();
+    const auto sourceWriteTime =
+        metadata[METADATA_SOURCE_WRITE_TIME_KEY].value<int64_t>();
+
+    if (!recordedSourcePath.has_value() || !sourceSize.has_value() ||
+        !sourceWriteTime.has_value()) {
+      return std::nullopt;
+    }
+
+    if (recordedSourcePath.value() != sourcePath.u8string() ||
+        sourceSize.value() !=
+            static_cast<int64_t>(std::filesystem::file_size(sourcePath)) ||
+        sourceWriteTime.value() != getFileWriteTime(sourcePath)) {
+      return std::nullopt;
+    }
+
+    return getRecordedGitBlobHash(filePath);
+  } catch (const std::exception&) {
+    return std::nullopt;
+  }
+}
+
+std::string getGitBlobHash(const std::filesystem::path& filePath) {
+  const auto recordedHash = getRecordedGitBlobHash(filePath);
+  if (recordedHash.has_value()) {
+    return recordedHash.value();
+  }
+
+  return calculateGitBlobHash(filePath);
+}
+
+std::optional<std::string> calculateExistingGitBlobHash(
+    const std::filesystem::path& filePath) {
+  if (!std::filesystem::exists(filePath)) {
+    return std::nullopt;
+  }
+
+  try {
+    return getGitBlobHash(filePath);
+  } catch (const std::exception& e) {
+    auto logger = getLogger();
+    if (logger) {
+      logger->error("Failed to calculate blob hash for {}: {}",
+                    filePath.u8string(),
+                    e.what());
+    }
+
+    return std::nullopt;
+  }
+}
+
+FileRevision getFileRevision(const std::filesystem::path& filePath,
+                             const std::string& fileHash) {
+  FileRevision revision;
+
+  revision.id = fileHash;
+
+  const auto metadata = readFileMetadata(filePath);
 
   auto hash = metadata[METADATA_ID_KEY].value<std::string>();
   auto timestamp = metadata[METADATA_DATE_KEY].value<std::string>();
@@ -187,15 +502,35 @@ FileRevision getFileRevision(const std::filesystem::path& filePath) {
   return revision;
 }
 
+FileRevision getFileRevision(const std::filesystem::path& filePath) {
+  return getFileRevision(filePath, getGitBlobHash(filePath));
+}
+
 FileRevisionSummary getFileRevisionSummary(
     const std::filesystem::path& filePath,
     FileType fileType) {
   using boost::locale::translate;
 
+  // Errors aren't cached, as getting them doesn't involve hashing the file.
+  const auto stamp = getFileRevisionStamp(filePath);
+  if (stamp.has_value()) {
+    const auto cachedSummary =
+        findCachedFileRevisionSummary(filePath, stamp.value());
+    if (cachedSummary.has_value()) {
+      return cachedSummary.value();
+    }
+  }
+
   auto logger = getLogger();
 
   try {
-    return FileRevisionSummary(getFileRevision(filePath));
+    const auto summary = FileRevisionSummary(getFileRevision(filePath));
+
+    if (stamp.has_value()) {
+      cacheFileRevisionSummary(filePath, stamp.value(), summary);
+    }
+
+    return summary;
   } catch (FileAccessError&) {
     if (logger) {
       if (fileType == FileType::Masterlist) {
@@ -225,15 +560,20 @@ FileRevisionSummary getFileRevisionSummary(
 }
 
 bool isFileUpToDate(const std::filesystem::path& filePath,
-                    const std::string& expectedHash) {
+                    const std::string& expectedHash,
+                    const std::optional<std::string>& existingFileHash) {
   if (!std::filesystem::exists(filePath)) {
     return false;
   }
 
+  if (existingFileHash.has_value()) {
+    return expectedHash == existingFileHash.value();
+  }
+
   auto logger = getLogger();
 
   try {
-    auto existingFileHash = calculateGitBlobHash(filePath);
+    auto existingFileHash = getGitBlobHash(filePath);
 
     if (logger) {
       logger->debug("Calculated blob hash for file at {}: {}",
@@ -255,17 +595,25 @@ bool isFileUpToDate(const std::filesystem::path& filePath,
 }
 
 bool updateFileWithData(const std::filesystem::path& filePath,
-                        const QByteArray& data) {
+                        const QByteArray& data,
+                        const HttpCacheValidators& validators,
+                        const std::optional<std::string>& existingFileHash) {
   auto logger = getLogger();
 
   auto newHash = calculateGitBlobHash(data);
-  auto hasChanged = !isFileUpToDate(filePath, newHash);
+  auto hasChanged = !isFileUpToDate(filePath, newHash, existingFileHash);
 
   if (hasChanged) {
-    QFile masterlist(QString::fromStdString(filePath.u8string()));
-    masterlist.open(QIODevice::WriteOnly);
-    masterlist.write(data);
-    masterlist.close();
+    // Write to a temporary file that replaces the existing file once it's
+    // complete, so that a failed write doesn't leave a truncated file.
+    QSaveFile file(QString::fromStdString(filePath.u8string()));
+    const auto isWritten = file.open(QIODevice::WriteOnly) &&
+                           file.write(data) == data.size() && file.commit();
+    if (!isWritten) {
+      throw std::runtime_error(filePath.u8string() +
+                               " could not be written to: " +
+                               file.errorString().toStdString());
+    }
   }
 
   if (logger) {
@@ -278,13 +626,104 @@ bool updateFileWithData(const std::filesystem::path& filePath,
   // update timestamp may have changed.
   auto updateTimestamp =
       QDate::currentDate().toString(Qt::ISODate).toStdString();
-  writeFileRevision(filePath, newHash, updateTimestamp);
+  writeFileRevision(filePath, newHash, updateTimestamp, validators);
 
   return hasChanged;
 }
 
+void updateFileRevisionDate(
+    const std::filesystem::path& filePath,
+    const HttpCacheValidators& validators,
+    const std::optional<std::string>& existingFileHash) {
+  const auto hash = existingFileHash.has_value()
+                        ? existingFileHash.value()
+                        : getGitBlobHash(filePath);
+
+  // Servers don't have to repeat validators that haven't changed, so keep the
+  // stored values for any that weren't given.
+  auto newValidators = getHttpCacheValidators(filePath, hash);
+  if (!validators.etag.empty()) {
+    newValidators.etag = validators.etag;
+  }
+  if (!validators.lastModified.empty()) {
+    newValidators.lastModified = validators.lastModified;
+  }
+
+  auto logger = getLogger();
+  if (logger) {
+    logger->debug("{} is already up to date with blob hash {}",
+                  filePath.u8string(),
+                  hash);
+  }
+
+  const auto updateTimestamp =
+      QDate::currentDate().toString(Qt::ISODate).toStdString();
+  writeFileRevision(filePath, hash, updateTimestamp, newValidators);
+}
+
+HttpCacheValidators getHttpCacheValidators(
+    const std::filesystem::path& filePath,
+    const std::optional<std::string>& existingFileHash) {
+  try {
+    const auto revision =
+        existingFileHash.has_value()
+            ? getFileRevision(filePath, existingFileHash.value())
+            : getFileRevision(filePath);
+    if (revision.is_modified) {
+      return {};
+    }
+
+    const auto metadata = readFileMetadata(filePath);
+
+    HttpCacheValidators validators;
+    validators.etag = metadata[METADATA_ETAG_KEY].value_or(std::string());
+    validators.lastModified =
+        metadata[METADATA_LAST_MODIFIED_KEY].value_or(std::string());
+
+    return validators;
+  } catch (const std::exception& e) {
+    auto logger = getLogger();
+    if (logger) {
+      logger->debug("Couldn't read HTTP cache validators for {}: {}",
+                    filePath.u8string(),
+                    e.what());
+    }
+
+    return {};
+  }
+}
+
+HttpCacheValidators getHttpCacheValidators(const QNetworkReply& reply) {
+  HttpCacheValidators validators;
+  validators.etag = reply.rawHeader("ETag").toStdString();
+  validators.lastModified = reply.rawHeader("Last-Modified").toStdString();
+
+  return validators;
+}
+
+void setHttpCacheValidators(QNetworkRequest& request,
+                            const HttpCacheValidators& validators) {
+  if (!validators.etag.empty()) {
+    request.setRawHeader("If-None-Match",
+                         QByteArray::fromStdString(validators.etag));
+  }
+
+  if (!validators.lastModified.empty()) {
+    request.setRawHeader("If-Modified-Since",
+                         QByteArray::fromStdString(validators.lastModified));
+  }
+}
+
+bool isHttpNotModifiedResponse(const QNetworkReply& reply) {
+  static constexpr int HTTP_STATUS_NOT_MODIFIED = 304;
+
+  return reply.attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() ==
+         HTTP_STATUS_NOT_MODIFIED;
+}
+
 bool updateFile(const std::filesystem::path& source,
-                const std::filesystem::path& destination) {
+                const std::filesystem::path& destination,
+                const HttpCacheValidators& validators) {
   const auto logger = getLogger();
   if (logger) {
     logger->info("Updating file at \"{}\" using file at \"{}\"",
@@ -296,10 +735,36 @@ bool updateFile(const std::filesystem::path& source,
     throw std::invalid_argument("source path is empty");
   }
 
-  const auto newHash = calculateGitBlobHash(source);
-  const auto hasChanged = !isFileUpToDate(destination, newHash);
+  const auto updateTimestamp =
+      QDate::currentDate().toString(Qt::ISODate).toStdString();
+
+  // If neither file has changed since the last update, there's no need to
+  // read either of them.
+  const auto recordedHash = getRecordedGitBlobHash(destination, source);
+  if (recordedHash.has_value()) {
+    if (logger) {
+      logger->debug("{} is already up to date with blob hash {}",
+                    destination.u8string(),
+                    recordedHash.value());
+    }
+
+    writeFileRevision(destination,
+                      recordedHash.value(),
+                      updateTimestamp,
+                      validators,
+                      source);
+
+    return false;
+  }
+
+  // The source may be another file that LOOT manages, so use its recorded
+  // hash if it's still valid.
+  const auto newHash = getGitBlobHash(source);
+  const auto hasChanged = !isFileUpToDate(destination, newHash, std::nullopt);
 
   if (hasChanged) {
+    // copy_file() lets the OS do the copy, which can share storage between
+    // the files on filesystems that support it instead of copying the data.
     std::filesystem::copy_file(
         source, destination, std::filesystem::copy_options::overwrite_existing);
   }
@@ -313,13 +778,95 @@ bool updateFile(const std::filesystem::path& source,
 
   // Update the metadata file even if the file is up to date, as the
   // update timestamp may have changed.
-  const auto updateTimestamp =
-      QDate::currentDate().toString(Qt::ISODate).toStdString();
-  writeFileRevision(destination, newHash, updateTimestamp);
+  writeFileRevision(destination, newHash, updateTimestamp, validators, source);
 
   return hasChanged;
 }
 
+std::filesystem::path getSharedCacheEntryPath(
+    const std::filesystem::path& cachePath,
+    const std::string& url) {
+  // Entries are named after a hash of their URL so that different sources
+  // never share an entry and the name is always a valid filename. The URL's
+  // file extension is kept to make the entries easier to identify.
+  const auto qUrl = QUrl(QString::fromStdString(url));
+  const auto urlHash =
+      QCryptographicHash::hash(qUrl.toEncoded(), QCryptographicHash::Sha1)
+          .toHex()
+          .toStdString();
+  const auto extension =
+      std::filesystem::u8path(qUrl.fileName().toStdString()).extension();
+
+  return cachePath / std::filesystem::u8path(urlHash + extension.u8string());
+}
+
+std::optional<bool> updateFileFromSharedCache(
+    const std::filesystem::path& entryPath,
+    const std::filesystem::path& filePath) {
+  auto logger = getLogger();
+
+  try {
+    if (!std::filesystem::exists(entryPath)) {
+      return std::nullopt;
+    }
+
+    // The entry's metadata is rewritten whenever the entry is checked against
+    // its source, so its write time is when the entry was last known to be
+    // current.
+    const auto checkedTime =
+        std::filesystem::last_write_time(getFileMetadataPath(entryPath));
+    const auto age =
+        std::filesystem::file_time_type::clock::now() - checkedTime;
+    if (age > SHARED_CACHE_ENTRY_MAX_AGE) {
+      if (logger) {
+        logger->debug("The shared download cache entry at {} is too old to use",
+                      entryPath.u8string());
+      }
+      return std::nullopt;
+    }
+
+    // The entry may have been partially written or edited by something other
+    // than LOOT, so check it against its recorded hash.
+    const auto revision = getFileRevision(entryPath);
+    if (revision.is_modified) {
+      if (logger) {
+        logger->warn(
+            "The shared download cache entry at {} doesn't match its recorded "
+            "hash",
+            entryPath.u8string());
+      }
+      return std::nullopt;
+    }
+
+    const auto validators = getHttpCacheValidators(entryPath, revision.id);
+
+    return updateFile(entryPath, filePath, validators);
+  } catch (const std::exception& e) {
+    if (logger) {
+      logger->warn("Failed to update {} from the shared download cache: {}",
+                   filePath.u8string(),
+                   e.what());
+    }
+    return std::nullopt;
+  }
+}
+
+void addFileToSharedCache(const std::filesystem::path& filePath,
+                          const std::filesystem::path& entryPath) {
+  try {
+    std::filesystem::create_directories(entryPath.parent_path());
+
+    updateFile(filePath, entryPath, getHttpCacheValidators(filePath));
+  } catch (const std::exception& e) {
+    auto logger = getLogger();
+    if (logger) {
+      logger->warn("Failed to add {} to the shared download cache: {}",
+                   filePath.u8string(),
+                   e.what());
+    }
+  }
+}
+
 bool isValidUrl(const std::string& location) {
   auto url = QUrl(QString::fromStdString(location), QUrl::StrictMode);
   auto scheme = url.scheme().toStdString();
@@ -350,6 +897,14 @@ std::optional<QByteArray> readHttpResponse(QNetworkReply* reply) {
     return std::nullopt;
   }
 
+  auto logger = getLogger();
+  if (logger) {
+    const auto encoding = reply->rawHeader("Content-Encoding");
+    logger->debug("Received {} bytes of response data, content encoding: {}",
+                  data.size(),
+                  encoding.isEmpty() ? "none" : encoding.toStdString());
+  }
+
   return data;
 }
 
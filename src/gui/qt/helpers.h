@@ -34,6 +34,8 @@
 #include <QtNetwork/QNetworkReply>
 #include <QtWidgets/QLabel>
 #include <filesystem>
+#include <optional>
+#include <string>
 #include <vector>
 
 #include "gui/state/game/helpers.h"
@@ -47,6 +49,14 @@ struct FileRevision {
   bool is_modified{false};
 };
 
+// The values that an HTTP server gave to identify the version of a file that
+// it sent, which can be used to ask the server to only send the file if it has
+// changed.
+struct HttpCacheValidators {
+  std::string etag;
+  std::string lastModified;
+};
+
 struct FileRevisionSummary {
   FileRevisionSummary() = default;
   explicit FileRevisionSummary(const FileRevision& fileRevision);
@@ -64,17 +74,76 @@ std::string calculateGitBlobHash(const QByteArray& data);
 
 std::string calculateGitBlobHash(const std::filesystem::path& filePath);
 
+// Uses the hash recorded in the file's metadata if the file's size and write
+// time are unchanged since the hash was recorded. Returns nothing if the file
+// doesn't exist or can't be read.
+std::optional<std::string> calculateExistingGitBlobHash(
+    const std::filesystem::path& filePath);
+
 FileRevision getFileRevision(const std::filesystem::path& filePath);
 
 FileRevisionSummary getFileRevisionSummary(
     const std::filesystem::path& filePath,
     FileType fileType);
 
-bool updateFileWithData(const std::filesystem::path& filePath,
-                        const QByteArray& data);
+// The functions below that take an existing file hash use it instead of
+// hashing the file at the given path, to avoid reading the file again if its
+// hash is already known.
+
+bool updateFileWithData(
+    const std::filesystem::path& filePath,
+    const QByteArray& data,
+    const HttpCacheValidators& validators = {},
+    const std::optional<std::string>& existingFileHash = std::nullopt);
+
+// Record that the file at the given path is up to date without changing it,
+// e.g. because a server reported that it hasn't changed. Empty validators
+// don't replace stored values.
+void updateFileRevisionDate(
+    const std::filesystem::path& filePath,
+    const HttpCacheValidators& validators,
+    const std::optional<std::string>& existingFileHash = std::nullopt);
+
+// Get the validators stored for the file at the given path. No validators are
+// returned if the file is missing or has been edited since it was written, as
+// it then needs to be downloaded again whether or not the server's copy has
+// changed.
+HttpCacheValidators getHttpCacheValidators(
+    const std::filesystem::path& filePath,
+    const std::optional<std::string>& existingFileHash = std::nullopt);
+
+HttpCacheValidators getHttpCacheValidators(const QNetworkReply& reply);
+
+void setHttpCacheValidators(QNetworkRequest& request,
+                            const HttpCacheValidators& validators);
+
+bool isHttpNotModifiedResponse(const QNetworkReply& reply);
 
+// Copy the source file to the destination if they differ. Any given validators
+// are recorded for the destination as if it had been downloaded with them.
 bool updateFile(const std::filesystem::path& source,
-                const std::filesystem::path& destination);
+                const std::filesystem::path& destination,
+                const HttpCacheValidators& validators = {});
+
+// Get the path of the entry for the given URL in a shared download cache, e.g.
+// a folder on a network share that several LOOT installs use.
+std::filesystem::path getSharedCacheEntryPath(
+    const std::filesystem::path& cachePath,
+    const std::string& url);
+
+// Update the file at the given path from a shared download cache entry if the
+// entry is intact and was checked against its source recently, so that the
+// source doesn't need to be contacted. Returns nothing if the entry can't be
+// used, and otherwise whether the file changed.
+std::optional<bool> updateFileFromSharedCache(
+    const std::filesystem::path& entryPath,
+    const std::filesystem::path& filePath);
+
+// Store a file that has just been checked against its source in a shared
+// download cache entry, along with the file's validators. Failures are logged
+// and otherwise ignored, as the cache is only an optimisation.
+void addFileToSharedCache(const std::filesystem::path& filePath,
+                          const std::filesystem::path& entryPath);
 
 bool isValidUrl(const std::string& location);
 
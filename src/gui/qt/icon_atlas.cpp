@@ -0,0 +1,176 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/qt/icon_atlas.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtGui/QImageReader>
+#include <QtGui/QPainter>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Keep the atlas reasonably square so that it doesn't hit image size limits.
+constexpr int ATLAS_WIDTH = 1024;
+
+int toPercentage(qreal pixelRatio) {
+  return static_cast<int>(std::lround(pixelRatio * 100));
+}
+}
+
+namespace loot {
+QImage rasteriseIcon(const QString& path, int extent, qreal pixelRatio) {
+  // Rasterise the SVG at the size it will be displayed at instead of scaling
+  // a pixmap.
+  QImageReader reader(path);
+  auto size = reader.size();
+  if (size.isValid()) {
+    const auto scaledExtent = static_cast<int>(std::ceil(extent * pixelRatio));
+    size.scale(scaledExtent, scaledExtent, Qt::KeepAspectRatio);
+    reader.setScaledSize(size);
+  }
+
+  return reader.read();
+}
+
+bool writeIconAtlas(const std::vector<IconAtlasEntry>& entries,
+                    const QString& imagePath,
+                    const QString& indexPath) {
+  // Pack the images into rows, starting a new row when the current one is
+  // full.
+  std::vector<QRect> rects;
+  int x = 0;
+  int y = 0;
+  int rowHeight = 0;
+  for (const auto& entry : entries) {
+    const auto size = entry.image.size();
+    if (x + size.width() > ATLAS_WIDTH && x > 0) {
+      x = 0;
+      y += rowHeight;
+      rowHeight = 0;
+    }
+
+    rects.emplace_back(QPoint(x, y), size);
+    x += size.width();
+    rowHeight = std::max(rowHeight, size.height());
+  }
+
+  QImage atlasImage(
+      ATLAS_WIDTH, y + rowHeight, QImage::Format_ARGB32_Premultiplied);
+  atlasImage.fill(Qt::transparent);
+
+  QPainter painter(&atlasImage);
+  QJsonArray index;
+  for (size_t i = 0; i < entries.size(); i += 1) {
+    const auto& entry = entries.at(i);
+    const auto& rect = rects.at(i);
+
+    painter.drawImage(rect.topLeft(), entry.image);
+
+    QJsonObject object;
+    object["icon"] = entry.iconPath;
+    object["extent"] = entry.extent;
+    object["pixelRatio"] = toPercentage(entry.pixelRatio);
+    object["x"] = rect.x();
+    object["y"] = rect.y();
+    object["width"] = rect.width();
+    object["height"] = rect.height();
+    index.append(object);
+  }
+  painter.end();
+
+  if (!atlasImage.save(imagePath, "PNG")) {
+    return false;
+  }
+
+  QFile indexFile(indexPath);
+  if (!indexFile.open(QIODevice::WriteOnly)) {
+    return false;
+  }
+
+  return indexFile.write(QJsonDocument(index).toJson(QJsonDocument::Compact)) >=
+         0;
+}
+
+IconAtlas IconAtlas::load(const QString& imagePath, const QString& indexPath) {
+  QFile indexFile(indexPath);
+  if (!indexFile.open(QIODevice::ReadOnly)) {
+    return IconAtlas();
+  }
+
+  const auto document = QJsonDocument::fromJson(indexFile.readAll());
+  if (!document.isArray()) {
+    return IconAtlas();
+  }
+
+  IconAtlas atlas;
+  atlas.atlasImage = QImage(imagePath);
+  if (atlas.atlasImage.isNull()) {
+    return IconAtlas();
+  }
+
+  const auto atlasRect = atlas.atlasImage.rect();
+  for (const auto& value : document.array()) {
+    const auto object = value.toObject();
+    const QRect rect(object.value("x").toInt(),
+                     object.value("y").toInt(),
+                     object.value("width").toInt(),
+                     object.value("height").toInt());
+    if (rect.isEmpty() || !atlasRect.contains(rect)) {
+      continue;
+    }
+
+    atlas.rects.emplace(std::make_tuple(object.value("icon").toString(),
+                                        object.value("extent").toInt(),
+                                        object.value("pixelRatio").toInt()),
+                        rect);
+  }
+
+  return atlas;
+}
+
+bool IconAtlas::isEmpty() const { return rects.empty(); }
+
+std::optional<QImage> IconAtlas::getImage(const QString& iconPath,
+                                          int extent,
+                                          qreal pixelRatio) const {
+  // Only use images that were rendered for exactly the given pixel ratio,
+  // as otherwise they would need to be scaled.
+  const auto percentage = toPercentage(pixelRatio);
+  if (std::abs(pixelRatio * 100 - percentage) > 1e-6) {
+    return std::nullopt;
+  }
+
+  const auto it = rects.find(std::make_tuple(iconPath, extent, percentage));
+  if (it == rects.end()) {
+    return std::nullopt;
+  }
+
+  return atlasImage.copy(it->second);
+}
+}
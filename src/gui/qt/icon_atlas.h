@@ -0,0 +1,87 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_QT_ICON_ATLAS
+#define LOOT_GUI_QT_ICON_ATLAS
+
+#include <QtCore/QRect>
+#include <QtCore/QString>
+#include <QtGui/QImage>
+#include <map>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+namespace loot {
+// The resource paths of the atlas of icons that's generated at build time.
+static constexpr const char* ICON_ATLAS_IMAGE_PATH = ":/icon-atlas/atlas.png";
+static constexpr const char* ICON_ATLAS_INDEX_PATH = ":/icon-atlas/atlas.json";
+
+// Rasterises the image at the given path so that its larger dimension is
+// extent * pixelRatio pixels, rounded up.
+QImage rasteriseIcon(const QString& path, int extent, qreal pixelRatio);
+
+struct IconAtlasEntry {
+  // The resource path of the SVG that the image was rasterised from.
+  QString iconPath;
+  int extent{0};
+  qreal pixelRatio{1.0};
+  QImage image;
+};
+
+// Packs the given images into a single PNG image, and writes an index of
+// where each image is to a JSON file. Returns false if either file could not
+// be written.
+bool writeIconAtlas(const std::vector<IconAtlasEntry>& entries,
+                    const QString& imagePath,
+                    const QString& indexPath);
+
+// Icons rasterised ahead of time, so that they don't need to be rendered
+// from their SVGs at runtime. The images are only used for their alpha
+// channel.
+class IconAtlas {
+public:
+  IconAtlas() = default;
+
+  // Returns an empty atlas if the files can't be read.
+  static IconAtlas load(const QString& imagePath, const QString& indexPath);
+
+  bool isEmpty() const;
+
+  // Returns std::nullopt if the atlas doesn't have an image for the given
+  // icon, extent and device pixel ratio.
+  std::optional<QImage> getImage(const QString& iconPath,
+                                 int extent,
+                                 qreal pixelRatio) const;
+
+private:
+  QImage atlasImage;
+  // Pixel ratios are stored as integer percentages so that they can be
+  // compared exactly.
+  std::map<std::tuple<QString, int, int>, QRect> rects;
+};
+}
+
+#endif
@@ -26,22 +26,34 @@
 #include "gui/qt/icon_factory.h"
 
 #include <QtGui/QGuiApplication>
+#include <QtGui/QImageReader>
+#include <QtGui/QPainter>
 #include <QtGui/QPalette>
 #include <QtGui/QScreen>
+#include <QtWidgets/QApplication>
 #include <QtWidgets/QStyle>
+#include <cmath>
+
+#include "gui/qt/icon_atlas.h"
 
 namespace loot {
-QPixmap changeColor(QPixmap pixmap, QColor color) {
-  QImage image = pixmap.toImage();
-
-  for (int y = 0; y < image.height(); y++) {
-    for (int x = 0; x < image.width(); x++) {
-      color.setAlpha(image.pixelColor(x, y).alpha());
-      image.setPixelColor(x, y, color);
-    }
-  }
+qreal getDevicePixelRatio() {
+  return dynamic_cast<QGuiApplication*>(QCoreApplication::instance())
+      ->devicePixelRatio();
+}
+
+QImage changeColor(QImage image, QColor color) {
+  // Only the image's alpha channel is kept.
+  color.setAlpha(255);
+
+  image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+  QPainter painter(&image);
+  painter.setCompositionMode(QPainter::CompositionMode_SourceIn);
+  painter.fillRect(image.rect(), color);
+  painter.end();
 
-  return QPixmap::fromImage(image);
+  return image;
 }
 
 QIcon IconFactory::getIsActiveIcon() {
@@ -159,38 +171,37 @@ QPixmap IconFactory::getPixmap(const QIcon& icon,
                                int extent,
                                QIcon::Mode mode,
                                QIcon::State state) {
-  // Take the device pixel ratio into account when reading or writing the cache
-  // as it may change while the application is running.
-  const auto pixelRatio =
-      dynamic_cast<QGuiApplication*>(QCoreApplication::instance())
-          ->devicePixelRatio();
-  auto scaledSize = extent * pixelRatio;
-  auto key = std::make_tuple(icon.cacheKey(), scaledSize, mode, state);
-
-  const auto it = pixmaps.find(key);
-  if (it != pixmaps.end()) {
-    return it->second;
+  const auto it = iconPaths.find(icon.cacheKey());
+  if (it == iconPaths.end()) {
+    return icon.pixmap(extent, mode, state);
   }
 
-  auto pixmap = icon.pixmap(extent, mode, state);
-
-  pixmaps.emplace(key, pixmap);
-
-  return pixmap;
+  // Take the device pixel ratio into account when reading or writing the cache
+  // as it may change while the application is running.
+  return getColouredPixmap(it->second, extent, getDevicePixelRatio(), mode);
 }
 
 void IconFactory::setColours(QColor normal, QColor disabled, QColor selected) {
   icons.clear();
-  pixmaps.clear();
+  iconPaths.clear();
 
   normalColor = normal;
   disabledColor = disabled;
   selectedColor = selected;
+
+  // Rebuild the whole set of pixmaps now so that painting never needs to
+  // rasterise an SVG.
+  for (auto& [key, pixmap] : pixmaps) {
+    const auto& [resourcePath, extent, pixelRatio, mode] = key;
+    pixmap = renderPixmap(resourcePath, extent, pixelRatio, mode);
+  }
 }
 
 std::map<QString, QIcon> IconFactory::icons;
 
-std::map<std::tuple<qint64, double, QIcon::Mode, QIcon::State>, QPixmap>
+std::map<qint64, QString> IconFactory::iconPaths;
+
+std::map<std::tuple<QString, int, qreal, QIcon::Mode>, QPixmap>
     IconFactory::pixmaps;
 
 QColor IconFactory::normalColor;
@@ -205,33 +216,87 @@ QIcon IconFactory::getIcon(QString resourcePath) {
     return it->second;
   }
 
-  if (!normalColor.isValid()) {
-    normalColor = QGuiApplication::palette().color(QPalette::Disabled,
-                                                   QPalette::WindowText);
-  }
+  const auto naturalExtent = QImageReader(resourcePath).size().height();
+  const auto smallExtent =
+      QApplication::style()->pixelMetric(QStyle::PM_SmallIconSize);
+  const auto pixelRatio = getDevicePixelRatio();
 
-  if (!disabledColor.isValid()) {
-    disabledColor = QGuiApplication::palette().color(QPalette::Disabled,
-                                                     QPalette::WindowText);
+  QIcon icon;
+  for (const auto mode : {QIcon::Normal, QIcon::Disabled, QIcon::Selected}) {
+    icon.addPixmap(getColouredPixmap(resourcePath, naturalExtent, 1.0, mode),
+                   mode);
+    // Item views draw decorations at the small icon size, so provide a pixmap
+    // at that size to avoid scaling when painting.
+    icon.addPixmap(
+        getColouredPixmap(resourcePath, smallExtent, pixelRatio, mode), mode);
   }
 
-  if (!selectedColor.isValid()) {
-    selectedColor = QGuiApplication::palette().color(QPalette::Active,
-                                                     QPalette::HighlightedText);
+  icons.emplace(resourcePath, icon);
+  iconPaths.emplace(icon.cacheKey(), resourcePath);
+
+  return icon;
+}
+
+QPixmap IconFactory::getColouredPixmap(const QString& resourcePath,
+                                       int extent,
+                                       qreal pixelRatio,
+                                       QIcon::Mode mode) {
+  const auto key = std::make_tuple(resourcePath, extent, pixelRatio, mode);
+
+  const auto it = pixmaps.find(key);
+  if (it != pixmaps.end()) {
+    return it->second;
   }
 
-  auto rawPixmap = QPixmap(resourcePath);
-  auto normalPixmap = changeColor(rawPixmap, normalColor);
-  auto disabledPixmap = changeColor(rawPixmap, disabledColor);
-  auto selectedPixmap = changeColor(rawPixmap, selectedColor);
+  auto pixmap = renderPixmap(resourcePath, extent, pixelRatio, mode);
 
-  QIcon icon;
-  icon.addPixmap(normalPixmap, QIcon::Normal);
-  icon.addPixmap(disabledPixmap, QIcon::Disabled);
-  icon.addPixmap(selectedPixmap, QIcon::Selected);
+  pixmaps.emplace(key, pixmap);
 
-  icons.emplace(resourcePath, icon);
+  return pixmap;
+}
 
-  return icon;
+QPixmap IconFactory::renderPixmap(const QString& resourcePath,
+                                  int extent,
+                                  qreal pixelRatio,
+                                  QIcon::Mode mode) {
+  // Use the image pre-rendered at build time if there is one, and otherwise
+  // rasterise the SVG.
+  auto image = getAtlas().getImage(resourcePath, extent, pixelRatio);
+  if (!image.has_value()) {
+    image = rasteriseIcon(resourcePath, extent, pixelRatio);
+  }
+
+  auto pixmap = QPixmap::fromImage(
+      changeColor(std::move(image.value()), getColour(mode)));
+  pixmap.setDevicePixelRatio(pixelRatio);
+
+  return pixmap;
+}
+
+const IconAtlas& IconFactory::getAtlas() {
+  static const auto atlas =
+      IconAtlas::load(ICON_ATLAS_IMAGE_PATH, ICON_ATLAS_INDEX_PATH);
+
+  return atlas;
+}
+
+QColor IconFactory::getColour(QIcon::Mode mode) {
+  switch (mode) {
+    case QIcon::Disabled:
+      return disabledColor.isValid()
+                 ? disabledColor
+                 : QGuiApplication::palette().color(QPalette::Disabled,
+                                                    QPalette::WindowText);
+    case QIcon::Selected:
+      return selectedColor.isValid()
+                 ? selectedColor
+                 : QGuiApplication::palette().color(QPalette::Active,
+                                                    QPalette::HighlightedText);
+    default:
+      return normalColor.isValid()
+                 ? normalColor
+                 : QGuiApplication::palette().color(QPalette::Disabled,
+                                                    QPalette::WindowText);
+  }
 }
 }
@@ -31,6 +31,9 @@
 #include <QtGui/QIcon>
 #include <QtGui/QPixmap>
 #include <map>
+#include <tuple>
+
+#include "gui/qt/icon_atlas.h"
 
 namespace loot {
 class IconFactory {
@@ -68,25 +71,39 @@ public:
   static QIcon getJoinDiscordServerIcon();
   static QIcon getAboutIcon();
 
-  // Caches resized pixmaps so that the transformation only needs to be done
-  // once per (icon, extent, mode, state) tuple of argument values.
+  // Caches the rasterised and recoloured pixmaps of icons created by this
+  // class, so that their SVGs only need to be rendered once per (icon, extent,
+  // device pixel ratio, mode) tuple of values, or not at all if the icon atlas
+  // has an image for the extent and device pixel ratio. State is ignored for
+  // these icons, and other icons are not cached.
   static QPixmap getPixmap(const QIcon& icon,
                            int extent,
                            QIcon::Mode mode = QIcon::Normal,
                            QIcon::State state = QIcon::Off);
 
+  // Re-renders all cached pixmaps using the given colours.
   static void setColours(QColor normal, QColor disabled, QColor selected);
 
 private:
   static std::map<QString, QIcon> icons;
-  static std::map<std::tuple<qint64, double, QIcon::Mode, QIcon::State>,
-                  QPixmap>
+  static std::map<qint64, QString> iconPaths;
+  static std::map<std::tuple<QString, int, qreal, QIcon::Mode>, QPixmap>
       pixmaps;
   static QColor normalColor;
   static QColor disabledColor;
   static QColor selectedColor;
 
   static QIcon getIcon(QString resourcePath);
+  static QPixmap getColouredPixmap(const QString& resourcePath,
+                                   int extent,
+                                   qreal pixelRatio,
+                                   QIcon::Mode mode);
+  static QPixmap renderPixmap(const QString& resourcePath,
+                              int extent,
+                              qreal pixelRatio,
+                              QIcon::Mode mode);
+  static QColor getColour(QIcon::Mode mode);
+  static const IconAtlas& getAtlas();
 };
 }
 
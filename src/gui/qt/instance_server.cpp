@@ -0,0 +1,203 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/qt/instance_server.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtNetwork/QLocalSocket>
+#include <utility>
+
+#include "gui/state/logging.h"
+
+namespace {
+constexpr int CONNECT_TIMEOUT_MS = 500;
+constexpr int ACKNOWLEDGEMENT_TIMEOUT_MS = 2000;
+// Serialized requests are much smaller than this, so a connection that
+// sends more without ending its request isn't a LOOT instance.
+constexpr qint64 MAX_REQUEST_SIZE = 4096;
+constexpr char REQUEST_TERMINATOR = '\n';
+const QByteArray ACKNOWLEDGEMENT = "ok\n";
+const QByteArray REJECTION = "rejected\n";
+
+QString getServerName() {
+  // Local socket names are shared between users, so include something
+  // user-specific to avoid forwarding requests to another user's LOOT.
+  return QString("LOOT.Shell.Instance-%1")
+      .arg(qHash(QDir::homePath()), 0, 16);
+}
+}
+
+namespace loot {
+bool operator==(const InstanceRequest& lhs, const InstanceRequest& rhs) {
+  return lhs.gameFolderName == rhs.gameFolderName &&
+         lhs.autoSort == rhs.autoSort;
+}
+
+QByteArray serializeInstanceRequest(const InstanceRequest& request) {
+  QJsonObject object;
+  object["game"] = QString::fromStdString(request.gameFolderName);
+  object["autoSort"] = request.autoSort;
+
+  return QJsonDocument(object).toJson(QJsonDocument::Compact);
+}
+
+std::optional<InstanceRequest> parseInstanceRequest(const QByteArray& data) {
+  const auto document = QJsonDocument::fromJson(data);
+  if (!document.isObject()) {
+    return std::nullopt;
+  }
+
+  const auto object = document.object();
+  const auto game = object.value("game");
+  const auto autoSort = object.value("autoSort");
+  if (!game.isString() || !autoSort.isBool()) {
+    return std::nullopt;
+  }
+
+  InstanceRequest request;
+  request.gameFolderName = game.toString().toStdString();
+  request.autoSort = autoSort.toBool();
+
+  return request;
+}
+
+bool forwardToRunningInstance(const InstanceRequest& request) {
+  QLocalSocket socket;
+  socket.connectToServer(getServerName());
+  if (!socket.waitForConnected(CONNECT_TIMEOUT_MS)) {
+    return false;
+  }
+
+  socket.write(serializeInstanceRequest(request) + REQUEST_TERMINATOR);
+  if (!socket.waitForBytesWritten(CONNECT_TIMEOUT_MS)) {
+    return false;
+  }
+
+  // Wait for the running instance to acknowledge the request so that this
+  // instance doesn't exit without anything having handled it. If the request
+  // was rejected, the caller handles it instead.
+  QByteArray response;
+  while (!response.endsWith(REQUEST_TERMINATOR)) {
+    if (!socket.waitForReadyRead(ACKNOWLEDGEMENT_TIMEOUT_MS)) {
+      return false;
+    }
+    response += socket.readAll();
+  }
+
+  return response == ACKNOWLEDGEMENT;
+}
+
+InstanceServer::InstanceServer(RequestHandler handler, QObject* parent) :
+    QObject(parent), handler(std::move(handler)) {
+  server->setSocketOptions(QLocalServer::UserAccessOption);
+
+  connect(server,
+          &QLocalServer::newConnection,
+          this,
+          &InstanceServer::handleNewConnection);
+}
+
+bool InstanceServer::listen() {
+  const auto serverName = getServerName();
+  if (server->listen(serverName)) {
+    return true;
+  }
+
+  if (server->serverError() == QAbstractSocket::AddressInUseError) {
+    // On Linux the socket file is left behind if LOOT doesn't exit cleanly,
+    // but forwarding can also fail because a running instance declined the
+    // request, so only remove the socket if nothing is listening on it.
+    QLocalSocket socket;
+    socket.connectToServer(serverName);
+    if (socket.waitForConnected(CONNECT_TIMEOUT_MS)) {
+      socket.disconnectFromServer();
+    } else {
+      QLocalServer::removeServer(serverName);
+      if (server->listen(serverName)) {
+        return true;
+      }
+    }
+  }
+
+  const auto logger = getLogger();
+  if (logger) {
+    logger->warn(
+        "Could not listen for requests from other instances of LOOT: {}",
+        server->errorString().toStdString());
+  }
+
+  return false;
+}
+
+void InstanceServer::handleNewConnection() {
+  while (server->hasPendingConnections()) {
+    const auto socket = server->nextPendingConnection();
+
+    connect(socket,
+            &QLocalSocket::disconnected,
+            socket,
+            &QLocalSocket::deleteLater);
+    connect(socket, &QLocalSocket::readyRead, this, [this, socket]() {
+      const auto logger = getLogger();
+      if (!socket->canReadLine()) {
+        if (socket->bytesAvailable() > MAX_REQUEST_SIZE) {
+          if (logger) {
+            logger->warn("Ignoring oversized request from another instance.");
+          }
+          socket->abort();
+        }
+        return;
+      }
+
+      const auto request =
+          parseInstanceRequest(socket->readLine(MAX_REQUEST_SIZE).trimmed());
+
+      if (!request.has_value()) {
+        if (logger) {
+          logger->warn("Ignoring invalid request from another instance.");
+        }
+        socket->disconnectFromServer();
+        return;
+      }
+
+      if (logger) {
+        logger->info(
+            "Received a request from another instance of LOOT: game \"{}\", "
+            "auto-sort {}",
+            request.value().gameFolderName,
+            request.value().autoSort);
+      }
+
+      const auto accepted = handler && handler(request.value());
+
+      socket->write(accepted ? ACKNOWLEDGEMENT : REJECTION);
+      socket->flush();
+      socket->disconnectFromServer();
+    });
+  }
+}
+}
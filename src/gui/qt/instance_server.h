@@ -0,0 +1,82 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_QT_INSTANCE_SERVER
+#define LOOT_GUI_QT_INSTANCE_SERVER
+
+#include <QtCore/QByteArray>
+#include <QtCore/QObject>
+#include <QtNetwork/QLocalServer>
+#include <functional>
+#include <optional>
+#include <string>
+
+namespace loot {
+// What a later launch of LOOT asked the running instance to do.
+struct InstanceRequest {
+  // The LOOT folder name of the game to switch to, or empty to stay on the
+  // current game.
+  std::string gameFolderName;
+  bool autoSort{false};
+};
+
+bool operator==(const InstanceRequest& lhs, const InstanceRequest& rhs);
+
+QByteArray serializeInstanceRequest(const InstanceRequest& request);
+
+// Returns std::nullopt if the data is not a valid serialized request.
+std::optional<InstanceRequest> parseInstanceRequest(const QByteArray& data);
+
+// Sends the request to an already-running instance of LOOT. Returns true if
+// the running instance accepted the request, and false if there is no
+// running instance to send it to or it declined the request. This blocks,
+// but the wait is short because the server is local and responds as soon as
+// it has decided whether to accept the request.
+bool forwardToRunningInstance(const InstanceRequest& request);
+
+// Listens for requests forwarded by later launches of LOOT, so that they
+// can exit immediately instead of loading everything again.
+class InstanceServer : public QObject {
+  Q_OBJECT
+public:
+  // The handler is called with each valid request, and returns whether it
+  // accepted the request. Only accepted requests are acknowledged, so that
+  // the sender can fall back to handling the request itself.
+  using RequestHandler = std::function<bool(const InstanceRequest&)>;
+
+  InstanceServer(RequestHandler handler, QObject* parent);
+
+  // Returns false if another instance is already listening.
+  bool listen();
+
+private:
+  QLocalServer* server{new QLocalServer(this)};
+  RequestHandler handler;
+
+  void handleNewConnection();
+};
+}
+
+#endif
@@ -29,12 +29,21 @@
 #include <QtCore/QTimer>
 #include <QtCore/QTranslator>
 #include <QtWidgets/QApplication>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
 
 #include "gui/application_mutex.h"
+#include "gui/qt/headless_sort.h"
+#include "gui/qt/instance_server.h"
 #include "gui/qt/main_window.h"
+#include "gui/qt/startup_benchmark.h"
 #include "gui/qt/style.h"
 #include "gui/state/logging.h"
 #include "gui/state/loot_state.h"
+#include "gui/state/memory_accounting.h"
+#include "gui/state/timing.h"
 #include "gui/version.h"
 
 bool isRunningThroughModOrganiser() {
@@ -74,68 +83,76 @@ void logRuntimeEnvironment() {
   }
 }
 
-int main(int argc, char* argv[]) {
-#ifdef _WIN32
-  // Check if LOOT is already running
-  //---------------------------------
-
-  if (loot::IsApplicationMutexLocked()) {
-    // An instance of LOOT is already running, so focus its window then quit.
-    HWND hWnd = ::FindWindow(nullptr, L"LOOT");
-    ::SetForegroundWindow(hWnd);
-    return 0;
+bool isHeadless(int argc, char* argv[]) {
+  for (int i = 1; i < argc; i += 1) {
+    if (std::strcmp(argv[i], "--headless") == 0) {
+      return true;
+    }
   }
-#endif
-
-  loot::ApplicationMutexGuard mutexGuard;
-
-  QApplication app(argc, argv);
 
-  QCommandLineParser parser;
-  parser.addHelpOption();
-  parser.addVersionOption();
-  parser.addOptions(
-      {{"game",
-        "Set the game that LOOT will initially load",
-        "game identifier"},
-       {"game-path", "Set the initial game's install path.", "path"},
-       {"loot-data-path",
-        "Set the directory where LOOT will store its data",
-        "path"},
-       {"auto-sort", "Automatically sort the load order on launch"}});
-  parser.process(app);
-
-  auto lootDataPath =
-      std::filesystem::u8path(parser.value("loot-data-path").toStdString());
-  auto startupGameFolder = parser.value("game").toStdString();
-  auto gamePath =
-      std::filesystem::u8path(parser.value("game-path").toStdString());
-  auto autoSort = parser.isSet("auto-sort");
+  return false;
+}
 
-  loot::LootState state("", lootDataPath);
+void attachToParentConsole() {
+#ifdef _WIN32
+  // LOOT is built as a GUI application, so on Windows it doesn't get a
+  // console for its output unless that output has been redirected.
+  if (GetStdHandle(STD_OUTPUT_HANDLE) == nullptr &&
+      AttachConsole(ATTACH_PARENT_PROCESS)) {
+    FILE* stream = nullptr;
+    freopen_s(&stream, "CONOUT$", "w", stdout);
+    freopen_s(&stream, "CONOUT$", "w", stderr);
+  }
+#endif
+}
 
-  logRuntimeEnvironment();
+void logDiagnostics(const std::filesystem::path& timingTracePath) {
+  loot::logTimingSummary();
+  loot::logMemorySummary();
 
-  state.init(startupGameFolder, gamePath, autoSort);
+  if (!timingTracePath.empty()) {
+    try {
+      loot::writeTimingTrace(timingTracePath);
+    } catch (const std::exception& e) {
+      const auto logger = loot::getLogger();
+      if (logger) {
+        logger->error("Failed to write timing trace: {}", e.what());
+      }
+    }
+  }
+}
 
-  // Load Qt's translations.
+int runGui(loot::LootState& state) {
+  // Load Qt's translations. Qt's own strings are in English, so there's
+  // nothing to load if that's the selected language.
   QTranslator translator;
 
-  auto translationsPath = QLibraryInfo::path(QLibraryInfo::TranslationsPath);
+  const auto& language = state.getSettings().getLanguage();
+  if (language != loot::MessageContent::DEFAULT_LANGUAGE) {
+    auto translationsPath = QLibraryInfo::path(QLibraryInfo::TranslationsPath);
 
-  auto loaded = translator.load(
-      QLocale(QString::fromStdString(state.getSettings().getLanguage())),
-      QString("qt"),
-      QString("_"),
-      translationsPath);
+    auto loaded = translator.load(QLocale(QString::fromStdString(language)),
+                                  QString("qt"),
+                                  QString("_"),
+                                  translationsPath);
 
-  if (loaded) {
-    app.installTranslator(&translator);
+    if (loaded) {
+      QCoreApplication::installTranslator(&translator);
+    }
   }
 
   loot::MainWindow mainWindow(state);
   mainWindow.applyTheme();
 
+  // Later launches of LOOT forward their requests to this instance instead
+  // of starting up again.
+  loot::InstanceServer instanceServer(
+      [&mainWindow](const loot::InstanceRequest& request) {
+        return mainWindow.handleInstanceRequest(request);
+      },
+      nullptr);
+  instanceServer.listen();
+
   const auto wasMaximised = state.getSettings()
                                 .getMainWindowPosition()
                                 .value_or(loot::LootSettings::WindowPosition())
@@ -195,5 +212,192 @@ int main(int argc, char* argv[]) {
     mainWindow.initialise();
   }
 
-  return app.exec();
+  return QApplication::exec();
+}
+
+int main(int argc, char* argv[]) {
+  // This needs to be known before the application object is created, so it
+  // can't be read using QCommandLineParser.
+  const auto headless = isHeadless(argc, argv);
+
+#ifdef _WIN32
+  // Check if LOOT is already running
+  //---------------------------------
+
+  if (headless && loot::IsApplicationMutexLocked()) {
+    std::cerr << "LOOT is already running." << std::endl;
+    return EXIT_FAILURE;
+  }
+#endif
+
+  if (headless) {
+    attachToParentConsole();
+  }
+
+  // Headless mode doesn't create any widgets, so it doesn't need a
+  // QApplication.
+  const std::unique_ptr<QCoreApplication> app =
+      headless ? std::make_unique<QCoreApplication>(argc, argv)
+               : std::make_unique<QApplication>(argc, argv);
+
+  QCommandLineParser parser;
+  parser.addHelpOption();
+  parser.addVersionOption();
+  parser.addOptions(
+      {{"game",
+        "Set the game that LOOT will initially load",
+        "game identifier"},
+       {"game-path", "Set the initial game's install path.", "path"},
+       {"loot-data-path",
+        "Set the directory where LOOT will store its data",
+        "path"},
+       {"auto-sort", "Automatically sort the load order on launch"},
+       {"headless",
+        "Sort and apply the load order without showing a window, then print "
+        "a JSON summary and quit. Implies --auto-sort, and --game may be "
+        "given more than once to sort several games in parallel"},
+       {"timing-trace-path",
+        "Write a trace of how long LOOT's operations took to the given file "
+        "on exit",
+        "path"},
+       {"benchmark-startup",
+        "Run LOOT's startup the given number of times without needing any "
+        "interaction, then write a JSON report of how long each stage took "
+        "and how much memory was used, and quit",
+        "runs"},
+       {"benchmark-sort",
+        "Also sort the load order in each startup benchmark run, without "
+        "applying it"},
+       {"benchmark-output",
+        "Write the startup benchmark report to the given file instead of "
+        "stdout",
+        "path"}});
+  parser.process(*app);
+
+  auto lootDataPath =
+      std::filesystem::u8path(parser.value("loot-data-path").toStdString());
+  auto startupGameFolder = parser.value("game").toStdString();
+
+  // Headless mode can sort multiple games, and the first is loaded as the
+  // current game.
+  std::vector<std::string> headlessGameFolders;
+  for (const auto& value : parser.values("game")) {
+    headlessGameFolders.push_back(value.toStdString());
+  }
+  if (headless) {
+    if (headlessGameFolders.empty()) {
+      std::cerr << "--headless requires at least one --game to be given."
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    startupGameFolder = headlessGameFolders.front();
+  }
+  auto gamePath =
+      std::filesystem::u8path(parser.value("game-path").toStdString());
+  auto autoSort = parser.isSet("auto-sort") || headless;
+  auto timingTracePath = std::filesystem::u8path(
+      parser.value("timing-trace-path").toStdString());
+
+  const auto benchmark = !headless && parser.isSet("benchmark-startup");
+  const auto benchmarkRuns = parser.value("benchmark-startup").toUInt();
+  if (benchmark && benchmarkRuns == 0) {
+    std::cerr << "The number of startup benchmark runs must be a positive "
+                 "integer."
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // A running instance can switch game, sort or refresh, but it can't change
+  // its data path or a game's install path, so don't forward requests that
+  // set them.
+  const auto canForward = !headless && !benchmark &&
+                          !parser.isSet("loot-data-path") &&
+                          !parser.isSet("game-path");
+  if (canForward) {
+#ifdef _WIN32
+    const auto isAlreadyRunning = loot::IsApplicationMutexLocked();
+#else
+    // There's no application mutex, so just try connecting.
+    const auto isAlreadyRunning = true;
+#endif
+
+    if (isAlreadyRunning) {
+      loot::InstanceRequest request;
+      request.gameFolderName = startupGameFolder;
+      request.autoSort = autoSort;
+
+      if (loot::forwardToRunningInstance(request)) {
+        return EXIT_SUCCESS;
+      }
+    }
+  }
+
+#ifdef _WIN32
+  if (benchmark && loot::IsApplicationMutexLocked()) {
+    std::cerr << "LOOT is already running." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!headless && loot::IsApplicationMutexLocked()) {
+    // An instance of LOOT is already running but couldn't handle the
+    // request, so focus its window then quit.
+    HWND hWnd = ::FindWindow(nullptr, L"LOOT");
+    ::SetForegroundWindow(hWnd);
+    return 0;
+  }
+#endif
+
+  loot::ApplicationMutexGuard mutexGuard;
+
+  if (!timingTracePath.empty()) {
+    loot::enableTimingTrace();
+  }
+
+  int exitCode = EXIT_SUCCESS;
+  if (benchmark) {
+    loot::StartupBenchmarkOptions options;
+    options.lootDataPath = lootDataPath;
+    options.gameFolderName = startupGameFolder;
+    options.gamePath = gamePath;
+    options.runs = benchmarkRuns;
+    options.sort = parser.isSet("benchmark-sort");
+    options.outputPath = std::filesystem::u8path(
+        parser.value("benchmark-output").toStdString());
+
+    // Each run creates its own state, so the shared state isn't created.
+    QTimer::singleShot(0, app.get(), [&options]() {
+      QCoreApplication::exit(loot::runStartupBenchmark(options));
+    });
+    exitCode = QCoreApplication::exec();
+
+    logDiagnostics(timingTracePath);
+    loot::shutdownLogging();
+
+    return exitCode;
+  }
+
+  loot::LootState state("", lootDataPath);
+
+  logRuntimeEnvironment();
+
+  state.init(startupGameFolder, gamePath, autoSort);
+
+  if (headless) {
+    // Run from the event loop so that the task worker threads get stopped
+    // when the application quits.
+    QTimer::singleShot(0, app.get(), [&state, &headlessGameFolders]() {
+      QCoreApplication::exit(
+          loot::runHeadlessSort(state, headlessGameFolders));
+    });
+    exitCode = QCoreApplication::exec();
+  } else {
+    exitCode = runGui(state);
+  }
+
+  logDiagnostics(timingTracePath);
+
+  loot::shutdownLogging();
+
+  return exitCode;
 }
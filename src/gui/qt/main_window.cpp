@@ -31,6 +31,7 @@
 #include <QtGui/QCloseEvent>
 #include <QtGui/QDesktopServices>
 #include <QtGui/QStyleHints>
+#include <QtWidgets/QFileDialog>
 #include <QtWidgets/QHeaderView>
 #include <QtWidgets/QMessageBox>
 #include <QtWidgets/QProgressBar>
@@ -40,8 +41,11 @@
 #include <boost/algorithm/string.hpp>
 
 #include "gui/backup.h"
+#include "gui/plugin_items_snapshot.h"
+#include "gui/qt/counters.h"
 #include "gui/qt/helpers.h"
 #include "gui/qt/icon_factory.h"
+#include "gui/qt/messages_widget.h"
 #include "gui/qt/plugin_item_filter_model.h"
 #include "gui/qt/sidebar_plugin_name_delegate.h"
 #include "gui/qt/style.h"
@@ -52,16 +56,30 @@
 #include "gui/query/types/change_game_query.h"
 #include "gui/query/types/clear_all_metadata_query.h"
 #include "gui/query/types/clear_plugin_metadata_query.h"
+#include "gui/query/types/create_backup_query.h"
+#include "gui/query/types/export_metadata_query.h"
 #include "gui/query/types/get_game_data_query.h"
+#include "gui/query/types/get_overlap_counts_query.h"
 #include "gui/query/types/get_overlapping_plugins_query.h"
+#include "gui/query/types/precompute_sort_result_query.h"
+#include "gui/query/types/preload_game_query.h"
+#include "gui/query/types/refresh_game_data_query.h"
 #include "gui/query/types/sort_plugins_query.h"
+#include "gui/state/game/helpers.h"
+#include "gui/state/thread_pool.h"
+#include "gui/state/update_check_cache.h"
 #include "gui/version.h"
 
 namespace {
 using loot::GameId;
 using loot::LootState;
+using loot::PluginMove;
 using loot::translate;
 
+// How long to wait after the last user metadata edit before saving the
+// userlist.
+constexpr int USER_METADATA_SAVE_DELAY_MS = 500;
+
 void showAmbiguousLoadOrderSetWarning(QWidget* parent, const LootState& state) {
   const auto maybeSTestFile =
       state.GetCurrentGame().GetSettings().Id() == GameId::fo4 ||
@@ -80,27 +98,110 @@ void showAmbiguousLoadOrderSetWarning(QWidget* parent, const LootState& state) {
   QMessageBox::warning(
       parent, translate("Ambiguous load order detected"), message);
 }
+
+std::optional<std::vector<std::string>> getIndexedOverlappingPluginNames(
+    const loot::gui::Game& game,
+    const std::vector<loot::PluginItem>& pluginItems,
+    const std::string& targetPluginName) {
+  const auto targetIt = std::find_if(
+      pluginItems.begin(), pluginItems.end(), [&](const auto& item) {
+        return item.name == targetPluginName;
+      });
+  if (targetIt == pluginItems.end() || !targetIt->crc.has_value()) {
+    return std::nullopt;
+  }
+
+  std::vector<std::string> overlappingPluginNames;
+  for (const auto& item : pluginItems) {
+    if (!item.crc.has_value()) {
+      return std::nullopt;
+    }
+
+    const auto overlap = game.DoIndexedRecordsOverlap(targetIt->name,
+                                                      targetIt->crc.value(),
+                                                      item.name,
+                                                      item.crc.value());
+    if (!overlap.has_value()) {
+      return std::nullopt;
+    }
+
+    if (overlap.value()) {
+      overlappingPluginNames.push_back(item.name);
+    }
+  }
+
+  return overlappingPluginNames;
 }
 
-namespace loot {
-std::vector<std::string> GetGroupNames(
-    const std::vector<Group>& masterlistGroups,
-    const std::vector<Group>& userGroups) {
-  std::set<std::string> groupNames;
+// Sorting usually only moves a few plugins, so list those instead of leaving
+// the user to spot them in the whole load order.
+QString describePluginMoves(const std::vector<PluginMove>& moves) {
+  static constexpr size_t MAX_LISTED_MOVES = 20;
+
+  QStringList lines;
+  lines.append(QString::fromStdString(
+      fmt::format(boost::locale::translate("Sorting moved {0} plugin.",
+                                           "Sorting moved {0} plugins.",
+                                           moves.size())
+                      .str(),
+                  moves.size())));
+
+  for (size_t i = 0; i < moves.size() && i < MAX_LISTED_MOVES; i += 1) {
+    // Positions are displayed starting from 1.
+    lines.append(QString::fromStdString(fmt::format(
+        boost::locale::translate("{0}: position {1} to {2}").str(),
+        moves[i].name,
+        moves[i].currentIndex + 1,
+        moves[i].newIndex + 1)));
+  }
+
+  if (moves.size() > MAX_LISTED_MOVES) {
+    const auto remainingMoves = moves.size() - MAX_LISTED_MOVES;
+    lines.append(QString::fromStdString(
+        fmt::format(boost::locale::translate("…and {0} more plugin.",
+                                             "…and {0} more plugins.",
+                                             remainingMoves)
+                        .str(),
+                    remainingMoves)));
+  }
+
+  return lines.join('\n');
+}
 
-  for (const auto& group : masterlistGroups) {
-    groupNames.insert(group.GetName());
+// Get each plugin's text in parallel, then join the texts into a single
+// buffer that's sized up front, as there may be a lot of text.
+template<typename Function>
+std::string joinPluginTexts(
+    const std::vector<const loot::PluginItem*>& plugins,
+    Function getText) {
+  std::vector<std::string> texts(plugins.size());
+  loot::parallelTransform(
+      plugins.begin(), plugins.end(), texts.begin(), [&](const auto plugin) {
+        return getText(*plugin);
+      });
+
+  size_t size = 0;
+  for (const auto& text : texts) {
+    size += text.size() + 2;
   }
 
-  for (const auto& group : userGroups) {
-    groupNames.insert(group.GetName());
+  std::string joined;
+  joined.reserve(size);
+
+  for (size_t i = 0; i < texts.size(); i += 1) {
+    if (i > 0) {
+      joined += "\n\n";
+    }
+    joined += texts[i];
   }
 
-  return std::vector<std::string>(groupNames.begin(), groupNames.end());
+  return joined;
+}
 }
 
+namespace loot {
 std::vector<std::string> GetGroupNames(const gui::Game& game) {
-  return GetGroupNames(game.GetMasterlistGroups(), game.GetUserGroups());
+  return game.GetGroupGraph()->GetGroupNames();
 }
 
 bool hasLoadOrderChanged(const std::vector<std::string>& oldLoadOrder,
@@ -233,7 +334,7 @@ void setWindowPosition(QWidget& window,
   if (QGuiApplication::screenAt(topLeft) == nullptr) {
     // No screen exists at the old position, just leave the Window at the
     // default position Qt gives it so that it isn't positioned off-screen.
-    auto logger = getLogger();
+    auto logger = getLogger(LogCategory::ui);
     if (logger) {
       logger->warn(
           "Could not restore window position because no screen exists "
@@ -249,8 +350,11 @@ void setWindowPosition(QWidget& window,
 
 MainWindow::MainWindow(LootState& state, QWidget* parent) :
     QMainWindow(parent), state(state) {
+  startPerformanceTiming(PerformanceMetric::startup);
+
   qRegisterMetaType<QueryResult>("QueryResult");
   qRegisterMetaType<std::string>("std::string");
+  qRegisterMetaType<PluginItems>("PluginItems");
 
   setupUi();
   refreshGamesDropdown();
@@ -272,6 +376,8 @@ void MainWindow::initialise() {
     themes = findThemes(state.getThemesPath());
 
     if (state.getSettings().getLastVersion() != gui::Version::string()) {
+      // Time spent reading the dialog isn't startup time.
+      performanceTimingStarts.erase(PerformanceMetric::startup);
       showFirstRunDialog();
     }
 
@@ -293,7 +399,6 @@ void MainWindow::initialise() {
     }
 
     const auto& filters = state.getSettings().getFilters();
-    filtersWidget->setGameId(state.GetCurrentGame().GetSettings().Id());
     filtersWidget->setFilterStates(filters);
 
     // Apply the filters before loading the game because that avoids having
@@ -307,24 +412,68 @@ void MainWindow::initialise() {
 
     loadGame(true);
 
-    // Check for updates.
-    if (state.getSettings().isLootUpdateCheckEnabled()) {
-      // This task can be run in the main thread because it's non-blocking.
-      const auto task = new CheckForUpdateTask();
+    runWhenPluginsDisplayed(
+        [this]() { finishPerformanceTiming(PerformanceMetric::startup); });
 
-      connect(
-          task, &Task::finished, this, &MainWindow::handleUpdateCheckFinished);
-      connect(task, &Task::finished, task, &QObject::deleteLater);
-      connect(task, &Task::error, this, &MainWindow::handleUpdateCheckError);
-      connect(task, &Task::error, task, &QObject::deleteLater);
+    // Hold back work that isn't needed to display the game's plugins until
+    // they're displayed, so that it doesn't slow down loading them.
+    startupScheduler->schedule(StartupPhase::idle, [this]() {
+      try {
+        updateGeneralInformation();
+      } catch (const std::exception& e) {
+        handleException(e);
+      }
+    });
 
-      task->execute();
+    if (state.getSettings().isLootUpdateCheckEnabled()) {
+      startupScheduler->schedule(StartupPhase::idle, [this]() {
+        try {
+          checkForUpdates();
+        } catch (const std::exception& e) {
+          handleException(e);
+        }
+      });
     }
   } catch (const std::exception& e) {
     handleException(e);
   }
 }
 
+void MainWindow::checkForUpdates() {
+  // Reuse a recent result instead of asking GitHub again, so that starting
+  // LOOT doesn't use up the API rate limit or wait on a slow network.
+  const auto cache = LoadUpdateCheckCache(state.getUpdateCheckCachePath(),
+                                          gui::Version::revision);
+  const auto now = std::chrono::system_clock::now();
+  if (cache.has_value() && IsUpdateCheckCacheFresh(cache.value(), now)) {
+    const auto logger = getLogger(LogCategory::ui);
+    if (logger) {
+      logger->debug("Using the cached result of the last LOOT update check.");
+    }
+
+    handleUpdateCheckFinished(cache.value().isUpdateAvailable);
+    return;
+  }
+
+  // This task can be run in the main thread because it's non-blocking.
+  const auto task = new CheckForUpdateTask(state.getUpdateCheckCachePath());
+
+  connect(task, &Task::finished, this, &MainWindow::handleUpdateCheckFinished);
+  connect(task, &Task::finished, task, &QObject::deleteLater);
+  connect(task, &Task::error, this, &MainWindow::handleUpdateCheckError);
+  connect(task, &Task::error, task, &QObject::deleteLater);
+
+  task->execute();
+}
+
+void MainWindow::runWhenPluginsDisplayed(std::function<void()> work) {
+  startupScheduler->schedule(StartupPhase::interactive, std::move(work));
+}
+
+void MainWindow::setPerformanceHistoryEnabled(bool enabled) {
+  isPerformanceHistoryEnabled = enabled;
+}
+
 void MainWindow::applyTheme() {
   // Apply theme.
   bool loadingDefault = state.getSettings().getTheme() == "default";
@@ -337,7 +486,7 @@ void MainWindow::applyTheme() {
     loadingDefault = true;
   }
 
-  const auto logger = getLogger();
+  const auto logger = getLogger(LogCategory::ui);
   if (logger) {
     logger->debug("Current style name is {}",
                   qApp->style()->name().toStdString());
@@ -359,9 +508,19 @@ void MainWindow::applyTheme() {
 #endif
 
   if (styleSheet.has_value()) {
-    qApp->setStyleSheet(styleSheet.value());
+    // Setting the application style sheet makes Qt re-polish every widget,
+    // which is slow when there are lots of cards, so skip it if the style
+    // sheet hasn't changed, e.g. because only the palette has changed with
+    // the system colour scheme.
+    if (styleSheet.value() != qApp->styleSheet()) {
+      qApp->setStyleSheet(styleSheet.value());
+
+      qApp->style()->polish(qApp);
+    } else if (logger) {
+      logger->debug("The style sheet is unchanged, so not setting it again");
+    }
 
-    qApp->style()->polish(qApp);
+    clearMessagesHtmlCache();
 
     const auto cardDelegate =
         qobject_cast<CardDelegate*>(pluginCardsView->itemDelegate());
@@ -400,6 +559,12 @@ void MainWindow::setupUi() {
 
   settingsDialog->setObjectName("settingsDialog");
   searchDialog->setObjectName("searchDialog");
+  diagnosticsDialog->setObjectName("diagnosticsDialog");
+  gameDataWatcher->setObjectName("gameDataWatcher");
+  cardSearch->setObjectName("cardSearch");
+  userMetadataSaveTimer->setObjectName("userMetadataSaveTimer");
+  userMetadataSaveTimer->setSingleShot(true);
+  userMetadataSaveTimer->setInterval(USER_METADATA_SAVE_DELAY_MS);
   sidebarPluginsView->setObjectName("sidebarPluginsView");
 
   toolBox->addItem(sidebarPluginsView, QString("P&lugins"));
@@ -501,6 +666,8 @@ void MainWindow::setupMenuBar() {
 
   actionBackupData->setObjectName("actionBackupData");
 
+  actionExtractBackup->setObjectName("actionExtractBackup");
+
   actionQuit->setObjectName("actionQuit");
 
   actionViewDocs->setObjectName("actionViewDocs");
@@ -510,6 +677,8 @@ void MainWindow::setupMenuBar() {
 
   actionOpenLOOTDataFolder->setObjectName("actionOpenLOOTDataFolder");
 
+  actionViewDiagnostics->setObjectName("actionViewDiagnostics");
+
   actionJoinDiscordServer->setObjectName("actionJoinDiscordServer");
 
   actionAbout->setObjectName("actionAbout");
@@ -523,9 +692,14 @@ void MainWindow::setupMenuBar() {
 
   actionCopyContent->setObjectName("actionCopyContent");
 
+  actionExportMetadata->setObjectName("actionExportMetadata");
+
   actionRefreshContent->setObjectName("actionRefreshContent");
   actionRefreshContent->setShortcut(QKeySequence::Refresh);
 
+  actionRankPluginsByOverlaps->setObjectName("actionRankPluginsByOverlaps");
+  actionRankPluginsByOverlaps->setCheckable(true);
+
   actionRedatePlugins->setObjectName("actionRedatePlugins");
 
   actionFixAmbiguousLoadOrder->setObjectName("actionFixAmbiguousLoadOrder");
@@ -555,7 +729,9 @@ void MainWindow::setupMenuBar() {
   menuFile->addAction(actionUpdateMasterlists);
   menuFile->addSeparator();
   menuFile->addAction(actionBackupData);
+  menuFile->addAction(actionExtractBackup);
   menuFile->addAction(actionOpenLOOTDataFolder);
+  menuFile->addAction(actionViewDiagnostics);
   menuFile->addSeparator();
   menuFile->addAction(actionQuit);
   menuGame->addAction(actionOpenGroupsEditor);
@@ -568,7 +744,9 @@ void MainWindow::setupMenuBar() {
   menuGame->addAction(actionSearch);
   menuGame->addAction(actionCopyLoadOrder);
   menuGame->addAction(actionCopyContent);
+  menuGame->addAction(actionExportMetadata);
   menuGame->addAction(actionRefreshContent);
+  menuGame->addAction(actionRankPluginsByOverlaps);
   menuGame->addSeparator();
   menuGame->addAction(actionFixAmbiguousLoadOrder);
   menuGame->addAction(actionRedatePlugins);
@@ -622,7 +800,7 @@ void MainWindow::setupViews() {
   sidebarPluginsView->setModel(proxyModel);
   sidebarPluginsView->setTabKeyNavigation(false);
   sidebarPluginsView->setDragEnabled(true);
-  sidebarPluginsView->setSelectionMode(QAbstractItemView::SingleSelection);
+  sidebarPluginsView->setSelectionMode(QAbstractItemView::ExtendedSelection);
   sidebarPluginsView->setSelectionBehavior(QAbstractItemView::SelectRows);
   sidebarPluginsView->setHorizontalScrollMode(
       QAbstractItemView::ScrollPerPixel);
@@ -648,6 +826,11 @@ void MainWindow::setupViews() {
                                          QHeaderView::Stretch);
   horizontalHeader->setSectionResizeMode(PluginItemModel::SIDEBAR_STATE_COLUMN,
                                          QHeaderView::Fixed);
+  horizontalHeader->setSectionResizeMode(
+      PluginItemModel::SIDEBAR_OVERLAPS_COLUMN, QHeaderView::ResizeToContents);
+
+  // The overlaps column is only shown while plugins are ranked by overlaps.
+  sidebarPluginsView->hideColumn(PluginItemModel::SIDEBAR_OVERLAPS_COLUMN);
 
   updateSidebarColumnWidths();
 
@@ -674,6 +857,35 @@ void MainWindow::setupViews() {
   // leading to layout issues.
   pluginCardsView->setWordWrap(true);
 
+  // Don't create cards for plugins that are filtered out, e.g. inactive
+  // plugins while they're hidden, until they're revealed.
+  cardSizingCache.setIsRowHidden([this](int row) {
+    return !proxyModel
+                ->mapFromSource(pluginItemModel->index(
+                    row, PluginItemModel::CARDS_COLUMN))
+                .isValid();
+  });
+  const auto updateDeferredCards = [this]() {
+    cardSizingCache.updateDeferredRows();
+  };
+  connect(proxyModel,
+          &QAbstractItemModel::rowsInserted,
+          this,
+          [this](const QModelIndex&, int first, int last) {
+            for (int row = first; row <= last; row += 1) {
+              const auto index =
+                  proxyModel->index(row, PluginItemModel::CARDS_COLUMN);
+              cardSizingCache.updateDeferredRow(
+                  proxyModel->mapToSource(index).row());
+            }
+          });
+  connect(proxyModel,
+          &QAbstractItemModel::layoutChanged,
+          this,
+          updateDeferredCards);
+  connect(
+      proxyModel, &QAbstractItemModel::modelReset, this, updateDeferredCards);
+
   cardSizingCache.update(pluginItemModel);
 
   pluginCardsView->setItemDelegate(
@@ -695,6 +907,17 @@ void MainWindow::setupViews() {
   // height of two empty cards, which seems reasonable.
   static constexpr int CARD_SCROLL_STEP_SIZE = 24;
   pluginCardsView->verticalScrollBar()->setSingleStep(CARD_SCROLL_STEP_SIZE);
+
+  connect(&cardSizingCache,
+          &CardSizingCache::cardsUpdated,
+          this,
+          &MainWindow::handleCardSizesUpdated);
+
+  // Size the visible cards first when scrolling to cards with estimated sizes.
+  connect(pluginCardsView->verticalScrollBar(),
+          &QScrollBar::valueChanged,
+          this,
+          &MainWindow::prioritiseVisibleCardSizes);
 }
 
 void MainWindow::translateUi() {
@@ -721,8 +944,12 @@ void MainWindow::translateUi() {
   /* translators: This string is an action in the File menu. */
   actionBackupData->setText(translate("&Backup LOOT Data"));
   /* translators: This string is an action in the File menu. */
+  actionExtractBackup->setText(translate("&Extract LOOT Data Backup…"));
+  /* translators: This string is an action in the File menu. */
   actionOpenLOOTDataFolder->setText(translate("&Open LOOT Data Folder"));
   /* translators: This string is an action in the File menu. */
+  actionViewDiagnostics->setText(translate("View Performance &Diagnostics…"));
+  /* translators: This string is an action in the File menu. */
   actionQuit->setText(translate("&Quit"));
 
   /* translators: The mnemonic in this string shouldn't conflict with other
@@ -737,8 +964,12 @@ void MainWindow::translateUi() {
   /* translators: This string is an action in the Game menu. */
   actionCopyContent->setText(translate("&Copy Content"));
   /* translators: This string is an action in the Game menu. */
+  actionExportMetadata->setText(translate("E&xport Metadata…"));
+  /* translators: This string is an action in the Game menu. */
   actionRefreshContent->setText(translate("&Refresh Content"));
   /* translators: This string is an action in the Game menu. */
+  actionRankPluginsByOverlaps->setText(translate("Rank Plugins by &Overlaps"));
+  /* translators: This string is an action in the Game menu. */
   actionRedatePlugins->setText(translate("Redate &Plugins…"));
   /* translators: This string is an action in the Game menu. */
   actionFixAmbiguousLoadOrder->setText(translate("&Fix Ambiguous Load Order"));
@@ -794,6 +1025,7 @@ void MainWindow::setIcons() {
   actionSearch->setIcon(IconFactory::getSearchIcon());
   actionCopyLoadOrder->setIcon(IconFactory::getCopyLoadOrderIcon());
   actionCopyContent->setIcon(IconFactory::getCopyContentIcon());
+  actionExportMetadata->setIcon(IconFactory::getCopyMetadataIcon());
   actionRefreshContent->setIcon(IconFactory::getRefreshIcon());
   actionRedatePlugins->setIcon(IconFactory::getRedateIcon());
   actionFixAmbiguousLoadOrder->setIcon(IconFactory::getFixIcon());
@@ -890,6 +1122,8 @@ void MainWindow::exitSortingState() {
 
   actionApplySort->setVisible(false);
   actionDiscardSort->setVisible(false);
+  // Restore the default tooltip, which is the action's text.
+  actionApplySort->setToolTip(QString());
 
   actionSettings->setDisabled(false);
   actionUpdateMasterlists->setDisabled(false);
@@ -899,6 +1133,10 @@ void MainWindow::exitSortingState() {
 }
 
 void MainWindow::loadGame(bool isOnLOOTStartup) {
+  // All the game's data is about to be reloaded, so there's no need to watch
+  // for changes to it until that's done.
+  gameDataWatcher->unwatch();
+
   auto progressUpdater = new ProgressUpdater();
 
   // This lambda will run from the worker thread.
@@ -906,10 +1144,44 @@ void MainWindow::loadGame(bool isOnLOOTStartup) {
     emit progressUpdater->progressUpdate(QString::fromStdString(message));
   };
 
+  // On startup there are no cards displayed yet, so display the cards from
+  // the previous session if they were saved, or otherwise display cards as
+  // they're created instead of waiting for all of them. When refreshing, the
+  // existing cards are kept until they're replaced.
+  const auto streamPluginItems = isOnLOOTStartup && !showPluginItemsSnapshot();
+  std::function<void(PluginItems)> sendPluginItems;
+  if (streamPluginItems) {
+    sendPluginItems = [progressUpdater](PluginItems items) {
+      emit progressUpdater->pluginItemsLoaded(items);
+    };
+  }
+
+  // If inactive plugins are hidden, their cards can be sent after all the
+  // active plugins' cards without being displayed out of load order.
+  const auto sendActivePluginItemsFirst =
+      streamPluginItems &&
+      filtersWidget->getPluginFiltersState().hideInactivePlugins;
+
   std::unique_ptr<Query> query =
       std::make_unique<GetGameDataQuery>(state.GetCurrentGame(),
                                          state.getSettings().getLanguage(),
-                                         sendProgressUpdate);
+                                         sendProgressUpdate,
+                                         sendPluginItems,
+                                         sendActivePluginItemsFirst);
+
+  if (streamPluginItems) {
+    const auto token = query->getCancellationToken();
+    connect(progressUpdater,
+            &ProgressUpdater::pluginItemsLoaded,
+            this,
+            [this, token](const PluginItems& items) {
+              // Ignore items that arrive after the query was abandoned.
+              if (!token->isCancelled()) {
+                pluginItemModel->appendPluginItems(PluginItems(items));
+                isShowingStreamedPluginItems = true;
+              }
+            });
+  }
 
   const auto handler = isOnLOOTStartup
                            ? &MainWindow::handleStartupGameDataLoaded
@@ -918,22 +1190,213 @@ void MainWindow::loadGame(bool isOnLOOTStartup) {
   executeBackgroundQuery(std::move(query), handler, progressUpdater);
 }
 
-void MainWindow::updateCounts(
-    const std::vector<SourcedMessage>& generalMessages,
-    const std::vector<PluginItem>& plugins) {
-  const auto counters = GeneralInformationCounters(generalMessages, plugins);
-  const auto hiddenMessageCount =
-      countHiddenMessages(plugins, filtersWidget->getCardContentFiltersState());
+bool MainWindow::showPluginItemsSnapshot() {
+  try {
+    const auto& game = state.GetCurrentGame();
+    auto items = LoadPluginItemsSnapshot(game.PluginItemsSnapshotPath(),
+                                         game.GetSettings().Id(),
+                                         state.getSettings().getLanguage());
+    if (!items.has_value()) {
+      return false;
+    }
+
+    pluginItemModel->setPluginItems(std::move(items.value()));
+    isShowingPluginItemsSnapshot = true;
+
+    statusBar()->showMessage(
+        translate("Showing plugins from when LOOT was last closed until the "
+                  "current data has loaded…"));
+
+    return true;
+  } catch (const std::exception& e) {
+    auto logger = getLogger(LogCategory::ui);
+    if (logger) {
+      logger->warn("Failed to load the plugin items snapshot: {}", e.what());
+    }
+    return false;
+  }
+}
+
+void MainWindow::savePluginItemsSnapshot() {
+  if (!state.HasCurrentGame() || isShowingPluginItemsSnapshot) {
+    return;
+  }
+
+  const auto& game = state.GetCurrentGame();
+  if (!game.IsInitialised()) {
+    return;
+  }
+
+  // Don't save items that don't match the current load order, e.g. because
+  // a sorted load order hasn't been applied or not all plugins have loaded.
+  const auto items = pluginItemModel->getPluginItems();
+  const auto loadOrder = game.GetLoadOrder();
+  const auto matchesLoadOrder = std::equal(
+      items.begin(),
+      items.end(),
+      loadOrder.begin(),
+      loadOrder.end(),
+      [](const PluginItem& item, const std::string& pluginName) {
+        return item.name == pluginName;
+      });
+  if (!matchesLoadOrder) {
+    return;
+  }
+
+  SavePluginItemsSnapshot(game.PluginItemsSnapshotPath(),
+                          game.GetSettings().Id(),
+                          state.getSettings().getLanguage(),
+                          items);
+}
+
+void MainWindow::updateGameDataWatcher() {
+  if (state.HasCurrentGame() && state.getSettings().isAutoRefreshEnabled()) {
+    gameDataWatcher->watch(state.GetCurrentGame());
+  } else {
+    gameDataWatcher->unwatch();
+  }
+}
+
+std::vector<PluginItem> MainWindow::reloadMetadataAndGetPluginItems() {
+  auto& game = state.GetCurrentGame();
+  const auto changedPluginNames = game.ReloadMetadata();
+  game.PublishDataSnapshot();
+  const auto loadOrder = game.GetLoadOrder();
+  const auto language = state.getSettings().getLanguage();
+
+  // Items from a snapshot weren't derived from the game's current state, so
+  // they can't be reused.
+  if (!changedPluginNames.has_value() || isShowingPluginItemsSnapshot) {
+    return GetPluginItems(loadOrder, game, language);
+  }
+
+  return GetPluginItems(loadOrder,
+                        game,
+                        language,
+                        pluginItemModel->getPluginItems(),
+                        changedPluginNames.value());
+}
+
+void MainWindow::updateCounts() {
+  const auto counters = pluginItemModel->getCounters();
+  const auto hiddenMessageCount = pluginItemModel->getHiddenMessageCount();
   const auto hiddenPluginCount =
       counters.totalPlugins - static_cast<size_t>(proxyModel->rowCount()) + 1;
 
   filtersWidget->setMessageCounts(hiddenMessageCount, counters.totalMessages);
   filtersWidget->setPluginCounts(hiddenPluginCount, counters.totalPlugins);
+  filtersWidget->setGroupPluginCounts(pluginItemModel->getGroupPluginCounts());
+}
+
+void MainWindow::updateGroups() {
+  const auto groupGraph = state.GetCurrentGame().GetGroupGraph();
+
+  filtersWidget->setGroups(groupGraph->GetGroupNames());
+  filtersWidget->setGroupPluginCounts(pluginItemModel->getGroupPluginCounts());
+  proxyModel->setGroupGraph(groupGraph);
+}
+
+void MainWindow::updatePluginDependents() {
+  proxyModel->setPluginDependentsIndex(
+      state.GetCurrentGame().GetPluginDependentsIndex());
+}
+
+void MainWindow::updateOverlapCounts() {
+  if (!actionRankPluginsByOverlaps->isChecked() || !state.HasCurrentGame() ||
+      !pluginItemModel->hasPluginsWithoutOverlapCounts()) {
+    return;
+  }
+
+  handleProgressUpdate(translate("Counting overlapping plugins…"));
+
+  std::unique_ptr<Query> query = std::make_unique<GetOverlapCountsQuery>(
+      state.GetCurrentGame(),
+      state.getSettings().getLanguage(),
+      state.getSettings().isPluginRecordDataReleaseEnabled());
+
+  executeBackgroundQuery(
+      std::move(query), &MainWindow::handleOverlapCountsFound, nullptr);
+}
+
+void MainWindow::startPerformanceTiming(PerformanceMetric metric) {
+  performanceTimingStarts.insert_or_assign(metric,
+                                           std::chrono::steady_clock::now());
+}
+
+void MainWindow::finishPerformanceTiming(PerformanceMetric metric) {
+  const auto it = performanceTimingStarts.find(metric);
+  if (it == performanceTimingStarts.end()) {
+    return;
+  }
+
+  const auto duration = std::chrono::steady_clock::now() - it->second;
+  performanceTimingStarts.erase(it);
+
+  if (!isPerformanceHistoryEnabled || !state.HasCurrentGame()) {
+    return;
+  }
+
+  PerformanceRecord record;
+  record.recordedAt = std::chrono::system_clock::now();
+  record.gameFolderName = state.GetCurrentGame().GetSettings().FolderName();
+  record.metric = metric;
+  record.duration =
+      std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+  record.pluginCount =
+      static_cast<uint32_t>(pluginItemModel->getPluginItems().size());
+
+  // The history is only informative, so failing to update it shouldn't
+  // interrupt the user.
+  try {
+    AppendPerformanceRecord(state.getPerformanceHistoryPath(), record);
+  } catch (const std::exception& e) {
+    const auto logger = getLogger(LogCategory::ui);
+    if (logger) {
+      logger->error("Failed to update the performance history: {}", e.what());
+    }
+  }
+
+  exportRunMetrics(record);
+}
+
+void MainWindow::exportRunMetrics(const PerformanceRecord& record) {
+  const auto metricsPath = state.getSettings().getRunMetricsPath();
+  if (metricsPath.empty()) {
+    runMetricsWriter.reset();
+    return;
+  }
+
+  // The path may have been changed in the settings dialog since the writer
+  // was created.
+  if (!runMetricsWriter || runMetricsWriter->getFilePath() != metricsPath) {
+    runMetricsWriter = std::make_unique<RunMetricsWriter>(metricsPath);
+  }
+
+  RunMetricsRecord metrics;
+  metrics.recordedAt = record.recordedAt;
+  metrics.lootVersion = gui::Version::string();
+  metrics.gameFolderName = record.gameFolderName;
+  metrics.operation = record.metric;
+  metrics.duration = record.duration;
+  metrics.pluginCount = record.pluginCount;
+  metrics.peakMemoryBytes = getProcessPeakMemoryUsage();
+  metrics.cacheStats = getCacheStats();
+  metrics.operationTimings = getOperationTimings();
+
+  runMetricsWriter->append(metrics);
 }
 
 void MainWindow::updateGeneralInformation() {
-  const auto preludeInfo = getFileRevisionSummary(state.getPreludePath(),
-                                                  FileType::MasterlistPrelude);
+  // Getting the revision summaries involves hashing the masterlist and
+  // prelude, so during startup that's left until the idle phase, and until
+  // then the displayed revisions are kept.
+  const auto deferRevisions = !startupScheduler->hasReached(StartupPhase::idle);
+  const auto& generalInfo = pluginItemModel->getGeneralInfo();
+
+  const auto preludeInfo =
+      deferRevisions ? generalInfo.preludeRevision
+                     : getFileRevisionSummary(state.getPreludePath(),
+                                              FileType::MasterlistPrelude);
   auto initMessages = state.getInitMessages();
 
   if (!state.HasCurrentGame()) {
@@ -942,8 +1405,11 @@ void MainWindow::updateGeneralInformation() {
     return;
   }
 
-  const auto masterlistInfo = getFileRevisionSummary(
-      state.GetCurrentGame().MasterlistPath(), FileType::Masterlist);
+  const auto masterlistInfo =
+      deferRevisions
+          ? generalInfo.masterlistRevision
+          : getFileRevisionSummary(state.GetCurrentGame().MasterlistPath(),
+                                   FileType::Masterlist);
 
   const auto gameMessages = state.GetCurrentGame().GetMessages(
       state.getSettings().getLanguage(),
@@ -1024,8 +1490,7 @@ void MainWindow::updateSidebarColumnWidths() {
 void MainWindow::setFiltersState(PluginFiltersState&& filtersState) {
   proxyModel->setFiltersState(std::move(filtersState));
 
-  updateCounts(pluginItemModel->getGeneralMessages(),
-               pluginItemModel->getPluginItems());
+  updateCounts();
   refreshSearch();
 }
 
@@ -1035,8 +1500,7 @@ void MainWindow::setFiltersState(
   proxyModel->setFiltersState(std::move(filtersState),
                               std::move(overlappingPluginNames));
 
-  updateCounts(pluginItemModel->getGeneralMessages(),
-               pluginItemModel->getPluginItems());
+  updateCounts();
   refreshSearch();
 }
 
@@ -1044,49 +1508,81 @@ void MainWindow::refreshSearch() {
   on_searchDialog_textChanged(searchDialog->getSearchText());
 }
 
-void MainWindow::refreshPluginRawData(const std::string& pluginName) {
-  const auto loadOrder = state.GetCurrentGame().GetLoadOrder();
+void MainWindow::refreshPluginRawData(
+    const std::vector<std::string>& pluginNames) {
+  // A plugin's item is derived from its own metadata and the state of the
+  // files and plugins that its metadata's conditions reference, not other
+  // plugins' metadata, so editing a plugin's metadata only affects its own
+  // item.
+  const auto& game = state.GetCurrentGame();
 
-  for (int i = 1; i < pluginItemModel->rowCount(); i += 1) {
-    const auto index = pluginItemModel->index(i, 0);
-    const auto pluginItem = index.data(RawDataRole).value<PluginItem>();
+  std::vector<PluginItem> newPluginItems;
+  newPluginItems.reserve(pluginNames.size());
 
-    if (pluginItem.name == pluginName) {
-      const auto& plugin = *state.GetCurrentGame().GetPlugin(pluginName);
-      const auto newPluginItem = PluginItem(
-          state.GetCurrentGame().GetSettings().Id(),
-          plugin,
-          state.GetCurrentGame(),
-          state.GetCurrentGame().GetActiveLoadOrderIndex(plugin, loadOrder),
-          state.GetCurrentGame().IsPluginActive(plugin.GetName()),
-          state.getSettings().getLanguage());
+  for (const auto& pluginName : pluginNames) {
+    if (!pluginItemModel->getPluginRow(pluginName).has_value()) {
+      continue;
+    }
 
-      const auto indexData = QVariant::fromValue(newPluginItem);
-      pluginItemModel->setData(index, indexData, RawDataRole);
-      break;
+    const auto plugin = game.GetPlugin(pluginName);
+    if (!plugin) {
+      continue;
     }
+
+    newPluginItems.push_back(
+        PluginItem(game.GetSettings().Id(),
+                   *plugin,
+                   game,
+                   game.GetActiveLoadOrderIndex(*plugin),
+                   game.IsPluginActive(plugin->GetName()),
+                   state.getSettings().getLanguage()));
   }
+
+  pluginItemModel->replacePluginItems(std::move(newPluginItems));
+
+  // Editing a plugin's metadata may change its requirements.
+  updatePluginDependents();
 }
 
-bool MainWindow::hasErrorMessages() const {
-  const auto counters = GeneralInformationCounters(
-      pluginItemModel->getGeneralMessages(), pluginItemModel->getPluginItems());
+void MainWindow::scheduleUserMetadataSave() {
+  // Restarting the timer pushes the save back.
+  userMetadataSaveTimer->start();
+}
+
+void MainWindow::flushUserMetadataSave() {
+  if (!userMetadataSaveTimer->isActive()) {
+    return;
+  }
+
+  userMetadataSaveTimer->stop();
+
+  if (state.HasCurrentGame()) {
+    state.GetCurrentGame().SaveUserMetadata();
+    gameDataWatcher->acceptOwnChanges();
+  }
+}
 
-  return counters.errors != 0;
+bool MainWindow::hasErrorMessages() const {
+  return pluginItemModel->getCounters().errors != 0;
 }
 
 void MainWindow::sortPlugins(bool isAutoSort) {
+  // Updating the masterlist reloads the userlist, and sorting may reuse a
+  // result fingerprinted with the userlist's content.
+  flushUserMetadataSave();
+
   std::vector<Task*> updateTasks;
 
   if (state.getSettings().isMasterlistUpdateBeforeSortEnabled()) {
     handleProgressUpdate(translate("Updating and parsing masterlist…"));
+    startPerformanceTiming(PerformanceMetric::masterlistUpdate);
 
     const auto preludeTask = new UpdatePreludeTask(state);
 
     updateTasks.push_back(preludeTask);
 
     const auto masterlistTask =
-        new UpdateMasterlistTask(state.GetCurrentGame());
+        new UpdateMasterlistTask(state.GetCurrentGame(), state.getSettings());
 
     updateTasks.push_back(masterlistTask);
   }
@@ -1102,50 +1598,139 @@ void MainWindow::sortPlugins(bool isAutoSort) {
     emit progressUpdater->progressUpdate(QString::fromStdString(message));
   };
 
-  std::unique_ptr<Query> sortPluginsQuery =
+  auto sortPluginsQuery =
       std::make_unique<SortPluginsQuery>(state.GetCurrentGame(),
                                          state,
                                          state.getSettings().getLanguage(),
                                          sendProgressUpdate);
 
+  // The task owns the query, but the query needs to be given the current
+  // plugin items just before it runs, after any masterlist update has been
+  // handled.
+  const auto sortPluginsQueryPtr = sortPluginsQuery.get();
+  const auto sortToken = trackRunningQuery(*sortPluginsQuery);
+
   auto sortTask = new QueryTask(std::move(sortPluginsQuery));
 
   const auto sortHandler = isAutoSort ? &MainWindow::handlePluginsAutoSorted
                                       : &MainWindow::handlePluginsManualSorted;
 
-  auto updatesFuture =
-      whenAllTasks(updateTasks)
-          .then(this,
-                [this](const QList<QFuture<QueryResult>> futures) {
-                  std::vector<QueryResult> results;
-                  for (const auto& future : futures) {
-                    results.push_back(future.result());
-                  }
+  whenAllTasks(updateTasks)
+      .then(this,
+            [this](const QList<QFuture<QueryResult>> futures) {
+              std::vector<QueryResult> results;
+              for (const auto& future : futures) {
+                results.push_back(future.result());
+              }
 
-                  handleMasterlistUpdated(results);
-                })
-          .onFailed(this,
-                    [this](const std::exception& e) { handleError(e.what()); })
-          .then(this, [sortTask]() { executeBackgroundTask(sortTask); });
+              handleMasterlistUpdated(results);
+            })
+      .onFailed(this,
+                [this](const std::exception& e) { handleError(e.what()); })
+      .then(this, [this, sortTask, sortPluginsQueryPtr]() {
+        sortPluginsQueryPtr->setCurrentPluginItems(
+            pluginItemModel->getPluginItems());
+        startPerformanceTiming(PerformanceMetric::sort);
+        executeBackgroundTask(sortTask);
+      });
 
   auto sortFuture =
       taskFuture(sortTask)
           .then(this,
-                [this, sortHandler](QueryResult result) {
-                  (this->*sortHandler)(result);
+                [this, sortHandler, sortToken](QFuture<QueryResult> future) {
+                  auto result = future.takeResult();
+                  if (!sortToken->isCancelled()) {
+                    finishPerformanceTiming(PerformanceMetric::sort);
+                    (this->*sortHandler)(std::move(result));
+                  }
                 })
           .onFailed(this,
-                    [this](const std::exception& e) { handleError(e.what()); })
-          .then(this, [this, progressUpdater]() {
-            progressDialog->reset();
+                    [this, sortToken](const std::exception& e) {
+                      if (!sortToken->isCancelled()) {
+                        handleError(e.what());
+                      }
+                    })
+          .then(this, [this, progressUpdater, sortToken]() {
+            untrackRunningQuery(sortToken);
+            // A superseded sort mustn't close the progress dialog of the sort
+            // that replaced it.
+            if (!sortToken->isCancelled()) {
+              progressDialog->reset();
+            }
             progressUpdater->deleteLater();
           });
 
-  executeConcurrentBackgroundTasks(updateTasks, updatesFuture);
+  executeConcurrentBackgroundTasks(updateTasks);
+}
+
+void MainWindow::startForwardedAutoSort() {
+  if (hasErrorMessages()) {
+    state.GetCurrentGame().AppendMessage(CreatePlainTextSourcedMessage(
+        MessageType::error,
+        MessageSource::autoSortCancellation,
+        boost::locale::translate("Auto-sort has been cancelled as there is at "
+                                 "least one error message displayed.")));
+
+    updateGeneralMessages();
+    return;
+  }
+
+  isForwardedAutoSort = true;
+  sortPlugins(true);
+}
+
+void MainWindow::precomputeSortResult() {
+  auto query =
+      std::make_unique<PrecomputeSortResultQuery>(state.GetCurrentGame());
+
+  const auto token = trackRunningQuery(*query);
+
+  // Run the query on the same worker thread as sorting, so that a sort that
+  // is started before the result is ready waits for it and can then use it.
+  auto task = new QueryTask(std::move(query));
+
+  executeBackgroundTask(task).then(this,
+                                   [this, token](QFuture<QueryResult>) {
+                                     untrackRunningQuery(token);
+                                   });
+}
+
+void MainWindow::preloadPreviousGame() {
+  const auto& settings = state.getSettings();
+  const auto previousGame = settings.getPreviousGame();
+  if (!settings.isPreviousGamePreloadEnabled() ||
+      settings.getMaxResidentGames() == 0 || previousGame.empty() ||
+      !state.IsGameInstalled(previousGame)) {
+    return;
+  }
+
+  auto query = std::make_unique<PreloadGameQuery>(
+      state,
+      settings.getLanguage(),
+      previousGame,
+      static_cast<size_t>(settings.getMaxResidentGames()));
+
+  cancelPreloadingGame();
+  preloadGameToken = query->getCancellationToken();
+
+  // Any errors are logged by the task, and there's nothing else to do with
+  // them as the game is still loaded normally when it's switched to.
+  executeBackgroundTask(new QueryTask(std::move(query), TaskThreadGroup::Idle));
+}
+
+void MainWindow::cancelPreloadingGame() {
+  if (preloadGameToken) {
+    preloadGameToken->cancel();
+    preloadGameToken.reset();
+  }
 }
 
 void MainWindow::showFirstRunDialog() {
-  auto zipPath = createBackup();
+  // Back up synchronously, as the backup should capture LOOT's data before
+  // anything is loaded or changed by this version.
+  flushUserMetadataSave();
+  const auto backupPath =
+      std::get<CreateBackupResult>(createBackupQuery()->executeLogic());
 
   std::string textTemplate = R"(
 <p>{}</p>
@@ -1159,10 +1744,10 @@ void MainWindow::showFirstRunDialog() {
 )";
 
   std::string paragraph1;
-  if (zipPath.has_value()) {
-    auto zipPathString = zipPath.value().u8string();
-    auto link = "<pre><a href=\"file:" + zipPathString +
-                "\" style=\"white-space: nowrap\">" + zipPathString +
+  if (backupPath.has_value()) {
+    auto backupPathString = backupPath.value().u8string();
+    auto link = "<pre><a href=\"file:" + backupPathString +
+                "\" style=\"white-space: nowrap\">" + backupPathString +
                 "</a></pre>";
 
     paragraph1 = fmt::format(
@@ -1233,9 +1818,34 @@ void MainWindow::showNotification(const QString& message) {
   statusBar()->showMessage(message, NOTIFICATION_LIFETIME_MS);
 }
 
+std::pair<QModelIndex, QModelIndex> MainWindow::getVisibleCardIndexes()
+    const {
+  const auto viewportRect = pluginCardsView->viewport()->rect();
+  const auto firstIndex = pluginCardsView->indexAt(viewportRect.topLeft());
+  if (!firstIndex.isValid()) {
+    return {QModelIndex(), QModelIndex()};
+  }
+
+  auto lastIndex = pluginCardsView->indexAt(viewportRect.bottomLeft());
+  if (!lastIndex.isValid()) {
+    lastIndex = proxyModel->index(proxyModel->rowCount() - 1,
+                                  PluginItemModel::CARDS_COLUMN);
+  }
+
+  return {firstIndex, lastIndex};
+}
+
 QModelIndex MainWindow::getSelectedPluginIndex() const {
-  auto selectedPluginIndices =
-      sidebarPluginsView->selectionModel()->selectedIndexes();
+  const auto selectionModel = sidebarPluginsView->selectionModel();
+
+  // If several plugins are selected, actions that work on one plugin use the
+  // one that was selected last.
+  const auto currentIndex = selectionModel->currentIndex();
+  if (currentIndex.isValid() && selectionModel->isSelected(currentIndex)) {
+    return currentIndex;
+  }
+
+  auto selectedPluginIndices = selectionModel->selectedIndexes();
   if (selectedPluginIndices.isEmpty()) {
     throw std::runtime_error(
         "Cannot copy plugin metadata when no plugin is selected");
@@ -1244,6 +1854,34 @@ QModelIndex MainWindow::getSelectedPluginIndex() const {
   return selectedPluginIndices.first();
 }
 
+std::vector<const PluginItem*> MainWindow::getSelectedPluginItems() const {
+  // The selected indexes include every column of each selected row.
+  std::set<int> sourceRows;
+  for (const auto& index :
+       sidebarPluginsView->selectionModel()->selectedIndexes()) {
+    const auto sourceRow = proxyModel->mapToSource(index).row();
+    // The zeroth row is for the general information card.
+    if (sourceRow > 0) {
+      sourceRows.insert(sourceRow);
+    }
+  }
+
+  if (sourceRows.empty()) {
+    throw std::runtime_error(
+        "Cannot copy plugin content when no plugin is selected");
+  }
+
+  const auto& items = pluginItemModel->getPluginItems();
+
+  std::vector<const PluginItem*> selectedItems;
+  selectedItems.reserve(sourceRows.size());
+  for (const auto sourceRow : sourceRows) {
+    selectedItems.push_back(&items.at(sourceRow - 1));
+  }
+
+  return selectedItems;
+}
+
 PluginItem MainWindow::getSelectedPlugin() const {
   auto indexData = getSelectedPluginIndex().data(RawDataRole);
   if (!indexData.canConvert<PluginItem>()) {
@@ -1287,7 +1925,7 @@ void MainWindow::closeEvent(QCloseEvent* event) {
 
     state.getSettings().storeGroupsEditorWindowPosition(groupsEditorPosition);
   } catch (const std::exception& e) {
-    auto logger = getLogger();
+    auto logger = getLogger(LogCategory::ui);
     if (logger) {
       logger->error("Failed to record window positions: {}", e.what());
     }
@@ -1296,7 +1934,7 @@ void MainWindow::closeEvent(QCloseEvent* event) {
   try {
     state.getSettings().storeFilters(filtersWidget->getFilterSettings());
   } catch (const std::exception& e) {
-    auto logger = getLogger();
+    auto logger = getLogger(LogCategory::ui);
     if (logger) {
       logger->error("Failed to record filter states: {}", e.what());
     }
@@ -1306,22 +1944,43 @@ void MainWindow::closeEvent(QCloseEvent* event) {
     state.getSettings().storeLastGame(
         state.GetCurrentGame().GetSettings().FolderName());
   } catch (const std::runtime_error& e) {
-    auto logger = getLogger();
+    auto logger = getLogger(LogCategory::ui);
     if (logger) {
       logger->error("Couldn't set last game: {}", e.what());
     }
   }
 
+  try {
+    flushUserMetadataSave();
+  } catch (const std::exception& e) {
+    auto logger = getLogger(LogCategory::ui);
+    if (logger) {
+      logger->error("Failed to save user metadata: {}", e.what());
+    }
+  }
+
+  try {
+    savePluginItemsSnapshot();
+  } catch (const std::exception& e) {
+    auto logger = getLogger(LogCategory::ui);
+    if (logger) {
+      logger->error("Failed to save the plugin items snapshot: {}", e.what());
+    }
+  }
+
   try {
     state.getSettings().updateLastVersion();
     state.getSettings().save(state.getSettingsPath());
   } catch (const std::exception& e) {
-    auto logger = getLogger();
+    auto logger = getLogger(LogCategory::ui);
     if (logger) {
       logger->error("Failed to save LOOT's settings. Error: {}", e.what());
     }
   }
 
+  abandonRunningQueries();
+  cancelPreloadingGame();
+
   event->accept();
 }
 
@@ -1329,6 +1988,14 @@ void MainWindow::executeBackgroundQuery(
     std::unique_ptr<Query> query,
     void (MainWindow::*onComplete)(QueryResult),
     ProgressUpdater* progressUpdater) {
+  // Queries may read the userlist or replace the current game, so any
+  // pending save must happen first.
+  try {
+    flushUserMetadataSave();
+  } catch (const std::exception& e) {
+    handleException(e);
+  }
+
   if (progressUpdater != nullptr) {
     connect(progressUpdater,
             &ProgressUpdater::progressUpdate,
@@ -1336,68 +2003,189 @@ void MainWindow::executeBackgroundQuery(
             &MainWindow::handleProgressUpdate);
   }
 
+  const auto token = trackRunningQuery(*query);
+
   loot::executeBackgroundQuery(std::move(query))
       .then(this,
-            [this, onComplete](QueryResult result) {
-              (this->*onComplete)(result);
+            [this, onComplete, token](QFuture<QueryResult> future) {
+              // Taking the result moves it out of the future instead of
+              // copying it, and rethrows any exception thrown by the query.
+              auto result = future.takeResult();
+              if (!token->isCancelled()) {
+                (this->*onComplete)(std::move(result));
+              }
             })
-      .onFailed(this, [this](std::exception& e) { handleError(e.what()); })
-      .then(this, [progressUpdater]() { progressUpdater->deleteLater(); });
+      .onFailed(this,
+                [this, token](std::exception& e) {
+                  if (!token->isCancelled()) {
+                    handleError(e.what());
+                  }
+                })
+      .then(this, [this, progressUpdater, token]() {
+        untrackRunningQuery(token);
+        progressUpdater->deleteLater();
+      });
 }
 
-void MainWindow::handleError(const std::string& message) {
-  progressDialog->reset();
+std::shared_ptr<CancellationToken> MainWindow::trackRunningQuery(
+    const Query& query) {
+  auto token = query.getCancellationToken();
 
-  QMessageBox::critical(
-      this, translate("Error"), QString::fromStdString(message));
-}
+  const auto key = query.getSupersedingKey();
+  if (key.has_value()) {
+    // Any older query with the same key is now redundant, so cancel it. If it
+    // hasn't started yet it won't run at all.
+    auto& latestToken = latestQueryTokensByKey[key.value()];
+    if (latestToken) {
+      latestToken->cancel();
 
-void MainWindow::handleException(const std::exception& exception) {
-  auto logger = getLogger();
-  if (logger) {
-    logger->error("Caught an exception: {}", exception.what());
+      auto logger = getLogger(LogCategory::ui);
+      if (logger) {
+        logger->debug("Superseded a running query with key \"{}\"",
+                      key.value());
+      }
+    }
+    latestToken = token;
   }
 
-  auto message = boost::locale::translate(
-                     "Oh no, something went wrong! You can check your "
-                     "LOOTDebugLog.txt (you can get to it through the "
-                     "main menu) for more information.")
-                     .str();
+  runningQueryTokens.insert(token);
 
-  handleError(message);
+  return token;
 }
 
-void MainWindow::handleQueryException(const Query& query,
-                                      const std::exception& exception) {
-  auto logger = getLogger();
-  if (logger) {
-    logger->error("Caught an exception: {}", exception.what());
+void MainWindow::untrackRunningQuery(
+    const std::shared_ptr<CancellationToken>& token) {
+  runningQueryTokens.erase(token);
+
+  for (auto it = latestQueryTokensByKey.begin();
+       it != latestQueryTokensByKey.end();) {
+    if (it->second == token) {
+      it = latestQueryTokensByKey.erase(it);
+    } else {
+      ++it;
+    }
   }
+}
 
-  handleError(query.getErrorMessage());
+void MainWindow::abandonRunningQueries() {
+  // The queries will stop at their next cancellation check, and their results
+  // and errors will be discarded.
+  for (const auto& token : runningQueryTokens) {
+    token->cancel();
+  }
+
+  runningQueryTokens.clear();
+  latestQueryTokensByKey.clear();
+
+  // Don't keep adding plugin items to the model in the background, but don't
+  // leave it partially filled either.
+  pluginItemsCommitter->cancel();
 }
 
-void MainWindow::handleGameDataLoaded(QueryResult result) {
+void MainWindow::handleError(const std::string& message) {
   progressDialog->reset();
 
-  pluginItemModel->setPluginItems(std::move(std::get<PluginItems>(result)));
+  // If loading the game at startup failed, there's nothing left to wait for.
+  startupScheduler->enterInteractivePhase();
+
+  // The snapshot is only shown until the current data has loaded, so if that
+  // failed, don't leave stale plugins displayed as if they were current.
+  if (isShowingPluginItemsSnapshot) {
+    isShowingPluginItemsSnapshot = false;
+    pluginItemModel->clearPluginItems();
+    statusBar()->clearMessage();
+  }
+
+  // Similarly, plugins streamed in by a load that then failed are only some
+  // of the game's plugins, so remove them all instead of showing a partial
+  // list.
+  if (isShowingStreamedPluginItems) {
+    isShowingStreamedPluginItems = false;
+    pluginItemModel->clearPluginItems();
+  }
+
+  QMessageBox::critical(
+      this, translate("Error"), QString::fromStdString(message));
+}
+
+void MainWindow::handleException(const std::exception& exception) {
+  auto logger = getLogger(LogCategory::ui);
+  if (logger) {
+    logger->error("Caught an exception: {}", exception.what());
+  }
+
+  auto message = boost::locale::translate(
+                     "Oh no, something went wrong! You can check your "
+                     "LOOTDebugLog.txt (you can get to it through the "
+                     "main menu) for more information.")
+                     .str();
+
+  handleError(message);
+}
+
+void MainWindow::handleQueryException(const Query& query,
+                                      const std::exception& exception) {
+  auto logger = getLogger(LogCategory::ui);
+  if (logger) {
+    logger->error("Caught an exception: {}", exception.what());
+  }
+
+  handleError(query.getErrorMessage());
+}
+
+void MainWindow::handleGameDataLoaded(QueryResult result,
+                                      std::function<void()> onDisplayed) {
+  // The complete list replaces any streamed items.
+  isShowingStreamedPluginItems = false;
 
-  updateGeneralInformation();
+  // Keep the progress dialog open until all the plugins are displayed, so
+  // that nothing can act on a partially-filled model.
+  pluginItemsCommitter->commit(
+      std::move(std::get<PluginItems>(result)),
+      [this, onDisplayed = std::move(onDisplayed)]() {
+        try {
+          progressDialog->reset();
 
-  filtersWidget->setGroups(GetGroupNames(state.GetCurrentGame()));
-  filtersWidget->showCreationClubPluginsFilter(
-      state.GetCurrentGame().HadCreationClub());
+          if (isShowingPluginItemsSnapshot) {
+            isShowingPluginItemsSnapshot = false;
+            statusBar()->clearMessage();
+          }
 
-  pluginEditorWidget->setBashTagCompletions(
-      state.GetCurrentGame().GetKnownBashTags());
+          updateGeneralInformation();
 
-  enableGameActions();
+          updateGroups();
+          updatePluginDependents();
+          filtersWidget->showCreationClubPluginsFilter(
+              state.GetCurrentGame().HadCreationClub());
+
+          pluginEditorWidget->setBashTagCompletions(
+              state.GetCurrentGame().GetKnownBashTags());
+
+          enableGameActions();
+
+          updateGameDataWatcher();
+
+          // The cards can now be interacted with, so startup work that was
+          // held back can go ahead.
+          startupScheduler->enterInteractivePhase();
+
+          if (onDisplayed) {
+            onDisplayed();
+          }
+
+          // Plugins that are new or have changed since overlaps were last
+          // counted have no count, so count them.
+          updateOverlapCounts();
+        } catch (const std::exception& e) {
+          handleException(e);
+        }
+      });
 }
 
 bool MainWindow::handlePluginsSorted(QueryResult result) {
   filtersWidget->resetOverlapAndGroupsFilters();
 
-  auto sortedPlugins = std::get<PluginItems>(result);
+  auto sortedPlugins = std::get<PluginItems>(std::move(result));
 
   if (sortedPlugins.empty()) {
     // If there was a sorting failure the array of plugins will be empty.
@@ -1420,6 +2208,18 @@ bool MainWindow::handlePluginsSorted(QueryResult result) {
 
   if (loadOrderHasChanged) {
     enterSortingState();
+
+    std::vector<std::string> sortedPluginNames;
+    sortedPluginNames.reserve(sortedPlugins.size());
+    for (const auto& plugin : sortedPlugins) {
+      sortedPluginNames.push_back(plugin.name);
+    }
+
+    const auto movesDescription = describePluginMoves(
+        GetMinimalPluginMoves(currentLoadOrder, sortedPluginNames));
+
+    actionApplySort->setToolTip(movesDescription);
+    showNotification(movesDescription.section('\n', 0, 0));
   } else {
     state.DecrementUnappliedChangeCounter();
 
@@ -1433,7 +2233,7 @@ bool MainWindow::handlePluginsSorted(QueryResult result) {
     }
   }
 
-  handleGameDataLoaded(sortedPlugins);
+  handleGameDataLoaded(std::move(sortedPlugins));
 
   return loadOrderHasChanged;
 }
@@ -1445,25 +2245,24 @@ QMenu* MainWindow::createPopupMenu() {
   return filteredMenu;
 }
 
-std::optional<std::filesystem::path> MainWindow::createBackup() {
-  auto backupBasename =
+std::unique_ptr<Query> MainWindow::createBackupQuery() const {
+  auto backupName =
       "LOOT-backup-" +
       QDateTime::currentDateTime().toString("yyyyMMddThhmmss").toStdString();
 
-  auto sourceDir = state.getLootDataPath();
-  auto destDir = state.getLootDataPath() / "backups" / backupBasename;
-
-  loot::createBackup(sourceDir, destDir);
-
-  if (!std::filesystem::exists(destDir)) {
-    return std::nullopt;
-  }
+  const auto retention = state.getSettings().getBackupRetention();
 
-  auto zipPath = compressDirectory(destDir);
+  BackupRetentionPolicy policy;
+  policy.maxCount = static_cast<size_t>(retention.maxCount);
+  policy.maxTotalSize =
+      static_cast<uintmax_t>(retention.maxTotalSizeMiB) * 1024 * 1024;
+  policy.maxAge = std::chrono::hours(24 * retention.maxAgeDays);
 
-  std::filesystem::remove_all(destDir);
-
-  return zipPath;
+  return std::make_unique<CreateBackupQuery>(
+      state.getLootDataPath(),
+      std::move(backupName),
+      state.getSettings().getBackupCompressionLevel(),
+      policy);
 }
 
 void MainWindow::checkForAmbiguousLoadOrder() {
@@ -1528,46 +2327,102 @@ void MainWindow::on_actionSettings_triggered() {
 
 void MainWindow::on_actionUpdateMasterlists_triggered() {
   try {
+    flushUserMetadataSave();
+
     handleProgressUpdate(translate("Updating and parsing masterlist…"));
 
     const auto preludeSource = state.getSettings().getPreludeSource();
     const auto preludePath = state.getPreludePath();
 
     std::vector<Task*> tasks;
+    std::vector<Task*> tasksToStart;
 
     const auto preludeTask = new UpdatePreludeTask(state);
 
     tasks.push_back(preludeTask);
+    tasksToStart.push_back(preludeTask);
+
+    // Several games often share a masterlist source, so only download each
+    // source once and then copy the downloaded file for every other game that
+    // uses it. The copies report whether each game's masterlist changed.
+    std::map<std::string, std::pair<Task*, std::filesystem::path>>
+        downloadTasksBySource;
+    std::map<Task*, std::vector<Task*>> copyTasksByDownloadTask;
 
     for (const auto& settings : state.getSettings().getGameSettings()) {
       // Masterlist update assumes that the game folder exists, so ensure that.
       InitLootGameFolder(state.getLootDataPath(), settings);
 
+      const auto& source = settings.MasterlistSource();
+      const auto masterlistPath =
+          GetMasterlistPath(state.getLootDataPath(), settings);
+
+      const auto downloadIt = downloadTasksBySource.find(source);
+      if (isValidUrl(source) && downloadIt != downloadTasksBySource.end()) {
+        const auto& [downloadTask, downloadedPath] = downloadIt->second;
+        const auto task = new UpdateMasterlistTask(
+            settings.FolderName(), downloadedPath.u8string(), masterlistPath);
+
+        copyTasksByDownloadTask[downloadTask].push_back(task);
+        tasks.push_back(task);
+        continue;
+      }
+
       const auto task = new UpdateMasterlistTask(
           settings.FolderName(),
-          settings.MasterlistSource(),
-          GetMasterlistPath(state.getLootDataPath(), settings));
+          source,
+          masterlistPath,
+          state.getSettings().getSharedDownloadCachePath(),
+          state.getSettings().getDownloadMirrors(source));
+
+      if (isValidUrl(source)) {
+        downloadTasksBySource.emplace(source,
+                                      std::make_pair(task, masterlistPath));
+      }
 
       tasks.push_back(task);
+      tasksToStart.push_back(task);
+    }
+
+    for (const auto& [downloadTask, copyTasks] : copyTasksByDownloadTask) {
+      // Only copy the downloaded file if the download succeeded, as otherwise
+      // the file may be missing or out of date. If it failed, fail the copies
+      // with the same error so that every task still finishes and the failure
+      // is reported once all of them have.
+      taskFuture(downloadTask)
+          .then(this, [copyTasks = copyTasks](QFuture<QueryResult> future) {
+            try {
+              future.result();
+            } catch (const std::exception& e) {
+              for (const auto copyTask : copyTasks) {
+                emit copyTask->error(e.what());
+                copyTask->deleteLater();
+              }
+              return;
+            }
+
+            for (const auto copyTask : copyTasks) {
+              executeBackgroundTask(copyTask);
+            }
+          });
     }
 
     handleProgressUpdate(translate("Updating all masterlists…"));
 
-    auto whenAll = whenAllTasks(tasks)
-                       .then(this,
-                             [this](const QList<QFuture<QueryResult>> futures) {
-                               std::vector<QueryResult> results;
-                               for (const auto& future : futures) {
-                                 results.push_back(future.result());
-                               }
-
-                               handleMasterlistsUpdated(results);
-                             })
-                       .onFailed(this, [this](const std::exception& e) {
-                         handleError(e.what());
-                       });
-
-    executeConcurrentBackgroundTasks(tasks, whenAll);
+    whenAllTasks(tasks)
+        .then(this,
+              [this](const QList<QFuture<QueryResult>> futures) {
+                std::vector<QueryResult> results;
+                for (const auto& future : futures) {
+                  results.push_back(future.result());
+                }
+
+                handleMasterlistsUpdated(results);
+              })
+        .onFailed(this,
+                  [this](const std::exception& e) { handleError(e.what()); });
+
+    executeConcurrentBackgroundTasks(tasksToStart);
   } catch (const std::exception& e) {
     handleException(e);
   }
@@ -1575,30 +2430,109 @@ void MainWindow::on_actionUpdateMasterlists_triggered() {
 
 void MainWindow::on_actionBackupData_triggered() {
   try {
-    auto zipPath = createBackup();
+    handleProgressUpdate(translate("Backing up LOOT data…"));
 
-    if (zipPath.has_value()) {
-      auto zipPathString = zipPath.value().u8string();
-      auto link = "<pre><a href=\"file:" + zipPathString +
-                  "\" style=\"white-space: nowrap\">" + zipPathString +
-                  "</a></pre>";
-      auto message = fmt::format(
-          boost::locale::translate("Your LOOT data has been backed up to: {0}")
-              .str(),
-          link);
+    executeBackgroundQuery(
+        createBackupQuery(), &MainWindow::handleBackupCreated, nullptr);
+  } catch (const std::exception& e) {
+    handleException(e);
+  }
+}
 
-      QMessageBox::information(this, "LOOT", QString::fromStdString(message));
-    } else {
-      auto message = translate(
-          "No backup has been created as LOOT has no data to backup.");
+void MainWindow::on_actionExtractBackup_triggered() {
+  try {
+    const auto backupsDir = state.getLootDataPath() / "backups";
 
-      QMessageBox::information(this, "LOOT", message);
+    const auto manifestPath = QFileDialog::getOpenFileName(
+        this,
+        translate("Extract LOOT Data Backup"),
+        QString::fromStdString(backupsDir.u8string()),
+        translate("LOOT backups (*.toml)"));
+    if (manifestPath.isEmpty()) {
+      return;
     }
+
+    // Extract the backup next to its manifest instead of over LOOT's data, as
+    // LOOT would overwrite some of the restored files while it's running.
+    const auto manifest = std::filesystem::u8path(manifestPath.toStdString());
+    auto destDir = manifest;
+    destDir.replace_extension();
+
+    if (std::filesystem::exists(destDir)) {
+      throw std::runtime_error(destDir.u8string() + " already exists");
+    }
+
+    restoreIncrementalBackup(manifest, destDir);
+
+    auto destDirString = destDir.u8string();
+    auto link = "<pre><a href=\"file:" + destDirString +
+                "\" style=\"white-space: nowrap\">" + destDirString +
+                "</a></pre>";
+    auto message = fmt::format(
+        boost::locale::translate(
+            "The backup has been extracted to: {0}To restore it, quit LOOT "
+            "and copy the extracted files into the LOOT data folder.")
+            .str(),
+        link);
+
+    QMessageBox::information(this, "LOOT", QString::fromStdString(message));
   } catch (const std::exception& e) {
     handleException(e);
   }
 }
 
+bool MainWindow::handleInstanceRequest(const InstanceRequest& request) {
+  try {
+    if (isMinimized()) {
+      showNormal();
+    }
+    raise();
+    activateWindow();
+
+    // Don't interrupt anything that's in progress or discard unapplied
+    // changes.
+    if (!state.HasCurrentGame() || state.HasUnappliedChanges() ||
+        progressDialog->isVisible()) {
+      showNotification(
+          /* translators: Notification text. */
+          translate("LOOT is busy, so the request from another launch of "
+                    "LOOT was ignored."));
+      return false;
+    }
+
+    const auto& currentGameFolderName =
+        state.GetCurrentGame().GetSettings().FolderName();
+    if (!request.gameFolderName.empty() &&
+        request.gameFolderName != currentGameFolderName) {
+      const auto index = gameComboBox->findData(
+          QString::fromStdString(request.gameFolderName));
+      if (index < 0) {
+        showNotification(
+            /* translators: Notification text. */
+            translate("The game requested by another launch of LOOT is not "
+                      "installed."));
+        return false;
+      }
+
+      gameComboBox->setCurrentIndex(index);
+      on_gameComboBox_activated(index);
+
+      // The game's data is loaded in the background, so this is set after
+      // starting to change game.
+      autoSortAfterGameChange = request.autoSort;
+    } else if (request.autoSort) {
+      startForwardedAutoSort();
+    } else {
+      loadGame(false);
+    }
+
+    return true;
+  } catch (const std::exception& e) {
+    handleException(e);
+    return false;
+  }
+}
+
 void MainWindow::on_actionQuit_triggered() { this->close(); }
 
 void MainWindow::on_actionOpenGroupsEditor_triggered() {
@@ -1606,17 +2540,20 @@ void MainWindow::on_actionOpenGroupsEditor_triggered() {
     std::set<std::string> installedPluginGroups;
     for (const auto& plugin : pluginItemModel->getPluginItems()) {
       if (plugin.group.has_value()) {
-        installedPluginGroups.insert(plugin.group.value());
+        installedPluginGroups.insert(plugin.group.value().str());
       }
     }
 
     const auto groupNodePositions =
         LoadGroupNodePositions(state.GetCurrentGame().GroupNodePositionsPath());
 
-    groupsEditor->setGroups(state.GetCurrentGame().GetMasterlistGroups(),
-                            state.GetCurrentGame().GetUserGroups(),
+    const auto groupGraph = state.GetCurrentGame().GetGroupGraph();
+
+    groupsEditor->setGroups(groupGraph->GetMasterlistGroups(),
+                            groupGraph->GetUserGroups(),
                             installedPluginGroups,
-                            groupNodePositions);
+                            groupNodePositions,
+                            state.GetCurrentGame().GroupLayoutCachePath());
 
     groupsEditor->show();
   } catch (const std::exception& e) {
@@ -1642,11 +2579,25 @@ void MainWindow::on_actionCopyLoadOrder_triggered() {
 
 void MainWindow::on_actionCopyContent_triggered() {
   try {
-    auto content =
-        pluginItemModel->getGeneralInfo().getMarkdownContent() + "\n\n";
+    const auto generalInfoContent =
+        pluginItemModel->getGeneralInfo().getMarkdownContent();
+    const auto& pluginItems = pluginItemModel->getPluginItems();
+
+    // Build the content in a single buffer, as it may be large.
+    size_t size = generalInfoContent.size() + 2;
+    for (const auto& plugin : pluginItems) {
+      size += plugin.estimateMarkdownContentSize() + 2;
+    }
 
-    for (const auto& plugin : pluginItemModel->getPluginItems()) {
-      content += plugin.getMarkdownContent() + "\n\n";
+    std::string content;
+    content.reserve(size);
+
+    content += generalInfoContent;
+    content += "\n\n";
+
+    for (const auto& plugin : pluginItems) {
+      plugin.appendMarkdownContent(content);
+      content += "\n\n";
     }
 
     CopyToClipboard(content);
@@ -1662,6 +2613,7 @@ void MainWindow::on_actionFixAmbiguousLoadOrder_triggered() {
   try {
     auto loadOrder = state.GetCurrentGame().GetLoadOrder();
     state.GetCurrentGame().SetLoadOrder(loadOrder);
+    gameDataWatcher->acceptOwnChanges();
 
     showNotification(
         translate("The load order displayed by LOOT has been set."));
@@ -1676,16 +2628,83 @@ void MainWindow::on_actionFixAmbiguousLoadOrder_triggered() {
   }
 }
 
+void MainWindow::on_actionExportMetadata_triggered() {
+  try {
+    const auto filePath =
+        QFileDialog::getSaveFileName(this,
+                                     translate("Export Metadata"),
+                                     QString(),
+                                     translate("YAML files (*.yaml)"));
+    if (filePath.isEmpty()) {
+      return;
+    }
+
+    handleProgressUpdate(translate("Exporting metadata…"));
+
+    // Export the metadata for all installed plugins, as it's intended to be
+    // used for snapshotting a setup, not sharing a single plugin's metadata.
+    auto snapshot = state.GetCurrentGame().GetDataSnapshot();
+    auto loadOrder = snapshot->GetLoadOrder();
+    std::unique_ptr<Query> query = std::make_unique<ExportMetadataQuery>(
+        std::move(snapshot),
+        std::move(loadOrder),
+        std::filesystem::u8path(filePath.toStdString()));
+
+    executeBackgroundQuery(
+        std::move(query), &MainWindow::handleMetadataExported, nullptr);
+  } catch (const std::exception& e) {
+    handleException(e);
+  }
+}
+
 void MainWindow::on_actionRefreshContent_triggered() {
   try {
+    startPerformanceTiming(PerformanceMetric::refresh);
     loadGame(false);
   } catch (const std::exception& e) {
     handleException(e);
   }
 }
 
+void MainWindow::on_actionRankPluginsByOverlaps_toggled(bool checked) {
+  try {
+    if (!checked) {
+      // Go back to displaying plugins in their load order.
+      proxyModel->sort(-1);
+      sidebarPluginsView->hideColumn(PluginItemModel::SIDEBAR_OVERLAPS_COLUMN);
+      return;
+    }
+
+    sidebarPluginsView->showColumn(PluginItemModel::SIDEBAR_OVERLAPS_COLUMN);
+    proxyModel->sort(PluginItemModel::SIDEBAR_OVERLAPS_COLUMN,
+                     Qt::DescendingOrder);
+
+    updateOverlapCounts();
+  } catch (const std::exception& e) {
+    handleException(e);
+  }
+}
+
 void MainWindow::on_actionRedatePlugins_triggered() {
   try {
+    // Work out which plugins would be redated first, so that the user can
+    // see how many would be affected before anything is changed.
+    const auto redates = state.GetCurrentGame().GetPluginRedates();
+
+    if (redates.empty()) {
+      showNotification(
+          /* translators: Notification text. */
+          translate("No plugins need to be redated."));
+      return;
+    }
+
+    const auto redateCount = QString::fromStdString(
+        fmt::format(boost::locale::translate("{0} plugin will be redated.",
+                                             "{0} plugins will be redated.",
+                                             redates.size())
+                        .str(),
+                    redates.size()));
+
     auto button = QMessageBox::question(
         this,
         /* translators: Title of a dialog box. */
@@ -1695,12 +2714,14 @@ void MainWindow::on_actionRedatePlugins_triggered() {
             "may "
             "set the load order it uses. A side-effect is that any subscribed "
             "Steam Workshop mods will be re-downloaded by Steam (this does not "
-            "affect Skyrim Special Edition). Do you wish to continue?"),
+            "affect Skyrim Special Edition). Do you wish to continue?") +
+            "\n\n" + redateCount,
         QMessageBox::StandardButton::Yes | QMessageBox::StandardButton::No,
         QMessageBox::StandardButton::No);
 
     if (button == QMessageBox::StandardButton::Yes) {
-      state.GetCurrentGame().RedatePlugins();
+      state.GetCurrentGame().ApplyPluginRedates(redates);
+      gameDataWatcher->acceptOwnChanges();
       showNotification(
           /* translators: Notification text. */
           translate("Plugins were successfully redated."));
@@ -1724,46 +2745,15 @@ void MainWindow::on_actionClearAllUserMetadata_triggered() {
       return;
     }
 
-    ClearAllMetadataQuery query(state.GetCurrentGame(),
-                                state.getSettings().getLanguage());
+    handleProgressUpdate(translate("Clearing all user-added metadata…"));
 
-    auto result = query.executeLogic();
-
-    // Clearing all user metadata can clear general messages (though
-    // user-defined general messages aren't editable through the LOOT GUI),
-    // change the known Bash Tags (though again they aren't editable in the GUI)
-    // and change plugin metadata that may be displayed in the sidebar or on
-    // cards. However, only plugins that had user metadata are affected, which
-    // is probably a small fraction of the total number, so doing a full refresh
-    // of the game-related UI would be overkill.
+    // Clearing the metadata saves the userlist and re-derives the affected
+    // plugins' items, which can take a while for a large userlist.
+    std::unique_ptr<Query> query = std::make_unique<ClearAllMetadataQuery>(
+        state.GetCurrentGame(), state.getSettings().getLanguage());
 
-    filtersWidget->setGroups(GetGroupNames(state.GetCurrentGame()));
-
-    pluginEditorWidget->setBashTagCompletions(
-        state.GetCurrentGame().GetKnownBashTags());
-
-    updateGeneralMessages();
-
-    // These plugin items are only those that had their user metadata removed.
-    auto pluginItems = std::get<PluginItems>(result);
-
-    // For each item, find its existing index in the model and update its data.
-    // The sidebar item and card will be updated by handling the resulting
-    // dataChanged signal.
-    auto nameToRowMap = pluginItemModel->getPluginNameToRowMap();
-    for (const auto& item : pluginItems) {
-      const auto it = nameToRowMap.find(item.name);
-      if (it == nameToRowMap.end()) {
-        throw std::runtime_error(std::string("Could not find plugin named \"") +
-                                 item.name + "\" in the plugin item model.");
-      }
-
-      // It doesn't matter which index column is used, it's the same data.
-      const auto index = pluginItemModel->index(it->second, 0);
-      pluginItemModel->setData(index, QVariant::fromValue(item), RawDataRole);
-    }
-
-    showNotification(translate("All user-added metadata has been cleared."));
+    executeBackgroundQuery(
+        std::move(query), &MainWindow::handleUserMetadataCleared, nullptr);
   } catch (const std::exception& e) {
     handleException(e);
   }
@@ -1824,25 +2814,39 @@ void MainWindow::on_actionEditMetadata_triggered() {
 
 void MainWindow::on_actionCopyMetadata_triggered() {
   try {
-    const auto selectedPluginName = getSelectedPlugin().name;
+    const auto selectedPlugins = getSelectedPluginItems();
+    const auto dataSnapshot = state.GetCurrentGame().GetDataSnapshot();
 
     const auto text =
-        GetMetadataAsBBCodeYaml(state.GetCurrentGame(), selectedPluginName);
+        joinPluginTexts(selectedPlugins, [&](const PluginItem& plugin) {
+          return GetMetadataAsBBCodeYaml(*dataSnapshot, plugin.name);
+        });
 
     CopyToClipboard(text);
 
-    const auto logger = getLogger();
+    const auto logger = getLogger(LogCategory::ui);
     if (logger) {
-      logger->debug("Exported userlist metadata text for \"{}\": {}",
-                    selectedPluginName,
+      logger->debug("Exported userlist metadata text for {} plugins: {}",
+                    selectedPlugins.size(),
                     text);
     }
 
-    const auto message = fmt::format(
-        boost::locale::translate(
-            "The metadata for \"{0}\" has been copied to the clipboard.")
-            .str(),
-        selectedPluginName);
+    const auto message =
+        selectedPlugins.size() == 1
+            ? fmt::format(boost::locale::translate(
+                              "The metadata for \"{0}\" has been copied to "
+                              "the clipboard.")
+                              .str(),
+                          selectedPlugins.front()->name)
+            : fmt::format(
+                  boost::locale::translate(
+                      "The metadata for {0} plugin has been copied to the "
+                      "clipboard.",
+                      "The metadata for {0} plugins has been copied to the "
+                      "clipboard.",
+                      selectedPlugins.size())
+                      .str(),
+                  selectedPlugins.size());
 
     showNotification(QString::fromStdString(message));
   } catch (const std::exception& e) {
@@ -1870,16 +2874,30 @@ void MainWindow::on_actionCopyPluginName_triggered() {
 
 void MainWindow::on_actionCopyCardContent_triggered() {
   try {
-    auto selectedPlugin = getSelectedPlugin();
-    auto content = selectedPlugin.getMarkdownContent();
+    const auto selectedPlugins = getSelectedPluginItems();
+    const auto content =
+        joinPluginTexts(selectedPlugins, [](const PluginItem& plugin) {
+          return plugin.getMarkdownContent();
+        });
 
     CopyToClipboard(content);
 
-    auto text = fmt::format(
-        boost::locale::translate(
-            "The card content for \"{0}\" has been copied to the clipboard.")
-            .str(),
-        selectedPlugin.name);
+    const auto text =
+        selectedPlugins.size() == 1
+            ? fmt::format(boost::locale::translate(
+                              "The card content for \"{0}\" has been copied "
+                              "to the clipboard.")
+                              .str(),
+                          selectedPlugins.front()->name)
+            : fmt::format(
+                  boost::locale::translate(
+                      "The card content for {0} plugin has been copied to "
+                      "the clipboard.",
+                      "The card content for {0} plugins has been copied to "
+                      "the clipboard.",
+                      selectedPlugins.size())
+                      .str(),
+                  selectedPlugins.size());
 
     showNotification(QString::fromStdString(text));
   } catch (const std::exception& e) {
@@ -1913,21 +2931,13 @@ void MainWindow::on_actionClearMetadata_triggered() {
                                    selectedPluginName);
 
     auto result = query.executeLogic();
+    gameDataWatcher->acceptOwnChanges();
 
     // The result is the changed plugin's derived metadata. Update the
-    // model's data and also the message counts.
-
-    auto newPluginItem = std::get<PluginItem>(result);
-
-    for (int i = 1; i < pluginItemModel->rowCount(); i += 1) {
-      const auto index = pluginItemModel->index(i, 0);
-      auto pluginItem = index.data(RawDataRole).value<PluginItem>();
-
-      if (pluginItem.name == selectedPluginName) {
-        pluginItemModel->setData(
-            index, QVariant::fromValue(newPluginItem), RawDataRole);
-        break;
-      }
+    // model's data, which also updates the message counts.
+    if (std::holds_alternative<PluginItem>(result)) {
+      pluginItemModel->replacePluginItem(
+          std::move(std::get<PluginItem>(result)));
     }
 
     auto notificationText =
@@ -1944,7 +2954,7 @@ void MainWindow::on_actionClearMetadata_triggered() {
 
 void MainWindow::on_actionViewDocs_triggered() {
   try {
-    const auto logger = getLogger();
+    const auto logger = getLogger(LogCategory::ui);
     if (logger) {
       logger->trace("Opening LOOT's readme.");
     }
@@ -1969,7 +2979,7 @@ void MainWindow::on_actionViewDocs_triggered() {
 
 void MainWindow::on_actionOpenFAQs_triggered() {
   try {
-    const auto logger = getLogger();
+    const auto logger = getLogger(LogCategory::ui);
     if (logger) {
       logger->trace("Opening LOOT's FAQs.");
     }
@@ -1983,7 +2993,7 @@ void MainWindow::on_actionOpenFAQs_triggered() {
 
 void MainWindow::on_actionOpenLOOTDataFolder_triggered() {
   try {
-    const auto logger = getLogger();
+    const auto logger = getLogger(LogCategory::ui);
     if (logger) {
       logger->trace("Opening LOOT's local appdata folder.");
     }
@@ -1994,6 +3004,15 @@ void MainWindow::on_actionOpenLOOTDataFolder_triggered() {
   }
 }
 
+void MainWindow::on_actionViewDiagnostics_triggered() {
+  try {
+    diagnosticsDialog->refresh();
+    diagnosticsDialog->show();
+  } catch (const std::exception& e) {
+    handleException(e);
+  }
+}
+
 void MainWindow::on_actionJoinDiscordServer_triggered() {
   QDesktopServices::openUrl(QUrl("https://loot.github.io/discord/"));
 }
@@ -2058,6 +3077,28 @@ void MainWindow::on_gameComboBox_activated(int index) {
       return;
     }
 
+    gameDataWatcher->unwatch();
+
+    // Any queries still running apply to the previous game.
+    abandonRunningQueries();
+
+    autoSortAfterGameChange = false;
+
+    if (state.HasCurrentGame()) {
+      state.getSettings().storePreviousGame(
+          state.GetCurrentGame().GetSettings().FolderName());
+    }
+
+    try {
+      savePluginItemsSnapshot();
+    } catch (const std::exception& e) {
+      auto logger = getLogger(LogCategory::ui);
+      if (logger) {
+        logger->error("Failed to save the plugin items snapshot: {}",
+                      e.what());
+      }
+    }
+
     auto progressUpdater = new ProgressUpdater();
 
     // This lambda will run from the worker thread.
@@ -2065,11 +3106,13 @@ void MainWindow::on_gameComboBox_activated(int index) {
       emit progressUpdater->progressUpdate(QString::fromStdString(message));
     };
 
-    std::unique_ptr<Query> query =
-        std::make_unique<ChangeGameQuery>(state,
-                                          state.getSettings().getLanguage(),
-                                          folderName,
-                                          sendProgressUpdate);
+    std::unique_ptr<Query> query = std::make_unique<ChangeGameQuery>(
+        state,
+        state.getSettings().getLanguage(),
+        folderName,
+        pluginItemModel->getPluginItems(),
+        static_cast<size_t>(state.getSettings().getMaxResidentGames()),
+        sendProgressUpdate);
 
     executeBackgroundQuery(
         std::move(query), &MainWindow::handleGameChanged, progressUpdater);
@@ -2095,6 +3138,7 @@ void MainWindow::on_actionApplySort_triggered() {
 
     try {
       query.executeLogic();
+      gameDataWatcher->acceptOwnChanges();
 
       exitSortingState();
 
@@ -2117,23 +3161,17 @@ void MainWindow::on_actionDiscardSort_triggered() {
 
     auto result = query.executeLogic();
 
-    auto pluginItems = pluginItemModel->getPluginItems();
+    const auto& pluginItems = pluginItemModel->getPluginItems();
 
     std::vector<PluginItem> newPluginItems;
     newPluginItems.reserve(pluginItems.size());
-    for (const auto& pluginPair : std::get<CancelSortResult>(result)) {
-      auto pluginName = pluginPair.first;
-
-      auto it = std::find_if(pluginItems.cbegin(),
-                             pluginItems.cend(),
-                             [&](const auto& pluginItem) {
-                               return pluginItem.name == pluginName;
-                             });
+    for (const auto& pluginPair : *std::get<CancelSortResult>(result)) {
+      const auto row = pluginItemModel->getPluginRow(pluginPair.first);
 
-      if (it != pluginItems.end()) {
-        auto newPluginItem = *it;
+      if (row.has_value()) {
+        auto newPluginItem = pluginItems.at(row.value() - 1);
         newPluginItem.loadOrderIndex = pluginPair.second;
-        newPluginItems.push_back(newPluginItem);
+        newPluginItems.push_back(std::move(newPluginItem));
       }
     }
 
@@ -2153,28 +3191,29 @@ void MainWindow::on_actionDiscardSort_triggered() {
 
 void MainWindow::on_actionUpdateMasterlist_triggered() {
   try {
+    flushUserMetadataSave();
+
     handleProgressUpdate(translate("Updating and parsing masterlist…"));
+    startPerformanceTiming(PerformanceMetric::masterlistUpdate);
 
     const auto preludeTask = new UpdatePreludeTask(state);
     const auto masterlistTask =
-        new UpdateMasterlistTask(state.GetCurrentGame());
+        new UpdateMasterlistTask(state.GetCurrentGame(), state.getSettings());
 
     const std::vector<Task*> tasks{preludeTask, masterlistTask};
 
-    auto whenAll =
-        whenAllTasks(tasks)
-            .then(this,
-                  [this](const QList<QFuture<QueryResult>> futures) {
-                    auto preludeResult = futures[0].result();
-                    auto masterlistResult = futures[1].result();
-
-                    handleMasterlistUpdated({preludeResult, masterlistResult});
-                  })
-            .onFailed(this, [this](const std::exception& e) {
-              handleError(e.what());
-            });
+    whenAllTasks(tasks)
+        .then(this,
+              [this](const QList<QFuture<QueryResult>> futures) {
+                auto preludeResult = futures[0].result();
+                auto masterlistResult = futures[1].result();
+
+                handleMasterlistUpdated({preludeResult, masterlistResult});
+              })
+        .onFailed(this,
+                  [this](const std::exception& e) { handleError(e.what()); });
 
-    executeConcurrentBackgroundTasks(tasks, whenAll);
+    executeConcurrentBackgroundTasks(tasks);
   } catch (const std::exception& e) {
     handleException(e);
   }
@@ -2193,7 +3232,13 @@ void MainWindow::on_sidebarPluginsView_customContextMenuRequested(
     return;
   }
 
-  sidebarPluginsView->selectRow(itemIndex.row());
+  // Keep a multiple selection that the clicked plugin is part of, so that the
+  // copy actions can act on all of the selected plugins.
+  if (!sidebarPluginsView->selectionModel()->isSelected(itemIndex)) {
+    sidebarPluginsView->selectRow(itemIndex.row());
+  }
+  sidebarPluginsView->selectionModel()->setCurrentIndex(
+      itemIndex, QItemSelectionModel::NoUpdate);
 
   // For some reason mapToGlobal() doesn't include the height of the table's
   // horizontal header, so add that so that the menu gets displayed in the
@@ -2260,7 +3305,13 @@ void MainWindow::on_pluginCardsView_customContextMenuRequested(
     return;
   }
 
-  sidebarPluginsView->selectRow(itemIndex.row());
+  const auto sidebarIndex =
+      itemIndex.siblingAtColumn(PluginItemModel::SIDEBAR_NAME_COLUMN);
+  if (!sidebarPluginsView->selectionModel()->isSelected(sidebarIndex)) {
+    sidebarPluginsView->selectRow(itemIndex.row());
+  }
+  sidebarPluginsView->selectionModel()->setCurrentIndex(
+      sidebarIndex, QItemSelectionModel::NoUpdate);
 
   const auto globalPos = pluginCardsView->mapToGlobal(position);
 
@@ -2274,16 +3325,28 @@ void MainWindow::on_pluginItemModel_dataChanged(const QModelIndex& topLeft,
     return;
   }
 
+  if (roles == QList<int>{SearchResultRole}) {
+    // Search results don't affect card sizes, and rendered cards are cached
+    // for each search state, so the view only needs to repaint the cards.
+    return;
+  }
+
   cardSizingCache.update(topLeft, bottomRight);
 
-  if (roles.isEmpty() || roles.contains(CardContentFiltersRole)) {
+  const auto cardDelegate =
+      qobject_cast<CardDelegate*>(pluginCardsView->itemDelegate());
+  if (cardDelegate) {
+    cardDelegate->invalidateRenderedCards(topLeft, bottomRight);
+  }
+
+  // Card content filter changes are signalled for each run of affected rows,
+  // so they're handled once all the runs have been signalled.
+  if (roles.isEmpty()) {
     proxyModel->invalidate();
   }
 
-  if (roles.isEmpty() || roles.contains(RawDataRole) ||
-      roles.contains(CardContentFiltersRole)) {
-    updateCounts(pluginItemModel->getGeneralMessages(),
-                 pluginItemModel->getPluginItems());
+  if (roles.isEmpty() || roles.contains(RawDataRole)) {
+    updateCounts();
     refreshSearch();
   }
 
@@ -2302,33 +3365,78 @@ void MainWindow::on_pluginItemModel_rowsInserted(const QModelIndex&,
                                                  int first,
                                                  int last) {
   cardSizingCache.update(pluginItemModel, first, last);
+
+  // Inserted rows may be for plugins that had rows with different content
+  // before they were removed.
+  const auto cardDelegate =
+      qobject_cast<CardDelegate*>(pluginCardsView->itemDelegate());
+  if (cardDelegate) {
+    cardDelegate->clearRenderedCards();
+
+    // Until the inserted rows' cards are created, their sizes are estimated,
+    // so do that for all of them at once on worker threads instead of one by
+    // one as the view lays them out. Row 0 is the general information card.
+    const auto& pluginItems = pluginItemModel->getPluginItems();
+    const auto firstItem = static_cast<size_t>(std::max(first, 1) - 1);
+    const auto endItem =
+        std::min(static_cast<size_t>(last), pluginItems.size());
+    if (firstItem < endItem) {
+      const std::vector<PluginItem> insertedItems(
+          pluginItems.begin() + firstItem, pluginItems.begin() + endItem);
+      cardDelegate->estimateSizes(
+          insertedItems,
+          pluginItemModel->getCardContentFiltersState(),
+          pluginCardsView->viewport()->width());
+    }
+  }
 }
 
-void MainWindow::on_pluginEditorWidget_accepted(PluginMetadata userMetadata) {
+void MainWindow::on_pluginItemModel_layoutChanged(
+    const QList<QPersistentModelIndex>&,
+    QAbstractItemModel::LayoutChangeHint) {
+  // Plugins have been moved to different rows, so each row's cached card may
+  // have changed and the filters' plugin name list needs to be given the new
+  // order. The metadata editor's completions are sorted by name, so moving
+  // plugins doesn't change them.
+  cardSizingCache.update(pluginItemModel);
+
+  filtersWidget->setPlugins(pluginItemModel->getPluginNames());
+}
+
+void MainWindow::on_pluginEditorWidget_accepted(UserMetadataChanges changes) {
   try {
-    auto logger = getLogger();
-    auto pluginName = userMetadata.GetName();
+    auto logger = getLogger(LogCategory::ui);
+    const auto pluginName = changes.pluginName;
 
-    // Erase any existing userlist entry.
-    if (logger) {
-      logger->trace("Erasing the existing userlist entry.");
-    }
-    state.GetCurrentGame().ClearUserMetadata(pluginName);
+    pluginItemModel->setEditorPluginName(std::nullopt);
 
-    // Add a new userlist entry if necessary.
-    if (!userMetadata.HasNameOnly()) {
+    if (changes.isEmpty()) {
       if (logger) {
-        logger->trace("Adding new metadata to new userlist entry.");
+        logger->trace("No user metadata was edited for {}.", pluginName);
       }
-      state.GetCurrentGame().AddUserMetadata(userMetadata);
-    }
+    } else {
+      auto& game = state.GetCurrentGame();
+      const auto userMetadata =
+          ApplyUserMetadataChanges(game.GetUserMetadata(pluginName), changes);
 
-    // Save edited userlist.
-    state.GetCurrentGame().SaveUserMetadata();
+      // Erase any existing userlist entry.
+      if (logger) {
+        logger->trace("Erasing the existing userlist entry.");
+      }
+      game.ClearUserMetadata(pluginName);
 
-    pluginItemModel->setEditorPluginName(std::nullopt);
+      // Add a new userlist entry if necessary.
+      if (!userMetadata.HasNameOnly()) {
+        if (logger) {
+          logger->trace("Adding new metadata to new userlist entry.");
+        }
+        game.AddUserMetadata(userMetadata);
+      }
 
-    refreshPluginRawData(pluginName);
+      scheduleUserMetadataSave();
+
+      refreshPluginRawData({pluginName});
+    }
 
     state.DecrementUnappliedChangeCounter();
 
@@ -2363,12 +3471,26 @@ void MainWindow::on_filtersWidget_overlapFilterChanged(
       return;
     }
 
+    // If the plugins that are displayed have all been indexed, there's no
+    // need to reload them.
+    auto indexedOverlappingPluginNames =
+        getIndexedOverlappingPluginNames(state.GetCurrentGame(),
+                                         pluginItemModel->getPluginItems(),
+                                         targetPluginName.value());
+    if (indexedOverlappingPluginNames.has_value()) {
+      setFiltersState(filtersWidget->getPluginFiltersState(),
+                      std::move(indexedOverlappingPluginNames.value()));
+      return;
+    }
+
     handleProgressUpdate(translate("Identifying overlapping plugins…"));
+    startPerformanceTiming(PerformanceMetric::overlapQuery);
 
     std::unique_ptr<Query> query = std::make_unique<GetOverlappingPluginsQuery>(
         state.GetCurrentGame(),
         state.getSettings().getLanguage(),
-        targetPluginName.value());
+        targetPluginName.value(),
+        state.getSettings().isPluginRecordDataReleaseEnabled());
 
     executeBackgroundQuery(
         std::move(query), &MainWindow::handleOverlapFilterChecked, nullptr);
@@ -2379,7 +3501,19 @@ void MainWindow::on_filtersWidget_overlapFilterChanged(
 
 void MainWindow::on_filtersWidget_cardContentFilterChanged(
     CardContentFiltersState filtersState) {
+  // Only the filters that hide messages can affect which plugins are
+  // filtered out, by hiding messageless plugins.
+  const auto messageFiltersChanged = !hideSameMessages(
+      pluginItemModel->getCardContentFiltersState(), filtersState);
+
   pluginItemModel->setCardContentFiltersState(std::move(filtersState));
+
+  if (messageFiltersChanged) {
+    proxyModel->invalidate();
+  }
+
+  updateCounts();
+  refreshSearch();
 }
 
 void MainWindow::on_settingsDialog_accepted() {
@@ -2395,6 +3529,8 @@ void MainWindow::on_settingsDialog_accepted() {
     if (state.getSettings().getTheme() != currentTheme) {
       applyTheme();
     }
+
+    updateGameDataWatcher();
   } catch (const std::exception& e) {
     handleException(e);
   }
@@ -2403,7 +3539,9 @@ void MainWindow::on_settingsDialog_accepted() {
 void MainWindow::on_groupsEditor_accepted() {
   try {
     state.GetCurrentGame().SetUserGroups(groupsEditor->getUserGroups());
+    updateGroups();
 
+    std::vector<std::string> changedPluginNames;
     for (const auto& [pluginName, groupName] :
          groupsEditor->getNewPluginGroups()) {
       // Update the plugin's group in user metadata.
@@ -2418,11 +3556,13 @@ void MainWindow::on_groupsEditor_accepted() {
         state.GetCurrentGame().AddUserMetadata(metadata);
       }
 
-      // Now update the plugin in the UI's plugin item model.
-      refreshPluginRawData(pluginName);
+      changedPluginNames.push_back(pluginName);
     }
 
-    state.GetCurrentGame().SaveUserMetadata();
+    // Now update the plugins in the UI's plugin item model.
+    refreshPluginRawData(changedPluginNames);
+
+    scheduleUserMetadataSave();
 
     SaveGroupNodePositions(state.GetCurrentGame().GroupNodePositionsPath(),
                            groupsEditor->getNodePositions());
@@ -2431,6 +3571,17 @@ void MainWindow::on_groupsEditor_accepted() {
   }
 }
 
+void MainWindow::on_userMetadataSaveTimer_timeout() {
+  try {
+    if (state.HasCurrentGame()) {
+      state.GetCurrentGame().SaveUserMetadata();
+      gameDataWatcher->acceptOwnChanges();
+    }
+  } catch (const std::exception& e) {
+    handleException(e);
+  }
+}
+
 void MainWindow::on_searchDialog_finished() { searchDialog->reset(); }
 
 void MainWindow::on_searchDialog_textChanged(const QVariant& text) {
@@ -2440,7 +3591,9 @@ void MainWindow::on_searchDialog_textChanged(const QVariant& text) {
        text.toRegularExpression().pattern().isEmpty());
 
   if (isEmpty) {
-    proxyModel->clearSearchResults();
+    cardSearch->cancel();
+    const auto [firstVisibleIndex, lastVisibleIndex] = getVisibleCardIndexes();
+    proxyModel->clearSearchResults(firstVisibleIndex, lastVisibleIndex);
     return;
   }
 
@@ -2449,18 +3602,39 @@ void MainWindow::on_searchDialog_textChanged(const QVariant& text) {
     // Do nothing if given an invalid regex.
   }
 
-  const auto flags = text.userType() == QMetaType::QRegularExpression
-                         ? Qt::MatchRegularExpression | Qt::MatchWrap
-                         : Qt::MatchContains | Qt::MatchWrap;
+  // Only visible cards are searched, in the order they're displayed.
+  std::vector<int> rows;
+  for (int row = 1; row < proxyModel->rowCount(); row += 1) {
+    const auto proxyIndex =
+        proxyModel->index(row, PluginItemModel::CARDS_COLUMN);
+    rows.push_back(proxyModel->mapToSource(proxyIndex).row());
+  }
 
-  auto results =
-      proxyModel->match(proxyModel->index(0, PluginItemModel::CARDS_COLUMN),
-                        ContentSearchRole,
-                        text,
-                        -1,
-                        flags);
+  cardSearch->search(
+      text, std::move(rows), pluginItemModel->getContentSearchTexts());
+}
 
-  proxyModel->setSearchResults(results);
+void MainWindow::on_cardSearch_searchFinished(
+    const std::vector<int>& resultRows,
+    const ContentSearchTexts& contentTexts) {
+  if (contentTexts != pluginItemModel->getContentSearchTexts()) {
+    // The cards changed while they were being searched.
+    refreshSearch();
+    return;
+  }
+
+  QModelIndexList results;
+  for (const auto row : resultRows) {
+    const auto sourceIndex =
+        pluginItemModel->index(row, PluginItemModel::CARDS_COLUMN);
+    const auto proxyIndex = proxyModel->mapFromSource(sourceIndex);
+    if (proxyIndex.isValid()) {
+      results.push_back(proxyIndex);
+    }
+  }
+
+  const auto [firstVisibleIndex, lastVisibleIndex] = getVisibleCardIndexes();
+  proxyModel->setSearchResults(results, firstVisibleIndex, lastVisibleIndex);
   searchDialog->setSearchResults(results.size());
 }
 
@@ -2471,19 +3645,63 @@ void MainWindow::on_searchDialog_currentResultChanged(size_t resultIndex) {
   pluginCardsView->scrollTo(proxyIndex, QAbstractItemView::PositionAtTop);
 }
 
+void MainWindow::on_gameDataWatcher_gameDataChanged() {
+  try {
+    // Don't change the game's data while it's being used by something else,
+    // or while there are unapplied changes that a refresh would discard.
+    if (!state.HasCurrentGame() || state.HasUnappliedChanges() ||
+        progressDialog->isVisible()) {
+      gameDataWatcher->deferChanges();
+      return;
+    }
+
+    auto changes = gameDataWatcher->takeChanges();
+    if (changes.IsEmpty()) {
+      return;
+    }
+
+    // Show the progress dialog immediately so that nothing else can be
+    // started while the game's data is being refreshed.
+    handleProgressUpdate(translate("Refreshing changed game data…"));
+
+    auto progressUpdater = new ProgressUpdater();
+
+    // This lambda will run from the worker thread.
+    auto sendProgressUpdate = [progressUpdater](std::string message) {
+      emit progressUpdater->progressUpdate(QString::fromStdString(message));
+    };
+
+    std::unique_ptr<Query> query = std::make_unique<RefreshGameDataQuery>(
+        state.GetCurrentGame(),
+        state.getSettings().getLanguage(),
+        std::move(changes),
+        sendProgressUpdate);
+
+    executeBackgroundQuery(std::move(query),
+                           &MainWindow::handleWatchedGameDataRefreshed,
+                           progressUpdater);
+  } catch (const std::exception& e) {
+    handleException(e);
+  }
+}
+
 void MainWindow::handleGameChanged(QueryResult result) {
   try {
-    filtersWidget->setGameId(state.GetCurrentGame().GetSettings().Id());
     filtersWidget->resetOverlapAndGroupsFilters();
     disablePluginActions();
 
-    handleGameDataLoaded(result);
+    handleGameDataLoaded(std::move(result), [this]() {
+      updateSidebarColumnWidths();
 
-    updateSidebarColumnWidths();
+      // Perform ambiguous load order check because load order state was
+      // refreshed when loading the new game's data.
+      checkForAmbiguousLoadOrder();
 
-    // Perform ambiguous load order check because load order state was refreshed
-    // when loading the new game's data.
-    checkForAmbiguousLoadOrder();
+      if (autoSortAfterGameChange) {
+        autoSortAfterGameChange = false;
+        startForwardedAutoSort();
+      }
+    });
   } catch (const std::exception& e) {
     handleException(e);
   }
@@ -2491,38 +3709,80 @@ void MainWindow::handleGameChanged(QueryResult result) {
 
 void MainWindow::handleRefreshGameDataLoaded(QueryResult result) {
   try {
-    handleGameDataLoaded(result);
+    handleGameDataLoaded(std::move(result), [this]() {
+      // Perform ambiguous load order check because load order state was
+      // refreshed when refreshing game data.
+      checkForAmbiguousLoadOrder();
 
-    // Perform ambiguous load order check because load order state was refreshed
-    // when refreshing game data.
-    checkForAmbiguousLoadOrder();
+      finishPerformanceTiming(PerformanceMetric::refresh);
+    });
   } catch (const std::exception& e) {
     handleException(e);
   }
 }
 
-void MainWindow::handleStartupGameDataLoaded(QueryResult result) {
+void MainWindow::handleWatchedGameDataRefreshed(QueryResult result) {
   try {
-    handleGameDataLoaded(result);
-
-    if (state.getSettings().isAutoSortEnabled()) {
-      if (hasErrorMessages()) {
-        state.GetCurrentGame().AppendMessage(CreatePlainTextSourcedMessage(
-            MessageType::error,
-            MessageSource::autoSortCancellation,
-            boost::locale::translate(
-                "Auto-sort has been cancelled as there is at "
-                "least one error message displayed.")));
-
-        updateGeneralMessages();
-      } else {
-        sortPlugins(true);
+    auto [pluginItems, isComplete] =
+        std::get<RefreshGameDataResult>(std::move(result));
+
+    if (isComplete) {
+      handleRefreshGameDataLoaded(QueryResult(std::move(pluginItems)));
+      return;
+    }
+
+    progressDialog->reset();
+
+    // Only the plugins that changed have been remapped, so update their
+    // existing rows in the model.
+    for (auto& item : pluginItems) {
+      const auto name = item.name;
+      if (!pluginItemModel->replacePluginItem(std::move(item))) {
+        throw std::runtime_error(std::string("Could not find plugin named \"") +
+                                 name + "\" in the plugin item model.");
       }
     }
 
-    // Perform ambiguous load order check because load order state was refreshed
-    // when loading game data.
-    checkForAmbiguousLoadOrder();
+    updatePluginDependents();
+
+    updateGeneralMessages();
+  } catch (const std::exception& e) {
+    handleException(e);
+  }
+}
+
+void MainWindow::handleStartupGameDataLoaded(QueryResult result) {
+  try {
+    handleGameDataLoaded(std::move(result), [this]() {
+      if (state.getSettings().isAutoSortEnabled()) {
+        if (hasErrorMessages()) {
+          state.GetCurrentGame().AppendMessage(CreatePlainTextSourcedMessage(
+              MessageType::error,
+              MessageSource::autoSortCancellation,
+              boost::locale::translate(
+                  "Auto-sort has been cancelled as there is at "
+                  "least one error message displayed.")));
+
+          updateGeneralMessages();
+        } else {
+          sortPlugins(true);
+        }
+      } else if (state.getSettings().isSpeculativeSortEnabled()) {
+        precomputeSortResult();
+      }
+
+      startupScheduler->schedule(StartupPhase::idle, [this]() {
+        try {
+          preloadPreviousGame();
+        } catch (const std::exception& e) {
+          handleException(e);
+        }
+      });
+
+      // Perform ambiguous load order check because load order state was
+      // refreshed when loading game data.
+      checkForAmbiguousLoadOrder();
+    });
   } catch (const std::exception& e) {
     handleException(e);
   }
@@ -2530,7 +3790,7 @@ void MainWindow::handleStartupGameDataLoaded(QueryResult result) {
 
 void MainWindow::handlePluginsManualSorted(QueryResult result) {
   try {
-    const auto loadOrderChanged = handlePluginsSorted(result);
+    const auto loadOrderChanged = handlePluginsSorted(std::move(result));
 
     if (!loadOrderChanged) {
       // Perform ambiguous load order check because load order state was
@@ -2544,13 +3804,18 @@ void MainWindow::handlePluginsManualSorted(QueryResult result) {
 
 void MainWindow::handlePluginsAutoSorted(QueryResult result) {
   try {
-    handlePluginsSorted(result);
+    handlePluginsSorted(std::move(result));
 
     if (actionApplySort->isVisible()) {
       actionApplySort->trigger();
     }
 
-    if (!hasErrorMessages()) {
+    // The launch that requested a forwarded auto-sort has already exited, so
+    // keep this instance open for the next request.
+    const auto wasForwarded = isForwardedAutoSort;
+    isForwardedAutoSort = false;
+
+    if (!wasForwarded && !hasErrorMessages()) {
       on_actionQuit_triggered();
     }
   } catch (const std::exception& e) {
@@ -2560,10 +3825,14 @@ void MainWindow::handlePluginsAutoSorted(QueryResult result) {
 
 void MainWindow::handleMasterlistUpdated(std::vector<QueryResult> results) {
   try {
+    finishPerformanceTiming(PerformanceMetric::masterlistUpdate);
+
     if (results.empty()) {
       return;
     }
 
+    gameDataWatcher->acceptOwnChanges();
+
     const auto wasPreludeUpdated = std::get<bool>(results.at(0));
     const auto wasMasterlistUpdated =
         std::get<MasterlistUpdateResult>(results.at(1)).second;
@@ -2578,14 +3847,7 @@ void MainWindow::handleMasterlistUpdated(std::vector<QueryResult> results) {
       return;
     }
 
-    state.GetCurrentGame().LoadMetadata();
-
-    const auto pluginItems =
-        GetPluginItems(state.GetCurrentGame().GetLoadOrder(),
-                       state.GetCurrentGame(),
-                       state.getSettings().getLanguage());
-
-    handleGameDataLoaded(pluginItems);
+    handleGameDataLoaded(reloadMetadataAndGetPluginItems());
 
     auto masterlistInfo = getFileRevisionSummary(
         state.GetCurrentGame().MasterlistPath(), FileType::Masterlist);
@@ -2606,6 +3868,8 @@ void MainWindow::handleMasterlistsUpdated(std::vector<QueryResult> results) {
       return;
     }
 
+    gameDataWatcher->acceptOwnChanges();
+
     // The results are in an unknown order due to parallel task execution.
     bool wasPreludeUpdated{false};
     for (const auto& result : results) {
@@ -2615,7 +3879,7 @@ void MainWindow::handleMasterlistsUpdated(std::vector<QueryResult> results) {
       }
     }
 
-    const auto logger = getLogger();
+    const auto logger = getLogger(LogCategory::ui);
     const auto gamesSettings = state.getSettings().getGameSettings();
 
     std::vector<std::string> updatedGameNames;
@@ -2664,14 +3928,7 @@ void MainWindow::handleMasterlistsUpdated(std::vector<QueryResult> results) {
 
     if (wasCurrentGameMasterlistUpdated) {
       // Need to reload the current game data.
-      state.GetCurrentGame().LoadMetadata();
-
-      const auto pluginItems =
-          GetPluginItems(state.GetCurrentGame().GetLoadOrder(),
-                         state.GetCurrentGame(),
-                         state.getSettings().getLanguage());
-
-      handleGameDataLoaded(pluginItems);
+      handleGameDataLoaded(reloadMetadataAndGetPluginItems());
     } else {
       progressDialog->reset();
     }
@@ -2693,36 +3950,115 @@ void MainWindow::handleMasterlistsUpdated(std::vector<QueryResult> results) {
 void MainWindow::handleOverlapFilterChecked(QueryResult result) {
   try {
     progressDialog->reset();
+    finishPerformanceTiming(PerformanceMetric::overlapQuery);
 
-    // The result is not an array of PluginItem objects.
-    // Instead it's an array of objects, with each having a metadata property
-    // that is a PluginItem object, and an overlap property that is
-    // a boolean.
-    std::vector<PluginItem> gameDataLoadedResult;
-    std::vector<std::string> overlappingPluginNames;
-
-    for (const auto& pluginPair :
-         std::get<GetOverlappingPluginsResult>(result)) {
-      if (pluginPair.second) {
-        overlappingPluginNames.push_back(pluginPair.first.name);
-      }
+    auto [overlappingPluginNames, pluginItems] =
+        std::get<GetOverlappingPluginsResult>(std::move(result));
+    const auto pluginsWereLoaded = pluginItems.has_value();
 
-      gameDataLoadedResult.push_back(pluginPair.first);
+    if (pluginsWereLoaded) {
+      handleGameDataLoaded(std::move(pluginItems.value()));
     }
 
-    handleGameDataLoaded(gameDataLoadedResult);
-
     setFiltersState(filtersWidget->getPluginFiltersState(),
                     std::move(overlappingPluginNames));
 
-    // Load order state was refreshed when plugins were loaded, so check for
-    // ambiguity.
-    checkForAmbiguousLoadOrder();
+    if (pluginsWereLoaded) {
+      // Load order state was refreshed when plugins were loaded, so check for
+      // ambiguity.
+      checkForAmbiguousLoadOrder();
+    }
+  } catch (const std::exception& e) {
+    handleException(e);
+  }
+}
+
+void MainWindow::handleOverlapCountsFound(QueryResult result) {
+  try {
+    progressDialog->reset();
+
+    auto [overlapCounts, pluginItems] =
+        std::get<GetOverlapCountsResult>(std::move(result));
+
+    // Set the counts before any new items so that displaying the items
+    // doesn't count overlaps again.
+    pluginItemModel->setOverlapCounts(std::move(overlapCounts));
+
+    if (pluginItems.has_value()) {
+      handleGameDataLoaded(std::move(pluginItems.value()),
+                           [this]() { checkForAmbiguousLoadOrder(); });
+    }
   } catch (const std::exception& e) {
     handleException(e);
   }
 }
 
+void MainWindow::handleUserMetadataCleared(QueryResult result) {
+  try {
+    progressDialog->reset();
+    gameDataWatcher->acceptOwnChanges();
+
+    // Clearing all user metadata can clear general messages (though
+    // user-defined general messages aren't editable through the LOOT GUI),
+    // change the known Bash Tags (though again they aren't editable in the GUI)
+    // and change plugin metadata that may be displayed in the sidebar or on
+    // cards. However, only plugins that had user metadata are affected, which
+    // is probably a small fraction of the total number, so doing a full refresh
+    // of the game-related UI would be overkill.
+
+    updateGroups();
+    updatePluginDependents();
+
+    pluginEditorWidget->setBashTagCompletions(
+        state.GetCurrentGame().GetKnownBashTags());
+
+    updateGeneralMessages();
+
+    // These plugin items are only those that had their user metadata removed.
+    // They're replaced together so that the sidebar items and cards are
+    // updated by handling a single dataChanged signal.
+    pluginItemModel->replacePluginItems(
+        std::get<PluginItems>(std::move(result)));
+
+    showNotification(translate("All user-added metadata has been cleared."));
+  } catch (const std::exception& e) {
+    handleException(e);
+  }
+}
+
+void MainWindow::handleBackupCreated(QueryResult result) {
+  try {
+    progressDialog->reset();
+
+    const auto backupPath = std::get<CreateBackupResult>(result);
+    if (backupPath.has_value()) {
+      auto backupPathString = backupPath.value().u8string();
+      auto link = "<pre><a href=\"file:" + backupPathString +
+                  "\" style=\"white-space: nowrap\">" + backupPathString +
+                  "</a></pre>";
+      auto message = fmt::format(
+          boost::locale::translate("Your LOOT data has been backed up to: {0}")
+              .str(),
+          link);
+
+      QMessageBox::information(this, "LOOT", QString::fromStdString(message));
+    } else {
+      auto message = translate(
+          "No backup has been created as LOOT has no data to backup.");
+
+      QMessageBox::information(this, "LOOT", message);
+    }
+  } catch (const std::exception& e) {
+    handleException(e);
+  }
+}
+
+void MainWindow::handleMetadataExported(QueryResult) {
+  progressDialog->reset();
+
+  showNotification(translate("The plugins' metadata has been exported."));
+}
+
 void MainWindow::handleProgressUpdate(const QString& message) {
   progressDialog->open();
   progressDialog->setLabelText(message);
@@ -2733,7 +4069,7 @@ void MainWindow::handleUpdateCheckFinished(QueryResult result) {
   try {
     const bool updateIsAvailable = std::get<bool>(result);
     if (updateIsAvailable) {
-      const auto logger = getLogger();
+      const auto logger = getLogger(LogCategory::ui);
       if (logger) {
         logger->info("LOOT update is available.");
       }
@@ -2776,6 +4112,38 @@ void MainWindow::handleUpdateCheckError(const std::string&) {
   }
 }
 
+void MainWindow::handleCardSizesUpdated(int firstRow, int lastRow) {
+  const auto cardDelegate =
+      qobject_cast<CardDelegate*>(pluginCardsView->itemDelegate());
+  if (!cardDelegate) {
+    return;
+  }
+
+  for (int row = firstRow; row <= lastRow; row += 1) {
+    const auto proxyIndex = proxyModel->mapFromSource(
+        pluginItemModel->index(row, PluginItemModel::CARDS_COLUMN));
+    if (proxyIndex.isValid()) {
+      emit cardDelegate->sizeHintChanged(proxyIndex);
+    }
+  }
+
+  prioritiseVisibleCardSizes();
+}
+
+void MainWindow::prioritiseVisibleCardSizes() {
+  if (!cardSizingCache.hasQueuedRows()) {
+    return;
+  }
+
+  const auto [firstIndex, lastIndex] = getVisibleCardIndexes();
+  if (!firstIndex.isValid()) {
+    return;
+  }
+
+  cardSizingCache.prioritise(proxyModel->mapToSource(firstIndex).row(),
+                             proxyModel->mapToSource(lastIndex).row());
+}
+
 void MainWindow::handleIconColorChanged() {
   IconFactory::setColours(
       normalIconColor, disabledIconColor, selectedIconColor);
@@ -2821,7 +4189,7 @@ void MainWindow::handleLinkColorChanged() {
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
 void MainWindow::handleColorSchemeChanged(Qt::ColorScheme colorScheme) {
-  const auto logger = getLogger();
+  const auto logger = getLogger(LogCategory::ui);
   if (logger) {
     std::string description;
     if (colorScheme == Qt::ColorScheme::Unknown) {
@@ -26,6 +26,7 @@
 #ifndef LOOT_GUI_QT_MAIN_WINDOW
 #define LOOT_GUI_QT_MAIN_WINDOW
 
+#include <QtCore/QTimer>
 #include <QtCore/QUrl>
 #include <QtCore/QVariant>
 #include <QtCore/QtGlobal>
@@ -54,18 +55,32 @@
 #include <QtWidgets/QToolButton>
 #include <QtWidgets/QVBoxLayout>
 #include <QtWidgets/QWidget>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <set>
+#include <utility>
 
 #include "gui/qt/card_delegate.h"
+#include "gui/qt/card_search.h"
+#include "gui/qt/diagnostics_dialog.h"
 #include "gui/qt/filters_widget.h"
+#include "gui/qt/game_data_watcher.h"
 #include "gui/qt/groups_editor/groups_editor_dialog.h"
+#include "gui/qt/instance_server.h"
 #include "gui/qt/plugin_editor/plugin_editor_widget.h"
 #include "gui/qt/plugin_item_filter_model.h"
 #include "gui/qt/plugin_item_model.h"
+#include "gui/qt/plugin_items_committer.h"
 #include "gui/qt/search_dialog.h"
 #include "gui/qt/settings/settings_dialog.h"
+#include "gui/qt/sidebar_plugins_view.h"
+#include "gui/qt/startup_scheduler.h"
 #include "gui/qt/tasks/tasks.h"
 #include "gui/query/query.h"
 #include "gui/state/loot_state.h"
+#include "gui/state/performance_history.h"
+#include "gui/state/run_metrics.h"
 
 namespace loot {
 class MainWindow : public QMainWindow {
@@ -90,6 +105,20 @@ public:
   void initialise();
   void applyTheme();
 
+  // Handles a request forwarded by a later launch of LOOT, switching game,
+  // sorting or refreshing the current game's content as requested. Returns
+  // false if the request was declined.
+  bool handleInstanceRequest(const InstanceRequest &request);
+
+  // Runs the given function once the current game's plugins are first
+  // displayed after initialise() is called, or the next time the event loop
+  // is free if they've already been displayed.
+  void runWhenPluginsDisplayed(std::function<void()> work);
+
+  // Controls whether the timings of key operations are added to the
+  // performance history file. Enabled by default.
+  void setPerformanceHistoryEnabled(bool enabled);
+
 signals:
   void normalIconColorChanged();
   void disabledIconColorChanged();
@@ -111,13 +140,16 @@ private:
   QAction *actionViewDocs{new QAction(this)};
   QAction *actionOpenFAQs{new QAction(this)};
   QAction *actionOpenLOOTDataFolder{new QAction(this)};
+  QAction *actionViewDiagnostics{new QAction(this)};
   QAction *actionJoinDiscordServer{new QAction(this)};
   QAction *actionAbout{new QAction(this)};
   QAction *actionQuit{new QAction(this)};
   QAction *actionOpenGroupsEditor{new QAction(this)};
   QAction *actionCopyLoadOrder{new QAction(this)};
   QAction *actionCopyContent{new QAction(this)};
+  QAction *actionExportMetadata{new QAction(this)};
   QAction *actionRefreshContent{new QAction(this)};
+  QAction *actionRankPluginsByOverlaps{new QAction(this)};
   QAction *actionRedatePlugins{new QAction(this)};
   QAction *actionFixAmbiguousLoadOrder{new QAction(this)};
   QAction *actionClearAllUserMetadata{new QAction(this)};
@@ -129,6 +161,7 @@ private:
   QAction *actionSettings{new QAction(this)};
   QAction *actionUpdateMasterlists{new QAction(this)};
   QAction *actionBackupData{new QAction(this)};
+  QAction *actionExtractBackup{new QAction(this)};
 
   QMenuBar *menubar{new QMenuBar(this)};
   QMenu *menuFile{new QMenu(menubar)};
@@ -143,7 +176,7 @@ private:
   QSplitter *sidebarSplitter{new QSplitter(this)};
   QToolBox *toolBox{new QToolBox(sidebarSplitter)};
   FiltersWidget *filtersWidget{new FiltersWidget(toolBox)};
-  QTableView *sidebarPluginsView{new QTableView(toolBox)};
+  SidebarPluginsView *sidebarPluginsView{new SidebarPluginsView(toolBox)};
 
   QSplitter *editorSplitter{
       new QSplitter(Qt::Orientation::Vertical, sidebarSplitter)};
@@ -155,9 +188,18 @@ private:
 
   SettingsDialog *settingsDialog{new SettingsDialog(this)};
   SearchDialog *searchDialog{new SearchDialog(this)};
+  DiagnosticsDialog *diagnosticsDialog{new DiagnosticsDialog(this, state)};
+  GameDataWatcher *gameDataWatcher{new GameDataWatcher(this)};
+  CardSearch *cardSearch{new CardSearch(this)};
+  StartupScheduler *startupScheduler{new StartupScheduler(this)};
+  // Saving the userlist is deferred until edits stop arriving, so that a
+  // burst of edits only writes it once.
+  QTimer *userMetadataSaveTimer{new QTimer(this)};
 
   PluginItemModel *pluginItemModel{new PluginItemModel(this)};
   PluginItemFilterModel *proxyModel{new PluginItemFilterModel(this)};
+  PluginItemsCommitter *pluginItemsCommitter{
+      new PluginItemsCommitter(this, pluginItemModel)};
   CardSizingCache cardSizingCache{pluginCardsView->viewport()};
 
   GroupsEditorDialog *groupsEditor{
@@ -165,6 +207,40 @@ private:
 
   std::optional<QPersistentModelIndex> lastEnteredCardIndex;
 
+  // True while the displayed plugin items are the snapshot from the previous
+  // session, before the game's current data has been loaded.
+  bool isShowingPluginItemsSnapshot{false};
+
+  // True while the displayed plugin items are those streamed in by a startup
+  // load that hasn't finished yet.
+  bool isShowingStreamedPluginItems{false};
+
+  // True if the game being switched to should be auto-sorted once it has
+  // loaded, because a request forwarded from another launch of LOOT said so.
+  bool autoSortAfterGameChange{false};
+  // True while an auto-sort requested by another launch of LOOT is running.
+  // Unlike an auto-sort on startup, LOOT stays open after it.
+  bool isForwardedAutoSort{false};
+
+  // Tokens for queries that are still running, so that they can be cancelled
+  // if their results are no longer wanted.
+  std::set<std::shared_ptr<CancellationToken>> runningQueryTokens;
+  // Tokens for the latest query run for each superseding key.
+  std::map<std::string, std::shared_ptr<CancellationToken>>
+      latestQueryTokensByKey;
+  // The token for the query preloading the previous game. It isn't tracked
+  // with the other running queries because it should still finish if the
+  // user switches to the game that it's preloading.
+  std::shared_ptr<CancellationToken> preloadGameToken;
+
+  bool isPerformanceHistoryEnabled{true};
+  // When each key operation that is still running started, so that its
+  // duration can be added to the performance history when it finishes.
+  std::map<PerformanceMetric, std::chrono::steady_clock::time_point>
+      performanceTimingStarts;
+  // Only created while a run metrics file is set.
+  std::unique_ptr<RunMetricsWriter> runMetricsWriter;
+
   QColor normalIconColor;
   QColor disabledIconColor;
   QColor selectedIconColor;
@@ -196,8 +272,24 @@ private:
   void exitSortingState();
 
   void loadGame(bool isOnLOOTStartup);
-  void updateCounts(const std::vector<SourcedMessage> &generalMessages,
-                    const std::vector<PluginItem> &plugins);
+  void updateGameDataWatcher();
+  // Reloads the current game's metadata lists and gets its plugin items,
+  // only rebuilding the items for plugins whose metadata changed.
+  std::vector<PluginItem> reloadMetadataAndGetPluginItems();
+  void updateCounts();
+  void updateGroups();
+  void updatePluginDependents();
+  // Counts the plugins that each plugin overlaps with in the background, if
+  // plugins are being ranked by overlaps and some plugins have no count.
+  void updateOverlapCounts();
+  void startPerformanceTiming(PerformanceMetric metric);
+  // Adds the time since the metric's timing was started to the performance
+  // history, if it was started.
+  void finishPerformanceTiming(PerformanceMetric metric);
+  // Queues the record to be appended to the run metrics file, along with
+  // the cache stats, operation timings and peak memory use so far, if a run
+  // metrics file is set.
+  void exportRunMetrics(const PerformanceRecord &record);
   void updateGeneralInformation();
   void updateGeneralMessages();
   void updateSidebarColumnWidths();
@@ -205,35 +297,55 @@ private:
   void setFiltersState(PluginFiltersState &&state,
                        std::vector<std::string> &&overlappingPluginNames);
   void refreshSearch();
-  void refreshPluginRawData(const std::string &pluginName);
+  void refreshPluginRawData(const std::vector<std::string> &pluginNames);
+  void scheduleUserMetadataSave();
+  void flushUserMetadataSave();
+  bool showPluginItemsSnapshot();
+  void savePluginItemsSnapshot();
 
   bool hasErrorMessages() const;
 
   void sortPlugins(bool isAutoSort);
+  void startForwardedAutoSort();
+  void precomputeSortResult();
+  void preloadPreviousGame();
+  void cancelPreloadingGame();
+  void checkForUpdates();
 
   void showFirstRunDialog();
   void showNotification(const QString &message);
 
   QModelIndex getSelectedPluginIndex() const;
   PluginItem getSelectedPlugin() const;
+  // Get the proxy model indexes of the first and last cards that are in view.
+  // The first index is invalid if no cards are in view.
+  std::pair<QModelIndex, QModelIndex> getVisibleCardIndexes() const;
+  // Get the selected plugins' items in load order.
+  std::vector<const PluginItem *> getSelectedPluginItems() const;
 
   void closeEvent(QCloseEvent *event) override;
 
   void executeBackgroundQuery(std::unique_ptr<Query> query,
                               void (MainWindow::*onComplete)(QueryResult),
                               ProgressUpdater *progressUpdater);
+  std::shared_ptr<CancellationToken> trackRunningQuery(const Query &query);
+  void untrackRunningQuery(const std::shared_ptr<CancellationToken> &token);
+  void abandonRunningQueries();
 
   void handleError(const std::string &message);
   void handleException(const std::exception &exception);
   void handleQueryException(const Query &query,
                             const std::exception &exception);
 
-  void handleGameDataLoaded(QueryResult result);
+  // The plugin items may be committed to the model over several event loop
+  // iterations, and onDisplayed is called once they all have been.
+  void handleGameDataLoaded(QueryResult result,
+                            std::function<void()> onDisplayed = nullptr);
   bool handlePluginsSorted(QueryResult result);
 
   QMenu *createPopupMenu() override;
 
-  std::optional<std::filesystem::path> createBackup();
+  std::unique_ptr<Query> createBackupQuery() const;
 
   void checkForAmbiguousLoadOrder();
 
@@ -243,13 +355,16 @@ private slots:
   void on_actionSettings_triggered();
   void on_actionUpdateMasterlists_triggered();
   void on_actionBackupData_triggered();
+  void on_actionExtractBackup_triggered();
   void on_actionQuit_triggered();
   void on_actionOpenGroupsEditor_triggered();
   void on_actionSearch_triggered();
   void on_actionCopyLoadOrder_triggered();
   void on_actionCopyContent_triggered();
+  void on_actionExportMetadata_triggered();
   void on_actionFixAmbiguousLoadOrder_triggered();
   void on_actionRefreshContent_triggered();
+  void on_actionRankPluginsByOverlaps_toggled(bool checked);
   void on_actionRedatePlugins_triggered();
   void on_actionClearAllUserMetadata_triggered();
   void on_actionEditMetadata_triggered();
@@ -260,6 +375,7 @@ private slots:
   void on_actionViewDocs_triggered();
   void on_actionOpenFAQs_triggered();
   void on_actionOpenLOOTDataFolder_triggered();
+  void on_actionViewDiagnostics_triggered();
   void on_actionJoinDiscordServer_triggered();
   void on_actionAbout_triggered();
 
@@ -284,8 +400,11 @@ private slots:
   void on_pluginItemModel_rowsInserted(const QModelIndex &,
                                        int first,
                                        int last);
+  void on_pluginItemModel_layoutChanged(
+      const QList<QPersistentModelIndex> &,
+      QAbstractItemModel::LayoutChangeHint);
 
-  void on_pluginEditorWidget_accepted(PluginMetadata userMetadata);
+  void on_pluginEditorWidget_accepted(UserMetadataChanges changes);
   void on_pluginEditorWidget_rejected();
 
   void on_filtersWidget_pluginFilterChanged(PluginFiltersState state);
@@ -297,22 +416,37 @@ private slots:
 
   void on_groupsEditor_accepted();
 
+  void on_userMetadataSaveTimer_timeout();
+
   void on_searchDialog_finished();
   void on_searchDialog_textChanged(const QVariant &text);
   void on_searchDialog_currentResultChanged(size_t resultIndex);
 
+  void on_cardSearch_searchFinished(const std::vector<int> &resultRows,
+                                    const ContentSearchTexts &contentTexts);
+
+  void on_gameDataWatcher_gameDataChanged();
+
   void handleGameChanged(QueryResult result);
   void handleRefreshGameDataLoaded(QueryResult result);
+  void handleWatchedGameDataRefreshed(QueryResult result);
   void handleStartupGameDataLoaded(QueryResult result);
   void handlePluginsManualSorted(QueryResult result);
   void handlePluginsAutoSorted(QueryResult result);
   void handleMasterlistUpdated(std::vector<QueryResult> results);
   void handleMasterlistsUpdated(std::vector<QueryResult> results);
   void handleOverlapFilterChecked(QueryResult result);
+  void handleOverlapCountsFound(QueryResult result);
+  void handleUserMetadataCleared(QueryResult result);
+  void handleBackupCreated(QueryResult result);
+  void handleMetadataExported(QueryResult result);
   void handleProgressUpdate(const QString &message);
   void handleUpdateCheckFinished(QueryResult result);
   void handleUpdateCheckError(const std::string &);
 
+  void handleCardSizesUpdated(int firstRow, int lastRow);
+  void prioritiseVisibleCardSizes();
+
   void handleIconColorChanged();
   void handleSidebarTextColorChanged();
   void handleLinkColorChanged();
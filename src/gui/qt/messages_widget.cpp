@@ -25,18 +25,35 @@
 
 #include "gui/qt/messages_widget.h"
 
+#include <QtCore/QCache>
+#include <QtGui/QGuiApplication>
+#include <QtGui/QPalette>
 #include <QtGui/QTextDocument>
 #include <QtWidgets/QGridLayout>
 #include <QtWidgets/QLabel>
 #include <QtWidgets/QStyle>
 
 #include "gui/sourced_message.h"
+#include "gui/state/diagnostics.h"
 
 namespace loot {
 static constexpr const char* MESSAGE_TYPE_PROPERTY = "messageType";
 static constexpr int COLUMN_COUNT = 2;
 static constexpr int BULLET_POINT_COLUMN = 0;
 static constexpr int MESSAGE_LABEL_COLUMN = 1;
+// The maximum total length of the HTML strings kept in the cache.
+static constexpr qsizetype HTML_CACHE_MAX_COST = 4 * 1024 * 1024;
+
+static CacheCounter htmlCacheCounter("Message HTML");
+
+// The HTML generated for a message depends on its Markdown text and the
+// current link color.
+typedef std::pair<QString, QRgb> HtmlCacheKey;
+
+QCache<HtmlCacheKey, QString>& getHtmlCache() {
+  static QCache<HtmlCacheKey, QString> cache(HTML_CACHE_MAX_COST);
+  return cache;
+}
 
 QString getPropertyValue(MessageType messageType) {
   switch (messageType) {
@@ -50,9 +67,22 @@ QString getPropertyValue(MessageType messageType) {
 }
 
 QString getHtmlText(const std::string& markdownText) {
+  // Converting Markdown to HTML is slow, and the same messages are often
+  // displayed for many plugins, so reuse previously generated HTML.
+  const auto markdown = QString::fromStdString(markdownText);
+  const auto cacheKey = HtmlCacheKey(
+      markdown, QGuiApplication::palette().color(QPalette::Link).rgba());
+
+  auto& cache = getHtmlCache();
+  const auto cachedHtml = cache.object(cacheKey);
+  htmlCacheCounter.recordLookup(cachedHtml != nullptr);
+  if (cachedHtml != nullptr) {
+    return *cachedHtml;
+  }
+
   QTextDocument document;
 
-  document.setMarkdown(QString::fromStdString(markdownText),
+  document.setMarkdown(markdown,
                        {QTextDocument::MarkdownNoHTML,
                         QTextDocument::MarkdownDialectCommonMark});
 
@@ -65,6 +95,9 @@ QString getHtmlText(const std::string& markdownText) {
 
   auto html = document.toHtml();
   html.replace("</head>", QString("<style>%1</style></head>").arg(styleSheet));
+
+  cache.insert(cacheKey, new QString(html), html.size());
+
   return html;
 }
 
@@ -139,9 +172,13 @@ std::vector<BareMessage> toBareMessages(
   return bareMessages;
 }
 
+void clearMessagesHtmlCache() { getHtmlCache().clear(); }
+
 MessagesWidget::MessagesWidget(QWidget* parent) : QWidget(parent) { setupUi(); }
 
 void MessagesWidget::setMessages(const std::vector<SourcedMessage>& messages) {
+  currentMessagesHash = std::nullopt;
+
   if (!willChangeContent(messages)) {
     // Avoid expensive layout changes.
     return;
@@ -150,7 +187,29 @@ void MessagesWidget::setMessages(const std::vector<SourcedMessage>& messages) {
   setMessages(toBareMessages(messages));
 }
 
-void MessagesWidget::refresh() { setMessages(currentMessages); }
+void MessagesWidget::setMessages(const std::vector<SourcedMessage>& messages,
+                                 uint64_t messagesHash) {
+  if (isDisplaying(messagesHash)) {
+    return;
+  }
+
+  if (willChangeContent(messages)) {
+    setMessages(toBareMessages(messages));
+  }
+
+  currentMessagesHash = messagesHash;
+}
+
+bool MessagesWidget::isDisplaying(uint64_t messagesHash) const {
+  return currentMessagesHash == messagesHash;
+}
+
+void MessagesWidget::refresh() {
+  // Force all the labels to be updated.
+  const auto messages = currentMessages;
+  currentMessages.clear();
+  setMessages(messages);
+}
 
 void MessagesWidget::setupUi() {
   // Bullet points rendered using rich text are positioned uncomfortably close
@@ -172,19 +231,22 @@ void MessagesWidget::setMessages(const std::vector<BareMessage>& messages) {
   // even when there's nothing in the layout yet. Instead, use count() /
   // COLUMN_COUNT.
 
-  // Delete any extra QLabels.
-  QLayoutItem* child = nullptr;
+  // Labels aren't deleted when there are fewer messages, they're hidden so
+  // that they can be reused when the number of messages increases again, as
+  // creating labels is much slower than updating them.
   const auto pastTheEndIndex = static_cast<int>(messages.size() * COLUMN_COUNT);
-  auto itemRemoved = false;
-  while ((child = layout()->takeAt(pastTheEndIndex)) != nullptr) {
-    delete child->widget();
-    delete child;
-    itemRemoved = true;
+  auto itemHidden = false;
+  for (int i = pastTheEndIndex; i < layout()->count(); i += 1) {
+    const auto widget = layout()->itemAt(i)->widget();
+    if (!widget->isHidden()) {
+      widget->hide();
+      itemHidden = true;
+    }
   }
 
   // For some reason the layout doesn't automatically resize if only some
-  // children are removed, but it does when all children are removed.
-  if (itemRemoved && layout()->count() != 0) {
+  // children are hidden.
+  if (itemHidden) {
     layout()->invalidate();
   }
 
@@ -202,13 +264,24 @@ void MessagesWidget::setMessages(const std::vector<BareMessage>& messages) {
     gridLayout->addWidget(messageLabel, row, MESSAGE_LABEL_COLUMN);
   }
 
-  // Now update the QLabels.
+  // Now update and show the QLabels. Labels that were already displaying
+  // the same message don't need to be updated.
   for (size_t i = 0; i < messages.size(); i += 1) {
     const auto position = static_cast<int>(i);
+    auto bulletPointLabel =
+        gridLayout->itemAtPosition(position, BULLET_POINT_COLUMN)->widget();
     auto label = qobject_cast<QLabel*>(
         gridLayout->itemAtPosition(position, MESSAGE_LABEL_COLUMN)->widget());
     const auto& message = messages.at(i);
-    updateMessageLabel(label, message);
+
+    const auto isUnchanged =
+        i < currentMessages.size() && currentMessages.at(i) == message;
+    if (!isUnchanged) {
+      updateMessageLabel(label, message);
+    }
+
+    bulletPointLabel->show();
+    label->show();
   }
 
   layout()->activate();
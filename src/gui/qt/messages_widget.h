@@ -27,13 +27,19 @@
 #define LOOT_GUI_QT_MESSAGES_WIDGET
 
 #include <QtWidgets/QWidget>
+#include <cstdint>
+#include <optional>
 
 #include "gui/sourced_message.h"
 
 namespace loot {
 // Use a pair of message type and text to avoid having to define the obvious
 // comparison operators.
-typedef std::pair<MessageType, std::string> BareMessage;
+typedef std::pair<MessageType, SharedString> BareMessage;
+
+// Message text is converted to HTML once and cached, so the cache must be
+// cleared when the theme changes, as that can change the generated HTML.
+void clearMessagesHtmlCache();
 
 class MessagesWidget : public QWidget {
 public:
@@ -41,10 +47,18 @@ public:
 
   void setMessages(const std::vector<SourcedMessage>& messages);
 
+  // Set messages that are identified by the given hash, so that whether they
+  // are displayed can be checked without comparing them.
+  void setMessages(const std::vector<SourcedMessage>& messages,
+                   uint64_t messagesHash);
+
+  bool isDisplaying(uint64_t messagesHash) const;
+
   void refresh();
 
 private:
   std::vector<BareMessage> currentMessages;
+  std::optional<uint64_t> currentMessagesHash;
 
   void setupUi();
 
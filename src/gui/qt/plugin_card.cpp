@@ -45,7 +45,7 @@ void setIcon(QLabel* label, QIcon icon) {
   label->setPixmap(IconFactory::getPixmap(icon, ATTRIBUTE_ICON_HEIGHT));
 }
 
-QString getTagsText(const std::vector<std::string> tags, bool hideTags) {
+QString getTagsText(const std::vector<InternedString>& tags, bool hideTags) {
   if (hideTags) {
     return "";
   }
@@ -69,7 +69,7 @@ std::vector<SourcedMessage> filterMessages(
 
   if (!filters.hideAllPluginMessages) {
     for (const auto& message : plugin.messages) {
-      if (!shouldFilterMessage(plugin.name, message, filters)) {
+      if (!shouldFilterMessage(plugin, message, filters)) {
         filteredMessages.push_back(message);
       }
     }
@@ -78,6 +78,28 @@ std::vector<SourcedMessage> filterMessages(
   return filteredMessages;
 }
 
+uint64_t getFilteredMessagesHash(const PluginItem& plugin,
+                                 const CardContentFiltersState& filters) {
+  if (filters.hideAllPluginMessages) {
+    return 0;
+  }
+
+  // The filtered messages only depend on the plugin's messages, whether it's
+  // official and the message filters.
+  auto hash = plugin.messagesHash;
+  const auto combine = [&hash](uint64_t value) {
+    // This is the same combination as boost::hash_combine() uses.
+    static constexpr uint64_t GOLDEN_RATIO = 0x9e3779b97f4a7c15;
+    hash ^= value + GOLDEN_RATIO + (hash << 6) + (hash >> 2);
+  };
+
+  combine(static_cast<uint64_t>(filters.hideNotes));
+  combine(static_cast<uint64_t>(filters.hideOfficialPluginsCleaningMessages &&
+                                plugin.isOfficial));
+
+  return hash;
+}
+
 PluginCard::PluginCard(QWidget* parent) : QFrame(parent) { setupUi(); }
 
 void PluginCard::setIcons() {
@@ -162,16 +184,24 @@ void PluginCard::setContent(const PluginItem& plugin,
 
   locationsLabel->setVisible(showLocations);
 
-  auto messages = filterMessages(plugin, filters);
-  if (!messages.empty()) {
-    messagesWidget->setMessages(messages);
+  // The messages only need to be filtered if they're not already displayed.
+  // The widget's messages aren't replaced when there are none to display, so
+  // it only ever displays a non-empty list.
+  const auto messagesHash = getFilteredMessagesHash(plugin, filters);
+  auto hasMessages = messagesWidget->isDisplaying(messagesHash);
+  if (!hasMessages) {
+    const auto messages = filterMessages(plugin, filters);
+    hasMessages = !messages.empty();
+    if (hasMessages) {
+      messagesWidget->setMessages(messages, messagesHash);
+    }
   }
-  messagesWidget->setVisible(!messages.empty());
+  messagesWidget->setVisible(hasMessages);
 
   if (plugin.cleaningUtility.has_value()) {
     auto cleanText =
         fmt::format(boost::locale::translate("Verified clean by {0}").str(),
-                    plugin.cleaningUtility.value());
+                    plugin.cleaningUtility.value().str());
     isCleanLabel->setToolTip(QString::fromStdString(cleanText));
   } else {
     isCleanLabel->setToolTip(QString());
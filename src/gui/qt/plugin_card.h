@@ -35,12 +35,17 @@
 #include "gui/qt/messages_widget.h"
 
 namespace loot {
-QString getTagsText(const std::vector<std::string> tags, bool hideTags);
+QString getTagsText(const std::vector<InternedString>& tags, bool hideTags);
 
 std::vector<SourcedMessage> filterMessages(
     const PluginItem& plugin,
     const CardContentFiltersState& filters);
 
+// Get a hash that identifies the messages that filterMessages() would return,
+// without filtering them.
+uint64_t getFilteredMessagesHash(const PluginItem& plugin,
+                                 const CardContentFiltersState& filters);
+
 class PluginCard : public QFrame {
   Q_OBJECT
 public:
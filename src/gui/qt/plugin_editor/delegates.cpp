@@ -163,7 +163,7 @@ bool MessageContentDelegate::eventFilter(QObject* editor, QEvent* event) {
 
 AutocompletingLineEditDelegate::AutocompletingLineEditDelegate(
     QObject* parent,
-    const QStringList& completions) :
+    CompletionModel* completions) :
     QStyledItemDelegate(parent), completions(completions) {}
 
 QWidget* AutocompletingLineEditDelegate::createEditor(
@@ -172,6 +172,7 @@ QWidget* AutocompletingLineEditDelegate::createEditor(
     const QModelIndex&) const {
   auto completer = new QCompleter(completions, parent);
   completer->setCaseSensitivity(Qt::CaseInsensitive);
+  completer->setModelSorting(QCompleter::CaseInsensitivelySortedModel);
 
   QLineEdit* lineEdit = new QLineEdit(parent);
   lineEdit->setCompleter(completer);
@@ -28,6 +28,7 @@
 
 #include <QtWidgets/QStyledItemDelegate>
 
+#include "gui/qt/plugin_editor/models/completion_model.h"
 #include "gui/state/loot_settings.h"
 
 namespace loot {
@@ -94,7 +95,7 @@ private:
 class AutocompletingLineEditDelegate : public QStyledItemDelegate {
 public:
   AutocompletingLineEditDelegate(QObject* parent,
-                                 const QStringList& completions);
+                                 CompletionModel* completions);
 
   QWidget* createEditor(QWidget* parent,
                         const QStyleOptionViewItem& option,
@@ -107,7 +108,7 @@ public:
                     const QModelIndex& index) const override;
 
 private:
-  const QStringList& completions;
+  CompletionModel* completions;
 };
 }
 
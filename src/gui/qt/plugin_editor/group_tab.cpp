@@ -75,6 +75,8 @@ void GroupTab::initialiseInputs(const std::vector<std::string>& groups,
       item->setFont(font);
     }
   }
+
+  initialUserGroupName = getUserMetadata();
 }
 
 std::optional<std::string> GroupTab::getUserMetadata() const {
@@ -88,6 +90,10 @@ std::optional<std::string> GroupTab::getUserMetadata() const {
   return name;
 }
 
+bool GroupTab::hasEdits() const {
+  return getUserMetadata() != initialUserGroupName;
+}
+
 void GroupTab::setupUi() {
   auto layout = new QFormLayout(this);
 
@@ -43,6 +43,10 @@ public:
 
   std::optional<std::string> getUserMetadata() const;
 
+  // Returns true if the user group is different from when the inputs were
+  // initialised.
+  bool hasEdits() const;
+
 signals:
   void groupChanged(bool hasUserMetadata);
 
@@ -50,6 +54,7 @@ private:
   QLabel* groupLabel{new QLabel(this)};
   QComboBox* groupComboBox{new QComboBox(this)};
   std::string nonUserGroupName;
+  std::optional<std::string> initialUserGroupName;
 
   void setupUi();
   void translateUi();
@@ -0,0 +1,84 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/qt/plugin_editor/models/completion_model.h"
+
+#include <algorithm>
+
+namespace loot {
+CompletionModel::CompletionModel(QObject* parent) :
+    QAbstractListModel(parent) {}
+
+int CompletionModel::rowCount(const QModelIndex& parent) const {
+  if (parent.isValid()) {
+    return 0;
+  }
+
+  return static_cast<int>(completions.size());
+}
+
+QVariant CompletionModel::data(const QModelIndex& index, int role) const {
+  if (!index.isValid() || index.row() >= completions.size()) {
+    return QVariant();
+  }
+
+  if (role != Qt::DisplayRole && role != Qt::EditRole) {
+    return QVariant();
+  }
+
+  return completions.at(index.row());
+}
+
+void CompletionModel::setCompletions(
+    const std::vector<std::string>& completions) {
+  QStringList newCompletions;
+  newCompletions.reserve(static_cast<qsizetype>(completions.size()));
+  for (const auto& completion : completions) {
+    newCompletions.append(QString::fromStdString(completion));
+  }
+
+  // This must match how QCompleter compares strings when searching a
+  // case-insensitively sorted model. Strings that only differ by case are
+  // then compared case-sensitively so that duplicates are adjacent.
+  std::sort(newCompletions.begin(),
+            newCompletions.end(),
+            [](const QString& lhs, const QString& rhs) {
+              const auto result =
+                  QString::compare(lhs, rhs, Qt::CaseInsensitive);
+              return result == 0 ? lhs < rhs : result < 0;
+            });
+  newCompletions.erase(
+      std::unique(newCompletions.begin(), newCompletions.end()),
+      newCompletions.end());
+
+  if (newCompletions == this->completions) {
+    return;
+  }
+
+  beginResetModel();
+  this->completions = std::move(newCompletions);
+  endResetModel();
+}
+}
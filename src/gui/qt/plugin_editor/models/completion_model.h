@@ -0,0 +1,60 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_QT_PLUGIN_EDITOR_MODELS_COMPLETION_MODEL
+#define LOOT_GUI_QT_PLUGIN_EDITOR_MODELS_COMPLETION_MODEL
+
+#include <QtCore/QAbstractListModel>
+#include <QtCore/QStringList>
+#include <string>
+#include <vector>
+
+namespace loot {
+// A list of completions that is kept sorted case-insensitively, so that a
+// QCompleter with its model sorting set to
+// QCompleter::CaseInsensitivelySortedModel can find the completions for a
+// prefix using a binary search instead of scanning the whole list each time
+// the text changes. One model can be shared by all the completers that offer
+// the same completions.
+class CompletionModel : public QAbstractListModel {
+  Q_OBJECT
+public:
+  explicit CompletionModel(QObject* parent);
+
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+
+  QVariant data(const QModelIndex& index, int role) const override;
+
+  // Does nothing if the given completions are the same as the current
+  // completions once sorted, so it's cheap to call whenever they might have
+  // changed.
+  void setCompletions(const std::vector<std::string>& completions);
+
+private:
+  QStringList completions;
+};
+}
+
+#endif
@@ -36,6 +36,31 @@ class MetadataTableModel : public QAbstractTableModel {
 public:
   std::vector<T> getUserMetadata() const { return userMetadata; }
 
+  void setMetadata(const std::vector<T>& newNonUserMetadata,
+                   const std::vector<T>& newUserMetadata) {
+    // Replace the rows instead of resetting the model, as a reset would also
+    // reset any column configuration in views of the model.
+    if (rowCount() > 0) {
+      beginRemoveRows(QModelIndex(), 0, rowCount() - 1);
+
+      nonUserMetadata.clear();
+      userMetadata.clear();
+
+      endRemoveRows();
+    }
+
+    const auto newRowCount =
+        static_cast<int>(newNonUserMetadata.size() + newUserMetadata.size());
+    if (newRowCount > 0) {
+      beginInsertRows(QModelIndex(), 0, newRowCount - 1);
+
+      nonUserMetadata = newNonUserMetadata;
+      userMetadata = newUserMetadata;
+
+      endInsertRows();
+    }
+  }
+
   int rowCount(const QModelIndex& = QModelIndex()) const override {
     return static_cast<int>(nonUserMetadata.size() + userMetadata.size());
   }
@@ -45,20 +45,12 @@ PluginEditorWidget::PluginEditorWidget(
 
 void PluginEditorWidget::setBashTagCompletions(
     const std::vector<std::string> &knownBashTags) {
-  bashTagCompletions.clear();
-
-  for (const auto &bashTag : knownBashTags) {
-    bashTagCompletions.append(QString::fromStdString(bashTag));
-  }
+  bashTagCompletions->setCompletions(knownBashTags);
 }
 
 void PluginEditorWidget::setFilenameCompletions(
     const std::vector<std::string> &knownFilenames) {
-  filenameCompletions.clear();
-
-  for (const auto &filename : knownFilenames) {
-    filenameCompletions.append(QString::fromStdString(filename));
-  }
+  filenameCompletions->setCompletions(knownFilenames);
 }
 
 void PluginEditorWidget::initialiseInputs(
@@ -195,24 +187,41 @@ void PluginEditorWidget::translateUi() {
   tabs->setTabText(LOCATIONS_TAB_INDEX, translate("Locations"));
 }
 
-PluginMetadata PluginEditorWidget::getUserMetadata() {
-  auto userMetadata = PluginMetadata(pluginLabel->text().toStdString());
+UserMetadataChanges PluginEditorWidget::getUserMetadataChanges() const {
+  UserMetadataChanges changes;
+  changes.pluginName = pluginLabel->text().toStdString();
 
-  auto group = groupTab->getUserMetadata();
-  if (group.has_value()) {
-    userMetadata.SetGroup(group.value());
+  if (groupTab->hasEdits()) {
+    changes.isGroupChanged = true;
+    changes.group = groupTab->getUserMetadata();
   }
 
-  userMetadata.SetLoadAfterFiles(loadAfterTab->getUserMetadata());
-  userMetadata.SetRequirements(requirementsTab->getUserMetadata());
-  userMetadata.SetIncompatibilities(incompatibilitiesTab->getUserMetadata());
-  userMetadata.SetMessages(messagesTab->getUserMetadata());
-  userMetadata.SetTags(tagsTab->getUserMetadata());
-  userMetadata.SetDirtyInfo(dirtyTab->getUserMetadata());
-  userMetadata.SetCleanInfo(cleanTab->getUserMetadata());
-  userMetadata.SetLocations(locationsTab->getUserMetadata());
+  if (loadAfterTab->hasEdits()) {
+    changes.loadAfterFiles = loadAfterTab->getUserMetadata();
+  }
+  if (requirementsTab->hasEdits()) {
+    changes.requirements = requirementsTab->getUserMetadata();
+  }
+  if (incompatibilitiesTab->hasEdits()) {
+    changes.incompatibilities = incompatibilitiesTab->getUserMetadata();
+  }
+  if (messagesTab->hasEdits()) {
+    changes.messages = messagesTab->getUserMetadata();
+  }
+  if (tagsTab->hasEdits()) {
+    changes.tags = tagsTab->getUserMetadata();
+  }
+  if (dirtyTab->hasEdits()) {
+    changes.dirtyInfo = dirtyTab->getUserMetadata();
+  }
+  if (cleanTab->hasEdits()) {
+    changes.cleanInfo = cleanTab->getUserMetadata();
+  }
+  if (locationsTab->hasEdits()) {
+    changes.locations = locationsTab->getUserMetadata();
+  }
 
-  return userMetadata;
+  return changes;
 }
 
 void PluginEditorWidget::connectTableRowCountChangedSignal(
@@ -226,7 +235,7 @@ void PluginEditorWidget::connectTableRowCountChangedSignal(
 void PluginEditorWidget::on_dialogButtons_accepted() {
   this->close();
 
-  emit accepted(getUserMetadata());
+  emit accepted(getUserMetadataChanges());
 }
 
 void PluginEditorWidget::on_dialogButtons_rejected() {
@@ -36,6 +36,7 @@
 #include "gui/qt/plugin_editor/group_tab.h"
 #include "gui/qt/plugin_editor/table_tabs.h"
 #include "gui/state/loot_settings.h"
+#include "gui/user_metadata_changes.h"
 
 namespace loot {
 class PluginEditorWidget : public QWidget {
@@ -56,15 +57,17 @@ public:
   std::string getCurrentPluginName() const;
 
 signals:
-  void accepted(PluginMetadata userMetadata);
+  // Only the user metadata in tabs that have been edited is included, so
+  // that saving a small edit doesn't involve reading every tab's table.
+  void accepted(UserMetadataChanges changes);
   void rejected();
 
 private:
   const std::vector<LootSettings::Language> &languages;
   const std::string language;
 
-  QStringList bashTagCompletions;
-  QStringList filenameCompletions;
+  CompletionModel *bashTagCompletions{new CompletionModel(this)};
+  CompletionModel *filenameCompletions{new CompletionModel(this)};
 
   QLabel *pluginLabel{new QLabel(this)};
   QTabWidget *tabs{new QTabWidget(this)};
@@ -89,7 +92,7 @@ private:
   void setupUi();
   void translateUi();
 
-  PluginMetadata getUserMetadata();
+  UserMetadataChanges getUserMetadataChanges() const;
 
   void connectTableRowCountChangedSignal(const BaseTableTab *tableTab);
 
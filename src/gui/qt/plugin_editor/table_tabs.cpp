@@ -131,6 +131,8 @@ int calculateMinimumColumnWidth(
 
 BaseTableTab::BaseTableTab(QWidget* parent) : QWidget(parent) { setupUi(); }
 
+bool BaseTableTab::hasEdits() const { return isEdited; }
+
 QAbstractItemModel* BaseTableTab::getTableModel() const {
   return tableView->model();
 }
@@ -166,6 +168,10 @@ void BaseTableTab::setTableModel(QAbstractItemModel* model) {
           &QAbstractItemModel::rowsRemoved,
           this,
           &BaseTableTab::onModelRowsRemoved);
+  connect(model,
+          &QAbstractItemModel::dataChanged,
+          this,
+          &BaseTableTab::onModelDataChanged);
 
   emit tableRowCountChanged(hasUserMetadata());
 
@@ -194,6 +200,8 @@ void BaseTableTab::configureAsDropTarget() {
   tableView->setDropIndicatorShown(true);
 }
 
+void BaseTableTab::clearEdits() { isEdited = false; }
+
 void BaseTableTab::resizeEvent(QResizeEvent*) {
   const auto header = tableView->horizontalHeader();
   for (int i = 0; i < header->count(); i += 1) {
@@ -325,17 +333,21 @@ void BaseTableTab::onSelectionModelSelectionChanged() {
 }
 
 void BaseTableTab::onModelRowsInserted() {
+  isEdited = true;
   emit tableRowCountChanged(hasUserMetadata());
 }
 
 void BaseTableTab::onModelRowsRemoved() {
+  isEdited = true;
   emit tableRowCountChanged(hasUserMetadata());
 }
 
+void BaseTableTab::onModelDataChanged() { isEdited = true; }
+
 FileTableTab::FileTableTab(QWidget* parent,
                            const std::vector<LootSettings::Language>& languages,
                            const std::string& language,
-                           const QStringList& completions) :
+                           CompletionModel* completions) :
     MetadataTableTab(parent),
     languages(languages),
     language(language),
@@ -343,8 +355,8 @@ FileTableTab::FileTableTab(QWidget* parent,
   configureAsDropTarget();
 }
 
-void FileTableTab::initialiseInputs(const std::vector<File>& nonUserMetadata,
-                                    const std::vector<File>& userMetadata) {
+void FileTableTab::initialiseTable(const std::vector<File>& nonUserMetadata,
+                                   const std::vector<File>& userMetadata) {
   auto tableModel =
       new FileTableModel(this, nonUserMetadata, userMetadata, language);
 
@@ -357,18 +369,10 @@ void FileTableTab::initialiseInputs(const std::vector<File>& nonUserMetadata,
   setItemDelegateForColumn(tableModel->DETAIL_COLUMN, detailDelegate);
 }
 
-std::vector<File> FileTableTab::getUserMetadata() const {
-  return dynamic_cast<FileTableModel*>(getTableModel())->getUserMetadata();
-}
-
-bool FileTableTab::hasUserMetadata() const {
-  return !getUserMetadata().empty();
-}
-
-void LoadAfterFileTableTab::initialiseInputs(
+void LoadAfterFileTableTab::initialiseTable(
     const std::vector<File>& nonUserMetadata,
     const std::vector<File>& userMetadata) {
-  FileTableTab::initialiseInputs(nonUserMetadata, userMetadata);
+  FileTableTab::initialiseTable(nonUserMetadata, userMetadata);
 
   setColumnHidden(FileTableModel::DISPLAY_NAME_COLUMN, true);
   setColumnHidden(FileTableModel::DETAIL_COLUMN, true);
@@ -387,7 +391,7 @@ MessageContentTableWidget::MessageContentTableWidget(
   }
 }
 
-void MessageContentTableWidget::initialiseInputs(
+void MessageContentTableWidget::initialiseTable(
     const std::vector<MessageContent>& nonUserMetadata,
     const std::vector<MessageContent>& userMetadata) {
   std::map<MessageType, std::pair<QString, QVariant>> messageTypeMap = {
@@ -409,22 +413,13 @@ void MessageContentTableWidget::initialiseInputs(
   setItemDelegateForColumn(tableModel->LANGUAGE_COLUMN, languageDelegate);
 }
 
-std::vector<MessageContent> MessageContentTableWidget::getUserMetadata() const {
-  return dynamic_cast<MessageContentTableModel*>(getTableModel())
-      ->getUserMetadata();
-}
-
-bool MessageContentTableWidget::hasUserMetadata() const {
-  return !getUserMetadata().empty();
-}
-
 MessageTableTab::MessageTableTab(
     QWidget* parent,
     const std::vector<LootSettings::Language>& languages,
     const std::string& language) :
     MetadataTableTab(parent), languages(languages), language(language) {}
 
-void MessageTableTab::initialiseInputs(
+void MessageTableTab::initialiseTable(
     const std::vector<Message>& nonUserMetadata,
     const std::vector<Message>& userMetadata) {
   std::map<MessageType, std::pair<QString, QVariant>> messageTypeMap = {
@@ -452,15 +447,7 @@ void MessageTableTab::initialiseInputs(
   setItemDelegateForColumn(tableModel->CONTENT_COLUMN, contentDelegate);
 }
 
-std::vector<Message> MessageTableTab::getUserMetadata() const {
-  return dynamic_cast<MessageTableModel*>(getTableModel())->getUserMetadata();
-}
-
-bool MessageTableTab::hasUserMetadata() const {
-  return !getUserMetadata().empty();
-}
-
-void LocationTableTab::initialiseInputs(
+void LocationTableTab::initialiseTable(
     const std::vector<Location>& nonUserMetadata,
     const std::vector<Location>& userMetadata) {
   auto tableModel = new LocationTableModel(this, nonUserMetadata, userMetadata);
@@ -468,21 +455,13 @@ void LocationTableTab::initialiseInputs(
   setTableModel(tableModel);
 }
 
-std::vector<Location> LocationTableTab::getUserMetadata() const {
-  return dynamic_cast<LocationTableModel*>(getTableModel())->getUserMetadata();
-}
-
-bool LocationTableTab::hasUserMetadata() const {
-  return !getUserMetadata().empty();
-}
-
 CleaningDataTableTab::CleaningDataTableTab(
     QWidget* parent,
     const std::vector<LootSettings::Language>& languages,
     const std::string& language) :
     MetadataTableTab(parent), languages(languages), language(language) {}
 
-void CleaningDataTableTab::initialiseInputs(
+void CleaningDataTableTab::initialiseTable(
     const std::vector<PluginCleaningData>& nonUserMetadata,
     const std::vector<PluginCleaningData>& userMetadata) {
   auto tableModel =
@@ -497,29 +476,33 @@ void CleaningDataTableTab::initialiseInputs(
   auto detailDelegate = new MessageContentDelegate(this, languages);
 
   setItemDelegateForColumn(tableModel->DETAIL_COLUMN, detailDelegate);
+
+  applyCountsHidden();
 }
 
 void CleaningDataTableTab::hideCounts(bool hide) {
-  setColumnHidden(CleaningDataTableModel::ITM_COLUMN, hide);
-  setColumnHidden(CleaningDataTableModel::DELETED_REFERENCE_COLUMN, hide);
-  setColumnHidden(CleaningDataTableModel::DELETED_NAVMESH_COLUMN, hide);
-  setColumnHidden(CleaningDataTableModel::DETAIL_COLUMN, hide);
-}
+  countsHidden = hide;
 
-std::vector<PluginCleaningData> CleaningDataTableTab::getUserMetadata() const {
-  return dynamic_cast<CleaningDataTableModel*>(getTableModel())
-      ->getUserMetadata();
+  // The table may not have been set up yet, in which case the columns are
+  // hidden once it is.
+  if (getTableModel() != nullptr) {
+    applyCountsHidden();
+  }
 }
 
-bool CleaningDataTableTab::hasUserMetadata() const {
-  return !getUserMetadata().empty();
+void CleaningDataTableTab::applyCountsHidden() {
+  setColumnHidden(CleaningDataTableModel::ITM_COLUMN, countsHidden);
+  setColumnHidden(CleaningDataTableModel::DELETED_REFERENCE_COLUMN,
+                  countsHidden);
+  setColumnHidden(CleaningDataTableModel::DELETED_NAVMESH_COLUMN, countsHidden);
+  setColumnHidden(CleaningDataTableModel::DETAIL_COLUMN, countsHidden);
 }
 
-TagTableTab::TagTableTab(QWidget* parent, const QStringList& completions) :
+TagTableTab::TagTableTab(QWidget* parent, CompletionModel* completions) :
     MetadataTableTab(parent), completions(completions) {}
 
-void TagTableTab::initialiseInputs(const std::vector<Tag>& nonUserMetadata,
-                                   const std::vector<Tag>& userMetadata) {
+void TagTableTab::initialiseTable(const std::vector<Tag>& nonUserMetadata,
+                                  const std::vector<Tag>& userMetadata) {
   std::map<bool, std::pair<QString, QVariant>> suggestionTypeMap = {
       {true, {translate("Add"), true}}, {false, {translate("Remove"), false}}};
 
@@ -542,11 +525,5 @@ void TagTableTab::initialiseInputs(const std::vector<Tag>& nonUserMetadata,
 
   setItemDelegateForColumn(tableModel->TYPE_COLUMN, addRemoveDelegate);
   setItemDelegateForColumn(tableModel->NAME_COLUMN, nameDelegate);
-}
-
-std::vector<Tag> TagTableTab::getUserMetadata() const {
-  return dynamic_cast<TagTableModel*>(getTableModel())->getUserMetadata();
-}
-
-bool TagTableTab::hasUserMetadata() const { return !getUserMetadata().empty(); }
+}}
 }
@@ -32,6 +32,9 @@
 #include <loot/metadata/plugin_cleaning_data.h>
 #include <loot/metadata/tag.h>
 
+#include <optional>
+#include <utility>
+
 #include <QtCore/QAbstractTableModel>
 #include <QtGui/QShowEvent>
 #include <QtWidgets/QPushButton>
@@ -39,6 +42,8 @@
 #include <QtWidgets/QTableView>
 #include <QtWidgets/QWidget>
 
+#include "gui/qt/plugin_editor/models/completion_model.h"
+#include "gui/qt/plugin_editor/models/metadata_table_model.h"
 #include "gui/state/loot_settings.h"
 
 namespace loot {
@@ -47,6 +52,10 @@ class BaseTableTab : public QWidget {
 public:
   explicit BaseTableTab(QWidget* parent);
 
+  // Returns true if the table's rows have been added to, removed or edited
+  // since its inputs were last initialised.
+  bool hasEdits() const;
+
 signals:
   void tableRowCountChanged(bool hasUserMetadata);
 
@@ -57,6 +66,7 @@ protected:
   void setItemDelegateForColumn(int column, QStyledItemDelegate* delegate);
   void setColumnFixedWidth(int column, int width);
   void configureAsDropTarget();
+  void clearEdits();
 
   virtual bool hasUserMetadata() const = 0;
 
@@ -66,6 +76,7 @@ private:
   QTableView* tableView{new QTableView(this)};
   QPushButton* addNewRowButton{new QPushButton(this)};
   QPushButton* deleteRowButton{new QPushButton(this)};
+  bool isEdited{false};
 
   void setupUi();
   void translateUi();
@@ -78,6 +89,7 @@ private slots:
 
   void onModelRowsInserted();
   void onModelRowsRemoved();
+  void onModelDataChanged();
 };
 
 template<typename T>
@@ -85,10 +97,74 @@ class MetadataTableTab : public BaseTableTab {
 public:
   using BaseTableTab::BaseTableTab;
 
-  virtual void initialiseInputs(const std::vector<T>& nonUserMetadata,
-                                const std::vector<T>& userMetadata) = 0;
+  // The table isn't populated until the tab is shown, as most tabs aren't
+  // viewed while editing a given plugin's metadata. Once the table has been
+  // set up its model is reused, so later inputs just replace its rows.
+  void initialiseInputs(const std::vector<T>& nonUserMetadata,
+                        const std::vector<T>& userMetadata) {
+    pendingInputs = std::make_pair(nonUserMetadata, userMetadata);
+
+    if (isVisible()) {
+      loadPendingInputs();
+    } else {
+      emit tableRowCountChanged(!userMetadata.empty());
+    }
+
+    clearEdits();
+  }
+
+  std::vector<T> getUserMetadata() const {
+    if (pendingInputs.has_value()) {
+      return pendingInputs->second;
+    }
+
+    const auto tableModel = getMetadataTableModel();
+    if (tableModel == nullptr) {
+      return {};
+    }
+
+    return tableModel->getUserMetadata();
+  }
+
+  bool hasUserMetadata() const override { return !getUserMetadata().empty(); }
+
+protected:
+  // Called the first time that the table is populated, to create its model
+  // and set up its columns.
+  virtual void initialiseTable(const std::vector<T>& nonUserMetadata,
+                               const std::vector<T>& userMetadata) = 0;
 
-  virtual std::vector<T> getUserMetadata() const = 0;
+  void showEvent(QShowEvent* event) override {
+    loadPendingInputs();
+
+    BaseTableTab::showEvent(event);
+  }
+
+private:
+  std::optional<std::pair<std::vector<T>, std::vector<T>>> pendingInputs;
+
+  MetadataTableModel<T>* getMetadataTableModel() const {
+    return dynamic_cast<MetadataTableModel<T>*>(getTableModel());
+  }
+
+  void loadPendingInputs() {
+    if (!pendingInputs.has_value()) {
+      return;
+    }
+
+    auto inputs = std::move(pendingInputs.value());
+    pendingInputs.reset();
+
+    const auto tableModel = getMetadataTableModel();
+    if (tableModel == nullptr) {
+      initialiseTable(inputs.first, inputs.second);
+    } else {
+      tableModel->setMetadata(inputs.first, inputs.second);
+    }
+
+    // Loading the inputs replaces the table's rows, which isn't an edit.
+    clearEdits();
+  }
 };
 
 class FileTableTab : public MetadataTableTab<File> {
@@ -97,27 +173,25 @@ public:
   FileTableTab(QWidget* parent,
                const std::vector<LootSettings::Language>& languages,
                const std::string& language,
-               const QStringList& completions);
-
-  void initialiseInputs(const std::vector<File>& nonUserMetadata,
-                        const std::vector<File>& userMetadata) override;
-
-  std::vector<File> getUserMetadata() const override;
+               CompletionModel* completions);
 
-  bool hasUserMetadata() const override;
+protected:
+  void initialiseTable(const std::vector<File>& nonUserMetadata,
+                       const std::vector<File>& userMetadata) override;
 
 private:
   const std::vector<LootSettings::Language>& languages;
   const std::string& language;
-  const QStringList& completions;
+  CompletionModel* completions;
 };
 
 class LoadAfterFileTableTab : public FileTableTab {
 public:
   using FileTableTab::FileTableTab;
 
-  void initialiseInputs(const std::vector<File>& nonUserMetadata,
-                        const std::vector<File>& userMetadata) override;
+protected:
+  void initialiseTable(const std::vector<File>& nonUserMetadata,
+                       const std::vector<File>& userMetadata) override;
 };
 
 class MessageContentTableWidget : public MetadataTableTab<MessageContent> {
@@ -127,14 +201,11 @@ public:
       QWidget* parent,
       const std::vector<LootSettings::Language>& languages);
 
-  void initialiseInputs(
+protected:
+  void initialiseTable(
       const std::vector<MessageContent>& nonUserMetadata,
       const std::vector<MessageContent>& userMetadata) override;
 
-  std::vector<MessageContent> getUserMetadata() const override;
-
-  bool hasUserMetadata() const override;
-
 private:
   std::vector<std::pair<QString, QVariant>> languages;
   std::map<std::string, QVariant> languageMap;
@@ -147,12 +218,9 @@ public:
                   const std::vector<LootSettings::Language>& languages,
                   const std::string& language);
 
-  void initialiseInputs(const std::vector<Message>& nonUserMetadata,
-                        const std::vector<Message>& userMetadata) override;
-
-  std::vector<Message> getUserMetadata() const override;
-
-  bool hasUserMetadata() const override;
+protected:
+  void initialiseTable(const std::vector<Message>& nonUserMetadata,
+                       const std::vector<Message>& userMetadata) override;
 
 private:
   const std::vector<LootSettings::Language>& languages;
@@ -164,12 +232,9 @@ class LocationTableTab : public MetadataTableTab<Location> {
 public:
   using MetadataTableTab::MetadataTableTab;
 
-  void initialiseInputs(const std::vector<Location>& nonUserMetadata,
-                        const std::vector<Location>& userMetadata) override;
-
-  std::vector<Location> getUserMetadata() const override;
-
-  bool hasUserMetadata() const override;
+protected:
+  void initialiseTable(const std::vector<Location>& nonUserMetadata,
+                       const std::vector<Location>& userMetadata) override;
 };
 
 class CleaningDataTableTab : public MetadataTableTab<PluginCleaningData> {
@@ -179,35 +244,32 @@ public:
                        const std::vector<LootSettings::Language>& languages,
                        const std::string& language);
 
-  void initialiseInputs(
-      const std::vector<PluginCleaningData>& nonUserMetadata,
-      const std::vector<PluginCleaningData>& userMetadata) override;
-
   void hideCounts(bool hide);
 
-  std::vector<PluginCleaningData> getUserMetadata() const override;
-
-  bool hasUserMetadata() const override;
+protected:
+  void initialiseTable(
+      const std::vector<PluginCleaningData>& nonUserMetadata,
+      const std::vector<PluginCleaningData>& userMetadata) override;
 
 private:
   const std::vector<LootSettings::Language>& languages;
   const std::string& language;
+  bool countsHidden{false};
+
+  void applyCountsHidden();
 };
 
 class TagTableTab : public MetadataTableTab<Tag> {
   Q_OBJECT
 public:
-  TagTableTab(QWidget* parent, const QStringList& completions);
-
-  void initialiseInputs(const std::vector<Tag>& nonUserMetadata,
-                        const std::vector<Tag>& userMetadata) override;
+  TagTableTab(QWidget* parent, CompletionModel* completions);
 
-  std::vector<Tag> getUserMetadata() const override;
-
-  bool hasUserMetadata() const override;
+protected:
+  void initialiseTable(const std::vector<Tag>& nonUserMetadata,
+                       const std::vector<Tag>& userMetadata) override;
 
 private:
-  const QStringList& completions;
+  CompletionModel* completions;
 };
 }
 
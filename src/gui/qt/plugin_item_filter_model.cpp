@@ -25,10 +25,18 @@
 
 #include "gui/qt/plugin_item_filter_model.h"
 
+#include <algorithm>
+
+#include "gui/helpers.h"
 #include "gui/plugin_item.h"
 #include "gui/qt/plugin_item_model.h"
+#include "gui/state/diagnostics.h"
+#include "gui/state/game/helpers.h"
+#include "gui/state/thread_pool.h"
 
 namespace loot {
+static CacheCounter contentRegexCacheCounter("Content filter regex results");
+
 bool anyMessagesVisible(const PluginItem& plugin,
                         const CardContentFiltersState& filters) {
   if (filters.hideAllPluginMessages) {
@@ -36,7 +44,7 @@ bool anyMessagesVisible(const PluginItem& plugin,
   }
 
   for (const auto& message : plugin.messages) {
-    if (!shouldFilterMessage(plugin.name, message, filters)) {
+    if (!shouldFilterMessage(plugin, message, filters)) {
       return true;
     }
   }
@@ -45,11 +53,17 @@ bool anyMessagesVisible(const PluginItem& plugin,
 }
 
 PluginItemFilterModel::PluginItemFilterModel(QObject* parent) :
-    QSortFilterProxyModel(parent) {}
+    QSortFilterProxyModel(parent) {
+  // The only sorting that's done is ranking plugins by their overlap counts.
+  setSortRole(OverlapCountRole);
+}
 
 void PluginItemFilterModel::setFiltersState(PluginFiltersState&& state) {
   filterState = std::move(state);
 
+  updateFilterGroupNames();
+  updateDependentPluginNames();
+  resetFilterResults();
   invalidateFilter();
 }
 
@@ -57,17 +71,81 @@ void PluginItemFilterModel::setFiltersState(
     PluginFiltersState&& state,
     std::vector<std::string>&& newOverlappingPluginNames) {
   filterState = std::move(state);
-  this->overlappingPluginNames = std::move(newOverlappingPluginNames);
 
+  overlappingPluginNames.clear();
+  for (const auto& name : newOverlappingPluginNames) {
+    overlappingPluginNames.insert(NormalisePluginName(name));
+  }
+
+  updateFilterGroupNames();
+  updateDependentPluginNames();
+  resetFilterResults();
   invalidateFilter();
 }
 
-void PluginItemFilterModel::setSearchResults(QModelIndexList results) {
+void PluginItemFilterModel::setGroupGraph(
+    std::shared_ptr<const GroupGraph> graph) {
+  groupGraph = std::move(graph);
+
+  if (filterState.groupName.has_value() && filterState.includeLaterGroups) {
+    updateFilterGroupNames();
+    resetFilterResults();
+    invalidateFilter();
+  }
+}
+
+void PluginItemFilterModel::setPluginDependentsIndex(
+    std::shared_ptr<const PluginDependentsIndex> index) {
+  pluginDependentsIndex = std::move(index);
+
+  if (filterState.dependencyPluginName.has_value()) {
+    updateDependentPluginNames();
+    resetFilterResults();
+    invalidateFilter();
+  }
+}
+
+void PluginItemFilterModel::setSearchResults(
+    QModelIndexList results,
+    const QModelIndex& firstVisibleIndex,
+    const QModelIndex& lastVisibleIndex) {
   std::set<int> resultRows;
   for (const auto& result : results) {
     resultRows.insert(result.row());
   }
 
+  // Update the source model's results in one go if possible, as setting them
+  // row by row emits a dataChanged signal for each row.
+  const auto pluginItemModel = qobject_cast<PluginItemModel*>(sourceModel());
+  if (pluginItemModel != nullptr) {
+    std::vector<std::pair<int, bool>> sourceRowResults;
+    for (int row = 1; row < rowCount(); row += 1) {
+      const auto sourceIndex =
+          mapToSource(this->index(row, PluginItemModel::CARDS_COLUMN));
+      const auto isNewResult = resultRows.find(row) != resultRows.end();
+
+      sourceRowResults.emplace_back(sourceIndex.row(), isNewResult);
+    }
+
+    // The rows may be ranked by their overlap counts, so the visible rows
+    // aren't necessarily in source row order.
+    auto firstVisibleRow = rowCount();
+    auto lastVisibleRow = -1;
+    if (firstVisibleIndex.isValid() && lastVisibleIndex.isValid()) {
+      for (int row = firstVisibleIndex.row(); row <= lastVisibleIndex.row();
+           row += 1) {
+        const auto sourceRow =
+            mapToSource(this->index(row, PluginItemModel::CARDS_COLUMN)).row();
+        firstVisibleRow = std::min(firstVisibleRow, sourceRow);
+        lastVisibleRow = std::max(lastVisibleRow, sourceRow);
+      }
+    }
+
+    pluginItemModel->setSearchResults(
+        sourceRowResults, firstVisibleRow, lastVisibleRow);
+    return;
+  }
+
   for (int row = 1; row < rowCount(); row += 1) {
     const auto index = this->index(row, PluginItemModel::CARDS_COLUMN);
     const auto isNewResult = resultRows.find(row) != resultRows.end();
@@ -78,7 +156,54 @@ void PluginItemFilterModel::setSearchResults(QModelIndexList results) {
   }
 }
 
-void PluginItemFilterModel::clearSearchResults() { setSearchResults({}); }
+void PluginItemFilterModel::clearSearchResults(
+    const QModelIndex& firstVisibleIndex,
+    const QModelIndex& lastVisibleIndex) {
+  setSearchResults({}, firstVisibleIndex, lastVisibleIndex);
+}
+
+void PluginItemFilterModel::setSourceModel(QAbstractItemModel* sourceModel) {
+  for (const auto& connection : sourceModelConnections) {
+    disconnect(connection);
+  }
+  sourceModelConnections.clear();
+  acceptedItems.clear();
+
+  // Connect to the source model before the base class does, so that the
+  // results are up to date before it filters rows in response to the same
+  // signals.
+  if (sourceModel != nullptr) {
+    const auto clearAcceptedItems = [this]() { acceptedItems.clear(); };
+
+    sourceModelConnections = {
+        connect(sourceModel,
+                &QAbstractItemModel::dataChanged,
+                this,
+                &PluginItemFilterModel::onSourceDataChanged),
+        connect(sourceModel,
+                &QAbstractItemModel::modelReset,
+                this,
+                clearAcceptedItems),
+        connect(sourceModel,
+                &QAbstractItemModel::layoutChanged,
+                this,
+                clearAcceptedItems),
+        connect(sourceModel,
+                &QAbstractItemModel::rowsInserted,
+                this,
+                clearAcceptedItems),
+        connect(sourceModel,
+                &QAbstractItemModel::rowsRemoved,
+                this,
+                clearAcceptedItems),
+        connect(sourceModel,
+                &QAbstractItemModel::rowsMoved,
+                this,
+                clearAcceptedItems)};
+  }
+
+  QSortFilterProxyModel::setSourceModel(sourceModel);
+}
 
 bool PluginItemFilterModel::filterAcceptsRow(
     int sourceRow,
@@ -88,13 +213,150 @@ bool PluginItemFilterModel::filterAcceptsRow(
     return true;
   }
 
+  // Read the item directly from the source model if possible, to avoid
+  // copying it and the card content filters state into and out of QVariants
+  // for every row.
+  const auto pluginItemModel =
+      qobject_cast<const PluginItemModel*>(sourceModel());
+  if (pluginItemModel != nullptr) {
+    const auto itemCount = pluginItemModel->getPluginItems().size();
+    if (acceptedItems.size() != itemCount) {
+      acceptedItems.resize(itemCount);
+      updateAcceptedItems(0, itemCount);
+    }
+
+    return acceptedItems.at(sourceRow - 1) != 0;
+  }
+
   const auto sourceIndex = sourceModel()->index(
       sourceRow, PluginItemModel::CARDS_COLUMN, sourceParent);
 
-  auto item = sourceIndex.data(RawDataRole).value<PluginItem>();
-  auto contentFilters =
+  const auto item = sourceIndex.data(RawDataRole).value<PluginItem>();
+  const auto contentFilters =
       sourceIndex.data(CardContentFiltersRole).value<CardContentFiltersState>();
 
+  return filterAcceptsItem(item, contentFilters);
+}
+
+bool PluginItemFilterModel::lessThan(const QModelIndex& sourceLeft,
+                                     const QModelIndex& sourceRight) const {
+  // The general information card is always first, whichever the sort order.
+  if (sourceLeft.row() == 0) {
+    return sortOrder() == Qt::AscendingOrder;
+  }
+  if (sourceRight.row() == 0) {
+    return sortOrder() == Qt::DescendingOrder;
+  }
+
+  // Plugins with no known count are ranked below plugins that have no
+  // overlaps. Equal counts keep their load order, as the sort is stable.
+  const auto leftValue = sourceLeft.data(sortRole());
+  const auto rightValue = sourceRight.data(sortRole());
+  if (!rightValue.isValid()) {
+    return false;
+  }
+  if (!leftValue.isValid()) {
+    return true;
+  }
+
+  return leftValue.toULongLong() < rightValue.toULongLong();
+}
+
+void PluginItemFilterModel::resetFilterResults() {
+  acceptedItems.clear();
+
+  if (std::holds_alternative<QRegularExpression>(filterState.content)) {
+    const auto& regex = std::get<QRegularExpression>(filterState.content);
+    if (regex.pattern() != cachedContentRegexPattern) {
+      cachedContentRegexResults.clear();
+      cachedContentRegexPattern = regex.pattern();
+    }
+  }
+}
+
+void PluginItemFilterModel::updateFilterGroupNames() {
+  filterGroupNames.clear();
+
+  if (!filterState.groupName.has_value()) {
+    return;
+  }
+
+  const auto& groupName = filterState.groupName.value();
+  filterGroupNames.insert(groupName);
+
+  if (filterState.includeLaterGroups && groupGraph) {
+    const auto laterGroups = groupGraph->GetGroupsLoadingAfter(groupName);
+    for (const auto& laterGroup : laterGroups) {
+      filterGroupNames.insert(InternedString(laterGroup));
+    }
+  }
+}
+
+void PluginItemFilterModel::updateDependentPluginNames() {
+  dependentPluginNames.clear();
+
+  if (!filterState.dependencyPluginName.has_value() ||
+      !pluginDependentsIndex) {
+    return;
+  }
+
+  for (const auto& dependent : pluginDependentsIndex->GetDependents(
+           filterState.dependencyPluginName.value())) {
+    dependentPluginNames.insert(NormalisePluginName(dependent));
+  }
+}
+
+void PluginItemFilterModel::onSourceDataChanged(const QModelIndex& topLeft,
+                                                const QModelIndex& bottomRight,
+                                                const QList<int>& roles) {
+  if (acceptedItems.empty()) {
+    return;
+  }
+
+  if (!roles.isEmpty() && !roles.contains(RawDataRole) &&
+      !roles.contains(CardContentFiltersRole)) {
+    // Nothing that is filtered on has changed.
+    return;
+  }
+
+  // The zeroth row is the general information card, which isn't filtered.
+  const auto startRow = std::max(topLeft.row(), 1);
+  const auto endRow = bottomRight.row() + 1;
+  if (endRow <= startRow ||
+      static_cast<size_t>(endRow - 1) > acceptedItems.size()) {
+    acceptedItems.clear();
+    return;
+  }
+
+  updateAcceptedItems(startRow - 1, endRow - 1);
+}
+
+void PluginItemFilterModel::updateAcceptedItems(size_t startIndex,
+                                                size_t endIndex) const {
+  const auto pluginItemModel =
+      qobject_cast<const PluginItemModel*>(sourceModel());
+  if (pluginItemModel == nullptr) {
+    return;
+  }
+
+  const auto& items = pluginItemModel->getPluginItems();
+  const auto& contentFilters = pluginItemModel->getCardContentFiltersState();
+
+  // Filtering happens in response to user input, so it's prioritised over
+  // background work.
+  parallelTransform(
+      items.begin() + startIndex,
+      items.begin() + endIndex,
+      acceptedItems.begin() + startIndex,
+      [&](const PluginItem& item) -> uint8_t {
+        return filterAcceptsItem(item, contentFilters) ? 1 : 0;
+      },
+      TaskPriority::interactive);
+}
+
+bool PluginItemFilterModel::filterAcceptsItem(
+    const PluginItem& item,
+    const CardContentFiltersState& contentFilters) const {
   if (filterState.hideInactivePlugins && !item.isActive) {
     return false;
   }
@@ -112,10 +374,11 @@ bool PluginItemFilterModel::filterAcceptsRow(
     return false;
   }
 
-  if (filterState.groupName.has_value() &&
-      item.group.value_or(Group::DEFAULT_NAME) !=
-          filterState.groupName.value()) {
-    return false;
+  if (filterState.groupName.has_value()) {
+    static const InternedString DEFAULT_GROUP_NAME(Group::DEFAULT_NAME);
+    if (filterGroupNames.count(item.group.value_or(DEFAULT_GROUP_NAME)) == 0) {
+      return false;
+    }
   }
 
   if (std::holds_alternative<std::string>(filterState.content) &&
@@ -123,22 +386,51 @@ bool PluginItemFilterModel::filterAcceptsRow(
     return false;
   }
 
-  if (std::holds_alternative<std::regex>(filterState.content) &&
-      !item.containsMatchingText(std::get<std::regex>(filterState.content))) {
+  if (std::holds_alternative<QRegularExpression>(filterState.content) &&
+      !matchesContentRegex(item)) {
     return false;
   }
 
-  if (filterState.overlapPluginName.has_value()) {
-    const auto hasOverlap =
-        std::any_of(overlappingPluginNames.begin(),
-                    overlappingPluginNames.end(),
-                    [&](const auto& name) { return name == item.name; });
+  if (filterState.overlapPluginName.has_value() &&
+      overlappingPluginNames.count(item.lowercaseName) == 0) {
+    return false;
+  }
 
-    if (!hasOverlap) {
-      return false;
-    }
+  if (filterState.dependencyPluginName.has_value() &&
+      dependentPluginNames.count(item.lowercaseName) == 0) {
+    return false;
   }
 
   return true;
 }
+
+bool PluginItemFilterModel::matchesContentRegex(const PluginItem& item) const {
+  const auto textHash = std::hash<std::string>()(item.lowercaseSearchText);
+
+  {
+    std::lock_guard<std::mutex> guard(cachedContentRegexResultsMutex);
+    const auto it = cachedContentRegexResults.find(item.name);
+    const auto isCached = it != cachedContentRegexResults.end() &&
+                          it->second.first == textHash;
+    contentRegexCacheCounter.recordLookup(isCached);
+    if (isCached) {
+      return it->second.second;
+    }
+  }
+
+  const auto& regex = std::get<QRegularExpression>(filterState.content);
+  const auto matches =
+      item.anyLowercaseSearchField([&regex](std::string_view field) {
+        return regex
+            .match(QString::fromUtf8(field.data(),
+                                     static_cast<qsizetype>(field.size())))
+            .hasMatch();
+      });
+
+  std::lock_guard<std::mutex> guard(cachedContentRegexResultsMutex);
+  cachedContentRegexResults.insert_or_assign(item.name,
+                                             std::make_pair(textHash, matches));
+
+  return matches;
+}
 }
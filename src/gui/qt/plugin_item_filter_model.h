@@ -27,10 +27,22 @@
 #define LOOT_GUI_QT_PLUGIN_ITEM_FILTER_MODEL
 
 #include <QtCore/QSortFilterProxyModel>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "gui/qt/filters_states.h"
+#include "gui/state/game/group_graph.h"
+#include "gui/state/game/plugin_dependents_index.h"
 
 namespace loot {
+struct PluginItem;
+
 class PluginItemFilterModel : public QSortFilterProxyModel {
   Q_OBJECT
 public:
@@ -40,16 +52,73 @@ public:
   void setFiltersState(PluginFiltersState&& state,
                        std::vector<std::string>&& overlappingPluginNames);
 
-  void setSearchResults(QModelIndexList results);
-  void clearSearchResults();
+  // Set the graph of the masterlist and user groups, which is used to find the
+  // groups that load after the group being filtered on.
+  void setGroupGraph(std::shared_ptr<const GroupGraph> graph);
+
+  // Set the index that's used to find the plugins that depend on the plugin
+  // being filtered on.
+  void setPluginDependentsIndex(
+      std::shared_ptr<const PluginDependentsIndex> index);
+
+  // The given indexes are of the first and last visible rows, as only they
+  // need to be signalled as changed. If the first index is invalid, no rows
+  // are visible.
+  void setSearchResults(QModelIndexList results,
+                        const QModelIndex& firstVisibleIndex,
+                        const QModelIndex& lastVisibleIndex);
+  void clearSearchResults(const QModelIndex& firstVisibleIndex,
+                          const QModelIndex& lastVisibleIndex);
+
+  void setSourceModel(QAbstractItemModel* sourceModel) override;
 
 protected:
   bool filterAcceptsRow(int sourceRow,
                         const QModelIndex& sourceParent) const override;
 
+  bool lessThan(const QModelIndex& sourceLeft,
+                const QModelIndex& sourceRight) const override;
+
 private:
   PluginFiltersState filterState;
-  std::vector<std::string> overlappingPluginNames;
+  // Lowercased so that lookups are case-insensitive, like libloot's filename
+  // comparisons.
+  std::unordered_set<std::string> overlappingPluginNames;
+  std::shared_ptr<const GroupGraph> groupGraph;
+  // The groups whose plugins the group filter shows, so that filtering each
+  // plugin is a set lookup.
+  std::unordered_set<InternedString> filterGroupNames;
+  std::shared_ptr<const PluginDependentsIndex> pluginDependentsIndex;
+  // The lowercased names of the plugins that the dependents filter shows.
+  std::unordered_set<std::string> dependentPluginNames;
+
+  // Regex matching is relatively expensive, so cache the results for the
+  // current content filter regex, keyed on plugin name. Each result is stored
+  // with a hash of the text it was matched against, so that it's not used if
+  // the item's content changes.
+  QString cachedContentRegexPattern;
+  mutable std::unordered_map<std::string, std::pair<size_t, bool>>
+      cachedContentRegexResults;
+  mutable std::mutex cachedContentRegexResultsMutex;
+
+  // Qt filters rows one at a time on the UI thread, so instead evaluate the
+  // filters for all of the source model's plugin items in parallel the first
+  // time that a row is filtered, and then just look up the result. This is
+  // empty if the results need to be recalculated.
+  mutable std::vector<uint8_t> acceptedItems;
+  std::vector<QMetaObject::Connection> sourceModelConnections;
+
+  void resetFilterResults();
+  void updateFilterGroupNames();
+  void updateDependentPluginNames();
+  void onSourceDataChanged(const QModelIndex& topLeft,
+                           const QModelIndex& bottomRight,
+                           const QList<int>& roles);
+  void updateAcceptedItems(size_t startIndex, size_t endIndex) const;
+
+  bool filterAcceptsItem(const PluginItem& item,
+                         const CardContentFiltersState& contentFilters) const;
+  bool matchesContentRegex(const PluginItem& item) const;
 };
 }
 
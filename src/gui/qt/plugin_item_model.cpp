@@ -27,11 +27,60 @@
 
 #include <QtCore/QMimeData>
 #include <QtCore/QSize>
+#include <algorithm>
+#include <unordered_set>
 
+#include "gui/helpers.h"
 #include "gui/qt/helpers.h"
 #include "gui/qt/icon_factory.h"
 
 namespace loot {
+InternedString getGroupOrDefault(const PluginItem& item) {
+  static const InternedString DEFAULT_GROUP_NAME(Group::DEFAULT_NAME);
+  return item.group.value_or(DEFAULT_GROUP_NAME);
+}
+
+bool isCardContentAffected(const PluginItem& item,
+                           const CardContentFiltersState& oldFilters,
+                           const CardContentFiltersState& newFilters) {
+  if (oldFilters.hideVersionNumbers != newFilters.hideVersionNumbers &&
+      item.version.has_value()) {
+    return true;
+  }
+
+  if (oldFilters.hideCRCs != newFilters.hideCRCs && item.crc.has_value()) {
+    return true;
+  }
+
+  if (oldFilters.hideBashTags != newFilters.hideBashTags &&
+      !(item.currentTags.empty() && item.addTags.empty() &&
+        item.removeTags.empty())) {
+    return true;
+  }
+
+  if (oldFilters.hideLocations != newFilters.hideLocations &&
+      !item.locations.empty()) {
+    return true;
+  }
+
+  if (!hideSameMessages(oldFilters, newFilters)) {
+    const auto isHidden = [&](const SourcedMessage& message,
+                              const CardContentFiltersState& filters) {
+      return filters.hideAllPluginMessages ||
+             shouldFilterMessage(item, message, filters);
+    };
+
+    return std::any_of(item.messages.begin(),
+                       item.messages.end(),
+                       [&](const SourcedMessage& message) {
+                         return isHidden(message, oldFilters) !=
+                                isHidden(message, newFilters);
+                       });
+  }
+
+  return false;
+}
+
 SearchResultData::SearchResultData(bool isResult, bool isCurrentResult) :
     isResult(isResult), isCurrentResult(isCurrentResult) {}
 
@@ -48,7 +97,8 @@ int PluginItemModel::columnCount(const QModelIndex&) const {
                                                 SIDEBAR_INDEX_COLUMN,
                                                 SIDEBAR_NAME_COLUMN,
                                                 SIDEBAR_STATE_COLUMN,
-                                                CARDS_COLUMN}) +
+                                                CARDS_COLUMN,
+                                                SIDEBAR_OVERLAPS_COLUMN}) +
                                       1;
   return COLUMN_COUNT;
 }
@@ -76,13 +126,12 @@ QVariant PluginItemModel::data(const QModelIndex& index, int role) const {
 
   if (index.row() == 0) {
     if (index.column() == CARDS_COLUMN && role == CountersRole) {
-      const auto counters =
-          GeneralInformationCounters(generalInformation.generalMessages, items);
-      return QVariant::fromValue(counters);
+      return QVariant::fromValue(getCounters());
     }
   } else {
     const int itemsIndex = index.row() - 1;
     const auto& plugin = items.at(itemsIndex);
+    const auto& sidebar = sidebarData.at(itemsIndex);
 
     switch (index.column()) {
       case SIDEBAR_POSITION_COLUMN: {
@@ -94,7 +143,7 @@ QVariant PluginItemModel::data(const QModelIndex& index, int role) const {
       }
       case SIDEBAR_INDEX_COLUMN: {
         if (role == Qt::DisplayRole) {
-          return QString::fromStdString(plugin.loadOrderIndexText());
+          return sidebar.loadOrderIndexText;
         }
 
         break;
@@ -102,8 +151,10 @@ QVariant PluginItemModel::data(const QModelIndex& index, int role) const {
       case SIDEBAR_NAME_COLUMN: {
         if (role == EditorStateRole) {
           return currentEditorPluginName.has_value();
-        } else if (role == DragRole) {
-          return QString::fromStdString(plugin.name);
+        } else if (role == DragRole || role == SidebarNameRole) {
+          return sidebar.name;
+        } else if (role == SidebarGroupRole) {
+          return sidebar.group;
         }
 
         break;
@@ -116,7 +167,7 @@ QVariant PluginItemModel::data(const QModelIndex& index, int role) const {
         if (role == Qt::DecorationRole) {
           if (isCurrentEditorPlugin) {
             return IconFactory::getEditIcon();
-          } else if (plugin.hasUserMetadata) {
+          } else if (sidebar.hasUserMetadata) {
             return IconFactory::getHasUserMetadataIcon();
           } else {
             return QVariant();
@@ -124,7 +175,7 @@ QVariant PluginItemModel::data(const QModelIndex& index, int role) const {
         } else if (role == Qt::ToolTipRole) {
           if (isCurrentEditorPlugin) {
             return translate("Editor Is Open");
-          } else if (plugin.hasUserMetadata) {
+          } else if (sidebar.hasUserMetadata) {
             return translate("Has User Metadata");
           } else {
             return QVariant();
@@ -153,6 +204,23 @@ QVariant PluginItemModel::data(const QModelIndex& index, int role) const {
 
         break;
       }
+      case SIDEBAR_OVERLAPS_COLUMN: {
+        if (role != Qt::DisplayRole && role != OverlapCountRole) {
+          break;
+        }
+
+        const auto overlapCount = getOverlapCount(plugin);
+        if (overlapCount == nullptr) {
+          return QVariant();
+        }
+
+        if (role == Qt::DisplayRole) {
+          return QString::number(overlapCount->count);
+        }
+
+        return QVariant::fromValue(
+            static_cast<qulonglong>(overlapCount->count));
+      }
       default:
         return QVariant();
     }
@@ -179,6 +247,8 @@ QVariant PluginItemModel::headerData(int section,
       return translate("Index");
     case SIDEBAR_NAME_COLUMN:
       return translate("Plugin Name");
+    case SIDEBAR_OVERLAPS_COLUMN:
+      return translate("Overlaps");
     default:
       return QVariant();
   }
@@ -201,10 +271,14 @@ QMimeData* PluginItemModel::mimeData(const QModelIndexList& indexes) const {
   QMimeData* mimeData = new QMimeData();
   QByteArray encodedData;
 
+  // A dragged row's indexes include every column, but only the name column
+  // has drag data. Only one plugin name can be dropped, so if several rows
+  // are dragged only the first row's name is used.
   for (const QModelIndex& index : indexes) {
-    if (index.isValid() && index.row() > 0) {
-      QString text = data(index, DragRole).toString();
-      encodedData.append(text.toUtf8());
+    if (index.isValid() && index.row() > 0 &&
+        index.column() == SIDEBAR_NAME_COLUMN) {
+      encodedData.append(sidebarData.at(index.row() - 1).name.toUtf8());
+      break;
     }
   }
 
@@ -238,6 +312,16 @@ bool PluginItemModel::setData(const QModelIndex& index,
       auto dataHasChanged = false;
       if (existingIsResult != newData.isResult) {
         searchResults.at(searchResultsIndex) = newData.isResult;
+
+        const auto row = index.row();
+        const auto it = std::lower_bound(
+            searchResultRows.begin(), searchResultRows.end(), row);
+        if (newData.isResult) {
+          searchResultRows.insert(it, row);
+        } else {
+          searchResultRows.erase(it);
+        }
+
         dataHasChanged = true;
       }
 
@@ -280,8 +364,25 @@ bool PluginItemModel::setData(const QModelIndex& index,
     generalInformation = value.value<GeneralInformation>();
   } else {
     const int itemsIndex = index.row() - 1;
+    auto newItem = value.value<PluginItem>();
+
+    // The item may be a copy of an existing item with changed content, so
+    // don't rely on its derived data being up to date.
+    newItem.updateLowercaseSearchText();
+    newItem.updateMessagesHash();
+
+    if (newItem.name != items.at(itemsIndex).name) {
+      pluginRows.erase(items.at(itemsIndex).lowercaseName);
+      pluginRows.insert_or_assign(newItem.lowercaseName, index.row());
+      pluginNamePrefixIndex.reset();
+    }
+
+    removeItemCounts(items.at(itemsIndex));
+    addItemCounts(newItem);
 
-    items.at(itemsIndex) = value.value<PluginItem>();
+    sidebarData.at(itemsIndex) = getSidebarData(newItem);
+    items.at(itemsIndex) = std::move(newItem);
+    contentSearchTexts.reset();
   }
 
   // The RawDataRole data changed, emit dataChanged for all columns.
@@ -306,42 +407,385 @@ std::vector<std::string> PluginItemModel::getPluginNames() const {
   return pluginNames;
 }
 
-std::unordered_map<std::string, int> PluginItemModel::getPluginNameToRowMap()
+std::optional<int> PluginItemModel::getPluginRow(
+    const std::string& pluginName) const {
+  const auto it = pluginRows.find(NormalisePluginName(pluginName));
+  if (it == pluginRows.end()) {
+    return std::nullopt;
+  }
+
+  return it->second;
+}
+
+const PluginNamePrefixIndex& PluginItemModel::getPluginNamePrefixIndex()
     const {
-  std::unordered_map<std::string, int> nameToRowMap;
-  const int size = rowCount() - 1;
-  nameToRowMap.reserve(size);
+  if (!pluginNamePrefixIndex.has_value()) {
+    std::vector<std::pair<std::string, int>> foldedNameRows(
+        pluginRows.begin(), pluginRows.end());
+    pluginNamePrefixIndex = PluginNamePrefixIndex(std::move(foldedNameRows));
+  }
+
+  return pluginNamePrefixIndex.value();
+}
 
-  for (int i = 1; i < rowCount(); i += 1) {
-    // The column we choose doesn't matter, it's the same data for both.
-    const auto index = this->index(i, 0);
-    auto indexName = index.data(RawDataRole).value<PluginItem>().name;
+ContentSearchTexts PluginItemModel::getContentSearchTexts() const {
+  if (!contentSearchTexts) {
+    auto texts = std::make_shared<std::vector<QString>>();
+    texts->reserve(items.size());
 
-    nameToRowMap.emplace(indexName, i);
+    for (const auto& item : items) {
+      texts->push_back(QString::fromStdString(item.contentToSearch()));
+    }
+
+    contentSearchTexts = texts;
   }
 
-  return nameToRowMap;
+  return contentSearchTexts;
+}
+
+GeneralInformationCounters PluginItemModel::getCounters() const {
+  auto counters = pluginCounters;
+  counters.addMessages(generalInformation.generalMessages);
+
+  return counters;
+}
+
+size_t PluginItemModel::getHiddenMessageCount() const {
+  return hiddenMessageCounts.count(cardContentFiltersState);
+}
+
+const std::unordered_map<InternedString, size_t>&
+PluginItemModel::getGroupPluginCounts() const {
+  return groupPluginCounts;
 }
 
 void PluginItemModel::setPluginItems(std::vector<PluginItem>&& newItems) {
-  if (!items.empty()) {
-    beginRemoveRows(QModelIndex(), 1, static_cast<int>(items.size()));
+  if (!items.empty() && items.size() == newItems.size()) {
+    // If only the plugins' order and data have changed, update the existing
+    // rows so that views and proxy models don't need to start from scratch.
+    std::unordered_map<std::string, size_t> newPositions;
+    for (size_t i = 0; i < newItems.size(); i += 1) {
+      newPositions.emplace(newItems[i].name, i);
+    }
+
+    const auto hasSamePlugins =
+        newPositions.size() == newItems.size() &&
+        std::all_of(items.begin(), items.end(), [&](const PluginItem& item) {
+          return newPositions.count(item.name) != 0;
+        });
+
+    if (hasSamePlugins) {
+      updatePluginItems(std::move(newItems), newPositions);
+      return;
+    }
+  }
 
-    items.clear();
-    searchResults.clear();
-    currentSearchResultIndex = std::nullopt;
+  clearPluginItems();
 
-    endRemoveRows();
+  if (newItems.empty()) {
+    return;
   }
 
   beginInsertRows(QModelIndex(), 1, static_cast<int>(newItems.size()));
 
   std::swap(items, newItems);
+  updatePluginRows();
+  updateSidebarData();
+  contentSearchTexts.reset();
+  searchResults.resize(items.size(), false);
+  recalculateItemCounts();
+
+  endInsertRows();
+}
+
+bool PluginItemModel::canUpdatePluginItemsInPlace(
+    const std::vector<PluginItem>& newItems) const {
+  if (items.empty() || items.size() != newItems.size()) {
+    return false;
+  }
+
+  std::unordered_set<std::string> newNames;
+  for (const auto& item : newItems) {
+    newNames.insert(item.name);
+  }
+
+  return newNames.size() == newItems.size() &&
+         std::all_of(items.begin(), items.end(), [&](const PluginItem& item) {
+           return newNames.count(item.name) != 0;
+         });
+}
+
+void PluginItemModel::clearPluginItems() {
+  if (items.empty()) {
+    return;
+  }
+
+  beginRemoveRows(QModelIndex(), 1, static_cast<int>(items.size()));
+
+  items.clear();
+  sidebarData.clear();
+  pluginRows.clear();
+  pluginNamePrefixIndex.reset();
+  contentSearchTexts.reset();
+  searchResults.clear();
+  searchResultRows.clear();
+  currentSearchResultIndex = std::nullopt;
+  recalculateItemCounts();
+
+  endRemoveRows();
+}
+
+void PluginItemModel::appendPluginItems(std::vector<PluginItem>&& newItems) {
+  if (newItems.empty()) {
+    return;
+  }
+
+  // Row 0 is the general information card.
+  const auto firstRow = static_cast<int>(items.size()) + 1;
+  const auto lastRow = firstRow + static_cast<int>(newItems.size()) - 1;
+
+  beginInsertRows(QModelIndex(), firstRow, lastRow);
+
+  items.reserve(items.size() + newItems.size());
+  sidebarData.reserve(items.size() + newItems.size());
+  for (auto& item : newItems) {
+    pluginRows.emplace(item.lowercaseName, static_cast<int>(items.size()) + 1);
+    addItemCounts(item);
+    sidebarData.push_back(getSidebarData(item));
+    items.push_back(std::move(item));
+  }
+  pluginNamePrefixIndex.reset();
+  contentSearchTexts.reset();
   searchResults.resize(items.size(), false);
 
   endInsertRows();
 }
 
+void PluginItemModel::replacePluginItems(std::vector<PluginItem>&& newItems) {
+  std::optional<int> firstChangedRow;
+  std::optional<int> lastChangedRow;
+
+  for (auto& newItem : newItems) {
+    const auto row = getPluginRow(newItem.name);
+    if (!row.has_value()) {
+      continue;
+    }
+
+    auto& item = items.at(row.value() - 1);
+    if (item == newItem) {
+      continue;
+    }
+
+    removeItemCounts(item);
+    addItemCounts(newItem);
+    sidebarData.at(row.value() - 1) = getSidebarData(newItem);
+    item = std::move(newItem);
+
+    firstChangedRow = std::min(firstChangedRow.value_or(*row), *row);
+    lastChangedRow = std::max(lastChangedRow.value_or(*row), *row);
+  }
+
+  if (!firstChangedRow.has_value()) {
+    return;
+  }
+
+  contentSearchTexts.reset();
+
+  emit dataChanged(index(firstChangedRow.value(), 0),
+                   index(lastChangedRow.value(), columnCount() - 1),
+                   {RawDataRole});
+}
+
+bool PluginItemModel::replacePluginItem(PluginItem&& newItem) {
+  const auto row = getPluginRow(newItem.name);
+  if (!row.has_value()) {
+    return false;
+  }
+
+  auto& item = items.at(row.value() - 1);
+  if (item == newItem) {
+    return true;
+  }
+
+  removeItemCounts(item);
+  addItemCounts(newItem);
+  sidebarData.at(row.value() - 1) = getSidebarData(newItem);
+  item = std::move(newItem);
+
+  contentSearchTexts.reset();
+
+  emit dataChanged(index(row.value(), 0),
+                   index(row.value(), columnCount() - 1),
+                   {RawDataRole});
+
+  return true;
+}
+
+void PluginItemModel::updatePluginItems(
+    std::vector<PluginItem>&& newItems,
+    const std::unordered_map<std::string, size_t>& newPositions) {
+  // Sorting usually only moves plugins within a small window of the load
+  // order, and the rows before and after that window stay where they are.
+  const auto hasSameName = [&](size_t i) {
+    return items.at(i).name == newItems.at(i).name;
+  };
+  size_t windowStart = 0;
+  while (windowStart < items.size() && hasSameName(windowStart)) {
+    windowStart += 1;
+  }
+  size_t windowEnd = items.size();
+  while (windowEnd > windowStart && hasSameName(windowEnd - 1)) {
+    windowEnd -= 1;
+  }
+
+  const auto isReordered = windowStart < windowEnd;
+
+  const auto getNewRow = [&](int oldRow) {
+    // Row 0 is the general information card, which doesn't move.
+    if (oldRow == 0) {
+      return 0;
+    }
+
+    const auto oldIndex = static_cast<size_t>(oldRow) - 1;
+    if (oldIndex < windowStart || oldIndex >= windowEnd) {
+      return oldRow;
+    }
+
+    return static_cast<int>(newPositions.at(items.at(oldIndex).name)) + 1;
+  };
+
+  if (isReordered) {
+    emit layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+
+    QModelIndexList oldIndexes;
+    QModelIndexList newIndexes;
+    for (const auto& oldIndex : persistentIndexList()) {
+      const auto newRow = getNewRow(oldIndex.row());
+      if (newRow != oldIndex.row()) {
+        oldIndexes.append(oldIndex);
+        newIndexes.append(index(newRow, oldIndex.column()));
+      }
+    }
+    changePersistentIndexList(oldIndexes, newIndexes);
+  }
+
+  std::vector<bool> newSearchResults(searchResults.size(), false);
+  std::optional<int> firstChangedRow;
+  std::optional<int> lastChangedRow;
+  for (size_t i = 0; i < items.size(); i += 1) {
+    const auto newRow = getNewRow(static_cast<int>(i) + 1);
+    const auto newIndex = static_cast<size_t>(newRow) - 1;
+
+    newSearchResults.at(newIndex) = searchResults.at(i);
+
+    if (items.at(i) != newItems.at(newIndex)) {
+      removeItemCounts(items.at(i));
+      addItemCounts(newItems.at(newIndex));
+
+      firstChangedRow = std::min(firstChangedRow.value_or(newRow), newRow);
+      lastChangedRow = std::max(lastChangedRow.value_or(newRow), newRow);
+    }
+  }
+
+  if (currentSearchResultIndex.has_value()) {
+    currentSearchResultIndex =
+        getNewRow(currentSearchResultIndex.value() + 1) - 1;
+  }
+
+  std::swap(items, newItems);
+  for (auto i = windowStart; i < windowEnd; i += 1) {
+    pluginRows.insert_or_assign(items[i].lowercaseName,
+                                static_cast<int>(i) + 1);
+  }
+  pluginNamePrefixIndex.reset();
+  updateSidebarData();
+  searchResults = std::move(newSearchResults);
+  updateSearchResultRows();
+  contentSearchTexts.reset();
+
+  if (isReordered) {
+    emit layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+  }
+
+  // Emit a single signal for the range of changed rows, as each signal
+  // causes the main window to recalculate counts and refresh searches.
+  if (firstChangedRow.has_value()) {
+    emit dataChanged(index(firstChangedRow.value(), 0),
+                     index(lastChangedRow.value(), columnCount() - 1));
+  }
+}
+
+void PluginItemModel::addItemCounts(const PluginItem& item) {
+  pluginCounters.addPlugin(item);
+  hiddenMessageCounts.add(HiddenMessageCounts(item));
+  groupPluginCounts[getGroupOrDefault(item)] += 1;
+}
+
+void PluginItemModel::removeItemCounts(const PluginItem& item) {
+  pluginCounters.removePlugin(item);
+  hiddenMessageCounts.remove(HiddenMessageCounts(item));
+
+  const auto it = groupPluginCounts.find(getGroupOrDefault(item));
+  if (it != groupPluginCounts.end()) {
+    it->second -= 1;
+    if (it->second == 0) {
+      groupPluginCounts.erase(it);
+    }
+  }
+}
+
+void PluginItemModel::recalculateItemCounts() {
+  pluginCounters = GeneralInformationCounters();
+  hiddenMessageCounts = HiddenMessageCounts();
+  groupPluginCounts.clear();
+
+  for (const auto& item : items) {
+    addItemCounts(item);
+  }
+}
+
+void PluginItemModel::updatePluginRows() {
+  pluginRows.clear();
+  pluginNamePrefixIndex.reset();
+  pluginRows.reserve(items.size());
+
+  for (size_t i = 0; i < items.size(); i += 1) {
+    pluginRows.emplace(items[i].lowercaseName, static_cast<int>(i) + 1);
+  }
+}
+
+void PluginItemModel::updateSidebarData() {
+  sidebarData.clear();
+  sidebarData.reserve(items.size());
+
+  for (const auto& item : items) {
+    sidebarData.push_back(getSidebarData(item));
+  }
+}
+
+PluginItemModel::SidebarData PluginItemModel::getSidebarData(
+    const PluginItem& item) {
+  SidebarData data;
+  data.name = QString::fromStdString(item.name);
+  data.loadOrderIndexText = QString::fromStdString(item.loadOrderIndexText());
+  if (item.group.has_value() &&
+      item.group.value().str() != Group::DEFAULT_NAME) {
+    data.group = QString::fromStdString(item.group.value());
+  }
+  data.hasUserMetadata = item.hasUserMetadata;
+
+  return data;
+}
+
+void PluginItemModel::updateSearchResultRows() {
+  searchResultRows.clear();
+  for (size_t i = 0; i < searchResults.size(); i += 1) {
+    if (searchResults.at(i)) {
+      searchResultRows.push_back(static_cast<int>(i) + 1);
+    }
+  }
+}
+
 void PluginItemModel::setEditorPluginName(
     const std::optional<std::string>& editorPluginName) {
   currentEditorPluginName = editorPluginName;
@@ -394,34 +838,140 @@ const GeneralInformation& PluginItemModel::getGeneralInfo() const {
   return generalInformation;
 }
 
+const CardContentFiltersState& PluginItemModel::getCardContentFiltersState()
+    const {
+  return cardContentFiltersState;
+}
+
 void PluginItemModel::setCardContentFiltersState(
     CardContentFiltersState&& state) {
+  // The hidden message counts don't depend on the filters, so toggling
+  // filters doesn't need any messages to be recounted.
+  const auto oldState = std::move(cardContentFiltersState);
   cardContentFiltersState = std::move(state);
 
-  const auto startIndex = index(1, CARDS_COLUMN);
-  const auto endIndex = index(rowCount() - 1, CARDS_COLUMN);
-  emit dataChanged(startIndex, endIndex, {CardContentFiltersRole});
+  // Most filters only affect cards that have the content that they hide, and
+  // signalling that other cards have changed would cause them to be re-sized
+  // and re-rendered for no reason, so only signal runs of affected rows.
+  std::optional<int> firstChangedRow;
+  const auto emitChangedRows = [&](int lastChangedRow) {
+    if (firstChangedRow.has_value()) {
+      emit dataChanged(index(firstChangedRow.value(), CARDS_COLUMN),
+                       index(lastChangedRow, CARDS_COLUMN),
+                       {CardContentFiltersRole});
+      firstChangedRow = std::nullopt;
+    }
+  };
+
+  for (size_t i = 0; i < items.size(); i += 1) {
+    const auto row = static_cast<int>(i) + 1;
+    if (isCardContentAffected(items.at(i), oldState, cardContentFiltersState)) {
+      if (!firstChangedRow.has_value()) {
+        firstChangedRow = row;
+      }
+    } else {
+      emitChangedRows(row - 1);
+    }
+  }
+
+  emitChangedRows(rowCount() - 1);
 }
 
-QModelIndex PluginItemModel::setCurrentSearchResult(size_t resultIndex) {
-  size_t currentResultIndex = 0;
-  for (size_t i = 0; i < searchResults.size(); i += 1) {
-    const auto isResult = searchResults.at(i);
-    if (isResult && currentResultIndex == resultIndex) {
-      const auto row = static_cast<int>(i) + 1;
-      auto modelIndex = index(row, CARDS_COLUMN);
-      // This setData will also handle unsetting the previous current result.
-      setData(modelIndex,
-              QVariant::fromValue(SearchResultData(true, true)),
-              SearchResultRole);
-      return modelIndex;
+void PluginItemModel::setSearchResults(
+    const std::vector<std::pair<int, bool>>& rowResults,
+    int firstVisibleRow,
+    int lastVisibleRow) {
+  std::optional<int> firstChangedRow;
+  std::optional<int> lastChangedRow;
+
+  for (const auto& [row, isResult] : rowResults) {
+    if (row <= 0 || row >= rowCount()) {
+      continue;
     }
 
-    if (isResult) {
-      currentResultIndex += 1;
+    const int searchResultsIndex = row - 1;
+
+    auto dataHasChanged = false;
+    if (searchResults.at(searchResultsIndex) != isResult) {
+      searchResults.at(searchResultsIndex) = isResult;
+      dataHasChanged = true;
     }
+
+    if (currentSearchResultIndex.has_value() &&
+        currentSearchResultIndex.value() == searchResultsIndex) {
+      currentSearchResultIndex = std::nullopt;
+      dataHasChanged = true;
+    }
+
+    if (dataHasChanged) {
+      firstChangedRow = std::min(firstChangedRow.value_or(row), row);
+      lastChangedRow = std::max(lastChangedRow.value_or(row), row);
+    }
+  }
+
+  if (firstChangedRow.has_value() && lastChangedRow.has_value()) {
+    // Rebuilding the rows once is cheaper than inserting or erasing each
+    // changed row individually.
+    updateSearchResultRows();
+
+    // A broad search can change most rows, and signalling them all would
+    // cause the views to process every one of them.
+    const auto firstRowToSignal =
+        std::max(firstChangedRow.value(), firstVisibleRow);
+    const auto lastRowToSignal =
+        std::min(lastChangedRow.value(), lastVisibleRow);
+
+    if (firstRowToSignal <= lastRowToSignal) {
+      emit dataChanged(index(firstRowToSignal, CARDS_COLUMN),
+                       index(lastRowToSignal, CARDS_COLUMN),
+                       {SearchResultRole});
+    }
+  }
+}
+
+QModelIndex PluginItemModel::setCurrentSearchResult(size_t resultIndex) {
+  if (resultIndex >= searchResultRows.size()) {
+    return QModelIndex();
+  }
+
+  auto modelIndex = index(searchResultRows.at(resultIndex), CARDS_COLUMN);
+  // This setData will also handle unsetting the previous current result.
+  setData(modelIndex,
+          QVariant::fromValue(SearchResultData(true, true)),
+          SearchResultRole);
+  return modelIndex;
+}
+
+void PluginItemModel::setOverlapCounts(
+    std::unordered_map<std::string, OverlapCount>&& counts) {
+  overlapCounts = std::move(counts);
+
+  if (items.empty()) {
+    return;
+  }
+
+  emit dataChanged(index(1, SIDEBAR_OVERLAPS_COLUMN),
+                   index(rowCount() - 1, SIDEBAR_OVERLAPS_COLUMN),
+                   {Qt::DisplayRole, OverlapCountRole});
+}
+
+bool PluginItemModel::hasPluginsWithoutOverlapCounts() const {
+  return std::any_of(items.begin(), items.end(), [&](const PluginItem& item) {
+    return getOverlapCount(item) == nullptr;
+  });
+}
+
+const OverlapCount* PluginItemModel::getOverlapCount(
+    const PluginItem& item) const {
+  if (!item.crc.has_value()) {
+    return nullptr;
+  }
+
+  const auto it = overlapCounts.find(item.name);
+  if (it == overlapCounts.end() || it->second.crc != item.crc.value()) {
+    return nullptr;
   }
 
-  return QModelIndex();
+  return &it->second;
 }
 }
@@ -29,10 +29,13 @@
 #include <QtCore/QAbstractListModel>
 
 #include "gui/plugin_item.h"
+#include "gui/plugin_name_prefix_index.h"
+#include "gui/qt/card_search.h"
 #include "gui/qt/counters.h"
 #include "gui/qt/filters_states.h"
 #include "gui/qt/general_info.h"
 #include "gui/qt/helpers.h"
+#include "gui/state/game/record_overlap_index.h"
 
 Q_DECLARE_METATYPE(loot::PluginItem);
 
@@ -44,6 +47,9 @@ static constexpr int CardContentFiltersRole = Qt::UserRole + 5;
 static constexpr int ContentSearchRole = Qt::UserRole + 6;
 static constexpr int DragRole = Qt::UserRole + 7;
 static constexpr int SearchResultRole = Qt::UserRole + 8;
+static constexpr int SidebarNameRole = Qt::UserRole + 9;
+static constexpr int SidebarGroupRole = Qt::UserRole + 10;
+static constexpr int OverlapCountRole = Qt::UserRole + 11;
 
 struct SearchResultData {
   SearchResultData() = default;
@@ -61,6 +67,7 @@ public:
   static constexpr int SIDEBAR_NAME_COLUMN = 2;
   static constexpr int SIDEBAR_STATE_COLUMN = 3;
   static constexpr int CARDS_COLUMN = 4;
+  static constexpr int SIDEBAR_OVERLAPS_COLUMN = 5;
 
   explicit PluginItemModel(QObject* parent);
 
@@ -89,10 +96,55 @@ public:
 
   std::vector<std::string> getPluginNames() const;
 
-  std::unordered_map<std::string, int> getPluginNameToRowMap() const;
+  // Get the row of the plugin with the given name, which is looked up
+  // case-insensitively.
+  std::optional<int> getPluginRow(const std::string& pluginName) const;
+
+  // Get an index of the plugins' lowercased names, which is built when first
+  // needed after the plugins change.
+  const PluginNamePrefixIndex& getPluginNamePrefixIndex() const;
+
+  // Get the text to search for each plugin item, which is built when first
+  // needed after the items change. It's immutable so that it can be searched
+  // on another thread.
+  ContentSearchTexts getContentSearchTexts() const;
+
+  // Get the counts for the general messages and plugin items. The plugin
+  // items' counts are kept up to date as items change, rather than being
+  // recalculated from every item.
+  GeneralInformationCounters getCounters() const;
+
+  // Get the number of plugin messages hidden by the current card content
+  // filters.
+  size_t getHiddenMessageCount() const;
+
+  // Get the number of plugins in each group. Plugins with no group are
+  // counted in the default group.
+  const std::unordered_map<InternedString, size_t>& getGroupPluginCounts()
+      const;
 
   void setPluginItems(std::vector<PluginItem>&& items);
 
+  // Returns true if setting the given items would update the existing rows
+  // in place, because the items are for the same plugins as the model has.
+  bool canUpdatePluginItemsInPlace(const std::vector<PluginItem>& items) const;
+
+  // Remove all plugin items, leaving only the general information row.
+  void clearPluginItems();
+
+  // Append the given items after the existing items, so that items can be
+  // displayed while the rest are still being created.
+  void appendPluginItems(std::vector<PluginItem>&& items);
+
+  // Replace the items for the plugins that have the same names as the given
+  // items, ignoring any that aren't in the model. A single dataChanged signal
+  // is emitted for the range of rows that changed, if any.
+  void replacePluginItems(std::vector<PluginItem>&& newItems);
+
+  // Replace the item for the plugin that has the same name as the given item,
+  // without copying it. Returns false if the plugin isn't in the model.
+  bool replacePluginItem(PluginItem&& newItem);
+
   void setEditorPluginName(const std::optional<std::string>& editorPluginName);
 
   void setGeneralInformation(bool gameSupportsLightPlugins,
@@ -109,18 +161,85 @@ public:
 
   const GeneralInformation& getGeneralInfo() const;
 
+  const CardContentFiltersState& getCardContentFiltersState() const;
+
   void setCardContentFiltersState(CardContentFiltersState&& state);
 
+  // Sets whether each of the given rows are search results, and unsets the
+  // current search result if it's one of them. Search results are read when
+  // cards are painted, so a single dataChanged signal is only emitted for the
+  // changed rows between the given visible rows, and other rows show their
+  // new state once they're scrolled into view.
+  void setSearchResults(const std::vector<std::pair<int, bool>>& rowResults,
+                        int firstVisibleRow,
+                        int lastVisibleRow);
+
   QModelIndex setCurrentSearchResult(size_t resultIndex);
 
+  // Set the number of other plugins that each plugin has overlapping records
+  // with, keyed by the plugins' names. Counts are only used for plugins that
+  // have the same CRC as when they were counted, so that a plugin that has
+  // changed since has no count.
+  void setOverlapCounts(std::unordered_map<std::string, OverlapCount>&& counts);
+
+  // Returns true if there's a plugin item that has no overlap count.
+  bool hasPluginsWithoutOverlapCounts() const;
+
 private:
+  const OverlapCount* getOverlapCount(const PluginItem& item) const;
+
+  // The data that the sidebar displays for a plugin, formatted when its item
+  // is set so that painting the sidebar doesn't copy or format whole items.
+  struct SidebarData {
+    QString name;
+    QString loadOrderIndexText;
+    // Empty if the plugin is in the default group.
+    QString group;
+    bool hasUserMetadata{false};
+  };
+
   GeneralInformation generalInformation;
   std::vector<PluginItem> items;
+  // Kept parallel to items.
+  std::vector<SidebarData> sidebarData;
+  // Maps lowercased plugin names to their rows.
+  std::unordered_map<std::string, int> pluginRows;
+  mutable std::optional<PluginNamePrefixIndex> pluginNamePrefixIndex;
+  mutable ContentSearchTexts contentSearchTexts;
   std::vector<bool> searchResults;
+  // The rows of the search results in ascending order, so that the N-th
+  // result can be found without walking searchResults.
+  std::vector<int> searchResultRows;
   std::optional<int> currentSearchResultIndex;
+  std::unordered_map<std::string, OverlapCount> overlapCounts;
 
   std::optional<std::string> currentEditorPluginName;
   CardContentFiltersState cardContentFiltersState;
+
+  GeneralInformationCounters pluginCounters;
+  // The counts are for the game in the card content filters state.
+  HiddenMessageCounts hiddenMessageCounts;
+  std::unordered_map<InternedString, size_t> groupPluginCounts;
+
+  void addItemCounts(const PluginItem& item);
+  void removeItemCounts(const PluginItem& item);
+  void recalculateItemCounts();
+
+  // Replaces the current items with the given items, which must be for the
+  // same plugins, moving and updating rows rather than resetting them.
+  void updatePluginItems(
+      std::vector<PluginItem>&& newItems,
+      const std::unordered_map<std::string, size_t>& newPositions);
+
+  void updatePluginRows();
+
+  // Rebuilds sidebarData from items.
+  void updateSidebarData();
+
+  static SidebarData getSidebarData(const PluginItem& item);
+
+  // Rebuilds searchResultRows from searchResults.
+  void updateSearchResultRows();
 };
 }
 
@@ -0,0 +1,141 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/qt/plugin_items_committer.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QTimer>
+#include <algorithm>
+#include <iterator>
+
+#include "gui/state/memory_accounting.h"
+#include "gui/state/timing.h"
+
+namespace {
+// Leave most of each 16 ms frame for the event loop.
+constexpr qint64 SLICE_DURATION_MS = 8;
+
+// Inserting rows one at a time would make proxy models and views handle a
+// rowsInserted signal per plugin, so insert them in small chunks.
+constexpr size_t ROWS_PER_CHUNK = 16;
+}
+
+namespace loot {
+PluginItemsCommitter::PluginItemsCommitter(QObject* parent,
+                                           PluginItemModel* model) :
+    QObject(parent), model(model) {}
+
+void PluginItemsCommitter::commit(std::vector<PluginItem>&& items,
+                                  std::function<void()> onCommitted) {
+  // The new items replace any that are still pending, so don't bother
+  // inserting them.
+  reset();
+
+  if (model->canUpdatePluginItemsInPlace(items)) {
+    model->setPluginItems(std::move(items));
+    onCommitted();
+    return;
+  }
+
+  model->clearPluginItems();
+
+  pendingItems = std::move(items);
+  nextItemIndex = 0;
+  this->onCommitted = std::move(onCommitted);
+
+  // Insert the first slice immediately so that the top of the list is
+  // displayed as soon as possible.
+  insertSlice();
+}
+
+void PluginItemsCommitter::cancel() {
+  if (isCommitting() && nextItemIndex < pendingItems.size()) {
+    model->appendPluginItems(std::vector<PluginItem>(
+        std::make_move_iterator(pendingItems.begin() + nextItemIndex),
+        std::make_move_iterator(pendingItems.end())));
+  }
+
+  reset();
+}
+
+void PluginItemsCommitter::reset() {
+  pendingItems.clear();
+  nextItemIndex = 0;
+  onCommitted = nullptr;
+}
+
+bool PluginItemsCommitter::isCommitting() const {
+  return static_cast<bool>(onCommitted);
+}
+
+void PluginItemsCommitter::scheduleSlice() {
+  if (isSliceScheduled) {
+    return;
+  }
+
+  isSliceScheduled = true;
+  QTimer::singleShot(0, this, [this]() {
+    isSliceScheduled = false;
+    insertSlice();
+  });
+}
+
+void PluginItemsCommitter::insertSlice() {
+  if (!isCommitting()) {
+    return;
+  }
+
+  ScopedTimer scopedTimer("PluginItemsCommitter::insertSlice");
+  ScopedMemoryMeter memoryMeter("PluginItemsCommitter::insertSlice");
+
+  QElapsedTimer timer;
+  timer.start();
+
+  while (nextItemIndex < pendingItems.size() &&
+         timer.elapsed() < SLICE_DURATION_MS) {
+    const auto chunkEnd =
+        std::min(nextItemIndex + ROWS_PER_CHUNK, pendingItems.size());
+
+    std::vector<PluginItem> chunk(
+        std::make_move_iterator(pendingItems.begin() + nextItemIndex),
+        std::make_move_iterator(pendingItems.begin() + chunkEnd));
+    nextItemIndex = chunkEnd;
+
+    model->appendPluginItems(std::move(chunk));
+  }
+
+  if (nextItemIndex < pendingItems.size()) {
+    scheduleSlice();
+    return;
+  }
+
+  // Clear the state before calling onCommitted in case it starts another
+  // commit.
+  const auto callback = std::move(onCommitted);
+  reset();
+
+  callback();
+}
+}
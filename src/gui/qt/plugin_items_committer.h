@@ -0,0 +1,76 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_QT_PLUGIN_ITEMS_COMMITTER
+#define LOOT_GUI_QT_PLUGIN_ITEMS_COMMITTER
+
+#include <QtCore/QObject>
+#include <functional>
+#include <vector>
+
+#include "gui/plugin_item.h"
+#include "gui/qt/plugin_item_model.h"
+
+namespace loot {
+// Gives a PluginItemModel a new set of plugin items without blocking the UI
+// thread for the whole time it takes views and proxy models to handle them.
+//
+// If the model's existing rows can be updated in place, that is done
+// immediately. Otherwise the existing rows are removed and the new items are
+// inserted in load order a slice at a time, with each slice limited to a few
+// milliseconds so that events are handled in between. Rows are inserted from
+// the top of the list, which is where the cards view starts.
+class PluginItemsCommitter : public QObject {
+  Q_OBJECT
+public:
+  PluginItemsCommitter(QObject* parent, PluginItemModel* model);
+
+  // onCommitted is called once all the items are in the model, which may be
+  // before this returns. Starting a new commit abandons any commit still in
+  // progress without calling its onCommitted.
+  void commit(std::vector<PluginItem>&& items,
+              std::function<void()> onCommitted);
+
+  // Insert the remaining items of a commit that is in progress without
+  // waiting for the event loop and without calling its onCommitted, so that
+  // the model isn't left with only some of the items.
+  void cancel();
+
+  bool isCommitting() const;
+
+private:
+  PluginItemModel* model{nullptr};
+  std::vector<PluginItem> pendingItems;
+  size_t nextItemIndex{0};
+  std::function<void()> onCommitted;
+  bool isSliceScheduled{false};
+
+  void reset();
+  void scheduleSlice();
+  void insertSlice();
+};
+}
+
+#endif
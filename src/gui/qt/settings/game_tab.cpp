@@ -25,11 +25,16 @@
 
 #include "gui/qt/settings/game_tab.h"
 
+#include <QtConcurrent/QtConcurrent>
+#include <QtCore/QPromise>
 #include <QtWidgets/QFileDialog>
 #include <QtWidgets/QFormLayout>
 #include <QtWidgets/QVBoxLayout>
 
 #include "gui/qt/helpers.h"
+#include "gui/state/game/detection/common.h"
+#include "gui/state/logging.h"
+#include "gui/state/thread_pool.h"
 
 namespace loot {
 FolderPicker::FolderPicker(QWidget* parent) : QFrame(parent) { setupUi(); }
@@ -50,6 +55,8 @@ void FolderPicker::setupUi() {
 
   translateUi();
 
+  connect(textInput, &QLineEdit::textChanged, this, &FolderPicker::textChanged);
+
   QMetaObject::connectSlotsByName(this);
 }
 
@@ -136,12 +143,35 @@ void GameTab::setupUi() {
   generalLayout->addRow(minimumHeaderVersionLabel, minimumHeaderVersionSpinBox);
   generalLayout->addRow(masterlistSourceLabel, masterlistSourceInput);
   generalLayout->addRow(installPathLabel, installPathInput);
+  generalLayout->addRow(QString(), installPathStatusLabel);
   generalLayout->addRow(localDataPathLabel, localDataPathInput);
 
   generalLayout->addWidget(deleteGameButton);
 
+  installPathStatusLabel->setWordWrap(true);
+  installPathStatusLabel->setVisible(false);
+
+  installPathCheckTimer->setSingleShot(true);
+  installPathCheckTimer->setInterval(INSTALL_PATH_CHECK_DELAY_MS);
+
   translateUi();
 
+  const auto scheduleInstallPathCheck = [this]() {
+    installPathCheckTimer->start();
+  };
+  connect(installPathInput,
+          &FolderPicker::textChanged,
+          this,
+          scheduleInstallPathCheck);
+  connect(masterFileInput,
+          &QLineEdit::textChanged,
+          this,
+          scheduleInstallPathCheck);
+  connect(installPathCheckTimer,
+          &QTimer::timeout,
+          this,
+          &GameTab::checkInstallPath);
+
   QMetaObject::connectSlotsByName(this);
 }
 
@@ -189,6 +219,77 @@ void GameTab::initialiseInputs(const GameSettings& settings,
   deleteGameButton->setEnabled(!isCurrentGame);
 }
 
+void GameTab::checkInstallPath() {
+  // Discard the result of any check that's still running.
+  installPathCheck.cancel();
+  currentInstallPathCheckId += 1;
+
+  const auto installPathText = installPathInput->text();
+  if (installPathText.isEmpty()) {
+    // LOOT will try to detect the install path.
+    setInstallPathStatus(QString());
+    return;
+  }
+
+  const auto gameId =
+      GAME_IDS_BY_STRING.at(baseGameComboBox->currentText().toStdString());
+  const auto masterFile = masterFileInput->text().toStdString();
+  const auto installPath =
+      std::filesystem::u8path(installPathText.toStdString());
+
+  setInstallPathStatus(translate("Checking install path…"));
+
+  installPathCheck = QtConcurrent::run(
+      &getThreadPool(),
+      [gameId, masterFile, installPath](QPromise<bool>& promise) {
+        if (promise.isCanceled()) {
+          return;
+        }
+
+        const auto isValid = IsValidGamePath(gameId, masterFile, installPath);
+
+        if (!promise.isCanceled()) {
+          promise.addResult(isValid);
+        }
+      });
+
+  installPathCheck
+      .then(this,
+            [this, checkId = currentInstallPathCheckId](bool isValid) {
+              if (checkId != currentInstallPathCheckId) {
+                return;
+              }
+
+              if (isValid) {
+                setInstallPathStatus(
+                    translate("The game's main master plugin was found."));
+              } else {
+                setInstallPathStatus(
+                    translate("The game's main master plugin could not be "
+                              "found at this install path."));
+              }
+            })
+      .onFailed(this,
+                [this, checkId = currentInstallPathCheckId](
+                    const std::exception& e) {
+                  const auto logger = getLogger(LogCategory::ui);
+                  if (logger) {
+                    logger->error("Failed to check the install path: {}",
+                                  e.what());
+                  }
+
+                  if (checkId == currentInstallPathCheckId) {
+                    setInstallPathStatus(
+                        translate("The install path could not be checked."));
+                  }
+                });
+}
+
+void GameTab::setInstallPathStatus(const QString& text) {
+  installPathStatusLabel->setText(text);
+  installPathStatusLabel->setVisible(!text.isEmpty());
+}
+
 void GameTab::on_deleteGameButton_clicked() { emit gameSettingsDeleted(); }
 
 void GameTab::on_nameInput_textEdited(const QString& text) {
@@ -26,6 +26,8 @@
 #ifndef LOOT_GUI_QT_SETTINGS_GAME_TAB
 #define LOOT_GUI_QT_SETTINGS_GAME_TAB
 
+#include <QtCore/QFuture>
+#include <QtCore/QTimer>
 #include <QtWidgets/QCheckBox>
 #include <QtWidgets/QComboBox>
 #include <QtWidgets/QDoubleSpinBox>
@@ -48,6 +50,9 @@ public:
 
   void setText(const QString &text);
 
+signals:
+  void textChanged(const QString &text);
+
 private:
   QLineEdit *textInput{new QLineEdit(this)};
   QPushButton *browseButton{new QPushButton(this)};
@@ -82,6 +87,7 @@ private:
   QLabel *masterlistSourceLabel{new QLabel(this)};
   QLabel *installPathLabel{new QLabel(this)};
   QLabel *localDataPathLabel{new QLabel(this)};
+  QLabel *installPathStatusLabel{new QLabel(this)};
   QLineEdit *nameInput{new QLineEdit(this)};
   QComboBox *baseGameComboBox{new QComboBox(this)};
   QLineEdit *lootFolderInput{new QLineEdit(this)};
@@ -92,10 +98,21 @@ private:
   FolderPicker *localDataPathInput{new FolderPicker(this)};
   QPushButton *deleteGameButton{new QPushButton(this)};
 
+  // Checking the install path reads from whatever drive it's on, which may be
+  // slow to respond, so it's done on a worker thread once the path has stopped
+  // changing, and only the latest check's result is shown.
+  static constexpr int INSTALL_PATH_CHECK_DELAY_MS = 300;
+  QTimer *installPathCheckTimer{new QTimer(this)};
+  QFuture<bool> installPathCheck;
+  unsigned int currentInstallPathCheckId{0};
+
   void setupUi();
   void translateUi();
   void initialiseInputs(const GameSettings &settings, bool isCurrentGame);
 
+  void checkInstallPath();
+  void setInstallPathStatus(const QString &text);
+
 private slots:
   void on_deleteGameButton_clicked();
   void on_nameInput_textEdited(const QString &text);
@@ -88,9 +88,28 @@ void GeneralTab::initialiseInputs(const LootSettings& settings,
       settings.isNoSortingChangesDialogEnabled());
   warnOnCaseSensitiveGamePathsCheckbox->setChecked(
       settings.isWarnOnCaseSensitiveGamePathsEnabled());
+  autoRefreshCheckbox->setChecked(settings.isAutoRefreshEnabled());
+  speculativeSortCheckbox->setChecked(settings.isSpeculativeSortEnabled());
+  backupCompressionLevelSpinBox->setValue(
+      settings.getBackupCompressionLevel());
+  maxResidentGamesSpinBox->setValue(settings.getMaxResidentGames());
+  preloadPreviousGameCheckbox->setChecked(
+      settings.isPreviousGamePreloadEnabled());
+  releasePluginRecordDataCheckbox->setChecked(
+      settings.isPluginRecordDataReleaseEnabled());
+  maxWorkerThreadsSpinBox->setValue(settings.getMaxWorkerThreads());
+
+  const auto backupRetention = settings.getBackupRetention();
+  backupMaxCountSpinBox->setValue(backupRetention.maxCount);
+  backupMaxTotalSizeSpinBox->setValue(backupRetention.maxTotalSizeMiB);
+  backupMaxAgeSpinBox->setValue(backupRetention.maxAgeDays);
 
   preludeSourceInput->setText(
       QString::fromStdString(settings.getPreludeSource()));
+  sharedDownloadCachePathInput->setText(QString::fromStdString(
+      settings.getSharedDownloadCachePath().u8string()));
+  runMetricsPathInput->setText(
+      QString::fromStdString(settings.getRunMetricsPath().u8string()));
 }
 
 void GeneralTab::recordInputValues(LootSettings& settings) {
@@ -106,7 +125,24 @@ void GeneralTab::recordInputValues(LootSettings& settings) {
       useNoSortingChangesDialogCheckbox->isChecked();
   const auto enableWarnOnCaseSensitiveGamePaths =
       warnOnCaseSensitiveGamePathsCheckbox->isChecked();
+  const auto enableAutoRefresh = autoRefreshCheckbox->isChecked();
+  const auto enableSpeculativeSort = speculativeSortCheckbox->isChecked();
+  const auto backupCompressionLevel = backupCompressionLevelSpinBox->value();
+  const auto maxResidentGames = maxResidentGamesSpinBox->value();
+  const auto enablePreviousGamePreload =
+      preloadPreviousGameCheckbox->isChecked();
+  const auto enablePluginRecordDataRelease =
+      releasePluginRecordDataCheckbox->isChecked();
+  const auto maxWorkerThreads = maxWorkerThreadsSpinBox->value();
+  LootSettings::BackupRetention backupRetention;
+  backupRetention.maxCount = backupMaxCountSpinBox->value();
+  backupRetention.maxTotalSizeMiB = backupMaxTotalSizeSpinBox->value();
+  backupRetention.maxAgeDays = backupMaxAgeSpinBox->value();
   auto preludeSource = preludeSourceInput->text().toStdString();
+  const auto sharedDownloadCachePath = std::filesystem::u8path(
+      sharedDownloadCachePathInput->text().trimmed().toStdString());
+  const auto runMetricsPath = std::filesystem::u8path(
+      runMetricsPathInput->text().trimmed().toStdString());
 
   settings.setDefaultGame(defaultGame);
   settings.setLanguage(language);
@@ -117,7 +153,17 @@ void GeneralTab::recordInputValues(LootSettings& settings) {
   settings.enableNoSortingChangesDialog(enableNoSortingChangesDialog);
   settings.enableWarnOnCaseSensitiveGamePaths(
       enableWarnOnCaseSensitiveGamePaths);
+  settings.enableAutoRefresh(enableAutoRefresh);
+  settings.enableSpeculativeSort(enableSpeculativeSort);
+  settings.setBackupCompressionLevel(backupCompressionLevel);
+  settings.setMaxResidentGames(maxResidentGames);
+  settings.enablePreviousGamePreload(enablePreviousGamePreload);
+  settings.enablePluginRecordDataRelease(enablePluginRecordDataRelease);
+  settings.setMaxWorkerThreads(maxWorkerThreads);
+  settings.storeBackupRetention(backupRetention);
   settings.setPreludeSource(preludeSource);
+  settings.setSharedDownloadCachePath(sharedDownloadCachePath);
+  settings.setRunMetricsPath(runMetricsPath);
 }
 
 bool GeneralTab::areInputValuesValid() const {
@@ -134,6 +180,13 @@ bool GeneralTab::areInputValuesValid() const {
 void GeneralTab::setupUi() {
   defaultGameComboBox->addItem(QString(), QVariant(QString("auto")));
 
+  backupCompressionLevelSpinBox->setRange(0, 9);
+  maxResidentGamesSpinBox->setRange(0, LootSettings::MAX_RESIDENT_GAMES);
+  maxWorkerThreadsSpinBox->setRange(0, LootSettings::MAX_WORKER_THREADS);
+  backupMaxCountSpinBox->setRange(0, 1000);
+  backupMaxTotalSizeSpinBox->setRange(0, 1024 * 1024);
+  backupMaxAgeSpinBox->setRange(0, 3650);
+
   const auto lineHeight = QFontMetricsF(QApplication::font()).height();
   const auto spacer = new QSpacerItem(0, static_cast<int>(lineHeight));
 
@@ -149,7 +202,23 @@ void GeneralTab::setupUi() {
                         useNoSortingChangesDialogCheckbox);
   generalLayout->addRow(warnOnCaseSensitiveGamePathsLabel,
                         warnOnCaseSensitiveGamePathsCheckbox);
+  generalLayout->addRow(autoRefreshLabel, autoRefreshCheckbox);
+  generalLayout->addRow(speculativeSortLabel, speculativeSortCheckbox);
+  generalLayout->addRow(maxResidentGamesLabel, maxResidentGamesSpinBox);
+  generalLayout->addRow(preloadPreviousGameLabel,
+                        preloadPreviousGameCheckbox);
+  generalLayout->addRow(releasePluginRecordDataLabel,
+                        releasePluginRecordDataCheckbox);
+  generalLayout->addRow(maxWorkerThreadsLabel, maxWorkerThreadsSpinBox);
+  generalLayout->addRow(backupCompressionLevelLabel,
+                        backupCompressionLevelSpinBox);
+  generalLayout->addRow(backupMaxCountLabel, backupMaxCountSpinBox);
+  generalLayout->addRow(backupMaxTotalSizeLabel, backupMaxTotalSizeSpinBox);
+  generalLayout->addRow(backupMaxAgeLabel, backupMaxAgeSpinBox);
   generalLayout->addRow(preludeSourceLabel, preludeSourceInput);
+  generalLayout->addRow(sharedDownloadCachePathLabel,
+                        sharedDownloadCachePathInput);
+  generalLayout->addRow(runMetricsPathLabel, runMetricsPathInput);
   generalLayout->addItem(spacer);
   generalLayout->addRow(descriptionLabel);
 
@@ -168,9 +237,55 @@ void GeneralTab::translateUi() {
       translate("Display dialog when sorting makes no changes"));
   warnOnCaseSensitiveGamePathsLabel->setText(
       translate("Warn if the game's paths are in a case-sensitive filesystem"));
+  autoRefreshLabel->setText(
+      translate("Refresh content when the game's files change"));
+  speculativeSortLabel->setText(
+      translate("Prepare a sorted load order after loading the game"));
+  maxResidentGamesLabel->setText(
+      translate("Number of other games to keep loaded"));
+  preloadPreviousGameLabel->setText(
+      translate("Load the previously used game in the background"));
+  releasePluginRecordDataLabel->setText(
+      translate("Free plugin data after finding overlapping plugins"));
+  maxWorkerThreadsLabel->setText(translate("Maximum number of worker threads"));
+  backupCompressionLevelLabel->setText(translate("Backup compression level"));
+  backupMaxCountLabel->setText(translate("Number of backups to keep"));
+  backupMaxTotalSizeLabel->setText(
+      translate("Maximum total size of backups (MiB)"));
+  backupMaxAgeLabel->setText(translate("Maximum age of backups (days)"));
+  sharedDownloadCachePathLabel->setText(translate("Shared download cache"));
+  runMetricsPathLabel->setText(translate("Run metrics file"));
 
   loggingLabel->setToolTip(
       translate("The output is logged to the LOOTDebugLog.txt file."));
+  autoRefreshLabel->setToolTip(
+      translate("Only the plugins and metadata that have changed are "
+                "reloaded."));
+  speculativeSortLabel->setToolTip(
+      translate("Sorting is faster if nothing that affects it changes before "
+                "you sort."));
+  maxResidentGamesLabel->setToolTip(
+      translate("Switching back to a game that is still loaded is quicker, "
+                "but each one uses more memory."));
+  preloadPreviousGameLabel->setToolTip(
+      translate("Switching to it is then quicker. This has no effect if no "
+                "other games are kept loaded."));
+  releasePluginRecordDataLabel->setToolTip(
+      translate("LOOT uses less memory, but may need to load the plugins "
+                "again the next time the overlap filter is used."));
+  maxWorkerThreadsLabel->setToolTip(
+      translate("Fewer threads leave more of your CPU free for other "
+                "programs, but loading and sorting may be slower."));
+  backupCompressionLevelLabel->setToolTip(
+      translate("Higher levels make backups smaller but slower to create."));
+  sharedDownloadCachePathLabel->setToolTip(
+      translate("A folder, e.g. on a network share, that LOOT checks for "
+                "recently downloaded masterlists and preludes before "
+                "downloading them. Leave empty to disable."));
+  runMetricsPathLabel->setToolTip(
+      translate("A file that LOOT appends a line of performance metrics to "
+                "after starting, refreshing, sorting and updating the "
+                "masterlist. Leave empty to disable."));
 
   preludeSourceInput->setToolTip(translate("A prelude source is required."));
 
@@ -178,5 +293,12 @@ void GeneralTab::translateUi() {
       "Language changes will be applied after LOOT is restarted."));
 
   defaultGameComboBox->setItemText(0, translate("Autodetect"));
+
+  backupCompressionLevelSpinBox->setSpecialValueText(
+      translate("No compression"));
+  backupMaxCountSpinBox->setSpecialValueText(translate("Unlimited"));
+  maxWorkerThreadsSpinBox->setSpecialValueText(translate("Automatic"));
+  backupMaxTotalSizeSpinBox->setSpecialValueText(translate("Unlimited"));
+  backupMaxAgeSpinBox->setSpecialValueText(translate("Unlimited"));
 }
 }
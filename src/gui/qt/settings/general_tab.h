@@ -31,6 +31,7 @@
 #include <QtWidgets/QFrame>
 #include <QtWidgets/QLabel>
 #include <QtWidgets/QLineEdit>
+#include <QtWidgets/QSpinBox>
 #include <QtWidgets/QWidget>
 
 #include "gui/state/loot_settings.h"
@@ -55,7 +56,19 @@ private:
   QLabel *loggingLabel{new QLabel(this)};
   QLabel *useNoSortingChangesDialogLabel{new QLabel(this)};
   QLabel *warnOnCaseSensitiveGamePathsLabel{new QLabel(this)};
+  QLabel *autoRefreshLabel{new QLabel(this)};
+  QLabel *speculativeSortLabel{new QLabel(this)};
+  QLabel *backupCompressionLevelLabel{new QLabel(this)};
+  QLabel *maxResidentGamesLabel{new QLabel(this)};
+  QLabel *preloadPreviousGameLabel{new QLabel(this)};
+  QLabel *releasePluginRecordDataLabel{new QLabel(this)};
+  QLabel *maxWorkerThreadsLabel{new QLabel(this)};
+  QLabel *backupMaxCountLabel{new QLabel(this)};
+  QLabel *backupMaxTotalSizeLabel{new QLabel(this)};
+  QLabel *backupMaxAgeLabel{new QLabel(this)};
   QLabel *preludeSourceLabel{new QLabel(this)};
+  QLabel *sharedDownloadCachePathLabel{new QLabel(this)};
+  QLabel *runMetricsPathLabel{new QLabel(this)};
   QComboBox *defaultGameComboBox{new QComboBox(this)};
   QComboBox *languageComboBox{new QComboBox(this)};
   QComboBox *themeComboBox{new QComboBox(this)};
@@ -64,7 +77,19 @@ private:
   QCheckBox *loggingCheckbox{new QCheckBox(this)};
   QCheckBox *useNoSortingChangesDialogCheckbox{new QCheckBox(this)};
   QCheckBox *warnOnCaseSensitiveGamePathsCheckbox{new QCheckBox(this)};
+  QCheckBox *autoRefreshCheckbox{new QCheckBox(this)};
+  QCheckBox *speculativeSortCheckbox{new QCheckBox(this)};
+  QSpinBox *backupCompressionLevelSpinBox{new QSpinBox(this)};
+  QSpinBox *maxResidentGamesSpinBox{new QSpinBox(this)};
+  QCheckBox *preloadPreviousGameCheckbox{new QCheckBox(this)};
+  QCheckBox *releasePluginRecordDataCheckbox{new QCheckBox(this)};
+  QSpinBox *maxWorkerThreadsSpinBox{new QSpinBox(this)};
+  QSpinBox *backupMaxCountSpinBox{new QSpinBox(this)};
+  QSpinBox *backupMaxTotalSizeSpinBox{new QSpinBox(this)};
+  QSpinBox *backupMaxAgeSpinBox{new QSpinBox(this)};
   QLineEdit *preludeSourceInput{new QLineEdit(this)};
+  QLineEdit *sharedDownloadCachePathInput{new QLineEdit(this)};
+  QLineEdit *runMetricsPathInput{new QLineEdit(this)};
   QLabel *descriptionLabel{new QLabel(this)};
 
   void setupUi();
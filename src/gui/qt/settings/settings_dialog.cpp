@@ -33,6 +33,19 @@
 #include "gui/qt/helpers.h"
 #include "gui/qt/settings/new_game_dialog.h"
 
+namespace {
+bool isSameSettings(const loot::GameSettings& lhs,
+                    const loot::GameSettings& rhs) {
+  return lhs.Id() == rhs.Id() && lhs.Name() == rhs.Name() &&
+         lhs.FolderName() == rhs.FolderName() &&
+         lhs.Master() == rhs.Master() &&
+         lhs.MinimumHeaderVersion() == rhs.MinimumHeaderVersion() &&
+         lhs.MasterlistSource() == rhs.MasterlistSource() &&
+         lhs.GamePath() == rhs.GamePath() &&
+         lhs.GameLocalPath() == rhs.GameLocalPath();
+}
+}
+
 namespace loot {
 SettingsDialog::SettingsDialog(QWidget* parent) : QDialog(parent) { setupUi(); }
 
@@ -42,14 +55,45 @@ void SettingsDialog::initialiseInputs(
     const std::optional<std::string>& currentGameFolder) {
   generalTab->initialiseInputs(settings, themes);
 
-  while (stackedWidget->count() > 1) {
-    removeTab(1);
+  // Select the general settings before replacing the game pages so that the
+  // sidebar doesn't select pages while they're being replaced.
+  listWidget->setCurrentRow(0);
+
+  auto oldPages = std::move(gamePages);
+  gamePages.clear();
+  while (listWidget->count() > 1) {
+    delete listWidget->takeItem(1);
   }
 
   for (const auto& game : settings.getGameSettings()) {
-    auto isCurrentGame = game.FolderName() == currentGameFolder;
+    GamePage page;
+    page.settings = game;
+    page.isCurrentGame = game.FolderName() == currentGameFolder;
+
+    // Keep the tab that was created for this game when the dialog was last
+    // opened if the game's settings haven't changed and the tab hasn't been
+    // edited since.
+    for (auto& oldPage : oldPages) {
+      if (oldPage.tab != nullptr &&
+          oldPage.isCurrentGame == page.isCurrentGame &&
+          isSameSettings(oldPage.settings, page.settings) &&
+          isSameSettings(oldPage.tab->getGameSettings(),
+                         oldPage.initialTabSettings)) {
+        page.tab = oldPage.tab;
+        page.initialTabSettings = oldPage.initialTabSettings;
+        oldPage.tab = nullptr;
+        break;
+      }
+    }
+
+    addGamePage(std::move(page));
+  }
 
-    addGameTab(game, isCurrentGame);
+  for (const auto& oldPage : oldPages) {
+    if (oldPage.tab != nullptr) {
+      stackedWidget->removeWidget(oldPage.tab);
+      oldPage.tab->deleteLater();
+    }
   }
 }
 
@@ -57,10 +101,9 @@ void SettingsDialog::recordInputValues(LootState& state) {
   generalTab->recordInputValues(state.getSettings());
 
   std::vector<GameSettings> gameSettings;
-  // First tab is for general settings.
-  for (int i = 1; i < stackedWidget->count(); i += 1) {
-    auto gameTab = qobject_cast<GameTab*>(stackedWidget->widget(i));
-    gameSettings.push_back(gameTab->getGameSettings());
+  for (const auto& page : gamePages) {
+    gameSettings.push_back(page.tab == nullptr ? page.settings
+                                               : page.tab->getGameSettings());
   }
 
   gameSettings = state.LoadInstalledGames(
@@ -100,8 +143,8 @@ void SettingsDialog::setupUi() {
 
   connect(listWidget,
           &QListWidget::currentRowChanged,
-          stackedWidget,
-          &QStackedWidget::setCurrentIndex);
+          this,
+          &SettingsDialog::onCurrentRowChanged);
 
   QMetaObject::connectSlotsByName(this);
 }
@@ -114,41 +157,69 @@ void SettingsDialog::translateUi() {
   addGameButton->setText(translate("Add new game…"));
 }
 
-void SettingsDialog::addGameTab(const GameSettings& settings,
-                                bool isCurrentGame) {
-  auto gameTab = new GameTab(settings, this, isCurrentGame);
+void SettingsDialog::addGamePage(GamePage&& page) {
+  const auto name = page.tab == nullptr
+                        ? QString::fromStdString(page.settings.Name())
+                        : page.tab->getName();
+  listWidget->addItem(name);
 
-  stackedWidget->addWidget(gameTab);
-  listWidget->addItem(gameTab->getName());
+  gamePages.push_back(std::move(page));
+}
 
-  connect(gameTab,
+GameTab* SettingsDialog::getGameTab(size_t pageIndex) {
+  auto& page = gamePages.at(pageIndex);
+  if (page.tab != nullptr) {
+    return page.tab;
+  }
+
+  page.tab = new GameTab(page.settings, this, page.isCurrentGame);
+  page.initialTabSettings = page.tab->getGameSettings();
+
+  stackedWidget->addWidget(page.tab);
+
+  connect(page.tab,
           &GameTab::gameSettingsDeleted,
           this,
           &SettingsDialog::onGameSettingsDeleted);
-  connect(gameTab,
+  connect(page.tab,
           &GameTab::gameNameChanged,
           this,
           &SettingsDialog::onGameNameChanged);
+
+  return page.tab;
 }
 
-void SettingsDialog::removeTab(int index) {
-  auto tab = stackedWidget->widget(index);
-  stackedWidget->removeWidget(tab);
-  tab->deleteLater();
+void SettingsDialog::removeGamePage(size_t pageIndex) {
+  const auto tab = gamePages.at(pageIndex).tab;
+  gamePages.erase(gamePages.begin() + pageIndex);
+
+  // Removing the list item changes the current row, which selects another
+  // page, so remove the page first.
+  delete listWidget->takeItem(static_cast<int>(pageIndex) + 1);
 
-  auto item = listWidget->takeItem(index);
-  delete item->listWidget();
-  delete item;
+  if (tab != nullptr) {
+    stackedWidget->removeWidget(tab);
+    tab->deleteLater();
+  }
+}
+
+std::optional<size_t> SettingsDialog::findGamePage(const QObject* tab) const {
+  for (size_t i = 0; i < gamePages.size(); i += 1) {
+    if (gamePages.at(i).tab == tab) {
+      return i;
+    }
+  }
+
+  return std::nullopt;
 }
 
 QStringList SettingsDialog::getGameFolderNames() const {
   QStringList folders;
 
-  for (auto i = 1; i < stackedWidget->count() - 1; i += 1) {
-    auto gameTab = qobject_cast<GameTab*>(stackedWidget->widget(i));
-    auto otherFolder = gameTab->getLootFolder();
-
-    folders.append(otherFolder);
+  for (const auto& page : gamePages) {
+    folders.append(page.tab == nullptr
+                       ? QString::fromStdString(page.settings.FolderName())
+                       : page.tab->getLootFolder());
   }
 
   return folders;
@@ -187,27 +258,42 @@ void SettingsDialog::on_addGameButton_clicked() {
   GameSettings game(gameId, lootFolder);
   game.SetName(name);
 
-  addGameTab(game, false);
+  GamePage page;
+  page.settings = game;
+  addGamePage(std::move(page));
 
   listWidget->setCurrentRow(listWidget->count() - 1);
 }
 
+void SettingsDialog::onCurrentRowChanged(int row) {
+  // The first row is for the general settings.
+  if (row < 1) {
+    stackedWidget->setCurrentWidget(generalTab);
+    return;
+  }
+
+  const auto pageIndex = static_cast<size_t>(row) - 1;
+  if (pageIndex < gamePages.size()) {
+    stackedWidget->setCurrentWidget(getGameTab(pageIndex));
+  }
+}
+
 void SettingsDialog::onGameSettingsDeleted() {
-  const auto gameTab = qobject_cast<QWidget*>(sender());
-  const auto index = stackedWidget->indexOf(gameTab);
+  const auto pageIndex = findGamePage(sender());
 
-  if (index > -1) {
-    removeTab(index);
+  if (pageIndex.has_value()) {
+    removeGamePage(pageIndex.value());
   }
 }
 
 void SettingsDialog::onGameNameChanged(const QString& name) {
-  const auto gameTab = qobject_cast<QWidget*>(sender());
-  const auto index = stackedWidget->indexOf(gameTab);
+  const auto pageIndex = findGamePage(sender());
 
-  if (index > -1) {
+  if (pageIndex.has_value()) {
     const auto model = listWidget->model();
-    model->setData(model->index(index, 0), name, Qt::DisplayRole);
+    model->setData(model->index(static_cast<int>(pageIndex.value()) + 1, 0),
+                   name,
+                   Qt::DisplayRole);
   }
 }
 }
@@ -32,6 +32,8 @@
 #include <QtWidgets/QStackedWidget>
 #include <QtWidgets/QTabWidget>
 #include <QtWidgets/QWidget>
+#include <optional>
+#include <vector>
 
 #include "gui/qt/settings/game_tab.h"
 #include "gui/qt/settings/general_tab.h"
@@ -55,11 +57,26 @@ private:
   GeneralTab *generalTab{new GeneralTab(this)};
   QStackedWidget *stackedWidget{new QStackedWidget(this)};
 
+  // Each game's page is listed in the sidebar after the general settings.
+  struct GamePage {
+    GameSettings settings;
+    bool isCurrentGame{false};
+    // Null until the page is first selected, as creating a tab for every
+    // game makes opening the dialog slow when there are many games.
+    GameTab *tab{nullptr};
+    // The tab's settings when it was created, so that a tab that has not been
+    // edited can be kept when the dialog is opened again.
+    GameSettings initialTabSettings;
+  };
+  std::vector<GamePage> gamePages;
+
   void setupUi();
   void translateUi();
 
-  void addGameTab(const GameSettings &settings, bool isCurrentGame);
-  void removeTab(int index);
+  void addGamePage(GamePage &&page);
+  GameTab *getGameTab(size_t pageIndex);
+  void removeGamePage(size_t pageIndex);
+  std::optional<size_t> findGamePage(const QObject *tab) const;
 
   QStringList getGameFolderNames() const;
 
@@ -68,6 +85,7 @@ private slots:
   void on_dialogButtons_rejected();
   void on_addGameButton_clicked();
 
+  void onCurrentRowChanged(int row);
   void onGameSettingsDeleted();
   void onGameNameChanged(const QString &name);
 };
@@ -26,6 +26,15 @@
 #include "gui/qt/sidebar_plugin_name_delegate.h"
 
 #include "gui/qt/plugin_item_model.h"
+#include "gui/state/diagnostics.h"
+
+namespace {
+// More entries than this are only cached if plugins are renamed or their
+// groups change many times, so the cache is cleared instead of growing.
+constexpr qsizetype MAX_ELIDED_TEXT_CACHE_SIZE = 10000;
+
+loot::CacheCounter elidedTextCacheCounter("Sidebar elided text");
+}
 
 namespace loot {
 qreal getSidebarRowHeight(bool inEditMode) {
@@ -64,7 +73,8 @@ void SidebarPluginNameDelegate::paint(QPainter* painter,
 
   painter->save();
 
-  auto pluginItem = index.data(RawDataRole).value<PluginItem>();
+  const auto pluginName = index.data(SidebarNameRole).toString();
+  const auto groupName = index.data(SidebarGroupRole).toString();
   auto isEditorOpen = index.data(EditorStateRole).toBool();
 
   const auto isSelected = styleOption.state.testFlag(QStyle::State_Selected);
@@ -77,14 +87,12 @@ void SidebarPluginNameDelegate::paint(QPainter* painter,
     painter->setPen(pluginColor);
   }
 
-  auto name = QFontMetricsF(painter->font())
-                  .elidedText(QString::fromStdString(pluginItem.name),
-                              Qt::ElideRight,
-                              styleOption.rect.width());
+  const auto name = getElidedText(
+      elidedNames, painter->font(), styleOption.rect.width(), pluginName);
   painter->drawText(styleOption.rect, Qt::AlignLeft, name);
 
-  if (isEditorOpen && pluginItem.group.has_value() &&
-      pluginItem.group.value() != Group::DEFAULT_NAME) {
+  // The group is empty if the plugin is in the default group.
+  if (isEditorOpen && !groupName.isEmpty()) {
     auto groupRect = styleOption.rect;
     groupRect.translate(0, getSidebarRowHeight(true) / 2.0);
 
@@ -96,13 +104,36 @@ void SidebarPluginNameDelegate::paint(QPainter* painter,
       painter->setPen(groupColor);
     }
 
-    auto group = painter->fontMetrics().elidedText(
-        QString::fromStdString(pluginItem.group.value()),
-        Qt::ElideRight,
-        groupRect.width());
+    const auto group = getElidedText(
+        elidedGroups, painter->font(), groupRect.width(), groupName);
     painter->drawText(groupRect, Qt::AlignLeft, group);
   }
 
   painter->restore();
 }
+
+QString SidebarPluginNameDelegate::getElidedText(ElidedTextCache& cache,
+                                                 const QFont& font,
+                                                 int width,
+                                                 const QString& text) {
+  if (cache.width != width || cache.font != font ||
+      cache.elidedTexts.size() >= MAX_ELIDED_TEXT_CACHE_SIZE) {
+    cache.font = font;
+    cache.width = width;
+    cache.elidedTexts.clear();
+  }
+
+  const auto it = cache.elidedTexts.constFind(text);
+  const auto isHit = it != cache.elidedTexts.constEnd();
+  elidedTextCacheCounter.recordLookup(isHit);
+  if (isHit) {
+    return it.value();
+  }
+
+  const auto elidedText =
+      QFontMetricsF(font).elidedText(text, Qt::ElideRight, width);
+  cache.elidedTexts.insert(text, elidedText);
+
+  return elidedText;
+}
 }
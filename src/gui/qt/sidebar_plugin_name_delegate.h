@@ -26,6 +26,7 @@
 #ifndef LOOT_GUI_QT_SIDEBAR_PLUGIN_NAME_DELEGATE
 #define LOOT_GUI_QT_SIDEBAR_PLUGIN_NAME_DELEGATE
 
+#include <QtCore/QHash>
 #include <QtGui/QPainter>
 #include <QtWidgets/QApplication>
 #include <QtWidgets/QStyledItemDelegate>
@@ -45,8 +46,24 @@ public:
              const QModelIndex& index) const override;
 
 private:
+  // The sidebar repaints every visible row when it's hovered over, selected
+  // or scrolled, so elided text is cached to avoid measuring text each time.
+  // The cached text is only valid for the font and width it was elided for.
+  struct ElidedTextCache {
+    QFont font;
+    int width{-1};
+    QHash<QString, QString> elidedTexts;
+  };
+
   QColor selectedTextColor;
   QColor unselectedGroupColor;
+  mutable ElidedTextCache elidedNames;
+  mutable ElidedTextCache elidedGroups;
+
+  static QString getElidedText(ElidedTextCache& cache,
+                               const QFont& font,
+                               int width,
+                               const QString& text);
 };
 }
 
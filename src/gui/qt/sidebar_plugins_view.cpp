@@ -0,0 +1,80 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/qt/sidebar_plugins_view.h"
+
+#include <QtCore/QSortFilterProxyModel>
+#include <QtWidgets/QApplication>
+#include <boost/locale.hpp>
+
+#include "gui/qt/plugin_item_model.h"
+
+namespace loot {
+SidebarPluginsView::SidebarPluginsView(QWidget* parent) : QTableView(parent) {}
+
+void SidebarPluginsView::keyboardSearch(const QString& search) {
+  if (search.isEmpty()) {
+    typedText.clear();
+    return;
+  }
+
+  // Keys typed in quick succession build up the text to search for, as in
+  // Qt's own keyboard search.
+  if (!typingTimer.isValid() ||
+      typingTimer.elapsed() > QApplication::keyboardInputInterval()) {
+    typedText.clear();
+  }
+  typedText += search;
+  typingTimer.start();
+
+  const auto proxyModel = qobject_cast<QSortFilterProxyModel*>(model());
+  const auto pluginItemModel =
+      proxyModel == nullptr
+          ? nullptr
+          : qobject_cast<const PluginItemModel*>(proxyModel->sourceModel());
+  if (pluginItemModel == nullptr) {
+    QTableView::keyboardSearch(search);
+    return;
+  }
+
+  const auto toViewIndex = [&](int sourceRow) {
+    return proxyModel->mapFromSource(pluginItemModel->index(
+        sourceRow, PluginItemModel::SIDEBAR_NAME_COLUMN));
+  };
+
+  // Plugins that are filtered out can't be jumped to, but the filters are
+  // left alone.
+  const auto row = pluginItemModel->getPluginNamePrefixIndex().FindFirstRow(
+      boost::locale::to_lower(typedText.toStdString()),
+      [&](int sourceRow) { return toViewIndex(sourceRow).isValid(); });
+  if (!row.has_value()) {
+    return;
+  }
+
+  const auto viewIndex = toViewIndex(row.value());
+  setCurrentIndex(viewIndex);
+  scrollTo(viewIndex);
+}
+}
@@ -0,0 +1,49 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_QT_SIDEBAR_PLUGINS_VIEW
+#define LOOT_GUI_QT_SIDEBAR_PLUGINS_VIEW
+
+#include <QtCore/QElapsedTimer>
+#include <QtWidgets/QTableView>
+
+namespace loot {
+// The sidebar's table of plugins. Typing while it has focus jumps to the
+// first plugin whose name starts with the typed text, using the plugin item
+// model's name prefix index instead of matching against every row.
+class SidebarPluginsView : public QTableView {
+  Q_OBJECT
+public:
+  explicit SidebarPluginsView(QWidget* parent);
+
+  void keyboardSearch(const QString& search) override;
+
+private:
+  QString typedText;
+  QElapsedTimer typingTimer;
+};
+}
+
+#endif
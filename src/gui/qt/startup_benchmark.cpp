@@ -0,0 +1,255 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/qt/startup_benchmark.h"
+
+#include <QtCore/QEventLoop>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTimer>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "gui/qt/main_window.h"
+#include "gui/query/types/sort_plugins_query.h"
+#include "gui/state/diagnostics.h"
+#include "gui/state/logging.h"
+#include "gui/state/loot_state.h"
+#include "gui/state/timing.h"
+#include "gui/version.h"
+
+namespace {
+using std::chrono::duration;
+using std::chrono::steady_clock;
+
+// Long enough for the largest load orders on slow drives.
+constexpr int RUN_TIMEOUT_MS = 10 * 60 * 1000;
+
+class StageTimer {
+public:
+  void start() { startTime_ = steady_clock::now(); }
+
+  void stop(const char* stageName) {
+    const auto elapsed = steady_clock::now() - startTime_;
+    stages_[stageName] = duration<double, std::milli>(elapsed).count();
+  }
+
+  QJsonObject toJson() const { return stages_; }
+
+private:
+  steady_clock::time_point startTime_;
+  QJsonObject stages_;
+};
+
+std::map<std::string, std::chrono::microseconds> getOperationTotals() {
+  std::map<std::string, std::chrono::microseconds> totals;
+  for (const auto& timing : loot::getOperationTimings()) {
+    totals.emplace(timing.operationName, timing.totalDuration);
+  }
+
+  return totals;
+}
+
+// Get how much time each of LOOT's timed operations took during a run, by
+// comparing the process-wide totals from before and after it.
+QJsonObject getOperationDurations(
+    const std::map<std::string, std::chrono::microseconds>& totalsBefore) {
+  QJsonObject durations;
+  for (const auto& [name, total] : getOperationTotals()) {
+    const auto it = totalsBefore.find(name);
+    const auto runTotal =
+        it == totalsBefore.end() ? total : total - it->second;
+
+    if (runTotal.count() > 0) {
+      durations[QString::fromStdString(name)] =
+          duration<double, std::milli>(runTotal).count();
+    }
+  }
+
+  return durations;
+}
+
+QJsonValue toJson(const std::optional<uint64_t>& bytes) {
+  if (!bytes.has_value()) {
+    return QJsonValue::Null;
+  }
+
+  return static_cast<qint64>(bytes.value());
+}
+
+bool hasErrorMessages(const std::vector<loot::SourcedMessage>& messages) {
+  return std::any_of(messages.begin(),
+                     messages.end(),
+                     [](const loot::SourcedMessage& message) {
+                       return message.type == loot::MessageType::error;
+                     });
+}
+
+void configureSettings(loot::LootSettings& settings) {
+  settings.updateLastVersion();
+  settings.enableLootUpdateCheck(false);
+  settings.enableAutoRefresh(false);
+  settings.enableSpeculativeSort(false);
+  settings.enablePreviousGamePreload(false);
+}
+
+QJsonObject runStartup(const loot::StartupBenchmarkOptions& options,
+                       unsigned int runNumber) {
+  QJsonObject run{{"run", static_cast<int>(runNumber)}};
+  StageTimer timer;
+  const auto operationTotals = getOperationTotals();
+  const auto runStartTime = steady_clock::now();
+
+  timer.start();
+  loot::LootState state("", options.lootDataPath);
+  state.init(options.gameFolderName, options.gamePath, false);
+  timer.stop("settingsAndDetection");
+
+  configureSettings(state.getSettings());
+
+  timer.start();
+  auto mainWindow = std::make_unique<loot::MainWindow>(state);
+  // Benchmark runs shouldn't skew the user's performance trends.
+  mainWindow->setPerformanceHistoryEnabled(false);
+  mainWindow->applyTheme();
+  mainWindow->show();
+  timer.stop("windowCreation");
+
+  std::optional<std::string> error;
+  QEventLoop eventLoop;
+
+  mainWindow->runWhenPluginsDisplayed([&]() {
+    timer.stop("gameDataLoad");
+
+    // Painting synchronously measures the first paint of the cards without
+    // also waiting for anything else that the event loop is doing.
+    timer.start();
+    mainWindow->repaint();
+    timer.stop("firstPaint");
+
+    if (options.sort) {
+      try {
+        timer.start();
+        loot::SortPluginsQuery query(state.GetCurrentGame(),
+                                     state,
+                                     state.getSettings().getLanguage(),
+                                     [](const std::string&) {});
+        query.executeLogic();
+        timer.stop("sort");
+      } catch (const std::exception& e) {
+        error = e.what();
+      }
+    }
+
+    eventLoop.quit();
+  });
+
+  QTimer::singleShot(RUN_TIMEOUT_MS, &eventLoop, [&]() {
+    error = "Timed out waiting for the plugins to be displayed.";
+    eventLoop.quit();
+  });
+
+  if (!state.HasCurrentGame()) {
+    error = "No game could be loaded.";
+  } else {
+    // Initialising the window initialises the current game, which is timed
+    // as the Game::Init operation, then starts loading its data in the
+    // background.
+    timer.start();
+    mainWindow->initialise();
+    timer.stop("initialise");
+    timer.start();
+
+    // The window doesn't load the game if initialisation failed.
+    if (hasErrorMessages(state.getInitMessages())) {
+      error = "LOOT's initialisation failed.";
+    } else {
+      eventLoop.exec();
+    }
+  }
+
+  run["totalMs"] =
+      duration<double, std::milli>(steady_clock::now() - runStartTime)
+          .count();
+  run["stagesMs"] = timer.toJson();
+  run["operationsMs"] = getOperationDurations(operationTotals);
+  run["residentBytes"] = toJson(loot::getProcessMemoryUsage());
+  run["peakResidentBytes"] = toJson(loot::getProcessPeakMemoryUsage());
+
+  if (error.has_value()) {
+    run["error"] = QString::fromStdString(error.value());
+
+    const auto logger = loot::getLogger();
+    if (logger) {
+      logger->error("Startup benchmark run {} failed: {}",
+                    runNumber,
+                    error.value());
+    }
+  }
+
+  return run;
+}
+}
+
+namespace loot {
+int runStartupBenchmark(const StartupBenchmarkOptions& options) {
+  auto exitCode = EXIT_SUCCESS;
+
+  QJsonArray runs;
+  for (unsigned int i = 1; i <= options.runs; i += 1) {
+    const auto run = runStartup(options, i);
+    if (run.contains("error")) {
+      exitCode = EXIT_FAILURE;
+    }
+
+    runs.append(run);
+  }
+
+  const QJsonObject results{
+      {"version", QString::fromStdString(gui::Version::string())},
+      {"game", QString::fromStdString(options.gameFolderName)},
+      {"sort", options.sort},
+      {"runs", runs}};
+
+  const auto json = QJsonDocument(results).toJson(QJsonDocument::Indented);
+
+  if (options.outputPath.empty()) {
+    std::cout << json.constData() << std::endl;
+  } else {
+    std::ofstream out(options.outputPath, std::ios_base::trunc);
+    out << json.constData();
+  }
+
+  return exitCode;
+}
+}
@@ -0,0 +1,60 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_QT_STARTUP_BENCHMARK
+#define LOOT_GUI_QT_STARTUP_BENCHMARK
+
+#include <filesystem>
+#include <string>
+
+namespace loot {
+struct StartupBenchmarkOptions {
+  std::filesystem::path lootDataPath;
+  std::string gameFolderName;
+  std::filesystem::path gamePath;
+  unsigned int runs{1};
+  bool sort{false};
+  // If empty, the results are written to stdout.
+  std::filesystem::path outputPath;
+};
+
+// Runs LOOT's startup the given number of times, from loading settings and
+// detecting games up to the first paint of the current game's plugin cards,
+// optionally followed by sorting the load order without applying it. Each run
+// uses new LootState and MainWindow instances, so only the first run is cold
+// (as far as LOOT's own caches are concerned). The duration of each stage,
+// the durations of LOOT's timed operations and the process' memory use after
+// each run are written as a JSON document.
+//
+// Settings are not saved, and the first-run dialog, update check, automatic
+// refreshing, speculative sorting and preloading of the previous game are
+// disabled so that runs are repeatable and need no interaction. Returns
+// EXIT_SUCCESS if every run displayed the game's plugins, and EXIT_FAILURE
+// otherwise. This must be called from the main thread's event loop after a
+// QApplication has been created.
+int runStartupBenchmark(const StartupBenchmarkOptions& options);
+}
+
+#endif
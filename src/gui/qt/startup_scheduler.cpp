@@ -0,0 +1,87 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/qt/startup_scheduler.h"
+
+#include <QtCore/QTimer>
+
+namespace loot {
+StartupScheduler::StartupScheduler(QObject* parent) : QObject(parent) {}
+
+StartupPhase StartupScheduler::getPhase() const { return phase; }
+
+bool StartupScheduler::hasReached(StartupPhase phase) const {
+  return this->phase >= phase;
+}
+
+void StartupScheduler::schedule(StartupPhase phase,
+                                std::function<void()> work) {
+  if (hasReached(phase)) {
+    QTimer::singleShot(0, this, std::move(work));
+  } else if (phase == StartupPhase::interactive) {
+    interactiveWork.push_back(std::move(work));
+  } else if (phase == StartupPhase::idle) {
+    idleWork.push_back(std::move(work));
+  }
+}
+
+void StartupScheduler::enterInteractivePhase() {
+  if (hasReached(StartupPhase::interactive)) {
+    return;
+  }
+
+  phase = StartupPhase::interactive;
+
+  // Take the work first in case any of it schedules more.
+  const auto work = std::move(interactiveWork);
+  interactiveWork.clear();
+  for (const auto& function : work) {
+    function();
+  }
+
+  QTimer::singleShot(0, this, &StartupScheduler::enterIdlePhase);
+}
+
+void StartupScheduler::enterIdlePhase() {
+  phase = StartupPhase::idle;
+
+  runNextIdleWork();
+}
+
+void StartupScheduler::runNextIdleWork() {
+  if (idleWork.empty()) {
+    return;
+  }
+
+  const auto work = std::move(idleWork.front());
+  idleWork.pop_front();
+
+  work();
+
+  if (!idleWork.empty()) {
+    QTimer::singleShot(0, this, &StartupScheduler::runNextIdleWork);
+  }
+}
+}
@@ -0,0 +1,80 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_QT_STARTUP_SCHEDULER
+#define LOOT_GUI_QT_STARTUP_SCHEDULER
+
+#include <QtCore/QObject>
+#include <deque>
+#include <functional>
+#include <vector>
+
+namespace loot {
+// The phases that LOOT's startup goes through, in order.
+enum struct StartupPhase : unsigned int {
+  // The window is being shown and the current game's data is being loaded.
+  critical,
+  // The plugin cards are displayed and can be interacted with.
+  interactive,
+  // Any work that was held back so that it didn't compete with loading the
+  // game is being done, or has been done.
+  idle,
+};
+
+// Holds back lower-priority startup work until the phase that it's been
+// scheduled for is reached, so that it doesn't compete with loading the
+// current game for I/O or time on the UI thread.
+//
+// Work is run on the UI thread, and must handle its own exceptions.
+class StartupScheduler : public QObject {
+  Q_OBJECT
+public:
+  explicit StartupScheduler(QObject* parent);
+
+  StartupPhase getPhase() const;
+
+  bool hasReached(StartupPhase phase) const;
+
+  // If the given phase has already been reached, the work is run the next
+  // time the event loop is free.
+  void schedule(StartupPhase phase, std::function<void()> work);
+
+  // Runs the work scheduled for the interactive phase, then moves on to the
+  // idle phase once control returns to the event loop. Idle work is run one
+  // piece at a time, so that events can be handled in between. Does nothing
+  // if the interactive phase has already been reached.
+  void enterInteractivePhase();
+
+private:
+  StartupPhase phase{StartupPhase::critical};
+  std::vector<std::function<void()>> interactiveWork;
+  std::deque<std::function<void()>> idleWork;
+
+  void enterIdlePhase();
+  void runNextIdleWork();
+};
+}
+
+#endif
@@ -28,6 +28,7 @@
 #include <QtCore/QFile>
 #include <QtCore/QTextStream>
 #include <boost/algorithm/string.hpp>
+#include <map>
 #include <set>
 
 #include "gui/state/logging.h"
@@ -38,6 +39,16 @@ static constexpr const char* QSS_SUFFIX = ".theme.qss";
 static constexpr size_t QSS_SUFFIX_LENGTH =
     std::char_traits<char>::length(QSS_SUFFIX);
 
+struct CachedStyleSheet {
+  // Has no value if the style sheet was loaded from built-in resources.
+  std::optional<std::filesystem::file_time_type> fileWriteTime;
+  QString styleSheet;
+};
+
+// Loaded style sheets keyed by the path that they would be loaded from in the
+// filesystem. Style sheets are only loaded on the UI thread.
+static std::map<std::filesystem::path, CachedStyleSheet> styleSheetCache;
+
 std::optional<QString> loadStyleSheet(const QString& resourcePath) {
   QFile file(resourcePath);
   if (!file.exists()) {
@@ -49,18 +60,18 @@ std::optional<QString> loadStyleSheet(const QString& resourcePath) {
   return ts.readAll();
 }
 
-std::optional<QString> loadStyleSheet(const std::filesystem::path& themesPath,
-                                      const std::string& themeName) {
+std::optional<QString> loadUncachedStyleSheet(
+    const std::filesystem::path& filesystemPath,
+    const std::string& themeName) {
   // First try loading the theme from the filesystem, then try loading from
   // built-in resources, then fall back to the default theme (which itself
   // will load from filesystem then built-in resources).
 
-  const auto logger = getLogger();
+  const auto logger = getLogger(LogCategory::ui);
   if (logger) {
     logger->debug("Loading style sheet for the \"{}\" theme...", themeName);
   }
 
-  const auto filesystemPath = (themesPath / (themeName + QSS_SUFFIX));
   auto styleSheet =
       loadStyleSheet(QString::fromStdString(filesystemPath.u8string()));
   if (styleSheet.has_value()) {
@@ -91,6 +102,36 @@ std::optional<QString> loadStyleSheet(const std::filesystem::path& themesPath,
   return std::nullopt;
 }
 
+std::optional<QString> loadStyleSheet(const std::filesystem::path& themesPath,
+                                      const std::string& themeName) {
+  const auto filesystemPath = themesPath / (themeName + QSS_SUFFIX);
+
+  std::optional<std::filesystem::file_time_type> fileWriteTime;
+  std::error_code errorCode;
+  const auto writeTime =
+      std::filesystem::last_write_time(filesystemPath, errorCode);
+  if (!errorCode) {
+    fileWriteTime = writeTime;
+  }
+
+  // A cached style sheet is only used if it came from the same place as it
+  // would be loaded from now and, if that's the filesystem, the file hasn't
+  // been changed since.
+  const auto it = styleSheetCache.find(filesystemPath);
+  if (it != styleSheetCache.end() &&
+      it->second.fileWriteTime == fileWriteTime) {
+    return it->second.styleSheet;
+  }
+
+  const auto styleSheet = loadUncachedStyleSheet(filesystemPath, themeName);
+  if (styleSheet.has_value()) {
+    styleSheetCache.insert_or_assign(
+        filesystemPath, CachedStyleSheet{fileWriteTime, styleSheet.value()});
+  }
+
+  return styleSheet;
+}
+
 std::vector<std::string> findThemes(const std::filesystem::path& themesPath) {
   // The default-dark theme is not listed here as it's a variation on the
   // default theme.
@@ -100,7 +141,7 @@ std::vector<std::string> findThemes(const std::filesystem::path& themesPath) {
     return {themes.begin(), themes.end()};
   }
 
-  const auto logger = getLogger();
+  const auto logger = getLogger(LogCategory::ui);
   for (std::filesystem::directory_iterator it(themesPath);
        it != std::filesystem::directory_iterator();
        ++it) {
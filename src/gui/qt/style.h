@@ -33,6 +33,8 @@
 #include <vector>
 
 namespace loot {
+// Loaded style sheets are cached, and a style sheet that was loaded from the
+// filesystem is loaded again if the file's write time changes.
 std::optional<QString> loadStyleSheet(
     const std::filesystem::path& themesPath,
     const std::string& themeName);
@@ -76,7 +76,7 @@ std::optional<QDate> getDateFromCommitJson(const QJsonDocument &document,
   // Committer can be null, but that will just result in an Undefined value.
   const auto dateString = document["commit"]["committer"]["date"].toString();
   if (dateString.isEmpty()) {
-    const auto logger = getLogger();
+    const auto logger = getLogger(LogCategory::network);
     if (logger) {
       logger->error(
           "Error while checking for LOOT updates: couldn't get commit date for "
@@ -89,31 +89,57 @@ std::optional<QDate> getDateFromCommitJson(const QJsonDocument &document,
   return QDate::fromString(dateString, Qt::ISODate);
 }
 
+CheckForUpdateTask::CheckForUpdateTask(std::filesystem::path cachePath) :
+    cachePath(std::move(cachePath)) {}
+
 void CheckForUpdateTask::execute() {
   try {
-    // Delay construction of the manager so that it's created in the correct
-    // thread.
-    if (networkAccessManager == nullptr) {
-      networkAccessManager = new QNetworkAccessManager(this);
-    }
+    // Get the manager here so that it's the one for the correct thread.
+    networkAccessManager = getNetworkAccessManager();
 
     // Reset the tag commit date in case this task is being run twice somehow.
     tagCommitDate = std::nullopt;
 
-    sendHttpRequest("https://api.github.com/repos/loot/loot/releases/latest",
+    previousCache = LoadUpdateCheckCache(cachePath, gui::Version::revision);
+
+    auto request = createApiRequest(
+        "https://api.github.com/repos/loot/loot/releases/latest");
+
+    // GitHub doesn't count conditional requests that get a 304 Not Modified
+    // response against the API rate limit.
+    if (previousCache.has_value()) {
+      latestReleaseETag = previousCache.value().latestReleaseETag;
+      latestReleaseLastModified =
+          previousCache.value().latestReleaseLastModified;
+
+      if (!latestReleaseETag.empty()) {
+        request.setRawHeader("If-None-Match",
+                             QByteArray::fromStdString(latestReleaseETag));
+      }
+      if (!latestReleaseLastModified.empty()) {
+        request.setRawHeader(
+            "If-Modified-Since",
+            QByteArray::fromStdString(latestReleaseLastModified));
+      }
+    }
+
+    sendHttpRequest(request,
                     &CheckForUpdateTask::onGetLatestReleaseReplyFinished);
   } catch (const std::exception &e) {
     handleException(e);
   }
 }
 
-void CheckForUpdateTask::sendHttpRequest(
-    const std::string &url,
-    void (CheckForUpdateTask::*onFinished)()) {
-  QNetworkRequest request(QUrl(QString::fromStdString(url)));
-  request.setTransferTimeout(QNetworkRequest::DefaultTransferTimeout);
+QNetworkRequest CheckForUpdateTask::createApiRequest(const std::string &url) {
+  auto request = createGetRequest(url);
   request.setRawHeader("Accept", "application/vnd.github.v3+json");
 
+  return request;
+}
+
+void CheckForUpdateTask::sendHttpRequest(
+    const QNetworkRequest &request,
+    void (CheckForUpdateTask::*onFinished)()) {
   const auto reply = networkAccessManager->get(request);
 
   connect(reply, &QNetworkReply::finished, this, onFinished);
@@ -125,16 +151,59 @@ void CheckForUpdateTask::sendHttpRequest(
       reply, &QNetworkReply::sslErrors, this, &CheckForUpdateTask::onSSLError);
 }
 
+void CheckForUpdateTask::finish(bool isUpdateAvailable) {
+  try {
+    UpdateCheckCache cache;
+    cache.revision = gui::Version::revision;
+    cache.checkedAt = std::chrono::system_clock::now();
+    cache.isUpdateAvailable = isUpdateAvailable;
+    cache.latestReleaseETag = latestReleaseETag;
+    cache.latestReleaseLastModified = latestReleaseLastModified;
+
+    SaveUpdateCheckCache(cachePath, cache);
+  } catch (const std::exception &e) {
+    // Failing to cache the result doesn't affect the result.
+    const auto logger = getLogger(LogCategory::network);
+    if (logger) {
+      logger->error("Failed to write the update check cache to {}: {}",
+                    cachePath.u8string(),
+                    e.what());
+    }
+  }
+
+  emit finished(isUpdateAvailable);
+}
+
 void CheckForUpdateTask::onGetLatestReleaseReplyFinished() {
   try {
-    const auto logger = getLogger();
+    const auto logger = getLogger(LogCategory::network);
     if (logger) {
       logger->trace(
           "Finished receiving a response for getting the latest release's tag");
     }
 
-    const auto responseData =
-        readHttpResponse(qobject_cast<QNetworkReply *>(sender()));
+    const auto reply = qobject_cast<QNetworkReply *>(sender());
+
+    static constexpr int HTTP_STATUS_NOT_MODIFIED = 304;
+    const auto statusCode =
+        reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (statusCode == HTTP_STATUS_NOT_MODIFIED && previousCache.has_value()) {
+      reply->deleteLater();
+
+      if (logger) {
+        logger->debug(
+            "The latest LOOT release hasn't changed since the last update "
+            "check, reusing its result.");
+      }
+
+      finish(previousCache.value().isUpdateAvailable);
+      return;
+    }
+
+    latestReleaseETag = reply->rawHeader("ETag").toStdString();
+    latestReleaseLastModified = reply->rawHeader("Last-Modified").toStdString();
+
+    const auto responseData = readHttpResponse(reply);
 
     if (!responseData.has_value()) {
       emit error("No response data");
@@ -147,12 +216,12 @@ void CheckForUpdateTask::onGetLatestReleaseReplyFinished() {
     const auto comparisonResult = compareLOOTVersion(tagName);
 
     if (comparisonResult < 0) {
-      emit finished(true);
+      finish(true);
       return;
     }
 
     if (comparisonResult > 0) {
-      emit finished(false);
+      finish(false);
       return;
     }
 
@@ -160,7 +229,8 @@ void CheckForUpdateTask::onGetLatestReleaseReplyFinished() {
     // tag's commit hash.
     const auto url =
         "https://api.github.com/repos/loot/loot/commits/tags/" + tagName;
-    sendHttpRequest(url, &CheckForUpdateTask::onGetTagCommitReplyFinished);
+    sendHttpRequest(createApiRequest(url),
+                    &CheckForUpdateTask::onGetTagCommitReplyFinished);
   } catch (const std::exception &e) {
     handleException(e);
   }
@@ -168,7 +238,7 @@ void CheckForUpdateTask::onGetLatestReleaseReplyFinished() {
 
 void CheckForUpdateTask::onGetTagCommitReplyFinished() {
   try {
-    const auto logger = getLogger();
+    const auto logger = getLogger(LogCategory::network);
     if (logger) {
       logger->trace(
           "Finished receiving a response for getting the latest release tag's "
@@ -187,7 +257,7 @@ void CheckForUpdateTask::onGetTagCommitReplyFinished() {
     const auto commitHash = json["sha"].toString().toStdString();
 
     if (boost::istarts_with(commitHash, gui::Version::revision)) {
-      emit finished(false);
+      finish(false);
       return;
     }
 
@@ -202,7 +272,8 @@ void CheckForUpdateTask::onGetTagCommitReplyFinished() {
     // Now get the build commit ID to do the final comparison.
     const auto url = "https://api.github.com/repos/loot/loot/commits/" +
                      gui::Version::revision;
-    sendHttpRequest(url, &CheckForUpdateTask::onGetBuildCommitReplyFinished);
+    sendHttpRequest(createApiRequest(url),
+                    &CheckForUpdateTask::onGetBuildCommitReplyFinished);
   } catch (const std::exception &e) {
     handleException(e);
   }
@@ -210,7 +281,7 @@ void CheckForUpdateTask::onGetTagCommitReplyFinished() {
 
 void CheckForUpdateTask::onGetBuildCommitReplyFinished() {
   try {
-    const auto logger = getLogger();
+    const auto logger = getLogger(LogCategory::network);
     if (logger) {
       logger->trace(
           "Finished receiving a response for getting the LOOT build's "
@@ -240,13 +311,17 @@ void CheckForUpdateTask::onGetBuildCommitReplyFinished() {
     }
 
     if (tagCommitDate.value() > buildCommitDate.value()) {
-      logger->info("Tag date: {}, build date: {}",
-                   tagCommitDate.value().toString().toStdString(),
-                   buildCommitDate.value().toString().toStdString());
-      emit finished(true);
-    } else if (logger) {
-      logger->info("No LOOT update is available.");
-      emit finished(false);
+      if (logger) {
+        logger->info("Tag date: {}, build date: {}",
+                     tagCommitDate.value().toString().toStdString(),
+                     buildCommitDate.value().toString().toStdString());
+      }
+      finish(true);
+    } else {
+      if (logger) {
+        logger->info("No LOOT update is available.");
+      }
+      finish(false);
     }
   } catch (const std::exception &e) {
     handleException(e);
@@ -27,22 +27,38 @@
 #define LOOT_GUI_QT_TASKS_CHECK_FOR_UPDATE_TASK
 
 #include <QtNetwork/QNetworkAccessManager>
+#include <filesystem>
 
 #include "gui/qt/tasks/network_task.h"
+#include "gui/state/update_check_cache.h"
 
 namespace loot {
+// Checks GitHub for a newer LOOT release and caches the result at the given
+// path. If a previous result is cached, the latest release is requested
+// conditionally, and the cached result is reused if it hasn't changed.
 class CheckForUpdateTask : public NetworkTask {
   Q_OBJECT
+public:
+  explicit CheckForUpdateTask(std::filesystem::path cachePath);
+
 public slots:
   void execute() override;
 
 private:
   QNetworkAccessManager *networkAccessManager{nullptr};
+  std::filesystem::path cachePath;
+  std::optional<UpdateCheckCache> previousCache;
+  std::string latestReleaseETag;
+  std::string latestReleaseLastModified;
   std::optional<QDate> tagCommitDate;
 
-  void sendHttpRequest(const std::string &url,
+  static QNetworkRequest createApiRequest(const std::string &url);
+
+  void sendHttpRequest(const QNetworkRequest &request,
                        void (CheckForUpdateTask::*onFinished)());
 
+  void finish(bool isUpdateAvailable);
+
 private slots:
   void onGetLatestReleaseReplyFinished();
   void onGetTagCommitReplyFinished();
@@ -0,0 +1,147 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/qt/tasks/download_task.h"
+
+#include <QtCore/QTimer>
+#include <algorithm>
+#include <random>
+
+#include "gui/state/download_mirrors.h"
+
+namespace loot {
+// Requests that can fail over to another attempt give up sooner on a stalled
+// transfer than the last attempt does.
+static constexpr std::chrono::milliseconds FAILOVER_TRANSFER_TIMEOUT{10000};
+
+double getRandomJitter() {
+  thread_local std::mt19937 generator{std::random_device()()};
+  std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+  return distribution(generator);
+}
+
+void DownloadTask::download(const std::vector<std::string>& urls,
+                            const HttpCacheValidators& validators) {
+  // Get the manager here so that it's the one for the correct thread.
+  networkAccessManager = getNetworkAccessManager();
+
+  this->urls = GetDownloadMirrorRanking().Order(urls);
+  this->validators = validators;
+  attempt = 0;
+  maxAttempts = std::max(static_cast<unsigned int>(this->urls.size()), 2U);
+
+  sendRequest();
+}
+
+const std::string& DownloadTask::getCurrentUrl() const {
+  return urls.at(attempt % urls.size());
+}
+
+void DownloadTask::sendRequest() {
+  const auto& url = getCurrentUrl();
+
+  auto logger = getLogger(LogCategory::network);
+  if (logger) {
+    logger->trace("Sending a request to GET {} (attempt {} of {})",
+                  url,
+                  attempt + 1,
+                  maxAttempts);
+  }
+
+  auto request = createGetRequest(url);
+  if (attempt + 1 < maxAttempts) {
+    request.setTransferTimeout(FAILOVER_TRANSFER_TIMEOUT);
+  }
+  setHttpCacheValidators(request, validators);
+
+  requestTimer.start();
+  const auto reply = networkAccessManager->get(request);
+
+  connect(
+      reply, &QNetworkReply::finished, this, &DownloadTask::onReplyFinished);
+}
+
+void DownloadTask::onReplyFinished() {
+  try {
+    const auto reply = qobject_cast<QNetworkReply*>(sender());
+    const auto& url = getCurrentUrl();
+    auto logger = getLogger(LogCategory::network);
+
+    const auto networkError = reply->error();
+    if (networkError == QNetworkReply::NoError) {
+      const auto responseTime =
+          std::chrono::milliseconds(requestTimer.elapsed());
+      GetDownloadMirrorRanking().RecordSuccess(url, responseTime);
+
+      if (logger) {
+        logger->trace("Received a response from {} in {} ms",
+                      url,
+                      responseTime.count());
+      }
+
+      onDownloadFinished(reply);
+      return;
+    }
+
+    const auto errorString = reply->errorString().toStdString();
+    reply->deleteLater();
+
+    GetDownloadMirrorRanking().RecordFailure(url);
+
+    attempt += 1;
+    if (attempt >= maxAttempts) {
+      if (logger) {
+        logger->error("Network error code {} from {}, description is: {}",
+                      static_cast<int>(networkError),
+                      url,
+                      errorString);
+      }
+
+      emit error(errorString);
+      return;
+    }
+
+    const auto delay = GetRetryDelay(attempt - 1, getRandomJitter());
+    if (logger) {
+      logger->warn("Request to GET {} failed with \"{}\", trying {} in {} ms",
+                   url,
+                   errorString,
+                   getCurrentUrl(),
+                   delay.count());
+    }
+
+    QTimer::singleShot(delay, this, [this]() {
+      try {
+        sendRequest();
+      } catch (const std::exception& e) {
+        handleException(e);
+      }
+    });
+  } catch (const std::exception& e) {
+    handleException(e);
+  }
+}
+}
@@ -0,0 +1,71 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_QT_TASKS_DOWNLOAD_TASK
+#define LOOT_GUI_QT_TASKS_DOWNLOAD_TASK
+
+#include <QtCore/QElapsedTimer>
+#include <QtNetwork/QNetworkAccessManager>
+#include <string>
+#include <vector>
+
+#include "gui/qt/helpers.h"
+#include "gui/qt/tasks/network_task.h"
+
+namespace loot {
+// A network task that downloads a file that may be available from several
+// URLs. If a request fails, the next URL is tried after a short randomised
+// delay that grows with each failure, and URLs that responded quickly earlier
+// in the session are tried first.
+class DownloadTask : public NetworkTask {
+  Q_OBJECT
+protected:
+  // Send a GET request to the given URLs in turn until one of them responds.
+  // If there's only one URL it's retried once. An error is emitted if every
+  // attempt fails.
+  void download(const std::vector<std::string>& urls,
+                const HttpCacheValidators& validators);
+
+  // Called with the first reply that doesn't fail. The reply must be deleted
+  // later by the implementation.
+  virtual void onDownloadFinished(QNetworkReply* reply) = 0;
+
+private:
+  QNetworkAccessManager* networkAccessManager{nullptr};
+  std::vector<std::string> urls;
+  HttpCacheValidators validators;
+  unsigned int attempt{0};
+  unsigned int maxAttempts{0};
+  QElapsedTimer requestTimer;
+
+  const std::string& getCurrentUrl() const;
+  void sendRequest();
+
+private slots:
+  void onReplyFinished();
+};
+}
+
+#endif
@@ -25,11 +25,37 @@
 
 #include "gui/qt/tasks/network_task.h"
 
+#include <QtCore/QThreadStorage>
 #include <boost/locale.hpp>
 
 namespace loot {
+TaskThreadGroup NetworkTask::getThreadGroup() const {
+  return TaskThreadGroup::EventDriven;
+}
+
+QNetworkAccessManager *NetworkTask::getNetworkAccessManager() {
+  static QThreadStorage<QNetworkAccessManager *> networkAccessManagers;
+
+  if (!networkAccessManagers.hasLocalData()) {
+    networkAccessManagers.setLocalData(new QNetworkAccessManager());
+  }
+
+  return networkAccessManagers.localData();
+}
+
+QNetworkRequest NetworkTask::createGetRequest(const std::string &url) {
+  QNetworkRequest request(QUrl(QString::fromStdString(url)));
+  request.setTransferTimeout(QNetworkRequest::DefaultTransferTimeout);
+
+  // Don't set an Accept-Encoding header: if it's left unset Qt offers every
+  // encoding it supports (e.g. gzip and deflate, plus Brotli and Zstandard if
+  // available) and decodes the response as it's received, but if it's set Qt
+  // leaves decoding to the caller.
+  return request;
+}
+
 void NetworkTask::handleException(const std::exception &exception) {
-  const auto logger = getLogger();
+  const auto logger = getLogger(LogCategory::network);
   if (logger) {
     logger->error("Caught an exception: {}", exception.what());
   }
@@ -48,7 +74,7 @@ void NetworkTask::onNetworkError(QNetworkReply::NetworkError networkError) {
     const auto reply = qobject_cast<QIODevice *>(sender());
     const auto errorString = reply->errorString().toStdString();
 
-    const auto logger = getLogger();
+    const auto logger = getLogger(LogCategory::network);
     if (logger) {
       logger->error("Network error code {}, description is: {}",
                     static_cast<int>(networkError),
@@ -63,7 +89,7 @@ void NetworkTask::onNetworkError(QNetworkReply::NetworkError networkError) {
 
 void NetworkTask::onSSLError(const QList<QSslError> &errors) {
   try {
-    const auto logger = getLogger();
+    const auto logger = getLogger(LogCategory::network);
 
     std::string errorStrings;
     for (const auto &error : errors) {
@@ -26,6 +26,7 @@
 #ifndef LOOT_GUI_QT_TASKS_NETWORK_TASK
 #define LOOT_GUI_QT_TASKS_NETWORK_TASK
 
+#include <QtNetwork/QNetworkAccessManager>
 #include <QtNetwork/QNetworkReply>
 
 #include "gui/qt/tasks/tasks.h"
@@ -33,7 +34,18 @@
 namespace loot {
 class NetworkTask : public Task {
   Q_OBJECT
+public:
+  TaskThreadGroup getThreadGroup() const override;
+
 protected:
+  // Returns a network access manager that is shared by all network tasks
+  // that execute in the current thread. It's deleted when the thread exits.
+  static QNetworkAccessManager *getNetworkAccessManager();
+
+  // Creates a GET request for the given URL that allows the response to be
+  // compressed.
+  static QNetworkRequest createGetRequest(const std::string &url);
+
   void handleException(const std::exception &exception);
 
 protected slots:
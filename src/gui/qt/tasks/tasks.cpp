@@ -26,9 +26,52 @@
 #include "gui/qt/tasks/tasks.h"
 
 #include <QtConcurrent/QtConcurrent>
+#include <QtCore/QCoreApplication>
+#include <map>
+#include <memory>
+
+#include "gui/state/memory_accounting.h"
+#include "gui/state/thread_pool.h"
+#include "gui/state/timing.h"
 
 namespace loot {
-QueryTask::QueryTask(std::unique_ptr<Query> query) : query(std::move(query)) {}
+void scheduleTask(Task *task) {
+  // Delete the task once it's done, as otherwise it would live as long as
+  // its worker thread.
+  QObject::connect(task, &Task::finished, task, &QObject::deleteLater);
+  QObject::connect(task, &Task::error, task, &QObject::deleteLater);
+
+  // Time the task from when it's scheduled until it's done, which includes
+  // any time spent waiting for its worker thread to be free.
+  const auto timer =
+      std::make_shared<ScopedTimer>(task->metaObject()->className());
+  const auto memoryMeter =
+      std::make_shared<ScopedMemoryMeter>(task->metaObject()->className());
+  QObject::connect(task, &Task::finished, task, [timer, memoryMeter]() {
+    timer->stop();
+    memoryMeter->stop();
+  });
+  QObject::connect(task, &Task::error, task, [timer, memoryMeter]() {
+    timer->stop();
+    memoryMeter->stop();
+  });
+
+  task->moveToThread(getTaskWorkerThread(task->getThreadGroup()));
+
+  QMetaObject::invokeMethod(task, "execute", Qt::QueuedConnection);
+}
+
+TaskThreadGroup Task::getThreadGroup() const {
+  return TaskThreadGroup::Blocking;
+}
+
+QueryTask::QueryTask(std::unique_ptr<Query> query,
+                     TaskThreadGroup threadGroup) :
+    query(std::move(query)), threadGroup(threadGroup) {}
+
+TaskThreadGroup QueryTask::getThreadGroup() const {
+  return threadGroup;
+}
 
 void QueryTask::execute() {
   try {
@@ -37,7 +80,17 @@ void QueryTask::execute() {
           "Attempted to execute a query with no query set!");
     }
 
+    // The query may have been superseded while it was waiting to run.
+    query->getCancellationToken()->throwIfCancelled();
+
     emit finished(query->executeLogic());
+  } catch (const CancelledError &e) {
+    auto logger = getLogger();
+    if (logger) {
+      logger->debug("Query was cancelled");
+    }
+
+    emit error(e.what());
   } catch (const std::exception &e) {
     auto logger = getLogger();
     if (logger) {
@@ -55,14 +108,23 @@ void QueryTask::execute() {
 QFuture<QueryResult> executeBackgroundQuery(std::unique_ptr<Query> query) {
   const auto sharedQuery = std::shared_ptr<Query>(std::move(query));
 
-  return QtConcurrent::run([sharedQuery]() {
+  return QtConcurrent::run(&getThreadPool(), [sharedQuery]() {
     if (sharedQuery == nullptr) {
       throw std::runtime_error(
           "Attempted to execute a query with no query set!");
     }
 
     try {
+      sharedQuery->getCancellationToken()->throwIfCancelled();
+
       return sharedQuery->executeLogic();
+    } catch (const CancelledError &) {
+      const auto logger = getLogger();
+      if (logger) {
+        logger->debug("Query was cancelled");
+      }
+
+      throw;
     } catch (const std::exception &e) {
       const auto logger = getLogger();
       if (logger) {
@@ -78,6 +140,53 @@ QFuture<QueryResult> executeBackgroundQuery(std::unique_ptr<Query> query) {
   });
 }
 
+QThread *getTaskWorkerThread(TaskThreadGroup group) {
+  static std::map<TaskThreadGroup, QThread *> workerThreads;
+
+  const auto it = workerThreads.find(group);
+  if (it != workerThreads.end()) {
+    return it->second;
+  }
+
+  const auto workerThread = new QThread();
+  switch (group) {
+    case TaskThreadGroup::Blocking:
+      workerThread->setObjectName("LOOT blocking task worker");
+      break;
+    case TaskThreadGroup::EventDriven:
+      workerThread->setObjectName("LOOT event-driven task worker");
+      break;
+    case TaskThreadGroup::Idle:
+      workerThread->setObjectName("LOOT idle task worker");
+      break;
+  }
+
+  QObject::connect(QCoreApplication::instance(),
+                   &QCoreApplication::aboutToQuit,
+                   workerThread,
+                   [group, workerThread]() {
+                     static constexpr unsigned long STOP_TIMEOUT_MS = 5000;
+
+                     workerThread->quit();
+
+                     // Don't wait indefinitely for a blocking task to finish,
+                     // and leak the thread if it doesn't stop in time because
+                     // it can't be deleted while it's running.
+                     if (workerThread->wait(STOP_TIMEOUT_MS)) {
+                       workerThreads.erase(group);
+                       delete workerThread;
+                     }
+                   });
+
+  workerThread->start(group == TaskThreadGroup::Idle
+                          ? QThread::LowestPriority
+                          : QThread::InheritPriority);
+
+  workerThreads.emplace(group, workerThread);
+
+  return workerThread;
+}
+
 QFuture<QueryResult> taskFuture(Task *task) {
   QFuture<QueryResult> taskFinishedFuture =
       QtFuture::connect(task, &Task::finished);
@@ -87,7 +196,7 @@ QFuture<QueryResult> taskFuture(Task *task) {
       .then(
           [](std::variant<QFuture<QueryResult>, QFuture<std::string>> variant) {
             if (std::holds_alternative<QFuture<QueryResult>>(variant)) {
-              return std::get<QFuture<QueryResult>>(variant).result();
+              return std::get<QFuture<QueryResult>>(variant).takeResult();
             } else {
               throw std::runtime_error(
                   std::get<QFuture<std::string>>(variant).result().c_str());
@@ -105,40 +214,19 @@ QFuture<QList<QFuture<QueryResult>>> whenAllTasks(
   return QtFuture::whenAll(futures.begin(), futures.end());
 }
 
-void executeConcurrentBackgroundTasks(const std::vector<Task *> &tasks,
-                                      QFuture<void> whenAll) {
-  QThread *workerThread = new QThread();
-
-  QObject::connect(
-      workerThread, &QThread::finished, workerThread, &QObject::deleteLater);
-
-  whenAll.then(workerThread, [workerThread]() { workerThread->quit(); });
-
-  workerThread->start();
-
+void executeConcurrentBackgroundTasks(const std::vector<Task *> &tasks) {
   for (auto task : tasks) {
-    task->moveToThread(workerThread);
-
-    QMetaObject::invokeMethod(task, "execute", Qt::QueuedConnection);
+    scheduleTask(task);
   }
 }
 
 QFuture<QueryResult> executeBackgroundTask(Task *task) {
-  QThread *workerThread = new QThread();
-
-  QObject::connect(
-      workerThread, &QThread::finished, workerThread, &QObject::deleteLater);
-
-  workerThread->start();
+  // Get the future before scheduling the task so that its signals can't be
+  // missed.
+  auto future = taskFuture(task);
 
-  task->moveToThread(workerThread);
-
-  QMetaObject::invokeMethod(task, "execute", Qt::QueuedConnection);
+  scheduleTask(task);
 
-  return taskFuture(task).then(workerThread,
-                               [workerThread](QueryResult result) {
-                                 workerThread->quit();
-                                 return result;
-                               });
+  return future;
 }
 }
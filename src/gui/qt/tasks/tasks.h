@@ -41,10 +41,21 @@ class ProgressUpdater : public QObject {
   Q_OBJECT
 signals:
   void progressUpdate(const QString &message);
+  void pluginItemsLoaded(const PluginItems &items);
 };
 
+// Background tasks run on long-lived worker threads instead of a new thread
+// per task. Tasks that block while they execute are kept apart from tasks
+// that wait on events (e.g. network replies), so that the latter aren't held
+// up by the former. Idle tasks block too, but run at a low priority and
+// apart from other blocking tasks, so that they don't hold those up.
+enum class TaskThreadGroup { Blocking, EventDriven, Idle };
+
 class Task : public QObject {
   Q_OBJECT
+public:
+  virtual TaskThreadGroup getThreadGroup() const;
+
 public slots:
   virtual void execute() = 0;
 
@@ -56,25 +67,35 @@ signals:
 class QueryTask : public Task {
   Q_OBJECT
 public:
-  explicit QueryTask(std::unique_ptr<Query> query);
+  explicit QueryTask(std::unique_ptr<Query> query,
+                     TaskThreadGroup threadGroup = TaskThreadGroup::Blocking);
+
+  TaskThreadGroup getThreadGroup() const override;
 
 public slots:
   void execute() override;
 
 private:
   std::unique_ptr<Query> query;
+  TaskThreadGroup threadGroup;
 };
 
 QFuture<QueryResult> executeBackgroundQuery(std::unique_ptr<Query> query);
 
+// Returns the worker thread for the given group, starting it if it's not
+// already running. This must be called from the main thread. The worker
+// threads are stopped when the application is about to quit.
+QThread *getTaskWorkerThread(TaskThreadGroup group);
+
 QFuture<QueryResult> taskFuture(Task *task);
 
 QFuture<QList<QFuture<QueryResult>>> whenAllTasks(
     const std::vector<Task *> &tasks);
 
-void executeConcurrentBackgroundTasks(const std::vector<Task *> &tasks,
-                                      QFuture<void> whenAll);
+// The tasks are deleted once they finish.
+void executeConcurrentBackgroundTasks(const std::vector<Task *> &tasks);
 
+// The task is deleted once it finishes.
 QFuture<QueryResult> executeBackgroundTask(Task *task);
 }
 
@@ -30,16 +30,12 @@
 namespace loot {
 UpdatePreludeTask::UpdatePreludeTask(const LootState &state) :
     preludeSource(state.getSettings().getPreludeSource()),
-    preludePath(state.getPreludePath()) {}
+    preludePath(state.getPreludePath()),
+    sharedCachePath(state.getSettings().getSharedDownloadCachePath()),
+    mirrorUrls(state.getSettings().getDownloadMirrors(preludeSource)) {}
 
 void UpdatePreludeTask::execute() {
   try {
-    // Delay construction of the manager so that it's created in the correct
-    // thread.
-    if (networkAccessManager == nullptr) {
-      networkAccessManager = new QNetworkAccessManager(this);
-    }
-
     if (!isValidUrl(preludeSource)) {
       // Treat the source as a local path, and copy the file from there.
       auto sourcePath = std::filesystem::u8path(preludeSource);
@@ -50,42 +46,54 @@ void UpdatePreludeTask::execute() {
       return;
     }
 
-    auto logger = getLogger();
-    if (logger) {
-      logger->trace("Sending a prelude update request to GET {}",
-                    preludeSource);
+    // A recently-checked copy in the shared download cache avoids contacting
+    // the server at all.
+    if (!sharedCachePath.empty()) {
+      const auto preludeUpdated = updateFileFromSharedCache(
+          getSharedCacheEntryPath(sharedCachePath, preludeSource), preludePath);
+      if (preludeUpdated.has_value()) {
+        emit finished(preludeUpdated.value());
+        return;
+      }
     }
 
-    QNetworkRequest request(QUrl(QString::fromStdString(preludeSource)));
-    request.setTransferTimeout(QNetworkRequest::DefaultTransferTimeout);
+    // Hash the existing prelude once, as it's needed to get the request's
+    // validators and to check if the response data is different.
+    existingFileHash = calculateExistingGitBlobHash(preludePath);
 
-    const auto reply = networkAccessManager->get(request);
+    // Only download the prelude if it has changed since it was last
+    // downloaded.
+    const auto validators =
+        getHttpCacheValidators(preludePath, existingFileHash);
 
-    connect(reply,
-            &QNetworkReply::finished,
-            this,
-            &UpdatePreludeTask::onReplyFinished);
+    auto urls = mirrorUrls;
+    urls.insert(urls.begin(), preludeSource);
 
-    connect(reply,
-            &QNetworkReply::errorOccurred,
-            this,
-            &UpdatePreludeTask::onNetworkError);
-    connect(
-        reply, &QNetworkReply::sslErrors, this, &UpdatePreludeTask::onSSLError);
+    download(urls, validators);
   } catch (const std::exception &e) {
     handleException(e);
   }
 }
 
-void UpdatePreludeTask::onReplyFinished() {
+void UpdatePreludeTask::onDownloadFinished(QNetworkReply *reply) {
   try {
-    auto logger = getLogger();
+    auto logger = getLogger(LogCategory::network);
     if (logger) {
       logger->trace("Finished receiving a response for prelude update");
     }
 
-    auto responseData =
-        readHttpResponse(qobject_cast<QNetworkReply *>(sender()));
+    const auto validators = getHttpCacheValidators(*reply);
+
+    if (isHttpNotModifiedResponse(*reply)) {
+      reply->deleteLater();
+
+      updateFileRevisionDate(preludePath, validators, existingFileHash);
+      addToSharedCache();
+      emit finished(false);
+      return;
+    }
+
+    auto responseData = readHttpResponse(reply);
 
     if (!responseData.has_value()) {
       emit error("Prelude update response errored");
@@ -93,7 +101,11 @@ void UpdatePreludeTask::onReplyFinished() {
     }
 
     const auto preludeUpdated =
-        updateFileWithData(preludePath, responseData.value());
+        updateFileWithData(preludePath,
+                           responseData.value(),
+                           validators,
+                           existingFileHash);
+    addToSharedCache();
 
     emit finished(preludeUpdated);
   } catch (const std::exception &e) {
@@ -101,27 +113,36 @@ void UpdatePreludeTask::onReplyFinished() {
   }
 }
 
-UpdateMasterlistTask::UpdateMasterlistTask(const gui::Game &game) :
-    UpdateMasterlistTask(game.GetSettings().FolderName(),
-                         game.GetSettings().MasterlistSource(),
-                         game.MasterlistPath()) {}
+UpdateMasterlistTask::UpdateMasterlistTask(const gui::Game &game,
+                                           const LootSettings &settings) :
+    UpdateMasterlistTask(
+        game.GetSettings().FolderName(),
+        game.GetSettings().MasterlistSource(),
+        game.MasterlistPath(),
+        settings.getSharedDownloadCachePath(),
+        settings.getDownloadMirrors(game.GetSettings().MasterlistSource())) {}
 
 UpdateMasterlistTask::UpdateMasterlistTask(
     const std::string &gameFolderName,
     const std::string &masterlistSource,
-    const std::filesystem::path &masterlistPath) :
+    const std::filesystem::path &masterlistPath,
+    const std::filesystem::path &sharedCachePath,
+    const std::vector<std::string> &mirrorUrls) :
     gameFolderName(gameFolderName),
     masterlistSource(masterlistSource),
-    masterlistPath(masterlistPath) {}
+    masterlistPath(masterlistPath),
+    sharedCachePath(sharedCachePath),
+    mirrorUrls(mirrorUrls) {}
+
+void UpdatePreludeTask::addToSharedCache() {
+  if (!sharedCachePath.empty()) {
+    addFileToSharedCache(
+        preludePath, getSharedCacheEntryPath(sharedCachePath, preludeSource));
+  }
+}
 
 void UpdateMasterlistTask::execute() {
   try {
-    // Delay construction of the manager so that it's created in the correct
-    // thread.
-    if (networkAccessManager == nullptr) {
-      networkAccessManager = new QNetworkAccessManager(this);
-    }
-
     if (!isValidUrl(masterlistSource)) {
       // Treat the source as a local path, and copy the file from there.
       const auto sourcePath = std::filesystem::u8path(masterlistSource);
@@ -132,44 +153,56 @@ void UpdateMasterlistTask::execute() {
       return;
     }
 
-    auto logger = getLogger();
-    if (logger) {
-      logger->trace("Sending a masterlist update request to GET {}",
-                    masterlistSource);
+    // A recently-checked copy in the shared download cache avoids contacting
+    // the server at all.
+    if (!sharedCachePath.empty()) {
+      const auto masterlistUpdated = updateFileFromSharedCache(
+          getSharedCacheEntryPath(sharedCachePath, masterlistSource),
+          masterlistPath);
+      if (masterlistUpdated.has_value()) {
+        emit finished(
+            std::make_pair(gameFolderName, masterlistUpdated.value()));
+        return;
+      }
     }
 
-    QNetworkRequest request(QUrl(QString::fromStdString(masterlistSource)));
-    request.setTransferTimeout(QNetworkRequest::DefaultTransferTimeout);
+    // Hash the existing masterlist once, as it's needed to get the request's
+    // validators and to check if the response data is different.
+    existingFileHash = calculateExistingGitBlobHash(masterlistPath);
 
-    const auto reply = networkAccessManager->get(request);
+    // Only download the masterlist if it has changed since it was last
+    // downloaded.
+    const auto validators =
+        getHttpCacheValidators(masterlistPath, existingFileHash);
 
-    connect(reply,
-            &QNetworkReply::finished,
-            this,
-            &UpdateMasterlistTask::onReplyFinished);
+    auto urls = mirrorUrls;
+    urls.insert(urls.begin(), masterlistSource);
 
-    connect(reply,
-            &QNetworkReply::errorOccurred,
-            this,
-            &UpdateMasterlistTask::onNetworkError);
-    connect(reply,
-            &QNetworkReply::sslErrors,
-            this,
-            &UpdateMasterlistTask::onSSLError);
+    download(urls, validators);
   } catch (const std::exception &e) {
     handleException(e);
   }
 }
 
-void UpdateMasterlistTask::onReplyFinished() {
+void UpdateMasterlistTask::onDownloadFinished(QNetworkReply *reply) {
   try {
-    auto logger = getLogger();
+    auto logger = getLogger(LogCategory::network);
     if (logger) {
       logger->trace("Finished receiving a response for masterlist update");
     }
 
-    auto responseData =
-        readHttpResponse(qobject_cast<QNetworkReply *>(sender()));
+    const auto validators = getHttpCacheValidators(*reply);
+
+    if (isHttpNotModifiedResponse(*reply)) {
+      reply->deleteLater();
+
+      updateFileRevisionDate(masterlistPath, validators, existingFileHash);
+      addToSharedCache();
+      emit finished(std::make_pair(gameFolderName, false));
+      return;
+    }
+
+    auto responseData = readHttpResponse(reply);
 
     if (!responseData.has_value()) {
       emit error("Masterlist update response errored");
@@ -177,11 +210,23 @@ void UpdateMasterlistTask::onReplyFinished() {
     }
 
     const auto masterlistUpdated =
-        updateFileWithData(masterlistPath, responseData.value());
+        updateFileWithData(masterlistPath,
+                           responseData.value(),
+                           validators,
+                           existingFileHash);
+    addToSharedCache();
 
     emit finished(std::make_pair(gameFolderName, masterlistUpdated));
   } catch (const std::exception &e) {
     handleException(e);
   }
 }
+
+void UpdateMasterlistTask::addToSharedCache() {
+  if (!sharedCachePath.empty()) {
+    addFileToSharedCache(
+        masterlistPath,
+        getSharedCacheEntryPath(sharedCachePath, masterlistSource));
+  }
+}
 }
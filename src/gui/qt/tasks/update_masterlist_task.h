@@ -26,12 +26,15 @@
 #ifndef LOOT_GUI_QT_TASKS_UPDATE_MASTERLIST_TASK
 #define LOOT_GUI_QT_TASKS_UPDATE_MASTERLIST_TASK
 
-#include <QtNetwork/QNetworkAccessManager>
+#include <optional>
+#include <string>
+#include <vector>
 
-#include "gui/qt/tasks/network_task.h"
+#include "gui/qt/tasks/download_task.h"
+#include "gui/state/loot_settings.h"
 
 namespace loot {
-class UpdatePreludeTask : public NetworkTask {
+class UpdatePreludeTask : public DownloadTask {
   Q_OBJECT
 public:
   explicit UpdatePreludeTask(const LootState& state);
@@ -42,20 +45,25 @@ public slots:
 private:
   std::string preludeSource;
   std::filesystem::path preludePath;
+  std::filesystem::path sharedCachePath;
+  std::vector<std::string> mirrorUrls;
 
-  QNetworkAccessManager* networkAccessManager{nullptr};
+  std::optional<std::string> existingFileHash;
 
-private slots:
-  void onReplyFinished();
+  void addToSharedCache();
+
+  void onDownloadFinished(QNetworkReply* reply) override;
 };
 
-class UpdateMasterlistTask : public NetworkTask {
+class UpdateMasterlistTask : public DownloadTask {
   Q_OBJECT
 public:
-  explicit UpdateMasterlistTask(const gui::Game& game);
+  UpdateMasterlistTask(const gui::Game& game, const LootSettings& settings);
   UpdateMasterlistTask(const std::string& gameFolderName,
                        const std::string& masterlistSource,
-                       const std::filesystem::path& masterlistPath);
+                       const std::filesystem::path& masterlistPath,
+                       const std::filesystem::path& sharedCachePath = {},
+                       const std::vector<std::string>& mirrorUrls = {});
 
 public slots:
   void execute() override;
@@ -64,11 +72,14 @@ private:
   std::string gameFolderName;
   std::string masterlistSource;
   std::filesystem::path masterlistPath;
+  std::filesystem::path sharedCachePath;
+  std::vector<std::string> mirrorUrls;
+
+  std::optional<std::string> existingFileHash;
 
-  QNetworkAccessManager* networkAccessManager{nullptr};
+  void addToSharedCache();
 
-private slots:
-  void onReplyFinished();
+  void onDownloadFinished(QNetworkReply* reply) override;
 };
 }
 
@@ -27,10 +27,15 @@ along with LOOT.  If not, see
 #define LOOT_GUI_QUERY_QUERY
 
 #include <boost/locale.hpp>
+#include <filesystem>
+#include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <variant>
 
+#include "gui/cancellation_token.h"
 #include "gui/helpers.h"
 #include "gui/plugin_item.h"
 #include "gui/state/logging.h"
@@ -38,11 +43,23 @@ along with LOOT.  If not, see
 #include "gui/state/loot_state.h"
 
 namespace loot {
-typedef std::vector<std::pair<std::string, std::optional<short>>>
-    CancelSortResult;
+// Shared with the game, which records it when sorting.
+typedef std::shared_ptr<const gui::Game::LoadOrderIndices> CancelSortResult;
 typedef std::pair<std::string, bool> MasterlistUpdateResult;
 typedef std::vector<PluginItem> PluginItems;
-typedef std::vector<std::pair<PluginItem, bool>> GetOverlappingPluginsResult;
+// The plugin items are only given if plugins had to be loaded to check for
+// overlaps, as otherwise the items that are already displayed are up to date.
+typedef std::pair<std::vector<std::string>, std::optional<PluginItems>>
+    GetOverlappingPluginsResult;
+// The overlap counts are keyed by plugin CRC. The plugin items are only given
+// if plugins had to be loaded to count their overlaps.
+typedef std::pair<std::unordered_map<std::string, OverlapCount>,
+                  std::optional<PluginItems>>
+    GetOverlapCountsResult;
+// The bool is true if the plugin items are for all plugins in the load order.
+typedef std::pair<PluginItems, bool> RefreshGameDataResult;
+// The path of the backup's manifest, if there was anything to back up.
+typedef std::optional<std::filesystem::path> CreateBackupResult;
 
 typedef std::variant<std::monostate,
                      bool,
@@ -50,7 +67,10 @@ typedef std::variant<std::monostate,
                      MasterlistUpdateResult,
                      PluginItems,
                      PluginItem,
-                     GetOverlappingPluginsResult>
+                     GetOverlappingPluginsResult,
+                     GetOverlapCountsResult,
+                     RefreshGameDataResult,
+                     CreateBackupResult>
     QueryResult;
 
 class Query {
@@ -71,6 +91,35 @@ public:
                "main menu) for more information.")
         .str();
   };
+
+  // Queries that return the same key do the same kind of work, so a newer
+  // query supersedes any older query with the same key that is still running
+  // or waiting to run. Queries without a key are never superseded.
+  virtual std::optional<std::string> getSupersedingKey() const {
+    return std::nullopt;
+  }
+
+  // The token is shared with whatever runs the query, so that it can ask the
+  // query to stop early. Queries that check it throw a CancelledError once it
+  // has been cancelled.
+  std::shared_ptr<CancellationToken> getCancellationToken() const {
+    return cancellationToken_;
+  }
+
+  // Replaces the query's token before it runs, so that a query run as part of
+  // another query stops when the outer query is cancelled.
+  void setCancellationToken(std::shared_ptr<CancellationToken> token) {
+    cancellationToken_ = std::move(token);
+  }
+
+protected:
+  const CancellationToken& cancellationToken() const {
+    return *cancellationToken_;
+  }
+
+private:
+  std::shared_ptr<CancellationToken> cancellationToken_{
+      std::make_shared<CancellationToken>()};
 };
 }
 
@@ -41,12 +41,26 @@ public:
       game_(game), counter_(counter), plugins_(plugins) {}
 
   QueryResult executeLogic() override {
-    auto logger = getLogger();
+    auto logger = getLogger(LogCategory::sorting);
     if (logger) {
       logger->trace("User has accepted sorted load order, applying it.");
     }
     try {
-      game_.SetLoadOrder(plugins_);
+      // Setting the load order backs it up and rewrites the load order files
+      // (or plugin timestamps), which can trigger file sync clients and mod
+      // manager rescans, so don't do that if it wouldn't change anything.
+      // Reload the current load order first in case something else has
+      // changed it since sorting. An ambiguous load order is always set, as
+      // that's what makes it unambiguous.
+      game_.LoadCurrentLoadOrderState();
+      if (game_.GetLoadOrder() != plugins_ || game_.IsLoadOrderAmbiguous()) {
+        game_.SetLoadOrder(plugins_);
+      } else if (logger) {
+        logger->debug(
+            "The sorted load order is the same as the current load order, so "
+            "it doesn't need to be set.");
+      }
+      game_.PublishDataSnapshot();
       counter_.DecrementUnappliedChangeCounter();
     } catch (...) {
       useSortingErrorMessage = true;
@@ -27,6 +27,7 @@ along with LOOT.  If not, see
 #define LOOT_GUI_QUERY_CANCEL_SORT_QUERY
 
 #include <functional>
+#include <memory>
 
 #include "gui/query/query.h"
 #include "gui/state/game/game.h"
@@ -38,7 +39,7 @@ public:
       game_(game), counter_(counter) {}
 
   QueryResult executeLogic() override {
-    auto logger = getLogger();
+    auto logger = getLogger(LogCategory::sorting);
     if (logger) {
       logger->trace("User has rejected sorted load order, discarding it.");
     }
@@ -46,6 +47,13 @@ public:
     counter_.DecrementUnappliedChangeCounter();
     game_.DecrementLoadOrderSortCount();
 
+    // The load order that sorting started from is normally recorded, so it
+    // doesn't need to be read from the plugins again.
+    auto preSortLoadOrder = game_.GetPreSortLoadOrder();
+    if (preSortLoadOrder) {
+      return preSortLoadOrder;
+    }
+
     const std::function<std::pair<std::string, std::optional<short>>(
         const PluginInterface* const, std::optional<short>, bool)>
         mapper = [](const PluginInterface* const plugin,
@@ -54,7 +62,8 @@ public:
           return std::make_pair(plugin->GetName(), loadOrderIndex);
         };
 
-    return MapFromLoadOrderData(game_, game_.GetLoadOrder(), mapper);
+    return std::make_shared<const gui::Game::LoadOrderIndices>(
+        MapFromLoadOrderData(game_, game_.GetLoadOrder(), mapper));
   }
 
 private:
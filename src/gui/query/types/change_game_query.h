@@ -31,17 +31,62 @@ along with LOOT.  If not, see
 namespace loot {
 class ChangeGameQuery : public Query {
 public:
+  // The given plugin items are those currently displayed for the current
+  // game, which are kept with it if it remains loaded.
   ChangeGameQuery(GamesManager& gamesManager,
                   std::string language,
                   std::string gameFolder,
+                  PluginItems currentPluginItems,
+                  size_t maxResidentGames,
                   std::function<void(std::string)> sendProgressUpdate) :
       gamesManager_(gamesManager),
       gameFolder_(gameFolder),
       language_(language),
+      currentPluginItems_(std::move(currentPluginItems)),
+      maxResidentGames_(maxResidentGames),
       sendProgressUpdate_(sendProgressUpdate) {}
 
   QueryResult executeLogic() override {
+    // If the new game is being preloaded, wait for it so that it isn't
+    // loaded twice. Preloading any other game doesn't get in the way.
+    gamesManager_.WaitForPreloadingGame(gameFolder_);
+
+    std::optional<std::string> previousGameFolder;
+    if (gamesManager_.HasCurrentGame()) {
+      previousGameFolder =
+          gamesManager_.GetCurrentGame().GetSettings().FolderName();
+    }
+
     gamesManager_.SetCurrentGame(gameFolder_);
+
+    // Take the new game's plugin items before keeping the previous game, so
+    // that keeping it can't evict the new game.
+    auto residentPluginItems =
+        gamesManager_.TakeResidentPluginItems(language_);
+
+    if (previousGameFolder.has_value()) {
+      gamesManager_.RetainGame(previousGameFolder.value(),
+                               std::move(currentPluginItems_),
+                               language_,
+                               maxResidentGames_);
+    }
+    if (residentPluginItems.has_value()) {
+      // The game's files are unchanged, but the load order and active
+      // plugins are stored outside them, so may still have changed.
+      sendProgressUpdate_(
+          boost::locale::translate("Checking for load order changes…"));
+
+      auto& game = gamesManager_.GetCurrentGame();
+      game.LoadCurrentLoadOrderState();
+      game.PublishDataSnapshot();
+
+      return GetPluginItems(game.GetLoadOrder(),
+                            game,
+                            language_,
+                            residentPluginItems.value(),
+                            &cancellationToken());
+    }
+
     gamesManager_.GetCurrentGame().Init();
 
     GetGameDataQuery subQuery(
@@ -54,6 +99,8 @@ private:
   GamesManager& gamesManager_;
   const std::string gameFolder_;
   const std::string language_;
+  PluginItems currentPluginItems_;
+  const size_t maxResidentGames_;
   const std::function<void(std::string)> sendProgressUpdate_;
 };
 }
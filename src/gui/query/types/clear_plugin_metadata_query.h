@@ -48,13 +48,12 @@ public:
 
     auto plugin = game_.GetPlugin(pluginName_);
     if (plugin) {
-      return PluginItem(
-          game_.GetSettings().Id(),
-          *plugin,
-          game_,
-          game_.GetActiveLoadOrderIndex(*plugin, game_.GetLoadOrder()),
-          game_.IsPluginActive(plugin->GetName()),
-          language_);
+      return PluginItem(game_.GetSettings().Id(),
+                        *plugin,
+                        game_,
+                        game_.GetActiveLoadOrderIndex(*plugin),
+                        game_.IsPluginActive(plugin->GetName()),
+                        language_);
     }
 
     return std::monostate();
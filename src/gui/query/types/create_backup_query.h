@@ -0,0 +1,77 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_QUERY_CREATE_BACKUP_QUERY
+#define LOOT_GUI_QUERY_CREATE_BACKUP_QUERY
+
+#include <filesystem>
+#include <string>
+#include <utility>
+
+#include "gui/backup.h"
+#include "gui/query/query.h"
+
+namespace loot {
+// Backs up LOOT's data folder into its backups folder, then deletes old
+// backups according to the given policy.
+class CreateBackupQuery : public Query {
+public:
+  CreateBackupQuery(std::filesystem::path lootDataPath,
+                    std::string backupName,
+                    int compressionLevel,
+                    BackupRetentionPolicy retentionPolicy) :
+      lootDataPath_(std::move(lootDataPath)),
+      backupName_(std::move(backupName)),
+      compressionLevel_(compressionLevel),
+      retentionPolicy_(retentionPolicy) {}
+
+  QueryResult executeLogic() override {
+    const auto backupsDir = lootDataPath_ / "backups";
+
+    auto backupPath = createIncrementalBackup(
+        lootDataPath_, backupsDir, backupName_, compressionLevel_);
+
+    // Failing to delete old backups shouldn't stop the new backup being used.
+    try {
+      enforceBackupRetentionPolicy(backupsDir, retentionPolicy_);
+    } catch (const std::exception& e) {
+      auto logger = getLogger();
+      if (logger) {
+        logger->error("Failed to delete old backups: {}", e.what());
+      }
+    }
+
+    return CreateBackupResult(std::move(backupPath));
+  }
+
+private:
+  const std::filesystem::path lootDataPath_;
+  const std::string backupName_;
+  const int compressionLevel_;
+  const BackupRetentionPolicy retentionPolicy_;
+};
+}
+
+#endif
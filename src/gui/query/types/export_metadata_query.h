@@ -0,0 +1,89 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_QUERY_EXPORT_METADATA_QUERY
+#define LOOT_GUI_QUERY_EXPORT_METADATA_QUERY
+
+#include <loot/exception/file_access_error.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+
+#include "gui/query/query.h"
+#include "gui/state/game/game.h"
+
+namespace loot {
+class ExportMetadataQuery : public Query {
+public:
+  // The metadata is read from the snapshot, so that exporting it can run
+  // while the game is changed.
+  ExportMetadataQuery(std::shared_ptr<const GameDataSnapshot> snapshot,
+                      std::vector<std::string> pluginNames,
+                      std::filesystem::path outputPath) :
+      snapshot_(std::move(snapshot)),
+      pluginNames_(std::move(pluginNames)),
+      outputPath_(std::move(outputPath)) {}
+
+  QueryResult executeLogic() override {
+    auto logger = getLogger();
+    if (logger) {
+      logger->debug("Exporting metadata for {} plugins to \"{}\"",
+                    pluginNames_.size(),
+                    outputPath_.u8string());
+    }
+
+    // Use a larger buffer than the default, as the output may be many
+    // megabytes when exporting metadata for thousands of plugins.
+    static constexpr size_t BUFFER_SIZE = 1024 * 1024;
+    std::vector<char> buffer(BUFFER_SIZE);
+
+    std::ofstream out;
+    out.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+    out.open(outputPath_, std::ios_base::out | std::ios_base::binary);
+    if (!out.is_open()) {
+      throw FileAccessError("Couldn't open \"" + outputPath_.u8string() +
+                            "\" for writing");
+    }
+
+    WriteMetadataAsYaml(*snapshot_, pluginNames_, out);
+
+    out.close();
+    if (out.fail()) {
+      throw FileAccessError("Couldn't write metadata to \"" +
+                            outputPath_.u8string() + "\"");
+    }
+
+    return std::monostate();
+  }
+
+private:
+  const std::shared_ptr<const GameDataSnapshot> snapshot_;
+  const std::vector<std::string> pluginNames_;
+  const std::filesystem::path outputPath_;
+};
+}
+
+#endif
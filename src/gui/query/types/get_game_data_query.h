@@ -27,20 +27,32 @@ along with LOOT.  If not, see
 #define LOOT_GUI_QUERY_GET_GAME_DATA_QUERY
 
 #include <boost/locale.hpp>
+#include <functional>
+#include <vector>
 
 #include "gui/query/query.h"
 #include "gui/state/game/game.h"
+#include "gui/state/thread_pool.h"
 #include "loot/loot_version.h"
 
 namespace loot {
 class GetGameDataQuery : public Query {
 public:
-  GetGameDataQuery(gui::Game& game,
-                   std::string language,
-                   std::function<void(std::string)> sendProgressUpdate) :
+  GetGameDataQuery(
+      gui::Game& game,
+      std::string language,
+      std::function<void(std::string)> sendProgressUpdate,
+      std::function<void(PluginItems)> sendPluginItems = nullptr,
+      bool sendActivePluginItemsFirst = false) :
       game_(game),
       language_(language),
-      sendProgressUpdate_(sendProgressUpdate) {}
+      sendProgressUpdate_(sendProgressUpdate),
+      sendPluginItems_(sendPluginItems),
+      sendActivePluginItemsFirst_(sendActivePluginItemsFirst) {}
+
+  std::optional<std::string> getSupersedingKey() const override {
+    return "GetGameData";
+  }
 
   QueryResult executeLogic() override {
     sendProgressUpdate_(boost::locale::translate(
@@ -50,58 +62,55 @@ public:
        the game data, so also load the metadata lists. */
     bool isFirstLoad = game_.GetPlugins().empty();
 
-    std::exception_ptr exceptionPointer;
-    std::vector<std::thread> threads;
+    // Loading plugins, metadata and Creation Club plugin names are
+    // independent of one another, so run them concurrently. Creating plugin
+    // items needs all three, so it can't start until they're all done.
+    // If more than one stage fails, the error from the first in this order
+    // is the one that's rethrown, so it doesn't depend on thread timing.
+    std::vector<std::function<void()>> stages;
 
-    threads.push_back(std::thread([&]() {
-      try {
-        game_.LoadAllInstalledPlugins(true);
-      } catch (...) {
-        if (exceptionPointer == nullptr) {
-          exceptionPointer = std::current_exception();
-        }
-      }
-    }));
+    // Each stage checks the token before it starts, as the query may have
+    // been abandoned while the stage waited for a thread.
+    stages.push_back([this]() {
+      game_.LoadAllInstalledPlugins(true, &cancellationToken());
+    });
 
     if (isFirstLoad) {
-      threads.push_back(std::thread([&]() {
-        try {
-          game_.LoadMetadata();
-        } catch (...) {
-          if (exceptionPointer == nullptr) {
-            exceptionPointer = std::current_exception();
-          }
-        }
-      }));
+      stages.push_back([this]() {
+        cancellationToken().throwIfCancelled();
+        game_.LoadMetadata();
+      });
     }
 
-    threads.push_back(std::thread([&]() {
-      try {
-        game_.LoadCreationClubPluginNames();
-      } catch (...) {
-        if (exceptionPointer == nullptr) {
-          exceptionPointer = std::current_exception();
-        }
-      }
-    }));
-
-    for (auto& thread : threads) {
-      if (thread.joinable()) {
-        thread.join();
-        if (exceptionPointer != nullptr) {
-          std::rethrow_exception(exceptionPointer);
-        }
-      }
-    }
+    stages.push_back([this]() {
+      cancellationToken().throwIfCancelled();
+      game_.LoadCreationClubPluginNames();
+    });
+
+    runConcurrently(stages);
+
+    // Don't bother creating plugin items if the query has been abandoned.
+    cancellationToken().throwIfCancelled();
+
+    game_.PublishDataSnapshot();
 
-    // Sort plugins into their load order.
-    return GetPluginItems(game_.GetLoadOrder(), game_, language_);
+    // Sort plugins into their load order. If plugin items are being sent as
+    // they're created, the result still holds all of them, in load order even
+    // if the active plugins' items were sent first.
+    return GetPluginItems(game_.GetLoadOrder(),
+                          game_,
+                          language_,
+                          &cancellationToken(),
+                          sendPluginItems_,
+                          sendActivePluginItemsFirst_);
   }
 
 private:
   gui::Game& game_;
   std::string language_;
   std::function<void(std::string)> sendProgressUpdate_;
+  std::function<void(PluginItems)> sendPluginItems_;
+  bool sendActivePluginItemsFirst_{false};
 };
 }
 
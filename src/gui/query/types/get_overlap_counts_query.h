@@ -0,0 +1,93 @@
+/*  LOOT
+
+A load order optimisation tool for
+Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+Copyright (C) 2014 WrinklyNinja
+
+This file is part of LOOT.
+
+LOOT is free software: you can redistribute
+it and/or modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+LOOT is distributed in the hope that it will
+be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LOOT.  If not, see
+<https://www.gnu.org/licenses/>.
+*/
+
+#ifndef LOOT_GUI_QUERY_GET_OVERLAP_COUNTS_QUERY
+#define LOOT_GUI_QUERY_GET_OVERLAP_COUNTS_QUERY
+
+#include "gui/query/query.h"
+#include "gui/state/game/game.h"
+
+namespace loot {
+class GetOverlapCountsQuery : public Query {
+public:
+  GetOverlapCountsQuery(gui::Game& game,
+                        std::string language,
+                        bool releaseRecordData) :
+      game_(game),
+      language_(language),
+      releaseRecordData_(releaseRecordData) {}
+
+  std::optional<std::string> getSupersedingKey() const override {
+    return "GetOverlapCounts";
+  }
+
+  QueryResult executeLogic() override {
+    auto logger = getLogger();
+    if (logger) {
+      logger->debug("Counting the plugins that each plugin overlaps with");
+    }
+
+    const auto loadedPlugins = !game_.ArePluginsFullyLoaded();
+    if (loadedPlugins)
+      game_.LoadAllInstalledPlugins(false);
+
+    cancellationToken().throwIfCancelled();
+
+    // Only plugins that are new or have changed since the index was last
+    // updated get compared, so the counts are cheap to keep up to date.
+    game_.UpdateRecordOverlapIndex();
+
+    if (loadedPlugins) {
+      game_.PublishDataSnapshot();
+    }
+
+    cancellationToken().throwIfCancelled();
+
+    GetOverlapCountsResult result;
+    result.first = game_.GetRecordOverlapCounts();
+
+    if (releaseRecordData_) {
+      cancellationToken().throwIfCancelled();
+      game_.ReleasePluginRecordData();
+    }
+
+    // Fully loaded plugins have CRCs, which the counts are checked against,
+    // so the displayed items need to be rebuilt.
+    if (loadedPlugins) {
+      result.second = GetPluginItems(
+          game_.GetLoadOrder(), game_, language_, &cancellationToken());
+    }
+
+    return result;
+  }
+
+private:
+  gui::Game& game_;
+  std::string language_;
+  const bool releaseRecordData_;
+};
+}
+
+#endif
@@ -34,8 +34,24 @@ class GetOverlappingPluginsQuery : public Query {
 public:
   GetOverlappingPluginsQuery(gui::Game& game,
                              std::string language,
-                             std::string pluginName) :
-      game_(game), language_(language), pluginName_(pluginName) {}
+                             std::string pluginName,
+                             bool releaseRecordData) :
+      game_(game),
+      language_(language),
+      pluginName_(pluginName),
+      releaseRecordData_(releaseRecordData),
+      isSupersedable_(game.ArePluginsFullyLoaded()) {}
+
+  std::optional<std::string> getSupersedingKey() const override {
+    // A query that fully loads the plugins is the only one that knows to
+    // rebuild the plugin items afterwards, as a later query would find the
+    // plugins already fully loaded. It therefore can't be superseded.
+    if (!isSupersedable_) {
+      return std::nullopt;
+    }
+
+    return "GetOverlappingPlugins";
+  }
 
   QueryResult executeLogic() override {
     auto logger = getLogger();
@@ -46,44 +62,85 @@ public:
     // Checking for FormID overlap will only work if the plugins have been
     // loaded, so check if the plugins have been fully loaded, and if not load
     // all plugins.
-    if (!game_.ArePluginsFullyLoaded())
+    const auto loadedPlugins = !game_.ArePluginsFullyLoaded();
+    if (loadedPlugins)
       game_.LoadAllInstalledPlugins(false);
 
-    return getResult();
+    cancellationToken().throwIfCancelled();
+
+    // Fully loading the plugins gives the snapshot their CRCs.
+    if (loadedPlugins) {
+      game_.PublishDataSnapshot();
+    }
+
+    GetOverlappingPluginsResult result;
+    result.first = getOverlappingPluginNames();
+
+    // The plugin has now been compared against every other plugin, so index
+    // it, so that the index is built up as the filter is used instead of
+    // making the user wait for every pair of plugins to be compared.
+    game_.AddToRecordOverlapIndex(pluginName_, result.first);
+
+    // Keeping every plugin's records loaded can use gigabytes of memory, so
+    // optionally go back to having only the plugins' headers loaded.
+    if (releaseRecordData_) {
+      cancellationToken().throwIfCancelled();
+      game_.ReleasePluginRecordData();
+    }
+
+    // Loading the plugins fully gives them data that the displayed items
+    // won't have, so the items need to be rebuilt.
+    if (loadedPlugins) {
+      result.second = GetPluginItems(
+          game_.GetLoadOrder(), game_, language_, &cancellationToken());
+    }
+
+    return result;
   }
 
 private:
-  std::vector<std::pair<PluginItem, bool>> getResult() {
-    std::vector<std::pair<PluginItem, bool>> result;
-
+  std::vector<std::string> getOverlappingPluginNames() const {
     auto plugin = game_.GetPlugin(pluginName_);
     if (!plugin) {
       throw std::runtime_error("The plugin \"" + pluginName_ +
                                "\" is not loaded.");
     }
 
-    const std::function<std::pair<PluginItem, bool>(
-        const PluginInterface* const, std::optional<short>, bool)>
-        mapper = [&](const PluginInterface* const otherPlugin,
-                     std::optional<short> loadOrderIndex,
-                     bool isActive) {
-          const auto pluginItem = PluginItem(game_.GetSettings().Id(),
-                                             *otherPlugin,
-                                             game_,
-                                             loadOrderIndex,
-                                             isActive,
-                                             language_);
-          const auto overlap = plugin->DoRecordsOverlap(*otherPlugin);
-
-          return std::make_pair(pluginItem, overlap);
-        };
-
-    return MapFromLoadOrderData(game_, game_.GetLoadOrder(), mapper);
+    std::vector<std::string> overlappingPluginNames;
+    for (const auto& otherPluginName : game_.GetLoadOrder()) {
+      cancellationToken().throwIfCancelled();
+
+      const auto otherPlugin = game_.GetPlugin(otherPluginName);
+      if (otherPlugin && doRecordsOverlap(*plugin, *otherPlugin)) {
+        overlappingPluginNames.push_back(otherPlugin->GetName());
+      }
+    }
+
+    return overlappingPluginNames;
+  }
+
+  bool doRecordsOverlap(const PluginInterface& plugin,
+                        const PluginInterface& otherPlugin) const {
+    const auto crc = plugin.GetCRC();
+    const auto otherCrc = otherPlugin.GetCRC();
+    if (crc.has_value() && otherCrc.has_value()) {
+      const auto overlap = game_.DoIndexedRecordsOverlap(plugin.GetName(),
+                                                         crc.value(),
+                                                         otherPlugin.GetName(),
+                                                         otherCrc.value());
+      if (overlap.has_value()) {
+        return overlap.value();
+      }
+    }
+
+    return plugin.DoRecordsOverlap(otherPlugin);
   }
 
   gui::Game& game_;
   std::string language_;
   const std::string pluginName_;
+  const bool releaseRecordData_;
+  const bool isSupersedable_;
 };
 }
 
@@ -0,0 +1,94 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_QUERY_PRELOAD_GAME_QUERY
+#define LOOT_GUI_QUERY_PRELOAD_GAME_QUERY
+
+#include "gui/query/types/get_game_data_query.h"
+#include "gui/state/game/games_manager.h"
+
+namespace loot {
+// Loads a game that isn't current and keeps it resident, so that switching
+// to it later doesn't need to load it. Does nothing if the game is current,
+// already resident, already being preloaded or not installed.
+class PreloadGameQuery : public Query {
+public:
+  PreloadGameQuery(GamesManager& gamesManager,
+                   std::string language,
+                   std::string gameFolder,
+                   size_t maxResidentGames) :
+      gamesManager_(gamesManager),
+      gameFolder_(std::move(gameFolder)),
+      language_(std::move(language)),
+      maxResidentGames_(maxResidentGames) {}
+
+  QueryResult executeLogic() override {
+    auto game = gamesManager_.BeginPreloadingGame(gameFolder_);
+    if (!game.has_value()) {
+      return std::monostate();
+    }
+
+    auto logger = getLogger(LogCategory::loading);
+    if (logger) {
+      logger->debug("Preloading the game with folder: {}", gameFolder_);
+    }
+
+    // A game that fails to load is just discarded, as it's separate from
+    // the installed game.
+    try {
+      game->Init();
+
+      cancellationToken().throwIfCancelled();
+
+      GetGameDataQuery subQuery(*game, language_, [](const std::string&) {});
+      subQuery.setCancellationToken(getCancellationToken());
+
+      auto pluginItems = std::get<PluginItems>(subQuery.executeLogic());
+
+      cancellationToken().throwIfCancelled();
+
+      gamesManager_.RetainPreloadedGame(std::move(game.value()),
+                                        std::move(pluginItems),
+                                        language_,
+                                        maxResidentGames_);
+    } catch (...) {
+      gamesManager_.EndPreloadingGame(gameFolder_);
+      throw;
+    }
+
+    gamesManager_.EndPreloadingGame(gameFolder_);
+
+    return std::monostate();
+  }
+
+private:
+  GamesManager& gamesManager_;
+  const std::string gameFolder_;
+  const std::string language_;
+  const size_t maxResidentGames_;
+};
+}
+
+#endif
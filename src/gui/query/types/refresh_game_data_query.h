@@ -0,0 +1,123 @@
+/*  LOOT
+
+A load order optimisation tool for
+Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+Copyright (C) 2014 WrinklyNinja
+
+This file is part of LOOT.
+
+LOOT is free software: you can redistribute
+it and/or modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+LOOT is distributed in the hope that it will
+be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LOOT.  If not, see
+<https://www.gnu.org/licenses/>.
+*/
+
+#ifndef LOOT_GUI_QUERY_REFRESH_GAME_DATA_QUERY
+#define LOOT_GUI_QUERY_REFRESH_GAME_DATA_QUERY
+
+#include <boost/locale.hpp>
+
+#include "gui/query/query.h"
+#include "gui/state/game/game.h"
+#include "gui/state/game/game_data_changes.h"
+
+namespace loot {
+// Reloads only the game data that the given changes affect. If only plugins'
+// contents have changed, only the changed plugins' items are returned,
+// otherwise all plugins' items are returned.
+class RefreshGameDataQuery : public Query {
+public:
+  RefreshGameDataQuery(gui::Game& game,
+                       std::string language,
+                       GameDataChanges changes,
+                       std::function<void(std::string)> sendProgressUpdate) :
+      game_(game),
+      language_(language),
+      changes_(std::move(changes)),
+      sendProgressUpdate_(sendProgressUpdate) {}
+
+  QueryResult executeLogic() override {
+    sendProgressUpdate_(
+        boost::locale::translate("Refreshing changed game data…"));
+
+    auto logger = getLogger(LogCategory::loading);
+
+    const auto loadOrderBefore = game_.GetLoadOrder();
+
+    if (changes_.metadataChanged) {
+      game_.LoadMetadata();
+    }
+
+    // Plugins can't be unloaded individually, so if any have been removed,
+    // all plugins need to be reloaded.
+    auto reloadAllPlugins = !changes_.removedPlugins.empty();
+    if (!reloadAllPlugins) {
+      if (changes_.loadOrderChanged || !changes_.changedPlugins.empty()) {
+        game_.LoadCurrentLoadOrderState();
+      }
+
+      if (!changes_.changedPlugins.empty()) {
+        const std::vector<std::string> pluginNames(
+            changes_.changedPlugins.begin(), changes_.changedPlugins.end());
+        reloadAllPlugins = !game_.ReloadPlugins(pluginNames, true);
+      }
+    }
+
+    if (reloadAllPlugins) {
+      if (logger) {
+        logger->debug("Reloading all installed plugins.");
+      }
+      game_.LoadAllInstalledPlugins(true);
+    }
+
+    game_.PublishDataSnapshot();
+
+    // Changes to the active plugins file may change which plugins are active
+    // without changing the load order, so always remap all plugins then.
+    const auto loadOrder = game_.GetLoadOrder();
+    if (reloadAllPlugins || changes_.metadataChanged ||
+        changes_.loadOrderChanged || loadOrder != loadOrderBefore) {
+      return RefreshGameDataResult(GetPluginItems(loadOrder, game_, language_),
+                                   true);
+    }
+
+    // A plugin's card can show messages about its masters and requirements,
+    // so the plugins that depend on a changed plugin need to be remapped too.
+    auto pluginsToRemap = changes_.changedPlugins;
+    const auto dependentsIndex = game_.GetPluginDependentsIndex();
+    for (const auto& pluginName : changes_.changedPlugins) {
+      const auto& dependents = dependentsIndex->GetDependents(pluginName);
+      pluginsToRemap.insert(dependents.begin(), dependents.end());
+    }
+
+    std::vector<std::string> changedPluginNames;
+    for (const auto& pluginName : loadOrder) {
+      if (pluginsToRemap.count(pluginName) != 0) {
+        changedPluginNames.push_back(pluginName);
+      }
+    }
+
+    return RefreshGameDataResult(
+        GetPluginItems(changedPluginNames, game_, language_), false);
+  }
+
+private:
+  gui::Game& game_;
+  std::string language_;
+  GameDataChanges changes_;
+  std::function<void(std::string)> sendProgressUpdate_;
+};
+}
+
+#endif
@@ -44,8 +44,12 @@ public:
       counter_(counter),
       sendProgressUpdate_(sendProgressUpdate) {}
 
+  std::optional<std::string> getSupersedingKey() const override {
+    return "SortPlugins";
+  }
+
   QueryResult executeLogic() override {
-    auto logger = getLogger();
+    auto logger = getLogger(LogCategory::sorting);
     if (logger) {
       logger->info("Beginning sorting operation.");
     }
@@ -54,6 +58,10 @@ public:
     sendProgressUpdate_(boost::locale::translate("Sorting load order…"));
     std::vector<std::string> plugins = game_.SortPlugins();
 
+    // Sorting can't be interrupted, but there's no point in creating plugin
+    // items for a sort that has been abandoned.
+    cancellationToken().throwIfCancelled();
+
     auto result = getResult(plugins);
 
     // plugins will be empty if there was a sorting error.
@@ -67,15 +75,26 @@ public:
     return result;
   }
 
+  // Sorting usually only changes plugins' load order indices, so items for
+  // plugins that are otherwise unchanged are reused instead of derived again.
+  void setCurrentPluginItems(std::vector<PluginItem> pluginItems) {
+    currentPluginItems_ = std::move(pluginItems);
+  }
+
 private:
   std::vector<PluginItem> getResult(const std::vector<std::string>& plugins) {
-    return GetPluginItems(plugins, game_, language_);
+    return GetPluginItems(plugins,
+                          game_,
+                          language_,
+                          currentPluginItems_,
+                          &cancellationToken());
   }
 
   gui::Game& game_;
   std::string language_;
   UnappliedChangeCounter& counter_;
   const std::function<void(std::string)> sendProgressUpdate_;
+  std::vector<PluginItem> currentPluginItems_;
 };
 }
 
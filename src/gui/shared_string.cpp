@@ -0,0 +1,86 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/shared_string.h"
+
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace {
+struct SharedStringPool {
+  std::shared_mutex mutex;
+  // The keys view the pooled strings, which are never freed.
+  std::unordered_map<std::string_view, std::shared_ptr<const std::string>>
+      strings;
+};
+
+SharedStringPool& getSharedStringPool() {
+  static SharedStringPool pool;
+  return pool;
+}
+
+const std::shared_ptr<const std::string>& getEmptyString() {
+  static const auto emptyString = std::make_shared<const std::string>();
+  return emptyString;
+}
+}
+
+namespace loot {
+SharedString::SharedString() : value_(getEmptyString()) {}
+
+SharedString::SharedString(const char* value) :
+    SharedString(std::string(value)) {}
+
+SharedString::SharedString(std::string value) :
+    value_(value.empty()
+               ? getEmptyString()
+               : std::make_shared<const std::string>(std::move(value))) {}
+
+SharedString::SharedString(std::shared_ptr<const std::string> value) :
+    value_(std::move(value)) {}
+
+SharedString SharedString::Pooled(std::string_view value) {
+  auto& pool = getSharedStringPool();
+
+  {
+    std::shared_lock lock(pool.mutex);
+    const auto it = pool.strings.find(value);
+    if (it != pool.strings.end()) {
+      return SharedString(it->second);
+    }
+  }
+
+  std::unique_lock lock(pool.mutex);
+  const auto it = pool.strings.find(value);
+  if (it != pool.strings.end()) {
+    return SharedString(it->second);
+  }
+
+  auto string = std::make_shared<const std::string>(value);
+  pool.strings.emplace(std::string_view(*string), string);
+  return SharedString(std::move(string));
+}
+}
@@ -0,0 +1,111 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_SHARED_STRING
+#define LOOT_GUI_SHARED_STRING
+
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace loot {
+// An immutable, reference-counted string. Copies share the same storage, so
+// values that are copied a lot, such as message text held by plugin items,
+// models and query results, are cheap to copy. Unlike InternedString, the
+// storage is freed once the last copy is destroyed, unless the string was
+// pooled.
+class SharedString {
+public:
+  SharedString();
+  SharedString(const char* value);
+  SharedString(std::string value);
+
+  // Returns a string from a process-wide pool, so that equal values share the
+  // same storage. Pooled strings are never freed, so this is only intended for
+  // values that come from a bounded vocabulary, such as metadata message text.
+  static SharedString Pooled(std::string_view value);
+
+  const std::string& str() const noexcept { return *value_; }
+
+  operator const std::string&() const noexcept { return *value_; }
+
+  bool empty() const noexcept { return value_->empty(); }
+
+private:
+  explicit SharedString(std::shared_ptr<const std::string> value);
+
+  std::shared_ptr<const std::string> value_;
+
+  friend bool operator==(const SharedString& lhs,
+                         const SharedString& rhs) noexcept {
+    return lhs.value_ == rhs.value_ || *lhs.value_ == *rhs.value_;
+  }
+
+  friend bool operator!=(const SharedString& lhs,
+                         const SharedString& rhs) noexcept {
+    return !(lhs == rhs);
+  }
+
+  friend bool operator==(const SharedString& lhs, const std::string& rhs) {
+    return *lhs.value_ == rhs;
+  }
+
+  friend bool operator==(const std::string& lhs, const SharedString& rhs) {
+    return lhs == *rhs.value_;
+  }
+
+  friend bool operator==(const SharedString& lhs, const char* rhs) {
+    return *lhs.value_ == rhs;
+  }
+
+  friend bool operator==(const char* lhs, const SharedString& rhs) {
+    return lhs == *rhs.value_;
+  }
+
+  friend bool operator!=(const SharedString& lhs, const std::string& rhs) {
+    return !(lhs == rhs);
+  }
+
+  friend bool operator!=(const std::string& lhs, const SharedString& rhs) {
+    return !(lhs == rhs);
+  }
+
+  friend bool operator!=(const SharedString& lhs, const char* rhs) {
+    return !(lhs == rhs);
+  }
+
+  friend bool operator!=(const char* lhs, const SharedString& rhs) {
+    return !(lhs == rhs);
+  }
+
+  friend std::ostream& operator<<(std::ostream& out,
+                                  const SharedString& string) {
+    return out << *string.value_;
+  }
+};
+}
+
+#endif
@@ -28,6 +28,7 @@
 #include <spdlog/fmt/fmt.h>
 
 #include <boost/locale.hpp>
+#include <functional>
 
 #include "gui/state/game/helpers.h"
 
@@ -41,6 +42,23 @@ bool operator!=(const SourcedMessage& lhs, const SourcedMessage& rhs) {
   return !(lhs == rhs);
 }
 
+uint64_t HashMessages(const std::vector<SourcedMessage>& messages) {
+  uint64_t hash = 0;
+  const auto combine = [&hash](uint64_t value) {
+    // This is the same combination as boost::hash_combine() uses.
+    static constexpr uint64_t GOLDEN_RATIO = 0x9e3779b97f4a7c15;
+    hash ^= value + GOLDEN_RATIO + (hash << 6) + (hash >> 2);
+  };
+
+  for (const auto& message : messages) {
+    combine(static_cast<uint64_t>(message.type));
+    combine(static_cast<uint64_t>(message.source));
+    combine(std::hash<std::string>()(message.text.str()));
+  }
+
+  return hash;
+}
+
 SourcedMessage CreatePlainTextSourcedMessage(const MessageType type,
                                              const MessageSource source,
                                              const std::string& text) {
@@ -48,11 +66,21 @@ SourcedMessage CreatePlainTextSourcedMessage(const MessageType type,
 }
 
 std::string MessagesAsMarkdown(const std::vector<SourcedMessage>& messages) {
+  std::string content;
+  content.reserve(EstimateMessagesAsMarkdownSize(messages));
+
+  AppendMessagesAsMarkdown(content, messages);
+
+  return content;
+}
+
+void AppendMessagesAsMarkdown(std::string& content,
+                              const std::vector<SourcedMessage>& messages) {
   if (messages.empty()) {
-    return "";
+    return;
   }
 
-  std::string content = "## Messages\n\n";
+  content += "## Messages\n\n";
 
   for (const auto& message : messages) {
     content += "- ";
@@ -65,10 +93,43 @@ std::string MessagesAsMarkdown(const std::vector<SourcedMessage>& messages) {
       content += "Note: ";
     }
 
-    content += message.text + "\n";
+    content += message.text.str();
+    content += '\n';
   }
+}
 
-  return content;
+size_t EstimateMessagesAsMarkdownSize(
+    const std::vector<SourcedMessage>& messages) {
+  if (messages.empty()) {
+    return 0;
+  }
+
+  // The heading, and then per message the list item's prefix (at most
+  // "- Warning: ") and trailing line break.
+  static constexpr size_t HEADING_SIZE = 13;
+  static constexpr size_t MESSAGE_OVERHEAD = 12;
+
+  size_t size = HEADING_SIZE;
+  for (const auto& message : messages) {
+    size += message.text.str().size() + MESSAGE_OVERHEAD;
+  }
+
+  return size;
+}
+
+std::optional<std::string> SelectMessageText(
+    const std::vector<MessageContent>& content,
+    const std::string& language) {
+  if (content.size() == 1) {
+    return content[0].GetText();
+  }
+
+  const auto selectedContent = SelectMessageContent(content, language);
+  if (!selectedContent.has_value()) {
+    return std::nullopt;
+  }
+
+  return selectedContent.value().GetText();
 }
 
 SourcedMessage ToSourcedMessage(const PluginCleaningData& cleaningData,
@@ -144,10 +205,10 @@ SourcedMessage ToSourcedMessage(const PluginCleaningData& cleaningData,
                      deletedNavmeshes);
 
   const auto selectedDetail =
-      SelectMessageContent(cleaningData.GetDetail(), language);
+      SelectMessageText(cleaningData.GetDetail(), language);
 
   if (selectedDetail.has_value()) {
-    message += " " + selectedDetail.value().GetText();
+    message += " " + selectedDetail.value();
   }
 
   return SourcedMessage{
@@ -159,12 +220,15 @@ std::vector<SourcedMessage> ToSourcedMessages(
     const MessageSource source,
     const std::string& language) {
   std::vector<SourcedMessage> pluginMessages;
+  pluginMessages.reserve(messages.size());
 
   for (const auto& message : messages) {
-    const auto content = SelectMessageContent(message.GetContent(), language);
-    if (content.has_value()) {
-      pluginMessages.push_back(
-          SourcedMessage{message.GetType(), source, content.value().GetText()});
+    const auto text = SelectMessageText(message.GetContent(), language);
+    if (text.has_value()) {
+      // The same metadata messages tend to be attached to many plugins, so
+      // pool their text.
+      pluginMessages.push_back(SourcedMessage{
+          message.GetType(), source, SharedString::Pooled(text.value())});
     }
   }
 
@@ -24,9 +24,12 @@
 #ifndef LOOT_GUI_PLUGIN_MESSAGE
 #define LOOT_GUI_PLUGIN_MESSAGE
 
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <vector>
 
+#include "gui/shared_string.h"
 #include "loot/metadata/message.h"
 #include "loot/metadata/plugin_cleaning_data.h"
 
@@ -60,19 +63,43 @@ enum struct MessageSource : unsigned int {
 struct SourcedMessage {
   MessageType type{MessageType::say};
   MessageSource source{MessageSource::messageMetadata};
-  std::string text;
+  // Message text is shared between copies, as messages are copied between
+  // plugin items, models and query results.
+  SharedString text;
 };
 
 bool operator==(const SourcedMessage& lhs, const SourcedMessage& rhs);
 
 bool operator!=(const SourcedMessage& lhs, const SourcedMessage& rhs);
 
+// Hash the messages' types, sources and text, in order. An empty vector has a
+// hash of zero.
+uint64_t HashMessages(const std::vector<SourcedMessage>& messages);
+
 SourcedMessage CreatePlainTextSourcedMessage(const MessageType type,
                                              const MessageSource source,
                                              const std::string& text);
 
 std::string MessagesAsMarkdown(const std::vector<SourcedMessage>& messages);
 
+// Appends the same text as MessagesAsMarkdown() to the given string, so that
+// a larger document can be built in a single buffer.
+void AppendMessagesAsMarkdown(std::string& content,
+                              const std::vector<SourcedMessage>& messages);
+
+// Get an upper bound on the length of the text that MessagesAsMarkdown()
+// produces, for reserving space.
+size_t EstimateMessagesAsMarkdownSize(
+    const std::vector<SourcedMessage>& messages);
+
+// Returns the text of the content that SelectMessageContent() would select for
+// the given language. Most metadata only has content in one language, which is
+// always selected, so that's returned without copying and searching the
+// content.
+std::optional<std::string> SelectMessageText(
+    const std::vector<MessageContent>& content,
+    const std::string& language);
+
 SourcedMessage ToSourcedMessage(const PluginCleaningData& cleaningData,
                                 const std::string& language);
 
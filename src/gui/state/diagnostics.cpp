@@ -0,0 +1,167 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/diagnostics.h"
+
+#ifdef _WIN32
+#ifndef UNICODE
+#define UNICODE
+#endif
+#ifndef _UNICODE
+#define _UNICODE
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+// psapi.h must be included after windows.h.
+#include <psapi.h>
+#else
+#include <unistd.h>
+
+#include <fstream>
+#include <string>
+#endif
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+
+namespace {
+using loot::CacheCounter;
+
+std::mutex& getCounterRegistryMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+// Counters may be constructed during static initialisation, so the registry
+// is created on first use.
+std::vector<const CacheCounter*>& getCounterRegistry() {
+  static std::vector<const CacheCounter*> counters;
+  return counters;
+}
+}
+
+namespace loot {
+CacheCounter::CacheCounter(std::string cacheName) :
+    cacheName_(std::move(cacheName)) {
+  std::lock_guard<std::mutex> guard(getCounterRegistryMutex());
+  getCounterRegistry().push_back(this);
+}
+
+void CacheCounter::recordLookup(bool isHit) {
+  if (isHit) {
+    hits_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    misses_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+CacheStats CacheCounter::getStats() const {
+  return CacheStats{cacheName_,
+                    hits_.load(std::memory_order_relaxed),
+                    misses_.load(std::memory_order_relaxed)};
+}
+
+std::vector<CacheStats> getCacheStats() {
+  std::vector<CacheStats> stats;
+
+  {
+    std::lock_guard<std::mutex> guard(getCounterRegistryMutex());
+    for (const auto counter : getCounterRegistry()) {
+      stats.push_back(counter->getStats());
+    }
+  }
+
+  std::sort(stats.begin(),
+            stats.end(),
+            [](const CacheStats& lhs, const CacheStats& rhs) {
+              return lhs.cacheName < rhs.cacheName;
+            });
+
+  return stats;
+}
+
+std::optional<uint64_t> getProcessMemoryUsage() {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return std::nullopt;
+  }
+
+  return static_cast<uint64_t>(counters.WorkingSetSize);
+#else
+  // The second value is the number of resident pages.
+  std::ifstream in("/proc/self/statm");
+  uint64_t totalPages = 0;
+  uint64_t residentPages = 0;
+  in >> totalPages >> residentPages;
+  if (!in) {
+    return std::nullopt;
+  }
+
+  const auto pageSize = sysconf(_SC_PAGESIZE);
+  if (pageSize <= 0) {
+    return std::nullopt;
+  }
+
+  return residentPages * static_cast<uint64_t>(pageSize);
+#endif
+}
+
+std::optional<uint64_t> getProcessPeakMemoryUsage() {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return std::nullopt;
+  }
+
+  return static_cast<uint64_t>(counters.PeakWorkingSetSize);
+#else
+  // The peak resident set size is given by the VmHWM line, in kB.
+  static constexpr const char* PEAK_FIELD = "VmHWM:";
+  static constexpr uint64_t BYTES_PER_KB = 1024;
+
+  std::ifstream in("/proc/self/status");
+  std::string field;
+  while (in >> field) {
+    if (field == PEAK_FIELD) {
+      uint64_t peakKb = 0;
+      in >> peakKb;
+      if (!in) {
+        return std::nullopt;
+      }
+
+      return peakKb * BYTES_PER_KB;
+    }
+
+    in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+  }
+
+  return std::nullopt;
+#endif
+}
+}
@@ -0,0 +1,78 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_DIAGNOSTICS
+#define LOOT_GUI_STATE_DIAGNOSTICS
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace loot {
+struct CacheStats {
+  std::string cacheName;
+  size_t hits{0};
+  size_t misses{0};
+};
+
+// Counts how often a cache's lookups hit or miss, so that its effectiveness
+// can be shown in the diagnostics dialog. Counters register themselves on
+// construction and must live until the program exits, so they should be
+// statically allocated. It's safe to record lookups on any thread.
+class CacheCounter {
+public:
+  explicit CacheCounter(std::string cacheName);
+  CacheCounter(const CacheCounter&) = delete;
+  CacheCounter(CacheCounter&&) = delete;
+  ~CacheCounter() = default;
+
+  CacheCounter& operator=(const CacheCounter&) = delete;
+  CacheCounter& operator=(CacheCounter&&) = delete;
+
+  void recordLookup(bool isHit);
+
+  CacheStats getStats() const;
+
+private:
+  std::string cacheName_;
+  std::atomic<size_t> hits_{0};
+  std::atomic<size_t> misses_{0};
+};
+
+// Get the stats of every cache counter, ordered by cache name.
+std::vector<CacheStats> getCacheStats();
+
+// Get the amount of physical memory used by LOOT's process in bytes, if it can
+// be determined.
+std::optional<uint64_t> getProcessMemoryUsage();
+
+// Get the largest amount of physical memory that LOOT's process has used at
+// once in bytes, if it can be determined.
+std::optional<uint64_t> getProcessPeakMemoryUsage();
+}
+
+#endif
@@ -0,0 +1,109 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/download_mirrors.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <tuple>
+
+namespace loot {
+static constexpr std::chrono::milliseconds RETRY_BASE_DELAY{250};
+static constexpr std::chrono::milliseconds RETRY_MAX_DELAY{4000};
+
+std::vector<std::string> DownloadMirrorRanking::Order(
+    const std::vector<std::string>& urls) const {
+  // 0 for URLs that have succeeded, 1 for untried URLs and 2 for URLs that
+  // have failed, then the response time or number of failures.
+  using SortKey = std::tuple<int, int64_t>;
+
+  std::vector<std::pair<SortKey, std::string>> keyedUrls;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+
+    for (const auto& url : urls) {
+      const auto it = records_.find(url);
+      if (it == records_.end()) {
+        keyedUrls.emplace_back(SortKey{1, 0}, url);
+      } else if (it->second.consecutiveFailures > 0) {
+        keyedUrls.emplace_back(SortKey{2, it->second.consecutiveFailures},
+                               url);
+      } else {
+        keyedUrls.emplace_back(SortKey{0, it->second.responseTime.count()},
+                               url);
+      }
+    }
+  }
+
+  std::stable_sort(
+      keyedUrls.begin(),
+      keyedUrls.end(),
+      [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+  std::vector<std::string> orderedUrls;
+  orderedUrls.reserve(keyedUrls.size());
+  for (auto& [key, url] : keyedUrls) {
+    orderedUrls.push_back(std::move(url));
+  }
+
+  return orderedUrls;
+}
+
+void DownloadMirrorRanking::RecordSuccess(
+    const std::string& url,
+    std::chrono::milliseconds responseTime) {
+  std::lock_guard<std::mutex> guard(mutex_);
+
+  auto& record = records_[url];
+  record.responseTime = responseTime;
+  record.consecutiveFailures = 0;
+}
+
+void DownloadMirrorRanking::RecordFailure(const std::string& url) {
+  std::lock_guard<std::mutex> guard(mutex_);
+
+  records_[url].consecutiveFailures += 1;
+}
+
+DownloadMirrorRanking& GetDownloadMirrorRanking() {
+  static DownloadMirrorRanking ranking;
+
+  return ranking;
+}
+
+std::chrono::milliseconds GetRetryDelay(unsigned int attempt, double jitter) {
+  // Stop doubling once the limit is reached, to avoid overflow.
+  auto delay = RETRY_BASE_DELAY;
+  for (unsigned int i = 0; i < attempt && delay < RETRY_MAX_DELAY; ++i) {
+    delay *= 2;
+  }
+  delay = std::min(delay, RETRY_MAX_DELAY);
+
+  jitter = std::clamp(jitter, 0.0, 1.0);
+
+  return std::chrono::milliseconds(static_cast<int64_t>(
+      static_cast<double>(delay.count()) * (1.0 - jitter / 2)));
+}
+}
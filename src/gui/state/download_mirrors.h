@@ -0,0 +1,71 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_DOWNLOAD_MIRRORS
+#define LOOT_GUI_STATE_DOWNLOAD_MIRRORS
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace loot {
+// Records how each URL that a file can be downloaded from has performed
+// during this session, so that later downloads try the fastest working URLs
+// first. It may be used from different threads.
+class DownloadMirrorRanking {
+public:
+  // URLs that have succeeded are ordered fastest first, followed by URLs that
+  // haven't been tried yet, followed by URLs that have failed, in order of
+  // how many times they've failed in a row. URLs that are otherwise equal
+  // keep their given order.
+  std::vector<std::string> Order(const std::vector<std::string>& urls) const;
+
+  void RecordSuccess(const std::string& url,
+                     std::chrono::milliseconds responseTime);
+  void RecordFailure(const std::string& url);
+
+private:
+  struct Record {
+    std::chrono::milliseconds responseTime{0};
+    unsigned int consecutiveFailures{0};
+  };
+
+  mutable std::mutex mutex_;
+  std::map<std::string, Record> records_;
+};
+
+// The ranking shared by all downloads in this session.
+DownloadMirrorRanking& GetDownloadMirrorRanking();
+
+// Get how long to wait before the given retry attempt (counting from zero),
+// which doubles with each attempt up to a limit. The jitter is a value between
+// 0 and 1 that randomly shortens the delay by up to half, so that clients that
+// failed at the same time don't all retry at the same time.
+std::chrono::milliseconds GetRetryDelay(unsigned int attempt, double jitter);
+}
+
+#endif
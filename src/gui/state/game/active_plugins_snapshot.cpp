@@ -0,0 +1,42 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/game/active_plugins_snapshot.h"
+
+#include "gui/helpers.h"
+
+namespace loot {
+ActivePluginsSnapshot::ActivePluginsSnapshot(
+    const std::vector<std::string>& activePluginNames) {
+  activePlugins_.reserve(activePluginNames.size());
+  for (const auto& pluginName : activePluginNames) {
+    activePlugins_.insert(NormalisePluginName(pluginName));
+  }
+}
+
+bool ActivePluginsSnapshot::IsActive(const std::string& pluginName) const {
+  return activePlugins_.count(NormalisePluginName(pluginName)) != 0;
+}
+}
@@ -0,0 +1,53 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_GAME_ACTIVE_PLUGINS_SNAPSHOT
+#define LOOT_GUI_STATE_GAME_ACTIVE_PLUGINS_SNAPSHOT
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace loot {
+// Holds the names of the plugins that were active when the snapshot was
+// taken, so that checking if a plugin is active doesn't need to go through
+// the game handle's load order state each time.
+class ActivePluginsSnapshot {
+public:
+  ActivePluginsSnapshot() = default;
+  explicit ActivePluginsSnapshot(
+      const std::vector<std::string>& activePluginNames);
+
+  // The comparison is case-insensitive.
+  bool IsActive(const std::string& pluginName) const;
+
+private:
+  // Holds lowercased plugin names, so that lookups only need to normalise the
+  // name being checked.
+  std::unordered_set<std::string> activePlugins_;
+};
+}
+
+#endif
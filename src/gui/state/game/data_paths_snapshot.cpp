@@ -0,0 +1,195 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/game/data_paths_snapshot.h"
+
+#include <cstring>
+
+#include "gui/state/game/directory_listing.h"
+#include "gui/state/game/helpers.h"
+#include "gui/state/logging.h"
+
+namespace {
+bool AddDirectoryEntries(std::map<loot::Filename, std::string>& entries,
+                         const std::filesystem::path& directory) {
+  std::error_code errorCode;
+  if (!std::filesystem::is_directory(directory, errorCode)) {
+    // A missing data path has no entries but does not make the snapshot
+    // incomplete.
+    return true;
+  }
+
+  try {
+    // Only names are needed, so avoid reading anything else about entries.
+    for (auto& entryName : loot::ListDirectoryFilenames(directory)) {
+      entries.emplace(loot::Filename(entryName), std::move(entryName));
+    }
+  } catch (const std::filesystem::filesystem_error& e) {
+    const auto logger = loot::getLogger();
+    if (logger) {
+      logger->warn("Failed to read the contents of {}: {}",
+                   directory.u8string(),
+                   e.code().message());
+    }
+    return false;
+  }
+
+  return true;
+}
+
+bool IsFilename(const std::string& filename) {
+  return filename.find_first_of("/\\") == std::string::npos;
+}
+}
+
+namespace loot {
+DataPathsSnapshot::DataPathsSnapshot(
+    const std::vector<std::filesystem::path>& externalDataPaths,
+    const std::filesystem::path& dataPath) {
+  isComplete_ = true;
+
+  auto directoryPaths = externalDataPaths;
+  directoryPaths.push_back(dataPath);
+
+  for (const auto& directoryPath : directoryPaths) {
+    DirectoryIndex directory;
+    directory.path = directoryPath;
+
+    if (!AddDirectoryEntries(directory.entries, directoryPath)) {
+      isComplete_ = false;
+    }
+
+    directories_.push_back(std::move(directory));
+  }
+
+  bashTagsDirectory_.path = dataPath / "BashTags";
+  isBashTagsDirectoryComplete_ =
+      AddDirectoryEntries(bashTagsDirectory_.entries, bashTagsDirectory_.path);
+}
+
+std::optional<bool> DataPathsSnapshot::FileExists(
+    const std::string& filename) const {
+  if (!isComplete_) {
+    return std::nullopt;
+  }
+
+  if (!IsFilename(filename)) {
+    // Only entries directly inside the data paths are recorded.
+    return std::nullopt;
+  }
+
+  for (const auto& directory : directories_) {
+    if (FindEntry(directory, filename).has_value()) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+std::optional<std::filesystem::path> DataPathsSnapshot::ResolveFilePath(
+    const std::string& filename) const {
+  if (!isComplete_ || !IsFilename(filename)) {
+    return std::nullopt;
+  }
+
+  for (const auto& directory : directories_) {
+    const auto path = FindEntry(directory, filename);
+    if (path.has_value()) {
+      return path;
+    }
+  }
+
+  // Like loot::ResolveGameFilePath(), fall back to the data path.
+  return directories_.back().path / std::filesystem::u8path(filename);
+}
+
+std::optional<bool> DataPathsSnapshot::GetRecordedFileExists(
+    const std::string& filePath) const {
+  std::lock_guard<std::mutex> guard(recordedPathsMutex_);
+
+  const auto it = recordedPaths_.find(Filename(filePath));
+  if (it == recordedPaths_.end()) {
+    return std::nullopt;
+  }
+
+  return it->second;
+}
+
+void DataPathsSnapshot::RecordFileExists(const std::string& filePath,
+                                         bool exists) const {
+  std::lock_guard<std::mutex> guard(recordedPathsMutex_);
+
+  recordedPaths_.insert_or_assign(Filename(filePath), exists);
+}
+
+std::optional<std::filesystem::path> DataPathsSnapshot::FindBashTagsFile(
+    const std::string& pluginName) const {
+  if (bashTagsDirectory_.path.empty()) {
+    return std::nullopt;
+  }
+
+  const auto filename = GetBashTagsFilename(pluginName);
+
+  if (isBashTagsDirectoryComplete_) {
+    return FindEntry(bashTagsDirectory_, filename);
+  }
+
+  const auto filePath = bashTagsDirectory_.path / filename;
+  if (std::filesystem::exists(filePath)) {
+    return filePath;
+  }
+
+  return std::nullopt;
+}
+
+std::optional<std::filesystem::path> DataPathsSnapshot::FindEntry(
+    const DirectoryIndex& directory,
+    const std::string& filename) {
+  auto it = directory.entries.find(Filename(filename));
+  std::string entryName;
+  if (it != directory.entries.end()) {
+    entryName = it->second;
+  } else if (HasPluginFileExtension(filename)) {
+    it = directory.entries.find(Filename(filename + GHOST_EXTENSION));
+    if (it == directory.entries.end()) {
+      return std::nullopt;
+    }
+
+    // Intentionally return the unghosted path.
+    entryName = it->second.substr(
+        0, it->second.size() - std::strlen(GHOST_EXTENSION));
+  } else {
+    return std::nullopt;
+  }
+
+#ifdef _WIN32
+  // Windows filesystems are case-insensitive, so keep the given case.
+  return directory.path / std::filesystem::u8path(filename);
+#else
+  return directory.path / std::filesystem::u8path(entryName);
+#endif
+}
+}
@@ -0,0 +1,100 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_GAME_DATA_PATHS_SNAPSHOT
+#define LOOT_GUI_STATE_GAME_DATA_PATHS_SNAPSHOT
+
+#include <loot/metadata/file.h>
+
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace loot {
+// Holds the names of all the entries directly inside a game's data paths and
+// its Data/BashTags directory at the time the snapshot was taken, so that
+// checking if a file exists doesn't need to hit the filesystem each time.
+class DataPathsSnapshot {
+public:
+  DataPathsSnapshot() = default;
+  DataPathsSnapshot(
+      const std::vector<std::filesystem::path>& externalDataPaths,
+      const std::filesystem::path& dataPath);
+
+  // Returns std::nullopt if the snapshot can't say whether or not the file
+  // exists, e.g. because the snapshot is empty or the filename is a path
+  // containing subdirectories. Ghosted plugins are treated as existing.
+  std::optional<bool> FileExists(const std::string& filename) const;
+
+  // Resolves the given filename to its path in the first data path that
+  // contains it, in the same way as loot::ResolveGameFilePath(), but using
+  // the snapshot's case-insensitive index. Outside of Windows, the returned
+  // path uses the case of the entry on disk, so that files can be found on
+  // case-sensitive filesystems. Returns std::nullopt in the same cases as
+  // FileExists().
+  std::optional<std::filesystem::path> ResolveFilePath(
+      const std::string& filename) const;
+
+  // The snapshot can't answer for paths containing subdirectories, but the
+  // same requirement and incompatibility paths tend to appear in many
+  // plugins' metadata, so the result of checking the filesystem for one is
+  // remembered for as long as the snapshot lives.
+  std::optional<bool> GetRecordedFileExists(const std::string& filePath) const;
+  void RecordFileExists(const std::string& filePath, bool exists) const;
+
+  // Returns the path to the given plugin's BashTags file, or std::nullopt if
+  // it doesn't have one. If the BashTags directory couldn't be read when the
+  // snapshot was taken, this checks the filesystem instead.
+  std::optional<std::filesystem::path> FindBashTagsFile(
+      const std::string& pluginName) const;
+
+private:
+  struct DirectoryIndex {
+    std::filesystem::path path;
+    // Maps case-insensitive entry names to the entry names on disk. Use
+    // Filename to benefit from libloot's case-insensitive comparisons.
+    std::map<Filename, std::string> entries;
+  };
+
+  static std::optional<std::filesystem::path> FindEntry(
+      const DirectoryIndex& directory,
+      const std::string& filename);
+
+  // External data paths come first, in order, followed by the data path.
+  std::vector<DirectoryIndex> directories_;
+  bool isComplete_{false};
+
+  DirectoryIndex bashTagsDirectory_;
+  bool isBashTagsDirectoryComplete_{false};
+
+  mutable std::mutex recordedPathsMutex_;
+  mutable std::map<Filename, bool> recordedPaths_;
+};
+}
+
+#endif
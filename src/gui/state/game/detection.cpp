@@ -34,7 +34,7 @@ using std::filesystem::u8path;
 
 namespace loot {
 bool IsInstalled(const GameSettings& settings) {
-  const auto logger = getLogger();
+  const auto logger = getLogger(LogCategory::detection);
   if (logger) {
     logger->trace("Checking if game \"{}\" is installed.", settings.Name());
   }
@@ -57,8 +57,14 @@ void UpdateInstalledGamesSettings(
   const auto gameInstalls = FindGameInstalls(
       registry, heroicConfigPaths, xboxGamingRootPaths, preferredUILanguages);
 
-  const auto newGameInstalls =
-      UpdateMatchingSettings(gamesSettings, gameInstalls, ArePathsEquivalent);
+  UpdateInstalledGamesSettings(gamesSettings, gameInstalls);
+}
+
+void UpdateInstalledGamesSettings(
+    std::vector<GameSettings>& gamesSettings,
+    const std::vector<GameInstall>& gameInstalls) {
+  const auto newGameInstalls = UpdateMatchingSettings(
+      gamesSettings, gameInstalls, CreateArePathsEquivalentComparator());
 
   const auto configuredInstalls = DetectConfiguredInstalls(gamesSettings);
 
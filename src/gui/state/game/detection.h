@@ -30,6 +30,7 @@
 #include <stdexcept>
 #include <vector>
 
+#include "gui/state/game/detection/game_install.h"
 #include "gui/state/game/detection/registry.h"
 #include "gui/state/game/game_settings.h"
 
@@ -51,6 +52,9 @@ void UpdateInstalledGamesSettings(
     const std::vector<std::filesystem::path>& heroicConfigPaths,
     const std::vector<std::filesystem::path>& xboxGamingRootPaths,
     const std::vector<std::string>& preferredUILanguages);
+
+void UpdateInstalledGamesSettings(std::vector<GameSettings>& gamesSettings,
+                                  const std::vector<GameInstall>& gameInstalls);
 }
 
 #endif
@@ -195,7 +195,7 @@ std::optional<std::filesystem::path> GetLocalisedGameInstallPath(
     const GameId gameId,
     const std::vector<std::string>& uiPreferredLanguages,
     const std::vector<LocalisedGameInstallPath>& paths) {
-  const auto logger = getLogger();
+  const auto logger = getLogger(LogCategory::detection);
 
   // Sort the given paths so they're in the same order as the preferred
   // languages.
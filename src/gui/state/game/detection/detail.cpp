@@ -25,7 +25,11 @@
 
 #include "gui/state/game/detection/detail.h"
 
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
+#include <functional>
+#include <map>
+#include <memory>
 #include <unordered_set>
 
 #include "gui/helpers.h"
@@ -37,14 +41,17 @@
 #include "gui/state/game/detection/microsoft_store.h"
 #include "gui/state/game/detection/steam.h"
 #include "gui/state/logging.h"
+#include "gui/state/thread_pool.h"
 
 namespace {
 using loot::GameId;
 using loot::GameInstall;
 using loot::GetGameName;
 using loot::getLogger;
+using loot::LogCategory;
 using loot::GetSourceDescription;
 using loot::InstallSource;
+using loot::parallelFor;
 
 std::string GetDefaultMasterlistRepositoryName(const GameId gameId) {
   switch (gameId) {
@@ -110,19 +117,69 @@ bool equivalent(const std::filesystem::path& path1,
   }
 }
 
+// Compares paths in the same way as equivalent(), but resolves each path with
+// the filesystem at most once, so that comparing many paths to each other
+// doesn't need a pair of filesystem calls per comparison. Two existing paths
+// are equivalent if their canonical paths are equal.
+class PathEquivalenceCache {
+public:
+  bool AreEquivalent(const std::filesystem::path& path1,
+                     const std::filesystem::path& path2) {
+    if (path1 == path2) {
+      return true;
+    }
+
+    const auto canonicalPath1 = GetCanonicalPath(path1);
+    if (!canonicalPath1.has_value()) {
+      return false;
+    }
+
+    return canonicalPath1 == GetCanonicalPath(path2);
+  }
+
+private:
+  std::optional<std::filesystem::path> GetCanonicalPath(
+      const std::filesystem::path& path) {
+    const auto it = canonicalPaths_.find(path);
+    if (it != canonicalPaths_.end()) {
+      return it->second;
+    }
+
+    std::optional<std::filesystem::path> canonicalPath;
+    try {
+      std::error_code errorCode;
+      auto result = std::filesystem::canonical(path, errorCode);
+      if (!errorCode) {
+        canonicalPath = std::move(result);
+      }
+    } catch (const std::system_error&) {
+      // See the comment in equivalent() above.
+    }
+
+    canonicalPaths_.emplace(path, canonicalPath);
+
+    return canonicalPath;
+  }
+
+  std::map<std::filesystem::path, std::optional<std::filesystem::path>>
+      canonicalPaths_;
+};
+
 // Deduplicate GameInstall objects by checking for equivalent install paths,
 // keeping the first of each duplicate.
 std::vector<GameInstall> DeduplicateGameInstalls(
     const std::vector<GameInstall>& gameInstalls) {
   std::vector<GameInstall> uniqueGameInstalls;
+  PathEquivalenceCache pathEquivalenceCache;
 
-  const auto logger = getLogger();
+  const auto logger = getLogger(LogCategory::detection);
   for (const auto& gameInstall : gameInstalls) {
     const auto duplicate = std::find_if(
         uniqueGameInstalls.begin(),
         uniqueGameInstalls.end(),
         [&](const GameInstall& other) {
-          return ::equivalent(gameInstall.installPath, other.installPath);
+          return pathEquivalenceCache.AreEquivalent(gameInstall.installPath,
+                                                    other.installPath);
         });
 
     if (duplicate == uniqueGameInstalls.end()) {
@@ -144,38 +201,70 @@ std::vector<GameInstall> DeduplicateGameInstalls(
 }
 
 // Search for installed copies of the given game, and return all those found.
-std::vector<GameInstall> FindGameInstalls(
+using GameInstallProbe = std::function<std::vector<GameInstall>()>;
+
+// The maximum number of probes to run at once. Probes mostly wait on registry
+// reads and filesystem checks, so running more probes than there are hardware
+// threads can still help, but not without limit.
+constexpr size_t MAX_CONCURRENT_PROBES = 8;
+
+void AddGameInstallProbes(
+    std::vector<GameInstallProbe>& probes,
     const loot::RegistryInterface& registry,
     const GameId gameId,
     const std::vector<std::filesystem::path>& xboxGamingRootPaths,
     const std::vector<std::string>& preferredUILanguages) {
-  const auto logger = getLogger();
+  const auto logger = getLogger(LogCategory::detection);
   if (logger) {
     logger->trace("Checking if game \"{}\" is installed.", GetGameName(gameId));
   }
 
-  std::vector<GameInstall> installs;
+  probes.push_back([&registry, gameId]() {
+    return loot::steam::FindGameInstalls(registry, gameId);
+  });
 
-  const auto steamInstalls = loot::steam::FindGameInstalls(registry, gameId);
-  installs.insert(installs.end(), steamInstalls.begin(), steamInstalls.end());
+  probes.push_back([&registry, gameId]() {
+    return loot::gog::FindGameInstalls(registry, gameId);
+  });
 
-  const auto gogInstalls = loot::gog::FindGameInstalls(registry, gameId);
-  installs.insert(installs.end(), gogInstalls.begin(), gogInstalls.end());
+  probes.push_back([&registry, gameId]() {
+    return loot::generic::FindGameInstalls(registry, gameId);
+  });
 
-  const auto genericInstalls =
-      loot::generic::FindGameInstalls(registry, gameId);
-  installs.insert(
-      installs.end(), genericInstalls.begin(), genericInstalls.end());
+  probes.push_back([&registry, gameId, &preferredUILanguages]() {
+    std::vector<GameInstall> installs;
 
-  const auto epicInstall =
-      loot::epic::FindGameInstalls(registry, gameId, preferredUILanguages);
-  if (epicInstall.has_value()) {
-    installs.push_back(epicInstall.value());
-  }
+    const auto epicInstall =
+        loot::epic::FindGameInstalls(registry, gameId, preferredUILanguages);
+    if (epicInstall.has_value()) {
+      installs.push_back(epicInstall.value());
+    }
+
+    return installs;
+  });
+
+  probes.push_back([gameId, &xboxGamingRootPaths, &preferredUILanguages]() {
+    return loot::microsoft::FindGameInstalls(
+        gameId, xboxGamingRootPaths, preferredUILanguages);
+  });
+}
+
+// Run the probes concurrently and concatenate their results in the order the
+// probes were given, so that the results don't depend on which probes finish
+// first.
+std::vector<GameInstall> RunGameInstallProbes(
+    const std::vector<GameInstallProbe>& probes) {
+  std::vector<std::vector<GameInstall>> probeResults(probes.size());
+
+  parallelFor(
+      probes.size(),
+      [&](size_t index) { probeResults[index] = probes[index](); },
+      MAX_CONCURRENT_PROBES);
 
-  const auto msInstalls = loot::microsoft::FindGameInstalls(
-      gameId, xboxGamingRootPaths, preferredUILanguages);
-  installs.insert(installs.end(), msInstalls.begin(), msInstalls.end());
+  std::vector<GameInstall> installs;
+  for (const auto& results : probeResults) {
+    installs.insert(installs.end(), results.begin(), results.end());
+  }
 
   return installs;
 }
@@ -280,36 +369,37 @@ std::vector<GameInstall> FindGameInstalls(
     const std::vector<std::filesystem::path>& heroicConfigPaths,
     const std::vector<std::filesystem::path>& xboxGamingRootPaths,
     const std::vector<std::string>& preferredUILanguages) {
-  std::vector<GameInstall> installs;
+  // Many games and sources read the same Registry keys, so only read each
+  // of them once.
+  const CachingRegistry cachingRegistry(registry);
 
-  for (const auto& steamInstallPath : steam::GetSteamInstallPaths(registry)) {
+  std::vector<GameInstallProbe> probes;
+
+  for (const auto& steamInstallPath :
+       steam::GetSteamInstallPaths(cachingRegistry)) {
     for (const auto& libraryPath :
          steam::GetSteamLibraryPaths(steamInstallPath)) {
-      for (const auto& gameId : ALL_GAME_IDS) {
-        for (const auto& manifestPath :
-             steam::GetSteamAppManifestPaths(libraryPath, gameId)) {
-          const auto install = steam::FindGameInstall(manifestPath);
-          if (install.has_value()) {
-            installs.push_back(install.value());
-          }
-        }
-      }
+      probes.push_back(
+          [libraryPath]() { return steam::FindGameInstalls(libraryPath); });
     }
   }
 
   for (const auto& heroicConfigPath : heroicConfigPaths) {
-    const auto heroicGameInstalls =
-        heroic::FindGameInstalls(heroicConfigPath, preferredUILanguages);
-    installs.insert(
-        installs.end(), heroicGameInstalls.begin(), heroicGameInstalls.end());
+    probes.push_back([&heroicConfigPath, &preferredUILanguages]() {
+      return heroic::FindGameInstalls(heroicConfigPath, preferredUILanguages);
+    });
   }
 
   for (const auto& gameId : ALL_GAME_IDS) {
-    const auto gameInstalls = ::FindGameInstalls(
-        registry, gameId, xboxGamingRootPaths, preferredUILanguages);
-    installs.insert(installs.end(), gameInstalls.begin(), gameInstalls.end());
+    AddGameInstallProbes(probes,
+                         cachingRegistry,
+                         gameId,
+                         xboxGamingRootPaths,
+                         preferredUILanguages);
   }
 
+  const auto installs = RunGameInstallProbes(probes);
+
   // The installs may duplicate Steam or GOG installs, so deduplicate them.
   return DeduplicateGameInstalls(installs);
 }
@@ -378,7 +468,7 @@ std::string DeriveName(
 };
 
 void UpdateSettingsPaths(GameSettings& settings, const GameInstall& install) {
-  const auto logger = getLogger();
+  const auto logger = getLogger(LogCategory::detection);
 
   // Update the existing settings object's paths.
   if (settings.GamePath().empty()) {
@@ -414,6 +504,15 @@ bool ArePathsEquivalent(const GameSettings& settings,
   return ::equivalent(install.installPath, settings.GamePath());
 }
 
+std::function<bool(const GameSettings& settings, const GameInstall& install)>
+CreateArePathsEquivalentComparator() {
+  const auto cache = std::make_shared<PathEquivalenceCache>();
+
+  return [cache](const GameSettings& settings, const GameInstall& install) {
+    return cache->AreEquivalent(install.installPath, settings.GamePath());
+  };
+}
+
 // Returns the installs that matched no settings.
 std::vector<GameInstall> UpdateMatchingSettings(
     std::vector<GameSettings>& gamesSettings,
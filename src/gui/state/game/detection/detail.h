@@ -72,6 +72,12 @@ void UpdateSettingsPaths(GameSettings& settings, const GameInstall& install);
 bool ArePathsEquivalent(const GameSettings& settings,
                         const GameInstall& install);
 
+// Returns a comparator that gives the same results as ArePathsEquivalent(),
+// but which resolves each distinct path with the filesystem at most once. The
+// comparator is not thread-safe.
+std::function<bool(const GameSettings& settings, const GameInstall& install)>
+CreateArePathsEquivalentComparator();
+
 std::vector<GameInstall> UpdateMatchingSettings(
     std::vector<GameSettings>& gamesSettings,
     const std::vector<GameInstall>& gameInstalls,
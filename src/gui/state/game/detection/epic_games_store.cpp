@@ -53,6 +53,7 @@
 namespace {
 using loot::GameId;
 using loot::getLogger;
+using loot::LogCategory;
 
 struct EgsManifestData {
   std::string appName;
@@ -145,7 +146,7 @@ std::optional<std::filesystem::path> GetEgsManifestsPath(
 #ifdef _WIN32
   // Fall back to using building the usual path if the Registry key couldn't
   // be found or the value is empty.
-  const auto logger = getLogger();
+  const auto logger = getLogger(LogCategory::detection);
 
   if (logger) {
     logger->warn(
@@ -161,7 +162,7 @@ std::optional<std::filesystem::path> GetEgsManifestsPath(
 }
 
 EgsManifestData GetEgsManifestData(const std::filesystem::path& manifestPath) {
-  const auto logger = getLogger();
+  const auto logger = getLogger(LogCategory::detection);
 
   if (logger) {
     logger->trace("Reading EGS manifest file at {}.", manifestPath.u8string());
@@ -222,7 +223,7 @@ std::optional<std::filesystem::path> GetEgsGameInstallPath(
     return std::nullopt;
   }
 
-  const auto logger = getLogger();
+  const auto logger = getLogger(LogCategory::detection);
 
   if (logger) {
     logger->trace(
@@ -259,6 +260,11 @@ std::optional<std::string> GetEgsAppName(const GameId gameId) {
   return ::GetEgsAppName(gameId);
 }
 
+std::optional<std::filesystem::path> GetManifestsPath(
+    const RegistryInterface& registry) {
+  return GetEgsManifestsPath(registry);
+}
+
 std::string GetAppDataFolderName(const GameId gameId) {
   switch (gameId) {
     case GameId::tes5se:
@@ -310,7 +316,7 @@ std::optional<GameInstall> FindGameInstalls(
       }
     }
   } catch (const std::exception& e) {
-    const auto logger = getLogger();
+    const auto logger = getLogger(LogCategory::detection);
     if (logger) {
       logger->error(
           "Error while checking if game \"{}\" is installed through the Epic "
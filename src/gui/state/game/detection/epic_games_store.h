@@ -38,6 +38,9 @@ std::optional<std::string> GetEgsAppName(const GameId gameId);
 
 std::string GetAppDataFolderName(const GameId gameId);
 
+std::optional<std::filesystem::path> GetManifestsPath(
+    const RegistryInterface& registry);
+
 std::optional<std::filesystem::path> FindGameInstallPath(
     const GameId gameId,
     const std::filesystem::path& rootInstallPath,
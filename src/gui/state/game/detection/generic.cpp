@@ -260,7 +260,7 @@ std::vector<GameInstall> FindGameInstalls(const RegistryInterface& registry,
       installs.push_back(sibling.value());
     }
   } catch (const std::exception& e) {
-    const auto logger = getLogger();
+    const auto logger = getLogger(LogCategory::detection);
     if (logger) {
       logger->error("Error while checking for a sibling install of game {}: {}",
                     GetGameName(gameId),
@@ -275,7 +275,7 @@ std::vector<GameInstall> FindGameInstalls(const RegistryInterface& registry,
       installs.push_back(registryInstall.value());
     }
   } catch (const std::exception& e) {
-    const auto logger = getLogger();
+    const auto logger = getLogger(LogCategory::detection);
     if (logger) {
       logger->error(
           "Error while trying to find {} using a generic Registry key: {}",
@@ -324,7 +324,7 @@ std::optional<GameInstall> DetectGameInstall(const GameSettings& settings) {
     return GameInstall{
         gameId, InstallSource::unknown, installPath, settings.GameLocalPath()};
   } catch (const std::exception& e) {
-    const auto logger = getLogger();
+    const auto logger = getLogger(LogCategory::detection);
     logger->error(
         "Error while detecting install for game with folder name {}: {}",
         settings.FolderName(),
@@ -125,7 +125,7 @@ std::vector<GameInstall> FindGameInstalls(const RegistryInterface& registry,
       }
     }
   } catch (const std::exception& e) {
-    const auto logger = getLogger();
+    const auto logger = getLogger(LogCategory::detection);
     if (logger) {
       logger->error(
           "Error while detecting game installs for game {} using GOG Registry "
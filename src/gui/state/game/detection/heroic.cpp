@@ -62,6 +62,7 @@ namespace {
 using loot::GameId;
 using loot::GameInstall;
 using loot::getLogger;
+using loot::LogCategory;
 using loot::InstallSource;
 using loot::heroic::HeroicGame;
 
@@ -120,26 +121,44 @@ std::filesystem::path GetUserConfigPath() {
 #endif
 }
 
-QJsonObject ReadJsonObjectFromFile(const std::filesystem::path& path) {
-  // Use Qt to parse the file - it breaks the separation of Qt out into just
-  // the GUI code, but it's not worth jumping through hoops to preserve that.
+QByteArray ReadFile(const std::filesystem::path& path) {
   auto file = QFile(QString::fromStdString(path.u8string()));
 
   file.open(QIODevice::ReadOnly | QIODevice::Text);
   const auto content = file.readAll();
   file.close();
 
-  return QJsonDocument::fromJson(content).object();
+  return content;
+}
+
+QJsonObject ReadJsonObjectFromFile(const std::filesystem::path& path) {
+  // Use Qt to parse the file - it breaks the separation of Qt out into just
+  // the GUI code, but it's not worth jumping through hoops to preserve that.
+  return QJsonDocument::fromJson(ReadFile(path)).object();
+}
+
+// Heroic's installed games files list every game in the user's library that
+// is installed, so may be large. Most of them won't include any supported
+// games, so check for supported app names as JSON strings before parsing the
+// file.
+bool MayContainAnyAppName(const QByteArray& content,
+                          const std::map<std::string, GameId>& gameIdMap) {
+  for (const auto& [appName, gameId] : gameIdMap) {
+    if (content.contains(QByteArray::fromStdString('"' + appName + '"'))) {
+      return true;
+    }
+  }
+
+  return false;
 }
 
 std::optional<HeroicGame> GetGameMetdata(
-    const QJsonValueConstRef& ref,
+    const QJsonObject& object,
     const char* appNameKey,
     const std::map<std::string, GameId>& gameIdMap) {
-  const auto logger = getLogger();
+  const auto logger = getLogger(LogCategory::detection);
 
-  const auto appName =
-      ref.toObject().value(appNameKey).toString().toStdString();
+  const auto appName = object.value(appNameKey).toString().toStdString();
 
   const auto it = gameIdMap.find(appName);
   if (it == gameIdMap.end()) {
@@ -154,7 +173,7 @@ std::optional<HeroicGame> GetGameMetdata(
   game.gameId = it->second;
   game.appName = appName;
   game.installPath = std::filesystem::u8path(
-      ref.toObject().value("install_path").toString().toStdString());
+      object.value("install_path").toString().toStdString());
 
   return game;
 }
@@ -220,7 +239,7 @@ std::vector<std::filesystem::path> GetHeroicGamesLauncherConfigPaths() {
 
 std::vector<HeroicGame> GetInstalledGogGames(
     const std::filesystem::path& heroicConfigPath) {
-  const auto logger = getLogger();
+  const auto logger = getLogger(LogCategory::detection);
 
   const auto installedGamesPath =
       heroicConfigPath / "gog_store" / "installed.json";
@@ -230,13 +249,19 @@ std::vector<HeroicGame> GetInstalledGogGames(
                   installedGamesPath.u8string());
   }
 
-  const auto json = ReadJsonObjectFromFile(installedGamesPath);
+  const auto content = ReadFile(installedGamesPath);
+  if (!MayContainAnyAppName(content, GOG_GAME_ID_MAP)) {
+    return {};
+  }
+
+  const auto json = QJsonDocument::fromJson(content).object();
 
   std::vector<HeroicGame> games;
 
   const auto installedGames = json.value("installed").toArray();
   for (const auto& installedGame : installedGames) {
-    const auto game = GetGameMetdata(installedGame, "appName", GOG_GAME_ID_MAP);
+    const auto game =
+        GetGameMetdata(installedGame.toObject(), "appName", GOG_GAME_ID_MAP);
     if (game.has_value()) {
       games.push_back(game.value());
     }
@@ -247,7 +272,7 @@ std::vector<HeroicGame> GetInstalledGogGames(
 
 std::vector<HeroicGame> GetInstalledEgsGames(
     const std::filesystem::path& heroicConfigPath) {
-  const auto logger = getLogger();
+  const auto logger = getLogger(LogCategory::detection);
 
   const auto installedGamesPath =
       heroicConfigPath / "legendaryConfig" / "legendary" / "installed.json";
@@ -257,13 +282,26 @@ std::vector<HeroicGame> GetInstalledEgsGames(
                   installedGamesPath.u8string());
   }
 
-  const auto json = ReadJsonObjectFromFile(installedGamesPath);
+  const auto content = ReadFile(installedGamesPath);
+  if (!MayContainAnyAppName(content, EGS_GAME_ID_MAP)) {
+    return {};
+  }
+
+  const auto json = QJsonDocument::fromJson(content).object();
 
   std::vector<HeroicGame> games;
 
-  for (const auto& installedGame : json) {
+  // The file's object is keyed by app name, so look up the supported games
+  // instead of checking every installed game. Both the map and the object's
+  // keys are sorted, so the games are found in the same order either way.
+  for (const auto& [appName, gameId] : EGS_GAME_ID_MAP) {
+    const auto installedGame = json.value(QString::fromStdString(appName));
+    if (!installedGame.isObject()) {
+      continue;
+    }
+
     const auto game =
-        GetGameMetdata(installedGame, "app_name", EGS_GAME_ID_MAP);
+        GetGameMetdata(installedGame.toObject(), "app_name", EGS_GAME_ID_MAP);
     if (game.has_value()) {
       games.push_back(game.value());
     }
@@ -276,7 +314,7 @@ std::filesystem::path GetGameLocalPath(
     const std::filesystem::path& heroicConfigPath,
     const std::string& appName,
     const std::string& gameFolderName) {
-  const auto logger = getLogger();
+  const auto logger = getLogger(LogCategory::detection);
 
   const auto gameConfigPath =
       heroicConfigPath / "GamesConfig" / (appName + ".json");
@@ -319,7 +357,7 @@ std::filesystem::path GetGameLocalPath(
 std::vector<GameInstall> FindGameInstalls(
     const std::filesystem::path& heroicConfigPath,
     const std::vector<std::string>& preferredUILanguages) {
-  const auto logger = getLogger();
+  const auto logger = getLogger(LogCategory::detection);
 
   std::vector<GameInstall> installs;
 
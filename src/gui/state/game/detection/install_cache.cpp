@@ -0,0 +1,556 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/game/detection/install_cache.h"
+
+#include <toml++/toml.h>
+
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+#include "gui/state/game/detection/common.h"
+#include "gui/state/game/detection/detail.h"
+#include "gui/state/game/detection/epic_games_store.h"
+#include "gui/state/game/detection/steam.h"
+#include "gui/state/logging.h"
+
+namespace {
+using loot::GameInstall;
+using loot::getLogger;
+using loot::LogCategory;
+using loot::RegistryInterface;
+using loot::RegistryValue;
+
+static constexpr int64_t CACHE_FORMAT_VERSION = 1;
+
+static constexpr const char* VERSION_KEY = "version";
+static constexpr const char* HEROIC_CONFIG_PATHS_KEY = "heroicConfigPaths";
+static constexpr const char* XBOX_GAMING_ROOT_PATHS_KEY =
+    "xboxGamingRootPaths";
+static constexpr const char* PREFERRED_UI_LANGUAGES_KEY =
+    "preferredUILanguages";
+static constexpr const char* PATHS_KEY = "paths";
+static constexpr const char* PATH_KEY = "path";
+static constexpr const char* WRITE_TIME_KEY = "writeTime";
+static constexpr const char* REGISTRY_VALUES_KEY = "registryValues";
+static constexpr const char* REGISTRY_SUB_KEYS_KEY = "registrySubKeys";
+static constexpr const char* ROOT_KEY_KEY = "rootKey";
+static constexpr const char* SUB_KEY_KEY = "subKey";
+static constexpr const char* VALUE_NAME_KEY = "valueName";
+static constexpr const char* VALUE_KEY = "value";
+static constexpr const char* SUB_KEYS_KEY = "subKeys";
+static constexpr const char* INSTALLS_KEY = "installs";
+static constexpr const char* GAME_ID_KEY = "gameId";
+static constexpr const char* SOURCE_KEY = "source";
+static constexpr const char* INSTALL_PATH_KEY = "installPath";
+static constexpr const char* LOCAL_PATH_KEY = "localPath";
+
+using RegistryValueKey = std::tuple<std::string, std::string, std::string>;
+using RegistrySubKeysKey = std::pair<std::string, std::string>;
+
+// Passes reads through to another Registry and records their results, so that
+// they can be compared against the Registry's state later. Game install probes
+// may run concurrently, so recording is synchronised.
+class RecordingRegistry : public RegistryInterface {
+public:
+  explicit RecordingRegistry(const RegistryInterface& registry) :
+      registry_(registry) {}
+
+  std::optional<std::string> GetStringValue(
+      const RegistryValue& value) const override {
+    auto data = registry_.GetStringValue(value);
+
+    std::lock_guard<std::mutex> guard(mutex_);
+    values_.insert_or_assign(
+        RegistryValueKey{value.rootKey, value.subKey, value.valueName}, data);
+
+    return data;
+  }
+
+  std::vector<std::string> GetSubKeys(
+      const std::string& rootKey,
+      const std::string& subKey) const override {
+    auto subKeys = registry_.GetSubKeys(rootKey, subKey);
+
+    std::lock_guard<std::mutex> guard(mutex_);
+    subKeys_.insert_or_assign(RegistrySubKeysKey{rootKey, subKey}, subKeys);
+
+    return subKeys;
+  }
+
+  std::map<RegistryValueKey, std::optional<std::string>> GetRecordedValues()
+      const {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return values_;
+  }
+
+  std::map<RegistrySubKeysKey, std::vector<std::string>> GetRecordedSubKeys()
+      const {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return subKeys_;
+  }
+
+private:
+  const RegistryInterface& registry_;
+  mutable std::mutex mutex_;
+  mutable std::map<RegistryValueKey, std::optional<std::string>> values_;
+  mutable std::map<RegistrySubKeysKey, std::vector<std::string>> subKeys_;
+};
+
+std::optional<int64_t> GetWriteTime(const std::filesystem::path& path) {
+  std::error_code errorCode;
+  const auto writeTime = std::filesystem::last_write_time(path, errorCode);
+  if (errorCode) {
+    return std::nullopt;
+  }
+
+  return static_cast<int64_t>(writeTime.time_since_epoch().count());
+}
+
+// Get the paths of the files and directories that game detection reads that
+// change when games are installed, moved or uninstalled. Directories are
+// included because adding or removing their entries changes their write
+// time.
+std::vector<std::filesystem::path> GetWatchedPaths(
+    const RegistryInterface& registry,
+    const std::vector<std::filesystem::path>& heroicConfigPaths,
+    const std::vector<std::filesystem::path>& xboxGamingRootPaths) {
+  std::vector<std::filesystem::path> paths;
+
+  for (const auto& steamInstallPath :
+       loot::steam::GetSteamInstallPaths(registry)) {
+    paths.push_back(steamInstallPath / "config" / "libraryfolders.vdf");
+
+    for (const auto& libraryPath :
+         loot::steam::GetSteamLibraryPaths(steamInstallPath)) {
+      paths.push_back(libraryPath / "steamapps");
+    }
+  }
+
+  for (const auto& heroicConfigPath : heroicConfigPaths) {
+    paths.push_back(heroicConfigPath / "gog_store" / "installed.json");
+    paths.push_back(heroicConfigPath / "legendaryConfig" / "legendary" /
+                    "installed.json");
+    paths.push_back(heroicConfigPath / "GamesConfig");
+  }
+
+  const auto egsManifestsPath = loot::epic::GetManifestsPath(registry);
+  if (egsManifestsPath.has_value()) {
+    paths.push_back(egsManifestsPath.value());
+  }
+
+  for (const auto& xboxGamingRootPath : xboxGamingRootPaths) {
+    paths.push_back(xboxGamingRootPath);
+  }
+
+  return paths;
+}
+
+std::vector<std::string> ToStrings(
+    const std::vector<std::filesystem::path>& paths) {
+  std::vector<std::string> strings;
+  for (const auto& path : paths) {
+    strings.push_back(path.u8string());
+  }
+
+  return strings;
+}
+
+toml::array ToArray(const std::vector<std::string>& strings) {
+  toml::array array;
+  for (const auto& string : strings) {
+    array.push_back(string);
+  }
+
+  return array;
+}
+
+std::optional<std::vector<std::string>> ReadStrings(const toml::node* node) {
+  if (node == nullptr || !node->is_array()) {
+    return std::nullopt;
+  }
+
+  std::vector<std::string> strings;
+  for (const auto& element : *node->as_array()) {
+    const auto string = element.value<std::string>();
+    if (!string.has_value()) {
+      return std::nullopt;
+    }
+
+    strings.push_back(string.value());
+  }
+
+  return strings;
+}
+
+toml::table BuildCache(
+    const std::vector<std::pair<std::filesystem::path, std::optional<int64_t>>>&
+        pathWriteTimes,
+    const RecordingRegistry& registry,
+    const std::vector<GameInstall>& installs,
+    const std::vector<std::filesystem::path>& heroicConfigPaths,
+    const std::vector<std::filesystem::path>& xboxGamingRootPaths,
+    const std::vector<std::string>& preferredUILanguages) {
+  toml::array paths;
+  for (const auto& [path, writeTime] : pathWriteTimes) {
+    toml::table table{{PATH_KEY, path.u8string()}};
+    if (writeTime.has_value()) {
+      table.insert(WRITE_TIME_KEY, writeTime.value());
+    }
+    paths.push_back(table);
+  }
+
+  toml::array registryValues;
+  for (const auto& [key, value] : registry.GetRecordedValues()) {
+    toml::table table{{ROOT_KEY_KEY, std::get<0>(key)},
+                      {SUB_KEY_KEY, std::get<1>(key)},
+                      {VALUE_NAME_KEY, std::get<2>(key)}};
+    if (value.has_value()) {
+      table.insert(VALUE_KEY, value.value());
+    }
+    registryValues.push_back(table);
+  }
+
+  toml::array registrySubKeys;
+  for (const auto& [key, subKeys] : registry.GetRecordedSubKeys()) {
+    registrySubKeys.push_back(toml::table{{ROOT_KEY_KEY, key.first},
+                                          {SUB_KEY_KEY, key.second},
+                                          {SUB_KEYS_KEY, ToArray(subKeys)}});
+  }
+
+  toml::array installsArray;
+  for (const auto& install : installs) {
+    installsArray.push_back(
+        toml::table{{GAME_ID_KEY, static_cast<int64_t>(install.gameId)},
+                    {SOURCE_KEY, static_cast<int64_t>(install.source)},
+                    {INSTALL_PATH_KEY, install.installPath.u8string()},
+                    {LOCAL_PATH_KEY, install.localPath.u8string()}});
+  }
+
+  return toml::table{
+      {VERSION_KEY, CACHE_FORMAT_VERSION},
+      {HEROIC_CONFIG_PATHS_KEY, ToArray(ToStrings(heroicConfigPaths))},
+      {XBOX_GAMING_ROOT_PATHS_KEY, ToArray(ToStrings(xboxGamingRootPaths))},
+      {PREFERRED_UI_LANGUAGES_KEY, ToArray(preferredUILanguages)},
+      {PATHS_KEY, paths},
+      {REGISTRY_VALUES_KEY, registryValues},
+      {REGISTRY_SUB_KEYS_KEY, registrySubKeys},
+      {INSTALLS_KEY, installsArray}};
+}
+
+void WriteCache(const std::filesystem::path& cachePath,
+                const toml::table& cache) {
+  auto tempPath = cachePath;
+  tempPath += ".tmp";
+
+  std::ofstream out(tempPath);
+  if (!out.is_open()) {
+    throw std::runtime_error(tempPath.u8string() +
+                             " could not be opened for writing");
+  }
+
+  out << cache;
+  out.close();
+
+  if (out.fail()) {
+    throw std::runtime_error("Failed to write to " + tempPath.u8string());
+  }
+
+  std::filesystem::rename(tempPath, cachePath);
+}
+
+std::optional<std::vector<GameInstall>> ReadInstalls(
+    const toml::table& cache) {
+  const auto installs = cache.get_as<toml::array>(INSTALLS_KEY);
+  if (installs == nullptr) {
+    return std::nullopt;
+  }
+
+  std::vector<GameInstall> gameInstalls;
+  for (const auto& node : *installs) {
+    const auto table = node.as_table();
+    if (table == nullptr) {
+      return std::nullopt;
+    }
+
+    const auto gameId = (*table)[GAME_ID_KEY].value<int64_t>();
+    const auto source = (*table)[SOURCE_KEY].value<int64_t>();
+    const auto installPath = (*table)[INSTALL_PATH_KEY].value<std::string>();
+    const auto localPath = (*table)[LOCAL_PATH_KEY].value<std::string>();
+
+    if (!gameId.has_value() || !source.has_value() ||
+        !installPath.has_value() || !localPath.has_value()) {
+      return std::nullopt;
+    }
+
+    if (gameId.value() < 0 ||
+        gameId.value() >= static_cast<int64_t>(loot::ALL_GAME_IDS.size()) ||
+        source.value() < 0 ||
+        source.value() > static_cast<int64_t>(loot::InstallSource::unknown)) {
+      return std::nullopt;
+    }
+
+    GameInstall install;
+    install.gameId = static_cast<loot::GameId>(gameId.value());
+    install.source = static_cast<loot::InstallSource>(source.value());
+    install.installPath = std::filesystem::u8path(installPath.value());
+    install.localPath = std::filesystem::u8path(localPath.value());
+
+    gameInstalls.push_back(install);
+  }
+
+  return gameInstalls;
+}
+
+// Returns a description of the first difference found between the cached
+// state and the current state, or nullopt if there are none.
+std::optional<std::string> FindCacheInvalidation(
+    const toml::table& cache,
+    const std::vector<GameInstall>& installs,
+    const RegistryInterface& registry,
+    const std::vector<std::filesystem::path>& heroicConfigPaths,
+    const std::vector<std::filesystem::path>& xboxGamingRootPaths,
+    const std::vector<std::string>& preferredUILanguages) {
+  if (cache[VERSION_KEY].value<int64_t>() != CACHE_FORMAT_VERSION) {
+    return "the cache format version has changed";
+  }
+
+  if (ReadStrings(cache.get(HEROIC_CONFIG_PATHS_KEY)) !=
+          ToStrings(heroicConfigPaths) ||
+      ReadStrings(cache.get(XBOX_GAMING_ROOT_PATHS_KEY)) !=
+          ToStrings(xboxGamingRootPaths) ||
+      ReadStrings(cache.get(PREFERRED_UI_LANGUAGES_KEY)) !=
+          preferredUILanguages) {
+    return "the detection inputs have changed";
+  }
+
+  const auto paths = cache.get_as<toml::array>(PATHS_KEY);
+  const auto registryValues = cache.get_as<toml::array>(REGISTRY_VALUES_KEY);
+  const auto registrySubKeys = cache.get_as<toml::array>(REGISTRY_SUB_KEYS_KEY);
+  if (paths == nullptr || registryValues == nullptr ||
+      registrySubKeys == nullptr) {
+    return "the cache is incomplete";
+  }
+
+  for (const auto& node : *paths) {
+    const auto table = node.as_table();
+    if (table == nullptr) {
+      return "the cache is incomplete";
+    }
+
+    const auto path = (*table)[PATH_KEY].value<std::string>();
+    if (!path.has_value()) {
+      return "the cache is incomplete";
+    }
+
+    const auto writeTime = (*table)[WRITE_TIME_KEY].value<int64_t>();
+    if (GetWriteTime(std::filesystem::u8path(path.value())) != writeTime) {
+      return path.value() + " has changed";
+    }
+  }
+
+  for (const auto& node : *registryValues) {
+    const auto table = node.as_table();
+    if (table == nullptr) {
+      return "the cache is incomplete";
+    }
+
+    const auto rootKey = (*table)[ROOT_KEY_KEY].value<std::string>();
+    const auto subKey = (*table)[SUB_KEY_KEY].value<std::string>();
+    const auto valueName = (*table)[VALUE_NAME_KEY].value<std::string>();
+    if (!rootKey.has_value() || !subKey.has_value() ||
+        !valueName.has_value()) {
+      return "the cache is incomplete";
+    }
+
+    const auto value = (*table)[VALUE_KEY].value<std::string>();
+    if (registry.GetStringValue(
+            {rootKey.value(), subKey.value(), valueName.value()}) != value) {
+      return "the Registry value " + rootKey.value() + "\\" + subKey.value() +
+             "\\" + valueName.value() + " has changed";
+    }
+  }
+
+  for (const auto& node : *registrySubKeys) {
+    const auto table = node.as_table();
+    if (table == nullptr) {
+      return "the cache is incomplete";
+    }
+
+    const auto rootKey = (*table)[ROOT_KEY_KEY].value<std::string>();
+    const auto subKey = (*table)[SUB_KEY_KEY].value<std::string>();
+    const auto subKeys = ReadStrings(table->get(SUB_KEYS_KEY));
+    if (!rootKey.has_value() || !subKey.has_value() || !subKeys.has_value()) {
+      return "the cache is incomplete";
+    }
+
+    if (registry.GetSubKeys(rootKey.value(), subKey.value()) !=
+        subKeys.value()) {
+      return "the subkeys of the Registry key " + rootKey.value() + "\\" +
+             subKey.value() + " have changed";
+    }
+  }
+
+  for (const auto& install : installs) {
+    std::error_code errorCode;
+    if (!std::filesystem::exists(install.installPath, errorCode)) {
+      return install.installPath.u8string() + " no longer exists";
+    }
+  }
+
+  return std::nullopt;
+}
+}
+
+namespace loot {
+std::optional<std::vector<GameInstall>> LoadCachedGameInstalls(
+    const std::filesystem::path& cachePath,
+    const RegistryInterface& registry,
+    const std::vector<std::filesystem::path>& heroicConfigPaths,
+    const std::vector<std::filesystem::path>& xboxGamingRootPaths,
+    const std::vector<std::string>& preferredUILanguages) {
+  const auto logger = getLogger(LogCategory::detection);
+
+  if (!std::filesystem::exists(cachePath)) {
+    return std::nullopt;
+  }
+
+  try {
+    // Don't use toml::parse_file() as it just uses a std stream,
+    // which don't support UTF-8 paths on Windows.
+    std::ifstream in(cachePath);
+    if (!in.is_open()) {
+      throw std::runtime_error(cachePath.u8string() +
+                               " could not be opened for parsing");
+    }
+
+    const auto cache = toml::parse(in, cachePath.u8string());
+
+    const auto installs = ReadInstalls(cache);
+    if (!installs.has_value()) {
+      if (logger) {
+        logger->warn("The game installs cache at {} is invalid, ignoring it.",
+                     cachePath.u8string());
+      }
+      return std::nullopt;
+    }
+
+    const auto invalidation = FindCacheInvalidation(cache,
+                                                    installs.value(),
+                                                    registry,
+                                                    heroicConfigPaths,
+                                                    xboxGamingRootPaths,
+                                                    preferredUILanguages);
+    if (invalidation.has_value()) {
+      if (logger) {
+        logger->info("The game installs cache is out of date because {}.",
+                     invalidation.value());
+      }
+      return std::nullopt;
+    }
+
+    if (logger) {
+      logger->debug("Using {} cached game installs from {}",
+                    installs.value().size(),
+                    cachePath.u8string());
+    }
+
+    return installs;
+  } catch (const std::exception& e) {
+    if (logger) {
+      logger->error("Failed to read the game installs cache at {}: {}",
+                    cachePath.u8string(),
+                    e.what());
+    }
+    return std::nullopt;
+  }
+}
+
+std::vector<GameInstall> DetectAndCacheGameInstalls(
+    const std::filesystem::path& cachePath,
+    const RegistryInterface& registry,
+    const std::vector<std::filesystem::path>& heroicConfigPaths,
+    const std::vector<std::filesystem::path>& xboxGamingRootPaths,
+    const std::vector<std::string>& preferredUILanguages) {
+  const RecordingRegistry recordingRegistry(registry);
+
+  // Record the state of the watched paths before detecting games, so that
+  // any changes made while detection is running invalidate the cache.
+  std::vector<std::pair<std::filesystem::path, std::optional<int64_t>>>
+      pathWriteTimes;
+  for (const auto& path : GetWatchedPaths(
+           recordingRegistry, heroicConfigPaths, xboxGamingRootPaths)) {
+    pathWriteTimes.push_back({path, GetWriteTime(path)});
+  }
+
+  const auto installs = FindGameInstalls(recordingRegistry,
+                                         heroicConfigPaths,
+                                         xboxGamingRootPaths,
+                                         preferredUILanguages);
+
+  try {
+    WriteCache(cachePath,
+               BuildCache(pathWriteTimes,
+                          recordingRegistry,
+                          installs,
+                          heroicConfigPaths,
+                          xboxGamingRootPaths,
+                          preferredUILanguages));
+  } catch (const std::exception& e) {
+    const auto logger = getLogger(LogCategory::detection);
+    if (logger) {
+      logger->error("Failed to write the game installs cache to {}: {}",
+                    cachePath.u8string(),
+                    e.what());
+    }
+  }
+
+  return installs;
+}
+
+std::vector<GameInstall> FindGameInstallsUsingCache(
+    const std::filesystem::path& cachePath,
+    const RegistryInterface& registry,
+    const std::vector<std::filesystem::path>& heroicConfigPaths,
+    const std::vector<std::filesystem::path>& xboxGamingRootPaths,
+    const std::vector<std::string>& preferredUILanguages) {
+  auto installs = LoadCachedGameInstalls(cachePath,
+                                         registry,
+                                         heroicConfigPaths,
+                                         xboxGamingRootPaths,
+                                         preferredUILanguages);
+  if (installs.has_value()) {
+    return installs.value();
+  }
+
+  return DetectAndCacheGameInstalls(cachePath,
+                                    registry,
+                                    heroicConfigPaths,
+                                    xboxGamingRootPaths,
+                                    preferredUILanguages);
+}
+}
@@ -0,0 +1,69 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_GAME_DETECTION_INSTALL_CACHE
+#define LOOT_GUI_STATE_GAME_DETECTION_INSTALL_CACHE
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "gui/state/game/detection/game_install.h"
+#include "gui/state/game/detection/registry.h"
+
+namespace loot {
+// Reads the game installs cached at the given path. They are only returned if
+// the cache was written for the same inputs, none of the Registry values,
+// config files and directories that were read to detect them have changed
+// since, and all the cached install paths still exist.
+std::optional<std::vector<GameInstall>> LoadCachedGameInstalls(
+    const std::filesystem::path& cachePath,
+    const RegistryInterface& registry,
+    const std::vector<std::filesystem::path>& heroicConfigPaths,
+    const std::vector<std::filesystem::path>& xboxGamingRootPaths,
+    const std::vector<std::string>& preferredUILanguages);
+
+// Detects installed games and writes them to the cache at the given path,
+// along with the state of the sources that they were detected from. Failing
+// to write the cache is logged but is not an error.
+std::vector<GameInstall> DetectAndCacheGameInstalls(
+    const std::filesystem::path& cachePath,
+    const RegistryInterface& registry,
+    const std::vector<std::filesystem::path>& heroicConfigPaths,
+    const std::vector<std::filesystem::path>& xboxGamingRootPaths,
+    const std::vector<std::string>& preferredUILanguages);
+
+// Gets the cached game installs if they are still valid, and otherwise
+// detects installed games and updates the cache.
+std::vector<GameInstall> FindGameInstallsUsingCache(
+    const std::filesystem::path& cachePath,
+    const RegistryInterface& registry,
+    const std::vector<std::filesystem::path>& heroicConfigPaths,
+    const std::vector<std::filesystem::path>& xboxGamingRootPaths,
+    const std::vector<std::string>& preferredUILanguages);
+}
+
+#endif
@@ -174,7 +174,7 @@ std::vector<GameInstall> FindGameInstalls(
       installs.push_back(install.value());
     }
   } catch (const std::exception& e) {
-    const auto logger = getLogger();
+    const auto logger = getLogger(LogCategory::detection);
     if (logger) {
       logger->error("Error while finding MS Store install of game {}: {}",
                     GetGameName(gameId),
@@ -57,7 +57,7 @@ std::optional<std::string> Registry::GetStringValue(
   DWORD len = MAX_PATH;
   std::wstring wstr(MAX_PATH, 0);
 
-  auto logger = getLogger();
+  auto logger = getLogger(LogCategory::detection);
   if (logger) {
     logger->trace(
         "Getting string for registry key, subkey and value: {}, {}, "
@@ -112,7 +112,7 @@ std::optional<std::string> Registry::GetStringValue(
 std::vector<std::string> Registry::GetSubKeys(const std::string& rootKey,
                                               const std::string& subKey) const {
 #ifdef _WIN32
-  const auto logger = getLogger();
+  const auto logger = getLogger(LogCategory::detection);
   if (logger) {
     logger->trace("Getting subkey names for registry key and subkey: {}, {}",
                   rootKey,
@@ -181,6 +181,54 @@ std::vector<std::string> Registry::GetSubKeys(const std::string& rootKey,
 #endif
 }
 
+CachingRegistry::CachingRegistry(const RegistryInterface& registry) :
+    registry_(registry) {}
+
+std::optional<std::string> CachingRegistry::GetStringValue(
+    const RegistryValue& value) const {
+  const auto key =
+      std::make_tuple(value.rootKey, value.subKey, value.valueName);
+
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    const auto it = values_.find(key);
+    if (it != values_.end()) {
+      return it->second;
+    }
+  }
+
+  // Don't hold the lock while reading so that concurrent reads of different
+  // keys aren't serialised. Concurrent reads of the same key may both miss
+  // the cache, but will get the same result.
+  auto result = registry_.GetStringValue(value);
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  values_.emplace(key, result);
+
+  return result;
+}
+
+std::vector<std::string> CachingRegistry::GetSubKeys(
+    const std::string& rootKey,
+    const std::string& subKey) const {
+  const auto key = std::make_pair(rootKey, subKey);
+
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    const auto it = subKeys_.find(key);
+    if (it != subKeys_.end()) {
+      return it->second;
+    }
+  }
+
+  auto result = registry_.GetSubKeys(rootKey, subKey);
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  subKeys_.emplace(key, result);
+
+  return result;
+}
+
 std::optional<std::filesystem::path> ReadPathFromRegistry(
     const RegistryInterface& registry,
     const RegistryValue& value) {
@@ -191,7 +239,7 @@ std::optional<std::filesystem::path> ReadPathFromRegistry(
       return std::filesystem::u8path(installedPath.value());
     }
   } catch (const std::exception& e) {
-    const auto logger = getLogger();
+    const auto logger = getLogger(LogCategory::detection);
     if (logger) {
       logger->error(
           "Error while trying to look up the registry key \"{}\\{}\\{}\": {}",
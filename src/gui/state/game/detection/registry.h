@@ -29,8 +29,11 @@
 #include <gui/state/game/detection/game_install.h>
 
 #include <filesystem>
+#include <map>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace loot {
@@ -60,6 +63,31 @@ class Registry : public RegistryInterface {
                                       const std::string& subKey) const override;
 };
 
+// Memoises the results of reads made through another Registry, so that keys
+// that are queried for several games or sources are only read once. It's
+// intended to be scoped to a single game detection pass, and is safe to use
+// concurrently. Failed reads are not memoised.
+class CachingRegistry : public RegistryInterface {
+public:
+  explicit CachingRegistry(const RegistryInterface& registry);
+
+  std::optional<std::string> GetStringValue(
+      const RegistryValue& value) const override;
+
+  std::vector<std::string> GetSubKeys(const std::string& rootKey,
+                                      const std::string& subKey) const override;
+
+private:
+  const RegistryInterface& registry_;
+  mutable std::mutex mutex_;
+  mutable std::map<std::tuple<std::string, std::string, std::string>,
+                   std::optional<std::string>>
+      values_;
+  mutable std::map<std::pair<std::string, std::string>,
+                   std::vector<std::string>>
+      subKeys_;
+};
+
 std::optional<std::filesystem::path> ReadPathFromRegistry(
     const RegistryInterface& registry,
     const RegistryValue& value);
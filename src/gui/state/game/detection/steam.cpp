@@ -25,10 +25,13 @@
 
 #include "gui/state/game/detection/steam.h"
 
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
+#include <cctype>
 #include <fstream>
+#include <functional>
 #include <map>
-#include <vdf_parser.hpp>
+#include <set>
 
 #include "gui/helpers.h"
 #include "gui/state/game/detection/common.h"
@@ -38,6 +41,9 @@
 namespace {
 using loot::GameId;
 
+static const std::string APP_MANIFEST_FILENAME_PREFIX = "appmanifest_";
+static const std::string APP_MANIFEST_FILENAME_SUFFIX = ".acf";
+
 std::vector<std::string> GetSteamGameIds(const GameId gameId) {
   switch (gameId) {
     case GameId::tes3:
@@ -149,72 +155,195 @@ There's some information about it here:
 https://developer.valvesoftware.com/wiki/KeyValues#About_KeyValues_Text_File_Format
 */
 
-void StripEscapes(std::string& token) {
-  boost::replace_all(token, "\\n", "\n");
-  boost::replace_all(token, "\\t", "\t");
-  boost::replace_all(token, "\\\\", "\\");
-  boost::replace_all(token, "\\\"", "\"");
-}
+struct VdfToken {
+  enum struct Type { string, objectStart, objectEnd };
 
-std::string GetStringValue(const std::string& line,
-                           const std::string& linePrefix) {
-  // -1 to cut off trailing double quote.
-  auto value =
-      line.substr(linePrefix.size(), line.size() - linePrefix.size() - 1);
-  StripEscapes(value);
+  Type type{Type::string};
+  std::string value;
+};
 
-  return value;
-}
+// A minimal reader for the KeyValues text format that only reports key-value
+// pairs as it encounters them, without building an object tree. This lets
+// callers stop reading as soon as they've found the values they need.
+class VdfScanner {
+public:
+  // The first argument is the keys of the objects that enclose the key-value
+  // pair, outermost first. Return false to stop scanning.
+  using Callback = std::function<bool(const std::vector<std::string>&,
+                                      const std::string&,
+                                      const std::string&)>;
+
+  explicit VdfScanner(std::istream& stream) : stream_(stream) {}
+
+  void Scan(const Callback& callback) {
+    std::vector<std::string> objectKeys;
+
+    for (auto token = ReadToken(); token.has_value(); token = ReadToken()) {
+      if (token->type == VdfToken::Type::objectEnd) {
+        if (objectKeys.empty()) {
+          throw std::runtime_error("Found an unexpected closing brace");
+        }
+        objectKeys.pop_back();
+        continue;
+      }
 
-// Return a list of paths to appmanifest files.
-std::vector<std::filesystem::path> ParseLibraryFoldersVdf(
-    std::istream& stream) {
-  const auto logger = loot::getLogger();
+      if (token->type == VdfToken::Type::objectStart) {
+        throw std::runtime_error("Found an object with no key");
+      }
 
-  try {
-    const auto root = tyti::vdf::read(stream);
+      const auto value = ReadToken();
+      if (!value.has_value() || value->type == VdfToken::Type::objectEnd) {
+        throw std::runtime_error("Found the key \"" + token->value +
+                                 "\" with no value");
+      }
 
-    if (root.name != "libraryfolders") {
-      if (logger) {
-        logger->error(
-            "Steam library folders VDF file has unexpected root node name {}",
-            root.name);
-        return {};
+      if (value->type == VdfToken::Type::objectStart) {
+        objectKeys.push_back(token->value);
+      } else if (!callback(objectKeys, token->value, value->value)) {
+        return;
       }
     }
 
-    std::vector<std::filesystem::path> appManifestPaths;
+    if (!objectKeys.empty()) {
+      throw std::runtime_error("Reached the end of the file inside an object");
+    }
+  }
 
-    for (const auto& [index, library] : root.childs) {
-      if (library == nullptr) {
-        if (logger) {
-          logger->error(
-              "Steam library folders VDF file has a key named {} with no "
-              "value, "
-              "skipping it",
-              index);
-        }
+private:
+  std::optional<VdfToken> ReadToken() {
+    while (true) {
+      const auto c = stream_.get();
+      if (c == std::char_traits<char>::eof()) {
+        return std::nullopt;
+      }
+
+      if (std::isspace(c)) {
+        continue;
+      }
+
+      if (c == '/' && stream_.peek() == '/') {
+        std::string comment;
+        std::getline(stream_, comment);
         continue;
       }
 
-      const auto pathIt = library->attribs.find("path");
-      if (pathIt == library->attribs.end()) {
+      if (c == '{') {
+        return VdfToken{VdfToken::Type::objectStart, ""};
+      }
+
+      if (c == '}') {
+        return VdfToken{VdfToken::Type::objectEnd, ""};
+      }
+
+      if (c == '"') {
+        return VdfToken{VdfToken::Type::string, ReadQuotedString()};
+      }
+
+      const auto token = ReadUnquotedString(static_cast<char>(c));
+
+      // Skip conditionals like [$WIN32], which LOOT doesn't need to evaluate.
+      if (token.front() != '[') {
+        return VdfToken{VdfToken::Type::string, token};
+      }
+    }
+  }
+
+  std::string ReadQuotedString() {
+    std::string string;
+
+    for (auto c = stream_.get(); c != std::char_traits<char>::eof();
+         c = stream_.get()) {
+      if (c == '"') {
+        return string;
+      }
+
+      if (c == '\\') {
+        const auto escaped = stream_.get();
+        switch (escaped) {
+          case 'n':
+            string.push_back('\n');
+            break;
+          case 't':
+            string.push_back('\t');
+            break;
+          case '\\':
+          case '"':
+            string.push_back(static_cast<char>(escaped));
+            break;
+          case std::char_traits<char>::eof():
+            string.push_back('\\');
+            break;
+          default:
+            string.push_back('\\');
+            string.push_back(static_cast<char>(escaped));
+            break;
+        }
+      } else {
+        string.push_back(static_cast<char>(c));
+      }
+    }
+
+    throw std::runtime_error("Reached the end of the file inside a string");
+  }
+
+  std::string ReadUnquotedString(char firstChar) {
+    std::string string(1, firstChar);
+
+    for (auto c = stream_.peek(); c != std::char_traits<char>::eof();
+         c = stream_.peek()) {
+      if (std::isspace(c) || c == '"' || c == '{' || c == '}') {
+        break;
+      }
+
+      string.push_back(static_cast<char>(stream_.get()));
+    }
+
+    return string;
+  }
+
+  std::istream& stream_;
+};
+
+// Return a list of Steam library paths.
+std::vector<std::filesystem::path> ParseLibraryFoldersVdf(
+    std::istream& stream) {
+  static constexpr const char* ROOT_KEY = "libraryfolders";
+  const auto logger = loot::getLogger(loot::LogCategory::detection);
+
+  try {
+    std::vector<std::filesystem::path> libraryPaths;
+    bool hasUnexpectedRoot = false;
+
+    VdfScanner(stream).Scan([&](const std::vector<std::string>& objectKeys,
+                                const std::string& key,
+                                const std::string& value) {
+      if (objectKeys.empty() || objectKeys.front() != ROOT_KEY) {
+        hasUnexpectedRoot = true;
         if (logger) {
           logger->error(
-              "Steam library folders VDF file has an object with no path key, "
-              "skipping it");
+              "Steam library folders VDF file has unexpected root node name {}",
+              objectKeys.empty() ? key : objectKeys.front());
         }
-        continue;
+        return false;
+      }
+
+      // Each library is an object that's a direct child of the root object.
+      if (objectKeys.size() == 2 && key == "path") {
+        libraryPaths.push_back(std::filesystem::u8path(value));
       }
 
-      appManifestPaths.push_back(std::filesystem::u8path(pathIt->second));
+      return true;
+    });
+
+    if (hasUnexpectedRoot) {
+      return {};
     }
 
-    // The parser exposes elements as unordered maps, so to ensure a consistent
-    // output order, sort the paths that have been collected.
-    std::sort(appManifestPaths.begin(), appManifestPaths.end());
+    // Sort the paths so that libraries are always probed in a consistent
+    // order.
+    std::sort(libraryPaths.begin(), libraryPaths.end());
 
-    return appManifestPaths;
+    return libraryPaths;
   } catch (const std::exception& e) {
     if (logger) {
       logger->error("Failed to parse Steam libraryfolders.vdf file: {}",
@@ -231,30 +360,51 @@ struct SteamAppManifest {
 
 // Returns game install directory.
 std::optional<SteamAppManifest> ParseAppManifest(std::istream& stream) {
-  const auto logger = loot::getLogger();
+  static constexpr const char* ROOT_KEY = "AppState";
+  const auto logger = loot::getLogger(loot::LogCategory::detection);
 
   try {
-    const auto root = tyti::vdf::read(stream);
+    std::optional<std::string> appId;
+    std::optional<std::string> installDir;
+    bool hasUnexpectedRoot = false;
+
+    VdfScanner(stream).Scan([&](const std::vector<std::string>& objectKeys,
+                                const std::string& key,
+                                const std::string& value) {
+      if (objectKeys.empty() || objectKeys.front() != ROOT_KEY) {
+        hasUnexpectedRoot = true;
+        if (logger) {
+          logger->error(
+              "Steam app manifest ACF file has unexpected root node name {}",
+              objectKeys.empty() ? key : objectKeys.front());
+        }
+        return false;
+      }
 
-    if (root.name != "AppState") {
-      if (logger) {
-        logger->error(
-            "Steam app manifest ACF file has unexpected root node name {}",
-            root.name);
-        return std::nullopt;
+      if (objectKeys.size() == 1) {
+        if (key == "appid") {
+          appId = value;
+        } else if (key == "installdir") {
+          installDir = value;
+        }
       }
+
+      // Stop reading once both values have been found.
+      return !appId.has_value() || !installDir.has_value();
+    });
+
+    if (hasUnexpectedRoot) {
+      return std::nullopt;
     }
 
-    const auto appIdIt = root.attribs.find("appid");
-    if (appIdIt == root.attribs.end()) {
+    if (!appId.has_value()) {
       if (logger) {
         logger->error("Steam app manifest ACF file has no appid key");
       }
       return std::nullopt;
     }
 
-    const auto installDirIt = root.attribs.find("installdir");
-    if (installDirIt == root.attribs.end()) {
+    if (!installDir.has_value()) {
       if (logger) {
         logger->error("Steam app manifest ACF file has no installdir key");
       }
@@ -262,8 +412,8 @@ std::optional<SteamAppManifest> ParseAppManifest(std::istream& stream) {
     }
 
     SteamAppManifest manifest;
-    manifest.appId = appIdIt->second;
-    manifest.installDir = installDirIt->second;
+    manifest.appId = appId.value();
+    manifest.installDir = installDir.value();
 
     return manifest;
   } catch (const std::exception& e) {
@@ -304,7 +454,7 @@ std::vector<std::filesystem::path> GetSteamInstallPaths(
                 ".local" / "share" / "Steam"};
 #endif
   } catch (const std::exception& e) {
-    const auto logger = getLogger();
+    const auto logger = getLogger(LogCategory::detection);
     if (logger) {
       logger->error("Error while getting Steam install paths: {}", e.what());
     }
@@ -315,7 +465,7 @@ std::vector<std::filesystem::path> GetSteamInstallPaths(
 
 std::vector<std::filesystem::path> GetSteamLibraryPaths(
     const std::filesystem::path& steamInstallPath) {
-  const auto logger = getLogger();
+  const auto logger = getLogger(LogCategory::detection);
 
   try {
     const auto vdfPath = steamInstallPath / "config" / "libraryfolders.vdf";
@@ -356,12 +506,13 @@ std::vector<std::filesystem::path> GetSteamAppManifestPaths(
     for (const auto& appId : GetSteamGameIds(gameId)) {
       const auto steamAppManifestPath =
           steamLibraryPath / "steamapps" /
-          std::filesystem::u8path("appmanifest_" + appId + ".acf");
+          std::filesystem::u8path(APP_MANIFEST_FILENAME_PREFIX + appId +
+                                  APP_MANIFEST_FILENAME_SUFFIX);
 
       paths.push_back(steamAppManifestPath);
     }
   } catch (const std::exception& e) {
-    const auto logger = getLogger();
+    const auto logger = getLogger(LogCategory::detection);
     if (logger) {
       logger->error(
           "Failed to get Steam app manifest paths for game {} and library "
@@ -378,7 +529,7 @@ std::vector<std::filesystem::path> GetSteamAppManifestPaths(
 // Parses steamapps/appmanifest_*.acf files.
 std::optional<GameInstall> FindGameInstall(
     const std::filesystem::path& steamAppManifestPath) {
-  const auto logger = getLogger();
+  const auto logger = getLogger(LogCategory::detection);
 
   try {
     if (!std::filesystem::exists(steamAppManifestPath)) {
@@ -475,6 +626,66 @@ std::optional<GameInstall> FindGameInstall(
   }
 }
 
+std::vector<GameInstall> FindGameInstalls(
+    const std::filesystem::path& steamLibraryPath) {
+  const auto logger = getLogger(LogCategory::detection);
+
+  // List the library's steamapps folder once instead of checking for each
+  // supported game's app manifests individually.
+  std::set<std::filesystem::path> manifestFilenames;
+  try {
+    std::error_code errorCode;
+    std::filesystem::directory_iterator it(steamLibraryPath / "steamapps",
+                                           errorCode);
+    if (errorCode) {
+      // Avoid logging unnecessary warnings if the library doesn't exist.
+      return {};
+    }
+
+    for (const auto& entry : it) {
+      const auto filename = entry.path().filename().u8string();
+      if (boost::starts_with(filename, APP_MANIFEST_FILENAME_PREFIX) &&
+          boost::ends_with(filename, APP_MANIFEST_FILENAME_SUFFIX)) {
+        const auto appId =
+            filename.substr(APP_MANIFEST_FILENAME_PREFIX.size(),
+                            filename.size() -
+                                APP_MANIFEST_FILENAME_PREFIX.size() -
+                                APP_MANIFEST_FILENAME_SUFFIX.size());
+
+        if (STEAM_GAME_ID_MAP.count(appId) != 0) {
+          manifestFilenames.insert(entry.path().filename());
+        }
+      }
+    }
+  } catch (const std::exception& e) {
+    if (logger) {
+      logger->error("Failed to list the Steam app manifests in {}: {}",
+                    steamLibraryPath.u8string(),
+                    e.what());
+    }
+    return {};
+  }
+
+  // Check the manifests in the same order as the supported games are listed,
+  // so that the order of the results doesn't depend on the filesystem.
+  std::vector<GameInstall> installs;
+  for (const auto& gameId : ALL_GAME_IDS) {
+    for (const auto& manifestPath :
+         GetSteamAppManifestPaths(steamLibraryPath, gameId)) {
+      if (manifestFilenames.count(manifestPath.filename()) == 0) {
+        continue;
+      }
+
+      const auto install = FindGameInstall(manifestPath);
+      if (install.has_value()) {
+        installs.push_back(install.value());
+      }
+    }
+  }
+
+  return installs;
+}
+
 std::vector<GameInstall> FindGameInstalls(const RegistryInterface& registry,
                                           const GameId gameId) {
   std::vector<GameInstall> installs;
@@ -494,7 +705,7 @@ std::vector<GameInstall> FindGameInstalls(const RegistryInterface& registry,
       }
     }
   } catch (const std::exception& e) {
-    const auto logger = getLogger();
+    const auto logger = getLogger(LogCategory::detection);
     if (logger) {
       logger->error(
           "Error while trying to find game installs for game {} using Steam "
@@ -52,6 +52,11 @@ std::vector<std::filesystem::path> GetSteamAppManifestPaths(
 std::optional<GameInstall> FindGameInstall(
     const std::filesystem::path& steamAppManifestPath);
 
+// Finds all supported games installed in the given Steam library, listing its
+// steamapps folder once and parsing only the app manifests of supported games.
+std::vector<GameInstall> FindGameInstalls(
+    const std::filesystem::path& steamLibraryPath);
+
 std::vector<GameInstall> FindGameInstalls(const RegistryInterface& registry,
                                           const GameId gameId);
 }
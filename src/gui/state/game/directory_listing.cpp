@@ -0,0 +1,392 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/game/directory_listing.h"
+
+#if defined(_WIN32) && defined(_MSC_VER)
+#ifndef UNICODE
+#define UNICODE
+#endif
+#ifndef _UNICODE
+#define _UNICODE
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#endif
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <cwchar>
+#include <memory>
+
+namespace {
+using loot::DirectoryEntry;
+
+bool IsIncluded(const std::function<bool(const std::string&)>& filter,
+                const std::string& filename) {
+  return !filter || filter(filename);
+}
+
+#ifndef __linux__
+// Used for entries that the platform-specific listing can't describe, and on
+// platforms that don't have one.
+void ReadEntryDetails(DirectoryEntry& entry) {
+  std::error_code errorCode;
+  const auto status = std::filesystem::status(entry.path, errorCode);
+  entry.isRegularFile = std::filesystem::is_regular_file(status);
+  entry.isDirectory = std::filesystem::is_directory(status);
+
+  if (!entry.isRegularFile) {
+    return;
+  }
+
+  const auto fileSize = std::filesystem::file_size(entry.path, errorCode);
+  if (errorCode) {
+    return;
+  }
+
+  const auto lastWriteTime =
+      std::filesystem::last_write_time(entry.path, errorCode);
+  if (errorCode) {
+    return;
+  }
+
+  entry.fileSize = fileSize;
+  entry.lastWriteTime = lastWriteTime;
+}
+#endif
+
+#if defined(_WIN32) && defined(_MSC_VER)
+struct FindCloser {
+  void operator()(HANDLE handle) const { ::FindClose(handle); }
+};
+
+bool IsDotOrDotDot(const wchar_t* filename) {
+  return std::wcscmp(filename, L".") == 0 || std::wcscmp(filename, L"..") == 0;
+}
+
+// Calls the given function for each entry in the directory, using a single
+// large-buffer enumeration that returns each entry's attributes, size and
+// timestamps along with its name.
+template<typename Function>
+void ForEachEntry(const std::filesystem::path& directory, Function function) {
+  WIN32_FIND_DATAW findData;
+  const auto handle = ::FindFirstFileExW((directory / L"*").c_str(),
+                                         FindExInfoBasic,
+                                         &findData,
+                                         FindExSearchNameMatch,
+                                         nullptr,
+                                         FIND_FIRST_EX_LARGE_FETCH);
+  if (handle == INVALID_HANDLE_VALUE) {
+    const auto error = ::GetLastError();
+    if (error == ERROR_FILE_NOT_FOUND) {
+      return;
+    }
+
+    throw std::filesystem::filesystem_error(
+        "Failed to list directory",
+        directory,
+        std::error_code(error, std::system_category()));
+  }
+
+  const std::unique_ptr<void, FindCloser> findHandle(handle);
+
+  do {
+    if (!IsDotOrDotDot(findData.cFileName)) {
+      function(findData);
+    }
+  } while (::FindNextFileW(handle, &findData));
+
+  const auto error = ::GetLastError();
+  if (error != ERROR_NO_MORE_FILES) {
+    throw std::filesystem::filesystem_error(
+        "Failed to list directory",
+        directory,
+        std::error_code(error, std::system_category()));
+  }
+}
+
+// MSVC's std::filesystem clock counts 100 ns intervals since 1601, just like
+// FILETIME, so the value can be used as-is.
+std::filesystem::file_time_type ToFileTime(const FILETIME& fileTime) {
+  const auto ticks =
+      (static_cast<uint64_t>(fileTime.dwHighDateTime) << 32) |
+      fileTime.dwLowDateTime;
+  return std::filesystem::file_time_type(
+      std::filesystem::file_time_type::duration(ticks));
+}
+#elif defined(__linux__)
+struct DirCloser {
+  void operator()(DIR* dir) const { closedir(dir); }
+};
+
+bool IsDotOrDotDot(const char* filename) {
+  return std::strcmp(filename, ".") == 0 || std::strcmp(filename, "..") == 0;
+}
+
+// readdir() reads entries from the kernel in large getdents64 batches and
+// gives each entry's type along with its name, so listing a directory
+// doesn't involve a syscall per entry.
+template<typename Function>
+void ForEachEntry(const std::filesystem::path& directory, Function function) {
+  const std::unique_ptr<DIR, DirCloser> dir(opendir(directory.c_str()));
+  if (!dir) {
+    const auto error = errno;
+    throw std::filesystem::filesystem_error(
+        "Failed to list directory",
+        directory,
+        std::error_code(error, std::generic_category()));
+  }
+
+  int error = 0;
+  while (true) {
+    errno = 0;
+    const auto entry = readdir(dir.get());
+    if (entry == nullptr) {
+      error = errno;
+      break;
+    }
+
+    if (!IsDotOrDotDot(entry->d_name)) {
+      function(dirfd(dir.get()), *entry);
+    }
+  }
+
+  if (error != 0) {
+    throw std::filesystem::filesystem_error(
+        "Failed to list directory",
+        directory,
+        std::error_code(error, std::generic_category()));
+  }
+}
+
+std::filesystem::file_time_type::duration ToDuration(
+    const struct timespec& time) {
+  return std::chrono::duration_cast<std::filesystem::file_time_type::duration>(
+      std::chrono::seconds(time.tv_sec) +
+      std::chrono::nanoseconds(time.tv_nsec));
+}
+
+bool operator==(const struct timespec& lhs, const struct timespec& rhs) {
+  return lhs.tv_sec == rhs.tv_sec && lhs.tv_nsec == rhs.tv_nsec;
+}
+
+// std::filesystem's clock has an unspecified epoch before C++20, but it's a
+// fixed offset from the Unix epoch, so find it by reading the same timestamp
+// both ways. The timestamps must match those that std::filesystem gives
+// exactly, as they're used as plugin file cache keys.
+std::optional<std::filesystem::file_time_type::duration>
+CalculateFileClockOffset() {
+  static constexpr const char* PATH = "/";
+  static constexpr unsigned int MAX_ATTEMPTS = 3;
+
+  for (unsigned int i = 0; i < MAX_ATTEMPTS; ++i) {
+    struct stat before;
+    if (stat(PATH, &before) != 0) {
+      return std::nullopt;
+    }
+
+    std::error_code errorCode;
+    const auto lastWriteTime =
+        std::filesystem::last_write_time(PATH, errorCode);
+    if (errorCode) {
+      return std::nullopt;
+    }
+
+    struct stat after;
+    if (stat(PATH, &after) != 0) {
+      return std::nullopt;
+    }
+
+    // Retry if the timestamp changed while it was being read.
+    if (before.st_mtim == after.st_mtim) {
+      return lastWriteTime.time_since_epoch() - ToDuration(before.st_mtim);
+    }
+  }
+
+  return std::nullopt;
+}
+
+std::optional<std::filesystem::file_time_type> ToFileTime(
+    const struct timespec& time) {
+  static const auto offset = CalculateFileClockOffset();
+  if (!offset.has_value()) {
+    return std::nullopt;
+  }
+
+  return std::filesystem::file_time_type(ToDuration(time) + offset.value());
+}
+#endif
+}
+
+namespace loot {
+#if defined(_WIN32) && defined(_MSC_VER)
+std::vector<DirectoryEntry> ListDirectory(
+    const std::filesystem::path& directory,
+    const std::function<bool(const std::string&)>& filter) {
+  std::vector<DirectoryEntry> entries;
+
+  ForEachEntry(directory, [&](const WIN32_FIND_DATAW& findData) {
+    const std::filesystem::path filename(findData.cFileName);
+    auto u8Filename = filename.u8string();
+    if (!IsIncluded(filter, u8Filename)) {
+      return;
+    }
+
+    DirectoryEntry entry;
+    entry.path = directory / filename;
+    entry.filename = std::move(u8Filename);
+
+    if ((findData.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0) {
+      // The listing describes the link, not what it points to.
+      ReadEntryDetails(entry);
+    } else if ((findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0) {
+      entry.isDirectory = true;
+    } else {
+      entry.isRegularFile = true;
+      entry.fileSize = (static_cast<uintmax_t>(findData.nFileSizeHigh) << 32) |
+                       findData.nFileSizeLow;
+      entry.lastWriteTime = ToFileTime(findData.ftLastWriteTime);
+    }
+
+    entries.push_back(std::move(entry));
+  });
+
+  return entries;
+}
+
+std::vector<std::string> ListDirectoryFilenames(
+    const std::filesystem::path& directory) {
+  std::vector<std::string> filenames;
+
+  ForEachEntry(directory, [&](const WIN32_FIND_DATAW& findData) {
+    filenames.push_back(std::filesystem::path(findData.cFileName).u8string());
+  });
+
+  return filenames;
+}
+#elif defined(__linux__)
+std::vector<DirectoryEntry> ListDirectory(
+    const std::filesystem::path& directory,
+    const std::function<bool(const std::string&)>& filter) {
+  std::vector<DirectoryEntry> entries;
+
+  ForEachEntry(directory, [&](int dirFd, const dirent& dirEntry) {
+    std::string filename(dirEntry.d_name);
+    if (!IsIncluded(filter, filename)) {
+      return;
+    }
+
+    DirectoryEntry entry;
+    entry.path = directory / filename;
+    entry.filename = std::move(filename);
+
+    if (dirEntry.d_type == DT_DIR) {
+      entry.isDirectory = true;
+    } else if (dirEntry.d_type == DT_REG || dirEntry.d_type == DT_LNK ||
+               dirEntry.d_type == DT_UNKNOWN) {
+      // A single stat relative to the open directory gives the size and
+      // last write time, and the type of whatever a link points to.
+      struct stat status;
+      if (fstatat(dirFd, dirEntry.d_name, &status, 0) == 0) {
+        entry.isRegularFile = S_ISREG(status.st_mode);
+        entry.isDirectory = S_ISDIR(status.st_mode);
+        if (entry.isRegularFile) {
+          entry.fileSize = static_cast<uintmax_t>(status.st_size);
+          entry.lastWriteTime = ToFileTime(status.st_mtim);
+        }
+      } else {
+        // The entry may have been removed since it was listed, or it may be
+        // a broken link. Either way, nothing more can be known about it.
+        entry.isRegularFile = dirEntry.d_type == DT_REG;
+      }
+    }
+
+    if (!entry.lastWriteTime.has_value()) {
+      entry.fileSize.reset();
+    }
+
+    entries.push_back(std::move(entry));
+  });
+
+  return entries;
+}
+
+std::vector<std::string> ListDirectoryFilenames(
+    const std::filesystem::path& directory) {
+  std::vector<std::string> filenames;
+
+  ForEachEntry(directory, [&](int, const dirent& dirEntry) {
+    filenames.push_back(dirEntry.d_name);
+  });
+
+  return filenames;
+}
+#else
+std::vector<DirectoryEntry> ListDirectory(
+    const std::filesystem::path& directory,
+    const std::function<bool(const std::string&)>& filter) {
+  std::vector<DirectoryEntry> entries;
+
+  for (std::filesystem::directory_iterator it(directory);
+       it != std::filesystem::directory_iterator();
+       ++it) {
+    auto filename = it->path().filename().u8string();
+    if (!IsIncluded(filter, filename)) {
+      continue;
+    }
+
+    DirectoryEntry entry;
+    entry.path = it->path();
+    entry.filename = std::move(filename);
+    ReadEntryDetails(entry);
+
+    entries.push_back(std::move(entry));
+  }
+
+  return entries;
+}
+
+std::vector<std::string> ListDirectoryFilenames(
+    const std::filesystem::path& directory) {
+  std::vector<std::string> filenames;
+
+  for (std::filesystem::directory_iterator it(directory);
+       it != std::filesystem::directory_iterator();
+       ++it) {
+    filenames.push_back(it->path().filename().u8string());
+  }
+
+  return filenames;
+}
+#endif
+}
@@ -0,0 +1,70 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_GAME_DIRECTORY_LISTING
+#define LOOT_GUI_STATE_GAME_DIRECTORY_LISTING
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace loot {
+struct DirectoryEntry {
+  std::filesystem::path path;
+  // The entry's filename, encoded as UTF-8.
+  std::string filename;
+  // Symlinks are followed, so these describe the entries they point to.
+  bool isRegularFile{false};
+  bool isDirectory{false};
+  // Only set for regular files whose size and last write time could be read.
+  // The values are the same as std::filesystem::file_size() and
+  // std::filesystem::last_write_time() would give.
+  std::optional<uintmax_t> fileSize;
+  std::optional<std::filesystem::file_time_type> lastWriteTime;
+};
+
+// Lists the entries directly inside the given directory. Where possible, each
+// entry's type, size and last write time are read in the same pass as its
+// name: on Windows they come with the directory listing itself, and on Linux
+// the file type comes with the listing and only entries that pass the filter
+// are stat'ed. Entries for which the filter (which is given the entry's UTF-8
+// filename) returns false are skipped without reading anything else about
+// them. Throws std::filesystem::filesystem_error if the directory can't be
+// read.
+std::vector<DirectoryEntry> ListDirectory(
+    const std::filesystem::path& directory,
+    const std::function<bool(const std::string&)>& filter = nullptr);
+
+// Lists only the UTF-8 filenames of the entries directly inside the given
+// directory, which avoids reading anything else about them on any platform.
+// Throws std::filesystem::filesystem_error if the directory can't be read.
+std::vector<std::string> ListDirectoryFilenames(
+    const std::filesystem::path& directory);
+}
+
+#endif
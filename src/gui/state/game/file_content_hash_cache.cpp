@@ -0,0 +1,101 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/game/file_content_hash_cache.h"
+
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "gui/state/diagnostics.h"
+#include "gui/state/game/sort_result_cache.h"
+
+namespace {
+loot::CacheCounter fileContentHashCacheCounter("File content hashes");
+
+std::optional<uint64_t> ReadContentHash(const std::filesystem::path& path) {
+  std::ifstream in(path, std::ios_base::in | std::ios_base::binary);
+  if (!in.is_open()) {
+    return std::nullopt;
+  }
+
+  const std::string content((std::istreambuf_iterator<char>(in)),
+                            std::istreambuf_iterator<char>());
+
+  loot::SortInputsHasher hasher;
+  hasher.Add(content);
+  return hasher.GetHash();
+}
+}
+
+namespace loot {
+std::optional<uint64_t> FileContentHashCache::GetHash(
+    const std::filesystem::path& path) {
+  std::error_code errorCode;
+  const auto fileSize = std::filesystem::file_size(path, errorCode);
+  if (errorCode) {
+    return std::nullopt;
+  }
+
+  const auto lastWriteTime = std::filesystem::last_write_time(path, errorCode);
+  if (errorCode) {
+    // The file can't be recognised again, so don't cache its hash.
+    return ReadContentHash(path);
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    const auto it = entries_.find(path);
+    const auto isHit = it != entries_.end() &&
+                       it->second.fileSize == fileSize &&
+                       it->second.lastWriteTime == lastWriteTime;
+    fileContentHashCacheCounter.recordLookup(isHit);
+    if (isHit) {
+      return it->second.hash;
+    }
+  }
+
+  // Don't hold the lock while reading, the file may be large.
+  const auto hash = ReadContentHash(path);
+  if (!hash.has_value()) {
+    return std::nullopt;
+  }
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  entries_.insert_or_assign(path, Entry{fileSize, lastWriteTime, hash.value()});
+
+  return hash;
+}
+
+size_t FileContentHashCache::Size() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return entries_.size();
+}
+
+FileContentHashCache& GetSharedFileContentHashCache() {
+  static FileContentHashCache cache;
+  return cache;
+}
+}
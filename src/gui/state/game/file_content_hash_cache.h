@@ -0,0 +1,62 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_GAME_FILE_CONTENT_HASH_CACHE
+#define LOOT_GUI_STATE_GAME_FILE_CONTENT_HASH_CACHE
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+
+namespace loot {
+// Remembers the hashes of files' content, so that a file that is checked
+// repeatedly, or by several games, is only read again once its size or last
+// write time changes. It's safe to use from any thread.
+class FileContentHashCache {
+public:
+  // Returns std::nullopt if the file can't be read.
+  std::optional<uint64_t> GetHash(const std::filesystem::path& path);
+
+  size_t Size() const;
+
+private:
+  struct Entry {
+    uintmax_t fileSize{0};
+    std::filesystem::file_time_type lastWriteTime;
+    uint64_t hash{0};
+  };
+
+  mutable std::mutex mutex_;
+  std::map<std::filesystem::path, Entry> entries_;
+};
+
+// Games that share a masterlist source or the masterlist prelude have
+// identical metadata list content, so they share one cache.
+FileContentHashCache& GetSharedFileContentHashCache();
+}
+
+#endif
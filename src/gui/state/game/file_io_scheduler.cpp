@@ -0,0 +1,79 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/game/file_io_scheduler.h"
+
+#include <map>
+
+#include "gui/helpers.h"
+
+namespace loot {
+std::vector<FileIoBatch> GetFileIoBatches(
+    const std::vector<std::filesystem::path>& paths) {
+  std::map<std::string, FileIoBatch> batchesByDrive;
+
+  // Files in the same directory are on the same drive, and there are usually
+  // far fewer directories than files, so only identify each directory's
+  // drive.
+  std::map<std::filesystem::path, std::string> driveIdsByDirectory;
+
+  for (size_t i = 0; i < paths.size(); ++i) {
+    const auto directory = paths[i].has_parent_path()
+                               ? paths[i].parent_path()
+                               : std::filesystem::path(".");
+
+    auto driveIt = driveIdsByDirectory.find(directory);
+    if (driveIt == driveIdsByDirectory.end()) {
+      driveIt =
+          driveIdsByDirectory.emplace(directory, GetDriveId(directory)).first;
+    }
+    const auto& driveId = driveIt->second;
+
+    auto it = batchesByDrive.find(driveId);
+    if (it == batchesByDrive.end()) {
+      FileIoBatch batch;
+      batch.isRotational = IsRotationalDrive(driveId);
+      it = batchesByDrive.emplace(driveId, batch).first;
+    }
+
+    it->second.indices.push_back(i);
+  }
+
+  std::vector<FileIoBatch> batches;
+  for (auto& [driveId, batch] : batchesByDrive) {
+    if (batch.isRotational) {
+      std::sort(batch.indices.begin(),
+                batch.indices.end(),
+                [&](size_t lhs, size_t rhs) {
+                  return paths[lhs] < paths[rhs];
+                });
+    }
+
+    batches.push_back(std::move(batch));
+  }
+
+  return batches;
+}
+}
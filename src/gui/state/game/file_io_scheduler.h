@@ -0,0 +1,71 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_GAME_FILE_IO_SCHEDULER
+#define LOOT_GUI_STATE_GAME_FILE_IO_SCHEDULER
+
+#include <algorithm>
+#include <filesystem>
+#include <vector>
+
+#include "gui/state/thread_pool.h"
+
+namespace loot {
+// A group of files that are all on the same drive.
+struct FileIoBatch {
+  bool isRotational{false};
+  // Indices into the paths that the batch was created from.
+  std::vector<size_t> indices;
+};
+
+// Group the given paths by the drive that their directories are on, so paths
+// to files that don't exist yet are grouped too. The indices in batches
+// for rotational drives are sorted by path, so that files in the same
+// directory are read one after another.
+std::vector<FileIoBatch> GetFileIoBatches(
+    const std::vector<std::filesystem::path>& paths);
+
+// Call the given function with each index into the given paths, when the
+// function reads the file at that path. Files on rotational drives are read
+// one at a time, to avoid thrashing the disk, while files on other drives are
+// read in parallel. Different drives are read from concurrently.
+template<typename Function>
+void ForEachFileIo(const std::vector<std::filesystem::path>& paths,
+                   const Function& function) {
+  const auto batches = GetFileIoBatches(paths);
+
+  parallelForEach(
+      batches.begin(), batches.end(), [&](const FileIoBatch& batch) {
+        if (batch.isRotational) {
+          std::for_each(batch.indices.begin(), batch.indices.end(), function);
+        } else {
+          parallelForEach(
+              batch.indices.begin(), batch.indices.end(), function);
+        }
+      });
+}
+}
+
+#endif
@@ -26,9 +26,11 @@
 #include "gui/state/game/game.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
-#include <execution>
 #include <fstream>
+#include <memory_resource>
+#include <set>
 #include <unordered_set>
 
 #ifdef _WIN32
@@ -53,12 +55,20 @@
 #include <boost/locale.hpp>
 
 #include "gui/helpers.h"
+#include "gui/state/diagnostics.h"
 #include "gui/state/game/detection/common.h"
 #include "gui/state/game/detection/detail.h"
 #include "gui/state/game/detection/generic.h"
+#include "gui/state/game/directory_listing.h"
+#include "gui/state/game/file_content_hash_cache.h"
+#include "gui/state/game/file_io_scheduler.h"
 #include "gui/state/game/helpers.h"
 #include "gui/state/logging.h"
 #include "gui/state/loot_paths.h"
+#include "gui/state/memory_accounting.h"
+#include "gui/state/thread_pool.h"
+#include "gui/state/timing.h"
+#include "gui/translation_cache.h"
 #include "loot/exception/file_access_error.h"
 #include "loot/exception/undefined_group_error.h"
 
@@ -69,7 +79,11 @@ using std::filesystem::u8path;
 namespace fs = std::filesystem;
 
 namespace {
+using loot::CacheCounter;
 using loot::GameType;
+using loot::Group;
+using loot::PluginMetadata;
+using loot::SortInputsHasher;
 
 struct Counters {
   size_t activeFullPlugins = 0;
@@ -77,6 +91,62 @@ struct Counters {
   size_t activeMediumPlugins = 0;
 };
 
+CacheCounter pluginFileCacheCounter("Plugin file validity");
+
+struct MaybePlugin {
+  std::filesystem::path path;
+  uintmax_t fileSize{0};
+  std::filesystem::file_time_type lastWriteTime;
+  bool isCacheable{false};
+  bool isValid{false};
+};
+
+MaybePlugin ToMaybePlugin(loot::DirectoryEntry&& entry) {
+  MaybePlugin maybePlugin;
+  maybePlugin.path = std::move(entry.path);
+
+  // If the file's size or last write time can't be read, it can't be
+  // matched against the plugin file cache, but it can still be checked.
+  if (entry.fileSize.has_value() && entry.lastWriteTime.has_value()) {
+    maybePlugin.fileSize = entry.fileSize.value();
+    maybePlugin.lastWriteTime = entry.lastWriteTime.value();
+    maybePlugin.isCacheable = true;
+  }
+
+  return maybePlugin;
+}
+
+struct DirectoryScan {
+  std::filesystem::path directory;
+  std::vector<MaybePlugin> maybePlugins;
+  std::exception_ptr exception;
+};
+
+void ScanDirectory(DirectoryScan& scan) {
+  LOOT_LOG_TRACE(loot::LogCategory::loading,
+                 "Scanning for plugins in {}",
+                 scan.directory.u8string());
+
+  try {
+    // Data folders can hold tens of thousands of loose files, so skip those
+    // that can't be plugins before reading anything else about them. The
+    // listing reads the size and last write time of the rest along with
+    // their type.
+    auto entries = loot::ListDirectory(
+        scan.directory, loot::HasPossiblyGhostedPluginFileExtension);
+
+    for (auto& entry : entries) {
+      if (entry.isRegularFile) {
+        scan.maybePlugins.push_back(ToMaybePlugin(std::move(entry)));
+      }
+    }
+  } catch (...) {
+    // Exceptions can't escape a parallel algorithm, so store it to be
+    // rethrown later.
+    scan.exception = std::current_exception();
+  }
+}
+
 std::filesystem::path GetLOOTGamePath(const std::filesystem::path& lootDataPath,
                                       const std::string& folderName) {
   return lootDataPath / "games" / std::filesystem::u8path(folderName);
@@ -106,7 +176,7 @@ void CopyMasterlistFromDefaultGameFolder(
       defaultLootGamePath / loot::MASTERLIST_FILENAME;
 
   if (fs::exists(defaultMasterlistPath)) {
-    const auto logger = loot::getLogger();
+    const auto logger = loot::getLogger(loot::LogCategory::loading);
     if (logger) {
       logger->debug("Copying masterlist from {} to {}",
                     defaultMasterlistPath.u8string(),
@@ -155,6 +225,242 @@ std::optional<std::filesystem::path> GetCCCFilename(const GameType gameType) {
       throw std::logic_error("Unrecognised game type");
   }
 }
+
+// Conditions in metadata can check for any file, but hashing every file in
+// the data paths would cost as much as sorting, so only the entries directly
+// inside the given directory are hashed. A directory's last write time
+// changes when it gains or loses a direct child.
+void AddDirectoryListing(SortInputsHasher& hasher, const fs::path& path) {
+  hasher.Add(path.u8string());
+
+  std::vector<DirectoryEntry> entries;
+  try {
+    entries = ListDirectory(path);
+  } catch (const fs::filesystem_error&) {
+    // The directory doesn't exist or can't be read, so only its path is
+    // hashed.
+    return;
+  }
+
+  std::sort(entries.begin(),
+            entries.end(),
+            [](const DirectoryEntry& lhs, const DirectoryEntry& rhs) {
+              return lhs.filename < rhs.filename;
+            });
+
+  for (const auto& entry : entries) {
+    hasher.Add(entry.filename);
+    hasher.Add(static_cast<uint64_t>(entry.isDirectory));
+    if (entry.fileSize.has_value()) {
+      hasher.Add(static_cast<uint64_t>(entry.fileSize.value()));
+    }
+
+    // The listing only reads the last write times of regular files, and
+    // there are few enough subdirectories that reading theirs separately is
+    // cheap.
+    auto lastWriteTime = entry.lastWriteTime;
+    if (!lastWriteTime.has_value() && entry.isDirectory) {
+      std::error_code ec;
+      lastWriteTime = fs::last_write_time(entry.path, ec);
+    }
+    if (lastWriteTime.has_value()) {
+      hasher.Add(static_cast<uint64_t>(
+          lastWriteTime.value().time_since_epoch().count()));
+    }
+  }
+}
+
+void AddFileStamp(SortInputsHasher& hasher, const fs::path& path) {
+  hasher.Add(path.u8string());
+
+  std::error_code ec;
+  hasher.Add(static_cast<uint64_t>(fs::file_size(path, ec)));
+  hasher.Add(static_cast<uint64_t>(
+      fs::last_write_time(path, ec).time_since_epoch().count()));
+}
+
+// Returns the file's content so that it doesn't need to be read again.
+std::string AddFileContent(SortInputsHasher& hasher, const fs::path& path) {
+  std::ifstream in(path, std::ios_base::in | std::ios_base::binary);
+  if (!in.is_open()) {
+    hasher.Add(std::string_view());
+    return std::string();
+  }
+
+  std::string content((std::istreambuf_iterator<char>(in)),
+                      std::istreambuf_iterator<char>());
+  hasher.Add(content);
+  return content;
+}
+
+std::optional<uint64_t> GetFileContentHash(const fs::path& path) {
+  std::ifstream in(path, std::ios_base::in | std::ios_base::binary);
+  if (!in.is_open()) {
+    return std::nullopt;
+  }
+
+  const std::string content((std::istreambuf_iterator<char>(in)),
+                            std::istreambuf_iterator<char>());
+
+  SortInputsHasher hasher;
+  hasher.Add(content);
+  return hasher.GetHash();
+}
+
+fs::path ExistingPathOrEmpty(const fs::path& path) {
+  return fs::exists(path) ? path : fs::path();
+}
+
+PluginMetadata GetMergedMetadata(const loot::gui::Game& game,
+                                 const std::string& pluginName) {
+  // Get metadata from masterlist and userlist.
+  PluginMetadata metadata(pluginName);
+
+  auto masterlistMetadata = game.GetMasterlistMetadata(pluginName);
+  auto userMetadata = game.GetUserMetadata(pluginName);
+
+  if (userMetadata.has_value()) {
+    if (masterlistMetadata.has_value()) {
+      userMetadata.value().MergeMetadata(masterlistMetadata.value());
+    }
+    metadata = userMetadata.value();
+  } else if (masterlistMetadata.has_value()) {
+    metadata = masterlistMetadata.value();
+  }
+
+  return metadata;
+}
+
+// Indent a plugin's YAML metadata so that it's an item in a sequence.
+std::string ToYamlSequenceItem(std::string_view yaml) {
+  std::string item;
+  item.reserve(yaml.size() + yaml.size() / 8);
+
+  size_t lineStart = 0;
+  while (lineStart < yaml.size()) {
+    auto lineEnd = yaml.find('\n', lineStart);
+    if (lineEnd == std::string_view::npos) {
+      lineEnd = yaml.size();
+    }
+
+    item += lineStart == 0 ? "  - " : "    ";
+    item.append(yaml.substr(lineStart, lineEnd - lineStart));
+    item += '\n';
+
+    lineStart = lineEnd + 1;
+  }
+
+  return item;
+}
+
+void AddGroups(SortInputsHasher& hasher, const std::vector<Group>& groups) {
+  hasher.Add(static_cast<uint64_t>(groups.size()));
+  for (const auto& group : groups) {
+    hasher.Add(group.GetName());
+
+    const auto afterGroups = group.GetAfterGroups();
+    hasher.Add(static_cast<uint64_t>(afterGroups.size()));
+    for (const auto& afterGroup : afterGroups) {
+      hasher.Add(afterGroup);
+    }
+  }
+}
+
+uint64_t GetGroupsHash(DatabaseInterface& database) {
+  SortInputsHasher hasher;
+  AddGroups(hasher, database.GetGroups(true));
+  return hasher.GetHash();
+}
+
+// Serialise the given plugins' metadata without evaluating any conditions, so
+// that it can be cheaply compared before and after reloading the metadata
+// lists. Conditions are evaluated against the game's state, which reloading
+// doesn't change, so unchanged unevaluated metadata evaluates the same way.
+std::vector<std::string> SerialiseUnevaluatedMetadata(
+    DatabaseInterface& database,
+    const std::vector<std::string>& pluginNames) {
+  std::vector<std::string> serialised;
+  serialised.reserve(pluginNames.size());
+
+  for (const auto& pluginName : pluginNames) {
+    const auto metadata = database.GetPluginMetadata(pluginName, true, false);
+    serialised.push_back(metadata.has_value() ? metadata.value().AsYaml()
+                                              : std::string());
+  }
+
+  return serialised;
+}
+
+// Write the metadata that the given function gets for each of the given
+// plugins, in the format described for loot::WriteMetadataAsYaml().
+void WriteMergedMetadataAsYaml(
+    const std::vector<std::string>& pluginNames,
+    const std::function<PluginMetadata(const std::string&)>& getMetadata,
+    std::ostream& out) {
+  static constexpr size_t BATCH_SIZE = 256;
+
+  struct SerialisedMetadata {
+    std::string yaml;
+    std::exception_ptr exception;
+  };
+
+  const auto serialise = [&getMetadata](const std::string& pluginName) {
+    SerialisedMetadata serialised;
+    try {
+      const auto metadata = getMetadata(pluginName);
+      if (!metadata.HasNameOnly()) {
+        serialised.yaml = ToYamlSequenceItem(metadata.AsYaml());
+      }
+    } catch (...) {
+      // Store the exception to be rethrown later, so that the error reported
+      // is the first in plugin order.
+      serialised.exception = std::current_exception();
+    }
+
+    return serialised;
+  };
+
+  size_t pluginCount = 0;
+  std::vector<SerialisedMetadata> batch;
+  for (size_t batchStart = 0; batchStart < pluginNames.size();
+       batchStart += BATCH_SIZE) {
+    const auto batchEnd = std::min(batchStart + BATCH_SIZE, pluginNames.size());
+
+    batch.resize(batchEnd - batchStart);
+    loot::parallelTransform(pluginNames.begin() + batchStart,
+                            pluginNames.begin() + batchEnd,
+                            batch.begin(),
+                            serialise);
+
+    for (const auto& serialised : batch) {
+      if (serialised.exception) {
+        std::rethrow_exception(serialised.exception);
+      }
+
+      if (serialised.yaml.empty()) {
+        continue;
+      }
+
+      if (pluginCount == 0) {
+        out << "plugins:\n";
+      }
+
+      out << serialised.yaml;
+      pluginCount += 1;
+    }
+  }
+
+  if (pluginCount == 0) {
+    out << "plugins: []\n";
+  }
+
+  auto logger = loot::getLogger(loot::LogCategory::loading);
+  if (logger) {
+    logger->debug("Wrote metadata for {} of {} plugins",
+                  pluginCount,
+                  pluginNames.size());
+  }
+}
 }
 
 namespace loot {
@@ -191,7 +497,7 @@ void InitLootGameFolder(const std::filesystem::path& lootDataPath,
                              lootDataPath / "SkyrimSE");
     }
 
-    const auto logger = getLogger();
+    const auto logger = getLogger(LogCategory::loading);
 
     for (const auto& legacyGamePath : legacyGamePaths) {
       if (fs::is_directory(legacyGamePath)) {
@@ -258,29 +564,38 @@ std::string GetLoadOrderAsTextTable(const gui::Game& game,
   return stream.str();
 }
 
-std::string GetMetadataAsBBCodeYaml(const gui::Game& game,
+std::string GetMetadataAsBBCodeYaml(const GameDataSnapshot& snapshot,
                                     const std::string& pluginName) {
-  auto logger = getLogger();
+  auto logger = getLogger(LogCategory::loading);
   if (logger) {
     logger->debug("Copying metadata for plugin {}", pluginName);
   }
 
-  // Get metadata from masterlist and userlist.
-  PluginMetadata metadata(pluginName);
+  const auto metadata = snapshot.GetMergedMetadata(pluginName);
 
-  auto masterlistMetadata = game.GetMasterlistMetadata(pluginName);
-  auto userMetadata = game.GetUserMetadata(pluginName);
+  return "[spoiler][code]\n" + metadata.AsYaml() + "\n[/code][/spoiler]";
+}
 
-  if (userMetadata.has_value()) {
-    if (masterlistMetadata.has_value()) {
-      userMetadata.value().MergeMetadata(masterlistMetadata.value());
-    }
-    metadata = userMetadata.value();
-  } else if (masterlistMetadata.has_value()) {
-    metadata = masterlistMetadata.value();
-  }
+void WriteMetadataAsYaml(const gui::Game& game,
+                         const std::vector<std::string>& pluginNames,
+                         std::ostream& out) {
+  WriteMergedMetadataAsYaml(
+      pluginNames,
+      [&game](const std::string& pluginName) {
+        return GetMergedMetadata(game, pluginName);
+      },
+      out);
+}
 
-  return "[spoiler][code]\n" + metadata.AsYaml() + "\n[/code][/spoiler]";
+void WriteMetadataAsYaml(const GameDataSnapshot& snapshot,
+                         const std::vector<std::string>& pluginNames,
+                         std::ostream& out) {
+  WriteMergedMetadataAsYaml(
+      pluginNames,
+      [&snapshot](const std::string& pluginName) {
+        return snapshot.GetMergedMetadata(pluginName);
+      },
+      out);
 }
 
 bool SupportsLightPlugins(const gui::Game& game) {
@@ -306,7 +621,7 @@ bool SupportsLightPlugins(const GameType gameType) {
 }
 
 void LogLoadOrderPaths(const gui::Game& game) {
-  const auto logger = getLogger();
+  const auto logger = getLogger(LogCategory::loading);
   if (!logger) {
     return;
   }
@@ -354,7 +669,9 @@ Game::Game(const GameSettings& gameSettings,
     preludePath_(preludePath),
     isMicrosoftStoreInstall_(
         generic::IsMicrosoftInstall(settings_.Id(), settings_.GamePath())),
-    supportsLightPlugins_(loot::SupportsLightPlugins(settings_.Type())) {}
+    supportsLightPlugins_(loot::SupportsLightPlugins(settings_.Type())) {
+  UpdateExternalDataPaths();
+}
 
 Game::Game(Game&& game) {
   settings_ = std::move(game.settings_);
@@ -366,6 +683,30 @@ Game::Game(Game&& game) {
   pluginsFullyLoaded_ = std::move(game.pluginsFullyLoaded_);
   isMicrosoftStoreInstall_ = std::move(game.isMicrosoftStoreInstall_);
   supportsLightPlugins_ = std::move(game.supportsLightPlugins_);
+  isMWSEInstalled_ = std::move(game.isMWSEInstalled_);
+  externalDataPaths_ = std::move(game.externalDataPaths_);
+  pluginFileCache_ = std::move(game.pluginFileCache_);
+  pluginCrcs_ = std::move(game.pluginCrcs_);
+  loadOrderFilesHash_ = std::move(game.loadOrderFilesHash_);
+  loadOrderJournalState_ = std::move(game.loadOrderJournalState_);
+  recordOverlapIndex_ = std::move(game.recordOverlapIndex_);
+  cachedSortResult_ = std::move(game.cachedSortResult_);
+  preSortLoadOrder_ = std::move(game.preSortLoadOrder_);
+  hasUnsavedUserMetadata_ = std::move(game.hasUnsavedUserMetadata_);
+  userlistContentHash_ = std::move(game.userlistContentHash_);
+  metadataListsHash_ = std::move(game.metadataListsHash_);
+  groupGraph_ = std::move(game.groupGraph_);
+  dataPathsSnapshot_ = std::move(game.dataPathsSnapshot_);
+  activePluginsSnapshot_ = std::move(game.activePluginsSnapshot_);
+  activePluginCounts_ = std::move(game.activePluginCounts_);
+  activePluginCountMessages_ = std::move(game.activePluginCountMessages_);
+  isLoadOrderAmbiguous_ = std::move(game.isLoadOrderAmbiguous_);
+  activeLoadOrderIndices_ = std::move(game.activeLoadOrderIndices_);
+  pluginDependentsIndex_ = std::move(game.pluginDependentsIndex_);
+  pathCaseSensitivity_ = std::move(game.pathCaseSensitivity_);
+  creationClubPlugins_ = std::move(game.creationClubPlugins_);
+  cccFileStamp_ = std::move(game.cccFileStamp_);
+  dataSnapshot_ = std::move(game.dataSnapshot_);
 }
 
 Game& Game::operator=(Game&& game) {
@@ -379,6 +720,30 @@ Game& Game::operator=(Game&& game) {
     pluginsFullyLoaded_ = std::move(game.pluginsFullyLoaded_);
     isMicrosoftStoreInstall_ = std::move(game.isMicrosoftStoreInstall_);
     supportsLightPlugins_ = std::move(game.supportsLightPlugins_);
+    isMWSEInstalled_ = std::move(game.isMWSEInstalled_);
+    externalDataPaths_ = std::move(game.externalDataPaths_);
+    pluginFileCache_ = std::move(game.pluginFileCache_);
+    pluginCrcs_ = std::move(game.pluginCrcs_);
+    loadOrderFilesHash_ = std::move(game.loadOrderFilesHash_);
+    loadOrderJournalState_ = std::move(game.loadOrderJournalState_);
+    recordOverlapIndex_ = std::move(game.recordOverlapIndex_);
+    cachedSortResult_ = std::move(game.cachedSortResult_);
+    preSortLoadOrder_ = std::move(game.preSortLoadOrder_);
+    hasUnsavedUserMetadata_ = std::move(game.hasUnsavedUserMetadata_);
+    userlistContentHash_ = std::move(game.userlistContentHash_);
+    metadataListsHash_ = std::move(game.metadataListsHash_);
+    groupGraph_ = std::move(game.groupGraph_);
+    dataPathsSnapshot_ = std::move(game.dataPathsSnapshot_);
+    activePluginsSnapshot_ = std::move(game.activePluginsSnapshot_);
+    activePluginCounts_ = std::move(game.activePluginCounts_);
+    activePluginCountMessages_ = std::move(game.activePluginCountMessages_);
+    isLoadOrderAmbiguous_ = std::move(game.isLoadOrderAmbiguous_);
+    activeLoadOrderIndices_ = std::move(game.activeLoadOrderIndices_);
+    pluginDependentsIndex_ = std::move(game.pluginDependentsIndex_);
+    pathCaseSensitivity_ = std::move(game.pathCaseSensitivity_);
+    creationClubPlugins_ = std::move(game.creationClubPlugins_);
+    cccFileStamp_ = std::move(game.cccFileStamp_);
+    dataSnapshot_ = std::move(game.dataSnapshot_);
   }
 
   return *this;
@@ -389,7 +754,9 @@ const GameSettings& Game::GetSettings() const { return settings_; }
 GameSettings& Game::GetSettings() { return settings_; }
 
 void Game::Init() {
-  auto logger = getLogger();
+  ScopedTimer timer("Game::Init");
+
+  auto logger = getLogger(LogCategory::loading);
   if (logger) {
     logger->info("Initialising filesystem-related data for game: {}",
                  settings_.Name());
@@ -398,18 +765,92 @@ void Game::Init() {
   // Reset data that is dependent on the libloot game handle.
   messages_.clear();
   loadOrderSortCount_ = 0;
+  preSortLoadOrder_.reset();
   pluginsFullyLoaded_ = false;
+  pluginCrcs_.clear();
+  loadOrderFilesHash_.reset();
+  metadataListsHash_.reset();
+  ClearGroupGraph();
+  hasUnsavedUserMetadata_ = false;
+  userlistContentHash_ = std::nullopt;
   supportsLightPlugins_ = loot::SupportsLightPlugins(*this);
+  // The game's paths may have changed since it was constructed.
+  isMicrosoftStoreInstall_ =
+      generic::IsMicrosoftInstall(settings_.Id(), settings_.GamePath());
+  isMWSEInstalled_ =
+      settings_.Id() == GameId::tes3 &&
+      std::filesystem::exists(settings_.GamePath() / "MWSE.dll");
+  UpdateExternalDataPaths();
+  ClearDataPathsSnapshot();
+  ClearActivePluginsCache();
+  ClearDataSnapshot();
+  {
+    std::lock_guard<std::mutex> guard(pathCaseSensitivityMutex_);
+    pathCaseSensitivity_.reset();
+  }
 
   gameHandle_ = CreateGameHandle(
       settings_.Type(), settings_.GamePath(), settings_.GameLocalPath());
   gameHandle_->IdentifyMainMasterFile(settings_.Master());
 
   InitLootGameFolder(lootDataPath_, settings_);
+
+  try {
+    pluginFileCache_ = LoadPluginFileCache(PluginFileCachePath());
+  } catch (const std::exception& e) {
+    // The cache is only an optimisation, so just start again without it.
+    if (logger) {
+      logger->warn("Failed to load the plugin file cache. Details: {}",
+                   e.what());
+    }
+    pluginFileCache_.Clear();
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(sortResultMutex_);
+    try {
+      cachedSortResult_ = LoadCachedSortResult(SortResultCachePath());
+    } catch (const std::exception& e) {
+      if (logger) {
+        logger->warn("Failed to load the cached sort result. Details: {}",
+                     e.what());
+      }
+      cachedSortResult_.reset();
+    }
+  }
+
+  std::lock_guard<std::mutex> guard(recordOverlapIndexMutex_);
+  try {
+    recordOverlapIndex_ = LoadRecordOverlapIndex(RecordOverlapIndexPath());
+  } catch (const std::exception& e) {
+    // Like the plugin file cache, the index is only an optimisation.
+    if (logger) {
+      logger->warn("Failed to load the record overlap index. Details: {}",
+                   e.what());
+    }
+    recordOverlapIndex_.Clear();
+  }
 }
 
 bool Game::IsInitialised() const { return gameHandle_ != nullptr; }
 
+void Game::Unload() {
+  auto logger = getLogger(LogCategory::loading);
+  if (logger) {
+    logger->info("Unloading data for game: {}", settings_.Name());
+  }
+
+  gameHandle_.reset();
+  messages_.clear();
+  pluginsFullyLoaded_ = false;
+  pluginCrcs_.clear();
+  loadOrderFilesHash_.reset();
+  metadataListsHash_.reset();
+  ClearDataPathsSnapshot();
+  ClearActivePluginsCache();
+  ClearDataSnapshot();
+}
+
 const PluginInterface* Game::GetPlugin(const std::string& name) const {
   return gameHandle_->GetPlugin(name);
 }
@@ -422,15 +863,16 @@ std::vector<SourcedMessage> Game::CheckInstallValidity(
     const PluginInterface& plugin,
     const PluginMetadata& metadata,
     const std::string& language) const {
-  auto logger = getLogger();
+  auto logger = getLogger(LogCategory::loading);
+
+  LOOT_LOG_TRACE(
+      LogCategory::loading,
+      "Checking that the current install is valid according to {}'s data.",
+      plugin.GetName());
+  const auto activePlugins = GetActivePluginsSnapshot();
 
-  if (logger) {
-    logger->trace(
-        "Checking that the current install is valid according to {}'s data.",
-        plugin.GetName());
-  }
   std::vector<SourcedMessage> messages;
-  if (IsPluginActive(plugin.GetName())) {
+  if (activePlugins->IsActive(plugin.GetName())) {
     auto tags = metadata.GetTags();
     const auto hasFilterTag =
         std::any_of(tags.cbegin(), tags.cend(), [&](const Tag& tag) {
@@ -449,11 +891,10 @@ std::vector<SourcedMessage> Game::CheckInstallValidity(
               MessageType::error,
               MessageSource::missingMaster,
               fmt::format(
-                  boost::locale::translate("This plugin requires \"{0}\" to be "
-                                           "installed, but it is missing.")
-                      .str(),
+                  TranslateCached("This plugin requires \"{0}\" to be "
+                                  "installed, but it is missing."),
                   master)));
-        } else if (!IsPluginActive(master)) {
+        } else if (!activePlugins->IsActive(master)) {
           if (logger) {
             logger->error("\"{}\" requires \"{}\", but it is inactive.",
                           plugin.GetName(),
@@ -463,15 +904,20 @@ std::vector<SourcedMessage> Game::CheckInstallValidity(
               MessageType::error,
               MessageSource::inactiveMaster,
               fmt::format(
-                  boost::locale::translate("This plugin requires \"{0}\" to be "
-                                           "active, but it is inactive.")
-                      .str(),
+                  TranslateCached("This plugin requires \"{0}\" to be "
+                                  "active, but it is inactive."),
                   master)));
         }
       }
     }
 
-    std::unordered_set<std::string> displayNamesWithMessages;
+    // The set of display names is only needed while checking this plugin's
+    // requirements and incompatibilities, so allocate it from a stack-backed
+    // arena that's freed in one go when the check finishes.
+    std::array<std::byte, 1024> arenaBuffer;
+    std::pmr::monotonic_buffer_resource arena(arenaBuffer.data(),
+                                              arenaBuffer.size());
+    std::pmr::unordered_set<std::pmr::string> displayNamesWithMessages(&arena);
 
     for (const auto& req : metadata.GetRequirements()) {
       auto file = std::string(req.GetName());
@@ -488,14 +934,13 @@ std::vector<SourcedMessage> Game::CheckInstallValidity(
 
         const auto displayName = GetDisplayName(req);
 
-        if (displayNamesWithMessages.count(displayName) > 0) {
+        if (!displayNamesWithMessages.emplace(displayName).second) {
           continue;
         }
 
         auto localisedText = fmt::format(
-            boost::locale::translate("This plugin requires \"{0}\" to be "
-                                     "installed, but it is missing.")
-                .str(),
+            TranslateCached("This plugin requires \"{0}\" to be "
+                            "installed, but it is missing."),
             displayName);
         auto detailContent = SelectMessageContent(req.GetDetail(), language);
         auto messageText =
@@ -506,7 +951,6 @@ std::vector<SourcedMessage> Game::CheckInstallValidity(
         messages.push_back(SourcedMessage{MessageType::error,
                                           MessageSource::requirementMetadata,
                                           messageText});
-        displayNamesWithMessages.insert(displayName);
       }
     }
 
@@ -515,7 +959,7 @@ std::vector<SourcedMessage> Game::CheckInstallValidity(
     for (const auto& inc : metadata.GetIncompatibilities()) {
       auto file = std::string(inc.GetName());
       if (FileExists(file) &&
-          (!HasPluginFileExtension(file) || IsPluginActive(file))) {
+          (!HasPluginFileExtension(file) || activePlugins->IsActive(file))) {
         if (logger) {
           logger->error(
               "\"{}\" is incompatible with \"{}\", but both are present. {}",
@@ -529,15 +973,14 @@ std::vector<SourcedMessage> Game::CheckInstallValidity(
 
         const auto displayName = GetDisplayName(inc);
 
-        if (displayNamesWithMessages.count(displayName) > 0) {
+        if (!displayNamesWithMessages.emplace(displayName).second) {
           continue;
         }
 
         auto localisedText = fmt::format(
-            boost::locale::translate(
+            TranslateCached(
                 "This plugin is incompatible with \"{0}\", but both "
-                "are present.")
-                .str(),
+                "are present."),
             displayName);
         auto detailContent = SelectMessageContent(inc.GetDetail(), language);
         auto messageText =
@@ -549,7 +992,6 @@ std::vector<SourcedMessage> Game::CheckInstallValidity(
             SourcedMessage{MessageType::error,
                            MessageSource::incompatibilityMetadata,
                            messageText});
-        displayNamesWithMessages.insert(displayName);
       }
     }
   }
@@ -580,18 +1022,17 @@ std::vector<SourcedMessage> Game::CheckInstallValidity(
 
         const auto pluginType =
             settings_.Id() == GameId::starfield
-                ? boost::locale::translate("small master").str()
-                : boost::locale::translate("light master").str();
+                ? TranslateCached("small master")
+                : TranslateCached("light master");
 
         messages.push_back(CreatePlainTextSourcedMessage(
             MessageType::error,
             MessageSource::lightPluginRequiresNonMaster,
             fmt::format(
-                boost::locale::translate(
+                TranslateCached(
                     "This plugin is a {0} and requires the non-master plugin "
                     "\"{1}\". This can cause issues in-game, and sorting will "
-                    "fail while this plugin is installed.")
-                    .str(),
+                    "fail while this plugin is installed."),
                 pluginType,
                 masterName)));
       }
@@ -609,7 +1050,7 @@ std::vector<SourcedMessage> Game::CheckInstallValidity(
     messages.push_back(CreatePlainTextSourcedMessage(
         MessageType::error,
         MessageSource::invalidLightPlugin,
-        boost::locale::translate(
+        TranslateCached(
             "This plugin contains records that have FormIDs outside "
             "the valid range for an ESL plugin. Using this plugin "
             "will cause irreversible damage to your game saves.")));
@@ -627,7 +1068,7 @@ std::vector<SourcedMessage> Game::CheckInstallValidity(
     messages.push_back(CreatePlainTextSourcedMessage(
         MessageType::error,
         MessageSource::invalidMediumPlugin,
-        boost::locale::translate(
+        TranslateCached(
             "This plugin contains records that have FormIDs outside "
             "the valid range for a medium plugin. Using this plugin "
             "will cause irreversible damage to your game saves.")));
@@ -641,10 +1082,10 @@ std::vector<SourcedMessage> Game::CheckInstallValidity(
           plugin.GetName());
     }
     const auto pluginType = boost::iends_with(plugin.GetName(), ".esp")
-                                ? boost::locale::translate("plugin")
+                                ? TranslateCached("plugin")
                                 /* translators: master as in a plugin that is
                                    loaded as if its master flag is set. */
-                                : boost::locale::translate("master");
+                                : TranslateCached("master");
     if (settings_.Type() == GameType::tes5vr) {
       messages.push_back(SourcedMessage{
           MessageType::error,
@@ -652,13 +1093,12 @@ std::vector<SourcedMessage> Game::CheckInstallValidity(
           fmt::format(
               /* translators: {1} in this message can be "master" or "plugin"
                  and {2} is the name of a requirement. */
-              boost::locale::translate(
+              TranslateCached(
                   "\"{0}\" is a light {1}, but {2} seems to be "
                   "missing. Please ensure you have correctly installed "
-                  "{2} and all its requirements.")
-                  .str(),
+                  "{2} and all its requirements."),
               EscapeMarkdownASCIIPunctuation(plugin.GetName()),
-              pluginType.str(),
+              pluginType,
               "[Skyrim VR ESL "
               "Support](https://www.nexusmods.com/skyrimspecialedition/"
               "mods/106712/)")});
@@ -666,10 +1106,9 @@ std::vector<SourcedMessage> Game::CheckInstallValidity(
       messages.push_back(CreatePlainTextSourcedMessage(
           MessageType::error,
           MessageSource::lightPluginNotSupported,
-          fmt::format(boost::locale::translate("\"{0}\" is a .esl plugin, but "
-                                               "the game does not support such "
-                                               "plugins, and will not load it.")
-                          .str(),
+          fmt::format(TranslateCached("\"{0}\" is a .esl plugin, but "
+                                      "the game does not support such "
+                                      "plugins, and will not load it."),
                       plugin.GetName())));
     } else {
       messages.push_back(CreatePlainTextSourcedMessage(
@@ -678,13 +1117,12 @@ std::vector<SourcedMessage> Game::CheckInstallValidity(
           fmt::format(
               /* translators: {1} in this message can be "master" or "plugin".
                */
-              boost::locale::translate(
+              TranslateCached(
                   "\"{0}\" is flagged as a light {1}, but the game "
                   "does not support such plugins, and will load it as "
-                  "a full {1}.")
-                  .str(),
+                  "a full {1}."),
               plugin.GetName(),
-              pluginType.str())));
+              pluginType)));
     }
   }
 
@@ -698,7 +1136,7 @@ std::vector<SourcedMessage> Game::CheckInstallValidity(
     messages.push_back(CreatePlainTextSourcedMessage(
         MessageType::error,
         MessageSource::invalidUpdatePlugin,
-        boost::locale::translate(
+        TranslateCached(
             "This plugin is an update plugin but adds new records. Using "
             "this plugin may cause irreversible damage to your game saves.")));
   }
@@ -717,12 +1155,11 @@ std::vector<SourcedMessage> Game::CheckInstallValidity(
         MessageType::warn,
         MessageSource::invalidHeaderVersion,
         fmt::format(
-            boost::locale::translate(
-                /* translators: A header is the part of a file that stores data
-                   like file name and version. */
+            /* translators: A header is the part of a file that stores data
+               like file name and version. */
+            TranslateCached(
                 "This plugin has a header version of {0}, which is less than "
-                "the game's minimum supported header version of {1}.")
-                .str(),
+                "the game's minimum supported header version of {1}."),
             plugin.GetHeaderVersion().value(),
             settings_.MinimumHeaderVersion())));
   }
@@ -735,36 +1172,36 @@ std::vector<SourcedMessage> Game::CheckInstallValidity(
       messages.push_back(CreatePlainTextSourcedMessage(
           MessageType::error,
           MessageSource::selfMaster,
-          boost::locale::translate("This plugin has itself as a master.")));
+          TranslateCached("This plugin has itself as a master.")));
       break;
     }
   }
 
   if (metadata.GetGroup().has_value()) {
     auto groupName = metadata.GetGroup().value();
-    auto groups = gameHandle_->GetDatabase().GetGroups();
-    const auto groupIsUndefined =
-        std::none_of(groups.cbegin(), groups.cend(), [&](const Group& group) {
-          return group.GetName() == groupName;
-        });
 
-    if (groupIsUndefined) {
+    if (!GetGroupGraph()->IsDefined(groupName)) {
       messages.push_back(CreatePlainTextSourcedMessage(
           MessageType::error,
           MessageSource::missingGroup,
           fmt::format(
-              boost::locale::translate("This plugin belongs to the group "
-                                       "\"{0}\", which does not exist.")
-                  .str(),
+              TranslateCached("This plugin belongs to the group "
+                              "\"{0}\", which does not exist."),
               groupName)));
     }
   }
 
   const auto lootTags = metadata.GetTags();
-  if (!lootTags.empty()) {
-    const auto bashTagFileTags =
-        ReadBashTagsFile(settings_.DataPath(), metadata.GetName());
-    const auto conflictingTags = GetTagConflicts(lootTags, bashTagFileTags);
+  const auto bashTagsFilePath =
+      lootTags.empty()
+          ? std::nullopt
+          : GetDataPathsSnapshot()->FindBashTagsFile(metadata.GetName());
+  if (bashTagsFilePath.has_value()) {
+    std::ifstream in(bashTagsFilePath.value());
+    const auto bashTagFileTags = ReadBashTagsFileTagSet(in);
+
+    const auto conflictingTags =
+        TagSet(lootTags).GetConflicts(bashTagFileTags);
     if (!conflictingTags.empty()) {
       const auto commaSeparatedTags = boost::join(conflictingTags, ", ");
       if (logger) {
@@ -778,10 +1215,9 @@ std::vector<SourcedMessage> Game::CheckInstallValidity(
           MessageType::say,
           MessageSource::bashTagsOverride,
           fmt::format(
-              boost::locale::translate(
+              TranslateCached(
                   "This plugin has a BashTags file that will override the "
-                  "suggestions made by LOOT for the following Bash Tags: {0}.")
-                  .str(),
+                  "suggestions made by LOOT for the following Bash Tags: {0}."),
               commaSeparatedTags)));
     }
   }
@@ -794,59 +1230,109 @@ std::vector<SourcedMessage> Game::CheckInstallValidity(
   return messages;
 }
 
-void Game::RedatePlugins() {
-  auto logger = getLogger();
+void Game::RedatePlugins() { ApplyPluginRedates(GetPluginRedates()); }
+
+std::vector<PluginRedate> Game::GetPluginRedates() const {
+  ScopedTimer timer("Game::GetPluginRedates");
+
+  auto logger = getLogger(LogCategory::loading);
 
   if (!ShouldAllowRedating(settings_.Type())) {
     if (logger) {
       logger->warn("Cannot redate plugins for game {}.", settings_.Name());
     }
-    return;
+    return {};
   }
 
   static constexpr std::chrono::seconds REDATE_TIMESTAMP_INTERVAL =
       std::chrono::seconds(60);
 
-  const auto loadorder = gameHandle_->GetLoadOrder();
-  if (!loadorder.empty()) {
-    std::filesystem::file_time_type lastTime =
-        std::filesystem::file_time_type::clock::time_point::min();
-    for (const auto& pluginName : loadorder) {
-      auto filepath = ResolveGameFilePath(pluginName);
-      if (!fs::exists(filepath)) {
-        filepath += GHOST_EXTENSION;
-        if (!fs::exists(filepath)) {
-          continue;
-        }
-      }
+  const auto loadOrder = gameHandle_->GetLoadOrder();
+
+  // Stat the plugins concurrently, as each one can involve several
+  // filesystem calls, which are slow on HDDs when there are many plugins.
+  std::vector<std::optional<PluginRedate>> pluginTimes(loadOrder.size());
+  parallelTransform(loadOrder.begin(),
+                    loadOrder.end(),
+                    pluginTimes.begin(),
+                    [this](const std::string& pluginName)
+                        -> std::optional<PluginRedate> {
+                      std::error_code ec;
+                      auto filepath = ResolveGameFilePath(pluginName);
+                      if (!fs::exists(filepath, ec)) {
+                        filepath += GHOST_EXTENSION;
+                        if (!fs::exists(filepath, ec)) {
+                          return std::nullopt;
+                        }
+                      }
+
+                      const auto time = fs::last_write_time(filepath, ec);
+                      if (ec) {
+                        return std::nullopt;
+                      }
+
+                      return PluginRedate{filepath, time};
+                    });
+
+  std::vector<PluginRedate> redates;
+  std::filesystem::file_time_type lastTime =
+      std::filesystem::file_time_type::clock::time_point::min();
+  for (const auto& pluginTime : pluginTimes) {
+    if (!pluginTime.has_value()) {
+      continue;
+    }
 
-      const auto thisTime = fs::last_write_time(filepath);
-      if (thisTime >= lastTime) {
-        lastTime = thisTime;
+    const auto& [filepath, thisTime] = pluginTime.value();
+    if (thisTime >= lastTime) {
+      lastTime = thisTime;
 
-        if (logger) {
-          logger->trace("No need to redate \"{}\".",
-                        filepath.filename().u8string());
-        }
-      } else {
-        lastTime += REDATE_TIMESTAMP_INTERVAL;
-        fs::last_write_time(filepath,
-                            lastTime);  // Space timestamps by a minute.
+      LOOT_LOG_TRACE(LogCategory::loading,
+                     "No need to redate \"{}\".",
+                     filepath.filename().u8string());
+    } else {
+      // Space timestamps by a minute.
+      lastTime += REDATE_TIMESTAMP_INTERVAL;
+      redates.push_back(PluginRedate{filepath, lastTime});
+    }
+  }
 
-        if (logger) {
-          logger->info("Redated \"{}\"", filepath.filename().u8string());
-        }
-      }
+  return redates;
+}
+
+void Game::ApplyPluginRedates(const std::vector<PluginRedate>& redates) {
+  ScopedTimer timer("Game::ApplyPluginRedates");
+
+  // Record errors instead of throwing them so that they're reported in
+  // load order.
+  std::vector<std::error_code> errors(redates.size());
+  parallelTransform(redates.begin(),
+                    redates.end(),
+                    errors.begin(),
+                    [](const PluginRedate& redate) {
+                      std::error_code ec;
+                      fs::last_write_time(redate.path, redate.newTime, ec);
+                      return ec;
+                    });
+
+  auto logger = getLogger(LogCategory::loading);
+  for (size_t i = 0; i < redates.size(); i += 1) {
+    if (errors[i]) {
+      throw fs::filesystem_error(
+          "Failed to redate plugin", redates[i].path, errors[i]);
+    }
+
+    if (logger) {
+      logger->info("Redated \"{}\"", redates[i].path.filename().u8string());
     }
   }
 }
 
 void Game::LoadCreationClubPluginNames() {
-  const auto logger = getLogger();
-
-  creationClubPlugins_.clear();
+  const auto logger = getLogger(LogCategory::loading);
 
   if (!HadCreationClub()) {
+    creationClubPlugins_.clear();
+    cccFileStamp_.reset();
     logger->debug(
         "The current game was not part of the Creation Club while it was "
         "active, skipping loading Creation Club plugin names.");
@@ -856,6 +1342,8 @@ void Game::LoadCreationClubPluginNames() {
   const auto cccFilename = GetCCCFilename(settings_.Type());
 
   if (!cccFilename.has_value()) {
+    creationClubPlugins_.clear();
+    cccFileStamp_.reset();
     if (logger) {
       logger->debug(
           "The current game does not have a CCC file, the Creation Club filter "
@@ -864,35 +1352,58 @@ void Game::LoadCreationClubPluginNames() {
     return;
   }
 
-  const auto cccFilePath = settings_.GamePath() / cccFilename.value();
+  CCCFileStamp stamp;
+  stamp.path = settings_.GamePath() / cccFilename.value();
+
+  // Getting the size fails if the file doesn't exist, so there's no need to
+  // check that separately.
+  std::error_code ec;
+  stamp.size = fs::file_size(stamp.path, ec);
+  if (!ec) {
+    stamp.writeTime = fs::last_write_time(stamp.path, ec);
+  }
 
-  if (!fs::exists(cccFilePath)) {
+  if (ec) {
+    creationClubPlugins_.clear();
+    cccFileStamp_.reset();
     if (logger) {
       logger->debug(
           "The CCC file at {} does not exist, the Creation Club filter "
           "will have no effect.",
-          cccFilePath.u8string());
+          stamp.path.u8string());
     }
     return;
   }
 
-  std::ifstream in(cccFilePath);
+  if (cccFileStamp_ == stamp) {
+    if (logger) {
+      logger->debug(
+          "The CCC file at {} is unchanged, skipping reloading Creation Club "
+          "plugin names.",
+          stamp.path.u8string());
+    }
+    return;
+  }
+
+  creationClubPlugins_.clear();
+
+  std::ifstream in(stamp.path);
 
-  std::vector<std::string> lines;
   for (std::string line; std::getline(in, line);) {
     if (!line.empty()) {
       if (line.back() == '\r') {
         line.pop_back();
       }
-      creationClubPlugins_.insert(Filename(line));
-      lines.push_back(line);
+      creationClubPlugins_.insert(NormalisePluginName(line));
     }
   }
 
+  cccFileStamp_ = stamp;
+
   if (logger) {
     logger->debug(
         "The following plugins will be hidden by the Creation Club filter: {}",
-        lines);
+        creationClubPlugins_);
   }
 }
 
@@ -902,12 +1413,26 @@ bool Game::HadCreationClub() const {
   return settings_.Id() == GameId::tes5se || settings_.Id() == GameId::fo4;
 }
 
-void Game::LoadAllInstalledPlugins(bool headersOnly) {
+void Game::LoadCurrentLoadOrderState() {
+  auto logger = getLogger(LogCategory::loading);
+
+  const auto filesHash = GetLoadOrderFilesHash();
+  if (loadOrderFilesHash_ == filesHash) {
+    if (logger) {
+      logger->debug(
+          "The load order files are unchanged, skipping reloading the current "
+          "load order.");
+    }
+    return;
+  }
+
   try {
     LogLoadOrderPaths(*this);
     gameHandle_->LoadCurrentLoadOrderState();
+    ClearActivePluginsCache();
+    loadOrderFilesHash_ = filesHash;
   } catch (const std::exception& e) {
-    auto logger = getLogger();
+    loadOrderFilesHash_.reset();
     if (logger) {
       logger->error("Failed to load current load order. Details: {}", e.what());
     }
@@ -918,9 +1443,42 @@ void Game::LoadAllInstalledPlugins(bool headersOnly) {
                                  "information displayed may be incorrect.")
             .str()));
   }
+}
+
+void Game::LoadAllInstalledPlugins(
+    bool headersOnly,
+    const CancellationToken* cancellationToken) {
+  const auto stageName = headersOnly
+                             ? "Game::LoadAllInstalledPlugins (headers)"
+                             : "Game::LoadAllInstalledPlugins";
+  ScopedTimer timer(stageName);
+  ScopedMemoryMeter memoryMeter(stageName);
+
+  LoadCurrentLoadOrderState();
 
   const auto installedPluginPaths = GetInstalledPluginPaths();
+
+  if (cancellationToken != nullptr) {
+    cancellationToken->throwIfCancelled();
+  }
+
   gameHandle_->LoadPlugins(installedPluginPaths, headersOnly);
+  ClearActivePluginsCache();
+
+  pluginCrcs_.clear();
+  UpdatePluginCrcs(installedPluginPaths);
+
+  try {
+    SavePluginFileCache(PluginFileCachePath(), pluginFileCache_);
+  } catch (const std::exception& e) {
+    auto logger = getLogger(LogCategory::loading);
+    if (logger) {
+      logger->warn("Failed to save the plugin file cache. Details: {}",
+                   e.what());
+    }
+  }
+
+  ClearDataPathsSnapshot();
 
   // Check if any plugins have been removed.
   std::vector<std::string> loadedPluginNames;
@@ -936,108 +1494,409 @@ void Game::LoadAllInstalledPlugins(bool headersOnly) {
   supportsLightPlugins_ = loot::SupportsLightPlugins(*this);
 }
 
-bool Game::ArePluginsFullyLoaded() const { return pluginsFullyLoaded_; }
+bool Game::ReloadPlugins(const std::vector<std::string>& pluginNames,
+                         bool headersOnly) {
+  const auto logger = getLogger(LogCategory::loading);
 
-bool Game::SupportsLightPlugins() const { return supportsLightPlugins_; }
+  // The plugins have changed on disk since the data paths snapshot may have
+  // been taken, so resolve their paths using a new snapshot.
+  ClearDataPathsSnapshot();
 
-bool Game::SupportsMediumPlugins() const {
-  return settings_.Id() == GameId::starfield;
-}
+  std::vector<std::filesystem::path> pluginPaths;
+  for (const auto& pluginName : pluginNames) {
+    auto pluginPath = ResolveGameFilePath(pluginName);
+    if (!std::filesystem::exists(pluginPath)) {
+      pluginPath += GHOST_EXTENSION;
+    }
 
-fs::path Game::MasterlistPath() const {
-  return GetMasterlistPath(lootDataPath_, settings_);
-}
+    bool isValid = false;
+    try {
+      isValid = std::filesystem::exists(pluginPath) &&
+                gameHandle_->IsValidPlugin(pluginPath);
+    } catch (const std::exception& e) {
+      if (logger) {
+        logger->warn("Failed to check if {} is a valid plugin. Details: {}",
+                     pluginPath.u8string(),
+                     e.what());
+      }
+    }
 
-std::filesystem::path Game::GetActivePluginsFilePath() const {
-  return gameHandle_->GetActivePluginsFilePath();
-}
+    if (!isValid) {
+      if (logger) {
+        logger->debug("Could not reload {} as it is not a valid plugin",
+                      pluginName);
+      }
+      return false;
+    }
 
-fs::path Game::UserlistPath() const {
-  return GetLOOTGamePath() / "userlist.yaml";
-}
+    pluginPaths.push_back(pluginPath);
+  }
 
-fs::path Game::GroupNodePositionsPath() const {
-  return GetLOOTGamePath() / "group_node_positions.bin";
-}
+  if (logger) {
+    logger->debug("Reloading plugins: {}", pluginNames);
+  }
 
-std::vector<std::string> Game::GetLoadOrder() const {
-  return gameHandle_->GetLoadOrder();
-}
+  gameHandle_->LoadPlugins(pluginPaths, headersOnly);
+  ClearActivePluginsCache();
 
-void Game::SetLoadOrder(const std::vector<std::string>& loadOrder) {
-  BackupLoadOrder(GetLoadOrder(), GetLOOTGamePath());
-  gameHandle_->SetLoadOrder(loadOrder);
-}
+  UpdatePluginCrcs(pluginPaths);
 
-bool Game::IsPluginActive(const std::string& pluginName) const {
-  return gameHandle_->IsPluginActive(pluginName);
+  pluginsFullyLoaded_ = pluginsFullyLoaded_ && !headersOnly;
+
+  supportsLightPlugins_ = loot::SupportsLightPlugins(*this);
+
+  return true;
 }
 
-std::optional<short> Game::GetActiveLoadOrderIndex(
-    const PluginInterface& plugin,
-    const std::vector<std::string>& loadOrder) const {
-  // Get the full load order, then count the number of active plugins until the
-  // given plugin is encountered. If the plugin isn't active or in the load
-  // order, return nullopt.
+bool Game::ArePluginsFullyLoaded() const { return pluginsFullyLoaded_; }
 
-  if (!IsPluginActive(plugin.GetName())) {
-    return std::nullopt;
+bool Game::ReleasePluginRecordData() {
+  ScopedTimer timer("Game::ReleasePluginRecordData");
+
+  std::vector<std::string> pluginNames;
+  for (const auto plugin : gameHandle_->GetLoadedPlugins()) {
+    pluginNames.push_back(plugin->GetName());
   }
 
-  short numberOfActivePlugins = 0;
-  for (const std::string& otherPluginName : loadOrder) {
-    if (CompareFilenames(plugin.GetName(), otherPluginName) == 0) {
-      return numberOfActivePlugins;
+  // Reloading the plugins' headers records their CRCs from the plugin file
+  // cache, which loading them fully updated.
+  if (!ReloadPlugins(pluginNames, true)) {
+    auto logger = getLogger(LogCategory::loading);
+    if (logger) {
+      logger->warn(
+          "Failed to release plugin record data, the plugins will stay fully "
+          "loaded.");
     }
+    return false;
+  }
 
-    auto otherPlugin = GetPlugin(otherPluginName);
-    if (otherPlugin && plugin.IsLightPlugin() == otherPlugin->IsLightPlugin() &&
-        plugin.IsMediumPlugin() == otherPlugin->IsMediumPlugin() &&
-        IsPluginActive(otherPluginName)) {
-      ++numberOfActivePlugins;
-    }
+  return true;
+}
+
+std::optional<uint32_t> Game::GetPluginCrc(
+    const PluginInterface& plugin) const {
+  const auto crc = plugin.GetCRC();
+  if (crc.has_value()) {
+    return crc;
+  }
+
+  const auto it = pluginCrcs_.find(Filename(plugin.GetName()));
+  if (it == pluginCrcs_.end()) {
+    return std::nullopt;
   }
 
-  return std::nullopt;
+  return it->second;
 }
 
-bool Game::IsLoadOrderAmbiguous() const {
-  return gameHandle_->IsLoadOrderAmbiguous();
+bool Game::SupportsLightPlugins() const { return supportsLightPlugins_; }
+
+bool Game::SupportsMediumPlugins() const {
+  return settings_.Id() == GameId::starfield;
 }
 
-std::vector<std::string> Game::SortPlugins() {
-  auto logger = getLogger();
+void Game::UpdateRecordOverlapIndex() {
+  LOOT_LOG_TRACE(LogCategory::loading, "Updating the record overlap index.");
+
+  // Update a copy so that the index can still be read while the plugins are
+  // being compared.
+  RecordOverlapIndex index;
+  {
+    std::lock_guard<std::mutex> guard(recordOverlapIndexMutex_);
+    index = recordOverlapIndex_;
+  }
+
+  index.Update(GetPlugins());
+
+  SetRecordOverlapIndex(std::move(index));
+}
+
+void Game::AddToRecordOverlapIndex(
+    const std::string& pluginName,
+    const std::vector<std::string>& overlappingPluginNames) {
+  const auto plugin = GetPlugin(pluginName);
+  if (!plugin) {
+    return;
+  }
+
+  RecordOverlapIndex index;
+  {
+    std::lock_guard<std::mutex> guard(recordOverlapIndexMutex_);
+    index = recordOverlapIndex_;
+  }
+
+  index.AddPlugin(GetPlugins(), *plugin, overlappingPluginNames);
+
+  SetRecordOverlapIndex(std::move(index));
+}
 
+std::optional<bool> Game::DoIndexedRecordsOverlap(
+    const std::string& pluginName1,
+    uint32_t crc1,
+    const std::string& pluginName2,
+    uint32_t crc2) const {
+  std::lock_guard<std::mutex> guard(recordOverlapIndexMutex_);
+
+  return recordOverlapIndex_.DoRecordsOverlap(
+      pluginName1, crc1, pluginName2, crc2);
+}
+
+std::unordered_map<std::string, OverlapCount> Game::GetRecordOverlapCounts()
+    const {
+  std::lock_guard<std::mutex> guard(recordOverlapIndexMutex_);
+
+  return recordOverlapIndex_.GetOverlapCounts();
+}
+
+void Game::SetRecordOverlapIndex(RecordOverlapIndex&& index) {
   try {
-    LogLoadOrderPaths(*this);
-    gameHandle_->LoadCurrentLoadOrderState();
+    SaveRecordOverlapIndex(RecordOverlapIndexPath(), index);
   } catch (const std::exception& e) {
+    const auto logger = getLogger(LogCategory::loading);
     if (logger) {
-      logger->error("Failed to load current load order. Details: {}", e.what());
+      logger->warn("Failed to save the record overlap index. Details: {}",
+                   e.what());
     }
-    AppendMessage(CreatePlainTextSourcedMessage(
-        MessageType::error,
-        MessageSource::caughtException,
-        boost::locale::translate("Failed to load the current load order, "
-                                 "information displayed may be incorrect.")
-            .str()));
   }
 
+  std::lock_guard<std::mutex> guard(recordOverlapIndexMutex_);
+  recordOverlapIndex_ = std::move(index);
+}
+
+fs::path Game::MasterlistPath() const {
+  return GetMasterlistPath(lootDataPath_, settings_);
+}
+
+std::filesystem::path Game::GetActivePluginsFilePath() const {
+  return gameHandle_->GetActivePluginsFilePath();
+}
+
+const std::vector<std::filesystem::path>& Game::ExternalDataPaths() const {
+  return externalDataPaths_;
+}
+
+fs::path Game::UserlistPath() const {
+  return GetLOOTGamePath() / "userlist.yaml";
+}
+
+fs::path Game::GroupNodePositionsPath() const {
+  return GetLOOTGamePath() / "group_node_positions.bin";
+}
+
+fs::path Game::GroupLayoutCachePath() const {
+  return GetLOOTGamePath() / "group_layout_cache.bin";
+}
+
+fs::path Game::PluginFileCachePath() const {
+  return GetLOOTGamePath() / "plugin_file_cache.bin";
+}
+
+fs::path Game::RecordOverlapIndexPath() const {
+  return GetLOOTGamePath() / "record_overlap_index.bin";
+}
+
+fs::path Game::SortResultCachePath() const {
+  return GetLOOTGamePath() / "sort_result_cache.bin";
+}
+
+fs::path Game::PluginItemsSnapshotPath() const {
+  return GetLOOTGamePath() / "plugin_items_snapshot.bin";
+}
+
+std::vector<std::string> Game::GetLoadOrder() const {
+  return gameHandle_->GetLoadOrder();
+}
+
+void Game::SetLoadOrder(const std::vector<std::string>& loadOrder) {
+  BackupLoadOrder(GetLoadOrder(), GetLOOTGamePath(), &loadOrderJournalState_);
+  gameHandle_->SetLoadOrder(loadOrder);
+  ClearActivePluginsCache();
+}
+
+bool Game::IsPluginActive(const std::string& pluginName) const {
+  return gameHandle_->IsPluginActive(pluginName);
+}
+
+std::shared_ptr<const ActivePluginsSnapshot> Game::GetActivePluginsSnapshot()
+    const {
+  std::lock_guard<std::mutex> guard(activePluginsMutex_);
+
+  return GetActivePluginsSnapshotLocked();
+}
+
+std::shared_ptr<const ActivePluginsSnapshot>
+Game::GetActivePluginsSnapshotLocked() const {
+  if (!activePluginsSnapshot_) {
+    std::vector<std::string> activePluginNames;
+    for (const auto& pluginName : gameHandle_->GetLoadOrder()) {
+      if (gameHandle_->IsPluginActive(pluginName)) {
+        activePluginNames.push_back(pluginName);
+      }
+    }
+
+    activePluginsSnapshot_ =
+        std::make_shared<const ActivePluginsSnapshot>(activePluginNames);
+  }
+
+  return activePluginsSnapshot_;
+}
+
+std::shared_ptr<const PluginDependentsIndex> Game::GetPluginDependentsIndex()
+    const {
+  std::lock_guard<std::mutex> guard(activePluginsMutex_);
+
+  if (!pluginDependentsIndex_) {
+    auto index = std::make_shared<PluginDependentsIndex>();
+
+    for (const auto plugin : gameHandle_->GetLoadedPlugins()) {
+      auto dependencyNames = plugin->GetMasters();
+
+      const auto metadata = gameHandle_->GetDatabase().GetPluginMetadata(
+          plugin->GetName(), true, false);
+      if (metadata.has_value()) {
+        for (const auto& requirement : metadata.value().GetRequirements()) {
+          dependencyNames.push_back(std::string(requirement.GetName()));
+        }
+      }
+
+      index->AddDependencies(plugin->GetName(), dependencyNames);
+    }
+
+    pluginDependentsIndex_ = std::move(index);
+  }
+
+  return pluginDependentsIndex_;
+}
+
+std::optional<short> Game::GetActiveLoadOrderIndex(
+    const PluginInterface& plugin) const {
+  std::lock_guard<std::mutex> guard(activePluginsMutex_);
+
+  if (!activeLoadOrderIndices_.has_value()) {
+    // Light, medium and full plugins are indexed separately.
+    short numberOfActiveLightPlugins = 0;
+    short numberOfActiveMediumPlugins = 0;
+    short numberOfActiveFullPlugins = 0;
+
+    std::unordered_map<std::string, short> indices;
+    for (const auto& pluginName : gameHandle_->GetLoadOrder()) {
+      const auto otherPlugin = gameHandle_->GetPlugin(pluginName);
+      if (!otherPlugin || !gameHandle_->IsPluginActive(pluginName)) {
+        continue;
+      }
+
+      auto& numberOfActivePlugins =
+          otherPlugin->IsLightPlugin()    ? numberOfActiveLightPlugins
+          : otherPlugin->IsMediumPlugin() ? numberOfActiveMediumPlugins
+                                          : numberOfActiveFullPlugins;
+
+      indices.emplace(NormalisePluginName(pluginName),
+                      numberOfActivePlugins);
+      ++numberOfActivePlugins;
+    }
+
+    activeLoadOrderIndices_ = std::move(indices);
+  }
+
+  const auto it = activeLoadOrderIndices_.value().find(
+      NormalisePluginName(plugin.GetName()));
+  if (it == activeLoadOrderIndices_.value().end()) {
+    return std::nullopt;
+  }
+
+  return it->second;
+}
+
+bool Game::IsLoadOrderAmbiguous() const {
+  std::lock_guard<std::mutex> guard(activePluginsMutex_);
+
+  if (!isLoadOrderAmbiguous_.has_value()) {
+    isLoadOrderAmbiguous_ = gameHandle_->IsLoadOrderAmbiguous();
+  }
+
+  return isLoadOrderAmbiguous_.value();
+}
+
+std::vector<std::string> Game::SortPlugins() {
+  ScopedTimer timer("Game::SortPlugins");
+
+  auto logger = getLogger(LogCategory::loading);
+
+  LoadCurrentLoadOrderState();
+
   std::vector<std::string> sortedPlugins;
   try {
     // Clear any existing game-specific messages, as these only relate to
     // state that has been changed by sorting.
     ClearMessages();
 
+    ClearDataPathsSnapshot();
+
+    const auto loadOrder = gameHandle_->GetLoadOrder();
+
     std::vector<std::filesystem::path> pluginPaths;
-    for (const auto& pluginName : gameHandle_->GetLoadOrder()) {
+    for (const auto& pluginName : loadOrder) {
       pluginPaths.push_back(ResolveGameFilePath(pluginName));
     }
 
-    sortedPlugins = gameHandle_->SortPlugins(pluginPaths);
+    // Unsaved user metadata isn't reflected in the userlist file, so it
+    // can't be fingerprinted.
+    std::optional<uint64_t> inputsHash;
+    if (!hasUnsavedUserMetadata_) {
+      inputsHash = GetSortInputsHash(
+          *gameHandle_, loadOrder, GetSortInputFilesHash());
+    }
+
+    std::lock_guard<std::mutex> guard(sortResultMutex_);
+    if (inputsHash.has_value() && cachedSortResult_.has_value() &&
+        cachedSortResult_.value().inputsHash == inputsHash.value()) {
+      if (logger) {
+        logger->info(
+            "The inputs to sorting are unchanged, reusing the last sort "
+            "result.");
+      }
+
+      // Sorting fully loads the plugins, so do the same when skipping it so
+      // that the resulting state doesn't depend on whether it was skipped.
+      const auto isFullyLoaded = [this](const std::string& pluginName) {
+        const auto plugin = gameHandle_->GetPlugin(pluginName);
+        return plugin != nullptr && plugin->GetCRC().has_value();
+      };
+      if (!std::all_of(loadOrder.begin(), loadOrder.end(), isFullyLoaded)) {
+        gameHandle_->LoadPlugins(pluginPaths, false);
+      }
+      ClearActivePluginsCache();
+
+      sortedPlugins = cachedSortResult_.value().sortedPlugins;
+    } else {
+      sortedPlugins = gameHandle_->SortPlugins(pluginPaths);
+
+      if (inputsHash.has_value()) {
+        cachedSortResult_ = CachedSortResult{inputsHash.value(), sortedPlugins};
+
+        try {
+          SaveCachedSortResult(SortResultCachePath(),
+                               cachedSortResult_.value());
+        } catch (const std::exception& e) {
+          if (logger) {
+            logger->warn("Failed to save the sort result. Details: {}",
+                         e.what());
+          }
+        }
+      }
+    }
 
     AppendMessages(CheckForRemovedPlugins(pluginPaths, sortedPlugins));
 
+    const std::function<std::pair<std::string, std::optional<short>>(
+        const PluginInterface* const, std::optional<short>, bool)>
+        mapper = [](const PluginInterface* const plugin,
+                    std::optional<short> loadOrderIndex,
+                    bool) {
+          return std::make_pair(plugin->GetName(), loadOrderIndex);
+        };
+    preSortLoadOrder_ = std::make_shared<const LoadOrderIndices>(
+        MapFromLoadOrderData(*this, loadOrder, mapper));
+
     IncrementLoadOrderSortCount();
   } catch (CyclicInteractionError& e) {
     if (logger) {
@@ -1075,63 +1934,913 @@ std::vector<std::string> Game::SortPlugins() {
   return sortedPlugins;
 }
 
+std::shared_ptr<const Game::LoadOrderIndices> Game::GetPreSortLoadOrder() {
+  std::lock_guard<std::mutex> guard(sortResultMutex_);
+
+  return preSortLoadOrder_;
+}
+
+void Game::PrecomputeSortResult() {
+  ScopedTimer timer("Game::PrecomputeSortResult");
+
+  const auto logger = getLogger(LogCategory::loading);
+
+  try {
+    // Hash the files before they're read so that any changes made to them
+    // while sorting can be detected.
+    const auto filesHash = GetSortInputFilesHash();
+
+    auto handle = CreateGameHandle(
+        settings_.Type(), settings_.GamePath(), settings_.GameLocalPath());
+    handle->IdentifyMainMasterFile(settings_.Master());
+    handle->GetDatabase().LoadLists(ExistingPathOrEmpty(MasterlistPath()),
+                                    ExistingPathOrEmpty(UserlistPath()),
+                                    ExistingPathOrEmpty(preludePath_));
+    handle->LoadCurrentLoadOrderState();
+
+    const auto loadOrder = handle->GetLoadOrder();
+
+    std::vector<std::filesystem::path> pluginPaths;
+    for (const auto& pluginName : loadOrder) {
+      pluginPaths.push_back(ResolveGameFilePath(pluginName));
+    }
+
+    const auto inputsHash = GetSortInputsHash(*handle, loadOrder, filesHash);
+
+    {
+      std::lock_guard<std::mutex> guard(sortResultMutex_);
+      if (cachedSortResult_.has_value() &&
+          cachedSortResult_.value().inputsHash == inputsHash) {
+        return;
+      }
+    }
+
+    const auto sortedPlugins = handle->SortPlugins(pluginPaths);
+
+    if (GetSortInputFilesHash() != filesHash) {
+      if (logger) {
+        logger->debug(
+            "The inputs to sorting changed while precomputing the sort "
+            "result, so it has been discarded.");
+      }
+      return;
+    }
+
+    std::lock_guard<std::mutex> guard(sortResultMutex_);
+    cachedSortResult_ = CachedSortResult{inputsHash, sortedPlugins};
+
+    try {
+      SaveCachedSortResult(SortResultCachePath(), cachedSortResult_.value());
+    } catch (const std::exception& e) {
+      if (logger) {
+        logger->warn("Failed to save the sort result. Details: {}", e.what());
+      }
+    }
+  } catch (const std::exception& e) {
+    if (logger) {
+      logger->warn("Failed to precompute the sort result. Details: {}",
+                   e.what());
+    }
+  }
+}
+
+uint64_t Game::GetSortInputFilesHash() const {
+  ScopedTimer timer("Game::GetSortInputFilesHash");
+
+  SortInputsHasher hasher;
+
+  AddDirectoryListing(hasher, settings_.GamePath());
+  AddDirectoryListing(hasher, settings_.DataPath());
+  for (const auto& dataPath : externalDataPaths_) {
+    AddDirectoryListing(hasher, dataPath);
+  }
+
+  // Conditions can also check files in subdirectories, so list the
+  // subdirectories that they reference too. Which subdirectories are listed
+  // only depends on the metadata files' content, which is also hashed.
+  std::set<std::string> subdirectories;
+  for (const auto& path : {MasterlistPath(), UserlistPath(), preludePath_}) {
+    const auto content = AddFileContent(hasher, path);
+    subdirectories.merge(GetConditionSubdirectories(content));
+  }
+
+  for (const auto& subdirectory : subdirectories) {
+    const auto relativePath = fs::u8path(subdirectory);
+    AddDirectoryListing(
+        hasher, (settings_.DataPath() / relativePath).lexically_normal());
+    for (const auto& dataPath : externalDataPaths_) {
+      AddDirectoryListing(hasher, (dataPath / relativePath).lexically_normal());
+    }
+  }
+
+  return hasher.GetHash();
+}
+
+uint64_t Game::GetEvaluationStateHash() const {
+  ScopedTimer timer("Game::GetEvaluationStateHash");
+
+  const auto activePlugins = GetActivePluginsSnapshot();
+
+  // Sort the plugins by name so that the hash doesn't depend on their load
+  // order, which conditions and validity checks don't use.
+  std::vector<std::string> pluginStates;
+  for (const auto plugin : GetPlugins()) {
+    auto state = NormalisePluginName(plugin->GetName());
+    state += activePlugins->IsActive(plugin->GetName()) ? '1' : '0';
+    state += plugin->IsMaster() ? '1' : '0';
+    state += plugin->IsLightPlugin() ? '1' : '0';
+    state += plugin->IsMediumPlugin() ? '1' : '0';
+    pluginStates.push_back(std::move(state));
+  }
+  std::sort(pluginStates.begin(), pluginStates.end());
+
+  SortInputsHasher hasher;
+  for (const auto& state : pluginStates) {
+    hasher.Add(state);
+  }
+
+  AddDirectoryListing(hasher, settings_.GamePath());
+  AddDirectoryListing(hasher, settings_.DataPath());
+  for (const auto& dataPath : externalDataPaths_) {
+    AddDirectoryListing(hasher, dataPath);
+  }
+
+  return hasher.GetHash();
+}
+
+uint64_t Game::GetMetadataListsHash() const {
+  SortInputsHasher hasher;
+
+  // The prelude is shared by all games, and games with the same masterlist
+  // source have identical masterlists, so use the shared cache to avoid
+  // reading the same unchanged content for each game.
+  auto& contentHashCache = GetSharedFileContentHashCache();
+
+  // Distinguish between a missing file and an empty file.
+  for (const auto& path : {MasterlistPath(), UserlistPath(), preludePath_}) {
+    const auto contentHash = contentHashCache.GetHash(path);
+    hasher.Add(static_cast<uint64_t>(contentHash.has_value()));
+    hasher.Add(contentHash.value_or(0));
+  }
+
+  return hasher.GetHash();
+}
+
+uint64_t Game::GetLoadOrderFilesHash() const {
+  SortInputsHasher hasher;
+
+  const auto activePluginsFilePath = gameHandle_->GetActivePluginsFilePath();
+  AddFileStamp(hasher, activePluginsFilePath);
+  AddFileStamp(hasher, activePluginsFilePath.parent_path() / "loadorder.txt");
+
+  const auto cccFilename = GetCCCFilename(settings_.Type());
+  if (cccFilename.has_value()) {
+    AddFileStamp(hasher, settings_.GamePath() / cccFilename.value());
+  }
+
+  // Installed plugins that aren't listed in the load order files are still
+  // part of the load order, and where they go depends on their headers (and
+  // their timestamps, for some games), so changes to any of the plugins
+  // also need to be detected.
+  AddDirectoryListing(hasher, settings_.DataPath());
+  for (const auto& dataPath : externalDataPaths_) {
+    AddDirectoryListing(hasher, dataPath);
+  }
+
+  return hasher.GetHash();
+}
+
+uint64_t Game::GetSortInputsHash(GameInterface& handle,
+                                 const std::vector<std::string>& loadOrder,
+                                 uint64_t filesHash) const {
+  SortInputsHasher hasher;
+
+  // A different libloot version may sort differently.
+  hasher.Add(GetLiblootVersion());
+  hasher.Add(static_cast<uint64_t>(settings_.Type()));
+  hasher.Add(filesHash);
+
+  hasher.Add(static_cast<uint64_t>(loadOrder.size()));
+  for (const auto& pluginName : loadOrder) {
+    hasher.Add(pluginName);
+    hasher.Add(static_cast<uint64_t>(handle.IsPluginActive(pluginName)));
+  }
+
+  AddGroups(hasher, handle.GetDatabase().GetGroups(false));
+  AddGroups(hasher, handle.GetDatabase().GetUserGroups());
+
+  return hasher.GetHash();
+}
+
 void Game::IncrementLoadOrderSortCount() { ++loadOrderSortCount_; }
 
-void Game::DecrementLoadOrderSortCount() {
-  if (loadOrderSortCount_ > 0) {
-    --loadOrderSortCount_;
+void Game::DecrementLoadOrderSortCount() {
+  if (loadOrderSortCount_ > 0) {
+    --loadOrderSortCount_;
+  }
+}
+
+std::vector<SourcedMessage> Game::GetMessages(
+    const std::string& language,
+    bool warnOnCaseSensitivePaths) const {
+  std::vector<SourcedMessage> output(
+      ToSourcedMessages(gameHandle_->GetDatabase().GetGeneralMessages(true),
+                        MessageSource::messageMetadata,
+                        language));
+  output.insert(end(output), begin(messages_), end(messages_));
+
+  const auto addWarning = [&output](const MessageSource source,
+                                    const std::string& text) {
+    output.push_back(
+        CreatePlainTextSourcedMessage(MessageType::warn, source, text));
+  };
+
+  if (loadOrderSortCount_ == 0) {
+    addWarning(MessageSource::unsortedLoadOrderCheck,
+               TranslateCached(
+                   "You have not sorted your load order this session."));
+  }
+
+  const auto activePluginCountMessages = GetActivePluginCountMessages();
+  output.insert(end(output),
+                begin(activePluginCountMessages),
+                end(activePluginCountMessages));
+
+  if (warnOnCaseSensitivePaths) {
+    const auto caseSensitivity = GetPathCaseSensitivity();
+
+    if (caseSensitivity.dataPath) {
+      addWarning(
+          MessageSource::caseSensitivePathCheck,
+          fmt::format(
+              boost::locale::translate(
+                  /* translators: The placeholder is for the current game's
+                     name. */
+                  "{0} is installed in a case-sensitive location. This may "
+                  "cause issues as the game, mods and LOOT may assume that "
+                  "filesystem paths are not case-sensitive, which is the "
+                  "default on Windows.")
+                  .str(),
+              GetSettings().Name()));
+    }
+
+    if (caseSensitivity.gameLocalPath) {
+      addWarning(
+          MessageSource::caseSensitivePathCheck,
+          fmt::format(
+              boost::locale::translate(
+                  /* translators: The placeholder is for the current game's
+                     name. */
+                  "{0}'s local application data is stored in a case-sensitive "
+                  "location. This may cause issues as the game, mods and LOOT "
+                  "may assume that filesystem paths are not case-sensitive, "
+                  "which is the default on Windows.")
+                  .str(),
+              GetSettings().Name()));
+    }
+  }
+
+  return output;
+}
+
+void Game::AppendMessage(const SourcedMessage& message) {
+  messages_.push_back(message);
+}
+
+void Game::ClearMessages() { messages_.clear(); }
+
+void Game::LoadMetadata() {
+  ScopedTimer timer("Game::LoadMetadata");
+  ScopedMemoryMeter memoryMeter("Game::LoadMetadata");
+
+  auto logger = getLogger(LogCategory::loading);
+
+  // Unsaved user metadata is discarded by loading the userlist, so the lists
+  // can only be left as they are if there is none.
+  const auto listsHash = GetMetadataListsHash();
+  if (!hasUnsavedUserMetadata_ && metadataListsHash_ == listsHash) {
+    if (logger) {
+      logger->debug(
+          "The metadata lists are unchanged since they were last loaded, "
+          "skipping parsing them.");
+    }
+    return;
+  }
+
+  std::filesystem::path masterlistPreludePath;
+  std::filesystem::path masterlistPath;
+  std::filesystem::path userlistPath;
+
+  if (std::filesystem::exists(preludePath_)) {
+    if (logger) {
+      logger->debug("Preparing to parse masterlist prelude.");
+    }
+    masterlistPreludePath = preludePath_;
+  }
+
+  if (std::filesystem::exists(MasterlistPath())) {
+    if (logger) {
+      logger->debug("Preparing to parse masterlist.");
+    }
+    masterlistPath = MasterlistPath();
+  }
+
+  if (std::filesystem::exists(UserlistPath())) {
+    if (logger) {
+      logger->debug("Preparing to parse userlist.");
+    }
+    userlistPath = UserlistPath();
+  }
+
+  if (logger) {
+    logger->debug("Parsing metadata list(s).");
+  }
+  try {
+    gameHandle_->GetDatabase().LoadLists(
+        masterlistPath, userlistPath, masterlistPreludePath);
+    hasUnsavedUserMetadata_ = false;
+    userlistContentHash_ = GetFileContentHash(UserlistPath());
+    metadataListsHash_ = listsHash;
+    ClearPluginDependentsIndex();
+    ClearGroupGraph();
+  } catch (const std::exception& e) {
+    metadataListsHash_.reset();
+    ClearPluginDependentsIndex();
+    ClearGroupGraph();
+    if (logger) {
+      logger->error("An error occurred while parsing the metadata list(s): {}",
+                    e.what());
+    }
+    AppendMessage(SourcedMessage{
+        MessageType::error,
+        MessageSource::caughtException,
+        fmt::format(
+            boost::locale::translate(
+                "An error occurred while parsing the metadata list(s): "
+                "{0}.\n\nTry updating your masterlist to resolve the error. If "
+                "the error is with your user metadata, this probably happened "
+                "because an update to LOOT changed its metadata syntax "
+                "support. Your user metadata will have to be updated "
+                "manually.\n\nTo do so, use 'Open LOOT Data Folder' in LOOT's "
+                "File menu to open its data folder, then open your "
+                "'userlist.yaml' file in the relevant game folder. You can "
+                "then edit the metadata it contains with reference to the "
+                "documentation, which is accessible through LOOT's main "
+                "menu.\n\nYou can also seek support on LOOT's forum thread, "
+                "which is linked to on [LOOT's "
+                "website]({1}).")
+                .str(),
+            EscapeMarkdownASCIIPunctuation(e.what()),
+            "https://loot.github.io/")});
+  }
+}
+
+std::optional<std::unordered_set<std::string>> Game::ReloadMetadata() {
+  ScopedTimer timer("Game::ReloadMetadata");
+
+  auto& database = gameHandle_->GetDatabase();
+  const auto loadOrder = GetLoadOrder();
+
+  const auto groupsHash = GetGroupsHash(database);
+  const auto metadataBefore = SerialiseUnevaluatedMetadata(database, loadOrder);
+
+  LoadMetadata();
+
+  // A plugin's card can show messages about its group, so if the groups
+  // have changed then any plugin may be affected.
+  if (GetGroupsHash(database) != groupsHash) {
+    return std::nullopt;
+  }
+
+  const auto metadataAfter = SerialiseUnevaluatedMetadata(database, loadOrder);
+
+  std::unordered_set<std::string> changedPluginNames;
+  for (size_t i = 0; i < loadOrder.size(); i += 1) {
+    if (metadataBefore.at(i) != metadataAfter.at(i)) {
+      changedPluginNames.insert(loadOrder.at(i));
+    }
+  }
+
+  auto logger = getLogger(LogCategory::loading);
+  if (logger) {
+    logger->debug("Reloading metadata changed the metadata for {} plugins.",
+                  changedPluginNames.size());
+  }
+
+  return changedPluginNames;
+}
+
+std::vector<std::string> Game::GetKnownBashTags() const {
+  return gameHandle_->GetDatabase().GetKnownBashTags();
+}
+
+std::vector<Group> Game::GetMasterlistGroups() const {
+  return GetGroupGraph()->GetMasterlistGroups();
+}
+
+std::vector<Group> Game::GetUserGroups() const {
+  return GetGroupGraph()->GetUserGroups();
+}
+
+std::shared_ptr<const GroupGraph> Game::GetGroupGraph() const {
+  std::lock_guard<std::mutex> guard(groupGraphMutex_);
+
+  if (!groupGraph_) {
+    auto& database = gameHandle_->GetDatabase();
+    groupGraph_ = std::make_shared<GroupGraph>(database.GetGroups(false),
+                                               database.GetUserGroups());
+  }
+
+  return groupGraph_;
+}
+
+std::optional<PluginMetadata> Game::GetMasterlistMetadata(
+    const std::string& pluginName,
+    bool evaluateConditions) const {
+  return gameHandle_->GetDatabase().GetPluginMetadata(
+      pluginName, false, evaluateConditions);
+}
+
+std::optional<PluginMetadata> Game::GetNonUserMetadata(
+    const PluginInterface& plugin) const {
+  auto fileBashTags = plugin.GetBashTags();
+  auto masterlistMetadata = GetMasterlistMetadata(plugin.GetName());
+
+  if (fileBashTags.empty()) {
+    return masterlistMetadata;
+  }
+
+  PluginMetadata metadata(plugin.GetName());
+  metadata.SetTags(fileBashTags);
+
+  if (masterlistMetadata.has_value()) {
+    masterlistMetadata.value().MergeMetadata(metadata);
+    return masterlistMetadata.value();
+  }
+
+  return metadata;
+}
+
+std::optional<PluginMetadata> Game::GetUserMetadata(
+    const std::string& pluginName,
+    bool evaluateConditions) const {
+  return gameHandle_->GetDatabase().GetPluginUserMetadata(pluginName,
+                                                          evaluateConditions);
+}
+
+void Game::SetUserGroups(const std::vector<Group>& groups) {
+  hasUnsavedUserMetadata_ = true;
+  gameHandle_->GetDatabase().SetUserGroups(groups);
+  ClearGroupGraph();
+}
+
+void Game::AddUserMetadata(const PluginMetadata& metadata) {
+  hasUnsavedUserMetadata_ = true;
+  gameHandle_->GetDatabase().SetPluginUserMetadata(metadata);
+  ClearPluginDependentsIndex();
+  UpdateDataSnapshotUserMetadata(metadata.GetName());
+}
+
+void Game::ClearUserMetadata(const std::string& pluginName) {
+  hasUnsavedUserMetadata_ = true;
+  gameHandle_->GetDatabase().DiscardPluginUserMetadata(pluginName);
+  ClearPluginDependentsIndex();
+  UpdateDataSnapshotUserMetadata(pluginName);
+}
+
+void Game::ClearAllUserMetadata() {
+  hasUnsavedUserMetadata_ = true;
+  gameHandle_->GetDatabase().DiscardAllUserMetadata();
+  ClearPluginDependentsIndex();
+
+  std::lock_guard<std::mutex> guard(dataSnapshotMutex_);
+  dataSnapshot_ = dataSnapshot_->WithoutUserMetadata();
+}
+
+void Game::SaveUserMetadata() {
+  // Write to a temporary file and then replace the userlist with it, so that
+  // the userlist is never left partially written.
+  auto tempPath = UserlistPath();
+  tempPath += ".tmp";
+
+  gameHandle_->GetDatabase().WriteUserMetadata(tempPath, true);
+
+  const auto contentHash = GetFileContentHash(tempPath);
+  if (contentHash.has_value() && contentHash == userlistContentHash_ &&
+      fs::exists(UserlistPath())) {
+    // Leave the userlist untouched so that its timestamp doesn't change and
+    // the game data watcher isn't triggered.
+    fs::remove(tempPath);
+  } else {
+    fs::rename(tempPath, UserlistPath());
+    userlistContentHash_ = contentHash;
+  }
+
+  hasUnsavedUserMetadata_ = false;
+}
+
+std::filesystem::path Game::GetLOOTGamePath() const {
+  return ::GetLOOTGamePath(lootDataPath_, settings_.FolderName());
+}
+
+void Game::UpdateExternalDataPaths() {
+  externalDataPaths_ = GetExternalDataPaths(settings_.Id(),
+                                            isMicrosoftStoreInstall_,
+                                            settings_.DataPath(),
+                                            settings_.GameLocalPath());
+}
+
+std::vector<std::filesystem::path> Game::GetInstalledPluginPaths() {
+  const auto logger = getLogger(LogCategory::loading);
+
+  // Checking to see if a plugin is valid is relatively slow, almost entirely
+  // due to blocking on opening the file, so instead just add all the files
+  // found to a buffer and then check if they're valid plugins in parallel.
+  std::vector<MaybePlugin> maybePlugins;
+  std::set<Filename> foundPlugins;
+  std::set<Filename> internallyFoundPlugins;
+
+  // Scan external data paths first, as the game checks them before the main
+  // data path. The directories are scanned concurrently, but their results
+  // are merged in this order so that the first plugin found with a given
+  // filename takes precedence.
+  std::vector<DirectoryScan> scans;
+  for (const auto& dataPath : externalDataPaths_) {
+    if (std::filesystem::exists(dataPath)) {
+      scans.push_back(DirectoryScan{dataPath});
+    }
+  }
+  scans.push_back(DirectoryScan{settings_.DataPath()});
+
+  parallelForEach(scans.begin(), scans.end(), ScanDirectory);
+
+  for (size_t i = 0; i < scans.size(); ++i) {
+    auto& scan = scans[i];
+    if (scan.exception != nullptr) {
+      std::rethrow_exception(scan.exception);
+    }
+
+    const auto isMainDataPath = i == scans.size() - 1;
+
+    for (auto& maybePlugin : scan.maybePlugins) {
+      const auto filename = Filename(maybePlugin.path.filename().u8string());
+      if (foundPlugins.count(filename) == 0) {
+        foundPlugins.insert(filename);
+
+        if (isMainDataPath && settings_.Id() == GameId::starfield) {
+          internallyFoundPlugins.insert(filename);
+        }
+
+        maybePlugins.push_back(std::move(maybePlugin));
+      }
+    }
+  }
+
+  if (settings_.Id() == GameId::starfield) {
+    const auto newEndIt =
+        std::remove_if(maybePlugins.begin(),
+                       maybePlugins.end(),
+                       [&](const MaybePlugin& maybePlugin) {
+                         // Starfield will only load a plugin that's present in
+                         // My Games if it's also present in the install path.
+                         const auto ignorePlugin =
+                             internallyFoundPlugins.count(Filename(
+                                 maybePlugin.path.filename().u8string())) == 0;
+                         if (ignorePlugin && logger) {
+                           logger->debug(
+                               "Ignoring plugin {} as it is not also present "
+                               "in the game install's Data folder",
+                               maybePlugin.path.u8string());
+                         }
+                         return ignorePlugin;
+                       });
+    maybePlugins.erase(newEndIt, maybePlugins.end());
+  }
+
+  // Files that haven't changed since they were last checked can reuse the
+  // cached result instead of being opened again.
+  std::vector<std::filesystem::path> uncheckedPluginPaths;
+  std::vector<MaybePlugin*> uncheckedPlugins;
+  for (auto& maybePlugin : maybePlugins) {
+    if (maybePlugin.isCacheable) {
+      const auto cachedIsValid =
+          pluginFileCache_.IsValidPlugin(maybePlugin.path,
+                                         maybePlugin.fileSize,
+                                         maybePlugin.lastWriteTime);
+      pluginFileCacheCounter.recordLookup(cachedIsValid.has_value());
+      if (cachedIsValid.has_value()) {
+        maybePlugin.isValid = cachedIsValid.value();
+        continue;
+      }
+    }
+
+    uncheckedPluginPaths.push_back(maybePlugin.path);
+    uncheckedPlugins.push_back(&maybePlugin);
+  }
+
+  ForEachFileIo(uncheckedPluginPaths, [&](size_t index) {
+    auto& maybePlugin = *uncheckedPlugins[index];
+    try {
+      maybePlugin.isValid = gameHandle_->IsValidPlugin(maybePlugin.path);
+    } catch (...) {
+      // Don't cache the result, as the error may be transient.
+      maybePlugin.isCacheable = false;
+      maybePlugin.isValid = false;
+    }
+  });
+
+  // Replace the cache so that it only holds entries for files that still
+  // exist, keeping the CRCs of files that haven't changed.
+  PluginFileCache newPluginFileCache;
+  std::vector<std::filesystem::path> installedPluginPaths;
+  for (const auto& maybePlugin : maybePlugins) {
+    if (maybePlugin.isCacheable) {
+      newPluginFileCache.SetIsValidPlugin(maybePlugin.path,
+                                          maybePlugin.fileSize,
+                                          maybePlugin.lastWriteTime,
+                                          maybePlugin.isValid);
+
+      const auto crc = pluginFileCache_.GetCrc(
+          maybePlugin.path, maybePlugin.fileSize, maybePlugin.lastWriteTime);
+      if (maybePlugin.isValid && crc.has_value()) {
+        newPluginFileCache.SetCrc(maybePlugin.path,
+                                  maybePlugin.fileSize,
+                                  maybePlugin.lastWriteTime,
+                                  crc.value());
+      }
+    }
+
+    if (maybePlugin.isValid) {
+      LOOT_LOG_DEBUG(LogCategory::loading,
+                     "Found plugin: {}",
+                     maybePlugin.path.u8string());
+      installedPluginPaths.push_back(maybePlugin.path);
+    }
+  }
+
+  pluginFileCache_ = std::move(newPluginFileCache);
+
+  return installedPluginPaths;
+}
+
+void Game::UpdatePluginCrcs(
+    const std::vector<std::filesystem::path>& pluginPaths) {
+  struct PluginCrc {
+    std::string name;
+    std::optional<uint32_t> crc;
+    std::optional<uint32_t> cachedCrc;
+    uintmax_t fileSize{0};
+    std::filesystem::file_time_type lastWriteTime;
+    bool isCacheable{false};
+  };
+
+  std::vector<PluginCrc> pluginCrcs;
+  pluginCrcs.reserve(pluginPaths.size());
+  for (const auto& pluginPath : pluginPaths) {
+    PluginCrc pluginCrc;
+    pluginCrc.name = pluginPath.filename().u8string();
+    if (boost::iends_with(pluginCrc.name, GHOST_EXTENSION)) {
+      pluginCrc.name.resize(pluginCrc.name.size() -
+                            std::char_traits<char>::length(GHOST_EXTENSION));
+    }
+
+    const auto plugin = gameHandle_->GetPlugin(pluginCrc.name);
+    if (plugin != nullptr) {
+      pluginCrc.crc = plugin->GetCRC();
+    }
+
+    pluginCrcs.push_back(std::move(pluginCrc));
+  }
+
+  // Getting file sizes and timestamps can block, so do it in parallel. CRCs
+  // that aren't known or cached aren't calculated here, as that would mean
+  // reading whole plugins during a header-only load. They're recorded the
+  // next time that the plugins are fully loaded instead.
+  ForEachFileIo(pluginPaths, [&](size_t index) {
+    auto& pluginCrc = pluginCrcs[index];
+    const auto& pluginPath = pluginPaths[index];
+
+    std::error_code ec;
+    pluginCrc.fileSize = std::filesystem::file_size(pluginPath, ec);
+    if (!ec) {
+      pluginCrc.lastWriteTime =
+          std::filesystem::last_write_time(pluginPath, ec);
+    }
+    pluginCrc.isCacheable = !ec;
+
+    if (pluginCrc.crc.has_value()) {
+      return;
+    }
+
+    if (pluginCrc.isCacheable) {
+      pluginCrc.cachedCrc = pluginFileCache_.GetCrc(
+          pluginPath, pluginCrc.fileSize, pluginCrc.lastWriteTime);
+    }
+  });
+
+  for (size_t i = 0; i < pluginCrcs.size(); ++i) {
+    const auto& pluginCrc = pluginCrcs[i];
+
+    if (pluginCrc.crc.has_value() && pluginCrc.isCacheable) {
+      pluginFileCache_.SetCrc(pluginPaths[i],
+                              pluginCrc.fileSize,
+                              pluginCrc.lastWriteTime,
+                              pluginCrc.crc.value());
+    }
+
+    const auto crc =
+        pluginCrc.crc.has_value() ? pluginCrc.crc : pluginCrc.cachedCrc;
+    if (crc.has_value()) {
+      pluginCrcs_.insert_or_assign(Filename(pluginCrc.name), crc.value());
+    } else {
+      pluginCrcs_.erase(Filename(pluginCrc.name));
+    }
+  }
+}
+
+void Game::AppendMessages(std::vector<SourcedMessage> messages) {
+  for (auto message : messages) {
+    AppendMessage(message);
+  }
+}
+
+bool Game::IsCreationClubPlugin(const std::string& name) const {
+  return creationClubPlugins_.count(NormalisePluginName(name)) != 0;
+}
+
+std::filesystem::path Game::ResolveGameFilePath(
+    const std::string& filePath) const {
+  const auto snapshotResult = GetDataPathsSnapshot()->ResolveFilePath(filePath);
+  if (snapshotResult.has_value()) {
+    return snapshotResult.value();
+  }
+
+  return loot::ResolveGameFilePath(
+      externalDataPaths_, settings_.DataPath(), filePath);
+}
+
+bool Game::FileExists(const std::string& filePath) const {
+  const auto snapshot = GetDataPathsSnapshot();
+  const auto snapshotResult = snapshot->FileExists(filePath);
+  if (snapshotResult.has_value()) {
+    return snapshotResult.value();
+  }
+
+  const auto recordedResult = snapshot->GetRecordedFileExists(filePath);
+  if (recordedResult.has_value()) {
+    return recordedResult.value();
+  }
+
+  // OK to call this for non-plugin files too.
+  auto resolvedPath = ResolveGameFilePath(filePath);
+
+  auto exists = std::filesystem::exists(resolvedPath);
+  if (!exists && HasPluginFileExtension(filePath)) {
+    resolvedPath += GHOST_EXTENSION;
+
+    exists = std::filesystem::exists(resolvedPath);
+  }
+
+  snapshot->RecordFileExists(filePath, exists);
+
+  return exists;
+}
+
+std::shared_ptr<const DataPathsSnapshot> Game::GetDataPathsSnapshot() const {
+  std::lock_guard<std::mutex> guard(dataPathsSnapshotMutex_);
+
+  if (!dataPathsSnapshot_) {
+    dataPathsSnapshot_ = std::make_shared<const DataPathsSnapshot>(
+        externalDataPaths_, settings_.DataPath());
+  }
+
+  return dataPathsSnapshot_;
+}
+
+void Game::ClearDataPathsSnapshot() {
+  std::lock_guard<std::mutex> guard(dataPathsSnapshotMutex_);
+
+  dataPathsSnapshot_.reset();
+}
+
+std::shared_ptr<const GameDataSnapshot> Game::GetDataSnapshot() const {
+  std::lock_guard<std::mutex> guard(dataSnapshotMutex_);
+
+  return dataSnapshot_;
+}
+
+void Game::PublishDataSnapshot() {
+  ScopedTimer timer("Game::PublishDataSnapshot");
+
+  const auto loadOrder = GetLoadOrder();
+  const auto activePlugins = GetActivePluginsSnapshot();
+
+  std::vector<std::shared_ptr<const GameDataSnapshot::Plugin>> plugins(
+      loadOrder.size());
+  parallelTransform(
+      loadOrder.begin(),
+      loadOrder.end(),
+      plugins.begin(),
+      [&](const std::string& pluginName) {
+        auto snapshotPlugin = std::make_shared<GameDataSnapshot::Plugin>();
+        snapshotPlugin->name = pluginName;
+        snapshotPlugin->isActive = activePlugins->IsActive(pluginName);
+
+        const auto plugin = GetPlugin(pluginName);
+        if (plugin != nullptr) {
+          snapshotPlugin->isLoaded = true;
+          snapshotPlugin->crc = GetPluginCrc(*plugin);
+          snapshotPlugin->isMaster = plugin->IsMaster();
+          snapshotPlugin->isLightPlugin = plugin->IsLightPlugin();
+          snapshotPlugin->isMediumPlugin = plugin->IsMediumPlugin();
+        }
+
+        snapshotPlugin->masterlistMetadata = GetMasterlistMetadata(pluginName);
+        snapshotPlugin->userMetadata = GetUserMetadata(pluginName);
+
+        return std::shared_ptr<const GameDataSnapshot::Plugin>(
+            std::move(snapshotPlugin));
+      });
+
+  // Build the snapshot before taking the lock, so that readers are only
+  // blocked while it's swapped in.
+  auto snapshot = std::make_shared<const GameDataSnapshot>(std::move(plugins));
+
+  std::lock_guard<std::mutex> guard(dataSnapshotMutex_);
+  dataSnapshot_ = std::move(snapshot);
+}
+
+void Game::ClearDataSnapshot() {
+  std::lock_guard<std::mutex> guard(dataSnapshotMutex_);
+
+  dataSnapshot_ = std::make_shared<const GameDataSnapshot>();
+}
+
+void Game::UpdateDataSnapshotUserMetadata(const std::string& pluginName) {
+  const auto userMetadata = GetUserMetadata(pluginName);
+
+  std::lock_guard<std::mutex> guard(dataSnapshotMutex_);
+  dataSnapshot_ = dataSnapshot_->WithUserMetadata(pluginName, userMetadata);
+}
+
+Game::ActivePluginCounts Game::GetActivePluginCounts() const {
+  std::lock_guard<std::mutex> guard(activePluginsMutex_);
+
+  if (!activePluginCounts_.has_value()) {
+    // Get the snapshot while holding the lock so that the cached counts can't
+    // be computed from a snapshot that has since been cleared.
+    const auto activePlugins = GetActivePluginsSnapshotLocked();
+
+    ActivePluginCounts counts;
+    for (const auto& plugin : GetPlugins()) {
+      if (activePlugins->IsActive(plugin->GetName())) {
+        if (plugin->IsLightPlugin()) {
+          ++counts.light;
+        } else if (plugin->IsMediumPlugin()) {
+          ++counts.medium;
+        } else {
+          ++counts.full;
+        }
+      }
+    }
+
+    activePluginCounts_ = counts;
   }
+
+  return activePluginCounts_.value();
 }
 
-std::vector<SourcedMessage> Game::GetMessages(
-    const std::string& language,
-    bool warnOnCaseSensitivePaths) const {
-  std::vector<SourcedMessage> output(
-      ToSourcedMessages(gameHandle_->GetDatabase().GetGeneralMessages(true),
-                        MessageSource::messageMetadata,
-                        language));
-  output.insert(end(output), begin(messages_), end(messages_));
+std::vector<SourcedMessage> Game::GetActivePluginCountMessages() const {
+  {
+    std::lock_guard<std::mutex> guard(activePluginsMutex_);
+    if (activePluginCountMessages_.has_value()) {
+      return activePluginCountMessages_.value();
+    }
+  }
 
-  const auto addWarning = [&output](const MessageSource source,
-                                    const std::string& text) {
-    output.push_back(
+  std::vector<SourcedMessage> messages;
+
+  const auto addWarning = [&messages](const MessageSource source,
+                                      const std::string& text) {
+    messages.push_back(
         CreatePlainTextSourcedMessage(MessageType::warn, source, text));
   };
 
-  if (loadOrderSortCount_ == 0) {
-    addWarning(MessageSource::unsortedLoadOrderCheck,
-               boost::locale::translate(
-                   "You have not sorted your load order this session."));
-  }
-
-  size_t activeFullPluginsCount = 0;
-  size_t activeLightPluginsCount = 0;
-  size_t activeMediumPluginsCount = 0;
-  for (const auto& plugin : GetPlugins()) {
-    if (IsPluginActive(plugin->GetName())) {
-      if (plugin->IsLightPlugin()) {
-        ++activeLightPluginsCount;
-      } else if (plugin->IsMediumPlugin()) {
-        ++activeMediumPluginsCount;
-      } else {
-        ++activeFullPluginsCount;
-      }
-    }
-  }
+  const auto activePluginCounts = GetActivePluginCounts();
+  const auto activeFullPluginsCount = activePluginCounts.full;
+  const auto activeLightPluginsCount = activePluginCounts.light;
+  const auto activeMediumPluginsCount = activePluginCounts.medium;
 
   static constexpr size_t MWSE_SAFE_MAX_ACTIVE_FULL_PLUGINS = 1023;
   static constexpr size_t SAFE_MAX_ACTIVE_FULL_PLUGINS = 255;
   static constexpr size_t SAFE_MAX_ACTIVE_MEDIUM_PLUGINS = 255;
   static constexpr size_t SAFE_MAX_ACTIVE_LIGHT_PLUGINS = 4096;
 
-  const auto logger = getLogger();
-  const auto isMWSEInstalled =
-      settings_.Id() == GameId::tes3 &&
-      std::filesystem::exists(settings_.GamePath() / "MWSE.dll");
+  const auto logger = getLogger(LogCategory::loading);
 
   auto safeMaxActiveFullPlugins = SAFE_MAX_ACTIVE_FULL_PLUGINS;
 
-  if (isMWSEInstalled) {
+  if (isMWSEInstalled_) {
     if (logger) {
       logger->info(
           "MWSE is installed, which raises the safe maximum number of active "
@@ -1152,24 +2861,22 @@ std::vector<SourcedMessage> Game::GetMessages(
 
     if (activeLightPluginsCount > 0 || activeMediumPluginsCount > 0) {
       addWarning(MessageSource::activePluginsCountCheck,
-                 fmt::format(boost::locale::translate(
+                 fmt::format(TranslateCached(
                                  "You have {0} active full plugins but the "
-                                 "game only supports up to {1}.")
-                                 .str(),
+                                 "game only supports up to {1}."),
                              activeFullPluginsCount,
                              safeMaxActiveFullPlugins));
     } else {
       addWarning(MessageSource::activePluginsCountCheck,
-                 fmt::format(boost::locale::translate(
+                 fmt::format(TranslateCached(
                                  "You have {0} active plugins but the "
-                                 "game only supports up to {1}.")
-                                 .str(),
+                                 "game only supports up to {1}."),
                              activeFullPluginsCount,
                              safeMaxActiveFullPlugins));
     }
   }
 
-  if (isMWSEInstalled &&
+  if (isMWSEInstalled_ &&
       activeFullPluginsCount > SAFE_MAX_ACTIVE_FULL_PLUGINS &&
       activeFullPluginsCount <= MWSE_SAFE_MAX_ACTIVE_FULL_PLUGINS) {
     if (logger) {
@@ -1182,7 +2889,7 @@ std::vector<SourcedMessage> Game::GetMessages(
     }
 
     addWarning(MessageSource::activePluginsCountCheck,
-               boost::locale::translate(
+               TranslateCached(
                    "Do not launch Morrowind without the use of MWSE or it will "
                    "cause severe damage to your game."));
   }
@@ -1206,9 +2913,8 @@ std::vector<SourcedMessage> Game::GetMessages(
 
     addWarning(
         MessageSource::activePluginsCountCheck,
-        fmt::format(boost::locale::translate("You have {0} active {1} but the "
-                                             "game only supports up to {2}.")
-                        .str(),
+        fmt::format(TranslateCached("You have {0} active {1} but the "
+                                    "game only supports up to {2}."),
                     activeLightPluginsCount,
                     lightPluginType,
                     SAFE_MAX_ACTIVE_LIGHT_PLUGINS));
@@ -1225,11 +2931,10 @@ std::vector<SourcedMessage> Game::GetMessages(
 
     addWarning(
         MessageSource::activePluginsCountCheck,
-        fmt::format(boost::locale::translate(
+        fmt::format(TranslateCached(
                         "You have a full plugin and {0} {1} sharing the FE "
                         "load order index. Deactivate a full plugin or your "
-                        "{1} to avoid potential issues.")
-                        .str(),
+                        "{1} to avoid potential issues."),
                     activeLightPluginsCount,
                     lightPluginType));
   }
@@ -1243,10 +2948,9 @@ std::vector<SourcedMessage> Game::GetMessages(
     }
 
     addWarning(MessageSource::activePluginsCountCheck,
-               fmt::format(boost::locale::translate(
+               fmt::format(TranslateCached(
                                "You have {0} active medium plugins but the "
-                               "game only supports up to {1}.")
-                               .str(),
+                               "game only supports up to {1}."),
                            activeMediumPluginsCount,
                            SAFE_MAX_ACTIVE_MEDIUM_PLUGINS));
   }
@@ -1262,28 +2966,30 @@ std::vector<SourcedMessage> Game::GetMessages(
 
     addWarning(
         MessageSource::activePluginsCountCheck,
-        boost::locale::translate(
+        TranslateCached(
             "You have a full plugin and at least one medium plugin sharing "
             "the FD load order index. Deactivate a full plugin or all your "
             "medium plugins to avoid potential issues."));
   }
 
-  if (warnOnCaseSensitivePaths &&
-      IsPathCaseSensitive(GetSettings().DataPath())) {
-    addWarning(
-        MessageSource::caseSensitivePathCheck,
-        fmt::format(
-            boost::locale::translate(
-                /* translators: The placeholder is for the current game's name.
-                 */
-                "{0} is installed in a case-sensitive location. This may "
-                "cause issues as the game, mods and LOOT may assume that "
-                "filesystem paths are not case-sensitive, which is the default "
-                "on Windows.")
-                .str(),
-            GetSettings().Name()));
+  std::lock_guard<std::mutex> guard(activePluginsMutex_);
+  activePluginCountMessages_ = messages;
+
+  return messages;
+}
+
+Game::PathCaseSensitivity Game::GetPathCaseSensitivity() const {
+  std::lock_guard<std::mutex> guard(pathCaseSensitivityMutex_);
+
+  if (pathCaseSensitivity_.has_value()) {
+    return pathCaseSensitivity_.value();
   }
 
+  const auto logger = getLogger(LogCategory::loading);
+
+  PathCaseSensitivity caseSensitivity;
+  caseSensitivity.dataPath = IsPathCaseSensitive(GetSettings().DataPath());
+
   const auto gameLocalPath = GetSettings().GameLocalPath();
   if (!gameLocalPath.empty()) {
     if (!std::filesystem::exists(gameLocalPath)) {
@@ -1300,20 +3006,7 @@ std::vector<SourcedMessage> Game::GetMessages(
       std::filesystem::create_directories(gameLocalPath);
     }
 
-    if (warnOnCaseSensitivePaths && IsPathCaseSensitive(gameLocalPath)) {
-      addWarning(
-          MessageSource::caseSensitivePathCheck,
-          fmt::format(
-              boost::locale::translate(
-                  /* translators: The placeholder is for the current game's
-                     name. */
-                  "{0}'s local application data is stored in a case-sensitive "
-                  "location. This may cause issues as the game, mods and LOOT "
-                  "may assume that filesystem paths are not case-sensitive, "
-                  "which is the default on Windows.")
-                  .str(),
-              GetSettings().Name()));
-    }
+    caseSensitivity.gameLocalPath = IsPathCaseSensitive(gameLocalPath);
   } else if (logger) {
     // This is probably fine because the path shouldn't be empty on Linux and on
     // Windows the filesystem is usually case-insensitive, but log a message
@@ -1323,284 +3016,32 @@ std::vector<SourcedMessage> Game::GetMessages(
         "checked for case-sensitivity.");
   }
 
-  return output;
-}
-
-void Game::AppendMessage(const SourcedMessage& message) {
-  messages_.push_back(message);
-}
-
-void Game::ClearMessages() { messages_.clear(); }
-
-void Game::LoadMetadata() {
-  auto logger = getLogger();
-
-  std::filesystem::path masterlistPreludePath;
-  std::filesystem::path masterlistPath;
-  std::filesystem::path userlistPath;
-
-  if (std::filesystem::exists(preludePath_)) {
-    if (logger) {
-      logger->debug("Preparing to parse masterlist prelude.");
-    }
-    masterlistPreludePath = preludePath_;
-  }
-
-  if (std::filesystem::exists(MasterlistPath())) {
-    if (logger) {
-      logger->debug("Preparing to parse masterlist.");
-    }
-    masterlistPath = MasterlistPath();
-  }
-
-  if (std::filesystem::exists(UserlistPath())) {
-    if (logger) {
-      logger->debug("Preparing to parse userlist.");
-    }
-    userlistPath = UserlistPath();
-  }
-
-  if (logger) {
-    logger->debug("Parsing metadata list(s).");
-  }
-  try {
-    gameHandle_->GetDatabase().LoadLists(
-        masterlistPath, userlistPath, masterlistPreludePath);
-  } catch (const std::exception& e) {
-    if (logger) {
-      logger->error("An error occurred while parsing the metadata list(s): {}",
-                    e.what());
-    }
-    AppendMessage(SourcedMessage{
-        MessageType::error,
-        MessageSource::caughtException,
-        fmt::format(
-            boost::locale::translate(
-                "An error occurred while parsing the metadata list(s): "
-                "{0}.\n\nTry updating your masterlist to resolve the error. If "
-                "the error is with your user metadata, this probably happened "
-                "because an update to LOOT changed its metadata syntax "
-                "support. Your user metadata will have to be updated "
-                "manually.\n\nTo do so, use 'Open LOOT Data Folder' in LOOT's "
-                "File menu to open its data folder, then open your "
-                "'userlist.yaml' file in the relevant game folder. You can "
-                "then edit the metadata it contains with reference to the "
-                "documentation, which is accessible through LOOT's main "
-                "menu.\n\nYou can also seek support on LOOT's forum thread, "
-                "which is linked to on [LOOT's "
-                "website]({1}).")
-                .str(),
-            EscapeMarkdownASCIIPunctuation(e.what()),
-            "https://loot.github.io/")});
-  }
-}
-
-std::vector<std::string> Game::GetKnownBashTags() const {
-  return gameHandle_->GetDatabase().GetKnownBashTags();
-}
-
-std::vector<Group> Game::GetMasterlistGroups() const {
-  return gameHandle_->GetDatabase().GetGroups(false);
-}
-
-std::vector<Group> Game::GetUserGroups() const {
-  return gameHandle_->GetDatabase().GetUserGroups();
-}
-
-std::optional<PluginMetadata> Game::GetMasterlistMetadata(
-    const std::string& pluginName,
-    bool evaluateConditions) const {
-  return gameHandle_->GetDatabase().GetPluginMetadata(
-      pluginName, false, evaluateConditions);
-}
-
-std::optional<PluginMetadata> Game::GetNonUserMetadata(
-    const PluginInterface& plugin) const {
-  auto fileBashTags = plugin.GetBashTags();
-  auto masterlistMetadata = GetMasterlistMetadata(plugin.GetName());
-
-  if (fileBashTags.empty()) {
-    return masterlistMetadata;
-  }
-
-  PluginMetadata metadata(plugin.GetName());
-  metadata.SetTags(fileBashTags);
-
-  if (masterlistMetadata.has_value()) {
-    masterlistMetadata.value().MergeMetadata(metadata);
-    return masterlistMetadata.value();
-  }
-
-  return metadata;
-}
-
-std::optional<PluginMetadata> Game::GetUserMetadata(
-    const std::string& pluginName,
-    bool evaluateConditions) const {
-  return gameHandle_->GetDatabase().GetPluginUserMetadata(pluginName,
-                                                          evaluateConditions);
-}
-
-void Game::SetUserGroups(const std::vector<Group>& groups) {
-  return gameHandle_->GetDatabase().SetUserGroups(groups);
-}
-
-void Game::AddUserMetadata(const PluginMetadata& metadata) {
-  gameHandle_->GetDatabase().SetPluginUserMetadata(metadata);
-}
-
-void Game::ClearUserMetadata(const std::string& pluginName) {
-  gameHandle_->GetDatabase().DiscardPluginUserMetadata(pluginName);
-}
-
-void Game::ClearAllUserMetadata() {
-  gameHandle_->GetDatabase().DiscardAllUserMetadata();
-}
-
-void Game::SaveUserMetadata() {
-  gameHandle_->GetDatabase().WriteUserMetadata(UserlistPath(), true);
-}
-
-std::filesystem::path Game::GetLOOTGamePath() const {
-  return ::GetLOOTGamePath(lootDataPath_, settings_.FolderName());
-}
-
-std::vector<std::filesystem::path> Game::GetInstalledPluginPaths() const {
-  const auto logger = getLogger();
-
-  // Checking to see if a plugin is valid is relatively slow, almost entirely
-  // due to blocking on opening the file, so instead just add all the files
-  // found to a buffer and then check if they're valid plugins in parallel.
-  std::vector<std::filesystem::path> maybePlugins;
-  std::set<Filename> foundPlugins;
-  std::set<Filename> internallyFoundPlugins;
-
-  // Scan external data paths first, as the game checks them before the main
-  // data path.
-  for (const auto& dataPath : GetExternalDataPaths(settings_.Id(),
-                                                   isMicrosoftStoreInstall_,
-                                                   settings_.DataPath(),
-                                                   settings_.GameLocalPath())) {
-    if (!std::filesystem::exists(dataPath)) {
-      continue;
-    }
-
-    if (logger) {
-      logger->trace("Scanning for plugins in {}", dataPath.u8string());
-    }
-
-    for (fs::directory_iterator it(dataPath); it != fs::directory_iterator();
-         ++it) {
-      if (fs::is_regular_file(it->status())) {
-        const auto filename = Filename(it->path().filename().u8string());
-        if (foundPlugins.count(filename) == 0) {
-          maybePlugins.push_back(it->path());
-          foundPlugins.insert(filename);
-        }
-      }
-    }
-  }
-
-  if (logger) {
-    logger->trace("Scanning for plugins in {}",
-                  settings_.DataPath().u8string());
-  }
-
-  for (fs::directory_iterator it(settings_.DataPath());
-       it != fs::directory_iterator();
-       ++it) {
-    if (fs::is_regular_file(it->status())) {
-      const auto filename = Filename(it->path().filename().u8string());
-      if (foundPlugins.count(filename) == 0) {
-        maybePlugins.push_back(it->path());
-        foundPlugins.insert(filename);
-
-        if (settings_.Id() == GameId::starfield) {
-          internallyFoundPlugins.insert(filename);
-        }
-      }
-    }
-  }
-
-  if (settings_.Id() == GameId::starfield) {
-    const auto newEndIt =
-        std::remove_if(std::execution::par_unseq,
-                       maybePlugins.begin(),
-                       maybePlugins.end(),
-                       [&](const std::filesystem::path& path) {
-                         // Starfield will only load a plugin that's present in
-                         // My Games if it's also present in the install path.
-                         const auto ignorePlugin =
-                             internallyFoundPlugins.count(
-                                 Filename(path.filename().u8string())) == 0;
-                         if (ignorePlugin && logger) {
-                           logger->debug(
-                               "Ignoring plugin {} as it is not also present "
-                               "in the game install's Data folder",
-                               path.u8string());
-                         }
-                         return ignorePlugin;
-                       });
-    maybePlugins.erase(newEndIt, maybePlugins.end());
-  }
-
-  const auto newEndIt =
-      std::remove_if(std::execution::par_unseq,
-                     maybePlugins.begin(),
-                     maybePlugins.end(),
-                     [&](const std::filesystem::path& path) {
-                       try {
-                         const auto isValid = gameHandle_->IsValidPlugin(path);
-                         if (isValid && logger) {
-                           logger->debug("Found plugin: {}", path.u8string());
-                         }
-                         return !isValid;
-                       } catch (...) {
-                         return true;
-                       }
-                     });
-  maybePlugins.erase(newEndIt, maybePlugins.end());
+  pathCaseSensitivity_ = caseSensitivity;
 
-  return maybePlugins;
+  return caseSensitivity;
 }
 
-void Game::AppendMessages(std::vector<SourcedMessage> messages) {
-  for (auto message : messages) {
-    AppendMessage(message);
-  }
-}
+void Game::ClearActivePluginsCache() {
+  std::lock_guard<std::mutex> guard(activePluginsMutex_);
 
-bool Game::IsCreationClubPlugin(const std::string& name) const {
-  return creationClubPlugins_.count(Filename(name)) != 0;
+  activePluginsSnapshot_.reset();
+  activePluginCounts_.reset();
+  activePluginCountMessages_.reset();
+  isLoadOrderAmbiguous_.reset();
+  activeLoadOrderIndices_.reset();
+  pluginDependentsIndex_.reset();
 }
 
-std::filesystem::path Game::ResolveGameFilePath(
-    const std::string& filePath) const {
-  const auto externalDataPaths =
-      GetExternalDataPaths(settings_.Id(),
-                           isMicrosoftStoreInstall_,
-                           settings_.DataPath(),
-                           settings_.GameLocalPath());
+void Game::ClearPluginDependentsIndex() {
+  std::lock_guard<std::mutex> guard(activePluginsMutex_);
 
-  return loot::ResolveGameFilePath(
-      externalDataPaths, settings_.DataPath(), filePath);
+  pluginDependentsIndex_.reset();
 }
 
-bool Game::FileExists(const std::string& filePath) const {
-  // OK to call this for non-plugin files too.
-  auto resolvedPath = ResolveGameFilePath(filePath);
-
-  if (std::filesystem::exists(resolvedPath)) {
-    return true;
-  }
-
-  if (HasPluginFileExtension(filePath)) {
-    resolvedPath += GHOST_EXTENSION;
-
-    return std::filesystem::exists(resolvedPath);
-  }
+void Game::ClearGroupGraph() {
+  std::lock_guard<std::mutex> guard(groupGraphMutex_);
 
-  return false;
+  groupGraph_.reset();
 }
 }
 }
@@ -38,12 +38,18 @@
 #endif
 #endif
 
-#include <execution>
+#include <algorithm>
 #include <filesystem>
 #include <functional>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <numeric>
 #include <optional>
+#include <ostream>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <variant>
 
 #ifdef LOOT_SHOULD_REDEFINE_EMIT
@@ -52,9 +58,22 @@
 #undef LOOT_SHOULD_REDEFINE_EMIT
 #endif
 
+#include "gui/cancellation_token.h"
 #include "gui/sourced_message.h"
+#include "gui/state/game/active_plugins_snapshot.h"
+#include "gui/state/game/data_paths_snapshot.h"
+#include "gui/state/game/game_data_snapshot.h"
 #include "gui/state/game/game_settings.h"
+#include "gui/state/game/group_graph.h"
+#include "gui/state/game/helpers.h"
+#include "gui/state/game/plugin_dependents_index.h"
+#include "gui/state/game/plugin_file_cache.h"
+#include "gui/state/game/record_overlap_index.h"
+#include "gui/state/game/sort_result_cache.h"
 #include "gui/state/logging.h"
+#include "gui/state/memory_accounting.h"
+#include "gui/state/thread_pool.h"
+#include "gui/state/timing.h"
 #include "loot/api.h"
 
 namespace loot {
@@ -65,9 +84,18 @@ std::filesystem::path GetMasterlistPath(
 void InitLootGameFolder(const std::filesystem::path& lootDataPath_,
                         const GameSettings& settings);
 
+struct PluginRedate {
+  std::filesystem::path path;
+  std::filesystem::file_time_type newTime;
+};
+
 namespace gui {
 class Game {
 public:
+  // Plugin names paired with their active load order indices, in load order.
+  typedef std::vector<std::pair<std::string, std::optional<short>>>
+      LoadOrderIndices;
+
   Game(const GameSettings& gameSettings,
        const std::filesystem::path& lootDataPath,
        const std::filesystem::path& preludePath);
@@ -83,6 +111,18 @@ public:
 
   void Init();
   bool IsInitialised() const;
+  // Discards the game's libloot game handle and all the plugins and metadata
+  // that were loaded into it, so the game must be initialised again before
+  // it can be used.
+  void Unload();
+  // Hashes the files and folders that are inputs to sorting, which covers
+  // all on-disk state that the game's loaded data is derived from.
+  uint64_t GetSortInputFilesHash() const;
+  // Hashes the state that plugins' metadata conditions and install validity
+  // checks depend on, other than the plugins' own data and metadata: which
+  // plugins are loaded, their active states and flags, and the files and
+  // folders in the game's data paths.
+  uint64_t GetEvaluationStateHash() const;
 
   const PluginInterface* GetPlugin(const std::string& name) const;
   std::vector<const PluginInterface*> GetPlugins() const;
@@ -92,47 +132,126 @@ public:
       const std::string& language) const;
 
   void RedatePlugins();  // Change timestamps to match load order (Skyrim only).
+  // Returns the plugins that need their timestamps changed to match the load
+  // order, without changing them.
+  std::vector<PluginRedate> GetPluginRedates() const;
+  void ApplyPluginRedates(const std::vector<PluginRedate>& redates);
 
   void LoadCreationClubPluginNames();
   bool HadCreationClub() const;
   bool IsCreationClubPlugin(const std::string& name) const;
 
+  void LoadCurrentLoadOrderState();
+  // Loads all installed plugins. If a cancellation token is given, it's
+  // checked before the plugins are read, which is the slowest part.
   void LoadAllInstalledPlugins(
-      bool headersOnly);  // Loads all installed plugins.
+      bool headersOnly,
+      const CancellationToken* cancellationToken = nullptr);
+  // Loads the named plugins, replacing any data that was previously loaded
+  // for them. Returns false if any of them is not an installed, valid plugin.
+  bool ReloadPlugins(const std::vector<std::string>& pluginNames,
+                     bool headersOnly);
   bool ArePluginsFullyLoaded()
       const;  // Checks if the game's plugins have already been loaded.
+  // Reloads the loaded plugins' headers only, so that the memory used by
+  // their records is freed. Plugin CRCs are still known afterwards. Returns
+  // false if the plugins could not be reloaded, in which case they stay
+  // loaded as they were.
+  bool ReleasePluginRecordData();
+  // Returns the plugin's CRC if it has been fully loaded, or otherwise the CRC
+  // that was recorded for its file, if the file hasn't changed since.
+  std::optional<uint32_t> GetPluginCrc(const PluginInterface& plugin) const;
   bool SupportsLightPlugins() const;
   bool SupportsMediumPlugins() const;
 
+  // Compares any fully-loaded plugins that haven't been compared before
+  // against all other fully-loaded plugins, and saves the results.
+  void UpdateRecordOverlapIndex();
+  // Indexes the given plugin using the names of the loaded plugins that it
+  // was found to overlap, and saves the results. The plugin must have been
+  // compared against all the loaded plugins.
+  void AddToRecordOverlapIndex(
+      const std::string& pluginName,
+      const std::vector<std::string>& overlappingPluginNames);
+  // Returns std::nullopt if the overlap between the plugins with the given
+  // names and CRCs has not been indexed.
+  std::optional<bool> DoIndexedRecordsOverlap(const std::string& pluginName1,
+                                              uint32_t crc1,
+                                              const std::string& pluginName2,
+                                              uint32_t crc2) const;
+  // Get the number of other indexed plugins that each indexed plugin
+  // overlaps, keyed by plugin name.
+  std::unordered_map<std::string, OverlapCount> GetRecordOverlapCounts() const;
+
   std::filesystem::path MasterlistPath() const;
   std::filesystem::path UserlistPath() const;
   std::filesystem::path GroupNodePositionsPath() const;
+  std::filesystem::path GroupLayoutCachePath() const;
+  std::filesystem::path PluginFileCachePath() const;
+  std::filesystem::path RecordOverlapIndexPath() const;
+  std::filesystem::path SortResultCachePath() const;
+  std::filesystem::path PluginItemsSnapshotPath() const;
   std::filesystem::path GetActivePluginsFilePath() const;
+  const std::vector<std::filesystem::path>& ExternalDataPaths() const;
 
   std::vector<std::string> GetLoadOrder() const;
   void SetLoadOrder(const std::vector<std::string>& loadOrder);
 
   bool IsPluginActive(const std::string& pluginName) const;
+  // The snapshot is shared until the load order or the loaded plugins change,
+  // so that checks made for many plugins don't each query the game handle.
+  std::shared_ptr<const ActivePluginsSnapshot> GetActivePluginsSnapshot()
+      const;
+  // The index is built from the loaded plugins' masters and their
+  // requirements' unevaluated metadata, and is shared until the loaded plugins
+  // or their metadata change.
+  std::shared_ptr<const PluginDependentsIndex> GetPluginDependentsIndex() const;
+  // Gets the plugin's index in the current load order. The indices of all
+  // active plugins are calculated together and then shared until the load
+  // order or the loaded plugins change, so each call is a hash lookup.
   std::optional<short> GetActiveLoadOrderIndex(
-      const PluginInterface& plugin,
-      const std::vector<std::string>& loadOrder) const;
+      const PluginInterface& plugin) const;
 
+  // The result is shared until the load order or the loaded plugins change.
   bool IsLoadOrderAmbiguous() const;
 
+  // If none of the inputs to sorting have changed since the last successful
+  // sort, in this session or the last, the last sort's result is returned
+  // without sorting again.
   std::vector<std::string> SortPlugins();
+  // Sorts the plugins using a separate libloot game handle, so that it's safe
+  // to do in the background, and keeps the result for the next call to
+  // SortPlugins() to use if the inputs to sorting are unchanged. The handle is
+  // discarded once sorting has finished.
+  void PrecomputeSortResult();
+  // The load order that the last successful sort started from, recorded so
+  // that discarding the sort's result doesn't need to look up every plugin
+  // again. The snapshot is never changed once recorded, so it can be shared.
+  // Null if no sort has succeeded since the game was initialised.
+  std::shared_ptr<const LoadOrderIndices> GetPreSortLoadOrder();
   void IncrementLoadOrderSortCount();
   void DecrementLoadOrderSortCount();
 
+  // The checks of the active plugin counts and of the game's paths are only
+  // made again once the load order or the game's paths change.
   std::vector<SourcedMessage> GetMessages(const std::string& language,
                                           bool warnOnCaseSensitivePaths) const;
   void AppendMessage(const SourcedMessage& message);
   void ClearMessages();
 
   void LoadMetadata();
+  // Loads the metadata lists like LoadMetadata(), and returns the names of
+  // the plugins in the load order whose metadata changed as a result, or
+  // std::nullopt if the groups changed, as that may affect any plugin.
+  std::optional<std::unordered_set<std::string>> ReloadMetadata();
   std::vector<std::string> GetKnownBashTags() const;
 
   std::vector<Group> GetMasterlistGroups() const;
   std::vector<Group> GetUserGroups() const;
+  // The masterlist and user groups are merged and indexed the first time
+  // that they're needed, and the graph is shared until the metadata lists
+  // are loaded or the user groups are set.
+  std::shared_ptr<const GroupGraph> GetGroupGraph() const;
 
   std::optional<PluginMetadata> GetMasterlistMetadata(
       const std::string& pluginName,
@@ -149,13 +268,63 @@ public:
   void ClearAllUserMetadata();
   void SaveUserMetadata();
 
+  // Returns the snapshot that was last published. Work that only reads the
+  // game's data can use it while the game is changed on another thread. The
+  // snapshot is empty until one is published.
+  std::shared_ptr<const GameDataSnapshot> GetDataSnapshot() const;
+  // Takes a new snapshot of the game's load order, plugins and metadata and
+  // replaces the published snapshot with it. Changes to user metadata are
+  // published automatically, but anything that loads or changes the load
+  // order, plugins or metadata lists must publish a new snapshot once it's
+  // done. The game must not be changed on another thread while the snapshot
+  // is taken.
+  void PublishDataSnapshot();
+
 private:
   std::filesystem::path GetLOOTGamePath() const;
-  std::vector<std::filesystem::path> GetInstalledPluginPaths() const;
+  void UpdateExternalDataPaths();
+  std::vector<std::filesystem::path> GetInstalledPluginPaths();
+  // Records the CRCs of the plugins at the given paths in the plugin file
+  // cache, and looks up the CRCs of plugins that weren't fully loaded.
+  void UpdatePluginCrcs(const std::vector<std::filesystem::path>& pluginPaths);
+  // Saves the index and then replaces the current index with it.
+  void SetRecordOverlapIndex(RecordOverlapIndex&& index);
   void AppendMessages(std::vector<SourcedMessage> messages);
   std::filesystem::path ResolveGameFilePath(
       const std::string& pluginName) const;
   bool FileExists(const std::string& file) const;
+  std::shared_ptr<const DataPathsSnapshot> GetDataPathsSnapshot() const;
+  void ClearDataPathsSnapshot();
+  void ClearDataSnapshot();
+  void UpdateDataSnapshotUserMetadata(const std::string& pluginName);
+  struct ActivePluginCounts {
+    size_t full{0};
+    size_t light{0};
+    size_t medium{0};
+  };
+  ActivePluginCounts GetActivePluginCounts() const;
+  // activePluginsMutex_ must be held when calling this.
+  std::shared_ptr<const ActivePluginsSnapshot> GetActivePluginsSnapshotLocked()
+      const;
+  std::vector<SourcedMessage> GetActivePluginCountMessages() const;
+  struct PathCaseSensitivity {
+    bool dataPath{false};
+    bool gameLocalPath{false};
+  };
+  // Creates the game's local data path if it doesn't exist, so that it can be
+  // checked.
+  PathCaseSensitivity GetPathCaseSensitivity() const;
+  void ClearActivePluginsCache();
+  void ClearPluginDependentsIndex();
+  void ClearGroupGraph();
+  // Hashes the sizes and timestamps of the files and folders that the current
+  // load order state is read from.
+  uint64_t GetLoadOrderFilesHash() const;
+  // Hashes the content of the masterlist, userlist and masterlist prelude.
+  uint64_t GetMetadataListsHash() const;
+  uint64_t GetSortInputsHash(GameInterface& handle,
+                             const std::vector<std::string>& loadOrder,
+                             uint64_t filesHash) const;
 
   GameSettings settings_;
   std::unique_ptr<GameInterface> gameHandle_;
@@ -166,24 +335,136 @@ private:
   bool pluginsFullyLoaded_{false};
   bool isMicrosoftStoreInstall_{false};
   bool supportsLightPlugins_{false};
+  bool isMWSEInstalled_{false};
+  std::vector<std::filesystem::path> externalDataPaths_;
+  PluginFileCache pluginFileCache_;
+  // The CRCs of loaded plugins that are known without fully loading them.
+  std::map<Filename, uint32_t> pluginCrcs_;
+  // The hash of the load order files when the current load order state was
+  // last loaded, so that loading it again can be skipped if they're
+  // unchanged.
+  std::optional<uint64_t> loadOrderFilesHash_;
+  LoadOrderJournalState loadOrderJournalState_;
+
+  // The index may be read from the UI thread while it's updated in the
+  // background.
+  RecordOverlapIndex recordOverlapIndex_;
+  mutable std::mutex recordOverlapIndexMutex_;
+
+  // The result may be precomputed in the background while the game is used
+  // from other threads.
+  std::optional<CachedSortResult> cachedSortResult_;
+  std::shared_ptr<const LoadOrderIndices> preSortLoadOrder_;
+  std::mutex sortResultMutex_;
+  bool hasUnsavedUserMetadata_{false};
+  // The hash of the userlist's content when it was last loaded or saved, so
+  // that saving unchanged user metadata doesn't rewrite the file.
+  std::optional<uint64_t> userlistContentHash_;
+  // The hash of the metadata lists' content when they were last loaded into
+  // the game handle, so that loading them again can be skipped if they're
+  // unchanged.
+  std::optional<uint64_t> metadataListsHash_;
+  mutable std::shared_ptr<const GroupGraph> groupGraph_;
+  mutable std::mutex groupGraphMutex_;
+
+  // The snapshot is taken lazily, the first time that it's needed after
+  // being cleared, so that it reflects the state of the data paths when
+  // install validity is checked.
+  mutable std::shared_ptr<const DataPathsSnapshot> dataPathsSnapshot_;
+  mutable std::mutex dataPathsSnapshotMutex_;
+
+  // The snapshot, counts and checks are calculated lazily, the first time that
+  // they're needed after the load order or the loaded plugins change.
+  mutable std::shared_ptr<const ActivePluginsSnapshot> activePluginsSnapshot_;
+  mutable std::optional<ActivePluginCounts> activePluginCounts_;
+  mutable std::optional<std::vector<SourcedMessage>> activePluginCountMessages_;
+  mutable std::optional<bool> isLoadOrderAmbiguous_;
+  // Keyed by lowercased plugin names.
+  mutable std::optional<std::unordered_map<std::string, short>>
+      activeLoadOrderIndices_;
+  mutable std::shared_ptr<const PluginDependentsIndex> pluginDependentsIndex_;
+  mutable std::mutex activePluginsMutex_;
+
+  // The game's paths can only change when it's initialised.
+  mutable std::optional<PathCaseSensitivity> pathCaseSensitivity_;
+  mutable std::mutex pathCaseSensitivityMutex_;
+
+  // The size and write time of the CCC file that the Creation Club plugin
+  // names were read from, so that it's only read again if it changes.
+  struct CCCFileStamp {
+    std::filesystem::path path;
+    uintmax_t size{0};
+    std::filesystem::file_time_type writeTime;
+
+    bool operator==(const CCCFileStamp& other) const {
+      return path == other.path && size == other.size &&
+             writeTime == other.writeTime;
+    }
+  };
+
+  // Normalised using NormalisePluginName() so that lookups are
+  // case-insensitive.
+  std::unordered_set<std::string> creationClubPlugins_;
+  std::optional<CCCFileStamp> cccFileStamp_;
 
-  // Use Filename to benefit from libloot's case-insensitive comparisons.
-  std::set<Filename> creationClubPlugins_;
+  // Only replacing the pointer needs to be synchronised, as snapshots are
+  // never changed once published.
+  std::shared_ptr<const GameDataSnapshot> dataSnapshot_{
+      std::make_shared<const GameDataSnapshot>()};
+  mutable std::mutex dataSnapshotMutex_;
 };
 }
 
 std::string GetLoadOrderAsTextTable(const gui::Game& game,
                                     const std::vector<std::string>& plugins);
 
-std::string GetMetadataAsBBCodeYaml(const gui::Game& game,
+std::string GetMetadataAsBBCodeYaml(const GameDataSnapshot& snapshot,
                                     const std::string& pluginName);
 
+// Write the merged masterlist and user metadata of the given plugins to the
+// stream as a YAML document with the same structure as a userlist. Plugins
+// with no metadata are omitted. The metadata is serialised in parallel in
+// batches, and each batch is written before the next is serialised, so the
+// whole document is never held in memory.
+void WriteMetadataAsYaml(const gui::Game& game,
+                         const std::vector<std::string>& pluginNames,
+                         std::ostream& out);
+
+void WriteMetadataAsYaml(const GameDataSnapshot& snapshot,
+                         const std::vector<std::string>& pluginNames,
+                         std::ostream& out);
+
+// If a cancellation token is given, it's checked before mapping each plugin,
+// and a CancelledError is thrown if it has been cancelled.
+//
+// If the mapper throws for any plugins, the rest of the batch is still mapped
+// and then a std::runtime_error is thrown that describes all the batch's
+// errors.
+//
+// If a batch callback is given, plugins are mapped in load order batches and
+// each batch is passed to the callback as soon as it has been mapped, before
+// the next batch is mapped. The first batch is only about a screenful of
+// cards so that they can be displayed quickly, and later batches grow so that
+// fewer are sent in total.
+//
+// If mapActivePluginsFirst is true, active plugins are mapped (and sent) in
+// load order before inactive plugins, so that their batches are sent sooner.
+// The returned data is still in load order.
 template<typename T>
 std::vector<T> MapFromLoadOrderData(
     const gui::Game& game,
     const std::vector<std::string>& loadOrder,
     const std::function<
-        T(const PluginInterface* const, std::optional<short>, bool)>& mapper) {
+        T(const PluginInterface* const, std::optional<short>, bool)>& mapper,
+    const CancellationToken* cancellationToken = nullptr,
+    const std::function<void(std::vector<T>)>& sendBatch = nullptr,
+    bool mapActivePluginsFirst = false) {
+  static constexpr size_t FIRST_BATCH_SIZE = 16;
+  static constexpr size_t MAX_BATCH_SIZE = 256;
+
+  ScopedTimer timer("MapFromLoadOrderData");
+  ScopedMemoryMeter memoryMeter("MapFromLoadOrderData");
+
   typedef std::tuple<const PluginInterface* const, std::optional<short>, bool>
       LoadOrderTuple;
 
@@ -194,6 +475,8 @@ std::vector<T> MapFromLoadOrderData(
   short numberOfActiveMediumPlugins = 0;
   short numberOfActiveFullPlugins = 0;
 
+  const auto activePlugins = game.GetActivePluginsSnapshot();
+
   // First get all the necessary data to call the mapper, as this is fast.
   for (const auto& pluginName : loadOrder) {
     const auto plugin = game.GetPlugin(pluginName);
@@ -203,7 +486,7 @@ std::vector<T> MapFromLoadOrderData(
 
     const auto isLight = plugin->IsLightPlugin();
     const auto isMedium = plugin->IsMediumPlugin();
-    const auto isActive = game.IsPluginActive(pluginName);
+    const auto isActive = activePlugins->IsActive(pluginName);
 
     short numberOfActivePlugins;
     if (isLight) {
@@ -231,6 +514,25 @@ std::vector<T> MapFromLoadOrderData(
     }
   }
 
+  // The position in load order of each element of data, if it has been
+  // reordered so that active plugins are mapped first.
+  std::vector<size_t> loadOrderPositions;
+  if (mapActivePluginsFirst) {
+    loadOrderPositions.resize(data.size());
+    std::iota(loadOrderPositions.begin(), loadOrderPositions.end(), 0);
+    std::stable_partition(
+        loadOrderPositions.begin(),
+        loadOrderPositions.end(),
+        [&data](size_t position) { return std::get<2>(data[position]); });
+
+    std::vector<LoadOrderTuple> reorderedData;
+    reorderedData.reserve(data.size());
+    for (const auto position : loadOrderPositions) {
+      reorderedData.push_back(data[position]);
+    }
+    data = std::move(reorderedData);
+  }
+
   // Now perform the mapping in a second loop that can be parallelised
   // (because sometimes the mapper is slow).
   //
@@ -239,13 +541,16 @@ std::vector<T> MapFromLoadOrderData(
   // type in the variant holds the exception message string if an exception
   // is thrown by the mapper.
   typedef std::variant<T, std::string> MappedDataOrError;
-  const auto transformer = [&mapper](const LoadOrderTuple& loadOrderTuple) {
-    try {
-      const auto [plugin, activeLoadOrderIndex, isActive] = loadOrderTuple;
-
-      const auto mappedData = mapper(plugin, activeLoadOrderIndex, isActive);
+  const auto transformer = [&mapper, cancellationToken](
+                               const LoadOrderTuple& loadOrderTuple) {
+    if (cancellationToken != nullptr && cancellationToken->isCancelled()) {
+      // Skip the mapping, the error is thrown below.
+      return MappedDataOrError(std::string());
+    }
 
-      return MappedDataOrError(mappedData);
+    const auto [plugin, activeLoadOrderIndex, isActive] = loadOrderTuple;
+    try {
+      return MappedDataOrError(mapper(plugin, activeLoadOrderIndex, isActive));
     } catch (const std::exception& e) {
       const auto logger = getLogger();
       if (logger) {
@@ -253,28 +558,67 @@ std::vector<T> MapFromLoadOrderData(
             "Failed to map load order data to output type, exception is: {}",
             e.what());
       }
-      return MappedDataOrError(e.what());
+      return MappedDataOrError(plugin->GetName() + ": " + e.what());
     }
   };
 
-  // Can't use std::back_inserter as the output iterator when running the
-  // transform in parallel, so presize the vector.
-  std::vector<MappedDataOrError> maybeMappedData(data.size());
+  std::vector<T> mappedData;
+  mappedData.reserve(data.size());
 
-  std::transform(std::execution::par_unseq,
-                 data.cbegin(),
-                 data.cend(),
-                 maybeMappedData.begin(),
-                 transformer);
+  auto batchSize = sendBatch ? FIRST_BATCH_SIZE : data.size();
+  size_t batchStart = 0;
+  do {
+    const auto batchEnd = std::min(batchStart + batchSize, data.size());
 
-  std::vector<T> mappedData;
-  mappedData.reserve(maybeMappedData.size());
+    // Can't use std::back_inserter as the output iterator when running the
+    // transform in parallel, so presize the vector.
+    std::vector<MappedDataOrError> maybeMappedData(batchEnd - batchStart);
 
-  for (const auto& mappedDataOrError : maybeMappedData) {
-    if (std::holds_alternative<T>(mappedDataOrError)) {
-      mappedData.push_back(std::get<T>(mappedDataOrError));
-    } else {
-      throw std::runtime_error(std::get<std::string>(mappedDataOrError));
+    parallelTransform(data.cbegin() + batchStart,
+                      data.cbegin() + batchEnd,
+                      maybeMappedData.begin(),
+                      transformer);
+
+    if (cancellationToken != nullptr) {
+      cancellationToken->throwIfCancelled();
+    }
+
+    std::string errors;
+    for (auto& mappedDataOrError : maybeMappedData) {
+      if (std::holds_alternative<T>(mappedDataOrError)) {
+        mappedData.push_back(std::get<T>(std::move(mappedDataOrError)));
+      } else {
+        if (!errors.empty()) {
+          errors += "; ";
+        }
+        errors += std::get<std::string>(mappedDataOrError);
+      }
+    }
+
+    if (!errors.empty()) {
+      throw std::runtime_error("Failed to map load order data: " + errors);
+    }
+
+    if (sendBatch && batchEnd > batchStart) {
+      sendBatch(std::vector<T>(mappedData.cbegin() + batchStart,
+                               mappedData.cend()));
+    }
+
+    batchStart = batchEnd;
+    if (sendBatch) {
+      batchSize = std::min(batchSize * 2, MAX_BATCH_SIZE);
+    }
+  } while (batchStart < data.size());
+
+  if (!loadOrderPositions.empty()) {
+    std::vector<std::optional<T>> loadOrderData(mappedData.size());
+    for (size_t i = 0; i < mappedData.size(); i += 1) {
+      loadOrderData[loadOrderPositions[i]] = std::move(mappedData[i]);
+    }
+
+    mappedData.clear();
+    for (auto& element : loadOrderData) {
+      mappedData.push_back(std::move(element.value()));
     }
   }
 
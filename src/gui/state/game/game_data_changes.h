@@ -0,0 +1,49 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_GAME_GAME_DATA_CHANGES
+#define LOOT_GUI_STATE_GAME_GAME_DATA_CHANGES
+
+#include <set>
+#include <string>
+
+namespace loot {
+// Records the changes that have been made to a game's data on disk since it
+// was last loaded.
+struct GameDataChanges {
+  // Plugins that have been added or modified.
+  std::set<std::string> changedPlugins;
+  std::set<std::string> removedPlugins;
+  bool loadOrderChanged{false};
+  bool metadataChanged{false};
+
+  bool IsEmpty() const {
+    return changedPlugins.empty() && removedPlugins.empty() &&
+           !loadOrderChanged && !metadataChanged;
+  }
+};
+}
+
+#endif
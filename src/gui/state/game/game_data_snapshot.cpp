@@ -0,0 +1,116 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/game/game_data_snapshot.h"
+
+#include "gui/helpers.h"
+
+namespace loot {
+GameDataSnapshot::GameDataSnapshot(
+    std::vector<std::shared_ptr<const Plugin>> plugins) :
+    plugins_(std::move(plugins)) {
+  pluginIndices_.reserve(plugins_.size());
+  for (size_t i = 0; i < plugins_.size(); i += 1) {
+    pluginIndices_.emplace(NormalisePluginName(plugins_[i]->name), i);
+  }
+}
+
+std::vector<std::string> GameDataSnapshot::GetLoadOrder() const {
+  std::vector<std::string> loadOrder;
+  loadOrder.reserve(plugins_.size());
+  for (const auto& plugin : plugins_) {
+    loadOrder.push_back(plugin->name);
+  }
+
+  return loadOrder;
+}
+
+const std::vector<std::shared_ptr<const GameDataSnapshot::Plugin>>&
+GameDataSnapshot::GetPlugins() const {
+  return plugins_;
+}
+
+const GameDataSnapshot::Plugin* GameDataSnapshot::GetPlugin(
+    const std::string& pluginName) const {
+  const auto it = pluginIndices_.find(NormalisePluginName(pluginName));
+  if (it == pluginIndices_.end()) {
+    return nullptr;
+  }
+
+  return plugins_[it->second].get();
+}
+
+PluginMetadata GameDataSnapshot::GetMergedMetadata(
+    const std::string& pluginName) const {
+  const auto plugin = GetPlugin(pluginName);
+  if (plugin == nullptr) {
+    return PluginMetadata(pluginName);
+  }
+
+  if (plugin->userMetadata.has_value()) {
+    auto metadata = plugin->userMetadata.value();
+    if (plugin->masterlistMetadata.has_value()) {
+      metadata.MergeMetadata(plugin->masterlistMetadata.value());
+    }
+    return metadata;
+  }
+
+  if (plugin->masterlistMetadata.has_value()) {
+    return plugin->masterlistMetadata.value();
+  }
+
+  return PluginMetadata(pluginName);
+}
+
+std::shared_ptr<const GameDataSnapshot> GameDataSnapshot::WithUserMetadata(
+    const std::string& pluginName,
+    const std::optional<PluginMetadata>& userMetadata) const {
+  auto snapshot = std::make_shared<GameDataSnapshot>(*this);
+
+  const auto it = pluginIndices_.find(NormalisePluginName(pluginName));
+  if (it != pluginIndices_.end()) {
+    auto plugin = std::make_shared<Plugin>(*plugins_[it->second]);
+    plugin->userMetadata = userMetadata;
+    snapshot->plugins_[it->second] = std::move(plugin);
+  }
+
+  return snapshot;
+}
+
+std::shared_ptr<const GameDataSnapshot> GameDataSnapshot::WithoutUserMetadata()
+    const {
+  auto snapshot = std::make_shared<GameDataSnapshot>(*this);
+
+  for (auto& plugin : snapshot->plugins_) {
+    if (plugin->userMetadata.has_value()) {
+      auto copy = std::make_shared<Plugin>(*plugin);
+      copy->userMetadata = std::nullopt;
+      plugin = std::move(copy);
+    }
+  }
+
+  return snapshot;
+}
+}
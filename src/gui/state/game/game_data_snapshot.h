@@ -0,0 +1,91 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_GAME_GAME_DATA_SNAPSHOT
+#define LOOT_GUI_STATE_GAME_GAME_DATA_SNAPSHOT
+
+#include <loot/metadata/plugin_metadata.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace loot {
+// An immutable copy of a game's load order, the plugins in it and their
+// unevaluated metadata, taken when the game's data was last loaded or
+// changed. Read-only work can hold a snapshot while the game is refreshed on
+// another thread, as nothing in it refers back to the game.
+class GameDataSnapshot {
+public:
+  struct Plugin {
+    std::string name;
+    // Header data is only known for plugins that were loaded.
+    bool isLoaded{false};
+    std::optional<uint32_t> crc;
+    bool isActive{false};
+    bool isMaster{false};
+    bool isLightPlugin{false};
+    bool isMediumPlugin{false};
+    std::optional<PluginMetadata> masterlistMetadata;
+    std::optional<PluginMetadata> userMetadata;
+  };
+
+  GameDataSnapshot() = default;
+  // The plugins must be in load order.
+  explicit GameDataSnapshot(std::vector<std::shared_ptr<const Plugin>> plugins);
+
+  std::vector<std::string> GetLoadOrder() const;
+  const std::vector<std::shared_ptr<const Plugin>>& GetPlugins() const;
+
+  // The lookup is case-insensitive. Returns nullptr if the plugin isn't in
+  // the snapshot.
+  const Plugin* GetPlugin(const std::string& pluginName) const;
+
+  // The user metadata is merged into the masterlist metadata in the same way
+  // as when they're evaluated. If the plugin isn't in the snapshot, the
+  // returned metadata has only a name.
+  PluginMetadata GetMergedMetadata(const std::string& pluginName) const;
+
+  // Returns a copy of the snapshot that shares all its plugins' data except
+  // for the given plugin's, which has its user metadata replaced. The copy is
+  // the same as this snapshot if the plugin isn't in it.
+  std::shared_ptr<const GameDataSnapshot> WithUserMetadata(
+      const std::string& pluginName,
+      const std::optional<PluginMetadata>& userMetadata) const;
+
+  // Returns a copy of the snapshot in which no plugins have user metadata.
+  std::shared_ptr<const GameDataSnapshot> WithoutUserMetadata() const;
+
+private:
+  std::vector<std::shared_ptr<const Plugin>> plugins_;
+  // Keyed by lowercased plugin names.
+  std::unordered_map<std::string, size_t> pluginIndices_;
+};
+}
+
+#endif
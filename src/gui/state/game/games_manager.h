@@ -26,14 +26,19 @@
 #ifndef LOOT_GUI_STATE_GAME_GAMES_MANAGER
 #define LOOT_GUI_STATE_GAME_GAMES_MANAGER
 
+#include <algorithm>
 #include <boost/locale.hpp>
+#include <condition_variable>
 #include <filesystem>
+#include <list>
 #include <mutex>
 #include <optional>
+#include <set>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
+#include "gui/plugin_item.h"
 #include "gui/state/game/detection.h"
 #include "gui/state/game/game.h"
 #include "gui/state/logging.h"
@@ -57,6 +62,9 @@ public:
       const std::filesystem::path& preludePath) {
     std::lock_guard<std::recursive_mutex> guard(mutex_);
 
+    lootDataPath_ = lootDataPath;
+    preludePath_ = preludePath;
+
     auto logger = getLogger();
     if (logger) {
       logger->debug("Detecting installed games.");
@@ -111,6 +119,8 @@ public:
       }
     }
     installedGames_ = std::move(installedGames);
+    // Only the current game has been carried over, and it isn't resident.
+    residentGames_.clear();
 
     if (currentGameUpdated) {
       SetCurrentGame(currentGameFolder.value());
@@ -180,6 +190,153 @@ public:
     }
   }
 
+  // Keeps the current game's loaded data after it stops being current, along
+  // with the given plugin items, so that switching back to it doesn't need to
+  // load it again. The least recently used games beyond the given number are
+  // unloaded. If the plugin items aren't for the game's whole load order (e.g.
+  // because loading it was abandoned), the game is unloaded instead.
+  void RetainCurrentGame(std::vector<PluginItem> pluginItems,
+                         const std::string& language,
+                         size_t maxResidentGames) {
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+
+    RetainGameData(GetCurrentGame(),
+                   std::move(pluginItems),
+                   language,
+                   maxResidentGames);
+  }
+
+  // Returns a new, unloaded copy of the installed game with the given folder
+  // name if it is neither the current game, resident nor already being
+  // preloaded, so is worth preloading. Otherwise returns nothing. The copy is
+  // separate from the installed game so that it can be loaded without holding
+  // up changes to the installed games, and the caller must call
+  // EndPreloadingGame() once it's done with it.
+  std::optional<gui::Game> BeginPreloadingGame(const std::string& folderName) {
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+
+    const auto game = FindGame(folderName);
+    if (game == installedGames_.end() || game == currentGame_ ||
+        game->IsInitialised() || preloadingGames_.count(folderName) != 0) {
+      return std::nullopt;
+    }
+
+    const auto isResident = std::any_of(
+        residentGames_.begin(),
+        residentGames_.end(),
+        [&](const ResidentGame& residentGame) {
+          return residentGame.folderName == folderName;
+        });
+    if (isResident) {
+      return std::nullopt;
+    }
+
+    preloadingGames_.insert(folderName);
+
+    return gui::Game(game->GetSettings(), lootDataPath_, preludePath_);
+  }
+
+  // Replaces the installed game with a game that was loaded by preloading it,
+  // and keeps its data in the same way as RetainCurrentGame(). The loaded game
+  // is discarded if the installed game has since become current, been loaded
+  // or had its paths changed.
+  void RetainPreloadedGame(gui::Game game,
+                           std::vector<PluginItem> pluginItems,
+                           const std::string& language,
+                           size_t maxResidentGames) {
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+
+    const auto folderName = game.GetSettings().FolderName();
+    const auto installedGame = FindGame(folderName);
+    if (installedGame == installedGames_.end() ||
+        installedGame == currentGame_ || installedGame->IsInitialised() ||
+        GameNeedsRecreating(*installedGame, game.GetSettings())) {
+      return;
+    }
+
+    // Keep the installed game's settings, as its name or masterlist source
+    // may have been changed since it was copied.
+    auto settings = installedGame->GetSettings();
+    *installedGame = std::move(game);
+    installedGame->GetSettings() = std::move(settings);
+
+    RetainGameData(
+        *installedGame, std::move(pluginItems), language, maxResidentGames);
+  }
+
+  void EndPreloadingGame(const std::string& folderName) {
+    {
+      std::lock_guard<std::recursive_mutex> guard(mutex_);
+      preloadingGames_.erase(folderName);
+    }
+
+    preloadingFinished_.notify_all();
+  }
+
+  // Waits until the game with the given folder name isn't being preloaded.
+  // Returns immediately if it isn't, so this only blocks when the game that
+  // is being preloaded is needed.
+  void WaitForPreloadingGame(const std::string& folderName) {
+    std::unique_lock<std::recursive_mutex> lock(mutex_);
+    preloadingFinished_.wait(
+        lock, [&]() { return preloadingGames_.count(folderName) == 0; });
+  }
+
+  // Keeps the loaded data of a game that isn't current, in the same way as
+  // RetainCurrentGame() keeps the current game's.
+  void RetainGame(const std::string& folderName,
+                  std::vector<PluginItem> pluginItems,
+                  const std::string& language,
+                  size_t maxResidentGames) {
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+
+    const auto game = FindGame(folderName);
+    if (game == installedGames_.end() || game == currentGame_) {
+      return;
+    }
+
+    RetainGameData(
+        *game, std::move(pluginItems), language, maxResidentGames);
+  }
+
+  // Returns the plugin items that were retained for the current game, if it
+  // is still loaded, the items are in the given language and none of the
+  // game's files have changed since it was retained. Otherwise the game is
+  // unloaded. Either way, the game is no longer resident.
+  std::optional<std::vector<PluginItem>> TakeResidentPluginItems(
+      const std::string& language) {
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+
+    auto& game = GetCurrentGame();
+    const auto it =
+        std::find_if(residentGames_.begin(),
+                     residentGames_.end(),
+                     [&](const ResidentGame& residentGame) {
+                       return residentGame.folderName ==
+                              game.GetSettings().FolderName();
+                     });
+    if (it == residentGames_.end()) {
+      return std::nullopt;
+    }
+
+    auto residentGame = std::move(*it);
+    residentGames_.erase(it);
+
+    if (game.IsInitialised() && residentGame.language == language &&
+        residentGame.filesHash == game.GetSortInputFilesHash()) {
+      return std::move(residentGame.pluginItems);
+    }
+
+    auto logger = getLogger();
+    if (logger) {
+      logger->debug("The loaded data for {} is out of date, unloading it.",
+                    game.GetSettings().Name());
+    }
+    game.Unload();
+
+    return std::nullopt;
+  }
+
   std::vector<std::string> GetInstalledGameFolderNames() const {
     std::lock_guard<std::recursive_mutex> guard(mutex_);
 
@@ -212,6 +369,13 @@ public:
   }
 
 private:
+  struct ResidentGame {
+    std::string folderName;
+    uint64_t filesHash{0};
+    std::string language;
+    std::vector<PluginItem> pluginItems;
+  };
+
   virtual std::vector<GameSettings> FindInstalledGames(
       const std::vector<GameSettings>& gamesSettings) const = 0;
 
@@ -226,11 +390,77 @@ private:
            game.GetSettings().Master() != newSettings.Master();
   }
 
+  static bool IsForLoadOrder(const std::vector<PluginItem>& pluginItems,
+                             const std::vector<std::string>& loadOrder) {
+    return std::equal(pluginItems.begin(),
+                      pluginItems.end(),
+                      loadOrder.begin(),
+                      loadOrder.end(),
+                      [](const PluginItem& item, const std::string& name) {
+                        return item.name == name;
+                      });
+  }
+
+  std::vector<gui::Game>::iterator FindGame(const std::string& folderName) {
+    return std::find_if(installedGames_.begin(),
+                        installedGames_.end(),
+                        [&](const gui::Game& game) {
+                          return folderName == game.GetSettings().FolderName();
+                        });
+  }
+
+  void RetainGameData(gui::Game& game,
+                      std::vector<PluginItem> pluginItems,
+                      const std::string& language,
+                      size_t maxResidentGames) {
+    const auto folderName = game.GetSettings().FolderName();
+    EraseResidentGame(folderName);
+
+    if (!game.IsInitialised()) {
+      return;
+    }
+
+    if (maxResidentGames == 0 ||
+        !IsForLoadOrder(pluginItems, game.GetLoadOrder())) {
+      game.Unload();
+      return;
+    }
+
+    residentGames_.push_front(ResidentGame{folderName,
+                                           game.GetSortInputFilesHash(),
+                                           language,
+                                           std::move(pluginItems)});
+
+    while (residentGames_.size() > maxResidentGames) {
+      const auto evictedGame = FindGame(residentGames_.back().folderName);
+      if (evictedGame != installedGames_.end()) {
+        evictedGame->Unload();
+      }
+      residentGames_.pop_back();
+    }
+  }
+
+  void EraseResidentGame(const std::string& folderName) {
+    residentGames_.remove_if([&](const ResidentGame& residentGame) {
+      return residentGame.folderName == folderName;
+    });
+  }
+
   std::vector<gui::Game> installedGames_;
   std::vector<gui::Game>::iterator currentGame_{installedGames_.end()};
+  // Games other than the current game that are still loaded, most recently
+  // used first.
+  std::list<ResidentGame> residentGames_;
 
   // Mutex used to protect access to member variables.
   mutable std::recursive_mutex mutex_;
+  // The paths given when the installed games were last loaded, used to
+  // create the games that are preloaded.
+  std::filesystem::path lootDataPath_;
+  std::filesystem::path preludePath_;
+  // The folder names of the games that are being preloaded.
+  std::set<std::string> preloadingGames_;
+  std::condition_variable_any preloadingFinished_;
 };
 }
 
@@ -0,0 +1,139 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/game/group_graph.h"
+
+#include <algorithm>
+
+namespace loot {
+GroupGraph::GroupGraph(std::vector<Group> masterlistGroups,
+                       std::vector<Group> userGroups) :
+    masterlistGroups_(std::move(masterlistGroups)),
+    userGroups_(std::move(userGroups)) {
+  groups_.reserve(masterlistGroups_.size() + userGroups_.size());
+  groups_.insert(
+      groups_.end(), masterlistGroups_.begin(), masterlistGroups_.end());
+  groups_.insert(groups_.end(), userGroups_.begin(), userGroups_.end());
+
+  for (const auto& group : groups_) {
+    const auto groupId = AddGroupName(group.GetName());
+    isDefined_.at(groupId) = true;
+
+    for (const auto& afterGroupName : group.GetAfterGroups()) {
+      const auto afterGroupId = AddGroupName(afterGroupName);
+
+      auto& afterGroupIds = afterGroupIds_.at(groupId);
+      if (std::find(afterGroupIds.begin(), afterGroupIds.end(), afterGroupId) ==
+          afterGroupIds.end()) {
+        afterGroupIds.push_back(afterGroupId);
+        laterGroupIds_.at(afterGroupId).push_back(groupId);
+      }
+    }
+  }
+
+  for (size_t i = 0; i < names_.size(); i += 1) {
+    if (isDefined_.at(i)) {
+      groupNames_.push_back(names_.at(i));
+    }
+  }
+  std::sort(groupNames_.begin(), groupNames_.end());
+}
+
+const std::vector<Group>& GroupGraph::GetMasterlistGroups() const {
+  return masterlistGroups_;
+}
+
+const std::vector<Group>& GroupGraph::GetUserGroups() const {
+  return userGroups_;
+}
+
+const std::vector<Group>& GroupGraph::GetGroups() const { return groups_; }
+
+const std::vector<std::string>& GroupGraph::GetGroupNames() const {
+  return groupNames_;
+}
+
+bool GroupGraph::IsDefined(const std::string& groupName) const {
+  const auto groupId = GetGroupId(groupName);
+  return groupId.has_value() && isDefined_.at(groupId.value());
+}
+
+std::optional<size_t> GroupGraph::GetGroupId(
+    const std::string& groupName) const {
+  const auto it = ids_.find(groupName);
+  if (it == ids_.end()) {
+    return std::nullopt;
+  }
+
+  return it->second;
+}
+
+const std::string& GroupGraph::GetGroupName(size_t groupId) const {
+  return names_.at(groupId);
+}
+
+const std::vector<size_t>& GroupGraph::GetAfterGroupIds(size_t groupId) const {
+  return afterGroupIds_.at(groupId);
+}
+
+std::set<std::string> GroupGraph::GetGroupsLoadingAfter(
+    const std::string& groupName) const {
+  std::set<std::string> result;
+
+  const auto groupId = GetGroupId(groupName);
+  if (!groupId.has_value()) {
+    return result;
+  }
+
+  std::vector<bool> visited(names_.size(), false);
+  std::vector<size_t> groupsToVisit{groupId.value()};
+  while (!groupsToVisit.empty()) {
+    const auto current = groupsToVisit.back();
+    groupsToVisit.pop_back();
+
+    for (const auto laterGroupId : laterGroupIds_.at(current)) {
+      if (!visited.at(laterGroupId)) {
+        visited.at(laterGroupId) = true;
+        result.insert(names_.at(laterGroupId));
+        groupsToVisit.push_back(laterGroupId);
+      }
+    }
+  }
+
+  return result;
+}
+
+size_t GroupGraph::AddGroupName(const std::string& groupName) {
+  const auto [it, inserted] = ids_.emplace(groupName, names_.size());
+  if (inserted) {
+    names_.push_back(groupName);
+    isDefined_.push_back(false);
+    afterGroupIds_.emplace_back();
+    laterGroupIds_.emplace_back();
+  }
+
+  return it->second;
+}
+}
@@ -0,0 +1,89 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_GAME_GROUP_GRAPH
+#define LOOT_GUI_STATE_GAME_GROUP_GRAPH
+
+#include <loot/metadata/group.h>
+
+#include <cstddef>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace loot {
+// The masterlist and user groups merged into a single graph, with each group
+// name given an ID so that the groups that load before and after a group can
+// be found without scanning every group.
+class GroupGraph {
+public:
+  GroupGraph() = default;
+  GroupGraph(std::vector<Group> masterlistGroups,
+             std::vector<Group> userGroups);
+
+  const std::vector<Group>& GetMasterlistGroups() const;
+  const std::vector<Group>& GetUserGroups() const;
+  // The masterlist groups followed by the user groups. A group may be defined
+  // in both.
+  const std::vector<Group>& GetGroups() const;
+  // Sorted and deduplicated.
+  const std::vector<std::string>& GetGroupNames() const;
+
+  // Groups that are only referenced as another group's "after" group aren't
+  // defined.
+  bool IsDefined(const std::string& groupName) const;
+  std::optional<size_t> GetGroupId(const std::string& groupName) const;
+  const std::string& GetGroupName(size_t groupId) const;
+
+  // Get the IDs of the groups that the given group loads directly after,
+  // combined across its masterlist and user definitions.
+  const std::vector<size_t>& GetAfterGroupIds(size_t groupId) const;
+
+  // Get the names of the groups that load after the given group, directly or
+  // through other groups. The given group is only included if it's part of a
+  // cycle. This is calculated on each call.
+  std::set<std::string> GetGroupsLoadingAfter(
+      const std::string& groupName) const;
+
+private:
+  std::vector<Group> masterlistGroups_;
+  std::vector<Group> userGroups_;
+  std::vector<Group> groups_;
+  std::vector<std::string> groupNames_;
+
+  // Indexed by group ID.
+  std::vector<std::string> names_;
+  std::vector<bool> isDefined_;
+  std::vector<std::vector<size_t>> afterGroupIds_;
+  std::vector<std::vector<size_t>> laterGroupIds_;
+  std::unordered_map<std::string, size_t> ids_;
+
+  size_t AddGroupName(const std::string& groupName);
+};
+}
+
+#endif
@@ -30,6 +30,11 @@
 namespace loot {
 constexpr uint32_t LGNP_MAGIC_NUMBER = 0x504E474C;
 constexpr uint8_t LGNP_FORMAT_VERSION = 1;
+// Version 2 adds a 64-bit graph hash after the format version.
+constexpr uint8_t LGNP_HASHED_FORMAT_VERSION = 2;
+// Version 3 holds a sequence of layouts, each a 64-bit graph hash followed
+// by a 32-bit count of node positions and then the node positions.
+constexpr uint8_t LGNP_MULTIPLE_LAYOUTS_FORMAT_VERSION = 3;
 
 size_t readStringLength(std::istream& in) {
   uint16_t length{0};
@@ -53,18 +58,8 @@ void writeStringLength(std::ostream& out, size_t length) {
   }
 }
 
-std::vector<GroupNodePosition> LoadGroupNodePositions(
-    const std ::filesystem::path& filePath) {
-  if (!std::filesystem::exists(filePath)) {
-    return {};
-  }
-
-  std::ifstream in(filePath, std::ios_base::in | std::ios_base::binary);
-  if (!in.is_open()) {
-    throw std::runtime_error(filePath.u8string() +
-                             " could not be opened for parsing");
-  }
-
+// Returns the format version.
+uint8_t readHeader(std::istream& in, const std::filesystem::path& filePath) {
   uint32_t magicNumber{0};
   in.read(reinterpret_cast<char*>(&magicNumber), sizeof magicNumber);
 
@@ -76,11 +71,43 @@ std::vector<GroupNodePosition> LoadGroupNodePositions(
   uint8_t formatVersion{0};
   in.read(reinterpret_cast<char*>(&formatVersion), sizeof formatVersion);
 
-  if (formatVersion != LGNP_FORMAT_VERSION) {
+  if (formatVersion != LGNP_FORMAT_VERSION &&
+      formatVersion != LGNP_HASHED_FORMAT_VERSION &&
+      formatVersion != LGNP_MULTIPLE_LAYOUTS_FORMAT_VERSION) {
     throw std::runtime_error("Failed to parse " + filePath.u8string() +
                              ": unrecognised format version");
   }
 
+  return formatVersion;
+}
+
+uint64_t readGraphHash(std::istream& in,
+                       const std::filesystem::path& filePath) {
+  uint64_t graphHash{0};
+  in.read(reinterpret_cast<char*>(&graphHash), sizeof graphHash);
+
+  if (!in.good()) {
+    throw std::runtime_error("Failed to parse " + filePath.u8string() +
+                             ": missing graph hash");
+  }
+
+  return graphHash;
+}
+
+GroupNodePosition readNodePosition(std::istream& in, size_t stringLength) {
+  std::string name(stringLength, '\0');
+  in.read(name.data(), stringLength);
+
+  double x{0.0};
+  in.read(reinterpret_cast<char*>(&x), sizeof x);
+
+  double y{0.0};
+  in.read(reinterpret_cast<char*>(&y), sizeof y);
+
+  return GroupNodePosition{name, x, y};
+}
+
+std::vector<GroupNodePosition> readNodePositions(std::istream& in) {
   std::vector<GroupNodePosition> nodePositions;
   while (in.good()) {
     const auto stringLength = readStringLength(in);
@@ -90,23 +117,33 @@ std::vector<GroupNodePosition> LoadGroupNodePositions(
       break;
     }
 
-    std::string name(stringLength, '\0');
-    in.read(name.data(), stringLength);
+    nodePositions.push_back(readNodePosition(in, stringLength));
+  }
 
-    double x{0.0};
-    in.read(reinterpret_cast<char*>(&x), sizeof x);
+  return nodePositions;
+}
 
-    double y{0.0};
-    in.read(reinterpret_cast<char*>(&y), sizeof y);
+std::vector<GroupNodePosition> readNodePositions(
+    std::istream& in,
+    const std::filesystem::path& filePath) {
+  uint32_t count{0};
+  in.read(reinterpret_cast<char*>(&count), sizeof count);
 
-    nodePositions.push_back(GroupNodePosition{name, x, y});
+  std::vector<GroupNodePosition> nodePositions;
+  for (uint32_t i = 0; i < count && in.good(); ++i) {
+    nodePositions.push_back(readNodePosition(in, readStringLength(in)));
+  }
+
+  if (!in.good()) {
+    throw std::runtime_error("Failed to parse " + filePath.u8string() +
+                             ": incomplete node positions");
   }
 
   return nodePositions;
 }
 
-void SaveGroupNodePositions(const std ::filesystem::path& filePath,
-                            const std::vector<GroupNodePosition>& positions) {
+std::ofstream openForWriting(const std::filesystem::path& filePath,
+                             uint8_t formatVersion) {
   // Don't care about endianness because the files don't need to be portable.
 
   std::ofstream out(
@@ -119,9 +156,14 @@ void SaveGroupNodePositions(const std ::filesystem::path& filePath,
 
   out.write(reinterpret_cast<const char*>(&LGNP_MAGIC_NUMBER),
             sizeof LGNP_MAGIC_NUMBER);
-  out.write(reinterpret_cast<const char*>(&LGNP_FORMAT_VERSION),
-            sizeof LGNP_FORMAT_VERSION);
+  out.write(reinterpret_cast<const char*>(&formatVersion),
+            sizeof formatVersion);
+
+  return out;
+}
 
+void writeNodePositions(std::ostream& out,
+                        const std::vector<GroupNodePosition>& positions) {
   for (const auto& nodePosition : positions) {
     writeStringLength(out, nodePosition.groupName.size());
 
@@ -134,4 +176,96 @@ void SaveGroupNodePositions(const std ::filesystem::path& filePath,
               sizeof nodePosition.y);
   }
 }
+
+std::ifstream openForReading(const std::filesystem::path& filePath) {
+  std::ifstream in(filePath, std::ios_base::in | std::ios_base::binary);
+  if (!in.is_open()) {
+    throw std::runtime_error(filePath.u8string() +
+                             " could not be opened for parsing");
+  }
+
+  return in;
+}
+
+std::vector<GroupNodePosition> LoadGroupNodePositions(
+    const std ::filesystem::path& filePath) {
+  if (!std::filesystem::exists(filePath)) {
+    return {};
+  }
+
+  auto in = openForReading(filePath);
+
+  const auto formatVersion = readHeader(in, filePath);
+  if (formatVersion == LGNP_MULTIPLE_LAYOUTS_FORMAT_VERSION) {
+    throw std::runtime_error("Failed to parse " + filePath.u8string() +
+                             ": the file holds cached layouts");
+  }
+
+  if (formatVersion == LGNP_HASHED_FORMAT_VERSION) {
+    readGraphHash(in, filePath);
+  }
+
+  return readNodePositions(in);
+}
+
+void SaveGroupNodePositions(const std ::filesystem::path& filePath,
+                            const std::vector<GroupNodePosition>& positions) {
+  auto out = openForWriting(filePath, LGNP_FORMAT_VERSION);
+
+  writeNodePositions(out, positions);
+}
+
+std::vector<GroupLayout> LoadGroupLayouts(
+    const std ::filesystem::path& filePath) {
+  if (!std::filesystem::exists(filePath)) {
+    return {};
+  }
+
+  auto in = openForReading(filePath);
+
+  const auto formatVersion = readHeader(in, filePath);
+  if (formatVersion == LGNP_FORMAT_VERSION) {
+    return {};
+  }
+
+  if (formatVersion == LGNP_HASHED_FORMAT_VERSION) {
+    GroupLayout layout;
+    layout.graphHash = readGraphHash(in, filePath);
+    layout.positions = readNodePositions(in);
+
+    return {layout};
+  }
+
+  std::vector<GroupLayout> layouts;
+  while (in.peek() != std::istream::traits_type::eof()) {
+    GroupLayout layout;
+    layout.graphHash = readGraphHash(in, filePath);
+    layout.positions = readNodePositions(in, filePath);
+
+    layouts.push_back(std::move(layout));
+  }
+
+  return layouts;
+}
+
+void SaveGroupLayouts(const std ::filesystem::path& filePath,
+                      const std::vector<GroupLayout>& layouts) {
+  auto out = openForWriting(filePath, LGNP_MULTIPLE_LAYOUTS_FORMAT_VERSION);
+
+  for (const auto& layout : layouts) {
+    if (layout.positions.size() > UINT32_MAX) {
+      throw std::runtime_error("Cannot write more than " +
+                               std::to_string(UINT32_MAX) +
+                               " node positions for one layout");
+    }
+
+    const auto count = static_cast<uint32_t>(layout.positions.size());
+
+    out.write(reinterpret_cast<const char*>(&layout.graphHash),
+              sizeof layout.graphHash);
+    out.write(reinterpret_cast<const char*>(&count), sizeof count);
+
+    writeNodePositions(out, layout.positions);
+  }
+}
 }
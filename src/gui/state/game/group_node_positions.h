@@ -26,6 +26,7 @@
 #ifndef LOOT_GUI_STATE_GAME_GROUP_NODE_POSITIONS
 #define LOOT_GUI_STATE_GAME_GROUP_NODE_POSITIONS
 
+#include <cstdint>
 #include <filesystem>
 #include <string>
 #include <vector>
@@ -42,6 +43,22 @@ std::vector<GroupNodePosition> LoadGroupNodePositions(
 
 void SaveGroupNodePositions(const std ::filesystem::path& filePath,
                             const std::vector<GroupNodePosition>& positions);
+
+// Node positions that were calculated for a group graph, along with a hash of
+// that graph's nodes, edges and node sizes.
+struct GroupLayout {
+  uint64_t graphHash{0};
+  std::vector<GroupNodePosition> positions;
+};
+
+// Returns an empty vector if the file does not exist or if it holds positions
+// that were saved without a graph hash. The layouts are returned in the order
+// they were saved in.
+std::vector<GroupLayout> LoadGroupLayouts(
+    const std ::filesystem::path& filePath);
+
+void SaveGroupLayouts(const std ::filesystem::path& filePath,
+                      const std::vector<GroupLayout>& layouts);
 }
 
 #endif
@@ -28,12 +28,21 @@
 #include <loot/api.h>
 #include <spdlog/fmt/fmt.h>
 
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
-#include <boost/locale.hpp>
+#include <chrono>
 #include <fstream>
 #include <regex>
-
+#include <iterator>
+#include <sstream>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "gui/helpers.h"
+#include "gui/state/game/group_graph.h"
 #include "gui/state/logging.h"
+#include "gui/translation_cache.h"
 
 #ifdef _WIN32
 #ifndef UNICODE
@@ -61,6 +70,139 @@ constexpr const char* MS_FO4_VAULT_TEC_DATA_PATH =
 constexpr const char* MS_FO4_WASTELAND_DATA_PATH =
     "../../../Fallout 4- Wasteland Workshop (PC)/Content/Data";
 
+constexpr const char* LOAD_ORDER_JOURNAL_FILENAME = "loadorder.journal";
+constexpr const char* LOAD_ORDER_BACKUP_FILENAME = "loadorder.bak.0";
+constexpr size_t MAX_LOAD_ORDER_JOURNAL_ENTRIES = 100;
+
+// The load order journal is a text file made up of entries that each start
+// with a line of the form:
+//
+//   @ <timestamp> <kept prefix length> <kept suffix length> <line count>
+//
+// followed by the given number of lines, each holding a plugin name. An
+// entry's load order is the previous entry's load order with everything
+// between the kept prefix and kept suffix replaced by the entry's lines.
+struct LoadOrderJournal {
+  std::vector<loot::LoadOrderJournalEntry> entries;
+  // False if the journal ends with an invalid or truncated entry, e.g.
+  // because LOOT was closed while writing to it.
+  bool isComplete{true};
+};
+
+LoadOrderJournal ReadLoadOrderJournalFile(
+    const std::filesystem::path& journalPath) {
+  LoadOrderJournal journal;
+
+  std::ifstream in(journalPath, std::ios::binary);
+  if (!in.is_open()) {
+    return journal;
+  }
+
+  // Every line in a valid journal ends with a line break, so reaching the end
+  // of the file while reading a line means that the line was truncated.
+  const auto readLine = [&in](std::string& line) {
+    return std::getline(in, line) && !in.eof();
+  };
+
+  std::vector<std::string> previousLoadOrder;
+  std::string line;
+  while (in.peek() != std::ifstream::traits_type::eof()) {
+    char marker = 0;
+    loot::LoadOrderJournalEntry entry;
+    size_t prefixLength = 0;
+    size_t suffixLength = 0;
+    size_t lineCount = 0;
+
+    std::istringstream header;
+    if (readLine(line)) {
+      header.str(line);
+      header >> marker >> entry.timestamp >> prefixLength >> suffixLength >>
+          lineCount;
+    }
+
+    if (!header || marker != '@' ||
+        prefixLength + suffixLength > previousLoadOrder.size()) {
+      journal.isComplete = false;
+      break;
+    }
+
+    entry.loadOrder.assign(previousLoadOrder.begin(),
+                           previousLoadOrder.begin() + prefixLength);
+    for (size_t i = 0; i < lineCount && journal.isComplete; i += 1) {
+      if (readLine(line)) {
+        entry.loadOrder.push_back(line);
+      } else {
+        journal.isComplete = false;
+      }
+    }
+
+    if (!journal.isComplete) {
+      break;
+    }
+
+    entry.loadOrder.insert(entry.loadOrder.end(),
+                           previousLoadOrder.end() - suffixLength,
+                           previousLoadOrder.end());
+
+    previousLoadOrder = entry.loadOrder;
+    journal.entries.push_back(std::move(entry));
+  }
+
+  return journal;
+}
+
+void AppendLoadOrderJournalEntry(
+    std::string& buffer,
+    const std::vector<std::string>& previousLoadOrder,
+    const loot::LoadOrderJournalEntry& entry) {
+  const auto& loadOrder = entry.loadOrder;
+  const auto maxLength = std::min(previousLoadOrder.size(), loadOrder.size());
+
+  size_t prefixLength = 0;
+  while (prefixLength < maxLength &&
+         previousLoadOrder[prefixLength] == loadOrder[prefixLength]) {
+    prefixLength += 1;
+  }
+
+  size_t suffixLength = 0;
+  while (suffixLength < maxLength - prefixLength &&
+         previousLoadOrder[previousLoadOrder.size() - 1 - suffixLength] ==
+             loadOrder[loadOrder.size() - 1 - suffixLength]) {
+    suffixLength += 1;
+  }
+
+  const auto lineCount = loadOrder.size() - prefixLength - suffixLength;
+
+  buffer += fmt::format("@ {} {} {} {}\n",
+                        entry.timestamp,
+                        prefixLength,
+                        suffixLength,
+                        lineCount);
+
+  for (size_t i = prefixLength; i < prefixLength + lineCount; i += 1) {
+    buffer += loadOrder[i];
+    buffer += '\n';
+  }
+}
+
+// Write to a temporary file first so that an interrupted write doesn't leave
+// a truncated file.
+void WriteFileAtomically(const std::filesystem::path& path,
+                         const std::string& content) {
+  auto tempPath = path;
+  tempPath += ".tmp";
+
+  std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+  out << content;
+  out.close();
+
+  if (out.fail()) {
+    throw std::runtime_error("Failed to write " + tempPath.u8string());
+  }
+
+  std::filesystem::rename(tempPath, path);
+}
+
 std::filesystem::path GetUserDocumentsPath(
     const std::filesystem::path& gameLocalPath) {
 #ifdef _WIN32
@@ -80,34 +222,155 @@ std::filesystem::path GetUserDocumentsPath(
   return gameLocalPath.parent_path().parent_path().parent_path() / "Documents";
 #endif
 }
+
+// Calls the given function with each part of the text between occurrences of
+// the delimiter, without copying the text.
+template<typename Function>
+void ForEachPart(std::string_view text, char delimiter, Function function) {
+  while (true) {
+    const auto pos = text.find(delimiter);
+    function(text.substr(0, pos));
+
+    if (pos == std::string_view::npos) {
+      break;
+    }
+
+    text.remove_prefix(pos + 1);
+  }
+}
+
+std::string_view TrimWhitespace(std::string_view text) {
+  static constexpr std::string_view WHITESPACE = " \t\n\v\f\r";
+
+  const auto start = text.find_first_not_of(WHITESPACE);
+  if (start == std::string_view::npos) {
+    return std::string_view();
+  }
+
+  const auto end = text.find_last_not_of(WHITESPACE);
+
+  return text.substr(start, end - start + 1);
+}
+
+// Calls the given function with the name of each tag that the BashTags file
+// content adds or removes, and whether it's added.
+template<typename Function>
+void ForEachBashTagsFileEntry(std::istream& in, Function function) {
+  // Read the whole file at once and then tokenise it in place, so that the
+  // tag names aren't copied unless the function copies them.
+  const std::string content{std::istreambuf_iterator<char>(in),
+                            std::istreambuf_iterator<char>()};
+
+  ForEachPart(content, '\n', [&](std::string_view line) {
+    if (line.empty() || line[0] == '#') {
+      return;
+    }
+
+    const auto uncommentedLine = line.substr(0, line.find('#'));
+    ForEachPart(uncommentedLine, ',', [&](std::string_view entry) {
+      entry = TrimWhitespace(entry);
+
+      if (entry.empty()) {
+        return;
+      }
+
+      if (entry[0] == '-') {
+        function(entry.substr(1), false);
+      } else {
+        function(entry, true);
+      }
+    });
+  });
+}
 }
 
 namespace loot {
 void BackupLoadOrder(const std::vector<std::string>& loadOrder,
-                     const std::filesystem::path& backupDirectory) {
-  const int maxBackupIndex = 2;
-  const auto filenameFormat = "loadorder.bak.{0}";
-
-  std::filesystem::path backupFilePath =
-      backupDirectory / fmt::format(filenameFormat, 2);
-  if (std::filesystem::exists(backupFilePath)) {
-    std::filesystem::remove(backupFilePath);
+                     const std::filesystem::path& backupDirectory,
+                     LoadOrderJournalState* journalState) {
+  const auto journalPath = backupDirectory / LOAD_ORDER_JOURNAL_FILENAME;
+
+  std::string plainTextBackup;
+  for (const auto& plugin : loadOrder) {
+    plainTextBackup += plugin;
+    plainTextBackup += '\n';
+  }
+  WriteFileAtomically(backupDirectory / LOAD_ORDER_BACKUP_FILENAME,
+                      plainTextBackup);
+
+  LoadOrderJournalEntry newEntry;
+  newEntry.timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+                           std::chrono::system_clock::now().time_since_epoch())
+                           .count();
+  newEntry.loadOrder = loadOrder;
+
+  std::error_code errorCode;
+  auto journalSize = std::filesystem::file_size(journalPath, errorCode);
+  if (errorCode) {
+    journalSize = 0;
   }
 
-  for (int i = maxBackupIndex - 1; i > -1; --i) {
-    const std::filesystem::path oldBackupFilePath =
-        backupDirectory / fmt::format(filenameFormat, i);
-    if (std::filesystem::exists(oldBackupFilePath)) {
-      std::filesystem::rename(
-          oldBackupFilePath,
-          backupDirectory / fmt::format(filenameFormat, i + 1));
+  // Only read the journal if it's not known what was last written to it.
+  LoadOrderJournalState state;
+  bool isComplete = true;
+  if (journalState != nullptr && journalState->fileSize == journalSize) {
+    state = *journalState;
+  } else {
+    auto journal = ReadLoadOrderJournalFile(journalPath);
+    isComplete = journal.isComplete;
+    state.entryCount = journal.entries.size();
+    if (!journal.entries.empty()) {
+      state.lastLoadOrder = std::move(journal.entries.back().loadOrder);
     }
   }
 
-  std::ofstream out(backupDirectory / fmt::format(filenameFormat, 0));
-  for (const auto& plugin : loadOrder) {
-    out << plugin << std::endl;
+  std::string buffer;
+  if (isComplete && state.entryCount < MAX_LOAD_ORDER_JOURNAL_ENTRIES) {
+    AppendLoadOrderJournalEntry(buffer, state.lastLoadOrder, newEntry);
+
+    std::ofstream out(journalPath, std::ios::binary | std::ios::app);
+    out << buffer;
+    out.close();
+
+    if (out.fail()) {
+      throw std::runtime_error("Failed to write " + journalPath.u8string());
+    }
+
+    state.entryCount += 1;
+    state.fileSize = journalSize + buffer.size();
+  } else {
+    // Rewrite the journal without its oldest entries (or without its invalid
+    // tail), so that its first entry records its whole load order.
+    auto entries = ReadLoadOrderJournalFile(journalPath).entries;
+    if (entries.size() >= MAX_LOAD_ORDER_JOURNAL_ENTRIES) {
+      entries.erase(entries.begin(),
+                    entries.end() - (MAX_LOAD_ORDER_JOURNAL_ENTRIES - 1));
+    }
+    entries.push_back(newEntry);
+
+    std::vector<std::string> previousLoadOrder;
+    for (const auto& entry : entries) {
+      AppendLoadOrderJournalEntry(buffer, previousLoadOrder, entry);
+      previousLoadOrder = entry.loadOrder;
+    }
+
+    WriteFileAtomically(journalPath, buffer);
+
+    state.entryCount = entries.size();
+    state.fileSize = buffer.size();
   }
+
+  state.lastLoadOrder = std::move(newEntry.loadOrder);
+
+  if (journalState != nullptr) {
+    *journalState = std::move(state);
+  }
+}
+
+std::vector<LoadOrderJournalEntry> ReadLoadOrderJournal(
+    const std::filesystem::path& backupDirectory) {
+  return ReadLoadOrderJournalFile(backupDirectory / LOAD_ORDER_JOURNAL_FILENAME)
+      .entries;
 }
 
 std::string EscapeMarkdownASCIIPunctuation(const std::string& text) {
@@ -188,9 +451,8 @@ std::vector<SourcedMessage> CheckForRemovedPlugins(
           MessageType::warn,
           MessageSource::removedPluginsCheck,
           fmt::format(
-              boost::locale::translate("LOOT has detected that \"{0}\" is "
-                                       "invalid and is now ignoring it.")
-                  .str(),
+              TranslateCached("LOOT has detected that \"{0}\" is "
+                              "invalid and is now ignoring it."),
               pluginPath.u8string())));
     }
   }
@@ -200,41 +462,33 @@ std::vector<SourcedMessage> CheckForRemovedPlugins(
 
 std::vector<Tag> ReadBashTagsFile(std::istream& in) {
   std::vector<Tag> tags;
-  for (std::string line; std::getline(in, line);) {
-    if (line.empty() || line[0] == '#') {
-      continue;
-    }
+  ForEachBashTagsFileEntry(in, [&](std::string_view name, bool isAddition) {
+    tags.push_back(Tag(std::string(name), isAddition));
+  });
 
-    line = line.substr(0, line.find('#'));
-
-    std::vector<std::string> entries;
-    boost::split(entries, line, boost::is_any_of(","));
+  return tags;
+}
 
-    for (auto& entry : entries) {
-      boost::trim(entry);
+TagSet ReadBashTagsFileTagSet(std::istream& in) {
+  TagSet tags;
+  ForEachBashTagsFileEntry(in, [&](std::string_view name, bool isAddition) {
+    tags.Add(name, isAddition);
+  });
 
-      if (entry.empty()) {
-        continue;
-      }
+  return tags;
+}
 
-      if (entry[0] == '-') {
-        tags.push_back(Tag(entry.substr(1), false));
-      } else {
-        tags.push_back(Tag(entry));
-      }
-    }
-  }
+std::string GetBashTagsFilename(const std::string& pluginName) {
+  static constexpr size_t PLUGIN_EXTENSION_LENGTH = 4;
 
-  return tags;
+  return pluginName.substr(0, pluginName.length() - PLUGIN_EXTENSION_LENGTH) +
+         ".txt";
 }
 
 std::vector<Tag> ReadBashTagsFile(const std::filesystem::path& dataPath,
                                   const std::string& pluginName) {
-  static constexpr size_t PLUGIN_EXTENSION_LENGTH = 4;
-  const auto filename =
-      pluginName.substr(0, pluginName.length() - PLUGIN_EXTENSION_LENGTH) +
-      ".txt";
-  const auto filePath = dataPath / "BashTags" / filename;
+  const auto filePath = dataPath / "BashTags" /
+                        GetBashTagsFilename(pluginName);
 
   if (!std::filesystem::exists(filePath)) {
     return {};
@@ -247,44 +501,7 @@ std::vector<Tag> ReadBashTagsFile(const std::filesystem::path& dataPath,
 
 std::vector<std::string> GetTagConflicts(const std::vector<Tag>& tags1,
                                          const std::vector<Tag>& tags2) {
-  std::set<std::string> additions1;
-  std::set<std::string> additions2;
-  std::set<std::string> removals1;
-  std::set<std::string> removals2;
-
-  for (const auto& tag : tags1) {
-    if (tag.IsAddition()) {
-      additions1.insert(tag.GetName());
-    } else {
-      removals1.insert(tag.GetName());
-    }
-  }
-
-  for (const auto& tag : tags2) {
-    if (tag.IsAddition()) {
-      additions2.insert(tag.GetName());
-    } else {
-      removals2.insert(tag.GetName());
-    }
-  }
-
-  std::vector<std::string> conflicts;
-
-  std::set_intersection(additions1.begin(),
-                        additions1.end(),
-                        removals2.begin(),
-                        removals2.end(),
-                        std::back_inserter(conflicts));
-
-  std::set_intersection(additions2.begin(),
-                        additions2.end(),
-                        removals1.begin(),
-                        removals1.end(),
-                        std::back_inserter(conflicts));
-
-  std::sort(conflicts.begin(), conflicts.end());
-
-  return conflicts;
+  return TagSet(tags1).GetConflicts(TagSet(tags2));
 }
 
 bool HasPluginFileExtension(const std::string& filename) {
@@ -293,6 +510,15 @@ bool HasPluginFileExtension(const std::string& filename) {
          boost::iends_with(filename, ".esl");
 }
 
+bool HasPossiblyGhostedPluginFileExtension(const std::string& filename) {
+  if (boost::iends_with(filename, GHOST_EXTENSION)) {
+    return HasPluginFileExtension(filename.substr(
+        0, filename.size() - std::char_traits<char>::length(GHOST_EXTENSION)));
+  }
+
+  return HasPluginFileExtension(filename);
+}
+
 std::filesystem::path ResolveGameFilePath(
     const std::vector<std::filesystem::path>& externalDataPaths,
     const std::filesystem::path& dataPath,
@@ -466,7 +692,7 @@ static constexpr std::array<const char*, 79> TES5SE_OFFICIAL_PLUGINS = {
 
 // Taken from
 // <https://github.com/wrye-bash/wrye-bash/blob/ea0a4f36fc57ad904487f2dbd9ec7e8b587bb528/Mopy/bash/game/skyrimvr/__init__.py#L70>
-static constexpr std::array<const char*, 80> TES5VR_OFFICIAL_PLUGINS = {
+static constexpr std::array<const char*, 79> TES5VR_OFFICIAL_PLUGINS = {
     "skyrim.esm",
     "update.esm",
     "dawnguard.esm",
@@ -549,7 +775,7 @@ static constexpr std::array<const char*, 80> TES5VR_OFFICIAL_PLUGINS = {
 
 // Taken from
 // <https://github.com/wrye-bash/wrye-bash/blob/ea0a4f36fc57ad904487f2dbd9ec7e8b587bb528/Mopy/bash/game/nehrim/__init__.py#L84>
-static constexpr std::array<const char*, 5> NEHRIM_OFFICIAL_PLUGINS = {
+static constexpr std::array<const char*, 1> NEHRIM_OFFICIAL_PLUGINS = {
     "nehrim.esm"};
 
 // Taken from
@@ -624,66 +850,101 @@ static constexpr std::array<const char*, 4> STARFIELD_OFFICIAL_PLUGINS = {
     "constellation.esm",
     "oldmars.esm"};
 
+template<size_t N>
+std::unordered_set<std::string_view> ToNameSet(
+    const std::array<const char*, N>& names) {
+  return std::unordered_set<std::string_view>(names.begin(), names.end());
+}
+
 bool IsOfficialPlugin(const GameId gameId, const std::string& pluginName) {
-  const auto lowercased = boost::locale::to_lower(pluginName);
-
-  switch (gameId) {
-    case GameId::tes3:
-      return std::find(TES3_OFFICIAL_PLUGINS.begin(),
-                       TES3_OFFICIAL_PLUGINS.end(),
-                       lowercased) != TES3_OFFICIAL_PLUGINS.end();
-    case GameId::tes4:
-      return std::find(TES4_OFFICIAL_PLUGINS.begin(),
-                       TES4_OFFICIAL_PLUGINS.end(),
-                       lowercased) != TES4_OFFICIAL_PLUGINS.end();
-    case GameId::nehrim:
-      return std::find(NEHRIM_OFFICIAL_PLUGINS.begin(),
-                       NEHRIM_OFFICIAL_PLUGINS.end(),
-                       lowercased) != NEHRIM_OFFICIAL_PLUGINS.end();
-    case GameId::tes5:
-      return std::find(TES5_OFFICIAL_PLUGINS.begin(),
-                       TES5_OFFICIAL_PLUGINS.end(),
-                       lowercased) != TES5_OFFICIAL_PLUGINS.end();
-    case GameId::enderal:
-      return std::find(ENDERAL_OFFICIAL_PLUGINS.begin(),
-                       ENDERAL_OFFICIAL_PLUGINS.end(),
-                       lowercased) != ENDERAL_OFFICIAL_PLUGINS.end();
-    case GameId::tes5se:
-      return std::find(TES5SE_OFFICIAL_PLUGINS.begin(),
-                       TES5SE_OFFICIAL_PLUGINS.end(),
-                       lowercased) != TES5SE_OFFICIAL_PLUGINS.end();
-    case GameId::enderalse:
-      return std::find(ENDERALSE_OFFICIAL_PLUGINS.begin(),
-                       ENDERALSE_OFFICIAL_PLUGINS.end(),
-                       lowercased) != ENDERALSE_OFFICIAL_PLUGINS.end();
-    case GameId::tes5vr:
-      return std::find(TES5VR_OFFICIAL_PLUGINS.begin(),
-                       TES5VR_OFFICIAL_PLUGINS.end(),
-                       lowercased) != TES5VR_OFFICIAL_PLUGINS.end();
-    case GameId::fo3:
-      return std::find(FO3_OFFICIAL_PLUGINS.begin(),
-                       FO3_OFFICIAL_PLUGINS.end(),
-                       lowercased) != FO3_OFFICIAL_PLUGINS.end();
-    case GameId::fonv:
-      return std::find(FONV_OFFICIAL_PLUGINS.begin(),
-                       FONV_OFFICIAL_PLUGINS.end(),
-                       lowercased) != FONV_OFFICIAL_PLUGINS.end();
-    case GameId::fo4:
-      return std::find(FO4_OFFICIAL_PLUGINS.begin(),
-                       FO4_OFFICIAL_PLUGINS.end(),
-                       lowercased) != FO4_OFFICIAL_PLUGINS.end();
-    case GameId::fo4vr:
-      return std::find(FO4VR_OFFICIAL_PLUGINS.begin(),
-                       FO4VR_OFFICIAL_PLUGINS.end(),
-                       lowercased) != FO4VR_OFFICIAL_PLUGINS.end();
-    case GameId::starfield:
-      return std::find(STARFIELD_OFFICIAL_PLUGINS.begin(),
-                       STARFIELD_OFFICIAL_PLUGINS.end(),
-                       lowercased) != STARFIELD_OFFICIAL_PLUGINS.end();
-    default:
-      throw std::logic_error("Unrecognised game type");
+  // The sets are built once so that each check is a single hash lookup.
+  static const std::unordered_map<GameId, std::unordered_set<std::string_view>>
+      OFFICIAL_PLUGINS{
+          {GameId::tes3, ToNameSet(TES3_OFFICIAL_PLUGINS)},
+          {GameId::tes4, ToNameSet(TES4_OFFICIAL_PLUGINS)},
+          {GameId::nehrim, ToNameSet(NEHRIM_OFFICIAL_PLUGINS)},
+          {GameId::tes5, ToNameSet(TES5_OFFICIAL_PLUGINS)},
+          {GameId::enderal, ToNameSet(ENDERAL_OFFICIAL_PLUGINS)},
+          {GameId::tes5se, ToNameSet(TES5SE_OFFICIAL_PLUGINS)},
+          {GameId::enderalse, ToNameSet(ENDERALSE_OFFICIAL_PLUGINS)},
+          {GameId::tes5vr, ToNameSet(TES5VR_OFFICIAL_PLUGINS)},
+          {GameId::fo3, ToNameSet(FO3_OFFICIAL_PLUGINS)},
+          {GameId::fonv, ToNameSet(FONV_OFFICIAL_PLUGINS)},
+          {GameId::fo4, ToNameSet(FO4_OFFICIAL_PLUGINS)},
+          {GameId::fo4vr, ToNameSet(FO4VR_OFFICIAL_PLUGINS)},
+          {GameId::starfield, ToNameSet(STARFIELD_OFFICIAL_PLUGINS)}};
+
+  const auto it = OFFICIAL_PLUGINS.find(gameId);
+  if (it == OFFICIAL_PLUGINS.end()) {
+    throw std::logic_error("Unrecognised game type");
+  }
+
+  return it->second.count(NormalisePluginName(pluginName)) != 0;
+}
+
+std::vector<PluginMove> GetMinimalPluginMoves(
+    const std::vector<std::string>& currentLoadOrder,
+    const std::vector<std::string>& newLoadOrder) {
+  static constexpr size_t NO_PREDECESSOR = SIZE_MAX;
+
+  std::unordered_map<std::string, size_t> currentIndices;
+  for (size_t i = 0; i < currentLoadOrder.size(); i += 1) {
+    currentIndices.emplace(currentLoadOrder[i], i);
   }
 
-  return false;
+  // Pairs of current and new indices, in new load order.
+  std::vector<std::pair<size_t, size_t>> indices;
+  for (size_t i = 0; i < newLoadOrder.size(); i += 1) {
+    const auto it = currentIndices.find(newLoadOrder[i]);
+    if (it != currentIndices.end()) {
+      indices.emplace_back(it->second, i);
+    }
+  }
+
+  // Find the longest increasing subsequence of current indices. tails[k] is
+  // the position in indices of the smallest current index that ends an
+  // increasing subsequence of length k + 1.
+  std::vector<size_t> tails;
+  std::vector<size_t> predecessors(indices.size(), NO_PREDECESSOR);
+  for (size_t i = 0; i < indices.size(); i += 1) {
+    const auto it = std::lower_bound(
+        tails.begin(),
+        tails.end(),
+        indices[i].first,
+        [&](size_t tail, size_t value) { return indices[tail].first < value; });
+
+    if (it != tails.begin()) {
+      predecessors[i] = *std::prev(it);
+    }
+
+    if (it == tails.end()) {
+      tails.push_back(i);
+    } else {
+      *it = i;
+    }
+  }
+
+  std::vector<bool> isStationary(indices.size(), false);
+  if (!tails.empty()) {
+    for (auto i = tails.back(); i != NO_PREDECESSOR; i = predecessors[i]) {
+      isStationary[i] = true;
+    }
+  }
+
+  std::vector<PluginMove> moves;
+  for (size_t i = 0; i < indices.size(); i += 1) {
+    if (!isStationary[i]) {
+      const auto [currentIndex, newIndex] = indices[i];
+      moves.push_back(
+          PluginMove{newLoadOrder[newIndex], currentIndex, newIndex});
+    }
+  }
+
+  return moves;
+}
+
+std::set<std::string> GetGroupsLoadingAfter(const std::vector<Group>& groups,
+                                            const std::string& groupName) {
+  return GroupGraph(groups, {}).GetGroupsLoadingAfter(groupName);
 }
 }
@@ -27,23 +27,57 @@
 #define LOOT_GUI_STATE_GAME_HELPERS
 
 #include <loot/enum/game_type.h>
+#include <loot/metadata/group.h>
 #include <loot/metadata/message.h>
 #include <loot/metadata/plugin_cleaning_data.h>
 #include <loot/metadata/tag.h>
 #include <loot/vertex.h>
 
+#include <cstdint>
 #include <filesystem>
+#include <optional>
+#include <set>
+#include <string>
 #include <tuple>
 #include <vector>
 
 #include "gui/sourced_message.h"
 #include "gui/state/game/detection/game_install.h"
+#include "gui/tag_set.h"
 
 namespace loot {
 static constexpr const char* GHOST_EXTENSION = ".ghost";
 
+struct LoadOrderJournalEntry {
+  // The number of seconds since the Unix epoch.
+  int64_t timestamp{0};
+  std::vector<std::string> loadOrder;
+};
+
+// What BackupLoadOrder() last wrote to a load order journal, so that the next
+// backup doesn't need to read the journal again.
+struct LoadOrderJournalState {
+  std::vector<std::string> lastLoadOrder;
+  size_t entryCount{0};
+  // The journal's size after it was written, used to check that nothing else
+  // has changed it since. Unknown if the journal hasn't been written yet.
+  std::optional<uintmax_t> fileSize;
+};
+
+// Append the load order to the load order journal in the given directory. Each
+// journal entry only records how its load order differs from the previous
+// entry's. The load order is also written as a plain text loadorder.bak.0 file
+// with one plugin per line, so that the most recent backup can be restored by
+// hand. If journal state is given, it's used to avoid reading the journal and
+// updated to reflect the new entry. Throws if the files can't be written.
 void BackupLoadOrder(const std::vector<std::string>& loadOrder,
-                     const std::filesystem::path& backupDirectory);
+                     const std::filesystem::path& backupDirectory,
+                     LoadOrderJournalState* journalState = nullptr);
+
+// Read the load orders recorded in the load order journal in the given
+// directory, from oldest to newest.
+std::vector<LoadOrderJournalEntry> ReadLoadOrderJournal(
+    const std::filesystem::path& backupDirectory);
 
 // Escape any Markdown special characters in the input text.
 std::string EscapeMarkdownASCIIPunctuation(const std::string& text);
@@ -56,6 +90,12 @@ std::vector<SourcedMessage> CheckForRemovedPlugins(
 
 std::vector<Tag> ReadBashTagsFile(std::istream& in);
 
+TagSet ReadBashTagsFileTagSet(std::istream& in);
+
+// Get the filename of the given plugin's BashTags file, which is inside the
+// game's Data/BashTags directory.
+std::string GetBashTagsFilename(const std::string& pluginName);
+
 std::vector<Tag> ReadBashTagsFile(const std::filesystem::path& dataPath,
                                   const std::string& pluginName);
 
@@ -66,6 +106,10 @@ std::vector<std::string> GetTagConflicts(const std::vector<Tag>& tags1,
 
 bool HasPluginFileExtension(const std::string& filename);
 
+// Like HasPluginFileExtension(), but also true for ghosted plugins, e.g.
+// "Blank.esp.ghost".
+bool HasPossiblyGhostedPluginFileExtension(const std::string& filename);
+
 std::filesystem::path ResolveGameFilePath(
     const std::vector<std::filesystem::path>& externalDataPaths,
     const std::filesystem::path& dataPath,
@@ -78,6 +122,28 @@ std::vector<std::filesystem::path> GetExternalDataPaths(
     const std::filesystem::path& gameLocalPath);
 
 bool IsOfficialPlugin(const GameId gameId, const std::string& pluginName);
+
+struct PluginMove {
+  std::string name;
+  size_t currentIndex{0};
+  size_t newIndex{0};
+};
+
+// Return the fewest plugin moves that turn the current load order into the
+// new load order, in new load order. The plugins that don't move are those in
+// the longest run of plugins (not necessarily adjacent) that are in the same
+// relative order in both load orders. Plugins that are only in one of the load
+// orders are ignored.
+std::vector<PluginMove> GetMinimalPluginMoves(
+    const std::vector<std::string>& currentLoadOrder,
+    const std::vector<std::string>& newLoadOrder);
+
+// Get the names of the groups that load after the given group, directly or
+// through other groups. The given groups may include more than one group with
+// the same name (e.g. masterlist and user groups), and their "after" groups
+// are combined. The given group is only included if it's part of a cycle.
+std::set<std::string> GetGroupsLoadingAfter(const std::vector<Group>& groups,
+                                            const std::string& groupName);
 }
 
 #endif
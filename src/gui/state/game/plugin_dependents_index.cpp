@@ -0,0 +1,56 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/game/plugin_dependents_index.h"
+
+#include "gui/helpers.h"
+
+namespace loot {
+void PluginDependentsIndex::AddDependencies(
+    const std::string& pluginName,
+    const std::vector<std::string>& dependencyNames) {
+  for (const auto& dependencyName : dependencyNames) {
+    auto& dependents = dependents_[NormalisePluginName(dependencyName)];
+
+    // A plugin may require one of its masters, but should only be listed
+    // once.
+    if (dependents.empty() || dependents.back() != pluginName) {
+      dependents.push_back(pluginName);
+    }
+  }
+}
+
+const std::vector<std::string>& PluginDependentsIndex::GetDependents(
+    const std::string& fileName) const {
+  static const std::vector<std::string> NO_DEPENDENTS;
+
+  const auto it = dependents_.find(NormalisePluginName(fileName));
+  if (it == dependents_.end()) {
+    return NO_DEPENDENTS;
+  }
+
+  return it->second;
+}
+}
@@ -0,0 +1,55 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_GAME_PLUGIN_DEPENDENTS_INDEX
+#define LOOT_GUI_STATE_GAME_PLUGIN_DEPENDENTS_INDEX
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace loot {
+// Maps files to the plugins that depend on them, i.e. that have them as
+// masters or requirements, so that a plugin's dependents can be found without
+// checking every plugin.
+class PluginDependentsIndex {
+public:
+  // Record that the given plugin depends on the given files. Each plugin
+  // should only be added once.
+  void AddDependencies(const std::string& pluginName,
+                       const std::vector<std::string>& dependencyNames);
+
+  // Get the plugins that depend on the given file, in the order that they
+  // were added. The comparison is case-insensitive.
+  const std::vector<std::string>& GetDependents(
+      const std::string& fileName) const;
+
+private:
+  // Keyed by lowercased file names.
+  std::unordered_map<std::string, std::vector<std::string>> dependents_;
+};
+}
+
+#endif
@@ -0,0 +1,242 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/game/plugin_file_cache.h"
+
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+constexpr uint32_t LPFC_MAGIC_NUMBER = 0x4346504C;
+constexpr uint8_t LPFC_FORMAT_VERSION = 2;
+// Version 1 files are still read, their entries just don't have CRCs.
+constexpr uint8_t LPFC_MIN_FORMAT_VERSION = 1;
+
+int64_t ToTicks(std::filesystem::file_time_type time) {
+  return static_cast<int64_t>(time.time_since_epoch().count());
+}
+
+template<typename T>
+void ReadValue(std::istream& in, T& value) {
+  in.read(reinterpret_cast<char*>(&value), sizeof value);
+}
+
+template<typename T>
+void WriteValue(std::ostream& out, const T& value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof value);
+}
+}
+
+namespace loot {
+std::optional<bool> PluginFileCache::IsValidPlugin(
+    const std::filesystem::path& path,
+    uintmax_t fileSize,
+    std::filesystem::file_time_type lastWriteTime) const {
+  const auto entry = FindEntry(path, fileSize, lastWriteTime);
+  if (entry == nullptr) {
+    return std::nullopt;
+  }
+
+  return entry->isValidPlugin;
+}
+
+void PluginFileCache::SetIsValidPlugin(
+    const std::filesystem::path& path,
+    uintmax_t fileSize,
+    std::filesystem::file_time_type lastWriteTime,
+    bool isValidPlugin) {
+  SetEntry(path.u8string(),
+           PluginFileCacheEntry{
+               fileSize, ToTicks(lastWriteTime), isValidPlugin, std::nullopt});
+}
+
+std::optional<uint32_t> PluginFileCache::GetCrc(
+    const std::filesystem::path& path,
+    uintmax_t fileSize,
+    std::filesystem::file_time_type lastWriteTime) const {
+  const auto entry = FindEntry(path, fileSize, lastWriteTime);
+  if (entry == nullptr) {
+    return std::nullopt;
+  }
+
+  return entry->crc;
+}
+
+void PluginFileCache::SetCrc(const std::filesystem::path& path,
+                             uintmax_t fileSize,
+                             std::filesystem::file_time_type lastWriteTime,
+                             uint32_t crc) {
+  const auto it = entries_.find(path.u8string());
+  if (it != entries_.end() && it->second.fileSize == fileSize &&
+      it->second.lastWriteTime == ToTicks(lastWriteTime)) {
+    it->second.crc = crc;
+    return;
+  }
+
+  SetEntry(path.u8string(),
+           PluginFileCacheEntry{fileSize, ToTicks(lastWriteTime), true, crc});
+}
+
+const std::unordered_map<std::string, PluginFileCacheEntry>&
+PluginFileCache::GetEntries() const {
+  return entries_;
+}
+
+void PluginFileCache::SetEntry(const std::string& path,
+                               const PluginFileCacheEntry& entry) {
+  entries_.insert_or_assign(path, entry);
+}
+
+void PluginFileCache::Clear() { entries_.clear(); }
+
+const PluginFileCacheEntry* PluginFileCache::FindEntry(
+    const std::filesystem::path& path,
+    uintmax_t fileSize,
+    std::filesystem::file_time_type lastWriteTime) const {
+  const auto it = entries_.find(path.u8string());
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+
+  if (it->second.fileSize != fileSize ||
+      it->second.lastWriteTime != ToTicks(lastWriteTime)) {
+    return nullptr;
+  }
+
+  return &it->second;
+}
+
+PluginFileCache LoadPluginFileCache(const std::filesystem::path& filePath) {
+  PluginFileCache cache;
+
+  if (!std::filesystem::exists(filePath)) {
+    return cache;
+  }
+
+  std::ifstream in(filePath, std::ios_base::in | std::ios_base::binary);
+  if (!in.is_open()) {
+    throw std::runtime_error(filePath.u8string() +
+                             " could not be opened for parsing");
+  }
+
+  uint32_t magicNumber{0};
+  ReadValue(in, magicNumber);
+
+  if (magicNumber != LPFC_MAGIC_NUMBER) {
+    throw std::runtime_error("Failed to parse " + filePath.u8string() +
+                             ": wrong magic number");
+  }
+
+  uint8_t formatVersion{0};
+  ReadValue(in, formatVersion);
+
+  if (formatVersion < LPFC_MIN_FORMAT_VERSION ||
+      formatVersion > LPFC_FORMAT_VERSION) {
+    throw std::runtime_error("Failed to parse " + filePath.u8string() +
+                             ": unrecognised format version");
+  }
+
+  while (in.good()) {
+    uint16_t pathLength{0};
+    ReadValue(in, pathLength);
+
+    if (!in.good()) {
+      // Handle reaching end of file.
+      break;
+    }
+
+    std::string path(pathLength, '\0');
+    in.read(path.data(), pathLength);
+
+    uint64_t fileSize{0};
+    ReadValue(in, fileSize);
+
+    int64_t lastWriteTime{0};
+    ReadValue(in, lastWriteTime);
+
+    uint8_t isValidPlugin{0};
+    ReadValue(in, isValidPlugin);
+
+    std::optional<uint32_t> crc;
+    if (formatVersion > 1) {
+      uint8_t hasCrc{0};
+      ReadValue(in, hasCrc);
+
+      uint32_t crcValue{0};
+      ReadValue(in, crcValue);
+
+      if (hasCrc != 0) {
+        crc = crcValue;
+      }
+    }
+
+    if (in.fail()) {
+      throw std::runtime_error("Failed to parse " + filePath.u8string() +
+                               ": unexpected end of file");
+    }
+
+    cache.SetEntry(path,
+                   PluginFileCacheEntry{static_cast<uintmax_t>(fileSize),
+                                        lastWriteTime,
+                                        isValidPlugin != 0,
+                                        crc});
+  }
+
+  return cache;
+}
+
+void SavePluginFileCache(const std::filesystem::path& filePath,
+                         const PluginFileCache& cache) {
+  // Don't care about endianness because the files don't need to be portable.
+
+  std::ofstream out(
+      filePath,
+      std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+  if (!out.is_open()) {
+    throw std::runtime_error(filePath.u8string() +
+                             " could not be opened for writing");
+  }
+
+  WriteValue(out, LPFC_MAGIC_NUMBER);
+  WriteValue(out, LPFC_FORMAT_VERSION);
+
+  for (const auto& [path, entry] : cache.GetEntries()) {
+    if (path.size() > UINT16_MAX) {
+      // Paths this long can't be stored, but they're not worth failing over,
+      // they just won't benefit from caching.
+      continue;
+    }
+
+    WriteValue(out, static_cast<uint16_t>(path.size()));
+    out.write(path.c_str(), path.size());
+
+    WriteValue(out, static_cast<uint64_t>(entry.fileSize));
+    WriteValue(out, entry.lastWriteTime);
+    WriteValue(out, static_cast<uint8_t>(entry.isValidPlugin ? 1 : 0));
+    WriteValue(out, static_cast<uint8_t>(entry.crc.has_value() ? 1 : 0));
+    WriteValue(out, entry.crc.value_or(0));
+  }
+}
+}
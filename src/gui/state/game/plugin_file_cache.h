@@ -0,0 +1,95 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_GAME_PLUGIN_FILE_CACHE
+#define LOOT_GUI_STATE_GAME_PLUGIN_FILE_CACHE
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace loot {
+struct PluginFileCacheEntry {
+  uintmax_t fileSize{0};
+  int64_t lastWriteTime{0};
+  bool isValidPlugin{false};
+  std::optional<uint32_t> crc;
+};
+
+// Stores the results of checking if files are valid plugins, and the CRCs of
+// plugins that have been fully loaded, so that files that have not changed
+// since LOOT last ran don't need to be opened and read again. Entries are
+// keyed on the file's path, and are only used if the file's size and last
+// write time still match.
+class PluginFileCache {
+public:
+  std::optional<bool> IsValidPlugin(
+      const std::filesystem::path& path,
+      uintmax_t fileSize,
+      std::filesystem::file_time_type lastWriteTime) const;
+
+  void SetIsValidPlugin(const std::filesystem::path& path,
+                        uintmax_t fileSize,
+                        std::filesystem::file_time_type lastWriteTime,
+                        bool isValidPlugin);
+
+  std::optional<uint32_t> GetCrc(
+      const std::filesystem::path& path,
+      uintmax_t fileSize,
+      std::filesystem::file_time_type lastWriteTime) const;
+
+  // Only plugins have CRCs recorded, so if there isn't already an entry for
+  // the given file size and last write time, the file is recorded as being a
+  // valid plugin.
+  void SetCrc(const std::filesystem::path& path,
+              uintmax_t fileSize,
+              std::filesystem::file_time_type lastWriteTime,
+              uint32_t crc);
+
+  // The keys are UTF-8 paths.
+  const std::unordered_map<std::string, PluginFileCacheEntry>& GetEntries()
+      const;
+  void SetEntry(const std::string& path, const PluginFileCacheEntry& entry);
+
+  void Clear();
+
+private:
+  const PluginFileCacheEntry* FindEntry(
+      const std::filesystem::path& path,
+      uintmax_t fileSize,
+      std::filesystem::file_time_type lastWriteTime) const;
+
+  std::unordered_map<std::string, PluginFileCacheEntry> entries_;
+};
+
+PluginFileCache LoadPluginFileCache(const std::filesystem::path& filePath);
+
+void SavePluginFileCache(const std::filesystem::path& filePath,
+                         const PluginFileCache& cache);
+}
+
+#endif
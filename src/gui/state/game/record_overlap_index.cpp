@@ -0,0 +1,324 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/game/record_overlap_index.h"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+
+#include "gui/state/thread_pool.h"
+
+namespace {
+constexpr uint32_t LROI_MAGIC_NUMBER = 0x494F524C;
+constexpr uint8_t LROI_FORMAT_VERSION = 2;
+
+std::pair<std::string, std::string> MakeOrderedPair(
+    const std::string& pluginName1,
+    const std::string& pluginName2) {
+  return pluginName1 <= pluginName2
+             ? std::make_pair(pluginName1, pluginName2)
+             : std::make_pair(pluginName2, pluginName1);
+}
+
+template<typename T>
+void ReadValue(std::istream& in, T& value) {
+  in.read(reinterpret_cast<char*>(&value), sizeof value);
+}
+
+template<typename T>
+void WriteValue(std::ostream& out, const T& value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof value);
+}
+
+std::string ReadString(std::istream& in) {
+  uint16_t length{0};
+  ReadValue(in, length);
+
+  std::string value(length, '\0');
+  in.read(value.data(), length);
+
+  return value;
+}
+
+void WriteString(std::ostream& out, const std::string& value) {
+  WriteValue(out, static_cast<uint16_t>(value.size()));
+  out.write(value.data(), value.size());
+}
+}
+
+namespace loot {
+bool RecordOverlapIndex::IsIndexed(const std::string& pluginName,
+                                   uint32_t crc) const {
+  const auto it = indexedPlugins_.find(pluginName);
+  return it != indexedPlugins_.end() && it->second == crc;
+}
+
+std::optional<bool> RecordOverlapIndex::DoRecordsOverlap(
+    const std::string& pluginName1,
+    uint32_t crc1,
+    const std::string& pluginName2,
+    uint32_t crc2) const {
+  if (!IsIndexed(pluginName1, crc1) || !IsIndexed(pluginName2, crc2)) {
+    return std::nullopt;
+  }
+
+  return overlappingPairs_.count(MakeOrderedPair(pluginName1, pluginName2)) !=
+         0;
+}
+
+void RecordOverlapIndex::Update(
+    const std::vector<const PluginInterface*>& plugins) {
+  const auto pluginsByName = RemoveChangedPlugins(plugins);
+
+  std::vector<std::pair<std::string, const PluginInterface*>> newPlugins;
+  for (const auto& entry : pluginsByName) {
+    if (indexedPlugins_.count(entry.first) == 0) {
+      newPlugins.push_back(entry);
+    }
+  }
+
+  std::vector<std::vector<std::pair<std::string, std::string>>> newOverlaps(
+      newPlugins.size());
+  parallelTransform(
+      newPlugins.begin(),
+      newPlugins.end(),
+      newOverlaps.begin(),
+      [&](const auto& newPlugin) {
+        std::vector<std::pair<std::string, std::string>> overlaps;
+        for (const auto& [name, plugin] : pluginsByName) {
+          // Pairs of new plugins only need to be compared once.
+          if (name < newPlugin.first && indexedPlugins_.count(name) == 0) {
+            continue;
+          }
+
+          if (newPlugin.second->DoRecordsOverlap(*plugin)) {
+            overlaps.push_back(MakeOrderedPair(newPlugin.first, name));
+          }
+        }
+        return overlaps;
+      });
+
+  for (const auto& [name, plugin] : newPlugins) {
+    AddIndexedPlugin(name, plugin->GetCRC().value());
+  }
+
+  for (const auto& overlaps : newOverlaps) {
+    overlappingPairs_.insert(overlaps.begin(), overlaps.end());
+  }
+}
+
+void RecordOverlapIndex::AddPlugin(
+    const std::vector<const PluginInterface*>& plugins,
+    const PluginInterface& plugin,
+    const std::vector<std::string>& overlappingPluginNames) {
+  const auto crc = plugin.GetCRC();
+  if (!crc.has_value()) {
+    return;
+  }
+
+  RemoveChangedPlugins(plugins);
+
+  const auto& name = plugin.GetName();
+  if (indexedPlugins_.count(name) != 0) {
+    return;
+  }
+
+  // The plugin is indexed first so that if it overlaps itself, that's
+  // recorded.
+  AddIndexedPlugin(name, crc.value());
+
+  // Only overlaps between indexed plugins are recorded, and the others will
+  // be compared against this plugin when they're indexed.
+  for (const auto& otherName : overlappingPluginNames) {
+    if (indexedPlugins_.count(otherName) != 0) {
+      AddOverlap(name, otherName);
+    }
+  }
+}
+
+std::unordered_map<std::string, OverlapCount>
+RecordOverlapIndex::GetOverlapCounts() const {
+  std::unordered_map<std::string, OverlapCount> counts;
+  for (const auto& [name, crc] : indexedPlugins_) {
+    counts.emplace(name, OverlapCount{crc, 0});
+  }
+
+  // A plugin overlapping with itself isn't a conflict.
+  for (const auto& [name1, name2] : overlappingPairs_) {
+    if (name1 != name2) {
+      counts[name1].count += 1;
+      counts[name2].count += 1;
+    }
+  }
+
+  return counts;
+}
+
+const std::map<std::string, uint32_t>& RecordOverlapIndex::GetIndexedPlugins()
+    const {
+  return indexedPlugins_;
+}
+
+const std::set<std::pair<std::string, std::string>>&
+RecordOverlapIndex::GetOverlappingPairs() const {
+  return overlappingPairs_;
+}
+
+void RecordOverlapIndex::AddIndexedPlugin(const std::string& pluginName,
+                                          uint32_t crc) {
+  indexedPlugins_.insert_or_assign(pluginName, crc);
+}
+
+void RecordOverlapIndex::AddOverlap(const std::string& pluginName1,
+                                    const std::string& pluginName2) {
+  overlappingPairs_.insert(MakeOrderedPair(pluginName1, pluginName2));
+}
+
+void RecordOverlapIndex::Clear() {
+  indexedPlugins_.clear();
+  overlappingPairs_.clear();
+}
+
+std::map<std::string, const PluginInterface*>
+RecordOverlapIndex::RemoveChangedPlugins(
+    const std::vector<const PluginInterface*>& plugins) {
+  std::map<std::string, const PluginInterface*> pluginsByName;
+  for (const auto plugin : plugins) {
+    if (plugin->GetCRC().has_value()) {
+      pluginsByName.emplace(plugin->GetName(), plugin);
+    }
+  }
+
+  // Forget plugins that are no longer loaded or that have changed, as new
+  // plugins won't be compared against them.
+  for (auto it = indexedPlugins_.begin(); it != indexedPlugins_.end();) {
+    const auto pluginIt = pluginsByName.find(it->first);
+    if (pluginIt == pluginsByName.end() ||
+        pluginIt->second->GetCRC().value() != it->second) {
+      it = indexedPlugins_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  for (auto it = overlappingPairs_.begin(); it != overlappingPairs_.end();) {
+    if (indexedPlugins_.count(it->first) == 0 ||
+        indexedPlugins_.count(it->second) == 0) {
+      it = overlappingPairs_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  return pluginsByName;
+}
+
+RecordOverlapIndex LoadRecordOverlapIndex(
+    const std::filesystem::path& filePath) {
+  RecordOverlapIndex index;
+
+  if (!std::filesystem::exists(filePath)) {
+    return index;
+  }
+
+  std::ifstream in(filePath, std::ios_base::in | std::ios_base::binary);
+  if (!in.is_open()) {
+    throw std::runtime_error(filePath.u8string() +
+                             " could not be opened for parsing");
+  }
+
+  uint32_t magicNumber{0};
+  ReadValue(in, magicNumber);
+
+  if (magicNumber != LROI_MAGIC_NUMBER) {
+    throw std::runtime_error("Failed to parse " + filePath.u8string() +
+                             ": wrong magic number");
+  }
+
+  uint8_t formatVersion{0};
+  ReadValue(in, formatVersion);
+
+  if (formatVersion != LROI_FORMAT_VERSION) {
+    throw std::runtime_error("Failed to parse " + filePath.u8string() +
+                             ": unrecognised format version");
+  }
+
+  uint32_t pluginCount{0};
+  ReadValue(in, pluginCount);
+
+  for (uint32_t i = 0; i < pluginCount && in.good(); ++i) {
+    const auto name = ReadString(in);
+    uint32_t crc{0};
+    ReadValue(in, crc);
+    index.AddIndexedPlugin(name, crc);
+  }
+
+  uint32_t pairCount{0};
+  ReadValue(in, pairCount);
+
+  for (uint32_t i = 0; i < pairCount && in.good(); ++i) {
+    const auto name1 = ReadString(in);
+    const auto name2 = ReadString(in);
+    index.AddOverlap(name1, name2);
+  }
+
+  if (in.fail()) {
+    throw std::runtime_error("Failed to parse " + filePath.u8string() +
+                             ": unexpected end of file");
+  }
+
+  return index;
+}
+
+void SaveRecordOverlapIndex(const std::filesystem::path& filePath,
+                            const RecordOverlapIndex& index) {
+  // Don't care about endianness because the files don't need to be portable.
+
+  std::ofstream out(
+      filePath,
+      std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+  if (!out.is_open()) {
+    throw std::runtime_error(filePath.u8string() +
+                             " could not be opened for writing");
+  }
+
+  WriteValue(out, LROI_MAGIC_NUMBER);
+  WriteValue(out, LROI_FORMAT_VERSION);
+
+  WriteValue(out, static_cast<uint32_t>(index.GetIndexedPlugins().size()));
+  for (const auto& [name, crc] : index.GetIndexedPlugins()) {
+    WriteString(out, name);
+    WriteValue(out, crc);
+  }
+
+  WriteValue(out, static_cast<uint32_t>(index.GetOverlappingPairs().size()));
+  for (const auto& [name1, name2] : index.GetOverlappingPairs()) {
+    WriteString(out, name1);
+    WriteString(out, name2);
+  }
+}
+}
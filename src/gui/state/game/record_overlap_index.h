@@ -0,0 +1,109 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_GAME_RECORD_OVERLAP_INDEX
+#define LOOT_GUI_STATE_GAME_RECORD_OVERLAP_INDEX
+
+#include <loot/plugin_interface.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace loot {
+struct OverlapCount {
+  // The CRC of the plugin when its overlaps were counted.
+  uint32_t crc{0};
+  size_t count{0};
+};
+
+// Records which pairs of plugins have overlapping records, so that the
+// overlap filter doesn't need to compare the target plugin against every
+// other plugin each time it's used. Plugins are identified by their names,
+// and the CRC that each plugin had when it was indexed is recorded so that
+// plugins that have changed since can be detected. Each indexed plugin has
+// been compared against every other indexed plugin (and itself).
+class RecordOverlapIndex {
+public:
+  bool IsIndexed(const std::string& pluginName, uint32_t crc) const;
+
+  // Returns std::nullopt if either plugin is not indexed with the given CRC.
+  std::optional<bool> DoRecordsOverlap(const std::string& pluginName1,
+                                       uint32_t crc1,
+                                       const std::string& pluginName2,
+                                       uint32_t crc2) const;
+
+  // Drops any indexed plugins that are not given or that have changed, then
+  // compares each given plugin that isn't already indexed against all the
+  // given plugins. Plugins that don't have a CRC (because they were only
+  // partially loaded) are skipped.
+  void Update(const std::vector<const PluginInterface*>& plugins);
+  // Indexes a single plugin from the result of comparing it against all the
+  // given plugins, so that the index can be built up as plugins are checked
+  // for overlaps. Like Update(), indexed plugins that are not given or that
+  // have changed are dropped first.
+  void AddPlugin(const std::vector<const PluginInterface*>& plugins,
+                 const PluginInterface& plugin,
+                 const std::vector<std::string>& overlappingPluginNames);
+
+  // Get the number of other indexed plugins that each indexed plugin has
+  // overlapping records with, keyed by the plugins' names.
+  std::unordered_map<std::string, OverlapCount> GetOverlapCounts() const;
+
+  // Indexed plugins' CRCs, keyed by the plugins' names.
+  const std::map<std::string, uint32_t>& GetIndexedPlugins() const;
+  // The first name in each pair is never greater than the second.
+  const std::set<std::pair<std::string, std::string>>& GetOverlappingPairs()
+      const;
+
+  void AddIndexedPlugin(const std::string& pluginName, uint32_t crc);
+  void AddOverlap(const std::string& pluginName1,
+                  const std::string& pluginName2);
+
+  void Clear();
+
+private:
+  // Returns the given plugins that have CRCs, keyed by their names.
+  std::map<std::string, const PluginInterface*> RemoveChangedPlugins(
+      const std::vector<const PluginInterface*>& plugins);
+
+  std::map<std::string, uint32_t> indexedPlugins_;
+  std::set<std::pair<std::string, std::string>> overlappingPairs_;
+};
+
+RecordOverlapIndex LoadRecordOverlapIndex(
+    const std::filesystem::path& filePath);
+
+void SaveRecordOverlapIndex(const std::filesystem::path& filePath,
+                            const RecordOverlapIndex& index);
+}
+
+#endif
@@ -0,0 +1,209 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/game/sort_result_cache.h"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+constexpr uint32_t LSRC_MAGIC_NUMBER = 0x4352534C;
+constexpr uint8_t LSRC_FORMAT_VERSION = 1;
+constexpr uint64_t FNV_PRIME = 0x100000001b3;
+
+// The condition functions that take a file path as their first argument.
+constexpr std::array<std::string_view, 10> PATH_CONDITION_FUNCTIONS{
+    "file(",
+    "readable(",
+    "is_executable(",
+    "many(",
+    "checksum(",
+    "version(",
+    "is_master(",
+    "description(",
+    "file_size(",
+    "product_version("};
+
+template<typename T>
+void ReadValue(std::istream& in, T& value) {
+  in.read(reinterpret_cast<char*>(&value), sizeof value);
+}
+
+template<typename T>
+void WriteValue(std::ostream& out, const T& value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof value);
+}
+}
+
+namespace loot {
+void SortInputsHasher::Add(std::string_view value) {
+  // Include the length so that adjacent values can't run into each other.
+  Add(static_cast<uint64_t>(value.size()));
+  AddBytes(value.data(), value.size());
+}
+
+void SortInputsHasher::Add(uint64_t value) {
+  AddBytes(reinterpret_cast<const char*>(&value), sizeof value);
+}
+
+uint64_t SortInputsHasher::GetHash() const { return hash_; }
+
+void SortInputsHasher::AddBytes(const char* bytes, size_t length) {
+  for (size_t i = 0; i < length; ++i) {
+    hash_ ^= static_cast<uint8_t>(bytes[i]);
+    hash_ *= FNV_PRIME;
+  }
+}
+
+std::set<std::string> GetConditionSubdirectories(std::string_view content) {
+  // This scans the text instead of parsing the metadata, as it only needs to
+  // find a superset of the paths that conditions check. Paths may be regexes,
+  // but only in their filename.
+  std::set<std::string> subdirectories;
+
+  for (auto pos = content.find('('); pos != std::string_view::npos;
+       pos = content.find('(', pos + 1)) {
+    const auto isPathFunction = std::any_of(
+        PATH_CONDITION_FUNCTIONS.begin(),
+        PATH_CONDITION_FUNCTIONS.end(),
+        [&](std::string_view function) {
+          const auto nameLength = function.size() - 1;
+          return pos >= nameLength &&
+                 content.substr(pos - nameLength, function.size()) == function;
+        });
+    if (!isPathFunction) {
+      continue;
+    }
+
+    auto start = content.find_first_not_of(' ', pos + 1);
+    // The quote is escaped if the condition is in a double-quoted YAML string.
+    if (start != std::string_view::npos && content[start] == '\\') {
+      start += 1;
+    }
+    if (start >= content.size() || content[start] != '"') {
+      continue;
+    }
+    start += 1;
+
+    auto end = content.find('"', start);
+    if (end == std::string_view::npos) {
+      break;
+    }
+    if (end > start && content[end - 1] == '\\') {
+      end -= 1;
+    }
+
+    const auto path = content.substr(start, end - start);
+    const auto lastSlash = path.rfind('/');
+    if (lastSlash != std::string_view::npos && lastSlash != 0) {
+      subdirectories.emplace(path.substr(0, lastSlash));
+    }
+  }
+
+  return subdirectories;
+}
+
+std::optional<CachedSortResult> LoadCachedSortResult(
+    const std::filesystem::path& filePath) {
+  if (!std::filesystem::exists(filePath)) {
+    return std::nullopt;
+  }
+
+  std::ifstream in(filePath, std::ios_base::in | std::ios_base::binary);
+  if (!in.is_open()) {
+    throw std::runtime_error(filePath.u8string() +
+                             " could not be opened for parsing");
+  }
+
+  uint32_t magicNumber{0};
+  ReadValue(in, magicNumber);
+
+  if (magicNumber != LSRC_MAGIC_NUMBER) {
+    throw std::runtime_error("Failed to parse " + filePath.u8string() +
+                             ": wrong magic number");
+  }
+
+  uint8_t formatVersion{0};
+  ReadValue(in, formatVersion);
+
+  if (formatVersion != LSRC_FORMAT_VERSION) {
+    throw std::runtime_error("Failed to parse " + filePath.u8string() +
+                             ": unrecognised format version");
+  }
+
+  CachedSortResult result;
+  ReadValue(in, result.inputsHash);
+
+  uint32_t pluginCount{0};
+  ReadValue(in, pluginCount);
+
+  for (uint32_t i = 0; i < pluginCount && in.good(); ++i) {
+    uint16_t nameLength{0};
+    ReadValue(in, nameLength);
+
+    std::string name(nameLength, '\0');
+    in.read(name.data(), nameLength);
+
+    result.sortedPlugins.push_back(std::move(name));
+  }
+
+  if (in.fail()) {
+    throw std::runtime_error("Failed to parse " + filePath.u8string() +
+                             ": unexpected end of file");
+  }
+
+  return result;
+}
+
+void SaveCachedSortResult(const std::filesystem::path& filePath,
+                          const CachedSortResult& result) {
+  // Don't care about endianness because the files don't need to be portable.
+
+  std::ofstream out(
+      filePath,
+      std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+  if (!out.is_open()) {
+    throw std::runtime_error(filePath.u8string() +
+                             " could not be opened for writing");
+  }
+
+  WriteValue(out, LSRC_MAGIC_NUMBER);
+  WriteValue(out, LSRC_FORMAT_VERSION);
+  WriteValue(out, result.inputsHash);
+  WriteValue(out, static_cast<uint32_t>(result.sortedPlugins.size()));
+
+  for (const auto& name : result.sortedPlugins) {
+    if (name.size() > UINT16_MAX) {
+      throw std::runtime_error("Failed to write " + filePath.u8string() +
+                               ": plugin name is too long");
+    }
+
+    WriteValue(out, static_cast<uint16_t>(name.size()));
+    out.write(name.c_str(), name.size());
+  }
+}
+}
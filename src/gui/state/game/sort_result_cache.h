@@ -0,0 +1,73 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_GAME_SORT_RESULT_CACHE
+#define LOOT_GUI_STATE_GAME_SORT_RESULT_CACHE
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace loot {
+// Accumulates a 64-bit FNV-1a hash of the inputs to sorting. The hash is
+// stable across runs, so it can be saved and compared in a later session.
+class SortInputsHasher {
+public:
+  void Add(std::string_view value);
+  void Add(uint64_t value);
+
+  uint64_t GetHash() const;
+
+private:
+  void AddBytes(const char* bytes, size_t length);
+
+  uint64_t hash_{0xcbf29ce484222325};
+};
+
+// The result of the last successful sort, so that sorting again without any
+// of its inputs having changed can reuse the result instead of sorting again.
+struct CachedSortResult {
+  uint64_t inputsHash{0};
+  std::vector<std::string> sortedPlugins;
+};
+
+// Get the parent directories of the paths that conditions in the given
+// metadata file content check, excluding paths that have no parent. Paths are
+// relative to the data path, as in the conditions themselves.
+std::set<std::string> GetConditionSubdirectories(std::string_view content);
+
+// Returns std::nullopt if the file does not exist.
+std::optional<CachedSortResult> LoadCachedSortResult(
+    const std::filesystem::path& filePath);
+
+void SaveCachedSortResult(const std::filesystem::path& filePath,
+                          const CachedSortResult& result);
+}
+
+#endif
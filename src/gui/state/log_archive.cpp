@@ -0,0 +1,328 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/log_archive.h"
+
+#include <mz.h>
+#include <mz_strm.h>
+#include <mz_zip.h>
+#include <mz_zip_rw.h>
+
+#include <QtCore/QDateTime>
+#include <algorithm>
+#include <iomanip>
+#include <optional>
+#include <sstream>
+
+#include "gui/state/logging.h"
+
+namespace {
+constexpr const char* SEGMENT_SEPARATOR = "-";
+constexpr const char* ARCHIVE_EXTENSION = ".zip";
+
+std::string getArchivePrefix(const std::filesystem::path& logPath) {
+  return logPath.stem().u8string() + SEGMENT_SEPARATOR;
+}
+
+void logArchiveError(const std::string& message) {
+  const auto logger = loot::getLogger();
+  if (logger) {
+    logger->error(message);
+  }
+}
+}
+
+namespace loot {
+std::filesystem::path getLogSegmentPath(
+    const std::filesystem::path& logPath,
+    const std::filesystem::path& archiveDir,
+    std::chrono::system_clock::time_point time,
+    unsigned int sequenceNumber) {
+  const auto secondsSinceEpoch =
+      std::chrono::duration_cast<std::chrono::seconds>(
+          time.time_since_epoch())
+          .count();
+  const auto timestamp = QDateTime::fromSecsSinceEpoch(secondsSinceEpoch)
+                             .toString("yyyyMMddThhmmss")
+                             .toStdString();
+
+  std::ostringstream filename;
+  filename << getArchivePrefix(logPath) << timestamp << SEGMENT_SEPARATOR
+           << std::setw(3) << std::setfill('0') << sequenceNumber
+           << logPath.extension().u8string();
+
+  return archiveDir / std::filesystem::u8path(filename.str());
+}
+
+std::vector<std::filesystem::path> findLogArchives(
+    const std::filesystem::path& logPath,
+    const std::filesystem::path& archiveDir) {
+  std::vector<std::filesystem::path> archives;
+
+  std::error_code errorCode;
+  std::filesystem::directory_iterator it(archiveDir, errorCode);
+  if (errorCode) {
+    return archives;
+  }
+
+  const auto prefix = getArchivePrefix(logPath);
+  const auto segmentExtension = logPath.extension().u8string();
+
+  for (; it != std::filesystem::directory_iterator(); it.increment(errorCode)) {
+    if (errorCode) {
+      break;
+    }
+
+    if (!it->is_regular_file()) {
+      continue;
+    }
+
+    const auto filename = it->path().filename().u8string();
+    const auto extension = it->path().extension().u8string();
+    if (filename.rfind(prefix, 0) == 0 &&
+        (extension == segmentExtension || extension == ARCHIVE_EXTENSION)) {
+      archives.push_back(it->path());
+    }
+  }
+
+  // Segment names start with their timestamp and sequence number, so sorting
+  // by name sorts them by age, and a segment sorts next to its archive.
+  std::sort(archives.begin(), archives.end());
+
+  return archives;
+}
+
+std::filesystem::path compressLogSegment(const std::filesystem::path& segment) {
+  auto archivePath = segment;
+  archivePath += ARCHIVE_EXTENSION;
+
+  // Write to a temporary file first so that an interrupted compression
+  // doesn't leave a truncated archive that looks complete.
+  auto tempPath = archivePath;
+  tempPath += ".tmp";
+
+  const auto tempPathString = tempPath.u8string();
+  const auto segmentPathString = segment.u8string();
+  const auto entryName = segment.filename().u8string();
+
+  auto zipWriter = mz_zip_writer_create();
+
+  mz_zip_writer_set_compress_method(zipWriter, MZ_COMPRESS_METHOD_DEFLATE);
+
+  auto result =
+      mz_zip_writer_open_file(zipWriter, tempPathString.c_str(), 0, 0);
+  if (result != MZ_OK) {
+    mz_zip_writer_delete(&zipWriter);
+
+    throw std::runtime_error("Failed to open zip file at " + tempPathString +
+                             ", got error code " + std::to_string(result));
+  }
+
+  result = mz_zip_writer_add_file(
+      zipWriter, segmentPathString.c_str(), entryName.c_str());
+
+  mz_zip_writer_close(zipWriter);
+  mz_zip_writer_delete(&zipWriter);
+
+  if (result != MZ_OK) {
+    std::filesystem::remove(tempPath);
+
+    throw std::runtime_error("Failed to add " + segmentPathString +
+                             " to zip file, got error code " +
+                             std::to_string(result));
+  }
+
+  std::filesystem::rename(tempPath, archivePath);
+  std::filesystem::remove(segment);
+
+  return archivePath;
+}
+
+size_t pruneLogArchives(const std::filesystem::path& logPath,
+                        const std::filesystem::path& archiveDir,
+                        size_t maxCount) {
+  const auto archives = findLogArchives(logPath, archiveDir);
+  if (archives.size() <= maxCount) {
+    return 0;
+  }
+
+  const auto countToDelete = archives.size() - maxCount;
+  size_t deletedCount = 0;
+  for (size_t i = 0; i < countToDelete; i += 1) {
+    std::error_code errorCode;
+    if (std::filesystem::remove(archives[i], errorCode)) {
+      deletedCount += 1;
+    }
+  }
+
+  return deletedCount;
+}
+
+LogArchiver::LogArchiver(const std::filesystem::path& logPath,
+                         const std::filesystem::path& archiveDir,
+                         size_t maxArchives) :
+    logPath_(logPath),
+    archiveDir_(archiveDir),
+    maxArchives_(maxArchives),
+    thread_([this]() { run(); }) {}
+
+LogArchiver::~LogArchiver() { stop(); }
+
+const std::filesystem::path& LogArchiver::getArchiveDir() const {
+  return archiveDir_;
+}
+
+bool LogArchiver::rotate() {
+  // This is called on the thread that writes the log, so it mustn't log.
+  std::error_code errorCode;
+  if (!std::filesystem::exists(logPath_, errorCode)) {
+    return !errorCode;
+  }
+
+  const auto size = std::filesystem::file_size(logPath_, errorCode);
+  if (errorCode) {
+    return false;
+  }
+  if (size == 0) {
+    return true;
+  }
+
+  std::filesystem::create_directories(archiveDir_, errorCode);
+  if (errorCode) {
+    return false;
+  }
+
+  const auto now = std::chrono::system_clock::now();
+
+  std::filesystem::path segment;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    do {
+      segment = getLogSegmentPath(logPath_, archiveDir_, now, sequenceNumber_);
+      sequenceNumber_ += 1;
+    } while (std::filesystem::exists(segment, errorCode));
+  }
+
+  std::filesystem::rename(logPath_, segment, errorCode);
+  if (errorCode) {
+    return false;
+  }
+
+  enqueue(segment);
+
+  return true;
+}
+
+void LogArchiver::compressLeftoverSegments() {
+  const auto segmentExtension = logPath_.extension().u8string();
+  for (const auto& path : findLogArchives(logPath_, archiveDir_)) {
+    if (path.extension().u8string() == segmentExtension) {
+      enqueue(path);
+    }
+  }
+}
+
+void LogArchiver::setMaxArchives(size_t maxArchives) {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    maxArchives_ = maxArchives;
+  }
+
+  // Prune on the background thread, as there may be many files to delete.
+  condition_.notify_one();
+}
+
+void LogArchiver::stop() {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    stopping_ = true;
+  }
+  condition_.notify_one();
+
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void LogArchiver::enqueue(const std::filesystem::path& segment) {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (std::find(queue_.begin(), queue_.end(), segment) != queue_.end()) {
+      return;
+    }
+    queue_.push_back(segment);
+  }
+  condition_.notify_one();
+}
+
+void LogArchiver::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  size_t prunedMaxArchives = 0;
+  bool hasPruned = false;
+
+  while (true) {
+    condition_.wait(lock, [&]() {
+      return stopping_ || !queue_.empty() || !hasPruned ||
+             prunedMaxArchives != maxArchives_;
+    });
+
+    if (stopping_) {
+      return;
+    }
+
+    std::optional<std::filesystem::path> segment;
+    if (!queue_.empty()) {
+      segment = queue_.front();
+      queue_.pop_front();
+    }
+    const auto maxArchives = maxArchives_;
+
+    lock.unlock();
+
+    if (segment.has_value()) {
+      try {
+        // The segment may have been pruned while it was queued.
+        if (std::filesystem::exists(segment.value())) {
+          compressLogSegment(segment.value());
+        }
+      } catch (const std::exception& e) {
+        logArchiveError("Failed to compress the log segment at " +
+                        segment.value().u8string() + ": " + e.what());
+      }
+    }
+
+    try {
+      pruneLogArchives(logPath_, archiveDir_, maxArchives);
+    } catch (const std::exception& e) {
+      logArchiveError(std::string("Failed to delete old logs: ") + e.what());
+    }
+
+    lock.lock();
+
+    hasPruned = true;
+    prunedMaxArchives = maxArchives;
+  }
+}
+}
@@ -0,0 +1,115 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_LOG_ARCHIVE
+#define LOOT_GUI_STATE_LOG_ARCHIVE
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace loot {
+// Get the path that a log file's current content should be moved to when it's
+// rotated. The name includes the given time and a sequence number so that
+// segments sort in the order they were written.
+std::filesystem::path getLogSegmentPath(
+    const std::filesystem::path& logPath,
+    const std::filesystem::path& archiveDir,
+    std::chrono::system_clock::time_point time,
+    unsigned int sequenceNumber);
+
+// Get the rotated segments and archives of the given log file that are in
+// the given directory, oldest first.
+std::vector<std::filesystem::path> findLogArchives(
+    const std::filesystem::path& logPath,
+    const std::filesystem::path& archiveDir);
+
+// Compresses the given log segment into a zip file next to it and then
+// deletes the segment. Returns the path to the zip file.
+std::filesystem::path compressLogSegment(const std::filesystem::path& segment);
+
+// Deletes the oldest rotated segments and archives of the given log file
+// until no more than maxCount remain. Returns the number of files deleted.
+size_t pruneLogArchives(const std::filesystem::path& logPath,
+                        const std::filesystem::path& archiveDir,
+                        size_t maxCount);
+
+// Compresses rotated log segments on a background thread, so that the thread
+// writing the log only has to rename the file, and prunes old archives once
+// each segment has been compressed.
+class LogArchiver {
+public:
+  LogArchiver(const std::filesystem::path& logPath,
+              const std::filesystem::path& archiveDir,
+              size_t maxArchives);
+  ~LogArchiver();
+
+  LogArchiver(const LogArchiver&) = delete;
+  LogArchiver(LogArchiver&&) = delete;
+  LogArchiver& operator=(const LogArchiver&) = delete;
+  LogArchiver& operator=(LogArchiver&&) = delete;
+
+  const std::filesystem::path& getArchiveDir() const;
+
+  // Moves the log file's current content into a new segment, which is then
+  // compressed in the background. The log file must be closed. Returns false
+  // if the log file could not be moved.
+  bool rotate();
+
+  // Queues any segments that were left uncompressed, e.g. because LOOT
+  // exited before they could be compressed.
+  void compressLeftoverSegments();
+
+  void setMaxArchives(size_t maxArchives);
+
+  // Finishes compressing the current segment, if any, and stops the
+  // background thread. Segments that are still queued are left uncompressed
+  // to be picked up the next time LOOT runs, so that exiting isn't delayed.
+  void stop();
+
+private:
+  void enqueue(const std::filesystem::path& segment);
+  void run();
+
+  const std::filesystem::path logPath_;
+  const std::filesystem::path archiveDir_;
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::deque<std::filesystem::path> queue_;
+  size_t maxArchives_;
+  unsigned int sequenceNumber_{0};
+  bool stopping_{false};
+  std::thread thread_;
+};
+}
+
+#endif
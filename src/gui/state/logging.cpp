@@ -25,13 +25,20 @@
 
 #include "gui/state/logging.h"
 
-#include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/async.h>
+#include <spdlog/details/file_helper.h>
+#include <spdlog/sinks/base_sink.h>
 #include <spdlog/sinks/stdout_sinks.h>
 
-#include <boost/algorithm/string/replace.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <optional>
+#include <tuple>
 
 #include "gui/helpers.h"
+#include "gui/state/log_archive.h"
 
 #ifdef _WIN32
 #ifndef UNICODE
@@ -49,12 +56,166 @@
 namespace loot {
 static const char* LOGGER_NAME = "loot_logger";
 
+// The number of messages that can be queued for the logging thread to write
+// before logging blocks until there's space.
+static constexpr size_t LOG_QUEUE_SIZE = 8192;
+
+static constexpr std::chrono::seconds LOG_FLUSH_INTERVAL =
+    std::chrono::seconds(1);
+
+static constexpr uintmax_t DEFAULT_MAX_LOG_FILE_SIZE = 10 * 1024 * 1024;
+
+static constexpr size_t DEFAULT_MAX_LOG_ARCHIVES = 5;
+
+// The size that the log file can reach before its content is moved into the
+// archive directory. Zero means that the log file is never rotated.
+static std::atomic<uintmax_t> maxLogFileSize{DEFAULT_MAX_LOG_FILE_SIZE};
+
+static std::atomic<size_t> maxLogArchives{DEFAULT_MAX_LOG_ARCHIVES};
+
+// Only accessed using the atomic shared_ptr functions.
+static std::shared_ptr<LogArchiver> currentLogArchiver;
+
+// Cache the logger so that getting it doesn't involve locking spdlog's
+// registry. It's only accessed using the atomic shared_ptr functions.
+static std::shared_ptr<spdlog::logger> currentLogger;
+
+// The current logger's level, so that it can be checked without getting the
+// logger.
+static std::atomic<spdlog::level::level_enum> currentLogLevel{
+    spdlog::level::info};
+
+static constexpr size_t LOG_CATEGORY_COUNT = 5;
+
+static constexpr std::array<std::string_view, LOG_CATEGORY_COUNT>
+    LOG_CATEGORY_NAMES = {"detection", "loading", "sorting", "network", "ui"};
+
+// Loggers for each category, created from the current logger when they're
+// first needed. They're only accessed using the atomic shared_ptr functions.
+static std::array<std::shared_ptr<spdlog::logger>, LOG_CATEGORY_COUNT>
+    categoryLoggers;
+
+// The level that each category has been explicitly set to, plus one so that
+// zero can mean that the category uses the current logger's level.
+static std::array<std::atomic<int>, LOG_CATEGORY_COUNT> categoryLevelOverrides;
+
+// Each category's level, so that it can be checked without getting the
+// category's logger.
+static std::array<std::atomic<spdlog::level::level_enum>, LOG_CATEGORY_COUNT>
+    categoryLogLevels = {spdlog::level::info,
+                         spdlog::level::info,
+                         spdlog::level::info,
+                         spdlog::level::info,
+                         spdlog::level::info};
+
+size_t getIndex(LogCategory category) {
+  return static_cast<size_t>(category);
+}
+
+void updateCategoryLevel(size_t index) {
+  const auto overrideLevel =
+      categoryLevelOverrides.at(index).load(std::memory_order_relaxed);
+  const auto level =
+      overrideLevel == 0
+          ? currentLogLevel.load(std::memory_order_relaxed)
+          : static_cast<spdlog::level::level_enum>(overrideLevel - 1);
+
+  categoryLogLevels.at(index).store(level, std::memory_order_relaxed);
+
+  const auto logger = std::atomic_load(&categoryLoggers.at(index));
+  if (logger) {
+    logger->set_level(level);
+  }
+}
+
+void updateCategoryLevels() {
+  for (size_t i = 0; i < LOG_CATEGORY_COUNT; i += 1) {
+    updateCategoryLevel(i);
+  }
+}
+
+void setCurrentLogger(const std::shared_ptr<spdlog::logger>& logger) {
+  if (logger) {
+    currentLogLevel.store(logger->level(), std::memory_order_relaxed);
+  }
+
+  std::atomic_store(&currentLogger, logger);
+
+  // The category loggers write to the previous logger's sinks.
+  for (auto& categoryLogger : categoryLoggers) {
+    std::atomic_store(&categoryLogger, std::shared_ptr<spdlog::logger>());
+  }
+
+  updateCategoryLevels();
+}
+
+// Writes to a file that is handed to the log archiver once it reaches the
+// maximum log file size, so that a long session doesn't produce a huge file.
+class RotatingFileSink : public spdlog::sinks::base_sink<std::mutex> {
+public:
+  RotatingFileSink(const spdlog::filename_t& filename,
+                   std::shared_ptr<LogArchiver> archiver) :
+      filename_(filename), archiver_(std::move(archiver)) {
+    fileHelper_.open(filename_, true);
+  }
+
+protected:
+  void sink_it_(const spdlog::details::log_msg& msg) override {
+    spdlog::memory_buf_t formatted;
+    formatter_->format(msg, formatted);
+
+    const auto maxSize = maxLogFileSize.load(std::memory_order_relaxed);
+    if (maxSize > 0 && currentSize_ > 0 &&
+        currentSize_ + formatted.size() > maxSize) {
+      rotate();
+    }
+
+    fileHelper_.write(formatted);
+    currentSize_ += formatted.size();
+  }
+
+  void flush_() override { fileHelper_.flush(); }
+
+private:
+  spdlog::filename_t filename_;
+  std::shared_ptr<LogArchiver> archiver_;
+  spdlog::details::file_helper fileHelper_;
+  uintmax_t currentSize_{0};
+
+  void rotate() {
+    fileHelper_.close();
+
+    // If the file couldn't be moved (e.g. because another program has it
+    // open), keep appending to it, and try again once another maximum file
+    // size's worth of messages has been written.
+    archiver_->rotate();
+
+    fileHelper_.open(filename_, false);
+    currentSize_ = 0;
+  }
+};
+
 class CensoringFileSink : public spdlog::sinks::sink {
 public:
   explicit CensoringFileSink(
       const spdlog::filename_t& filename,
+      const std::shared_ptr<LogArchiver>& archiver,
       const std::vector<std::pair<std::string, std::string>>& stringsToCensor) :
-      sink(filename), stringsToCensor_(stringsToCensor) {}
+      sink(filename, archiver) {
+    for (const auto& stringToCensor : stringsToCensor) {
+      // An empty string would match everywhere.
+      if (!stringToCensor.first.empty()) {
+        stringsToCensor_.push_back(stringToCensor);
+      }
+    }
+
+    // The searchers refer to the strings to censor, so they can only be
+    // created once those strings won't move.
+    searchers_.reserve(stringsToCensor_.size());
+    for (const auto& [search, replacement] : stringsToCensor_) {
+      searchers_.emplace_back(search.data(), search.data() + search.size());
+    }
+  }
 
 protected:
   void log(const spdlog::details::log_msg& msg) {
@@ -63,21 +224,37 @@ protected:
       return;
     }
 
-    if (!needsCensoring(msg.payload)) {
+    // Build the censored payload in a single pass. The buffer only allocates
+    // if the payload is longer than its inline storage.
+    const auto payloadBegin = msg.payload.data();
+    const auto payloadEnd = payloadBegin + msg.payload.size();
+
+    spdlog::memory_buf_t censoredPayload;
+    auto unsearchedBegin = payloadBegin;
+    auto match = findFirstMatch(unsearchedBegin, payloadEnd);
+
+    if (!match.has_value()) {
       // Avoid unnecessary copies.
       sink.log(msg);
       return;
     }
 
-    spdlog::details::log_msg msgCopy = msg;
+    while (match.has_value()) {
+      const auto [matchBegin, matchEnd, replacement] = match.value();
 
-    std::string payload(msg.payload.data(), msg.payload.size());
+      censoredPayload.append(unsearchedBegin, matchBegin);
+      censoredPayload.append(replacement->data(),
+                             replacement->data() + replacement->size());
 
-    for (const auto& [search, replacement] : stringsToCensor_) {
-      boost::replace_all(payload, search, replacement);
+      unsearchedBegin = matchEnd;
+      match = findFirstMatch(unsearchedBegin, payloadEnd);
     }
 
-    msgCopy.payload = payload;
+    censoredPayload.append(unsearchedBegin, payloadEnd);
+
+    spdlog::details::log_msg msgCopy = msg;
+    msgCopy.payload =
+        spdlog::string_view_t(censoredPayload.data(), censoredPayload.size());
 
     sink.log(msgCopy);
   }
@@ -91,19 +268,34 @@ protected:
   }
 
 private:
-  spdlog::sinks::basic_file_sink_mt sink;
-  std::vector<std::pair<std::string, std::string>> stringsToCensor_;
+  typedef std::boyer_moore_horspool_searcher<const char*> Searcher;
+  typedef std::tuple<const char*, const char*, const std::string*> Match;
 
-  bool needsCensoring(const spdlog::string_view_t& payload) {
-    std::string_view view(payload.data(), payload.size());
+  RotatingFileSink sink;
+  std::vector<std::pair<std::string, std::string>> stringsToCensor_;
+  std::vector<Searcher> searchers_;
+
+  // Find the earliest match of any of the strings to censor, preferring the
+  // longest if more than one starts at the same position.
+  std::optional<Match> findFirstMatch(const char* begin,
+                                      const char* end) const {
+    std::optional<Match> firstMatch;
+
+    for (size_t i = 0; i < searchers_.size(); i += 1) {
+      const auto [matchBegin, matchEnd] = searchers_[i](begin, end);
+      if (matchBegin == end) {
+        continue;
+      }
 
-    for (const auto& [search, replacement] : stringsToCensor_) {
-      if (view.find(search) != std::string_view::npos) {
-        return true;
+      if (!firstMatch.has_value() ||
+          matchBegin < std::get<0>(firstMatch.value()) ||
+          (matchBegin == std::get<0>(firstMatch.value()) &&
+           matchEnd > std::get<1>(firstMatch.value()))) {
+        firstMatch = Match(matchBegin, matchEnd, &stringsToCensor_[i].second);
       }
     }
 
-    return false;
+    return firstMatch;
   }
 };
 
@@ -118,7 +310,12 @@ std::vector<std::pair<std::string, std::string>> getStringsToCensor() {
 }
 
 std::shared_ptr<spdlog::logger> getLogger() {
-  auto logger = spdlog::get(LOGGER_NAME);
+  auto logger = std::atomic_load(&currentLogger);
+  if (logger) {
+    return logger;
+  }
+
+  logger = spdlog::get(LOGGER_NAME);
 
   if (!logger) {
     spdlog::set_pattern("[%T.%f] [%l]: %v");
@@ -133,13 +330,90 @@ std::shared_ptr<spdlog::logger> getLogger() {
     }
   }
 
+  setCurrentLogger(logger);
+
   return logger;
 }
 
-void setLogPath(const std::filesystem::path& outputFile) {
+bool isLogLevelEnabled(spdlog::level::level_enum level) {
+  return level >= currentLogLevel.load(std::memory_order_relaxed);
+}
+
+std::string_view getLogCategoryName(LogCategory category) {
+  return LOG_CATEGORY_NAMES.at(getIndex(category));
+}
+
+std::optional<LogCategory> parseLogCategory(std::string_view name) {
+  for (size_t i = 0; i < LOG_CATEGORY_COUNT; i += 1) {
+    if (LOG_CATEGORY_NAMES.at(i) == name) {
+      return static_cast<LogCategory>(i);
+    }
+  }
+
+  return std::nullopt;
+}
+
+std::shared_ptr<spdlog::logger> getLogger(LogCategory category) {
+  const auto index = getIndex(category);
+  auto logger = std::atomic_load(&categoryLoggers.at(index));
+  if (logger) {
+    return logger;
+  }
+
+  const auto parentLogger = getLogger();
+  if (!parentLogger) {
+    return nullptr;
+  }
+
+  // Cloning shares the parent's sinks (and for an async logger, its thread
+  // pool), so messages are written to the same places in the same order.
+  logger = parentLogger->clone(std::string(LOGGER_NAME) + "." +
+                               std::string(getLogCategoryName(category)));
+  logger->set_level(
+      categoryLogLevels.at(index).load(std::memory_order_relaxed));
+
+  std::atomic_store(&categoryLoggers.at(index), logger);
+
+  return logger;
+}
+
+bool isLogLevelEnabled(LogCategory category, spdlog::level::level_enum level) {
+  return level >= categoryLogLevels.at(getIndex(category))
+                      .load(std::memory_order_relaxed);
+}
+
+void setLogLevel(LogCategory category,
+                 std::optional<spdlog::level::level_enum> level) {
+  const auto index = getIndex(category);
+  categoryLevelOverrides.at(index).store(
+      level.has_value() ? static_cast<int>(level.value()) + 1 : 0,
+      std::memory_order_relaxed);
+
+  updateCategoryLevel(index);
+}
+
+void setLogPath(const std::filesystem::path& outputFile,
+                const std::filesystem::path& archiveDir) {
   spdlog::set_pattern("[%T.%f] [%l]: %v");
 
   spdlog::drop(LOGGER_NAME);
+  setCurrentLogger(nullptr);
+
+  // Keep the previous session's log by moving it into the archive directory
+  // instead of overwriting it. Compressing it and any segments that the
+  // previous session didn't get to happens in the background.
+  auto archiver = std::make_shared<LogArchiver>(
+      outputFile,
+      archiveDir,
+      maxLogArchives.load(std::memory_order_relaxed));
+  archiver->rotate();
+  archiver->compressLeftoverSegments();
+
+  const auto previousArchiver =
+      std::atomic_exchange(&currentLogArchiver, archiver);
+  if (previousArchiver) {
+    previousArchiver->stop();
+  }
 
 #if defined(_WIN32) && defined(SPDLOG_WCHAR_FILENAMES)
   const auto platformFilePath = outputFile.wstring();
@@ -148,13 +422,83 @@ void setLogPath(const std::filesystem::path& outputFile) {
 #endif
   const auto stringsToCensor = getStringsToCensor();
 
-  auto logger = spdlog::synchronous_factory::create<CensoringFileSink>(
-      LOGGER_NAME, platformFilePath, stringsToCensor);
+  // Write messages to the file on a separate thread so that logging (e.g.
+  // from inside parallel loops) doesn't wait on file I/O. Messages are
+  // flushed periodically and whenever a warning or error is logged, so that
+  // they're not held back if LOOT then crashes.
+  if (!spdlog::thread_pool()) {
+    spdlog::init_thread_pool(LOG_QUEUE_SIZE, 1);
+  }
+
+  auto logger = spdlog::async_factory::create<CensoringFileSink>(
+      LOGGER_NAME, platformFilePath, archiver, stringsToCensor);
 
   if (!logger) {
     throw std::runtime_error("Error: Could not initialise logging.");
   }
-  logger->flush_on(spdlog::level::trace);
+  logger->flush_on(spdlog::level::warn);
+
+  setCurrentLogger(logger);
+
+  spdlog::flush_every(LOG_FLUSH_INTERVAL);
+}
+
+void setLogLevels(const std::map<std::string, std::string>& levels) {
+  std::array<std::optional<spdlog::level::level_enum>, LOG_CATEGORY_COUNT>
+      newLevels;
+
+  const auto logger = getLogger();
+  for (const auto& [categoryName, levelName] : levels) {
+    const auto category = parseLogCategory(categoryName);
+    if (!category.has_value()) {
+      if (logger) {
+        logger->warn("Ignoring the level of unknown log category \"{}\"",
+                     categoryName);
+      }
+      continue;
+    }
+
+    // spdlog::level::from_str() returns off for unrecognised names, so check
+    // that the name round-trips.
+    const auto level = spdlog::level::from_str(levelName);
+    if (level == spdlog::level::off && levelName != "off") {
+      if (logger) {
+        logger->warn("Ignoring unknown log level \"{}\" for category \"{}\"",
+                     levelName,
+                     categoryName);
+      }
+      continue;
+    }
+
+    newLevels.at(getIndex(category.value())) = level;
+  }
+
+  for (size_t i = 0; i < LOG_CATEGORY_COUNT; i += 1) {
+    setLogLevel(static_cast<LogCategory>(i), newLevels.at(i));
+  }
+}
+
+void setLogRotation(uintmax_t maxFileSize, size_t maxArchives) {
+  maxLogFileSize.store(maxFileSize, std::memory_order_relaxed);
+  maxLogArchives.store(maxArchives, std::memory_order_relaxed);
+
+  const auto archiver = std::atomic_load(&currentLogArchiver);
+  if (archiver) {
+    archiver->setMaxArchives(maxArchives);
+  }
+}
+
+void shutdownLogging() {
+  // Write out any queued messages and stop the logging threads, which needs
+  // to happen before static destruction.
+  setCurrentLogger(nullptr);
+  spdlog::shutdown();
+
+  const auto archiver = std::atomic_exchange(
+      &currentLogArchiver, std::shared_ptr<LogArchiver>());
+  if (archiver) {
+    archiver->stop();
+  }
 }
 
 void enableDebugLogging(bool enable) {
@@ -165,6 +509,10 @@ void enableDebugLogging(bool enable) {
     } else {
       logger->set_level(spdlog::level::level_enum::info);
     }
+
+    currentLogLevel.store(logger->level(), std::memory_order_relaxed);
+
+    updateCategoryLevels();
   }
 }
 }
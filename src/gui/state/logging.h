@@ -38,14 +38,93 @@
 #include <spdlog/spdlog.h>
 #endif
 
+#include <cstdint>
 #include <filesystem>
+#include <map>
+#include <optional>
+#include <string_view>
 
 namespace loot {
+// Categories of log messages that can be given their own log levels, e.g. so
+// that network problems can be debugged without also logging a message for
+// every plugin.
+enum struct LogCategory : unsigned int {
+  detection,
+  loading,
+  sorting,
+  network,
+  ui,
+};
+
+std::string_view getLogCategoryName(LogCategory category);
+
+std::optional<LogCategory> parseLogCategory(std::string_view name);
+
+// The logger is cached, so this is cheap enough to call from hot loops.
 std::shared_ptr<spdlog::logger> getLogger();
 
-void setLogPath(const std::filesystem::path& outputFile);
+// Get the logger for messages in the given category. It writes to the same
+// sinks as the uncategorised logger, but has its own level.
+std::shared_ptr<spdlog::logger> getLogger(LogCategory category);
+
+// Check if messages of the given level are logged without getting the logger,
+// to avoid building messages that won't be logged.
+bool isLogLevelEnabled(spdlog::level::level_enum level);
+
+bool isLogLevelEnabled(LogCategory category, spdlog::level::level_enum level);
+
+// Set the level of the given category, overriding the level set by
+// enableDebugLogging(). Passing std::nullopt removes the override.
+void setLogLevel(LogCategory category,
+                 std::optional<spdlog::level::level_enum> level);
+
+// Set the levels of the categories named in the given map to the named
+// levels, and remove the overrides of the other categories. Invalid category
+// or level names are logged and ignored.
+void setLogLevels(const std::map<std::string, std::string>& levels);
+
+// Log to the given file. If the file already exists, its content is moved
+// into the archive directory and compressed, along with any earlier content
+// that has been rotated out of the file.
+void setLogPath(const std::filesystem::path& outputFile,
+                const std::filesystem::path& archiveDir);
+
+// Rotate the log file into the archive directory once it reaches the given
+// size in bytes, or never if the size is zero, and keep no more than the
+// given number of previous logs in the archive directory.
+void setLogRotation(uintmax_t maxFileSize, size_t maxArchives);
 
 void enableDebugLogging(bool enable);
+
+// Logs a message in the given category, only formatting it if it will be
+// logged.
+#define LOOT_LOG(category, level, ...)                              \
+  do {                                                              \
+    if (::loot::isLogLevelEnabled(category, level)) {               \
+      const auto lootCategoryLogger_ = ::loot::getLogger(category); \
+      if (lootCategoryLogger_) {                                    \
+        lootCategoryLogger_->log(level, __VA_ARGS__);               \
+      }                                                             \
+    }                                                               \
+  } while (false)
+
+// Trace messages are compiled out entirely if LOOT_DISABLE_TRACE_LOGGING is
+// defined, so their arguments aren't evaluated.
+#ifdef LOOT_DISABLE_TRACE_LOGGING
+#define LOOT_LOG_TRACE(category, ...) \
+  do {                                \
+  } while (false)
+#else
+#define LOOT_LOG_TRACE(category, ...) \
+  LOOT_LOG(category, spdlog::level::trace, __VA_ARGS__)
+#endif
+
+#define LOOT_LOG_DEBUG(category, ...) \
+  LOOT_LOG(category, spdlog::level::debug, __VA_ARGS__)
+
+// Flushes any messages that have not yet been written to the log file. No
+// more messages can be logged once this has been called.
+void shutdownLogging();
 }
 
 #endif
@@ -93,7 +93,23 @@ std::filesystem::path LootPaths::getLogPath() const {
   return lootDataPath_ / "LOOTDebugLog.txt";
 }
 
+std::filesystem::path LootPaths::getLogArchivePath() const {
+  return lootDataPath_ / "logs";
+}
+
 std::filesystem::path LootPaths::getPreludePath() const {
   return lootDataPath_ / "prelude" / "prelude.yaml";
 }
+
+std::filesystem::path LootPaths::getGameInstallsCachePath() const {
+  return lootDataPath_ / "game_installs.toml";
+}
+
+std::filesystem::path LootPaths::getUpdateCheckCachePath() const {
+  return lootDataPath_ / "update_check.toml";
+}
+
+std::filesystem::path LootPaths::getPerformanceHistoryPath() const {
+  return lootDataPath_ / "performance_history.bin";
+}
 }
@@ -40,7 +40,11 @@ public:
   std::filesystem::path getSettingsPath() const;
   std::filesystem::path getThemesPath() const;
   std::filesystem::path getLogPath() const;
+  std::filesystem::path getLogArchivePath() const;
   std::filesystem::path getPreludePath() const;
+  std::filesystem::path getGameInstallsCachePath() const;
+  std::filesystem::path getUpdateCheckCachePath() const;
+  std::filesystem::path getPerformanceHistoryPath() const;
 
 private:
   std::filesystem::path lootDocsPath_;
@@ -27,10 +27,12 @@
 
 #include <toml++/toml.h>
 
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
 #include <boost/locale.hpp>
 #include <fstream>
 #include <regex>
+#include <sstream>
 
 #include "gui/state/game/detection/common.h"
 #include "gui/state/game/detection/detail.h"
@@ -129,6 +131,10 @@ bool IsEnderalSE(const toml::table& table) {
 }
 
 namespace loot {
+// Settings files written with this version or later have no repository
+// settings left to migrate.
+static constexpr int SETTINGS_VERSION = 1;
+
 static const std::set<std::string> oldDefaultBranches({"master",
                                                        "v0.7",
                                                        "v0.8",
@@ -593,7 +599,12 @@ std::string getGameFolder(const toml::table& table) {
   return *folder;
 }
 
-GameSettings convertGameTable(const toml::table& table) {
+bool isRepoSettingsMigrationNeeded(const toml::table& settings) {
+  return settings["settingsVersion"].value_or(0) < SETTINGS_VERSION;
+}
+
+GameSettings convertGameTable(const toml::table& table,
+                              bool migrateRepoSettings) {
   const auto gameId = getGameId(table);
   const auto folder = getGameFolder(table);
 
@@ -618,7 +629,7 @@ GameSettings convertGameTable(const toml::table& table) {
   auto source = table["masterlistSource"].value<std::string>();
   if (source) {
     game.SetMasterlistSource(migrateMasterlistSource(*source));
-  } else {
+  } else if (migrateRepoSettings) {
     auto url = table["repo"].value<std::string>();
     auto branch = table["branch"].value<std::string>();
     auto migratedSource = migrateMasterlistRepoSettings(game.Id(), url, branch);
@@ -660,6 +671,10 @@ std::vector<std::string> checkSettingsFile(
 
   auto settings = toml::parse(in);
 
+  if (!isRepoSettingsMigrationNeeded(settings)) {
+    return warningMessages;
+  }
+
   auto preludeUrl = settings["preludeRepo"].value<std::string>();
   auto preludeBranch = settings["preludeBranch"].value<std::string>();
 
@@ -767,7 +782,11 @@ void LootSettings::load(const std::filesystem::path& file) {
     throw std::runtime_error(file.u8string() +
                              " could not be opened for parsing");
 
-  const auto settings = toml::parse(in, file.u8string());
+  std::stringstream buffer;
+  buffer << in.rdbuf();
+  auto content = buffer.str();
+
+  const auto settings = toml::parse(content, file.u8string());
 
   enableDebugLogging_ =
       settings["enableDebugLogging"].value_or(enableDebugLogging_);
@@ -780,16 +799,38 @@ void LootSettings::load(const std::filesystem::path& file) {
   warnOnCaseSensitiveGamePaths_ =
       settings["warnOnCaseSensitiveGamePaths"].value_or(
           warnOnCaseSensitiveGamePaths_);
+  autoRefresh_ = settings["enableAutoRefresh"].value_or(autoRefresh_);
+  speculativeSort_ =
+      settings["enableSpeculativeSort"].value_or(speculativeSort_);
+  preloadPreviousGame_ = settings["enablePreviousGamePreload"].value_or(
+      preloadPreviousGame_);
+  releasePluginRecordData_ = settings["releasePluginRecordData"].value_or(
+      releasePluginRecordData_);
+  backupCompressionLevel_ = std::clamp(
+      settings["backupCompressionLevel"].value_or(backupCompressionLevel_),
+      0,
+      9);
+  maxResidentGames_ =
+      std::clamp(settings["maxResidentGames"].value_or(maxResidentGames_),
+                 0,
+                 MAX_RESIDENT_GAMES);
+  maxWorkerThreads_ =
+      std::clamp(settings["maxWorkerThreads"].value_or(maxWorkerThreads_),
+                 0,
+                 MAX_WORKER_THREADS);
   game_ = settings["game"].value_or(game_);
   language_ = settings["language"].value_or(language_);
   theme_ = settings["theme"].value_or(theme_);
   lastGame_ = settings["lastGame"].value_or(lastGame_);
+  previousGame_ = settings["previousGame"].value_or(previousGame_);
   lastVersion_ = settings["lastVersion"].value_or(lastVersion_);
 
+  const auto migrateRepoSettings = isRepoSettingsMigrationNeeded(settings);
+
   const auto preludeSource = settings["preludeSource"].value<std::string>();
   if (preludeSource.has_value()) {
     preludeSource_ = migratePreludeSource(preludeSource.value());
-  } else {
+  } else if (migrateRepoSettings) {
     auto url = settings["preludeRepo"].value<std::string>();
     auto branch = settings["preludeBranch"].value<std::string>();
     auto migratedSource = migratePreludeRepoSettings(url, branch);
@@ -798,6 +839,18 @@ void LootSettings::load(const std::filesystem::path& file) {
     }
   }
 
+  const auto sharedDownloadCachePath =
+      settings["sharedDownloadCachePath"].value<std::string>();
+  if (sharedDownloadCachePath.has_value()) {
+    sharedDownloadCachePath_ =
+        std::filesystem::u8path(sharedDownloadCachePath.value());
+  }
+
+  const auto runMetricsPath = settings["runMetricsPath"].value<std::string>();
+  if (runMetricsPath.has_value()) {
+    runMetricsPath_ = std::filesystem::u8path(runMetricsPath.value());
+  }
+
   const auto window = settings["window"];
   if (window.is_table()) {
     const auto windowPosition = windowPositionFromToml(*window.as_table());
@@ -826,7 +879,8 @@ void LootSettings::load(const std::filesystem::path& file) {
           throw std::runtime_error("games array element is not a table");
         }
 
-        gameSettings_.push_back(convertGameTable(*game.as_table()));
+        gameSettings_.push_back(
+            convertGameTable(*game.as_table(), migrateRepoSettings));
       } catch (const std::exception& e) {
         // Skip invalid games.
         if (logger) {
@@ -837,6 +891,66 @@ void LootSettings::load(const std::filesystem::path& file) {
     }
   }
 
+  const auto backupRetention = settings["backupRetention"];
+  if (backupRetention.is_table()) {
+    backupRetention_.maxCount = std::max(
+        0,
+        backupRetention.at_path("maxCount").value_or(
+            backupRetention_.maxCount));
+    backupRetention_.maxTotalSizeMiB = std::max(
+        0,
+        backupRetention.at_path("maxTotalSizeMiB")
+            .value_or(backupRetention_.maxTotalSizeMiB));
+    backupRetention_.maxAgeDays = std::max(
+        0,
+        backupRetention.at_path("maxAgeDays")
+            .value_or(backupRetention_.maxAgeDays));
+  }
+
+  const auto logRotation = settings["logRotation"];
+  if (logRotation.is_table()) {
+    logRotation_.maxFileSizeMiB = std::max(
+        0,
+        logRotation.at_path("maxFileSizeMiB")
+            .value_or(logRotation_.maxFileSizeMiB));
+    logRotation_.maxArchives = std::max(
+        0,
+        logRotation.at_path("maxArchives").value_or(logRotation_.maxArchives));
+  }
+
+  const auto logLevels = settings["logLevels"];
+  if (logLevels.is_table()) {
+    logLevels_.clear();
+    for (const auto& [category, level] : *logLevels.as_table()) {
+      const auto levelName = level.value<std::string>();
+      if (levelName.has_value()) {
+        logLevels_.emplace(std::string(category.str()), levelName.value());
+      }
+    }
+  }
+
+  const auto downloadMirrors = settings["downloadMirrors"];
+  if (downloadMirrors.is_table()) {
+    downloadMirrors_.clear();
+    for (const auto& [source, mirrors] : *downloadMirrors.as_table()) {
+      if (!mirrors.is_array()) {
+        continue;
+      }
+
+      std::vector<std::string> mirrorUrls;
+      for (const auto& mirror : *mirrors.as_array()) {
+        const auto mirrorUrl = mirror.value<std::string>();
+        if (mirrorUrl.has_value()) {
+          mirrorUrls.push_back(mirrorUrl.value());
+        }
+      }
+
+      if (!mirrorUrls.empty()) {
+        downloadMirrors_.emplace(std::string(source.str()), mirrorUrls);
+      }
+    }
+  }
+
   const auto filters = settings["filters"];
   if (filters.is_table()) {
     filters_.hideVersionNumbers = filters.at_path("hideVersionNumbers")
@@ -867,6 +981,18 @@ void LootSettings::load(const std::filesystem::path& file) {
             .value_or(filters_.showOnlyEmptyPlugins);
   }
 
+  const auto xboxGamingRootPaths = settings["xboxGamingRootPaths"];
+  if (xboxGamingRootPaths.is_array()) {
+    xboxGamingRootPaths_.clear();
+    for (const auto& path : *xboxGamingRootPaths.as_array()) {
+      const auto pathString = path.value<std::string>();
+      if (pathString.has_value()) {
+        xboxGamingRootPaths_.push_back(
+            std::filesystem::u8path(pathString.value()));
+      }
+    }
+  }
+
   const auto languages = settings["languages"];
   if (languages.is_array_of_tables()) {
     languages_.clear();
@@ -878,21 +1004,43 @@ void LootSettings::load(const std::filesystem::path& file) {
       languages_.push_back(convertLanguageTable(*language.as_table()));
     }
   }
+
+  RecordSavedFileState(file, std::move(content));
 }
 
 void LootSettings::save(const std::filesystem::path& file) {
   lock_guard<recursive_mutex> guard(mutex_);
 
   toml::table root{
+      {"settingsVersion", SETTINGS_VERSION},
       {"enableDebugLogging", enableDebugLogging_},
       {"updateMasterlist", updateMasterlistBeforeSort_},
       {"enableLootUpdateCheck", enableLootUpdateCheck_},
       {"useNoSortingChangesDialog", useNoSortingChangesDialog_},
       {"warnOnCaseSensitiveGamePaths", warnOnCaseSensitiveGamePaths_},
+      {"enableAutoRefresh", autoRefresh_},
+      {"enableSpeculativeSort", speculativeSort_},
+      {"enablePreviousGamePreload", preloadPreviousGame_},
+      {"releasePluginRecordData", releasePluginRecordData_},
+      {"backupCompressionLevel", backupCompressionLevel_},
+      {"maxResidentGames", maxResidentGames_},
+      {"maxWorkerThreads", maxWorkerThreads_},
+      {"backupRetention",
+       toml::table{
+           {"maxCount", backupRetention_.maxCount},
+           {"maxTotalSizeMiB", backupRetention_.maxTotalSizeMiB},
+           {"maxAgeDays", backupRetention_.maxAgeDays},
+       }},
+      {"logRotation",
+       toml::table{
+           {"maxFileSizeMiB", logRotation_.maxFileSizeMiB},
+           {"maxArchives", logRotation_.maxArchives},
+       }},
       {"game", game_},
       {"language", language_},
       {"theme", theme_},
       {"lastGame", lastGame_},
+      {"previousGame", previousGame_},
       {"lastVersion", lastVersion_},
       {"preludeSource", preludeSource_},
       {"filters",
@@ -911,6 +1059,26 @@ void LootSettings::save(const std::filesystem::path& file) {
            {"showOnlyEmptyPlugins", filters_.showOnlyEmptyPlugins},
        }}};
 
+  if (!logLevels_.empty()) {
+    toml::table logLevels;
+    for (const auto& [category, level] : logLevels_) {
+      logLevels.insert(category, level);
+    }
+    root.insert("logLevels", logLevels);
+  }
+
+  if (!downloadMirrors_.empty()) {
+    toml::table downloadMirrors;
+    for (const auto& [source, mirrorUrls] : downloadMirrors_) {
+      toml::array mirrors;
+      for (const auto& mirrorUrl : mirrorUrls) {
+        mirrors.push_back(mirrorUrl);
+      }
+      downloadMirrors.insert(source, mirrors);
+    }
+    root.insert("downloadMirrors", downloadMirrors);
+  }
+
   if (mainWindowPosition_.has_value()) {
     const auto window = windowPositionToToml(mainWindowPosition_.value());
     root.insert("window", window);
@@ -943,6 +1111,24 @@ void LootSettings::save(const std::filesystem::path& file) {
     root.insert("games", games);
   }
 
+  if (!sharedDownloadCachePath_.empty()) {
+    root.insert("sharedDownloadCachePath", sharedDownloadCachePath_.u8string());
+  }
+
+  if (!runMetricsPath_.empty()) {
+    root.insert("runMetricsPath", runMetricsPath_.u8string());
+  }
+
+  if (!xboxGamingRootPaths_.empty()) {
+    toml::array paths;
+
+    for (const auto& path : xboxGamingRootPaths_) {
+      paths.push_back(path.u8string());
+    }
+
+    root.insert("xboxGamingRootPaths", paths);
+  }
+
   if (!languages_.empty()) {
     toml::array languageTables;
 
@@ -957,8 +1143,43 @@ void LootSettings::save(const std::filesystem::path& file) {
     root.insert("languages", languageTables);
   }
 
-  std::ofstream out(file);
-  out << root;
+  std::ostringstream buffer;
+  buffer << root;
+  auto content = buffer.str();
+
+  if (IsSavedFileState(file, content)) {
+    const auto logger = getLogger();
+    if (logger) {
+      logger->debug("LOOT's settings are unchanged, skipping save.");
+    }
+    return;
+  }
+
+  auto tempPath = file;
+  tempPath += ".tmp";
+
+  std::ofstream out(tempPath, std::ios::binary);
+  if (!out.is_open()) {
+    throw std::runtime_error(tempPath.u8string() +
+                             " could not be opened for writing");
+  }
+
+  out << content;
+  out.close();
+
+  if (out.fail()) {
+    throw std::runtime_error("Failed to write to " + tempPath.u8string());
+  }
+
+  std::filesystem::rename(tempPath, file);
+
+  RecordSavedFileState(file, std::move(content));
+}
+
+bool LootSettings::isAutoRefreshEnabled() const {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  return autoRefresh_;
 }
 
 bool LootSettings::isAutoSortEnabled() const {
@@ -991,6 +1212,24 @@ bool LootSettings::isNoSortingChangesDialogEnabled() const {
   return useNoSortingChangesDialog_;
 }
 
+bool LootSettings::isSpeculativeSortEnabled() const {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  return speculativeSort_;
+}
+
+bool LootSettings::isPreviousGamePreloadEnabled() const {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  return preloadPreviousGame_;
+}
+
+bool LootSettings::isPluginRecordDataReleaseEnabled() const {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  return releasePluginRecordData_;
+}
+
 bool LootSettings::isWarnOnCaseSensitiveGamePathsEnabled() const {
   lock_guard<recursive_mutex> guard(mutex_);
 
@@ -1009,6 +1248,12 @@ std::string LootSettings::getLastGame() const {
   return lastGame_;
 }
 
+std::string LootSettings::getPreviousGame() const {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  return previousGame_;
+}
+
 std::string LootSettings::getLastVersion() const {
   lock_guard<recursive_mutex> guard(mutex_);
 
@@ -1027,12 +1272,72 @@ std::string LootSettings::getTheme() const {
   return theme_;
 }
 
+int LootSettings::getBackupCompressionLevel() const {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  return backupCompressionLevel_;
+}
+
+int LootSettings::getMaxResidentGames() const {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  return maxResidentGames_;
+}
+
+int LootSettings::getMaxWorkerThreads() const {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  return maxWorkerThreads_;
+}
+
+LootSettings::BackupRetention LootSettings::getBackupRetention() const {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  return backupRetention_;
+}
+
+LootSettings::LogRotation LootSettings::getLogRotation() const {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  return logRotation_;
+}
+
+std::map<std::string, std::string> LootSettings::getLogLevels() const {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  return logLevels_;
+}
+
 std::string LootSettings::getPreludeSource() const {
   lock_guard<recursive_mutex> guard(mutex_);
 
   return preludeSource_;
 }
 
+std::filesystem::path LootSettings::getSharedDownloadCachePath() const {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  return sharedDownloadCachePath_;
+}
+
+std::filesystem::path LootSettings::getRunMetricsPath() const {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  return runMetricsPath_;
+}
+
+std::vector<std::string> LootSettings::getDownloadMirrors(
+    const std::string& source) const {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  const auto it = downloadMirrors_.find(source);
+  if (it == downloadMirrors_.end()) {
+    return {};
+  }
+
+  return it->second;
+}
+
 std::optional<LootSettings::WindowPosition>
 LootSettings::getMainWindowPosition() const {
   lock_guard<recursive_mutex> guard(mutex_);
@@ -1065,6 +1370,13 @@ const std::vector<LootSettings::Language>& LootSettings::getLanguages() const {
   return languages_;
 }
 
+std::vector<std::filesystem::path> LootSettings::getXboxGamingRootPaths()
+    const {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  return xboxGamingRootPaths_;
+}
+
 void LootSettings::setDefaultGame(const std::string& game) {
   lock_guard<recursive_mutex> guard(mutex_);
 
@@ -1089,6 +1401,43 @@ void LootSettings::setPreludeSource(const std::string& source) {
   preludeSource_ = source;
 }
 
+void LootSettings::setSharedDownloadCachePath(
+    const std::filesystem::path& path) {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  sharedDownloadCachePath_ = path;
+}
+
+void LootSettings::setRunMetricsPath(const std::filesystem::path& path) {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  runMetricsPath_ = path;
+}
+
+void LootSettings::setBackupCompressionLevel(int level) {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  backupCompressionLevel_ = std::clamp(level, 0, 9);
+}
+
+void LootSettings::setMaxResidentGames(int count) {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  maxResidentGames_ = std::clamp(count, 0, MAX_RESIDENT_GAMES);
+}
+
+void LootSettings::setMaxWorkerThreads(int count) {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  maxWorkerThreads_ = std::clamp(count, 0, MAX_WORKER_THREADS);
+}
+
+void LootSettings::enableAutoRefresh(bool enable) {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  autoRefresh_ = enable;
+}
+
 void LootSettings::enableAutoSort(bool autoSort) {
   lock_guard<recursive_mutex> guard(mutex_);
 
@@ -1120,6 +1469,24 @@ void LootSettings::enableNoSortingChangesDialog(bool enable) {
   useNoSortingChangesDialog_ = enable;
 }
 
+void LootSettings::enableSpeculativeSort(bool enable) {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  speculativeSort_ = enable;
+}
+
+void LootSettings::enablePreviousGamePreload(bool enable) {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  preloadPreviousGame_ = enable;
+}
+
+void LootSettings::enablePluginRecordDataRelease(bool enable) {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  releasePluginRecordData_ = enable;
+}
+
 void LootSettings::enableWarnOnCaseSensitiveGamePaths(bool enable) {
   lock_guard<recursive_mutex> guard(mutex_);
 
@@ -1132,6 +1499,12 @@ void LootSettings::storeLastGame(const std::string& lastGame) {
   this->lastGame_ = lastGame;
 }
 
+void LootSettings::storePreviousGame(const std::string& previousGame) {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  this->previousGame_ = previousGame;
+}
+
 void LootSettings::storeMainWindowPosition(const WindowPosition& position) {
   lock_guard<recursive_mutex> guard(mutex_);
 
@@ -1158,10 +1531,65 @@ void LootSettings::storeFilters(const Filters& filters) {
   filters_ = filters;
 }
 
+void LootSettings::storeBackupRetention(const BackupRetention& retention) {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  backupRetention_.maxCount = std::max(0, retention.maxCount);
+  backupRetention_.maxTotalSizeMiB = std::max(0, retention.maxTotalSizeMiB);
+  backupRetention_.maxAgeDays = std::max(0, retention.maxAgeDays);
+}
+
+void LootSettings::storeLogRotation(const LogRotation& rotation) {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  logRotation_.maxFileSizeMiB = std::max(0, rotation.maxFileSizeMiB);
+  logRotation_.maxArchives = std::max(0, rotation.maxArchives);
+}
+
+void LootSettings::storeLogLevels(
+    const std::map<std::string, std::string>& levels) {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  logLevels_ = levels;
+}
+
+void LootSettings::storeXboxGamingRootPaths(
+    const std::vector<std::filesystem::path>& paths) {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  xboxGamingRootPaths_ = paths;
+}
+
 void LootSettings::updateLastVersion() {
   lock_guard<recursive_mutex> guard(mutex_);
 
   lastVersion_ = gui::Version::string();
 }
 
+bool LootSettings::IsSavedFileState(const std::filesystem::path& file,
+                                    const std::string& content) const {
+  if (!savedFileState_.has_value() || savedFileState_->path != file ||
+      savedFileState_->content != content) {
+    return false;
+  }
+
+  // Check that the file hasn't been changed by something else.
+  std::error_code ec;
+  const auto writeTime = std::filesystem::last_write_time(file, ec);
+
+  return !ec && writeTime == savedFileState_->writeTime;
+}
+
+void LootSettings::RecordSavedFileState(const std::filesystem::path& file,
+                                        std::string content) {
+  std::error_code ec;
+  const auto writeTime = std::filesystem::last_write_time(file, ec);
+  if (ec) {
+    savedFileState_ = std::nullopt;
+    return;
+  }
+
+  savedFileState_ = SavedFileState{file, writeTime, std::move(content)};
+}
+
 }
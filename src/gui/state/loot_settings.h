@@ -43,6 +43,11 @@ std::string getDefaultPreludeSource();
 
 class LootSettings {
 public:
+  // The most games other than the current game that can be kept loaded.
+  static constexpr int MAX_RESIDENT_GAMES = 8;
+  // The most worker threads that LOOT can be configured to use.
+  static constexpr int MAX_WORKER_THREADS = 64;
+
   struct WindowPosition {
     int top{0};
     int bottom{0};
@@ -70,62 +75,126 @@ public:
     bool showOnlyEmptyPlugins{false};
   };
 
+  // Limits of zero are not enforced.
+  struct BackupRetention {
+    int maxCount{10};
+    int maxTotalSizeMiB{0};
+    int maxAgeDays{0};
+  };
+
+  // A maximum file size of zero disables rotation.
+  struct LogRotation {
+    int maxFileSizeMiB{10};
+    int maxArchives{5};
+  };
+
   void load(const std::filesystem::path& file);
+  // Does nothing if the file's content would not change. Otherwise the
+  // settings are written to a temporary file that then replaces the given
+  // file, so that an interrupted save cannot leave it truncated.
   void save(const std::filesystem::path& file);
 
+  bool isAutoRefreshEnabled() const;
   bool isAutoSortEnabled() const;
   bool isDebugLoggingEnabled() const;
   bool isMasterlistUpdateBeforeSortEnabled() const;
   bool isLootUpdateCheckEnabled() const;
   bool isNoSortingChangesDialogEnabled() const;
+  bool isPreviousGamePreloadEnabled() const;
+  bool isPluginRecordDataReleaseEnabled() const;
+  bool isSpeculativeSortEnabled() const;
   bool isWarnOnCaseSensitiveGamePathsEnabled() const;
+  int getBackupCompressionLevel() const;
+  int getMaxResidentGames() const;
+  // Zero means one worker thread per logical CPU core.
+  int getMaxWorkerThreads() const;
+  BackupRetention getBackupRetention() const;
+  LogRotation getLogRotation() const;
+  // Log category names mapped to the level names they're set to.
+  std::map<std::string, std::string> getLogLevels() const;
   std::string getGame() const;
   std::string getLastGame() const;
+  std::string getPreviousGame() const;
   std::string getLastVersion() const;
   std::string getLanguage() const;
   std::string getTheme() const;
   std::string getPreludeSource() const;
+  std::filesystem::path getSharedDownloadCachePath() const;
+  std::filesystem::path getRunMetricsPath() const;
+  // Other URLs that the file at the given source URL can be downloaded from.
+  std::vector<std::string> getDownloadMirrors(const std::string& source) const;
   std::optional<WindowPosition> getMainWindowPosition() const;
   std::optional<WindowPosition> getGroupsEditorWindowPosition() const;
   const std::vector<GameSettings>& getGameSettings() const;
   const Filters& getFilters() const;
   const std::vector<Language>& getLanguages() const;
+  std::vector<std::filesystem::path> getXboxGamingRootPaths() const;
 
   void setDefaultGame(const std::string& game);
   void setLanguage(const std::string& language);
   void setTheme(const std::string& theme);
   void setPreludeSource(const std::string& source);
+  void setSharedDownloadCachePath(const std::filesystem::path& path);
+  void setRunMetricsPath(const std::filesystem::path& path);
+  void setBackupCompressionLevel(int level);
+  void setMaxResidentGames(int count);
+  void setMaxWorkerThreads(int count);
+  void enableAutoRefresh(bool enable);
   void enableAutoSort(bool enable);
   void enableDebugLogging(bool enable);
   void enableMasterlistUpdateBeforeSort(bool enable);
   void enableLootUpdateCheck(bool enable);
   void enableNoSortingChangesDialog(bool enable);
+  void enablePreviousGamePreload(bool enable);
+  void enablePluginRecordDataRelease(bool enable);
+  void enableSpeculativeSort(bool enable);
   void enableWarnOnCaseSensitiveGamePaths(bool enable);
 
   void storeLastGame(const std::string& lastGame);
+  void storePreviousGame(const std::string& previousGame);
   void storeMainWindowPosition(const WindowPosition& position);
   void storeGroupsEditorWindowPosition(const WindowPosition& position);
   void storeGameSettings(const std::vector<GameSettings>& gameSettings);
   void storeFilters(const Filters& filters);
+  void storeBackupRetention(const BackupRetention& retention);
+  void storeLogRotation(const LogRotation& rotation);
+  void storeLogLevels(const std::map<std::string, std::string>& levels);
+  void storeXboxGamingRootPaths(
+      const std::vector<std::filesystem::path>& paths);
   void updateLastVersion();
 
 private:
+  bool autoRefresh_{false};
   bool autoSort_{false};
   bool enableDebugLogging_{false};
   bool updateMasterlistBeforeSort_{true};
   bool enableLootUpdateCheck_{true};
   bool useNoSortingChangesDialog_{true};
+  bool speculativeSort_{false};
+  bool preloadPreviousGame_{false};
+  bool releasePluginRecordData_{false};
   bool warnOnCaseSensitiveGamePaths_{true};
+  int backupCompressionLevel_{0};
+  int maxResidentGames_{1};
+  int maxWorkerThreads_{0};
+  BackupRetention backupRetention_;
+  LogRotation logRotation_;
+  std::map<std::string, std::string> logLevels_;
+  std::map<std::string, std::vector<std::string>> downloadMirrors_;
   std::string game_{"auto"};
   std::string lastGame_{"auto"};
+  std::string previousGame_;
   std::string lastVersion_;
   std::string language_{"en"};
   std::string preludeSource_{getDefaultPreludeSource()};
   std::string theme_{"default"};
+  std::filesystem::path sharedDownloadCachePath_;
+  std::filesystem::path runMetricsPath_;
   std::optional<WindowPosition> mainWindowPosition_;
   std::optional<WindowPosition> groupsEditorWindowPosition_;
   std::vector<GameSettings> gameSettings_;
   Filters filters_;
+  std::vector<std::filesystem::path> xboxGamingRootPaths_;
   std::vector<Language> languages_{
       Language({"en", "English"}),
       Language({"bg", "Български"}),
@@ -148,6 +217,21 @@ private:
       Language({"zh_CN", "简体中文"}),
   };
 
+  // The state of the settings file as of the last load or save, used to
+  // skip writing settings that have not changed.
+  struct SavedFileState {
+    std::filesystem::path path;
+    std::filesystem::file_time_type writeTime;
+    std::string content;
+  };
+
+  bool IsSavedFileState(const std::filesystem::path& file,
+                        const std::string& content) const;
+  void RecordSavedFileState(const std::filesystem::path& file,
+                            std::string content);
+
+  std::optional<SavedFileState> savedFileState_;
+
   mutable std::recursive_mutex mutex_;
 };
 }
@@ -42,14 +42,18 @@
 
 #include <boost/algorithm/string.hpp>
 #include <boost/locale.hpp>
+#include <future>
 
 #include "gui/helpers.h"
 #include "gui/state/game/detection.h"
 #include "gui/state/game/detection/heroic.h"
+#include "gui/state/game/detection/install_cache.h"
 #include "gui/state/game/detection/registry.h"
 #include "gui/state/game/helpers.h"
 #include "gui/state/logging.h"
 #include "gui/state/loot_paths.h"
+#include "gui/state/timing.h"
+#include "gui/translation_cache.h"
 #include "loot/api.h"
 
 using boost::locale::translate;
@@ -59,6 +63,12 @@ using std::exception;
 namespace fs = std::filesystem;
 
 namespace {
+#ifdef _WIN32
+// Drive probes run concurrently, so this is the longest that looking for Xbox
+// gaming roots can delay startup.
+constexpr std::chrono::seconds XBOX_GAMING_ROOT_PROBE_TIMEOUT(2);
+#endif
+
 loot::SourcedMessage CreateInitErrorMessage(const std::string& text) {
   return loot::CreatePlainTextSourcedMessage(
       loot::MessageType::error, loot::MessageSource::init, text);
@@ -108,8 +118,7 @@ LootState::LootState(const std::filesystem::path& lootAppPath,
   createLootDataPath();
 
   // Initialise logging.
-  fs::remove(LootPaths::getLogPath());
-  setLogPath(LootPaths::getLogPath());
+  setLogPath(LootPaths::getLogPath(), LootPaths::getLogArchivePath());
   SetLoggingCallback(apiLogCallback);
 
   // Enable debug logging before settings are loaded to capture as much
@@ -122,6 +131,12 @@ LootState::LootState(const std::filesystem::path& lootAppPath,
 void LootState::init(const std::string& cmdLineGame,
                      const std::filesystem::path& cmdLineGamePath,
                      bool autoSort) {
+  // Querying the OS for the preferred UI languages doesn't depend on
+  // anything else, and they're only needed for game detection, so do it
+  // while settings are loaded.
+  auto preferredUILanguages = std::async(
+      std::launch::async, []() { return GetPreferredUILanguages(); });
+
   loadSettings(cmdLineGame, autoSort);
 
   // Check settings after handling translations so that any messages
@@ -132,7 +147,7 @@ void LootState::init(const std::string& cmdLineGame,
   // Microsoft Store / Xbox app.
   findXboxGamingRootPaths();
 
-  preferredUILanguages_ = GetPreferredUILanguages();
+  preferredUILanguages_ = preferredUILanguages.get();
   if (preferredUILanguages_.empty() && settings_.getLanguage().size() > 1) {
     preferredUILanguages_ = {settings_.getLanguage()};
   }
@@ -225,6 +240,14 @@ void LootState::loadSettings(const std::string& cmdLineGame, bool autoSort) {
 
   // Apply debug logging settings.
   enableDebugLogging(settings_.isDebugLoggingEnabled());
+  setLogLevels(settings_.getLogLevels());
+
+  const auto logRotation = settings_.getLogRotation();
+  setLogRotation(
+      static_cast<uintmax_t>(logRotation.maxFileSizeMiB) * 1024 * 1024,
+      static_cast<size_t>(logRotation.maxArchives));
+
+  setMaxWorkerThreadCount(settings_.getMaxWorkerThreads());
 
   // Now that settings have been loaded, set the locale again to handle
   // translations.
@@ -243,6 +266,9 @@ void LootState::loadSettings(const std::string& cmdLineGame, bool autoSort) {
     gen.add_messages_path(l10nPath);
     gen.add_messages_domain("loot");
     std::locale::global(gen(settings_.getLanguage() + ".UTF-8"));
+
+    // Any cached translations are for the previous locale.
+    ClearTranslationCache();
   }
 }
 
@@ -270,12 +296,27 @@ void LootState::checkSettingsFile() {
 void LootState::findXboxGamingRootPaths() {
 #ifdef _WIN32
   try {
-    for (const auto& driveRootPath : GetDriveRootPaths()) {
-      const auto xboxGamingRootPath = FindXboxGamingRootPath(driveRootPath);
-      if (xboxGamingRootPath.has_value()) {
-        xboxGamingRootPaths_.push_back(xboxGamingRootPath.value());
+    const auto previousGamingRootPaths = settings_.getXboxGamingRootPaths();
+
+    const auto results = FindXboxGamingRootPaths(
+        GetDriveRootPaths(), XBOX_GAMING_ROOT_PROBE_TIMEOUT);
+
+    for (const auto& result : results) {
+      if (result.gamingRootPath.has_value()) {
+        xboxGamingRootPaths_.push_back(result.gamingRootPath.value());
+      } else if (result.timedOut) {
+        // Fall back to the gaming roots that were previously found on the
+        // drive, so that a drive that is slow to wake up doesn't cause its
+        // games to be forgotten.
+        for (const auto& previousPath : previousGamingRootPaths) {
+          if (previousPath.root_path() == result.driveRootPath) {
+            xboxGamingRootPaths_.push_back(previousPath);
+          }
+        }
       }
     }
+
+    settings_.storeXboxGamingRootPaths(xboxGamingRootPaths_);
   } catch (const exception& e) {
     const auto logger = getLogger();
     if (logger) {
@@ -395,14 +436,19 @@ void LootState::setInitialGame(const std::string& cliGameValue) {
 
 std::vector<GameSettings> LootState::FindInstalledGames(
     const std::vector<GameSettings>& gamesSettings) const {
+  ScopedTimer timer("LootState::FindInstalledGames");
+
   const auto heroicConfigPaths = heroic::GetHeroicGamesLauncherConfigPaths();
 
+  const auto gameInstalls =
+      FindGameInstallsUsingCache(LootPaths::getGameInstallsCachePath(),
+                                 Registry(),
+                                 heroicConfigPaths,
+                                 xboxGamingRootPaths_,
+                                 preferredUILanguages_);
+
   auto gamesSettingsToUpdate = gamesSettings;
-  UpdateInstalledGamesSettings(gamesSettingsToUpdate,
-                               Registry(),
-                               heroicConfigPaths,
-                               xboxGamingRootPaths_,
-                               preferredUILanguages_);
+  UpdateInstalledGamesSettings(gamesSettingsToUpdate, gameInstalls);
 
   std::sort(gamesSettingsToUpdate.begin(),
             gamesSettingsToUpdate.end(),
@@ -0,0 +1,264 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/memory_accounting.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <new>
+
+#include "gui/state/diagnostics.h"
+#include "gui/state/logging.h"
+
+namespace {
+constexpr double BYTES_PER_MIB = 1024.0 * 1024.0;
+
+// These are updated by every allocation if allocation counting is enabled, so
+// they're only ever incremented, and callers look at their differences.
+std::atomic<uint64_t> allocatedBytes{0};
+std::atomic<uint64_t> allocationCount{0};
+
+struct StageStats {
+  size_t count{0};
+  uint64_t totalAllocatedBytes{0};
+  uint64_t totalAllocationCount{0};
+  int64_t lastResidentDelta{0};
+  int64_t maxResidentDelta{0};
+  uint64_t totalPeakIncrease{0};
+};
+
+std::mutex memoryMutex;
+std::map<std::string, StageStats> stageStats;
+
+double toMiB(double bytes) { return bytes / BYTES_PER_MIB; }
+
+int64_t getDifference(const std::optional<uint64_t>& start,
+                      const std::optional<uint64_t>& end) {
+  if (!start.has_value() || !end.has_value()) {
+    return 0;
+  }
+
+  return static_cast<int64_t>(end.value()) -
+         static_cast<int64_t>(start.value());
+}
+
+#ifdef LOOT_COUNT_ALLOCATIONS
+void* countedAllocate(std::size_t size) noexcept {
+  allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+  // malloc(0) may return a null pointer, but new must not.
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+void* countedAllocateOrThrow(std::size_t size) {
+  auto pointer = countedAllocate(size);
+  while (pointer == nullptr) {
+    const auto handler = std::get_new_handler();
+    if (handler == nullptr) {
+      throw std::bad_alloc();
+    }
+
+    handler();
+    pointer = std::malloc(size == 0 ? 1 : size);
+  }
+
+  return pointer;
+}
+#endif
+}
+
+#ifdef LOOT_COUNT_ALLOCATIONS
+// The aligned allocation functions aren't replaced, so they're not counted,
+// but they're also not affected by replacing the others.
+void* operator new(std::size_t size) { return countedAllocateOrThrow(size); }
+
+void* operator new[](std::size_t size) { return countedAllocateOrThrow(size); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return countedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return countedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+  std::free(pointer);
+}
+#endif
+
+namespace loot {
+ScopedMemoryMeter::ScopedMemoryMeter(std::string stageName) :
+    stageName_(std::move(stageName)) {
+  if (!isLogLevelEnabled(spdlog::level::debug)) {
+    return;
+  }
+
+  isStopped_ = false;
+  startResidentBytes_ = getProcessMemoryUsage();
+  startPeakResidentBytes_ = getProcessPeakMemoryUsage();
+  startAllocatedBytes_ = getAllocatedBytes();
+  startAllocationCount_ = getAllocationCount();
+}
+
+ScopedMemoryMeter::~ScopedMemoryMeter() { stop(); }
+
+void ScopedMemoryMeter::stop() {
+  if (isStopped_) {
+    return;
+  }
+  isStopped_ = true;
+
+  try {
+    const auto allocated = getAllocatedBytes() - startAllocatedBytes_;
+    const auto allocations = getAllocationCount() - startAllocationCount_;
+    const auto residentDelta =
+        getDifference(startResidentBytes_, getProcessMemoryUsage());
+    const auto peakIncrease = static_cast<uint64_t>(std::max(
+        int64_t{0},
+        getDifference(startPeakResidentBytes_, getProcessPeakMemoryUsage())));
+
+    {
+      std::lock_guard<std::mutex> guard(memoryMutex);
+
+      auto& stats = stageStats[stageName_];
+      stats.maxResidentDelta = stats.count == 0
+                                   ? residentDelta
+                                   : std::max(stats.maxResidentDelta,
+                                              residentDelta);
+      stats.count += 1;
+      stats.totalAllocatedBytes += allocated;
+      stats.totalAllocationCount += allocations;
+      stats.lastResidentDelta = residentDelta;
+      stats.totalPeakIncrease += peakIncrease;
+    }
+
+    const auto logger = getLogger();
+    if (!logger) {
+      return;
+    }
+
+    if (isAllocationCountingEnabled()) {
+      logger->debug(
+          "{} allocated {:.1f} MiB in {} allocations, changed resident memory "
+          "by {:.1f} MiB and raised its peak by {:.1f} MiB",
+          stageName_,
+          toMiB(static_cast<double>(allocated)),
+          allocations,
+          toMiB(static_cast<double>(residentDelta)),
+          toMiB(static_cast<double>(peakIncrease)));
+    } else {
+      logger->debug(
+          "{} changed resident memory by {:.1f} MiB and raised its peak by "
+          "{:.1f} MiB",
+          stageName_,
+          toMiB(static_cast<double>(residentDelta)),
+          toMiB(static_cast<double>(peakIncrease)));
+    }
+  } catch (...) {
+    // Memory accounting is only diagnostic, so failing to record it shouldn't
+    // affect the operation that was measured.
+  }
+}
+
+bool isAllocationCountingEnabled() {
+#ifdef LOOT_COUNT_ALLOCATIONS
+  return true;
+#else
+  return false;
+#endif
+}
+
+uint64_t getAllocatedBytes() {
+  return allocatedBytes.load(std::memory_order_relaxed);
+}
+
+uint64_t getAllocationCount() {
+  return allocationCount.load(std::memory_order_relaxed);
+}
+
+void logMemorySummary() {
+  const auto logger = getLogger();
+  if (!logger) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(memoryMutex);
+  if (stageStats.empty()) {
+    return;
+  }
+
+  logger->debug("Memory summary:");
+  for (const auto& [stageName, stats] : stageStats) {
+    logger->debug(
+        "{}: {} times, {:.1f} MiB allocated in {} allocations, {:.1f} MiB "
+        "largest resident change, {:.1f} MiB peak increase in total",
+        stageName,
+        stats.count,
+        toMiB(static_cast<double>(stats.totalAllocatedBytes)),
+        stats.totalAllocationCount,
+        toMiB(static_cast<double>(stats.maxResidentDelta)),
+        toMiB(static_cast<double>(stats.totalPeakIncrease)));
+  }
+}
+
+std::vector<StageMemoryUsage> getStageMemoryUsage() {
+  std::lock_guard<std::mutex> guard(memoryMutex);
+
+  std::vector<StageMemoryUsage> usages;
+  usages.reserve(stageStats.size());
+  for (const auto& [stageName, stats] : stageStats) {
+    usages.push_back(StageMemoryUsage{stageName,
+                                      stats.count,
+                                      stats.totalAllocatedBytes,
+                                      stats.totalAllocationCount,
+                                      stats.lastResidentDelta,
+                                      stats.maxResidentDelta,
+                                      stats.totalPeakIncrease});
+  }
+
+  return usages;
+}
+}
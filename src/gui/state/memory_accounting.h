@@ -0,0 +1,93 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_MEMORY_ACCOUNTING
+#define LOOT_GUI_STATE_MEMORY_ACCOUNTING
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace loot {
+// Measures how an operation changes LOOT's memory use, from construction until
+// stop() is called or the meter is destroyed. The change is logged at debug
+// level and added to the memory summary. Measuring involves querying the OS,
+// so meters only measure anything while debug logging is enabled, and they
+// should only be used for coarse stages, not inside loops.
+//
+// Allocations are counted for the whole process, so an operation's counts
+// include any allocations made by other threads while it's running.
+class ScopedMemoryMeter {
+public:
+  explicit ScopedMemoryMeter(std::string stageName);
+  ScopedMemoryMeter(const ScopedMemoryMeter&) = delete;
+  ScopedMemoryMeter(ScopedMemoryMeter&&) = delete;
+  ~ScopedMemoryMeter();
+
+  ScopedMemoryMeter& operator=(const ScopedMemoryMeter&) = delete;
+  ScopedMemoryMeter& operator=(ScopedMemoryMeter&&) = delete;
+
+  // Records the change so far. Only the first call has any effect.
+  void stop();
+
+private:
+  std::string stageName_;
+  bool isStopped_{true};
+  uint64_t startAllocatedBytes_{0};
+  uint64_t startAllocationCount_{0};
+  std::optional<uint64_t> startResidentBytes_;
+  std::optional<uint64_t> startPeakResidentBytes_;
+};
+
+struct StageMemoryUsage {
+  std::string stageName;
+  size_t count{0};
+  uint64_t totalAllocatedBytes{0};
+  uint64_t totalAllocationCount{0};
+  int64_t lastResidentDelta{0};
+  int64_t maxResidentDelta{0};
+  // The sum of how much each run raised the process' peak memory use.
+  uint64_t totalPeakIncrease{0};
+};
+
+// Allocations are only counted if LOOT was built with allocation counters
+// enabled, as counting them replaces the global allocation functions.
+bool isAllocationCountingEnabled();
+
+// Get the number of bytes and number of allocations that have been made since
+// LOOT started. Both are zero if allocation counting is not enabled.
+uint64_t getAllocatedBytes();
+uint64_t getAllocationCount();
+
+// Log the memory use of each stage that has been measured so far.
+void logMemorySummary();
+
+// Get the memory use of each stage that has been measured so far, ordered by
+// stage name.
+std::vector<StageMemoryUsage> getStageMemoryUsage();
+}
+
+#endif
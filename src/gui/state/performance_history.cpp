@@ -0,0 +1,306 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/performance_history.h"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+
+#include "gui/state/logging.h"
+
+namespace {
+using loot::PerformanceMetric;
+using loot::PerformanceRecord;
+
+constexpr uint32_t LPH_MAGIC_NUMBER = 0x48504C4C;
+constexpr uint8_t LPH_FORMAT_VERSION = 1;
+constexpr uint8_t MAX_METRIC_VALUE =
+    static_cast<uint8_t>(PerformanceMetric::refresh);
+
+template<typename T>
+void ReadValue(std::istream& in, T& value) {
+  in.read(reinterpret_cast<char*>(&value), sizeof value);
+}
+
+template<typename T>
+void WriteValue(std::ostream& out, const T& value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof value);
+}
+
+// Game folder names are repeated in many records, so they're written once
+// and each record refers to its game by index.
+std::vector<std::string> GetGameFolderNames(
+    const std::vector<PerformanceRecord>& records) {
+  std::vector<std::string> names;
+  for (const auto& record : records) {
+    if (std::find(names.begin(), names.end(), record.gameFolderName) ==
+        names.end()) {
+      names.push_back(record.gameFolderName);
+    }
+  }
+
+  return names;
+}
+}
+
+namespace loot {
+std::string ToString(PerformanceMetric metric) {
+  switch (metric) {
+    case PerformanceMetric::startup:
+      return "Startup";
+    case PerformanceMetric::sort:
+      return "Sort";
+    case PerformanceMetric::masterlistUpdate:
+      return "Masterlist update";
+    case PerformanceMetric::overlapQuery:
+      return "Overlap query";
+    case PerformanceMetric::refresh:
+      return "Refresh";
+    default:
+      return "Unknown";
+  }
+}
+
+std::vector<PerformanceRecord> LoadPerformanceHistory(
+    const std::filesystem::path& filePath) {
+  std::vector<PerformanceRecord> records;
+
+  if (!std::filesystem::exists(filePath)) {
+    return records;
+  }
+
+  std::ifstream in(filePath, std::ios_base::in | std::ios_base::binary);
+  if (!in.is_open()) {
+    throw std::runtime_error(filePath.u8string() +
+                             " could not be opened for parsing");
+  }
+
+  uint32_t magicNumber{0};
+  ReadValue(in, magicNumber);
+
+  if (magicNumber != LPH_MAGIC_NUMBER) {
+    throw std::runtime_error("Failed to parse " + filePath.u8string() +
+                             ": wrong magic number");
+  }
+
+  uint8_t formatVersion{0};
+  ReadValue(in, formatVersion);
+
+  if (formatVersion != LPH_FORMAT_VERSION) {
+    throw std::runtime_error("Failed to parse " + filePath.u8string() +
+                             ": unrecognised format version");
+  }
+
+  uint16_t gameCount{0};
+  ReadValue(in, gameCount);
+
+  std::vector<std::string> gameFolderNames;
+  for (uint16_t i = 0; i < gameCount && in.good(); ++i) {
+    uint8_t length{0};
+    ReadValue(in, length);
+
+    std::string name(length, '\0');
+    in.read(name.data(), length);
+    gameFolderNames.push_back(std::move(name));
+  }
+
+  uint32_t recordCount{0};
+  ReadValue(in, recordCount);
+
+  for (uint32_t i = 0; i < recordCount && in.good(); ++i) {
+    int64_t recordedAt{0};
+    uint16_t gameIndex{0};
+    uint8_t metric{0};
+    uint32_t durationMs{0};
+    uint32_t pluginCount{0};
+    ReadValue(in, recordedAt);
+    ReadValue(in, gameIndex);
+    ReadValue(in, metric);
+    ReadValue(in, durationMs);
+    ReadValue(in, pluginCount);
+
+    if (in.good() &&
+        (gameIndex >= gameFolderNames.size() || metric > MAX_METRIC_VALUE)) {
+      throw std::runtime_error("Failed to parse " + filePath.u8string() +
+                               ": invalid record");
+    }
+
+    PerformanceRecord record;
+    record.recordedAt = std::chrono::system_clock::time_point(
+        std::chrono::seconds(recordedAt));
+    record.gameFolderName = gameFolderNames[gameIndex];
+    record.metric = static_cast<PerformanceMetric>(metric);
+    record.duration = std::chrono::milliseconds(durationMs);
+    record.pluginCount = pluginCount;
+    records.push_back(std::move(record));
+  }
+
+  if (in.fail()) {
+    throw std::runtime_error("Failed to parse " + filePath.u8string() +
+                             ": unexpected end of file");
+  }
+
+  return records;
+}
+
+void SavePerformanceHistory(const std::filesystem::path& filePath,
+                            const std::vector<PerformanceRecord>& records) {
+  // Don't care about endianness because the files don't need to be portable.
+
+  const auto gameFolderNames = GetGameFolderNames(records);
+
+  auto tempPath = filePath;
+  tempPath += ".tmp";
+
+  std::ofstream out(
+      tempPath,
+      std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+  if (!out.is_open()) {
+    throw std::runtime_error(tempPath.u8string() +
+                             " could not be opened for writing");
+  }
+
+  WriteValue(out, LPH_MAGIC_NUMBER);
+  WriteValue(out, LPH_FORMAT_VERSION);
+
+  WriteValue(out, static_cast<uint16_t>(gameFolderNames.size()));
+  for (const auto& name : gameFolderNames) {
+    // Folder names are short, but make sure the length fits.
+    const auto length =
+        static_cast<uint8_t>(std::min(name.size(), size_t{UINT8_MAX}));
+    WriteValue(out, length);
+    out.write(name.data(), length);
+  }
+
+  WriteValue(out, static_cast<uint32_t>(records.size()));
+  for (const auto& record : records) {
+    const auto recordedAt =
+        std::chrono::duration_cast<std::chrono::seconds>(
+            record.recordedAt.time_since_epoch())
+            .count();
+    const auto gameIndex =
+        std::find(gameFolderNames.begin(),
+                  gameFolderNames.end(),
+                  record.gameFolderName) -
+        gameFolderNames.begin();
+    const auto durationMs = std::min(
+        record.duration.count(),
+        static_cast<std::chrono::milliseconds::rep>(UINT32_MAX));
+
+    WriteValue(out, static_cast<int64_t>(recordedAt));
+    WriteValue(out, static_cast<uint16_t>(gameIndex));
+    WriteValue(out, static_cast<uint8_t>(record.metric));
+    WriteValue(out, static_cast<uint32_t>(durationMs));
+    WriteValue(out, record.pluginCount);
+  }
+
+  out.close();
+
+  if (out.fail()) {
+    throw std::runtime_error("Failed to write to " + tempPath.u8string());
+  }
+
+  std::filesystem::rename(tempPath, filePath);
+}
+
+void AppendPerformanceRecord(const std::filesystem::path& filePath,
+                             const PerformanceRecord& record) {
+  std::vector<PerformanceRecord> records;
+  try {
+    records = LoadPerformanceHistory(filePath);
+  } catch (const std::exception& e) {
+    const auto logger = getLogger();
+    if (logger) {
+      logger->warn("Replacing the invalid performance history at {}: {}",
+                   filePath.u8string(),
+                   e.what());
+    }
+  }
+
+  records.push_back(record);
+
+  if (records.size() > PERFORMANCE_HISTORY_MAX_RECORDS) {
+    records.erase(records.begin(),
+                  records.end() - PERFORMANCE_HISTORY_MAX_RECORDS);
+  }
+
+  SavePerformanceHistory(filePath, records);
+}
+
+std::vector<PerformanceSeries> GetPerformanceSeries(
+    const std::vector<PerformanceRecord>& records) {
+  std::map<std::pair<std::string, PerformanceMetric>, PerformanceSeries>
+      seriesByKey;
+  for (const auto& record : records) {
+    auto& series = seriesByKey[{record.gameFolderName, record.metric}];
+    series.gameFolderName = record.gameFolderName;
+    series.metric = record.metric;
+    series.records.push_back(record);
+  }
+
+  std::vector<PerformanceSeries> series;
+  series.reserve(seriesByKey.size());
+  for (auto& entry : seriesByKey) {
+    series.push_back(std::move(entry.second));
+  }
+
+  return series;
+}
+
+std::optional<double> GetRelativeDuration(const PerformanceSeries& series,
+                                          size_t recordIndex) {
+  if (recordIndex == 0 || recordIndex >= series.records.size()) {
+    return std::nullopt;
+  }
+
+  const auto firstIndex =
+      recordIndex > PERFORMANCE_HISTORY_COMPARISON_COUNT
+          ? recordIndex - PERFORMANCE_HISTORY_COMPARISON_COUNT
+          : 0;
+
+  std::vector<std::chrono::milliseconds::rep> durations;
+  for (auto i = firstIndex; i < recordIndex; i += 1) {
+    durations.push_back(series.records[i].duration.count());
+  }
+
+  const auto middle = durations.begin() + durations.size() / 2;
+  std::nth_element(durations.begin(), middle, durations.end());
+  auto median = static_cast<double>(*middle);
+
+  if (durations.size() % 2 == 0) {
+    const auto lowerMiddle = std::max_element(durations.begin(), middle);
+    median = (median + static_cast<double>(*lowerMiddle)) / 2;
+  }
+
+  if (median == 0) {
+    return std::nullopt;
+  }
+
+  return static_cast<double>(series.records[recordIndex].duration.count()) /
+         median;
+}
+}
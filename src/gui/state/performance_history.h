@@ -0,0 +1,101 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_PERFORMANCE_HISTORY
+#define LOOT_GUI_STATE_PERFORMANCE_HISTORY
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace loot {
+// The number of records that are kept in the history file. Older records are
+// dropped when new records are added.
+static constexpr size_t PERFORMANCE_HISTORY_MAX_RECORDS = 1000;
+
+// The number of earlier records in a series that a record's duration is
+// compared against.
+static constexpr size_t PERFORMANCE_HISTORY_COMPARISON_COUNT = 10;
+
+enum struct PerformanceMetric : uint8_t {
+  // From the main window being created to the plugin cards being displayed.
+  startup = 0,
+  sort = 1,
+  masterlistUpdate = 2,
+  overlapQuery = 3,
+  // From a refresh being requested to the plugin cards being updated.
+  refresh = 4,
+};
+
+std::string ToString(PerformanceMetric metric);
+
+// A timing of one of LOOT's key operations, recorded so that changes in
+// performance can be seen across sessions.
+struct PerformanceRecord {
+  std::chrono::system_clock::time_point recordedAt;
+  std::string gameFolderName;
+  PerformanceMetric metric{PerformanceMetric::startup};
+  std::chrono::milliseconds duration{0};
+  uint32_t pluginCount{0};
+};
+
+// The records for one game and metric, in the order that they were recorded.
+struct PerformanceSeries {
+  std::string gameFolderName;
+  PerformanceMetric metric{PerformanceMetric::startup};
+  std::vector<PerformanceRecord> records;
+};
+
+// Returns an empty history if the file does not exist. Throws if the file is
+// not a valid history file.
+std::vector<PerformanceRecord> LoadPerformanceHistory(
+    const std::filesystem::path& filePath);
+
+void SavePerformanceHistory(const std::filesystem::path& filePath,
+                            const std::vector<PerformanceRecord>& records);
+
+// Adds the record to the end of the history in the given file, dropping the
+// oldest records if there are more than PERFORMANCE_HISTORY_MAX_RECORDS. If
+// the existing file is invalid, it's replaced.
+void AppendPerformanceRecord(const std::filesystem::path& filePath,
+                             const PerformanceRecord& record);
+
+// Group the records by game and metric, ordered by game folder name and then
+// metric.
+std::vector<PerformanceSeries> GetPerformanceSeries(
+    const std::vector<PerformanceRecord>& records);
+
+// Get how many times longer the record at the given index in the series took
+// than the median of the up to PERFORMANCE_HISTORY_COMPARISON_COUNT records
+// before it. Returns std::nullopt if there are no earlier records, or their
+// median duration is zero.
+std::optional<double> GetRelativeDuration(const PerformanceSeries& series,
+                                          size_t recordIndex);
+}
+
+#endif
@@ -0,0 +1,232 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/run_metrics.h"
+
+#include <spdlog/fmt/chrono.h>
+#include <spdlog/fmt/fmt.h>
+
+#include <fstream>
+#include <stdexcept>
+
+#include "gui/state/logging.h"
+
+namespace {
+using loot::CacheStats;
+using loot::OperationTiming;
+using std::chrono::duration_cast;
+using std::chrono::milliseconds;
+
+std::string ToJsonString(const std::string& text) {
+  std::string json = "\"";
+  json.reserve(text.size() + 2);
+
+  for (const auto character : text) {
+    if (character == '"' || character == '\\') {
+      json += '\\';
+      json += character;
+    } else if (static_cast<unsigned char>(character) < 0x20) {
+      json += fmt::format("\\u{:04x}", static_cast<unsigned int>(character));
+    } else {
+      json += character;
+    }
+  }
+
+  json += '"';
+  return json;
+}
+
+std::string ToJson(const CacheStats& stats) {
+  const auto lookups = stats.hits + stats.misses;
+  const auto hitRate =
+      lookups == 0 ? 0.0
+                   : static_cast<double>(stats.hits) /
+                         static_cast<double>(lookups);
+
+  return fmt::format(R"({{"name":{},"hits":{},"misses":{},"hitRate":{:.4f}}})",
+                     ToJsonString(stats.cacheName),
+                     stats.hits,
+                     stats.misses,
+                     hitRate);
+}
+
+std::string ToJson(const OperationTiming& timing) {
+  return fmt::format(R"({{"name":{},"count":{},"totalMs":{},"maxMs":{}}})",
+                     ToJsonString(timing.operationName),
+                     timing.count,
+                     duration_cast<milliseconds>(timing.totalDuration).count(),
+                     duration_cast<milliseconds>(timing.maxDuration).count());
+}
+
+template<typename T>
+std::string ToJsonArray(const std::vector<T>& values) {
+  std::string json = "[";
+  for (const auto& value : values) {
+    if (json.size() > 1) {
+      json += ',';
+    }
+    json += ToJson(value);
+  }
+  json += ']';
+
+  return json;
+}
+
+void logWriteError(const std::string& message) {
+  const auto logger = loot::getLogger();
+  if (logger) {
+    logger->error("{}", message);
+  }
+}
+}
+
+namespace loot {
+std::string GetMetricId(PerformanceMetric metric) {
+  switch (metric) {
+    case PerformanceMetric::startup:
+      return "startup";
+    case PerformanceMetric::sort:
+      return "sort";
+    case PerformanceMetric::masterlistUpdate:
+      return "masterlistUpdate";
+    case PerformanceMetric::overlapQuery:
+      return "overlapQuery";
+    case PerformanceMetric::refresh:
+      return "refresh";
+    default:
+      return "unknown";
+  }
+}
+
+std::string ToJsonLine(const RunMetricsRecord& record) {
+  const auto recordedAt =
+      std::chrono::system_clock::to_time_t(record.recordedAt);
+  const auto peakMemory =
+      record.peakMemoryBytes.has_value()
+          ? std::to_string(record.peakMemoryBytes.value())
+          : "null";
+
+  return fmt::format(
+      R"({{"recordedAt":"{:%Y-%m-%dT%H:%M:%SZ}","lootVersion":{},)"
+      R"("game":{},"operation":{},"durationMs":{},"pluginCount":{},)"
+      R"("peakMemoryBytes":{},"caches":{},"timings":{}}})",
+      fmt::gmtime(recordedAt),
+      ToJsonString(record.lootVersion),
+      ToJsonString(record.gameFolderName),
+      ToJsonString(GetMetricId(record.operation)),
+      record.duration.count(),
+      record.pluginCount,
+      peakMemory,
+      ToJsonArray(record.cacheStats),
+      ToJsonArray(record.operationTimings));
+}
+
+RunMetricsWriter::RunMetricsWriter(const std::filesystem::path& filePath) :
+    filePath_(filePath), thread_([this]() { run(); }) {}
+
+RunMetricsWriter::~RunMetricsWriter() { stop(); }
+
+const std::filesystem::path& RunMetricsWriter::getFilePath() const {
+  return filePath_;
+}
+
+void RunMetricsWriter::append(const RunMetricsRecord& record) {
+  auto line = ToJsonLine(record);
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (stopping_) {
+      return;
+    }
+    queue_.push_back(std::move(line));
+  }
+  condition_.notify_one();
+}
+
+void RunMetricsWriter::stop() {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    stopping_ = true;
+  }
+  condition_.notify_one();
+
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void RunMetricsWriter::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  while (true) {
+    condition_.wait(lock, [&]() { return stopping_ || !queue_.empty(); });
+
+    // Records are small, so write everything that's queued even when
+    // stopping.
+    std::vector<std::string> lines(queue_.begin(), queue_.end());
+    queue_.clear();
+    const auto stopping = stopping_;
+
+    lock.unlock();
+
+    if (!lines.empty()) {
+      write(lines);
+    }
+
+    if (stopping) {
+      return;
+    }
+
+    lock.lock();
+  }
+}
+
+void RunMetricsWriter::write(const std::vector<std::string>& lines) const {
+  try {
+    if (filePath_.has_parent_path()) {
+      std::filesystem::create_directories(filePath_.parent_path());
+    }
+
+    std::ofstream out(filePath_,
+                      std::ios_base::out | std::ios_base::binary |
+                          std::ios_base::app);
+    if (!out.is_open()) {
+      throw std::runtime_error(filePath_.u8string() +
+                               " could not be opened for writing");
+    }
+
+    for (const auto& line : lines) {
+      out << line << '\n';
+    }
+
+    out.close();
+
+    if (out.fail()) {
+      throw std::runtime_error("Failed to write to " + filePath_.u8string());
+    }
+  } catch (const std::exception& e) {
+    logWriteError(std::string("Failed to export run metrics: ") + e.what());
+  }
+}
+}
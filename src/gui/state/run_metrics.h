@@ -0,0 +1,104 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_RUN_METRICS
+#define LOOT_GUI_STATE_RUN_METRICS
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gui/state/diagnostics.h"
+#include "gui/state/performance_history.h"
+#include "gui/state/timing.h"
+
+namespace loot {
+// A snapshot of LOOT's performance taken after one of its key operations
+// finishes, for aggregating across installs.
+struct RunMetricsRecord {
+  std::chrono::system_clock::time_point recordedAt;
+  std::string lootVersion;
+  std::string gameFolderName;
+  PerformanceMetric operation{PerformanceMetric::startup};
+  std::chrono::milliseconds duration{0};
+  uint32_t pluginCount{0};
+  std::optional<uint64_t> peakMemoryBytes;
+  // Cache stats and operation timings are totals since LOOT started.
+  std::vector<CacheStats> cacheStats;
+  std::vector<OperationTiming> operationTimings;
+};
+
+// Get a stable identifier for the metric to use in exported metrics, which
+// unlike ToString() is not meant to be displayed.
+std::string GetMetricId(PerformanceMetric metric);
+
+// Serialise the record as a JSON object on a single line, without a trailing
+// line break.
+std::string ToJsonLine(const RunMetricsRecord& record);
+
+// Appends records as JSON lines to a file on a background thread, so that
+// exporting metrics never blocks the thread that records them. The file and
+// its parent directories are created if they don't exist, and errors are
+// logged.
+class RunMetricsWriter {
+public:
+  explicit RunMetricsWriter(const std::filesystem::path& filePath);
+  ~RunMetricsWriter();
+
+  RunMetricsWriter(const RunMetricsWriter&) = delete;
+  RunMetricsWriter(RunMetricsWriter&&) = delete;
+  RunMetricsWriter& operator=(const RunMetricsWriter&) = delete;
+  RunMetricsWriter& operator=(RunMetricsWriter&&) = delete;
+
+  const std::filesystem::path& getFilePath() const;
+
+  void append(const RunMetricsRecord& record);
+
+  // Writes any records that are still queued and stops the background
+  // thread. Records appended after this is called are discarded.
+  void stop();
+
+private:
+  void run();
+  void write(const std::vector<std::string>& lines) const;
+
+  const std::filesystem::path filePath_;
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::deque<std::string> queue_;
+  bool stopping_{false};
+  std::thread thread_;
+};
+}
+
+#endif
@@ -0,0 +1,161 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/thread_pool.h"
+
+#include <QtCore/QRunnable>
+#include <QtCore/QThread>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <future>
+#include <memory>
+
+namespace {
+using loot::TaskPriority;
+
+// Unlike QRunnable::create(), this isn't deleted by the pool, so it can be
+// taken back from the pool's queue and waited on.
+class FunctionRunnable : public QRunnable {
+public:
+  explicit FunctionRunnable(const std::function<void()>& function) :
+      function_(function), finished_(promise_.get_future()) {
+    setAutoDelete(false);
+  }
+
+  void run() override {
+    try {
+      function_();
+    } catch (...) {
+      exception_ = std::current_exception();
+    }
+
+    promise_.set_value();
+  }
+
+  void wait() const { finished_.wait(); }
+
+  std::exception_ptr getException() const { return exception_; }
+
+private:
+  std::function<void()> function_;
+  std::promise<void> promise_;
+  std::future<void> finished_;
+  std::exception_ptr exception_;
+};
+}
+
+namespace loot {
+QThreadPool& getThreadPool() { return *QThreadPool::globalInstance(); }
+
+void setMaxWorkerThreadCount(int count) {
+  const auto threadCount =
+      count > 0 ? count : std::max(1, QThread::idealThreadCount());
+
+  getThreadPool().setMaxThreadCount(threadCount);
+}
+
+void runConcurrently(const std::vector<std::function<void()>>& functions,
+                     TaskPriority priority) {
+  if (functions.empty()) {
+    return;
+  }
+
+  auto& pool = getThreadPool();
+
+  std::vector<std::unique_ptr<FunctionRunnable>> runnables;
+  runnables.reserve(functions.size() - 1);
+  for (size_t i = 1; i < functions.size(); i += 1) {
+    runnables.push_back(std::make_unique<FunctionRunnable>(functions[i]));
+    pool.start(runnables.back().get(), static_cast<int>(priority));
+  }
+
+  std::exception_ptr firstException;
+  try {
+    functions[0]();
+  } catch (...) {
+    firstException = std::current_exception();
+  }
+
+  // Run anything that the pool hasn't started yet on this thread, so that
+  // waiting can't deadlock if every pool thread is itself waiting.
+  for (const auto& runnable : runnables) {
+    if (pool.tryTake(runnable.get())) {
+      runnable->run();
+    }
+  }
+
+  // Wait for all the functions to finish before rethrowing any error, as they
+  // may reference the caller's locals.
+  for (const auto& runnable : runnables) {
+    runnable->wait();
+
+    if (!firstException) {
+      firstException = runnable->getException();
+    }
+  }
+
+  if (firstException) {
+    std::rethrow_exception(firstException);
+  }
+}
+
+void parallelFor(size_t count,
+                 const std::function<void(size_t)>& function,
+                 size_t maxConcurrency,
+                 TaskPriority priority) {
+  const auto poolThreadCount =
+      static_cast<size_t>(std::max(1, getThreadPool().maxThreadCount()));
+  auto workerCount = std::min(count, poolThreadCount);
+  if (maxConcurrency > 0) {
+    workerCount = std::min(workerCount, maxConcurrency);
+  }
+
+  if (workerCount <= 1) {
+    for (size_t i = 0; i < count; i += 1) {
+      function(i);
+    }
+    return;
+  }
+
+  std::atomic<size_t> nextIndex{0};
+  std::atomic<bool> hasFailed{false};
+
+  const auto worker = [&]() {
+    try {
+      for (auto index = nextIndex++; index < count && !hasFailed;
+           index = nextIndex++) {
+        function(index);
+      }
+    } catch (...) {
+      hasFailed = true;
+      throw;
+    }
+  };
+
+  runConcurrently(std::vector<std::function<void()>>(workerCount, worker),
+                  priority);
+}
+}
@@ -0,0 +1,110 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_THREAD_POOL
+#define LOOT_GUI_STATE_THREAD_POOL
+
+#include <QtCore/QThreadPool>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+namespace loot {
+// Higher priority work is started first when the pool is busy.
+enum struct TaskPriority : int {
+  background = 0,
+  normal = 1,
+  interactive = 2,
+};
+
+// All of LOOT's parallel work runs on this pool. It's Qt's global thread
+// pool, so work run using QtConcurrent shares it too, and the number of
+// threads doing work at once is bounded by its maximum thread count.
+QThreadPool& getThreadPool();
+
+// Limit the number of worker threads in the pool. Zero uses one thread per
+// logical CPU core.
+void setMaxWorkerThreadCount(int count);
+
+// Run the given functions concurrently, using the calling thread and the
+// thread pool, and return once they've all finished. Functions that are still
+// queued once the calling thread is free are run on the calling thread, so
+// it's safe to call this from a pool thread. If any functions throw, the
+// exception from the first of them is rethrown.
+void runConcurrently(const std::vector<std::function<void()>>& functions,
+                     TaskPriority priority = TaskPriority::normal);
+
+// Call the given function with each index from zero up to the given count,
+// concurrently, and return once all calls have finished. maxConcurrency
+// limits how many calls can run at once, with zero meaning no limit other
+// than the pool's. If any call throws, no more calls are started and the
+// first exception caught is rethrown.
+void parallelFor(size_t count,
+                 const std::function<void(size_t)>& function,
+                 size_t maxConcurrency = 0,
+                 TaskPriority priority = TaskPriority::normal);
+
+// Like std::transform, but the operation is applied concurrently. The
+// iterators must be random access iterators.
+template<typename InputIt, typename OutputIt, typename UnaryOperation>
+void parallelTransform(InputIt first,
+                       InputIt last,
+                       OutputIt output,
+                       UnaryOperation operation,
+                       TaskPriority priority = TaskPriority::normal) {
+  using Difference = typename std::iterator_traits<InputIt>::difference_type;
+  const auto count = static_cast<size_t>(std::distance(first, last));
+
+  parallelFor(
+      count,
+      [&](size_t index) {
+        const auto offset = static_cast<Difference>(index);
+        *(output + offset) = operation(*(first + offset));
+      },
+      0,
+      priority);
+}
+
+// Like std::for_each, but the function is called concurrently. The iterators
+// must be random access iterators.
+template<typename RandomIt, typename Function>
+void parallelForEach(RandomIt first,
+                     RandomIt last,
+                     const Function& function,
+                     TaskPriority priority = TaskPriority::normal) {
+  using Difference = typename std::iterator_traits<RandomIt>::difference_type;
+  const auto count = static_cast<size_t>(std::distance(first, last));
+
+  parallelFor(
+      count,
+      [&](size_t index) {
+        function(*(first + static_cast<Difference>(index)));
+      },
+      0,
+      priority);
+}
+}
+
+#endif
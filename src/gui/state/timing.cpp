@@ -0,0 +1,200 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/timing.h"
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gui/state/logging.h"
+
+namespace {
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::steady_clock;
+
+struct OperationStats {
+  size_t count{0};
+  microseconds lastDuration{0};
+  microseconds totalDuration{0};
+  microseconds maxDuration{0};
+};
+
+struct TraceEvent {
+  std::string operationName;
+  size_t threadId{0};
+  microseconds startTime{0};
+  microseconds duration{0};
+};
+
+std::mutex timingMutex;
+std::map<std::string, OperationStats> operationStats;
+bool isTraceEnabled = false;
+std::vector<TraceEvent> traceEvents;
+
+// Trace event times are relative to when timing was first used.
+steady_clock::time_point getTimingEpoch() {
+  static const auto epoch = steady_clock::now();
+  return epoch;
+}
+
+std::string escapeJsonString(const std::string& text) {
+  std::string escaped;
+  escaped.reserve(text.size());
+
+  for (const auto character : text) {
+    if (character == '"' || character == '\\') {
+      escaped += '\\';
+      escaped += character;
+    } else if (static_cast<unsigned char>(character) < 0x20) {
+      escaped += ' ';
+    } else {
+      escaped += character;
+    }
+  }
+
+  return escaped;
+}
+
+void recordDuration(const std::string& operationName,
+                    steady_clock::time_point startTime,
+                    microseconds duration) {
+  std::lock_guard<std::mutex> guard(timingMutex);
+
+  auto& stats = operationStats[operationName];
+  stats.count += 1;
+  stats.lastDuration = duration;
+  stats.totalDuration += duration;
+  stats.maxDuration = std::max(stats.maxDuration, duration);
+
+  if (isTraceEnabled) {
+    traceEvents.push_back(TraceEvent{
+        operationName,
+        std::hash<std::thread::id>()(std::this_thread::get_id()),
+        duration_cast<microseconds>(startTime - getTimingEpoch()),
+        duration});
+  }
+}
+}
+
+namespace loot {
+ScopedTimer::ScopedTimer(std::string operationName) :
+    operationName_(std::move(operationName)) {
+  // Make sure the epoch isn't after the start time.
+  getTimingEpoch();
+  startTime_ = steady_clock::now();
+}
+
+ScopedTimer::~ScopedTimer() { stop(); }
+
+void ScopedTimer::stop() {
+  if (isStopped_) {
+    return;
+  }
+  isStopped_ = true;
+
+  const auto duration =
+      duration_cast<microseconds>(steady_clock::now() - startTime_);
+
+  try {
+    recordDuration(operationName_, startTime_, duration);
+
+    const auto logger = getLogger();
+    if (logger) {
+      logger->debug("{} took {} ms", operationName_, duration.count() / 1000.0);
+    }
+  } catch (...) {
+    // Timing is only diagnostic, so failing to record it shouldn't affect the
+    // operation that was timed.
+  }
+}
+
+void enableTimingTrace() {
+  std::lock_guard<std::mutex> guard(timingMutex);
+  isTraceEnabled = true;
+}
+
+void writeTimingTrace(const std::filesystem::path& outputPath) {
+  std::lock_guard<std::mutex> guard(timingMutex);
+
+  std::ofstream out(outputPath);
+  if (!out.is_open()) {
+    throw std::runtime_error("Couldn't open timing trace file for writing");
+  }
+
+  out << "{\"traceEvents\":[";
+  for (size_t i = 0; i < traceEvents.size(); i += 1) {
+    const auto& event = traceEvents[i];
+    if (i != 0) {
+      out << ',';
+    }
+
+    out << "\n{\"name\":\"" << escapeJsonString(event.operationName)
+        << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadId
+        << ",\"ts\":" << event.startTime.count()
+        << ",\"dur\":" << event.duration.count() << '}';
+  }
+  out << "\n]}\n";
+}
+
+void logTimingSummary() {
+  const auto logger = getLogger();
+  if (!logger) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(timingMutex);
+
+  logger->debug("Timing summary:");
+  for (const auto& [operationName, stats] : operationStats) {
+    logger->debug("{}: {} times, {} ms in total, {} ms at most",
+                  operationName,
+                  stats.count,
+                  stats.totalDuration.count() / 1000.0,
+                  stats.maxDuration.count() / 1000.0);
+  }
+}
+
+std::vector<OperationTiming> getOperationTimings() {
+  std::lock_guard<std::mutex> guard(timingMutex);
+
+  std::vector<OperationTiming> timings;
+  timings.reserve(operationStats.size());
+  for (const auto& [operationName, stats] : operationStats) {
+    timings.push_back(OperationTiming{operationName,
+                                      stats.count,
+                                      stats.lastDuration,
+                                      stats.totalDuration,
+                                      stats.maxDuration});
+  }
+
+  return timings;
+}
+}
@@ -0,0 +1,83 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_TIMING
+#define LOOT_GUI_STATE_TIMING
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace loot {
+// Measures how long an operation takes, from construction until stop() is
+// called or the timer is destroyed. The duration is logged at debug level and
+// added to the timing summary and, if enabled, the timing trace. It's safe to
+// time operations on any thread.
+class ScopedTimer {
+public:
+  explicit ScopedTimer(std::string operationName);
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer(ScopedTimer&&) = delete;
+  ~ScopedTimer();
+
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(ScopedTimer&&) = delete;
+
+  // Records the duration so far. Only the first call has any effect.
+  void stop();
+
+private:
+  std::string operationName_;
+  std::chrono::steady_clock::time_point startTime_;
+  bool isStopped_{false};
+};
+
+struct OperationTiming {
+  std::string operationName;
+  size_t count{0};
+  std::chrono::microseconds lastDuration{0};
+  std::chrono::microseconds totalDuration{0};
+  std::chrono::microseconds maxDuration{0};
+};
+
+// Start recording every timed operation so that they can be written out as a
+// trace. Until this is called only the summary of durations is kept.
+void enableTimingTrace();
+
+// Write the recorded timed operations in the Chrome trace event format, which
+// can be viewed using Chrome's about://tracing or Perfetto.
+void writeTimingTrace(const std::filesystem::path& outputPath);
+
+// Log the number of times each operation was timed and their total and
+// longest durations.
+void logTimingSummary();
+
+// Get the timing summary for each operation that has been timed so far,
+// ordered by operation name.
+std::vector<OperationTiming> getOperationTimings();
+}
+
+#endif
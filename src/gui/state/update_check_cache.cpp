@@ -0,0 +1,148 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/update_check_cache.h"
+
+#include <toml++/toml.h>
+
+#include <fstream>
+
+#include "gui/state/logging.h"
+
+namespace {
+static constexpr int64_t CACHE_FORMAT_VERSION = 1;
+
+static constexpr const char* VERSION_KEY = "version";
+static constexpr const char* REVISION_KEY = "revision";
+static constexpr const char* CHECKED_AT_KEY = "checkedAt";
+static constexpr const char* IS_UPDATE_AVAILABLE_KEY = "isUpdateAvailable";
+static constexpr const char* LATEST_RELEASE_ETAG_KEY = "latestReleaseETag";
+static constexpr const char* LATEST_RELEASE_LAST_MODIFIED_KEY =
+    "latestReleaseLastModified";
+}
+
+namespace loot {
+std::optional<UpdateCheckCache> LoadUpdateCheckCache(
+    const std::filesystem::path& cachePath,
+    const std::string& revision) {
+  const auto logger = getLogger(LogCategory::network);
+
+  if (!std::filesystem::exists(cachePath)) {
+    return std::nullopt;
+  }
+
+  try {
+    // Don't use toml::parse_file() as it just uses a std stream,
+    // which don't support UTF-8 paths on Windows.
+    std::ifstream in(cachePath);
+    if (!in.is_open()) {
+      throw std::runtime_error(cachePath.u8string() +
+                               " could not be opened for parsing");
+    }
+
+    const auto table = toml::parse(in, cachePath.u8string());
+
+    const auto cachedRevision = table[REVISION_KEY].value<std::string>();
+    const auto checkedAt = table[CHECKED_AT_KEY].value<int64_t>();
+    const auto isUpdateAvailable = table[IS_UPDATE_AVAILABLE_KEY].value<bool>();
+    if (table[VERSION_KEY].value<int64_t>() != CACHE_FORMAT_VERSION ||
+        !cachedRevision.has_value() || !checkedAt.has_value() ||
+        !isUpdateAvailable.has_value()) {
+      if (logger) {
+        logger->warn("The update check cache at {} is invalid, ignoring it.",
+                     cachePath.u8string());
+      }
+      return std::nullopt;
+    }
+
+    if (cachedRevision.value() != revision) {
+      if (logger) {
+        logger->debug(
+            "The update check cache was written for a different LOOT build, "
+            "ignoring it.");
+      }
+      return std::nullopt;
+    }
+
+    UpdateCheckCache cache;
+    cache.revision = cachedRevision.value();
+    cache.checkedAt = std::chrono::system_clock::time_point(
+        std::chrono::seconds(checkedAt.value()));
+    cache.isUpdateAvailable = isUpdateAvailable.value();
+    cache.latestReleaseETag =
+        table[LATEST_RELEASE_ETAG_KEY].value_or(std::string());
+    cache.latestReleaseLastModified =
+        table[LATEST_RELEASE_LAST_MODIFIED_KEY].value_or(std::string());
+
+    return cache;
+  } catch (const std::exception& e) {
+    if (logger) {
+      logger->error("Failed to read the update check cache at {}: {}",
+                    cachePath.u8string(),
+                    e.what());
+    }
+    return std::nullopt;
+  }
+}
+
+void SaveUpdateCheckCache(const std::filesystem::path& cachePath,
+                          const UpdateCheckCache& cache) {
+  const auto checkedAt = std::chrono::duration_cast<std::chrono::seconds>(
+                             cache.checkedAt.time_since_epoch())
+                             .count();
+
+  const toml::table table{
+      {VERSION_KEY, CACHE_FORMAT_VERSION},
+      {REVISION_KEY, cache.revision},
+      {CHECKED_AT_KEY, static_cast<int64_t>(checkedAt)},
+      {IS_UPDATE_AVAILABLE_KEY, cache.isUpdateAvailable},
+      {LATEST_RELEASE_ETAG_KEY, cache.latestReleaseETag},
+      {LATEST_RELEASE_LAST_MODIFIED_KEY, cache.latestReleaseLastModified}};
+
+  auto tempPath = cachePath;
+  tempPath += ".tmp";
+
+  std::ofstream out(tempPath);
+  if (!out.is_open()) {
+    throw std::runtime_error(tempPath.u8string() +
+                             " could not be opened for writing");
+  }
+
+  out << table;
+  out.close();
+
+  if (out.fail()) {
+    throw std::runtime_error("Failed to write to " + tempPath.u8string());
+  }
+
+  std::filesystem::rename(tempPath, cachePath);
+}
+
+bool IsUpdateCheckCacheFresh(const UpdateCheckCache& cache,
+                             std::chrono::system_clock::time_point now) {
+  return cache.checkedAt <= now &&
+         now - cache.checkedAt < UPDATE_CHECK_CACHE_MAX_AGE;
+}
+}
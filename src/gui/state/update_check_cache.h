@@ -0,0 +1,66 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_UPDATE_CHECK_CACHE
+#define LOOT_GUI_STATE_UPDATE_CHECK_CACHE
+
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+namespace loot {
+// How long a cached update check result is used for before LOOT checks for
+// updates again.
+static constexpr std::chrono::hours UPDATE_CHECK_CACHE_MAX_AGE{24};
+
+// The result of the last LOOT update check, along with the validators that
+// GitHub gave for the latest release, so that the next check can be skipped
+// while the result is fresh and made conditional once it isn't.
+struct UpdateCheckCache {
+  // The revision of the LOOT build that the result was calculated for.
+  std::string revision;
+  std::chrono::system_clock::time_point checkedAt;
+  bool isUpdateAvailable{false};
+  std::string latestReleaseETag;
+  std::string latestReleaseLastModified;
+};
+
+// Returns std::nullopt if the cache does not exist, is invalid or was written
+// for a different LOOT build revision. Errors are logged, not thrown.
+std::optional<UpdateCheckCache> LoadUpdateCheckCache(
+    const std::filesystem::path& cachePath,
+    const std::string& revision);
+
+void SaveUpdateCheckCache(const std::filesystem::path& cachePath,
+                          const UpdateCheckCache& cache);
+
+// A cache with a check time in the future is not fresh, in case the system
+// clock has been changed since it was written.
+bool IsUpdateCheckCacheFresh(const UpdateCheckCache& cache,
+                             std::chrono::system_clock::time_point now);
+}
+
+#endif
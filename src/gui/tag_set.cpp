@@ -0,0 +1,111 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/tag_set.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace {
+using loot::InternedString;
+
+// Interned strings are equal if and only if they have the same storage, so
+// ordering them by their storage is a valid and cheap strict weak ordering.
+bool IsStoredBefore(const InternedString& lhs, const InternedString& rhs) {
+  return std::less<const std::string*>()(&lhs.str(), &rhs.str());
+}
+
+void Insert(std::vector<InternedString>& names, InternedString name) {
+  const auto it =
+      std::lower_bound(names.begin(), names.end(), name, IsStoredBefore);
+  if (it == names.end() || *it != name) {
+    names.insert(it, name);
+  }
+}
+
+void Sort(std::vector<InternedString>& names) {
+  std::sort(names.begin(), names.end(), IsStoredBefore);
+  names.erase(std::unique(names.begin(), names.end()), names.end());
+}
+
+void AppendIntersection(const std::vector<InternedString>& names1,
+                        const std::vector<InternedString>& names2,
+                        std::vector<std::string>& intersection) {
+  auto it1 = names1.begin();
+  auto it2 = names2.begin();
+  while (it1 != names1.end() && it2 != names2.end()) {
+    if (IsStoredBefore(*it1, *it2)) {
+      ++it1;
+    } else if (IsStoredBefore(*it2, *it1)) {
+      ++it2;
+    } else {
+      intersection.push_back(it1->str());
+      ++it1;
+      ++it2;
+    }
+  }
+}
+}
+
+namespace loot {
+TagSet::TagSet(const std::vector<Tag>& tags) {
+  for (const auto& tag : tags) {
+    if (tag.IsAddition()) {
+      additions_.emplace_back(tag.GetName());
+    } else {
+      removals_.emplace_back(tag.GetName());
+    }
+  }
+
+  Sort(additions_);
+  Sort(removals_);
+}
+
+TagSet::TagSet(const std::vector<InternedString>& additions,
+               const std::vector<InternedString>& removals) :
+    additions_(additions), removals_(removals) {
+  Sort(additions_);
+  Sort(removals_);
+}
+
+void TagSet::Add(std::string_view name, bool isAddition) {
+  Insert(isAddition ? additions_ : removals_, InternedString(name));
+}
+
+bool TagSet::empty() const noexcept {
+  return additions_.empty() && removals_.empty();
+}
+
+std::vector<std::string> TagSet::GetConflicts(const TagSet& other) const {
+  std::vector<std::string> conflicts;
+
+  AppendIntersection(additions_, other.removals_, conflicts);
+  AppendIntersection(other.additions_, removals_, conflicts);
+
+  std::sort(conflicts.begin(), conflicts.end());
+
+  return conflicts;
+}
+}
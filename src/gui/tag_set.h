@@ -0,0 +1,64 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_TAG_SET
+#define LOOT_GUI_TAG_SET
+
+#include <loot/metadata/tag.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gui/interned_string.h"
+
+namespace loot {
+// A set of Bash Tag additions and removals, which is how all sources of Bash
+// Tags can be compared: LOOT's metadata, plugin items and BashTags files. The
+// tag names are interned and each half of the set is kept sorted by the
+// names' pooled storage, so finding conflicts between two sets is a merge of
+// pointers that doesn't allocate unless there are conflicts.
+class TagSet {
+public:
+  TagSet() = default;
+  explicit TagSet(const std::vector<Tag>& tags);
+  TagSet(const std::vector<InternedString>& additions,
+         const std::vector<InternedString>& removals);
+
+  void Add(std::string_view name, bool isAddition);
+
+  bool empty() const noexcept;
+
+  // Returns the names of tags that are added by one set but removed by the
+  // other, in lexicographical order.
+  std::vector<std::string> GetConflicts(const TagSet& other) const;
+
+private:
+  std::vector<InternedString> additions_;
+  std::vector<InternedString> removals_;
+};
+}
+
+#endif
@@ -0,0 +1,72 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/translation_cache.h"
+
+#include <boost/locale.hpp>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace {
+struct TranslationCache {
+  std::shared_mutex mutex;
+  // Map values are nodes that never move, so references to them stay valid
+  // as more translations are added.
+  std::unordered_map<const char*, std::string> translations;
+};
+
+TranslationCache& getTranslationCache() {
+  static TranslationCache cache;
+  return cache;
+}
+}
+
+namespace loot {
+const std::string& TranslateCached(const char* message) {
+  auto& cache = getTranslationCache();
+
+  {
+    std::shared_lock lock(cache.mutex);
+    const auto it = cache.translations.find(message);
+    if (it != cache.translations.end()) {
+      return it->second;
+    }
+  }
+
+  auto translation = boost::locale::translate(message).str();
+
+  std::unique_lock lock(cache.mutex);
+  return cache.translations.emplace(message, std::move(translation))
+      .first->second;
+}
+
+void ClearTranslationCache() {
+  auto& cache = getTranslationCache();
+
+  std::unique_lock lock(cache.mutex);
+  cache.translations.clear();
+}
+}
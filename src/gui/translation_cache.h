@@ -0,0 +1,46 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_TRANSLATION_CACHE
+#define LOOT_GUI_TRANSLATION_CACHE
+
+#include <string>
+
+namespace loot {
+// Translating a message looks it up in the global locale's message catalog and
+// allocates a new string each time, which adds up when the same messages are
+// generated for every plugin. This translates each message once and then
+// returns the cached translation.
+//
+// Messages are cached by address, so the message must be a string literal.
+// The returned reference stays valid until the cache is cleared.
+const std::string& TranslateCached(const char* message);
+
+// Clears all cached translations. This must be called when the global locale
+// changes, while no cached translations are in use.
+void ClearTranslationCache();
+}
+
+#endif
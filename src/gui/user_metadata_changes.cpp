@@ -0,0 +1,93 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/user_metadata_changes.h"
+
+#include <functional>
+
+namespace {
+template<typename T, typename Getter>
+std::vector<T> GetValue(const std::optional<std::vector<T>>& change,
+                        const std::optional<loot::PluginMetadata>& metadata,
+                        Getter getter) {
+  if (change.has_value()) {
+    return change.value();
+  }
+
+  if (metadata.has_value()) {
+    return std::invoke(getter, metadata.value());
+  }
+
+  return {};
+}
+}
+
+namespace loot {
+bool UserMetadataChanges::isEmpty() const {
+  return !isGroupChanged && !loadAfterFiles.has_value() &&
+         !requirements.has_value() && !incompatibilities.has_value() &&
+         !messages.has_value() && !tags.has_value() &&
+         !dirtyInfo.has_value() && !cleanInfo.has_value() &&
+         !locations.has_value();
+}
+
+PluginMetadata ApplyUserMetadataChanges(
+    const std::optional<PluginMetadata>& userMetadata,
+    const UserMetadataChanges& changes) {
+  // Build new metadata instead of modifying a copy of the existing metadata,
+  // so that a group that has been changed to be unset isn't carried over.
+  PluginMetadata metadata(changes.pluginName);
+
+  const auto group = changes.isGroupChanged
+                         ? changes.group
+                         : (userMetadata.has_value() ? userMetadata->GetGroup()
+                                                     : std::nullopt);
+  if (group.has_value()) {
+    metadata.SetGroup(group.value());
+  }
+
+  metadata.SetLoadAfterFiles(GetValue(changes.loadAfterFiles,
+                                      userMetadata,
+                                      &PluginMetadata::GetLoadAfterFiles));
+  metadata.SetRequirements(GetValue(
+      changes.requirements, userMetadata, &PluginMetadata::GetRequirements));
+  metadata.SetIncompatibilities(
+      GetValue(changes.incompatibilities,
+               userMetadata,
+               &PluginMetadata::GetIncompatibilities));
+  metadata.SetMessages(
+      GetValue(changes.messages, userMetadata, &PluginMetadata::GetMessages));
+  metadata.SetTags(
+      GetValue(changes.tags, userMetadata, &PluginMetadata::GetTags));
+  metadata.SetDirtyInfo(
+      GetValue(changes.dirtyInfo, userMetadata, &PluginMetadata::GetDirtyInfo));
+  metadata.SetCleanInfo(
+      GetValue(changes.cleanInfo, userMetadata, &PluginMetadata::GetCleanInfo));
+  metadata.SetLocations(
+      GetValue(changes.locations, userMetadata, &PluginMetadata::GetLocations));
+
+  return metadata;
+}
+}
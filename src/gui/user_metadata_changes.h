@@ -0,0 +1,64 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_USER_METADATA_CHANGES
+#define LOOT_GUI_USER_METADATA_CHANGES
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "loot/metadata/plugin_metadata.h"
+
+namespace loot {
+// The new values of the fields of a plugin's user metadata that have been
+// edited. Fields that have not been edited have no value.
+struct UserMetadataChanges {
+  bool isEmpty() const;
+
+  std::string pluginName;
+  // The group is optional in user metadata, so this is only meaningful if
+  // isGroupChanged is true.
+  bool isGroupChanged{false};
+  std::optional<std::string> group;
+  std::optional<std::vector<File>> loadAfterFiles;
+  std::optional<std::vector<File>> requirements;
+  std::optional<std::vector<File>> incompatibilities;
+  std::optional<std::vector<Message>> messages;
+  std::optional<std::vector<Tag>> tags;
+  std::optional<std::vector<PluginCleaningData>> dirtyInfo;
+  std::optional<std::vector<PluginCleaningData>> cleanInfo;
+  std::optional<std::vector<Location>> locations;
+};
+
+// Get the user metadata that results from applying the changes to the
+// plugin's existing user metadata, which is nullopt if it has none. Fields
+// that haven't been changed keep their existing values.
+PluginMetadata ApplyUserMetadataChanges(
+    const std::optional<PluginMetadata>& userMetadata,
+    const UserMetadataChanges& changes);
+}
+
+#endif
@@ -35,6 +35,7 @@ along with LOOT.  If not, see
 #include <filesystem>
 #include <fstream>
 #include <map>
+#include <optional>
 
 #include "gui/state/game/detection/game_install.h"
 #include "loot/enum/game_type.h"
@@ -52,9 +53,63 @@ static const std::array<GameType, 9> ALL_GAME_TYPES = {GameType::tes3,
                                                        GameType::fo4,
                                                        GameType::fo4vr};
 
+// How a fixture creates its game's files for each test.
+enum struct FixtureFiles {
+  // Each test's files are written from scratch.
+  copied,
+  // The files are written once per test binary into a snapshot that is then
+  // cloned for each test. Plugins are hard-linked into each test's tree
+  // unless the game's load order is stored in their timestamps, and other
+  // files are copied. Tests that change the content or timestamps of
+  // existing plugins must first call detachFromSnapshot() on them, or the
+  // change would be seen by later tests.
+  sharedSnapshot,
+};
+
+// The snapshots of the initial state of each game's files, which are deleted
+// when the test binary exits.
+class FixtureSnapshots {
+public:
+  FixtureSnapshots() = default;
+  FixtureSnapshots(const FixtureSnapshots&) = delete;
+  FixtureSnapshots(FixtureSnapshots&&) = delete;
+
+  ~FixtureSnapshots() {
+    for (const auto& [gameId, path] : paths_) {
+      std::error_code ec;
+      std::filesystem::remove_all(path, ec);
+    }
+  }
+
+  FixtureSnapshots& operator=(const FixtureSnapshots&) = delete;
+  FixtureSnapshots& operator=(FixtureSnapshots&&) = delete;
+
+  static FixtureSnapshots& get() {
+    static FixtureSnapshots snapshots;
+    return snapshots;
+  }
+
+  std::optional<std::filesystem::path> find(GameId gameId) const {
+    const auto it = paths_.find(gameId);
+    if (it == paths_.end()) {
+      return std::nullopt;
+    }
+
+    return it->second;
+  }
+
+  void insert(GameId gameId, const std::filesystem::path& path) {
+    paths_.emplace(gameId, path);
+  }
+
+private:
+  std::map<GameId, std::filesystem::path> paths_;
+};
+
 class CommonGameTestFixture : public ::testing::Test {
 protected:
-  CommonGameTestFixture(const GameId gameId) :
+  CommonGameTestFixture(const GameId gameId,
+                        FixtureFiles files = FixtureFiles::copied) :
       gameId_(gameId),
       rootTestPath(getTempPath()),
       missingPath(rootTestPath / "missing"),
@@ -78,7 +133,11 @@ protected:
           "Blank - Different Plugin Dependent.esp"),
       nonAsciiEsp(u8"non\u00C1scii.esp"),
       blankEsmCrc(getBlankEsmCrc()) {
-    assertInitialState();
+    if (files == FixtureFiles::sharedSnapshot) {
+      initialiseFromSnapshot();
+    } else {
+      assertInitialState();
+    }
   }
 
   void assertInitialState() {
@@ -136,6 +195,30 @@ protected:
     ASSERT_FALSE(exists(dataPath / missingEsp));
   }
 
+  // Replace a file that may be hard-linked to the fixture's snapshot with a
+  // copy, so that it can be changed without affecting other tests.
+  void detachFromSnapshot(const std::filesystem::path& path) const {
+    if (std::filesystem::hard_link_count(path) < 2) {
+      return;
+    }
+
+    auto copyPath = path;
+    copyPath += ".detached";
+
+    std::filesystem::copy_file(path, copyPath);
+    std::filesystem::last_write_time(copyPath,
+                                     std::filesystem::last_write_time(path));
+    std::filesystem::rename(copyPath, path);
+  }
+
+  void detachPluginsFromSnapshot() const {
+    for (const auto& entry : std::filesystem::directory_iterator(dataPath)) {
+      if (entry.is_regular_file()) {
+        detachFromSnapshot(entry.path());
+      }
+    }
+  }
+
   void TearDown() override {
     // Grant write permissions to everything in rootTestPath
     // in case the test made anything read only.
@@ -343,6 +426,69 @@ private:
     }
   }
 
+  void initialiseFromSnapshot() {
+    auto& snapshots = FixtureSnapshots::get();
+
+    const auto snapshotPath = snapshots.find(gameId_);
+    if (snapshotPath.has_value()) {
+      cloneTree(snapshotPath.value(),
+                rootTestPath,
+                !isLoadOrderTimestampBased(getGameType()));
+      return;
+    }
+
+    // The first test to use a game's snapshot creates it from its own files,
+    // before the test can change them.
+    assertInitialState();
+
+    const auto newSnapshotPath = getTempPath();
+    cloneTree(rootTestPath, newSnapshotPath, false);
+    snapshots.insert(gameId_, newSnapshotPath);
+  }
+
+  static void cloneTree(const std::filesystem::path& sourcePath,
+                        const std::filesystem::path& targetPath,
+                        bool linkPlugins) {
+    std::filesystem::create_directories(targetPath);
+
+    for (const auto& entry :
+         std::filesystem::recursive_directory_iterator(sourcePath)) {
+      const auto path =
+          targetPath / std::filesystem::relative(entry.path(), sourcePath);
+
+      if (entry.is_directory()) {
+        std::filesystem::create_directory(path);
+        continue;
+      }
+
+      if (linkPlugins && isPluginFile(entry.path())) {
+        // Fall back to copying if the filesystem doesn't support hard links.
+        std::error_code ec;
+        std::filesystem::create_hard_link(entry.path(), path, ec);
+        if (!ec) {
+          continue;
+        }
+      }
+
+      // Copies aren't guaranteed to keep their timestamps, which may hold
+      // the load order.
+      std::filesystem::copy_file(entry.path(), path);
+      std::filesystem::last_write_time(
+          path, std::filesystem::last_write_time(entry.path()));
+    }
+  }
+
+  static bool isPluginFile(const std::filesystem::path& path) {
+    auto filename = path.filename().u8string();
+    if (boost::iends_with(filename, ".ghost")) {
+      filename = path.stem().u8string();
+    }
+
+    return boost::iends_with(filename, ".esp") ||
+           boost::iends_with(filename, ".esm") ||
+           boost::iends_with(filename, ".esl");
+  }
+
   void setLoadOrder(
       const std::vector<std::pair<std::string, bool>>& loadOrder) const {
     using std::filesystem::u8path;
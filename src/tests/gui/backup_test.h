@@ -29,6 +29,8 @@ along with LOOT.  If not, see
 #include <boost/crc.hpp>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
+#include <string>
 
 #include "gui/backup.h"
 #include "tests/gui/test_helpers.h"
@@ -45,6 +47,9 @@ protected:
   static constexpr const char* gitConfig = "config";
   static constexpr const char* debugLog = "LOOTDebugLog.txt";
   static constexpr const char* backupsFolder = "backups";
+  static constexpr const char* logsFolder = "logs";
+  static constexpr const char* logArchive =
+      "LOOTDebugLog-19700101T000000-000.txt.zip";
   static constexpr const char* backupFile = "LOOT-backup-19700101T000000.zip";
   static constexpr const char* rootDirFile = "rootFile.txt";
   static constexpr const char* subFolder = "subFolder";
@@ -54,11 +59,13 @@ protected:
     std::filesystem::create_directories(destRoot);
     std::filesystem::create_directories(sourceRoot / emptyFolder);
     std::filesystem::create_directories(sourceRoot / backupsFolder);
+    std::filesystem::create_directories(sourceRoot / logsFolder);
     std::filesystem::create_directories(sourceRoot / subFolder / gitFolder);
 
     touch(sourceRoot / debugLog);
     touch(sourceRoot / rootDirFile);
     touch(sourceRoot / backupsFolder / backupFile);
+    touch(sourceRoot / logsFolder / logArchive);
     touch(sourceRoot / subFolder / subFolderFile);
     touch(sourceRoot / subFolder / gitFolder / gitConfig);
   }
@@ -108,6 +115,54 @@ protected:
 
 class CreateBackupTest : public BackupTest {};
 
+class IncrementalBackupTest : public BackupTest {
+protected:
+  static constexpr const char* backupName = "LOOT-backup-19700101T000001";
+
+  size_t countObjects() const {
+    size_t count = 0;
+    for (const auto& entry :
+         std::filesystem::directory_iterator(destRoot / "objects")) {
+      if (entry.is_regular_file()) {
+        count += 1;
+      }
+    }
+    return count;
+  }
+
+  void write(const std::filesystem::path& path, const std::string& content) {
+    std::ofstream out(path, std::ios::binary);
+    out << content;
+  }
+
+  std::string read(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in),
+                       std::istreambuf_iterator<char>());
+  }
+};
+
+class EnforceBackupRetentionPolicyTest : public IncrementalBackupTest {
+protected:
+  // Create a backup with the given root file content and a write time that is
+  // the given number of hours in the past.
+  std::filesystem::path createBackupAged(const std::string& name,
+                                         const std::string& content,
+                                         int ageInHours) {
+    write(sourceRoot / rootDirFile, content);
+
+    const auto manifestPath =
+        createIncrementalBackup(sourceRoot, destRoot, name).value();
+
+    std::filesystem::last_write_time(
+        manifestPath,
+        std::filesystem::file_time_type::clock::now() -
+            std::chrono::hours(ageInHours));
+
+    return manifestPath;
+  }
+};
+
 TEST_F(CompressDirectoryTest, shouldReturnThePathToAZipOfTheInput) {
   createBackup(sourceRoot, destRoot);
 
@@ -155,6 +210,15 @@ TEST_F(CreateBackupTest, shouldSkipBackupsDirectoryInRootDir) {
   EXPECT_FALSE(std::filesystem::exists(destRoot / backupsFolder));
 }
 
+TEST_F(CreateBackupTest, shouldSkipLogsDirectoryInRootDir) {
+  createBackup(sourceRoot, destRoot);
+
+  ASSERT_TRUE(std::filesystem::exists(destRoot / rootDirFile));
+  ASSERT_TRUE(std::filesystem::exists(destRoot / subFolder / subFolderFile));
+
+  EXPECT_FALSE(std::filesystem::exists(destRoot / logsFolder));
+}
+
 TEST_F(CreateBackupTest, shouldSkipDotGitFolderInAnyDirectory) {
   createBackup(sourceRoot, destRoot);
 
@@ -172,6 +236,160 @@ TEST_F(CreateBackupTest, shouldSkipEmptyDirectories) {
 
   EXPECT_FALSE(std::filesystem::exists(destRoot / emptyFolder));
 }
+
+TEST_F(IncrementalBackupTest,
+       createIncrementalBackupShouldReturnNothingIfThereAreNoFilesToBackup) {
+  const auto emptyRoot = sourceRoot / emptyFolder;
+
+  auto manifestPath = createIncrementalBackup(emptyRoot, destRoot, backupName);
+
+  EXPECT_FALSE(manifestPath.has_value());
+}
+
+TEST_F(IncrementalBackupTest,
+       createIncrementalBackupShouldStoreEachDistinctFileContentOnce) {
+  write(sourceRoot / rootDirFile, "content");
+
+  auto manifestPath = createIncrementalBackup(sourceRoot, destRoot, backupName);
+
+  ASSERT_TRUE(manifestPath.has_value());
+  EXPECT_EQ(destRoot / (std::string(backupName) + ".toml"),
+            manifestPath.value());
+  EXPECT_TRUE(std::filesystem::exists(manifestPath.value()));
+
+  // The root file's content is stored once, and the empty subfolder file's
+  // content is stored once.
+  EXPECT_EQ(2, countObjects());
+}
+
+TEST_F(IncrementalBackupTest,
+       createIncrementalBackupShouldOnlyStoreFilesThatHaveChanged) {
+  ASSERT_TRUE(
+      createIncrementalBackup(sourceRoot, destRoot, backupName).has_value());
+  ASSERT_EQ(1, countObjects());
+
+  write(sourceRoot / rootDirFile, "content");
+
+  auto manifestPath =
+      createIncrementalBackup(sourceRoot, destRoot, "LOOT-backup-2");
+
+  ASSERT_TRUE(manifestPath.has_value());
+  EXPECT_EQ(2, countObjects());
+}
+
+TEST_F(IncrementalBackupTest,
+       restoreIncrementalBackupShouldRecreateTheBackedUpFiles) {
+  write(sourceRoot / rootDirFile, "root\r\n");
+  write(sourceRoot / subFolder / subFolderFile, "sub\n");
+
+  auto manifestPath = createIncrementalBackup(sourceRoot, destRoot, backupName);
+  ASSERT_TRUE(manifestPath.has_value());
+
+  write(sourceRoot / rootDirFile, "changed");
+
+  const auto restoreRoot = destRoot / "restored";
+  restoreIncrementalBackup(manifestPath.value(), restoreRoot);
+
+  EXPECT_EQ("root\r\n", read(restoreRoot / rootDirFile));
+  EXPECT_EQ("sub\n", read(restoreRoot / subFolder / subFolderFile));
+  EXPECT_FALSE(std::filesystem::exists(restoreRoot / debugLog));
+  EXPECT_FALSE(std::filesystem::exists(restoreRoot / backupsFolder));
+  EXPECT_FALSE(std::filesystem::exists(restoreRoot / subFolder / gitFolder));
+}
+
+TEST_F(IncrementalBackupTest,
+       restoreIncrementalBackupShouldDecompressCompressedFiles) {
+  write(sourceRoot / rootDirFile, std::string(1000, 'a'));
+
+  auto manifestPath =
+      createIncrementalBackup(sourceRoot, destRoot, backupName, 9);
+  ASSERT_TRUE(manifestPath.has_value());
+
+  const auto restoreRoot = destRoot / "restored";
+  restoreIncrementalBackup(manifestPath.value(), restoreRoot);
+
+  EXPECT_EQ(std::string(1000, 'a'), read(restoreRoot / rootDirFile));
+  EXPECT_TRUE(std::filesystem::exists(restoreRoot / subFolder / subFolderFile));
+}
+
+TEST_F(EnforceBackupRetentionPolicyTest,
+       shouldDeleteTheOldestBackupsBeyondTheMaximumCount) {
+  const auto oldest = createBackupAged("backup-1", "1", 3);
+  const auto older = createBackupAged("backup-2", "2", 2);
+  const auto newest = createBackupAged("backup-3", "3", 1);
+  ASSERT_EQ(4, countObjects());
+
+  BackupRetentionPolicy policy;
+  policy.maxCount = 2;
+
+  EXPECT_EQ(1, enforceBackupRetentionPolicy(destRoot, policy));
+
+  EXPECT_FALSE(std::filesystem::exists(oldest));
+  EXPECT_TRUE(std::filesystem::exists(older));
+  EXPECT_TRUE(std::filesystem::exists(newest));
+
+  // The content "1" is no longer referenced, but "2", "3" and the empty
+  // subfolder file's content are.
+  EXPECT_EQ(3, countObjects());
+}
+
+TEST_F(EnforceBackupRetentionPolicyTest,
+       shouldDeleteBackupsThatAreOlderThanTheMaximumAge) {
+  const auto oldest = createBackupAged("backup-1", "1", 48);
+  const auto newest = createBackupAged("backup-2", "2", 1);
+
+  BackupRetentionPolicy policy;
+  policy.maxAge = std::chrono::hours(24);
+
+  EXPECT_EQ(1, enforceBackupRetentionPolicy(destRoot, policy));
+
+  EXPECT_FALSE(std::filesystem::exists(oldest));
+  EXPECT_TRUE(std::filesystem::exists(newest));
+}
+
+TEST_F(EnforceBackupRetentionPolicyTest, shouldNotDeleteZipBackups) {
+  const auto newest = createBackupAged("backup-1", "1", 1);
+  touch(destRoot / backupFile);
+  std::filesystem::last_write_time(
+      destRoot / backupFile,
+      std::filesystem::file_time_type::clock::now() - std::chrono::hours(48));
+
+  BackupRetentionPolicy policy;
+  policy.maxCount = 1;
+  policy.maxAge = std::chrono::hours(24);
+
+  EXPECT_EQ(0, enforceBackupRetentionPolicy(destRoot, policy));
+
+  EXPECT_TRUE(std::filesystem::exists(destRoot / backupFile));
+  EXPECT_TRUE(std::filesystem::exists(newest));
+}
+
+TEST_F(EnforceBackupRetentionPolicyTest,
+       shouldAlwaysKeepTheMostRecentBackup) {
+  const auto oldest = createBackupAged("backup-1", "1", 48);
+  const auto newest = createBackupAged("backup-2", "2", 47);
+
+  BackupRetentionPolicy policy;
+  policy.maxTotalSize = 1;
+  policy.maxAge = std::chrono::hours(24);
+
+  EXPECT_EQ(1, enforceBackupRetentionPolicy(destRoot, policy));
+
+  EXPECT_FALSE(std::filesystem::exists(oldest));
+  EXPECT_TRUE(std::filesystem::exists(newest));
+}
+
+TEST_F(EnforceBackupRetentionPolicyTest,
+       shouldNotDeleteAnythingIfThereAreNoLimits) {
+  const auto oldest = createBackupAged("backup-1", "1", 48);
+  const auto newest = createBackupAged("backup-2", "2", 1);
+
+  EXPECT_EQ(0, enforceBackupRetentionPolicy(destRoot, {}));
+
+  EXPECT_TRUE(std::filesystem::exists(oldest));
+  EXPECT_TRUE(std::filesystem::exists(newest));
+  EXPECT_EQ(3, countObjects());
+}
 }
 }
 
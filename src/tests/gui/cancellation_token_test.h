@@ -0,0 +1,67 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_CANCELLATION_TOKEN_TEST
+#define LOOT_TESTS_GUI_CANCELLATION_TOKEN_TEST
+
+#include <gtest/gtest.h>
+
+#include "gui/cancellation_token.h"
+
+namespace loot::test {
+TEST(CancellationToken, shouldNotBeCancelledByDefault) {
+  const CancellationToken token;
+
+  EXPECT_FALSE(token.isCancelled());
+  EXPECT_NO_THROW(token.throwIfCancelled());
+}
+
+TEST(CancellationToken, cancelShouldCancelTheToken) {
+  CancellationToken token;
+
+  token.cancel();
+
+  EXPECT_TRUE(token.isCancelled());
+}
+
+TEST(CancellationToken, throwIfCancelledShouldThrowIfTheTokenIsCancelled) {
+  CancellationToken token;
+
+  token.cancel();
+
+  EXPECT_THROW(token.throwIfCancelled(), CancelledError);
+}
+
+TEST(CancellationToken, cancelShouldHaveNoEffectIfTheTokenIsAlreadyCancelled) {
+  CancellationToken token;
+
+  token.cancel();
+  token.cancel();
+
+  EXPECT_TRUE(token.isCancelled());
+}
+}
+
+#endif
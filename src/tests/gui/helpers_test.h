@@ -46,6 +46,22 @@ TEST(GetDriveRootPaths, shouldReturnNonEmptyVector) {
   EXPECT_FALSE(GetDriveRootPaths().empty());
 }
 
+class GetDriveIdTest : public CommonGameTestFixture {
+protected:
+  GetDriveIdTest() : CommonGameTestFixture(GameId::tes3) {}
+};
+
+TEST_F(GetDriveIdTest, shouldReturnTheSameIdForPathsOnTheSameDrive) {
+  const auto driveId = GetDriveId(dataPath / blankEsm);
+
+  EXPECT_FALSE(driveId.empty());
+  EXPECT_EQ(driveId, GetDriveId(dataPath / blankEsp));
+}
+
+TEST(IsRotationalDrive, shouldReturnFalseForAnEmptyDriveId) {
+  EXPECT_FALSE(IsRotationalDrive(""));
+}
+
 TEST_F(FindXboxGamingRootPathTest,
        shouldReturnNulloptIfTheDotGamingRootFileDoesNotExist) {
   EXPECT_FALSE(FindXboxGamingRootPath(dataPath).has_value());
@@ -99,6 +115,29 @@ TEST_F(FindXboxGamingRootPathTest,
   EXPECT_FALSE(FindXboxGamingRootPath(dataPath).has_value());
 }
 
+TEST_F(FindXboxGamingRootPathTest,
+       findXboxGamingRootPathsShouldReturnAResultForEachDriveInOrder) {
+  std::ofstream out(dataPath / ".GamingRoot", std::ios::binary);
+  const char* data = "12345678t\0e\0s\0t\0 \0p\0a\0t\0h\0\0\0";
+  out.write(data, 28);
+  out.close();
+
+  const auto results = FindXboxGamingRootPaths({localPath, dataPath},
+                                               std::chrono::seconds(10));
+
+  ASSERT_EQ(2, results.size());
+  EXPECT_EQ(localPath, results[0].driveRootPath);
+  EXPECT_FALSE(results[0].timedOut);
+  EXPECT_FALSE(results[0].gamingRootPath.has_value());
+  EXPECT_EQ(dataPath, results[1].driveRootPath);
+  EXPECT_FALSE(results[1].timedOut);
+  EXPECT_EQ(dataPath / "test path", results[1].gamingRootPath);
+}
+
+TEST(FindXboxGamingRootPaths, shouldReturnAnEmptyVectorIfGivenNoDrives) {
+  EXPECT_TRUE(FindXboxGamingRootPaths({}, std::chrono::seconds(1)).empty());
+}
+
 // MSVC interprets source files in the default code page, so
 // for me u8"\xC3\x9C" != u8"\u00DC", which is a lot of fun.
 // To avoid insanity, write non-ASCII characters as \uXXXX escapes.
@@ -108,6 +147,32 @@ TEST_F(FindXboxGamingRootPathTest,
 // \u0130 is turkish 'İ'
 // \u0131 is turkish 'ı'
 
+TEST(CompareFilenames, shouldCompareAsciiNamesCaseInsensitively) {
+  EXPECT_EQ(0, CompareFilenames("Blank.esp", "blank.ESP"));
+  EXPECT_EQ(-1, CompareFilenames("Blank.esm", "blank.esp"));
+  EXPECT_EQ(1, CompareFilenames("Blank.esp", "blank.esm"));
+  EXPECT_EQ(-1, CompareFilenames("Blank", "blank.esp"));
+  EXPECT_EQ(1, CompareFilenames("Blank.esp", "blank"));
+  EXPECT_EQ(0, CompareFilenames("", ""));
+}
+
+TEST(CompareFilenames,
+     shouldOrderAsciiNamesTheSameWayAsTheUnicodeAwareComparison) {
+  // Windows compares uppercased names, while ICU compares folded names,
+  // which only differs for characters between 'Z' and 'a'.
+#ifdef _WIN32
+  EXPECT_EQ(1, CompareFilenames("_", "a"));
+#else
+  EXPECT_EQ(-1, CompareFilenames("_", "a"));
+#endif
+}
+
+TEST(CompareFilenames, shouldCompareNonAsciiCharactersAfterAnAsciiPrefix) {
+  EXPECT_EQ(0, CompareFilenames(u8"Blank\u00E1.esp", u8"blank\u00C1.esp"));
+  EXPECT_EQ(-1, CompareFilenames("Blank", u8"blank\u00E1"));
+  EXPECT_EQ(1, CompareFilenames(u8"blank\u00E1", "Blank"));
+}
+
 TEST(CompareFilenames, shouldBeCaseInsensitiveAndLocaleInvariant) {
   // ICU sees all three greek rhos as case-insensitively equal, unlike Windows.
   // A small enough deviation that it should hopefully be insignificant.
@@ -166,7 +231,28 @@ TEST(CompareFilenames, shouldBeCaseInsensitiveAndLocaleInvariant) {
   // Reset locale.
   std::locale::global(boost::locale::generator().generate(""));
 }
+
+TEST(NormalisePluginName, shouldLowercaseAsciiNames) {
+  EXPECT_EQ("blank.esp", NormalisePluginName("Blank.ESP"));
+  EXPECT_EQ("", NormalisePluginName(""));
 }
+
+TEST(NormalisePluginName, shouldLowercaseNonAsciiNames) {
+  std::locale::global(boost::locale::generator().generate("en.UTF-8"));
+
+  EXPECT_EQ(u8"non\u00e1scii.esp", NormalisePluginName(u8"Non\u00C1scii.esp"));
+
+  // Reset locale.
+  std::locale::global(boost::locale::generator().generate(""));
 }
 
-#endif
+TEST(NormalisePluginName, shouldNotDependOnTheLocaleForAsciiNames) {
+  std::locale::global(boost::locale::generator().generate("tr_TR.UTF-8"));
+
+  EXPECT_EQ("ii.esp", NormalisePluginName("iI.esp"));
+
+  // Reset locale.
+  std::locale::global(boost::locale::generator().generate(""));
+}
+}
+}
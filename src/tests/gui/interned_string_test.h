@@ -0,0 +1,71 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_INTERNED_STRING_TEST
+#define LOOT_TESTS_GUI_INTERNED_STRING_TEST
+
+#include <gtest/gtest.h>
+
+#include "gui/interned_string.h"
+
+namespace loot::test {
+TEST(InternedString, defaultConstructorShouldCreateAnEmptyString) {
+  const InternedString string;
+
+  EXPECT_TRUE(string.empty());
+  EXPECT_EQ("", string.str());
+  EXPECT_EQ(InternedString(""), string);
+}
+
+TEST(InternedString, stringsWithEqualValuesShouldShareTheSameStorage) {
+  const auto string1 = InternedString("Delev");
+  const auto string2 = InternedString(std::string("Delev"));
+
+  EXPECT_EQ(&string1.str(), &string2.str());
+}
+
+TEST(InternedString, equalityOperatorShouldReturnTrueIfValuesAreEqual) {
+  EXPECT_TRUE(InternedString("Delev") == InternedString("Delev"));
+  EXPECT_FALSE(InternedString("Delev") == InternedString("Relev"));
+}
+
+TEST(InternedString, equalityShouldBeCaseSensitive) {
+  EXPECT_FALSE(InternedString("Delev") == InternedString("delev"));
+}
+
+TEST(InternedString, inequalityOperatorShouldReturnTrueIfValuesAreNotEqual) {
+  EXPECT_TRUE(InternedString("Delev") != InternedString("Relev"));
+  EXPECT_FALSE(InternedString("Delev") != InternedString("Delev"));
+}
+
+TEST(InternedString, shouldBeImplicitlyConvertibleToAStringReference) {
+  const auto string = InternedString("Delev");
+  const std::string& reference = string;
+
+  EXPECT_EQ("Delev", reference);
+}
+}
+
+#endif
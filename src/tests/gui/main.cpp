@@ -38,9 +38,18 @@
 #include <boost/locale.hpp>
 
 #include "tests/gui/backup_test.h"
+#include "tests/gui/cancellation_token_test.h"
 #include "tests/gui/helpers_test.h"
+#include "tests/gui/interned_string_test.h"
+#include "tests/gui/plugin_items_snapshot_test.h"
+#include "tests/gui/plugin_name_prefix_index_test.h"
 #include "tests/gui/qt/helpers_test.h"
+#include "tests/gui/qt/icon_atlas_test.h"
+#include "tests/gui/qt/instance_server_test.h"
+#include "tests/gui/qt/startup_scheduler_test.h"
 #include "tests/gui/qt/tasks/tasks_test.h"
+#include "tests/gui/query/types/apply_sort_query_test.h"
+#include "tests/gui/shared_string_test.h"
 #include "tests/gui/sourced_message_test.h"
 #include "tests/gui/state/game/detection/common_test.h"
 #include "tests/gui/state/game/detection/detail_test.h"
@@ -48,17 +57,41 @@
 #include "tests/gui/state/game/detection/generic_test.h"
 #include "tests/gui/state/game/detection/gog_test.h"
 #include "tests/gui/state/game/detection/heroic_test.h"
+#include "tests/gui/state/game/detection/install_cache_test.h"
 #include "tests/gui/state/game/detection/microsoft_store_test.h"
+#include "tests/gui/state/game/detection/registry_test.h"
 #include "tests/gui/state/game/detection/steam_test.h"
+#include "tests/gui/state/game/active_plugins_snapshot_test.h"
+#include "tests/gui/state/game/data_paths_snapshot_test.h"
+#include "tests/gui/state/game/directory_listing_test.h"
 #include "tests/gui/state/game/detection_test.h"
+#include "tests/gui/state/game/file_content_hash_cache_test.h"
+#include "tests/gui/state/game/file_io_scheduler_test.h"
 #include "tests/gui/state/game/game_settings_test.h"
+#include "tests/gui/state/game/game_data_snapshot_test.h"
 #include "tests/gui/state/game/game_test.h"
 #include "tests/gui/state/game/games_manager_test.h"
+#include "tests/gui/state/game/group_graph_test.h"
 #include "tests/gui/state/game/group_node_positions_test.h"
 #include "tests/gui/state/game/helpers_test.h"
+#include "tests/gui/state/game/plugin_dependents_index_test.h"
+#include "tests/gui/state/game/plugin_file_cache_test.h"
+#include "tests/gui/state/game/record_overlap_index_test.h"
+#include "tests/gui/state/game/sort_result_cache_test.h"
+#include "tests/gui/state/game/synthetic_load_order_test.h"
+#include "tests/gui/state/diagnostics_test.h"
+#include "tests/gui/state/download_mirrors_test.h"
+#include "tests/gui/state/log_archive_test.h"
 #include "tests/gui/state/loot_paths_test.h"
 #include "tests/gui/state/loot_settings_test.h"
+#include "tests/gui/state/performance_history_test.h"
+#include "tests/gui/state/run_metrics_test.h"
+#include "tests/gui/state/thread_pool_test.h"
 #include "tests/gui/state/unapplied_change_counter_test.h"
+#include "tests/gui/state/update_check_cache_test.h"
+#include "tests/gui/tag_set_test.h"
+#include "tests/gui/translation_cache_test.h"
+#include "tests/gui/user_metadata_changes_test.h"
 
 int main(int argc, char **argv) {
   // Set the logger to use a null sink.
@@ -0,0 +1,143 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_PLUGIN_ITEMS_SNAPSHOT_TEST
+#define LOOT_TESTS_GUI_PLUGIN_ITEMS_SNAPSHOT_TEST
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "gui/plugin_items_snapshot.h"
+#include "tests/gui/test_helpers.h"
+
+namespace loot {
+namespace test {
+class PluginItemsSnapshotTest : public ::testing::Test {
+protected:
+  PluginItemsSnapshotTest() :
+      rootPath_(getTempPath()),
+      filePath_(rootPath_ / "plugin_items_snapshot.bin") {}
+
+  void SetUp() override { std::filesystem::create_directories(rootPath_); }
+
+  void TearDown() override { std::filesystem::remove_all(rootPath_); }
+
+  static PluginItem createItem() {
+    PluginItem item;
+    item.gameId = GameId::tes5se;
+    item.name = "Blank.esp";
+    item.loadOrderIndex = 3;
+    item.crc = 0xDEADBEEF;
+    item.version = "1.0";
+    item.group = InternedString("group");
+    item.isActive = true;
+    item.isLightPlugin = true;
+    item.isCreationClubPlugin = true;
+    item.isOfficial = true;
+    item.currentTags = {InternedString("Relev")};
+    item.addTags = {InternedString("Delev")};
+    item.removeTags = {InternedString("Names")};
+    item.messages = {SourcedMessage{MessageType::warn,
+                                    MessageSource::messageMetadata,
+                                    "a warning"},
+                     SourcedMessage{MessageType::say,
+                                    MessageSource::cleaningMetadata,
+                                    "a note"}};
+    item.locations = {Location("https://example.com", "Example")};
+    item.updateLowercaseSearchText();
+
+    return item;
+  }
+
+  const std::filesystem::path rootPath_;
+  const std::filesystem::path filePath_;
+};
+
+TEST_F(PluginItemsSnapshotTest,
+       loadPluginItemsSnapshotShouldReturnNulloptIfFileDoesNotExist) {
+  EXPECT_FALSE(
+      LoadPluginItemsSnapshot(filePath_, GameId::tes5se, "en").has_value());
+}
+
+TEST_F(PluginItemsSnapshotTest,
+       loadPluginItemsSnapshotShouldThrowIfFileMagicNumberIsUnexpected) {
+  std::ofstream out(filePath_, std::ios::binary);
+  out << "not a snapshot";
+  out.close();
+
+  EXPECT_THROW(LoadPluginItemsSnapshot(filePath_, GameId::tes5se, "en"),
+               std::runtime_error);
+}
+
+TEST_F(PluginItemsSnapshotTest,
+       loadPluginItemsSnapshotShouldReadItemsThatWereSaved) {
+  PluginItem emptyItem;
+  emptyItem.gameId = GameId::tes5se;
+  emptyItem.name = "Other.esm";
+
+  const std::vector<PluginItem> items{createItem(), emptyItem};
+  SavePluginItemsSnapshot(filePath_, GameId::tes5se, "en", items);
+
+  const auto loadedItems =
+      LoadPluginItemsSnapshot(filePath_, GameId::tes5se, "en");
+
+  ASSERT_TRUE(loadedItems.has_value());
+  EXPECT_EQ(items, loadedItems.value());
+  EXPECT_EQ(items[0].lowercaseSearchText,
+            loadedItems.value()[0].lowercaseSearchText);
+  EXPECT_EQ("blank.esp", loadedItems.value()[0].lowercaseName);
+}
+
+TEST_F(PluginItemsSnapshotTest,
+       loadPluginItemsSnapshotShouldReturnNulloptIfSavedForADifferentGame) {
+  SavePluginItemsSnapshot(filePath_, GameId::tes5se, "en", {createItem()});
+
+  EXPECT_FALSE(
+      LoadPluginItemsSnapshot(filePath_, GameId::fo4, "en").has_value());
+}
+
+TEST_F(PluginItemsSnapshotTest,
+       loadPluginItemsSnapshotShouldReturnNulloptIfSavedForADifferentLanguage) {
+  SavePluginItemsSnapshot(filePath_, GameId::tes5se, "en", {createItem()});
+
+  EXPECT_FALSE(
+      LoadPluginItemsSnapshot(filePath_, GameId::tes5se, "fr").has_value());
+}
+
+TEST_F(PluginItemsSnapshotTest,
+       loadPluginItemsSnapshotShouldThrowIfTheFileIsTruncated) {
+  SavePluginItemsSnapshot(filePath_, GameId::tes5se, "en", {createItem()});
+
+  std::filesystem::resize_file(filePath_,
+                               std::filesystem::file_size(filePath_) - 4);
+
+  EXPECT_THROW(LoadPluginItemsSnapshot(filePath_, GameId::tes5se, "en"),
+               std::runtime_error);
+}
+}
+}
+
+#endif
@@ -0,0 +1,89 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_PLUGIN_NAME_PREFIX_INDEX_TEST
+#define LOOT_TESTS_GUI_PLUGIN_NAME_PREFIX_INDEX_TEST
+
+#include <gtest/gtest.h>
+
+#include "gui/plugin_name_prefix_index.h"
+
+namespace loot::test {
+class PluginNamePrefixIndexTest : public ::testing::Test {
+protected:
+  PluginNamePrefixIndexTest() :
+      index_({{"skyui.esp", 1},
+              {"skyrim.esm", 2},
+              {"update.esm", 3},
+              {"sky.esp", 4},
+              {"unofficial skyrim patch.esp", 5}}) {}
+
+  static bool acceptAll(int) { return true; }
+
+  const PluginNamePrefixIndex index_;
+};
+
+TEST_F(PluginNamePrefixIndexTest,
+       findFirstRowShouldReturnTheRowOfTheFirstMatchingNameInNameOrder) {
+  EXPECT_EQ(4, index_.FindFirstRow("sky", acceptAll));
+  EXPECT_EQ(2, index_.FindFirstRow("skyr", acceptAll));
+  EXPECT_EQ(5, index_.FindFirstRow("un", acceptAll));
+}
+
+TEST_F(PluginNamePrefixIndexTest,
+       findFirstRowShouldReturnTheRowOfAnExactlyMatchingName) {
+  EXPECT_EQ(3, index_.FindFirstRow("update.esm", acceptAll));
+}
+
+TEST_F(PluginNamePrefixIndexTest,
+       findFirstRowShouldReturnNulloptIfNoNameStartsWithThePrefix) {
+  EXPECT_FALSE(index_.FindFirstRow("dawnguard", acceptAll).has_value());
+  EXPECT_FALSE(index_.FindFirstRow("skyui.esp2", acceptAll).has_value());
+  EXPECT_FALSE(index_.FindFirstRow("z", acceptAll).has_value());
+}
+
+TEST_F(PluginNamePrefixIndexTest,
+       findFirstRowShouldReturnTheFirstRowInNameOrderIfThePrefixIsEmpty) {
+  EXPECT_EQ(4, index_.FindFirstRow("", acceptAll));
+}
+
+TEST_F(PluginNamePrefixIndexTest,
+       findFirstRowShouldSkipMatchingRowsThatAreNotAccepted) {
+  const auto acceptRow = [](int row) { return row != 4 && row != 2; };
+
+  EXPECT_EQ(1, index_.FindFirstRow("sky", acceptRow));
+  EXPECT_FALSE(index_.FindFirstRow("skyr", acceptRow).has_value());
+}
+
+TEST(PluginNamePrefixIndex, findFirstRowShouldReturnNulloptIfTheIndexIsEmpty) {
+  const PluginNamePrefixIndex index;
+
+  EXPECT_EQ(0, index.size());
+  EXPECT_FALSE(
+      index.FindFirstRow("a", [](int) { return true; }).has_value());
+}
+}
+
+#endif
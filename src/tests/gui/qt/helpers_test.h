@@ -69,6 +69,19 @@ class UpdateFileWithDataTest : public QtHelpersFixture {};
 
 class UpdateFileTest : public QtHelpersFixture {};
 
+class HttpCacheValidatorsTest : public QtHelpersFixture {};
+
+class SharedDownloadCacheTest : public QtHelpersFixture {
+protected:
+  SharedDownloadCacheTest() :
+      cachePath_(rootPath_ / "cache"),
+      entryPath_(getSharedCacheEntryPath(cachePath_,
+                                         "https://example.com/prelude.yaml")) {}
+
+  const std::filesystem::path cachePath_;
+  const std::filesystem::path entryPath_;
+};
+
 TEST(calculateGitBlobHash, shouldCalculateTheSameHashAsGitDoesForABlob) {
   auto data = QByteArray("some text to hash");
   auto hash = calculateGitBlobHash(data);
@@ -97,6 +110,35 @@ TEST_F(CalculateGitBlobHashTest, shouldReplaceCRLFWithLFBeforeCalculatingHash) {
   EXPECT_EQ("7d91453217afc429984c4706e8df22aaac47c9ce", hash);
 }
 
+TEST_F(CalculateGitBlobHashTest,
+       shouldReplaceCRLFWithLFIfItSpansTheBoundaryBetweenReadChunks) {
+  auto file = rootPath_ / "text.txt";
+
+  // Files are read in 64 KiB chunks.
+  const auto prefix = std::string(64 * 1024 - 1, 'a');
+
+  std::ofstream out(file, std::ios::binary);
+  out << prefix << "\r\nb";
+  out.close();
+
+  auto hash = calculateGitBlobHash(file);
+
+  EXPECT_EQ(calculateGitBlobHash(QByteArray::fromStdString(prefix + "\nb")),
+            hash);
+}
+
+TEST_F(CalculateGitBlobHashTest, shouldNotReplaceCRThatIsNotFollowedByLF) {
+  auto file = rootPath_ / "text.txt";
+
+  std::ofstream out(file, std::ios::binary);
+  out << "a\rb\r";
+  out.close();
+
+  auto hash = calculateGitBlobHash(file);
+
+  EXPECT_EQ(calculateGitBlobHash(QByteArray("a\rb\r")), hash);
+}
+
 TEST_F(GetFileRevisionTest, shouldThrowIfGivenPathIsNotARegularFile) {
   EXPECT_THROW(getFileRevision(rootPath_), FileAccessError);
 }
@@ -145,6 +187,37 @@ TEST_F(GetFileRevisionTest,
   EXPECT_TRUE(revision.is_modified);
 }
 
+TEST_F(GetFileRevisionTest,
+       shouldUseTheRecordedHashIfFileSizeAndWriteTimeAreUnchanged) {
+  auto data = QByteArray("new data");
+  updateFileWithData(filePath_, data);
+  const auto writeTime = std::filesystem::last_write_time(filePath_);
+
+  // Change the file's content without changing its size or write time.
+  std::ofstream out(filePath_, std::ios::binary);
+  out << "old data";
+  out.close();
+  std::filesystem::last_write_time(filePath_, writeTime);
+
+  auto revision = getFileRevision(filePath_);
+
+  EXPECT_EQ(calculateGitBlobHash(data), revision.id);
+  EXPECT_FALSE(revision.is_modified);
+}
+
+TEST_F(GetFileRevisionTest, shouldRecalculateTheHashIfTheFileSizeHasChanged) {
+  updateFileWithData(filePath_, QByteArray("new data"));
+
+  std::ofstream out(filePath_, std::ios::binary);
+  out << "edited data";
+  out.close();
+
+  auto revision = getFileRevision(filePath_);
+
+  EXPECT_EQ(calculateGitBlobHash(QByteArray("edited data")), revision.id);
+  EXPECT_TRUE(revision.is_modified);
+}
+
 TEST_F(GetFileRevisionSummaryTest, shouldReturnTheFileRevisionIfItCanBeRead) {
   auto summary = getFileRevisionSummary(filePath_, FileType::Masterlist);
 
@@ -163,6 +236,37 @@ TEST_F(GetFileRevisionSummaryTest, shouldIndicateIfTheFileHasBeenEdited) {
   EXPECT_EQ("2022-01-22 (edited)", summary.date);
 }
 
+TEST_F(GetFileRevisionSummaryTest,
+       shouldReturnANewSummaryIfTheFileIsUpdatedAfterItWasGot) {
+  getFileRevisionSummary(filePath_, FileType::Masterlist);
+
+  const auto data = QByteArray("new data");
+  updateFileWithData(filePath_, data);
+
+  auto summary = getFileRevisionSummary(filePath_, FileType::Masterlist);
+
+  const auto expectedDate =
+      QDate::currentDate().toString(Qt::ISODate).toStdString();
+  EXPECT_EQ(calculateGitBlobHash(data).substr(0, 7), summary.id);
+  EXPECT_EQ(expectedDate, summary.date);
+}
+
+TEST_F(GetFileRevisionSummaryTest,
+       shouldReturnANewSummaryIfTheMetadataIsChangedAfterItWasGot) {
+  getFileRevisionSummary(filePath_, FileType::Masterlist);
+
+  std::ofstream out(fileMetadataPath_);
+  out << "blob_sha1 = \"686d51d2991e7359e636720c5cb04446257a42af\""
+      << std::endl;
+  out << "update_timestamp = \"2023-10-31T12:00\"";
+  out.close();
+
+  auto summary = getFileRevisionSummary(filePath_, FileType::Masterlist);
+
+  EXPECT_EQ("686d51d", summary.id);
+  EXPECT_EQ("2023-10-31T12:00", summary.date);
+}
+
 TEST_F(GetFileRevisionSummaryTest,
        shouldDisplayErrorsIfTheMasterlistCannotBeRead) {
   auto summary = getFileRevisionSummary(rootPath_, FileType::Masterlist);
@@ -244,6 +348,30 @@ TEST_F(UpdateFileWithDataTest, shouldWriteMetadataFileEvenIfHashIsUnchanged) {
   EXPECT_EQ(expectedDate, revision.date);
 }
 
+TEST_F(UpdateFileWithDataTest,
+       shouldCompareAgainstTheGivenExistingFileHashIfOneIsGiven) {
+  auto originalHash = calculateGitBlobHash(filePath_);
+
+  auto data = QByteArray("new data");
+  auto dataHash = calculateGitBlobHash(data);
+
+  auto result = updateFileWithData(filePath_, data, {}, dataHash);
+
+  EXPECT_FALSE(result);
+  EXPECT_EQ(originalHash, calculateGitBlobHash(filePath_));
+}
+
+TEST_F(UpdateFileWithDataTest, shouldWriteToAFileThatDoesNotExist) {
+  std::filesystem::remove(filePath_);
+
+  auto data = QByteArray("new data");
+
+  auto result = updateFileWithData(filePath_, data, {}, std::nullopt);
+
+  EXPECT_TRUE(result);
+  EXPECT_EQ(calculateGitBlobHash(data), calculateGitBlobHash(filePath_));
+}
+
 TEST_F(UpdateFileTest,
        shouldOverwriteDestinationWithSourceIfHashesAreDifferent) {
   auto originalHash = calculateGitBlobHash(filePath_);
@@ -316,6 +444,196 @@ TEST_F(UpdateFileTest, shouldWriteMetadataFileEvenIfHashIsUnchanged) {
   EXPECT_EQ(expectedDate, revision.date);
 }
 
+TEST_F(UpdateFileTest,
+       shouldNotReadTheSourceIfItsSizeAndWriteTimeAreUnchangedSinceLastUpdate) {
+  auto sourceFilePath = rootPath_ / "source";
+
+  std::ofstream out(sourceFilePath);
+  out << "new data";
+  out.close();
+
+  auto dataHash = calculateGitBlobHash(sourceFilePath);
+
+  ASSERT_TRUE(updateFile(sourceFilePath, filePath_));
+
+  // Change the source's content without changing its size or write time.
+  const auto writeTime = std::filesystem::last_write_time(sourceFilePath);
+  out.open(sourceFilePath);
+  out << "old data";
+  out.close();
+  std::filesystem::last_write_time(sourceFilePath, writeTime);
+
+  auto result = updateFile(sourceFilePath, filePath_);
+
+  EXPECT_FALSE(result);
+  EXPECT_EQ(dataHash, calculateGitBlobHash(filePath_));
+  EXPECT_EQ(dataHash, getFileRevision(filePath_).id);
+}
+
+TEST_F(UpdateFileTest, shouldReadTheSourceAgainIfItsWriteTimeHasChanged) {
+  auto sourceFilePath = rootPath_ / "source";
+
+  std::ofstream out(sourceFilePath);
+  out << "new data";
+  out.close();
+
+  ASSERT_TRUE(updateFile(sourceFilePath, filePath_));
+
+  const auto writeTime = std::filesystem::last_write_time(sourceFilePath);
+  out.open(sourceFilePath);
+  out << "old data";
+  out.close();
+  std::filesystem::last_write_time(sourceFilePath,
+                                   writeTime + std::chrono::seconds(1));
+
+  auto dataHash = calculateGitBlobHash(sourceFilePath);
+
+  auto result = updateFile(sourceFilePath, filePath_);
+
+  EXPECT_TRUE(result);
+  EXPECT_EQ(dataHash, calculateGitBlobHash(filePath_));
+}
+
+TEST_F(HttpCacheValidatorsTest,
+       getHttpCacheValidatorsShouldReturnNothingIfNoneAreStored) {
+  auto validators = getHttpCacheValidators(filePath_);
+
+  EXPECT_EQ("", validators.etag);
+  EXPECT_EQ("", validators.lastModified);
+}
+
+TEST_F(HttpCacheValidatorsTest,
+       getHttpCacheValidatorsShouldReturnNothingIfTheFileIsMissing) {
+  auto validators = getHttpCacheValidators(rootPath_ / "missing");
+
+  EXPECT_EQ("", validators.etag);
+  EXPECT_EQ("", validators.lastModified);
+}
+
+TEST_F(HttpCacheValidatorsTest,
+       getHttpCacheValidatorsShouldReturnValidatorsStoredWithFileData) {
+  auto data = QByteArray("new data");
+
+  updateFileWithData(
+      filePath_, data, {"\"abc\"", "Sat, 22 Jan 2022 00:00:00 GMT"});
+  auto validators = getHttpCacheValidators(filePath_);
+
+  EXPECT_EQ("\"abc\"", validators.etag);
+  EXPECT_EQ("Sat, 22 Jan 2022 00:00:00 GMT", validators.lastModified);
+}
+
+TEST_F(HttpCacheValidatorsTest,
+       getHttpCacheValidatorsShouldReturnNothingIfTheFileHasBeenEdited) {
+  updateFileWithData(
+      filePath_, QByteArray("new data"), {"\"abc\"", "last modified"});
+
+  std::ofstream out(filePath_);
+  out << "edited data";
+  out.close();
+
+  auto validators = getHttpCacheValidators(filePath_);
+
+  EXPECT_EQ("", validators.etag);
+  EXPECT_EQ("", validators.lastModified);
+}
+
+TEST_F(HttpCacheValidatorsTest,
+       updateFileRevisionDateShouldUpdateTheDateAndKeepTheFileUnchanged) {
+  const auto originalHash = calculateGitBlobHash(filePath_);
+
+  updateFileRevisionDate(filePath_, {"\"abc\"", ""});
+
+  auto revision = getFileRevision(filePath_);
+  auto expectedDate = QDate::currentDate().toString(Qt::ISODate).toStdString();
+
+  EXPECT_EQ(originalHash, revision.id);
+  EXPECT_FALSE(revision.is_modified);
+  EXPECT_EQ(expectedDate, revision.date);
+  EXPECT_EQ("\"abc\"", getHttpCacheValidators(filePath_).etag);
+}
+
+TEST_F(HttpCacheValidatorsTest,
+       updateFileRevisionDateShouldKeepStoredValidatorsThatAreNotGiven) {
+  updateFileWithData(
+      filePath_, QByteArray("new data"), {"\"abc\"", "last modified"});
+
+  updateFileRevisionDate(filePath_, {"\"def\"", ""});
+
+  auto validators = getHttpCacheValidators(filePath_);
+
+  EXPECT_EQ("\"def\"", validators.etag);
+  EXPECT_EQ("last modified", validators.lastModified);
+}
+
+TEST_F(SharedDownloadCacheTest,
+       getSharedCacheEntryPathShouldGiveDifferentUrlsDifferentEntries) {
+  const auto otherEntryPath =
+      getSharedCacheEntryPath(cachePath_, "https://example.com/other.yaml");
+
+  EXPECT_EQ(cachePath_, entryPath_.parent_path());
+  EXPECT_EQ(".yaml", entryPath_.extension());
+  EXPECT_NE(entryPath_, otherEntryPath);
+}
+
+TEST_F(SharedDownloadCacheTest,
+       addFileToSharedCacheShouldCopyTheFileAndItsValidatorsToTheEntry) {
+  updateFileWithData(filePath_, QByteArray("new data"), {"\"abc\"", ""});
+
+  addFileToSharedCache(filePath_, entryPath_);
+
+  ASSERT_TRUE(std::filesystem::exists(entryPath_));
+  EXPECT_EQ(calculateGitBlobHash(filePath_), getFileRevision(entryPath_).id);
+  EXPECT_EQ("\"abc\"", getHttpCacheValidators(entryPath_).etag);
+}
+
+TEST_F(SharedDownloadCacheTest,
+       updateFileFromSharedCacheShouldReturnNothingIfTheEntryIsMissing) {
+  EXPECT_FALSE(updateFileFromSharedCache(entryPath_, filePath_).has_value());
+}
+
+TEST_F(SharedDownloadCacheTest,
+       updateFileFromSharedCacheShouldUpdateTheFileFromARecentEntry) {
+  const auto otherFilePath = rootPath_ / "other.yaml";
+  updateFileWithData(otherFilePath, QByteArray("new data"), {"\"abc\"", ""});
+  addFileToSharedCache(otherFilePath, entryPath_);
+
+  const auto result = updateFileFromSharedCache(entryPath_, filePath_);
+
+  ASSERT_TRUE(result.has_value());
+  EXPECT_TRUE(result.value());
+  EXPECT_EQ(calculateGitBlobHash(otherFilePath),
+            calculateGitBlobHash(filePath_));
+  EXPECT_EQ("\"abc\"", getHttpCacheValidators(filePath_).etag);
+}
+
+TEST_F(SharedDownloadCacheTest,
+       updateFileFromSharedCacheShouldReturnNothingIfTheEntryIsOld) {
+  addFileToSharedCache(filePath_, entryPath_);
+
+  const auto entryMetadataPath =
+      std::filesystem::path(entryPath_.u8string() + ".metadata.toml");
+  std::filesystem::last_write_time(
+      entryMetadataPath,
+      std::filesystem::last_write_time(entryMetadataPath) -
+          std::chrono::hours(2));
+
+  EXPECT_FALSE(updateFileFromSharedCache(entryPath_, filePath_).has_value());
+}
+
+TEST_F(SharedDownloadCacheTest,
+       updateFileFromSharedCacheShouldReturnNothingIfTheEntryHasBeenEdited) {
+  addFileToSharedCache(filePath_, entryPath_);
+
+  std::ofstream out(entryPath_);
+  out << "edited data";
+  out.close();
+
+  const auto originalHash = calculateGitBlobHash(filePath_);
+
+  EXPECT_FALSE(updateFileFromSharedCache(entryPath_, filePath_).has_value());
+  EXPECT_EQ(originalHash, calculateGitBlobHash(filePath_));
+}
+
 TEST(isValidUrl, shouldBeFalseForALocalWindowsPath) {
   auto result = isValidUrl("C:\\Users\\user\\file");
 
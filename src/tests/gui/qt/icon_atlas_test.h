@@ -0,0 +1,106 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_QT_ICON_ATLAS_TEST
+#define LOOT_TESTS_GUI_QT_ICON_ATLAS_TEST
+
+#include <gtest/gtest.h>
+
+#include "gui/qt/icon_atlas.h"
+#include "tests/gui/test_helpers.h"
+
+namespace loot {
+namespace test {
+class IconAtlasTest : public ::testing::Test {
+protected:
+  IconAtlasTest() :
+      rootPath_(getTempPath()),
+      imagePath_(QString::fromStdString((rootPath_ / "atlas.png").u8string())),
+      indexPath_(
+          QString::fromStdString((rootPath_ / "atlas.json").u8string())) {}
+
+  void SetUp() override { std::filesystem::create_directories(rootPath_); }
+
+  void TearDown() override { std::filesystem::remove_all(rootPath_); }
+
+  static QImage createImage(int width, int height, QColor color) {
+    QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
+    image.fill(color);
+    return image;
+  }
+
+  const std::filesystem::path rootPath_;
+  const QString imagePath_;
+  const QString indexPath_;
+};
+
+TEST_F(IconAtlasTest, loadShouldReturnAnEmptyAtlasIfTheFilesDoNotExist) {
+  const auto atlas = IconAtlas::load(imagePath_, indexPath_);
+
+  EXPECT_TRUE(atlas.isEmpty());
+  EXPECT_FALSE(atlas.getImage(":/icons/a.svg", 16, 1.0).has_value());
+}
+
+TEST_F(IconAtlasTest, shouldRoundTripImagesThroughTheAtlas) {
+  const auto image1 = createImage(16, 16, Qt::black);
+  const auto image2 = createImage(24, 20, QColor(0, 0, 0, 128));
+
+  ASSERT_TRUE(writeIconAtlas({IconAtlasEntry{":/icons/a.svg", 16, 1.0, image1},
+                              IconAtlasEntry{":/icons/b.svg", 16, 1.5, image2}},
+                             imagePath_,
+                             indexPath_));
+
+  const auto atlas = IconAtlas::load(imagePath_, indexPath_);
+  ASSERT_FALSE(atlas.isEmpty());
+
+  const auto loaded1 = atlas.getImage(":/icons/a.svg", 16, 1.0);
+  ASSERT_TRUE(loaded1.has_value());
+  EXPECT_EQ(image1.size(), loaded1.value().size());
+  EXPECT_EQ(image1.pixel(0, 0), loaded1.value().pixel(0, 0));
+
+  const auto loaded2 = atlas.getImage(":/icons/b.svg", 16, 1.5);
+  ASSERT_TRUE(loaded2.has_value());
+  EXPECT_EQ(image2.size(), loaded2.value().size());
+  EXPECT_EQ(qAlpha(image2.pixel(0, 0)), qAlpha(loaded2.value().pixel(0, 0)));
+}
+
+TEST_F(IconAtlasTest, getImageShouldOnlyMatchExactExtentsAndPixelRatios) {
+  const auto image = createImage(20, 20, Qt::black);
+  ASSERT_TRUE(writeIconAtlas({IconAtlasEntry{":/icons/a.svg", 16, 1.25, image}},
+                             imagePath_,
+                             indexPath_));
+
+  const auto atlas = IconAtlas::load(imagePath_, indexPath_);
+
+  EXPECT_TRUE(atlas.getImage(":/icons/a.svg", 16, 1.25).has_value());
+  EXPECT_FALSE(atlas.getImage(":/icons/a.svg", 18, 1.25).has_value());
+  EXPECT_FALSE(atlas.getImage(":/icons/a.svg", 16, 1.0).has_value());
+  EXPECT_FALSE(atlas.getImage(":/icons/a.svg", 16, 1.254).has_value());
+  EXPECT_FALSE(atlas.getImage(":/icons/b.svg", 16, 1.25).has_value());
+}
+}
+}
+
+#endif
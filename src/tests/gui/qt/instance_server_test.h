@@ -0,0 +1,74 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_QT_INSTANCE_SERVER_TEST
+#define LOOT_TESTS_GUI_QT_INSTANCE_SERVER_TEST
+
+#include <gtest/gtest.h>
+
+#include "gui/qt/instance_server.h"
+
+namespace loot {
+namespace test {
+TEST(InstanceRequest, shouldRoundTripThroughSerialization) {
+  InstanceRequest request;
+  request.gameFolderName = "Skyrim Special Edition";
+  request.autoSort = true;
+
+  const auto parsed = parseInstanceRequest(serializeInstanceRequest(request));
+
+  ASSERT_TRUE(parsed.has_value());
+  EXPECT_EQ(request, parsed.value());
+}
+
+TEST(InstanceRequest, shouldRoundTripAnEmptyGameFolderName) {
+  const auto parsed =
+      parseInstanceRequest(serializeInstanceRequest(InstanceRequest()));
+
+  ASSERT_TRUE(parsed.has_value());
+  EXPECT_TRUE(parsed.value().gameFolderName.empty());
+  EXPECT_FALSE(parsed.value().autoSort);
+}
+
+TEST(InstanceRequest, serializedRequestShouldNotContainANewline) {
+  InstanceRequest request;
+  request.gameFolderName = "Skyrim\nSpecial Edition";
+
+  EXPECT_FALSE(serializeInstanceRequest(request).contains('\n'));
+}
+
+TEST(InstanceRequest, parseShouldReturnNulloptForInvalidData) {
+  EXPECT_FALSE(parseInstanceRequest("").has_value());
+  EXPECT_FALSE(parseInstanceRequest("not json").has_value());
+  EXPECT_FALSE(parseInstanceRequest("[]").has_value());
+  EXPECT_FALSE(parseInstanceRequest(R"({"game": 1, "autoSort": true})")
+                   .has_value());
+  EXPECT_FALSE(
+      parseInstanceRequest(R"({"game": "Skyrim"})").has_value());
+}
+}
+}
+
+#endif
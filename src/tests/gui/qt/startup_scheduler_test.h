@@ -0,0 +1,127 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_QT_STARTUP_SCHEDULER_TEST
+#define LOOT_TESTS_GUI_QT_STARTUP_SCHEDULER_TEST
+
+#include <gtest/gtest.h>
+
+#include <QtCore/QCoreApplication>
+#include <vector>
+
+#include "gui/qt/startup_scheduler.h"
+
+namespace loot {
+namespace test {
+class StartupSchedulerTest : public ::testing::Test {
+protected:
+  StartupScheduler scheduler{nullptr};
+
+  static void processEvents() {
+    // Idle work is run one piece per event loop iteration.
+    for (int i = 0; i < 10; i += 1) {
+      QCoreApplication::processEvents();
+    }
+  }
+};
+
+TEST_F(StartupSchedulerTest, shouldStartInTheCriticalPhase) {
+  EXPECT_EQ(StartupPhase::critical, scheduler.getPhase());
+  EXPECT_TRUE(scheduler.hasReached(StartupPhase::critical));
+  EXPECT_FALSE(scheduler.hasReached(StartupPhase::interactive));
+}
+
+TEST_F(StartupSchedulerTest, scheduledWorkShouldNotRunBeforeItsPhase) {
+  bool interactiveRan = false;
+  bool idleRan = false;
+  scheduler.schedule(StartupPhase::interactive,
+                     [&]() { interactiveRan = true; });
+  scheduler.schedule(StartupPhase::idle, [&]() { idleRan = true; });
+
+  processEvents();
+
+  EXPECT_FALSE(interactiveRan);
+  EXPECT_FALSE(idleRan);
+}
+
+TEST_F(StartupSchedulerTest,
+       enterInteractivePhaseShouldRunInteractiveWorkImmediately) {
+  bool interactiveRan = false;
+  bool idleRan = false;
+  scheduler.schedule(StartupPhase::interactive,
+                     [&]() { interactiveRan = true; });
+  scheduler.schedule(StartupPhase::idle, [&]() { idleRan = true; });
+
+  scheduler.enterInteractivePhase();
+
+  EXPECT_EQ(StartupPhase::interactive, scheduler.getPhase());
+  EXPECT_TRUE(interactiveRan);
+  EXPECT_FALSE(idleRan);
+}
+
+TEST_F(StartupSchedulerTest,
+       idleWorkShouldRunInOrderOnceTheEventLoopIsReachedAgain) {
+  std::vector<int> order;
+  scheduler.schedule(StartupPhase::idle, [&]() { order.push_back(1); });
+  scheduler.schedule(StartupPhase::idle, [&]() { order.push_back(2); });
+
+  scheduler.enterInteractivePhase();
+  processEvents();
+
+  EXPECT_EQ(StartupPhase::idle, scheduler.getPhase());
+  EXPECT_EQ(std::vector<int>({1, 2}), order);
+}
+
+TEST_F(StartupSchedulerTest,
+       workScheduledForAReachedPhaseShouldRunWhenEventsAreProcessed) {
+  scheduler.enterInteractivePhase();
+
+  bool ran = false;
+  scheduler.schedule(StartupPhase::interactive, [&]() { ran = true; });
+
+  EXPECT_FALSE(ran);
+
+  processEvents();
+
+  EXPECT_TRUE(ran);
+}
+
+TEST_F(StartupSchedulerTest,
+       enterInteractivePhaseShouldNotRunWorkAgainIfCalledTwice) {
+  int count = 0;
+  scheduler.schedule(StartupPhase::interactive, [&]() { count += 1; });
+
+  scheduler.enterInteractivePhase();
+  scheduler.enterInteractivePhase();
+  processEvents();
+  scheduler.enterInteractivePhase();
+
+  EXPECT_EQ(1, count);
+  EXPECT_EQ(StartupPhase::idle, scheduler.getPhase());
+}
+}
+}
+
+#endif
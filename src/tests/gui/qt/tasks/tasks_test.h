@@ -47,6 +47,8 @@ public:
   TestQuery(int value) : value(value) {}
 
   QueryResult executeLogic() override {
+    cancellationToken().throwIfCancelled();
+
     if (value < 0) {
       throw std::runtime_error("Value is negative");
     }
@@ -61,6 +63,19 @@ private:
   const int value;
 };
 
+class UncheckedQuery : public Query {
+public:
+  explicit UncheckedQuery(bool& wasExecuted) : wasExecuted(wasExecuted) {}
+
+  QueryResult executeLogic() override {
+    wasExecuted = true;
+    return PluginItem();
+  }
+
+private:
+  bool& wasExecuted;
+};
+
 TEST(QueryTask, executeShouldEmitAnErrorIfQueryIsANullPointer) {
   auto task = QueryTask(std::unique_ptr<Query>());
   auto finishedSpy = QSignalSpy(&task, &Task::finished);
@@ -87,6 +102,38 @@ TEST(QueryTask, executeShouldEmitAnErrorIfQueryExecutionThrowsAnException) {
             errorSpy.takeFirst().at(0).value<std::string>());
 }
 
+TEST(QueryTask, executeShouldEmitACancellationErrorIfQueryIsCancelled) {
+  auto query = std::make_unique<TestQuery>(1);
+  query->getCancellationToken()->cancel();
+
+  auto task = QueryTask(std::move(query));
+  auto finishedSpy = QSignalSpy(&task, &Task::finished);
+  auto errorSpy = QSignalSpy(&task, &Task::error);
+
+  task.execute();
+
+  EXPECT_EQ(0, finishedSpy.count());
+  ASSERT_EQ(1, errorSpy.count());
+  EXPECT_EQ(CancelledError().what(),
+            errorSpy.takeFirst().at(0).value<std::string>());
+}
+
+TEST(QueryTask, executeShouldNotRunAQueryThatWasCancelledBeforeItStarted) {
+  bool wasExecuted = false;
+  auto query = std::make_unique<UncheckedQuery>(wasExecuted);
+  query->getCancellationToken()->cancel();
+
+  auto task = QueryTask(std::move(query));
+  auto finishedSpy = QSignalSpy(&task, &Task::finished);
+  auto errorSpy = QSignalSpy(&task, &Task::error);
+
+  task.execute();
+
+  EXPECT_FALSE(wasExecuted);
+  EXPECT_EQ(0, finishedSpy.count());
+  EXPECT_EQ(1, errorSpy.count());
+}
+
 TEST(QueryTask, executeShouldEmitAFinishedIfQueryExecutionSucceeds) {
   auto task = QueryTask(std::make_unique<TestQuery>(1));
   auto finishedSpy = QSignalSpy(&task, &Task::finished);
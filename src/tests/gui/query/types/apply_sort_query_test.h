@@ -0,0 +1,98 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_QUERY_TYPES_APPLY_SORT_QUERY_TEST
+#define LOOT_TESTS_GUI_QUERY_TYPES_APPLY_SORT_QUERY_TEST
+
+#include <gtest/gtest.h>
+
+#include "gui/query/types/apply_sort_query.h"
+
+namespace loot {
+namespace test {
+class ApplySortQueryTest : public ::testing::Test {
+protected:
+  class FakeGame {
+  public:
+    void LoadCurrentLoadOrderState() { ++loadCount; }
+
+    std::vector<std::string> GetLoadOrder() const { return loadOrder; }
+
+    void SetLoadOrder(const std::vector<std::string>& newLoadOrder) {
+      loadOrder = newLoadOrder;
+      ++setCount;
+    }
+
+    bool IsLoadOrderAmbiguous() const { return isAmbiguous; }
+
+    std::filesystem::path GetActivePluginsFilePath() const {
+      return "plugins.txt";
+    }
+
+    std::vector<std::string> loadOrder{"A.esm", "B.esp"};
+    bool isAmbiguous{false};
+    size_t loadCount{0};
+    size_t setCount{0};
+  };
+
+  FakeGame game_;
+  UnappliedChangeCounter counter_;
+};
+
+TEST_F(ApplySortQueryTest, executeLogicShouldSetTheLoadOrderIfItHasChanged) {
+  const std::vector<std::string> sortedLoadOrder{"B.esp", "A.esm"};
+  ApplySortQuery<FakeGame> query(game_, counter_, sortedLoadOrder);
+
+  query.executeLogic();
+
+  EXPECT_EQ(1, game_.setCount);
+  EXPECT_EQ(sortedLoadOrder, game_.loadOrder);
+}
+
+TEST_F(ApplySortQueryTest,
+       executeLogicShouldNotSetTheLoadOrderIfItIsUnchanged) {
+  counter_.IncrementUnappliedChangeCounter();
+  ApplySortQuery<FakeGame> query(game_, counter_, game_.loadOrder);
+
+  query.executeLogic();
+
+  EXPECT_EQ(1, game_.loadCount);
+  EXPECT_EQ(0, game_.setCount);
+  EXPECT_FALSE(counter_.HasUnappliedChanges());
+}
+
+TEST_F(ApplySortQueryTest,
+       executeLogicShouldSetAnUnchangedLoadOrderIfItIsAmbiguous) {
+  game_.isAmbiguous = true;
+  ApplySortQuery<FakeGame> query(game_, counter_, game_.loadOrder);
+
+  query.executeLogic();
+
+  EXPECT_EQ(1, game_.setCount);
+}
+}
+}
+
+#endif
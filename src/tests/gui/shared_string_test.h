@@ -0,0 +1,84 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_SHARED_STRING_TEST
+#define LOOT_TESTS_GUI_SHARED_STRING_TEST
+
+#include <gtest/gtest.h>
+
+#include "gui/shared_string.h"
+
+namespace loot::test {
+TEST(SharedString, defaultConstructorShouldCreateAnEmptyString) {
+  const SharedString string;
+
+  EXPECT_TRUE(string.empty());
+  EXPECT_EQ("", string.str());
+  EXPECT_EQ(SharedString(""), string);
+}
+
+TEST(SharedString, copiesShouldShareTheSameStorage) {
+  const auto string1 = SharedString(std::string("Requires SKSE."));
+  const auto string2 = string1;
+
+  EXPECT_EQ(&string1.str(), &string2.str());
+}
+
+TEST(SharedString, pooledStringsWithEqualValuesShouldShareTheSameStorage) {
+  const auto string1 = SharedString::Pooled("Requires SKSE.");
+  const auto string2 = SharedString::Pooled(std::string("Requires SKSE."));
+
+  EXPECT_EQ(&string1.str(), &string2.str());
+}
+
+TEST(SharedString, equalityOperatorShouldCompareValues) {
+  EXPECT_TRUE(SharedString("Delev") == SharedString("Delev"));
+  EXPECT_FALSE(SharedString("Delev") == SharedString("Relev"));
+  EXPECT_TRUE(SharedString("Delev") == SharedString::Pooled("Delev"));
+  EXPECT_FALSE(SharedString("Delev") == SharedString("delev"));
+}
+
+TEST(SharedString, inequalityOperatorShouldReturnTrueIfValuesAreNotEqual) {
+  EXPECT_TRUE(SharedString("Delev") != SharedString("Relev"));
+  EXPECT_FALSE(SharedString("Delev") != SharedString("Delev"));
+}
+
+TEST(SharedString, shouldBeComparableWithStrings) {
+  const auto string = SharedString("Delev");
+
+  EXPECT_TRUE(string == "Delev");
+  EXPECT_TRUE(std::string("Delev") == string);
+  EXPECT_TRUE(string != "Relev");
+}
+
+TEST(SharedString, shouldBeImplicitlyConvertibleToAStringReference) {
+  const auto string = SharedString("Delev");
+  const std::string& reference = string;
+
+  EXPECT_EQ("Delev", reference);
+}
+}
+
+#endif
@@ -75,6 +75,44 @@ TEST(SourcedMessage, equalityOperatorShouldReturnTrueIfAnyFieldIsNotEqual) {
   EXPECT_TRUE(message1 != message2);
 }
 
+TEST(HashMessages, shouldReturnZeroIfThereAreNoMessages) {
+  EXPECT_EQ(0, HashMessages({}));
+}
+
+TEST(HashMessages, shouldReturnTheSameHashForEqualMessages) {
+  const std::vector<SourcedMessage> messages{
+      SourcedMessage{MessageType::say, MessageSource::init, "text"}};
+
+  EXPECT_EQ(HashMessages(messages), HashMessages(messages));
+  EXPECT_NE(0, HashMessages(messages));
+}
+
+TEST(HashMessages, shouldReturnDifferentHashesIfAnyFieldIsNotEqual) {
+  const auto message1 =
+      SourcedMessage{MessageType::say, MessageSource::init, "text"};
+  const auto hash = HashMessages({message1});
+
+  EXPECT_NE(hash,
+            HashMessages({SourcedMessage{
+                MessageType::warn, MessageSource::init, "text"}}));
+  EXPECT_NE(hash,
+            HashMessages({SourcedMessage{
+                MessageType::say, MessageSource::inactiveMaster, "text"}}));
+  EXPECT_NE(hash,
+            HashMessages({SourcedMessage{
+                MessageType::say, MessageSource::init, "different"}}));
+}
+
+TEST(HashMessages, shouldDependOnTheOrderOfMessages) {
+  const auto message1 =
+      SourcedMessage{MessageType::say, MessageSource::init, "text 1"};
+  const auto message2 =
+      SourcedMessage{MessageType::say, MessageSource::init, "text 2"};
+
+  EXPECT_NE(HashMessages({message1, message2}),
+            HashMessages({message2, message1}));
+}
+
 TEST(CreatePlainTextSourcedMessage, shouldEscapeMarkdownSpecialCharacters) {
   const auto message = CreatePlainTextSourcedMessage(
       MessageType::say, MessageSource::init, "normal text\\`*_{}[]()#+-.!");
@@ -84,6 +122,45 @@ TEST(CreatePlainTextSourcedMessage, shouldEscapeMarkdownSpecialCharacters) {
   EXPECT_EQ(expectedText, message.text);
 }
 
+TEST(MessagesAsMarkdown, shouldReturnAnEmptyStringIfThereAreNoMessages) {
+  EXPECT_EQ("", MessagesAsMarkdown({}));
+}
+
+TEST(MessagesAsMarkdown, shouldListMessagesWithTheirTypes) {
+  const std::vector<SourcedMessage> messages{
+      SourcedMessage{MessageType::say, MessageSource::init, "1"},
+      SourcedMessage{MessageType::warn, MessageSource::init, "2"},
+      SourcedMessage{MessageType::error, MessageSource::init, "3"},
+  };
+
+  EXPECT_EQ("## Messages\n\n- Note: 1\n- Warning: 2\n- Error: 3\n",
+            MessagesAsMarkdown(messages));
+}
+
+TEST(AppendMessagesAsMarkdown, shouldAppendToTheGivenString) {
+  const std::vector<SourcedMessage> messages{
+      SourcedMessage{MessageType::say, MessageSource::init, "1"},
+  };
+
+  std::string content = "text\n";
+  AppendMessagesAsMarkdown(content, messages);
+
+  EXPECT_EQ("text\n" + MessagesAsMarkdown(messages), content);
+}
+
+TEST(EstimateMessagesAsMarkdownSize,
+     shouldNotBeLessThanTheSizeOfTheMarkdownText) {
+  const std::vector<SourcedMessage> messages{
+      SourcedMessage{MessageType::say, MessageSource::init, "1"},
+      SourcedMessage{MessageType::warn, MessageSource::init, "22"},
+      SourcedMessage{MessageType::error, MessageSource::init, "333"},
+  };
+
+  EXPECT_EQ(0, EstimateMessagesAsMarkdownSize({}));
+  EXPECT_LE(MessagesAsMarkdown(messages).size(),
+            EstimateMessagesAsMarkdownSize(messages));
+}
+
 TEST(ToSourcedMessage, shouldOutputAllNonZeroCounts) {
   const auto detail = std::vector<MessageContent>({
       MessageContent("detail"),
@@ -191,6 +268,24 @@ TEST(ToSourcedMessage,
       message.text);
 }
 
+TEST(SelectMessageText, shouldReturnNulloptIfThereIsNoContent) {
+  EXPECT_FALSE(SelectMessageText({}, MessageContent::DEFAULT_LANGUAGE));
+}
+
+TEST(SelectMessageText, shouldReturnTheOnlyContentWhateverItsLanguage) {
+  EXPECT_EQ("1_fr", SelectMessageText({MessageContent("1_fr", "fr")}, "de"));
+}
+
+TEST(SelectMessageText, shouldSelectTheSameContentAsSelectMessageContent) {
+  const std::vector<MessageContent> content{MessageContent("1_en", "en"),
+                                            MessageContent("1_fr", "fr")};
+
+  for (const auto& language : {"en", "fr", "de"}) {
+    EXPECT_EQ(SelectMessageContent(content, language).value().GetText(),
+              SelectMessageText(content, language));
+  }
+}
+
 TEST(ToSourcedMessages, shouldSkipAnyMessagesWithoutContentInTheGivenLanguage) {
   const std::vector<Message> messages{
       Message(MessageType::say,
@@ -0,0 +1,112 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_DIAGNOSTICS_TEST
+#define LOOT_TESTS_GUI_STATE_DIAGNOSTICS_TEST
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "gui/state/diagnostics.h"
+
+namespace loot {
+namespace test {
+std::optional<CacheStats> findCacheStats(const std::string& cacheName) {
+  for (const auto& stats : getCacheStats()) {
+    if (stats.cacheName == cacheName) {
+      return stats;
+    }
+  }
+
+  return std::nullopt;
+}
+
+TEST(CacheCounter, getStatsShouldReturnZeroCountsIfNoLookupsWereRecorded) {
+  static CacheCounter counter("unused test cache");
+
+  const auto stats = counter.getStats();
+
+  EXPECT_EQ("unused test cache", stats.cacheName);
+  EXPECT_EQ(0, stats.hits);
+  EXPECT_EQ(0, stats.misses);
+}
+
+TEST(CacheCounter, recordLookupShouldCountHitsAndMissesSeparately) {
+  static CacheCounter counter("counting test cache");
+
+  counter.recordLookup(true);
+  counter.recordLookup(false);
+  counter.recordLookup(true);
+
+  const auto stats = counter.getStats();
+
+  EXPECT_EQ(2, stats.hits);
+  EXPECT_EQ(1, stats.misses);
+}
+
+TEST(getCacheStats, shouldIncludeTheStatsOfEveryCounter) {
+  static CacheCounter counter("registered test cache");
+  counter.recordLookup(false);
+
+  const auto stats = findCacheStats("registered test cache");
+
+  ASSERT_TRUE(stats.has_value());
+  EXPECT_EQ(0, stats->hits);
+  EXPECT_EQ(1, stats->misses);
+}
+
+TEST(getCacheStats, shouldOrderStatsByCacheName) {
+  static CacheCounter counter1("test cache b");
+  static CacheCounter counter2("test cache a");
+
+  const auto stats = getCacheStats();
+
+  EXPECT_TRUE(std::is_sorted(stats.begin(),
+                             stats.end(),
+                             [](const CacheStats& lhs, const CacheStats& rhs) {
+                               return lhs.cacheName < rhs.cacheName;
+                             }));
+}
+
+TEST(getProcessMemoryUsage, shouldReturnANonZeroValue) {
+  const auto memoryUsage = getProcessMemoryUsage();
+
+  ASSERT_TRUE(memoryUsage.has_value());
+  EXPECT_LT(0u, memoryUsage.value());
+}
+
+TEST(getProcessPeakMemoryUsage, shouldReturnAtLeastTheCurrentMemoryUsage) {
+  const auto memoryUsage = getProcessMemoryUsage();
+  const auto peakMemoryUsage = getProcessPeakMemoryUsage();
+
+  ASSERT_TRUE(memoryUsage.has_value());
+  ASSERT_TRUE(peakMemoryUsage.has_value());
+  EXPECT_LE(memoryUsage.value(), peakMemoryUsage.value());
+}
+}
+}
+
+#endif
@@ -0,0 +1,91 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_DOWNLOAD_MIRRORS_TEST
+#define LOOT_TESTS_GUI_STATE_DOWNLOAD_MIRRORS_TEST
+
+#include <gtest/gtest.h>
+
+#include "gui/state/download_mirrors.h"
+
+namespace loot::test {
+TEST(DownloadMirrorRanking, orderShouldKeepTheOrderOfUntriedUrls) {
+  DownloadMirrorRanking ranking;
+
+  const std::vector<std::string> urls{"a", "b", "c"};
+
+  EXPECT_EQ(urls, ranking.Order(urls));
+}
+
+TEST(DownloadMirrorRanking, orderShouldPutTheFastestSuccessfulUrlsFirst) {
+  DownloadMirrorRanking ranking;
+  ranking.RecordSuccess("b", std::chrono::milliseconds(200));
+  ranking.RecordSuccess("c", std::chrono::milliseconds(100));
+
+  const std::vector<std::string> expected{"c", "b", "a"};
+
+  EXPECT_EQ(expected, ranking.Order({"a", "b", "c"}));
+}
+
+TEST(DownloadMirrorRanking, orderShouldPutFailedUrlsLast) {
+  DownloadMirrorRanking ranking;
+  ranking.RecordFailure("a");
+  ranking.RecordFailure("a");
+  ranking.RecordFailure("b");
+
+  const std::vector<std::string> expected{"c", "b", "a"};
+
+  EXPECT_EQ(expected, ranking.Order({"a", "b", "c"}));
+}
+
+TEST(DownloadMirrorRanking, aSuccessShouldClearPreviousFailures) {
+  DownloadMirrorRanking ranking;
+  ranking.RecordFailure("a");
+  ranking.RecordSuccess("a", std::chrono::milliseconds(100));
+
+  const std::vector<std::string> expected{"a", "b"};
+
+  EXPECT_EQ(expected, ranking.Order({"a", "b"}));
+}
+
+TEST(GetRetryDelay, shouldDoubleWithEachAttempt) {
+  EXPECT_EQ(std::chrono::milliseconds(250), GetRetryDelay(0, 0.0));
+  EXPECT_EQ(std::chrono::milliseconds(500), GetRetryDelay(1, 0.0));
+  EXPECT_EQ(std::chrono::milliseconds(1000), GetRetryDelay(2, 0.0));
+}
+
+TEST(GetRetryDelay, shouldBeLimited) {
+  EXPECT_EQ(std::chrono::milliseconds(4000), GetRetryDelay(10, 0.0));
+  EXPECT_EQ(std::chrono::milliseconds(4000), GetRetryDelay(1000, 0.0));
+}
+
+TEST(GetRetryDelay, shouldBeShortenedByUpToHalfByJitter) {
+  EXPECT_EQ(std::chrono::milliseconds(375), GetRetryDelay(1, 0.5));
+  EXPECT_EQ(std::chrono::milliseconds(250), GetRetryDelay(1, 1.0));
+  EXPECT_EQ(std::chrono::milliseconds(250), GetRetryDelay(1, 2.0));
+}
+}
+
+#endif
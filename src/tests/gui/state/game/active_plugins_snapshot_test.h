@@ -0,0 +1,71 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_GAME_ACTIVE_PLUGINS_SNAPSHOT_TEST
+#define LOOT_TESTS_GUI_STATE_GAME_ACTIVE_PLUGINS_SNAPSHOT_TEST
+
+#include <gtest/gtest.h>
+
+#include <boost/locale.hpp>
+
+#include "gui/state/game/active_plugins_snapshot.h"
+
+namespace loot {
+namespace test {
+class ActivePluginsSnapshotTest : public ::testing::Test {
+protected:
+  ActivePluginsSnapshotTest() {
+    // Lowercasing plugin names uses boost::locale.
+    boost::locale::generator gen;
+    std::locale::global(gen("en.UTF-8"));
+  }
+};
+
+TEST_F(ActivePluginsSnapshotTest,
+       isActiveShouldReturnFalseIfDefaultConstructed) {
+  ActivePluginsSnapshot snapshot;
+
+  EXPECT_FALSE(snapshot.IsActive("Blank.esm"));
+}
+
+TEST_F(ActivePluginsSnapshotTest,
+       isActiveShouldReturnTrueOnlyForPluginsThatWereActive) {
+  ActivePluginsSnapshot snapshot({"Blank.esm", "Blank.esp"});
+
+  EXPECT_TRUE(snapshot.IsActive("Blank.esm"));
+  EXPECT_TRUE(snapshot.IsActive("Blank.esp"));
+  EXPECT_FALSE(snapshot.IsActive("Blank - Different.esp"));
+}
+
+TEST_F(ActivePluginsSnapshotTest, isActiveShouldBeCaseInsensitive) {
+  ActivePluginsSnapshot snapshot({"Blank.esm", u8"non\u00C1scii.esp"});
+
+  EXPECT_TRUE(snapshot.IsActive("blank.ESM"));
+  EXPECT_TRUE(snapshot.IsActive(u8"NON\u00E1SCII.esp"));
+}
+}
+}
+
+#endif
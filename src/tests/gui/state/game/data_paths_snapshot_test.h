@@ -0,0 +1,217 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_GAME_DATA_PATHS_SNAPSHOT_TEST
+#define LOOT_TESTS_GUI_STATE_GAME_DATA_PATHS_SNAPSHOT_TEST
+
+#include <gtest/gtest.h>
+
+#include "gui/state/game/data_paths_snapshot.h"
+#include "tests/gui/test_helpers.h"
+
+namespace loot {
+namespace test {
+class DataPathsSnapshotTest : public ::testing::Test {
+protected:
+  DataPathsSnapshotTest() :
+      rootPath_(getTempPath()),
+      dataPath_(rootPath_ / "Data"),
+      externalDataPath_(rootPath_ / "External") {}
+
+  void SetUp() override {
+    touch(dataPath_ / "Blank.esm");
+    touch(dataPath_ / "Blank.esp.ghost");
+    touch(dataPath_ / "readme.txt.ghost");
+    touch(externalDataPath_ / "External.esm");
+    touch(dataPath_ / "BashTags" / "Blank.txt");
+    std::filesystem::create_directories(dataPath_ / "SKSE");
+  }
+
+  void TearDown() override { std::filesystem::remove_all(rootPath_); }
+
+  const std::filesystem::path rootPath_;
+  const std::filesystem::path dataPath_;
+  const std::filesystem::path externalDataPath_;
+};
+
+TEST_F(DataPathsSnapshotTest,
+       fileExistsShouldReturnNulloptIfDefaultConstructed) {
+  DataPathsSnapshot snapshot;
+
+  EXPECT_FALSE(snapshot.FileExists("Blank.esm").has_value());
+}
+
+TEST_F(DataPathsSnapshotTest,
+       fileExistsShouldReturnTrueForEntriesInAnyDataPath) {
+  DataPathsSnapshot snapshot({externalDataPath_}, dataPath_);
+
+  EXPECT_EQ(true, snapshot.FileExists("Blank.esm"));
+  EXPECT_EQ(true, snapshot.FileExists("External.esm"));
+  EXPECT_EQ(true, snapshot.FileExists("SKSE"));
+}
+
+TEST_F(DataPathsSnapshotTest, fileExistsShouldBeCaseInsensitive) {
+  DataPathsSnapshot snapshot({externalDataPath_}, dataPath_);
+
+  EXPECT_EQ(true, snapshot.FileExists("blank.ESM"));
+}
+
+TEST_F(DataPathsSnapshotTest, fileExistsShouldReturnTrueForGhostedPluginsOnly) {
+  DataPathsSnapshot snapshot({externalDataPath_}, dataPath_);
+
+  EXPECT_EQ(true, snapshot.FileExists("Blank.esp"));
+  EXPECT_EQ(false, snapshot.FileExists("readme.txt"));
+}
+
+TEST_F(DataPathsSnapshotTest, fileExistsShouldReturnFalseForMissingFiles) {
+  DataPathsSnapshot snapshot({externalDataPath_}, dataPath_);
+
+  EXPECT_EQ(false, snapshot.FileExists("missing.esp"));
+}
+
+TEST_F(DataPathsSnapshotTest,
+       fileExistsShouldReturnNulloptForPathsWithSubdirectories) {
+  DataPathsSnapshot snapshot({externalDataPath_}, dataPath_);
+
+  EXPECT_FALSE(snapshot.FileExists("SKSE/Plugins/foo.dll").has_value());
+  EXPECT_FALSE(snapshot.FileExists("SKSE\\Plugins\\foo.dll").has_value());
+}
+
+TEST_F(DataPathsSnapshotTest,
+       getRecordedFileExistsShouldReturnNulloptIfNothingWasRecorded) {
+  DataPathsSnapshot snapshot({externalDataPath_}, dataPath_);
+
+  EXPECT_FALSE(snapshot.GetRecordedFileExists("SKSE/Plugins/foo.dll"));
+}
+
+TEST_F(DataPathsSnapshotTest,
+       getRecordedFileExistsShouldCaseInsensitivelyReturnTheRecordedValue) {
+  DataPathsSnapshot snapshot({externalDataPath_}, dataPath_);
+
+  snapshot.RecordFileExists("SKSE/Plugins/foo.dll", true);
+  snapshot.RecordFileExists("SKSE/Plugins/bar.dll", false);
+
+  EXPECT_EQ(true, snapshot.GetRecordedFileExists("skse/plugins/FOO.dll"));
+  EXPECT_EQ(false, snapshot.GetRecordedFileExists("SKSE/Plugins/bar.dll"));
+}
+
+TEST_F(DataPathsSnapshotTest,
+       resolveFilePathShouldReturnNulloptIfDefaultConstructed) {
+  DataPathsSnapshot snapshot;
+
+  EXPECT_FALSE(snapshot.ResolveFilePath("Blank.esm").has_value());
+}
+
+TEST_F(DataPathsSnapshotTest,
+       resolveFilePathShouldReturnNulloptForPathsWithSubdirectories) {
+  DataPathsSnapshot snapshot({externalDataPath_}, dataPath_);
+
+  EXPECT_FALSE(snapshot.ResolveFilePath("SKSE/Plugins/foo.dll").has_value());
+}
+
+TEST_F(DataPathsSnapshotTest,
+       resolveFilePathShouldPreferExternalDataPathsOverTheDataPath) {
+  touch(dataPath_ / "External.esm");
+  DataPathsSnapshot snapshot({externalDataPath_}, dataPath_);
+
+  EXPECT_EQ(externalDataPath_ / "External.esm",
+            snapshot.ResolveFilePath("External.esm"));
+  EXPECT_EQ(dataPath_ / "Blank.esm", snapshot.ResolveFilePath("Blank.esm"));
+}
+
+TEST_F(DataPathsSnapshotTest,
+       resolveFilePathShouldReturnTheUnghostedPathOfAGhostedPlugin) {
+  DataPathsSnapshot snapshot({externalDataPath_}, dataPath_);
+
+  EXPECT_EQ(dataPath_ / "Blank.esp", snapshot.ResolveFilePath("Blank.esp"));
+}
+
+TEST_F(DataPathsSnapshotTest,
+       resolveFilePathShouldFallBackToTheDataPathForMissingFiles) {
+  DataPathsSnapshot snapshot({externalDataPath_}, dataPath_);
+
+  EXPECT_EQ(dataPath_ / "missing.esp", snapshot.ResolveFilePath("missing.esp"));
+}
+
+#ifdef _WIN32
+TEST_F(DataPathsSnapshotTest, resolveFilePathShouldKeepTheGivenCaseOnWindows) {
+  DataPathsSnapshot snapshot({externalDataPath_}, dataPath_);
+
+  EXPECT_EQ(externalDataPath_ / "external.ESM",
+            snapshot.ResolveFilePath("external.ESM"));
+}
+#else
+TEST_F(DataPathsSnapshotTest, resolveFilePathShouldUseTheCaseOfTheEntryOnDisk) {
+  DataPathsSnapshot snapshot({externalDataPath_}, dataPath_);
+
+  EXPECT_EQ(externalDataPath_ / "External.esm",
+            snapshot.ResolveFilePath("external.ESM"));
+  EXPECT_EQ(dataPath_ / "Blank.esp", snapshot.ResolveFilePath("blank.ESP"));
+}
+#endif
+
+TEST_F(DataPathsSnapshotTest, missingDataPathsShouldBeTreatedAsEmpty) {
+  DataPathsSnapshot snapshot({rootPath_ / "missing"}, dataPath_);
+
+  EXPECT_EQ(true, snapshot.FileExists("Blank.esm"));
+  EXPECT_EQ(false, snapshot.FileExists("External.esm"));
+}
+
+TEST_F(DataPathsSnapshotTest,
+       findBashTagsFileShouldReturnNulloptIfDefaultConstructed) {
+  DataPathsSnapshot snapshot;
+
+  EXPECT_FALSE(snapshot.FindBashTagsFile("Blank.esp").has_value());
+}
+
+TEST_F(DataPathsSnapshotTest,
+       findBashTagsFileShouldCaseInsensitivelyFindAPluginsBashTagsFile) {
+  DataPathsSnapshot snapshot({externalDataPath_}, dataPath_);
+
+  const auto path = snapshot.FindBashTagsFile("blank.ESP");
+
+  ASSERT_TRUE(path.has_value());
+  EXPECT_TRUE(std::filesystem::exists(path.value()));
+}
+
+TEST_F(DataPathsSnapshotTest,
+       findBashTagsFileShouldReturnNulloptIfAPluginHasNoBashTagsFile) {
+  DataPathsSnapshot snapshot({externalDataPath_}, dataPath_);
+
+  EXPECT_FALSE(snapshot.FindBashTagsFile("Blank.esm.esp").has_value());
+  EXPECT_FALSE(snapshot.FindBashTagsFile("External.esm").has_value());
+}
+
+TEST_F(DataPathsSnapshotTest,
+       findBashTagsFileShouldReturnNulloptIfThereIsNoBashTagsDirectory) {
+  std::filesystem::remove_all(dataPath_ / "BashTags");
+  DataPathsSnapshot snapshot({externalDataPath_}, dataPath_);
+
+  EXPECT_FALSE(snapshot.FindBashTagsFile("Blank.esp").has_value());
+}
+}
+}
+
+#endif
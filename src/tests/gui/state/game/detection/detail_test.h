@@ -450,6 +450,55 @@ TEST(UpdateMatchingSettings,
   EXPECT_TRUE(gamesSettings[0].GameLocalPath().empty());
 }
 
+class CreateArePathsEquivalentComparatorTest : public CommonGameTestFixture {
+protected:
+  CreateArePathsEquivalentComparatorTest() :
+      CommonGameTestFixture(GameId::tes4) {}
+
+  GameInstall createInstall(const std::filesystem::path& installPath) const {
+    return GameInstall{
+        GameId::tes4, InstallSource::unknown, installPath, localPath};
+  }
+};
+
+TEST_F(CreateArePathsEquivalentComparatorTest,
+       comparatorShouldReturnTrueForIdenticalPathsEvenIfTheyDoNotExist) {
+  const auto comparator = CreateArePathsEquivalentComparator();
+  const auto settings =
+      GameSettings(GameId::tes4, "").SetGamePath(missingPath);
+
+  EXPECT_TRUE(comparator(settings, createInstall(missingPath)));
+}
+
+TEST_F(CreateArePathsEquivalentComparatorTest,
+       comparatorShouldReturnFalseIfEitherPathDoesNotExist) {
+  const auto comparator = CreateArePathsEquivalentComparator();
+  const auto settings = GameSettings(GameId::tes4, "").SetGamePath(dataPath);
+
+  EXPECT_FALSE(comparator(settings, createInstall(missingPath)));
+  EXPECT_FALSE(comparator(
+      GameSettings(GameId::tes4, "").SetGamePath(missingPath),
+      createInstall(dataPath)));
+}
+
+TEST_F(CreateArePathsEquivalentComparatorTest,
+       comparatorShouldReturnTrueForDifferentPathsToTheSameDirectory) {
+  const auto comparator = CreateArePathsEquivalentComparator();
+  const auto settings = GameSettings(GameId::tes4, "").SetGamePath(dataPath);
+  const auto install = createInstall(dataPath / ".." / dataPath.filename());
+
+  EXPECT_TRUE(ArePathsEquivalent(settings, install));
+  EXPECT_TRUE(comparator(settings, install));
+}
+
+TEST_F(CreateArePathsEquivalentComparatorTest,
+       comparatorShouldReturnFalseForDifferentExistingDirectories) {
+  const auto comparator = CreateArePathsEquivalentComparator();
+  const auto settings = GameSettings(GameId::tes4, "").SetGamePath(dataPath);
+
+  EXPECT_FALSE(comparator(settings, createInstall(localPath)));
+}
+
 TEST(AppendNewGamesSettings,
      shouldAppendSettingsForEachNewInstallUsingGameDefaults) {
   const std::filesystem::path installPath = "install";
@@ -100,6 +100,21 @@ TEST_F(
   EXPECT_TRUE(installs.empty());
 }
 
+TEST_F(Heroic_GetInstalledGogGamesTest,
+       shouldReturnNoInstallsIfASupportedAppNameIsOnlyInAnotherField) {
+  std::ofstream out(gogInstalledPath_);
+  out << R"test({"installed": [{
+	"install_path": "/home/user/Games/Heroic/Morrowind",
+	"appName": "unsupported",
+	"buildId": "1435828767"
+}]})test";
+  out.close();
+
+  const auto installs = loot::heroic::GetInstalledGogGames(rootPath_);
+
+  EXPECT_TRUE(installs.empty());
+}
+
 TEST_F(Heroic_GetInstalledGogGamesTest, shouldReturnAllSupportedGameInstalls) {
   std::ofstream out(gogInstalledPath_);
   out << R"test({"installed": [
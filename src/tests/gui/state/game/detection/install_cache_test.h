@@ -0,0 +1,162 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_GAME_DETECTION_INSTALL_CACHE_TEST
+#define LOOT_TESTS_GUI_STATE_GAME_DETECTION_INSTALL_CACHE_TEST
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "gui/state/game/detection/install_cache.h"
+#include "tests/common_game_test_fixture.h"
+#include "tests/gui/state/game/detection/test_registry.h"
+
+namespace loot::test {
+class InstallCacheTest : public ::testing::Test {
+public:
+  InstallCacheTest() :
+      rootPath_(getTempPath()),
+      cachePath_(rootPath_ / "game_installs.toml"),
+      heroicConfigPath_(rootPath_ / "heroic"),
+      gamesConfigPath_(heroicConfigPath_ / "GamesConfig"),
+      preferredUILanguages_({"en"}) {}
+
+protected:
+  void SetUp() override {
+    std::filesystem::create_directories(gamesConfigPath_);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(rootPath_); }
+
+  std::optional<std::vector<GameInstall>> load() const {
+    return LoadCachedGameInstalls(
+        cachePath_, registry_, {heroicConfigPath_}, {}, preferredUILanguages_);
+  }
+
+  std::vector<GameInstall> detect() const {
+    return DetectAndCacheGameInstalls(
+        cachePath_, registry_, {heroicConfigPath_}, {}, preferredUILanguages_);
+  }
+
+  const std::filesystem::path rootPath_;
+  const std::filesystem::path cachePath_;
+  const std::filesystem::path heroicConfigPath_;
+  const std::filesystem::path gamesConfigPath_;
+  std::vector<std::string> preferredUILanguages_;
+  TestRegistry registry_;
+};
+
+TEST_F(InstallCacheTest,
+       loadCachedGameInstallsShouldReturnNulloptIfTheCacheDoesNotExist) {
+  EXPECT_FALSE(load().has_value());
+}
+
+TEST_F(InstallCacheTest,
+       loadCachedGameInstallsShouldReturnNulloptIfTheCacheIsInvalid) {
+  std::ofstream out(cachePath_);
+  out << "this is not valid TOML = = =";
+  out.close();
+
+  EXPECT_FALSE(load().has_value());
+}
+
+TEST_F(InstallCacheTest, detectAndCacheGameInstallsShouldWriteTheCache) {
+  detect();
+
+  EXPECT_TRUE(std::filesystem::exists(cachePath_));
+}
+
+TEST_F(InstallCacheTest,
+       loadCachedGameInstallsShouldReturnTheCachedInstallsIfNothingChanged) {
+  const auto installs = detect();
+
+  const auto cachedInstalls = load();
+
+  ASSERT_TRUE(cachedInstalls.has_value());
+  EXPECT_EQ(installs.size(), cachedInstalls.value().size());
+}
+
+TEST_F(InstallCacheTest,
+       loadCachedGameInstallsShouldReturnNulloptIfAWatchedFileIsCreated) {
+  detect();
+
+  const auto installedJsonPath =
+      heroicConfigPath_ / "gog_store" / "installed.json";
+  std::filesystem::create_directories(installedJsonPath.parent_path());
+  std::ofstream out(installedJsonPath);
+  out << R"({"installed": []})";
+  out.close();
+
+  EXPECT_FALSE(load().has_value());
+}
+
+TEST_F(
+    InstallCacheTest,
+    loadCachedGameInstallsShouldReturnNulloptIfAWatchedDirectoryWriteTimeChanges) {
+  detect();
+
+  const auto writeTime = std::filesystem::last_write_time(gamesConfigPath_);
+  std::filesystem::last_write_time(gamesConfigPath_,
+                                   writeTime + std::chrono::hours(1));
+
+  EXPECT_FALSE(load().has_value());
+}
+
+TEST_F(InstallCacheTest,
+       loadCachedGameInstallsShouldReturnNulloptIfARegistryValueChanges) {
+  detect();
+
+  registry_.SetStringValue("Software\\Epic Games\\EpicGamesLauncher",
+                           (rootPath_ / "egs").u8string());
+
+  EXPECT_FALSE(load().has_value());
+}
+
+TEST_F(
+    InstallCacheTest,
+    loadCachedGameInstallsShouldReturnNulloptIfThePreferredUILanguagesChange) {
+  detect();
+
+  preferredUILanguages_ = {"de"};
+
+  EXPECT_FALSE(load().has_value());
+}
+
+TEST_F(InstallCacheTest,
+       findGameInstallsUsingCacheShouldUpdateTheCacheIfItIsOutOfDate) {
+  detect();
+
+  preferredUILanguages_ = {"de"};
+  ASSERT_FALSE(load().has_value());
+
+  FindGameInstallsUsingCache(
+      cachePath_, registry_, {heroicConfigPath_}, {}, preferredUILanguages_);
+
+  EXPECT_TRUE(load().has_value());
+}
+}
+
+#endif
@@ -0,0 +1,111 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_GAME_DETECTION_REGISTRY_TEST
+#define LOOT_TESTS_GUI_STATE_GAME_DETECTION_REGISTRY_TEST
+
+#include <gtest/gtest.h>
+
+#include "gui/state/game/detection/registry.h"
+#include "tests/gui/state/game/detection/test_registry.h"
+
+namespace loot::test {
+class CountingRegistry : public TestRegistry {
+public:
+  std::optional<std::string> GetStringValue(
+      const RegistryValue& value) const override {
+    stringValueReads_ += 1;
+    return TestRegistry::GetStringValue(value);
+  }
+
+  std::vector<std::string> GetSubKeys(
+      const std::string& rootKey,
+      const std::string& subKey) const override {
+    subKeyReads_ += 1;
+    return TestRegistry::GetSubKeys(rootKey, subKey);
+  }
+
+  size_t GetStringValueReads() const { return stringValueReads_; }
+
+  size_t GetSubKeyReads() const { return subKeyReads_; }
+
+private:
+  mutable size_t stringValueReads_{0};
+  mutable size_t subKeyReads_{0};
+};
+
+TEST(CachingRegistry, getStringValueShouldOnlyReadEachValueOnce) {
+  CountingRegistry registry;
+  registry.SetStringValue("Software\\Test", "value");
+  const CachingRegistry cachingRegistry(registry);
+
+  const RegistryValue value{"HKEY_LOCAL_MACHINE", "Software\\Test", "Path"};
+  EXPECT_EQ("value", cachingRegistry.GetStringValue(value));
+  EXPECT_EQ("value", cachingRegistry.GetStringValue(value));
+
+  EXPECT_EQ(1, registry.GetStringValueReads());
+}
+
+TEST(CachingRegistry, getStringValueShouldMemoiseMissingValues) {
+  CountingRegistry registry;
+  const CachingRegistry cachingRegistry(registry);
+
+  const RegistryValue value{"HKEY_LOCAL_MACHINE", "Software\\Test", "Path"};
+  EXPECT_FALSE(cachingRegistry.GetStringValue(value).has_value());
+  EXPECT_FALSE(cachingRegistry.GetStringValue(value).has_value());
+
+  EXPECT_EQ(1, registry.GetStringValueReads());
+}
+
+TEST(CachingRegistry, getStringValueShouldReadDifferentValuesSeparately) {
+  CountingRegistry registry;
+  const CachingRegistry cachingRegistry(registry);
+
+  cachingRegistry.GetStringValue(
+      {"HKEY_LOCAL_MACHINE", "Software\\Test", "Path"});
+  cachingRegistry.GetStringValue(
+      {"HKEY_LOCAL_MACHINE", "Software\\Test", "InstallPath"});
+  cachingRegistry.GetStringValue(
+      {"HKEY_CURRENT_USER", "Software\\Test", "Path"});
+
+  EXPECT_EQ(3, registry.GetStringValueReads());
+}
+
+TEST(CachingRegistry, getSubKeysShouldOnlyReadEachKeyOnce) {
+  CountingRegistry registry;
+  registry.SetSubKeys("Software\\Test", {"a", "b"});
+  const CachingRegistry cachingRegistry(registry);
+
+  const std::vector<std::string> expected{"a", "b"};
+  EXPECT_EQ(expected,
+            cachingRegistry.GetSubKeys("HKEY_LOCAL_MACHINE", "Software\\Test"));
+  EXPECT_EQ(expected,
+            cachingRegistry.GetSubKeys("HKEY_LOCAL_MACHINE", "Software\\Test"));
+
+  EXPECT_EQ(1, registry.GetSubKeyReads());
+}
+}
+
+#endif
@@ -421,6 +421,78 @@ TEST_F(Steam_FindGameInstallTest,
 #endif
 }
 
+TEST_F(Steam_FindGameInstallTest,
+       shouldStopReadingTheAcfOnceTheAppIdAndInstallDirHaveBeenFound) {
+  std::ofstream out(filePath_);
+  out << R"test(
+// A comment
+"AppState"
+{
+	"appid"		"489830"
+	"installdir"		"Skyrim Special Edition"
+	"UserConfig"
+	{
+		"language"		"english" [$WIN32]
+		"unterminated
+)test";
+  out.close();
+
+  const auto install = loot::steam::FindGameInstall(filePath_);
+
+  ASSERT_TRUE(install.has_value());
+  EXPECT_EQ(GameId::tes5se, install.value().gameId);
+  EXPECT_EQ(dataPath_.parent_path(), install.value().installPath);
+}
+
+class Steam_FindLibraryGameInstallsTest : public FilesystemTest {
+public:
+  Steam_FindLibraryGameInstallsTest() :
+      steamAppsPath_(rootPath_ / "steamapps"),
+      dataPath_(steamAppsPath_ / "common" / "Skyrim Special Edition" /
+                "Data") {}
+
+protected:
+  void SetUp() override {
+    FilesystemTest::SetUp();
+
+    std::filesystem::create_directories(dataPath_);
+    touch(dataPath_ / "Skyrim.esm");
+    touch(dataPath_.parent_path() / "SkyrimSE.exe");
+  }
+
+  void writeAppManifest(const std::string& appId,
+                        const std::string& installDir) {
+    std::ofstream out(steamAppsPath_ / ("appmanifest_" + appId + ".acf"));
+    out << "\"AppState\"\n{\n\t\"appid\"\t\t\"" << appId
+        << "\"\n\t\"installdir\"\t\t\"" << installDir << "\"\n}\n";
+  }
+
+  const std::filesystem::path steamAppsPath_;
+  const std::filesystem::path dataPath_;
+};
+
+TEST_F(Steam_FindLibraryGameInstallsTest,
+       shouldReturnAnEmptyVectorIfTheLibraryHasNoSteamappsFolder) {
+  const auto installs =
+      loot::steam::FindGameInstalls(rootPath_ / "missing library");
+
+  EXPECT_TRUE(installs.empty());
+}
+
+TEST_F(Steam_FindLibraryGameInstallsTest,
+       shouldReturnInstallsForTheLibrarysSupportedGames) {
+  writeAppManifest("489830", "Skyrim Special Edition");
+  writeAppManifest("736260", "Baba Is You");
+  writeAppManifest("22330", "Oblivion");
+
+  const auto installs = loot::steam::FindGameInstalls(rootPath_);
+
+  ASSERT_EQ(1, installs.size());
+  EXPECT_EQ(GameId::tes5se, installs[0].gameId);
+  EXPECT_EQ(InstallSource::steam, installs[0].source);
+  EXPECT_EQ(dataPath_.parent_path(), installs[0].installPath);
+}
+
 class Steam_FindGameInstallsTest
     : public CommonGameTestFixture,
       public ::testing::WithParamInterface<GameId> {
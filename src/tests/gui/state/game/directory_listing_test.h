@@ -0,0 +1,127 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_GAME_DIRECTORY_LISTING_TEST
+#define LOOT_TESTS_GUI_STATE_GAME_DIRECTORY_LISTING_TEST
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "gui/state/game/directory_listing.h"
+#include "tests/gui/test_helpers.h"
+
+namespace loot {
+namespace test {
+class DirectoryListingTest : public ::testing::Test {
+protected:
+  DirectoryListingTest() : rootPath_(getTempPath()) {}
+
+  void SetUp() override {
+    touch(rootPath_ / "Blank.esm");
+    touch(rootPath_ / "readme.txt");
+    std::filesystem::create_directories(rootPath_ / "Textures");
+  }
+
+  void TearDown() override { std::filesystem::remove_all(rootPath_); }
+
+  std::vector<DirectoryEntry> listSorted(
+      const std::function<bool(const std::string&)>& filter = nullptr) {
+    auto entries = ListDirectory(rootPath_, filter);
+    std::sort(entries.begin(),
+              entries.end(),
+              [](const DirectoryEntry& lhs, const DirectoryEntry& rhs) {
+                return lhs.filename < rhs.filename;
+              });
+    return entries;
+  }
+
+  const std::filesystem::path rootPath_;
+};
+
+TEST_F(DirectoryListingTest, listDirectoryShouldThrowIfTheDirectoryIsMissing) {
+  EXPECT_THROW(ListDirectory(rootPath_ / "missing"),
+               std::filesystem::filesystem_error);
+}
+
+TEST_F(DirectoryListingTest,
+       listDirectoryShouldReturnAllEntriesIfThereIsNoFilter) {
+  const auto entries = listSorted();
+
+  ASSERT_EQ(3, entries.size());
+  EXPECT_EQ("Blank.esm", entries[0].filename);
+  EXPECT_EQ(rootPath_ / "Blank.esm", entries[0].path);
+  EXPECT_EQ("Textures", entries[1].filename);
+  EXPECT_EQ("readme.txt", entries[2].filename);
+}
+
+TEST_F(DirectoryListingTest, listDirectoryShouldSkipEntriesThatAreFilteredOut) {
+  const auto entries = listSorted(
+      [](const std::string& filename) { return filename != "readme.txt"; });
+
+  ASSERT_EQ(2, entries.size());
+  EXPECT_EQ("Blank.esm", entries[0].filename);
+  EXPECT_EQ("Textures", entries[1].filename);
+}
+
+TEST_F(DirectoryListingTest, listDirectoryShouldReadTheTypeOfEachEntry) {
+  const auto entries = listSorted();
+
+  ASSERT_EQ(3, entries.size());
+  EXPECT_TRUE(entries[0].isRegularFile);
+  EXPECT_FALSE(entries[0].isDirectory);
+  EXPECT_FALSE(entries[1].isRegularFile);
+  EXPECT_TRUE(entries[1].isDirectory);
+  EXPECT_FALSE(entries[1].fileSize.has_value());
+  EXPECT_FALSE(entries[1].lastWriteTime.has_value());
+}
+
+TEST_F(DirectoryListingTest,
+       listDirectoryShouldGiveTheSameSizeAndTimeAsStdFilesystem) {
+  const auto path = rootPath_ / "Blank.esm";
+  std::ofstream(path) << "content";
+  std::filesystem::last_write_time(
+      path,
+      std::filesystem::last_write_time(path) - std::chrono::hours(1));
+
+  const auto entries = listSorted();
+
+  ASSERT_EQ(3, entries.size());
+  EXPECT_EQ(std::filesystem::file_size(path), entries[0].fileSize);
+  EXPECT_EQ(std::filesystem::last_write_time(path), entries[0].lastWriteTime);
+}
+
+TEST_F(DirectoryListingTest,
+       listDirectoryFilenamesShouldReturnTheNamesOfAllEntries) {
+  auto filenames = ListDirectoryFilenames(rootPath_);
+  std::sort(filenames.begin(), filenames.end());
+
+  EXPECT_EQ(std::vector<std::string>({"Blank.esm", "Textures", "readme.txt"}),
+            filenames);
+}
+}
+}
+
+#endif
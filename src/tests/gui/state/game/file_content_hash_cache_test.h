@@ -0,0 +1,120 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_GAME_FILE_CONTENT_HASH_CACHE_TEST
+#define LOOT_TESTS_GUI_STATE_GAME_FILE_CONTENT_HASH_CACHE_TEST
+
+#include <gtest/gtest.h>
+
+#include "gui/state/game/file_content_hash_cache.h"
+#include "tests/gui/test_helpers.h"
+
+namespace loot {
+namespace test {
+class FileContentHashCacheTest : public ::testing::Test {
+protected:
+  FileContentHashCacheTest() :
+      rootPath_(getTempPath()), filePath_(rootPath_ / "masterlist.yaml") {}
+
+  void SetUp() override {
+    std::filesystem::create_directories(rootPath_);
+    write(filePath_, "content");
+  }
+
+  void TearDown() override { std::filesystem::remove_all(rootPath_); }
+
+  static void write(const std::filesystem::path& path,
+                    const std::string& content) {
+    std::ofstream out(path, std::ios_base::binary);
+    out << content;
+  }
+
+  const std::filesystem::path rootPath_;
+  const std::filesystem::path filePath_;
+};
+
+TEST_F(FileContentHashCacheTest, getHashShouldReturnNulloptForAMissingFile) {
+  FileContentHashCache cache;
+
+  EXPECT_FALSE(cache.GetHash(rootPath_ / "missing.yaml").has_value());
+  EXPECT_EQ(0, cache.Size());
+}
+
+TEST_F(FileContentHashCacheTest,
+       getHashShouldReturnTheSameHashForFilesWithTheSameContent) {
+  const auto otherPath = rootPath_ / "other.yaml";
+  write(otherPath, "content");
+
+  FileContentHashCache cache;
+
+  const auto hash = cache.GetHash(filePath_);
+  ASSERT_TRUE(hash.has_value());
+  EXPECT_EQ(hash, cache.GetHash(otherPath));
+  EXPECT_EQ(2, cache.Size());
+}
+
+TEST_F(FileContentHashCacheTest,
+       getHashShouldReturnADifferentHashForDifferentContent) {
+  const auto otherPath = rootPath_ / "other.yaml";
+  write(otherPath, "other content");
+
+  FileContentHashCache cache;
+
+  EXPECT_NE(cache.GetHash(filePath_), cache.GetHash(otherPath));
+}
+
+TEST_F(FileContentHashCacheTest,
+       getHashShouldReuseTheHashIfTheFileSizeAndTimeAreUnchanged) {
+  FileContentHashCache cache;
+
+  const auto hash = cache.GetHash(filePath_);
+
+  // Change the content without changing the size or last write time, which
+  // the cache can't detect.
+  const auto lastWriteTime = std::filesystem::last_write_time(filePath_);
+  write(filePath_, "CONTENT");
+  std::filesystem::last_write_time(filePath_, lastWriteTime);
+
+  EXPECT_EQ(hash, cache.GetHash(filePath_));
+}
+
+TEST_F(FileContentHashCacheTest,
+       getHashShouldReadTheFileAgainIfItsLastWriteTimeChanges) {
+  FileContentHashCache cache;
+
+  const auto hash = cache.GetHash(filePath_);
+
+  const auto lastWriteTime = std::filesystem::last_write_time(filePath_);
+  write(filePath_, "CONTENT");
+  std::filesystem::last_write_time(filePath_,
+                                   lastWriteTime + std::chrono::seconds(1));
+
+  EXPECT_NE(hash, cache.GetHash(filePath_));
+  EXPECT_EQ(1, cache.Size());
+}
+}
+}
+
+#endif
@@ -0,0 +1,107 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_GAME_FILE_IO_SCHEDULER_TEST
+#define LOOT_TESTS_GUI_STATE_GAME_FILE_IO_SCHEDULER_TEST
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+#include "gui/state/game/file_io_scheduler.h"
+#include "tests/gui/test_helpers.h"
+
+namespace loot {
+namespace test {
+class FileIoSchedulerTest : public ::testing::Test {
+protected:
+  FileIoSchedulerTest() :
+      rootPath_(getTempPath()),
+      paths_({
+          rootPath_ / "c.esp",
+          rootPath_ / "a.esp",
+          rootPath_ / "b.esp",
+      }) {}
+
+  void SetUp() override {
+    for (const auto& path : paths_) {
+      touch(path);
+    }
+  }
+
+  void TearDown() override { std::filesystem::remove_all(rootPath_); }
+
+  const std::filesystem::path rootPath_;
+  const std::vector<std::filesystem::path> paths_;
+};
+
+TEST_F(FileIoSchedulerTest, getFileIoBatchesShouldReturnNoBatchesForNoPaths) {
+  EXPECT_TRUE(GetFileIoBatches({}).empty());
+}
+
+TEST_F(FileIoSchedulerTest,
+       getFileIoBatchesShouldPutPathsOnTheSameDriveInTheSameBatch) {
+  const auto batches = GetFileIoBatches(paths_);
+
+  ASSERT_EQ(1, batches.size());
+  EXPECT_EQ(3, batches[0].indices.size());
+}
+
+TEST_F(FileIoSchedulerTest,
+       getFileIoBatchesShouldBatchAMissingFileWithOthersInItsDirectory) {
+  auto paths = paths_;
+  paths.push_back(rootPath_ / "missing.esp");
+
+  const auto batches = GetFileIoBatches(paths);
+
+  ASSERT_EQ(1, batches.size());
+  EXPECT_EQ(4, batches[0].indices.size());
+}
+
+TEST_F(FileIoSchedulerTest,
+       getFileIoBatchesShouldSortIndicesByPathIfTheDriveIsRotational) {
+  const auto batches = GetFileIoBatches(paths_);
+
+  ASSERT_EQ(1, batches.size());
+  if (batches[0].isRotational) {
+    EXPECT_EQ(std::vector<size_t>({1, 2, 0}), batches[0].indices);
+  } else {
+    EXPECT_EQ(std::vector<size_t>({0, 1, 2}), batches[0].indices);
+  }
+}
+
+TEST_F(FileIoSchedulerTest, forEachFileIoShouldCallTheFunctionForEachIndex) {
+  std::vector<std::atomic<unsigned int>> callCounts(paths_.size());
+
+  ForEachFileIo(paths_, [&](size_t index) { ++callCounts.at(index); });
+
+  for (const auto& callCount : callCounts) {
+    EXPECT_EQ(1, callCount);
+  }
+}
+}
+}
+
+#endif
@@ -0,0 +1,132 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_GAME_GAME_DATA_SNAPSHOT_TEST
+#define LOOT_TESTS_GUI_STATE_GAME_GAME_DATA_SNAPSHOT_TEST
+
+#include <gtest/gtest.h>
+
+#include <boost/locale.hpp>
+
+#include "gui/state/game/game_data_snapshot.h"
+
+namespace loot {
+namespace test {
+class GameDataSnapshotTest : public ::testing::Test {
+protected:
+  GameDataSnapshotTest() {
+    // Lowercasing plugin names uses boost::locale.
+    boost::locale::generator gen;
+    std::locale::global(gen("en.UTF-8"));
+  }
+
+  static std::shared_ptr<const GameDataSnapshot::Plugin> makePlugin(
+      const std::string& name,
+      const std::optional<PluginMetadata>& masterlistMetadata = std::nullopt,
+      const std::optional<PluginMetadata>& userMetadata = std::nullopt) {
+    auto plugin = std::make_shared<GameDataSnapshot::Plugin>();
+    plugin->name = name;
+    plugin->masterlistMetadata = masterlistMetadata;
+    plugin->userMetadata = userMetadata;
+    return plugin;
+  }
+};
+
+TEST_F(GameDataSnapshotTest, shouldBeEmptyIfDefaultConstructed) {
+  GameDataSnapshot snapshot;
+
+  EXPECT_TRUE(snapshot.GetLoadOrder().empty());
+  EXPECT_EQ(nullptr, snapshot.GetPlugin("Blank.esm"));
+}
+
+TEST_F(GameDataSnapshotTest, getLoadOrderShouldReturnPluginNamesInOrder) {
+  GameDataSnapshot snapshot({makePlugin("Blank.esm"), makePlugin("Blank.esp")});
+
+  EXPECT_EQ(std::vector<std::string>({"Blank.esm", "Blank.esp"}),
+            snapshot.GetLoadOrder());
+}
+
+TEST_F(GameDataSnapshotTest, getPluginShouldBeCaseInsensitive) {
+  GameDataSnapshot snapshot({makePlugin("Blank.esm")});
+
+  const auto plugin = snapshot.GetPlugin("blank.ESM");
+
+  ASSERT_NE(nullptr, plugin);
+  EXPECT_EQ("Blank.esm", plugin->name);
+}
+
+TEST_F(GameDataSnapshotTest,
+       getMergedMetadataShouldReturnNameOnlyMetadataForAnUnknownPlugin) {
+  GameDataSnapshot snapshot;
+
+  const auto metadata = snapshot.GetMergedMetadata("Blank.esm");
+
+  EXPECT_EQ("Blank.esm", metadata.GetName());
+  EXPECT_TRUE(metadata.HasNameOnly());
+}
+
+TEST_F(GameDataSnapshotTest,
+       getMergedMetadataShouldPreferUserMetadataOverMasterlistMetadata) {
+  PluginMetadata masterlistMetadata("Blank.esm");
+  masterlistMetadata.SetGroup("masterlist");
+  PluginMetadata userMetadata("Blank.esm");
+  userMetadata.SetGroup("user");
+  GameDataSnapshot snapshot(
+      {makePlugin("Blank.esm", masterlistMetadata, userMetadata)});
+
+  const auto metadata = snapshot.GetMergedMetadata("Blank.esm");
+
+  EXPECT_EQ("user", metadata.GetGroup());
+}
+
+TEST_F(GameDataSnapshotTest,
+       withUserMetadataShouldOnlyChangeTheGivenPluginInTheCopy) {
+  GameDataSnapshot snapshot({makePlugin("Blank.esm"), makePlugin("Blank.esp")});
+  PluginMetadata userMetadata("Blank.esp");
+  userMetadata.SetGroup("user");
+
+  const auto copy = snapshot.WithUserMetadata("blank.esp", userMetadata);
+
+  EXPECT_FALSE(snapshot.GetPlugin("Blank.esp")->userMetadata.has_value());
+  ASSERT_TRUE(copy->GetPlugin("Blank.esp")->userMetadata.has_value());
+  EXPECT_EQ("user", copy->GetPlugin("Blank.esp")->userMetadata->GetGroup());
+  EXPECT_EQ(snapshot.GetPlugins()[0], copy->GetPlugins()[0]);
+}
+
+TEST_F(GameDataSnapshotTest, withoutUserMetadataShouldRemoveAllUserMetadata) {
+  PluginMetadata userMetadata("Blank.esm");
+  userMetadata.SetGroup("user");
+  GameDataSnapshot snapshot(
+      {makePlugin("Blank.esm", std::nullopt, userMetadata)});
+
+  const auto copy = snapshot.WithoutUserMetadata();
+
+  EXPECT_TRUE(snapshot.GetPlugin("Blank.esm")->userMetadata.has_value());
+  EXPECT_FALSE(copy->GetPlugin("Blank.esm")->userMetadata.has_value());
+}
+}
+}
+
+#endif
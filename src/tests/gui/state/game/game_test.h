@@ -26,7 +26,9 @@ along with LOOT.  If not, see
 #define LOOT_TESTS_GUI_STATE_GAME_GAME_TEST
 
 #include <fstream>
+#include <sstream>
 
+#include "gui/helpers.h"
 #include "gui/state/game/game.h"
 #include "gui/state/game/helpers.h"
 #include "tests/common_game_test_fixture.h"
@@ -39,7 +41,8 @@ class GameTest : public loot::test::CommonGameTestFixture,
                  public testing::WithParamInterface<GameId> {
 protected:
   GameTest() :
-      CommonGameTestFixture(GetParam()),
+      CommonGameTestFixture(GetParam(),
+                            loot::test::FixtureFiles::sharedSnapshot),
       loadOrderToSet_({
           masterFile,
           blankEsm,
@@ -56,10 +59,7 @@ protected:
       detail_(std::vector<MessageContent>({
           MessageContent("detail"),
       })),
-      loadOrderBackupFile0("loadorder.bak.0"),
-      loadOrderBackupFile1("loadorder.bak.1"),
-      loadOrderBackupFile2("loadorder.bak.2"),
-      loadOrderBackupFile3("loadorder.bak.3"),
+      loadOrderJournalFile("loadorder.journal"),
       defaultGameSettings(GameSettings(GetParam(), u8"non\u00C1sciiFolder")
                               .SetMinimumHeaderVersion(0.0f)
                               .SetGamePath(dataPath.parent_path())
@@ -76,6 +76,35 @@ protected:
     return game;
   }
 
+  // Counts the active plugins of the same type that come before the given
+  // plugin in the given load order, to check the game's cached indices
+  // against.
+  static std::optional<short> CountActivePluginsBefore(
+      const Game& game,
+      const PluginInterface& plugin,
+      const std::vector<std::string>& loadOrder) {
+    if (!game.IsPluginActive(plugin.GetName())) {
+      return std::nullopt;
+    }
+
+    short numberOfActivePlugins = 0;
+    for (const auto& otherPluginName : loadOrder) {
+      if (CompareFilenames(plugin.GetName(), otherPluginName) == 0) {
+        return numberOfActivePlugins;
+      }
+
+      const auto otherPlugin = game.GetPlugin(otherPluginName);
+      if (otherPlugin &&
+          plugin.IsLightPlugin() == otherPlugin->IsLightPlugin() &&
+          plugin.IsMediumPlugin() == otherPlugin->IsMediumPlugin() &&
+          game.IsPluginActive(otherPluginName)) {
+        ++numberOfActivePlugins;
+      }
+    }
+
+    return std::nullopt;
+  }
+
   std::optional<std::filesystem::path> GetCCCPath() {
     switch (GetParam()) {
       case GameId::tes5se:
@@ -90,10 +119,7 @@ protected:
   }
 
   std::vector<std::string> loadOrderToSet_;
-  const std::string loadOrderBackupFile0;
-  const std::string loadOrderBackupFile1;
-  const std::string loadOrderBackupFile2;
-  const std::string loadOrderBackupFile3;
+  const std::string loadOrderJournalFile;
 
   const std::vector<MessageContent> detail_;
 
@@ -247,6 +273,28 @@ TEST_P(GameTest, initShouldNotMoveAFileWithTheSamePathAsTheLegacyGameFolder) {
   EXPECT_TRUE(std::filesystem::is_directory(lootGamePath));
 }
 
+TEST_P(GameTest, unloadShouldLeaveTheGameUninitialised) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+  ASSERT_TRUE(game.IsInitialised());
+
+  game.Unload();
+
+  EXPECT_FALSE(game.IsInitialised());
+  EXPECT_FALSE(game.ArePluginsFullyLoaded());
+}
+
+TEST_P(GameTest, initShouldReinitialiseAnUnloadedGame) {
+  Game game = CreateInitialisedGame();
+  game.Unload();
+
+  game.Init();
+  game.LoadAllInstalledPlugins(true);
+
+  EXPECT_TRUE(game.IsInitialised());
+  EXPECT_NE(nullptr, game.GetPlugin(blankEsm));
+}
+
 TEST_P(
     GameTest,
     initShouldCreateTheGamesFolderWhenItDoesNotExistAndMigratingALegacyGameFolder) {
@@ -834,6 +882,8 @@ TEST_P(
     redatePluginsShouldRedatePluginsForSkyrimAndSkyrimSEAndDoNothingForOtherGames) {
   using std::filesystem::u8path;
 
+  detachPluginsFromSnapshot();
+
   Game game = CreateInitialisedGame();
   game.LoadAllInstalledPlugins(true);
 
@@ -868,6 +918,55 @@ TEST_P(
   }
 }
 
+TEST_P(GameTest, getPluginRedatesShouldNotChangeAnyTimestamps) {
+  using std::filesystem::u8path;
+
+  detachPluginsFromSnapshot();
+
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+
+  std::vector<std::pair<std::string, bool>> loadOrder = getInitialLoadOrder();
+
+  auto time = std::filesystem::last_write_time(dataPath / u8path(masterFile));
+  for (size_t i = 1; i < loadOrder.size(); ++i) {
+    auto pluginPath = dataPath / u8path(loadOrder[i].first);
+    if (!std::filesystem::exists(pluginPath))
+      pluginPath += ".ghost";
+
+    std::filesystem::last_write_time(pluginPath,
+                                     time - i * std::chrono::seconds(60));
+  }
+
+  const auto redates = game.GetPluginRedates();
+
+  if (GetParam() == GameId::tes5 || GetParam() == GameId::tes5se) {
+    EXPECT_EQ(loadOrder.size() - 1, redates.size());
+  } else {
+    EXPECT_TRUE(redates.empty());
+  }
+
+  for (size_t i = 1; i < loadOrder.size(); ++i) {
+    auto pluginPath = dataPath / u8path(loadOrder[i].first);
+    if (!std::filesystem::exists(pluginPath))
+      pluginPath += ".ghost";
+
+    EXPECT_EQ(time - i * std::chrono::seconds(60),
+              std::filesystem::last_write_time(pluginPath));
+  }
+}
+
+TEST_P(GameTest,
+       getPluginRedatesShouldReturnNothingIfTimestampsMatchTheLoadOrder) {
+  detachPluginsFromSnapshot();
+
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+  game.RedatePlugins();
+
+  EXPECT_TRUE(game.GetPluginRedates().empty());
+}
+
 TEST_P(GameTest,
        loadCreationClubPluginNamesShouldClearCCPluginSetIfCCCFileDoesNotExist) {
   if (GetParam() != GameId::tes5se && GetParam() != GameId::fo4 &&
@@ -918,6 +1017,61 @@ TEST_P(GameTest,
   EXPECT_TRUE(game.IsCreationClubPlugin(pluginName));
 }
 
+TEST_P(GameTest, isCreationClubPluginShouldBeCaseInsensitive) {
+  if (GetParam() != GameId::tes5se && GetParam() != GameId::fo4 &&
+      GetParam() != GameId::starfield) {
+    return;
+  }
+
+  Game game = CreateInitialisedGame();
+
+  const auto cccPath = GetCCCPath().value();
+  std::ofstream out(cccPath);
+  out << "ccPlugin.esp";
+  out.close();
+
+  game.LoadCreationClubPluginNames();
+
+  EXPECT_TRUE(game.IsCreationClubPlugin("CCPLUGIN.ESP"));
+}
+
+TEST_P(GameTest,
+       loadCreationClubPluginNamesShouldNotReadTheCCCFileAgainIfItIsUnchanged) {
+  if (GetParam() != GameId::tes5se && GetParam() != GameId::fo4 &&
+      GetParam() != GameId::starfield) {
+    return;
+  }
+
+  Game game = CreateInitialisedGame();
+
+  const auto cccPath = GetCCCPath().value();
+  std::ofstream out(cccPath);
+  out << "ccPlugin1.esp";
+  out.close();
+
+  game.LoadCreationClubPluginNames();
+
+  // Change the file's content without changing its size or write time.
+  const auto writeTime = std::filesystem::last_write_time(cccPath);
+  out.open(cccPath);
+  out << "ccPlugin2.esp";
+  out.close();
+  std::filesystem::last_write_time(cccPath, writeTime);
+
+  game.LoadCreationClubPluginNames();
+
+  EXPECT_TRUE(game.IsCreationClubPlugin("ccPlugin1.esp"));
+  EXPECT_FALSE(game.IsCreationClubPlugin("ccPlugin2.esp"));
+
+  std::filesystem::last_write_time(cccPath,
+                                   writeTime + std::chrono::seconds(1));
+
+  game.LoadCreationClubPluginNames();
+
+  EXPECT_FALSE(game.IsCreationClubPlugin("ccPlugin1.esp"));
+  EXPECT_TRUE(game.IsCreationClubPlugin("ccPlugin2.esp"));
+}
+
 TEST_P(
     GameTest,
     loadAllInstalledPluginsWithHeadersOnlyTrueShouldLoadTheHeadersOfAllInstalledPlugins) {
@@ -952,6 +1106,80 @@ TEST_P(
   EXPECT_EQ(blankEsmCrc, plugin->GetCRC().value());
 }
 
+TEST_P(GameTest,
+       loadAllInstalledPluginsShouldNotLoadPluginsIfTheTokenIsCancelled) {
+  Game game = CreateInitialisedGame();
+  CancellationToken token;
+  token.cancel();
+
+  EXPECT_THROW(game.LoadAllInstalledPlugins(true, &token), CancelledError);
+  EXPECT_TRUE(game.GetPlugins().empty());
+}
+
+TEST_P(GameTest,
+       doIndexedRecordsOverlapShouldReturnNulloptBeforeTheIndexIsUpdated) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(false);
+
+  EXPECT_FALSE(game.DoIndexedRecordsOverlap(
+      blankEsm, blankEsmCrc, blankEsm, blankEsmCrc));
+}
+
+TEST_P(GameTest,
+       doIndexedRecordsOverlapShouldMatchPluginsAfterTheIndexIsUpdated) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(false);
+
+  game.UpdateRecordOverlapIndex();
+
+  const auto esm = game.GetPlugin(blankEsm);
+  const auto dependentEsm = game.GetPlugin(blankMasterDependentEsm);
+  const auto differentEsm = game.GetPlugin(blankDifferentEsm);
+
+  EXPECT_EQ(esm->DoRecordsOverlap(*dependentEsm),
+            game.DoIndexedRecordsOverlap(esm->GetName(),
+                                         esm->GetCRC().value(),
+                                         dependentEsm->GetName(),
+                                         dependentEsm->GetCRC().value()));
+  EXPECT_EQ(esm->DoRecordsOverlap(*differentEsm),
+            game.DoIndexedRecordsOverlap(differentEsm->GetName(),
+                                         differentEsm->GetCRC().value(),
+                                         esm->GetName(),
+                                         esm->GetCRC().value()));
+  EXPECT_TRUE(std::filesystem::exists(game.RecordOverlapIndexPath()));
+}
+
+TEST_P(GameTest, addToRecordOverlapIndexShouldOnlyIndexTheGivenPlugin) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(false);
+
+  game.AddToRecordOverlapIndex(blankEsm, {blankEsm});
+
+  EXPECT_EQ(true,
+            game.DoIndexedRecordsOverlap(
+                blankEsm, blankEsmCrc, blankEsm, blankEsmCrc));
+
+  const auto counts = game.GetRecordOverlapCounts();
+  EXPECT_EQ(1, counts.size());
+  EXPECT_EQ(0, counts.at(blankEsm).count);
+  EXPECT_TRUE(std::filesystem::exists(game.RecordOverlapIndexPath()));
+}
+
+TEST_P(GameTest, initShouldLoadASavedRecordOverlapIndex) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(false);
+  game.UpdateRecordOverlapIndex();
+
+  Game otherGame = CreateInitialisedGame();
+
+  EXPECT_EQ(game.DoIndexedRecordsOverlap(
+                blankEsm, blankEsmCrc, blankEsm, blankEsmCrc),
+            otherGame.DoIndexedRecordsOverlap(
+                blankEsm, blankEsmCrc, blankEsm, blankEsmCrc));
+  EXPECT_TRUE(otherGame.DoIndexedRecordsOverlap(
+      blankEsm, blankEsmCrc, blankEsm, blankEsmCrc));
+}
+
 TEST_P(GameTest,
        loadAllInstalledPluginsShouldNotGenerateWarningsForGhostedPlugins) {
   Game game = CreateInitialisedGame();
@@ -987,6 +1215,53 @@ TEST_P(GameTest, loadAllInstalledPluginsShouldLoadPluginsAtExternalPaths) {
   EXPECT_NE(nullptr, plugin);
 }
 
+TEST_P(GameTest, reloadPluginsShouldLoadTheGivenPluginsAndKeepOthersLoaded) {
+  const auto newPluginName = "NewPlugin.esm";
+
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+
+  std::filesystem::copy(dataPath / blankEsm, dataPath / newPluginName);
+
+  EXPECT_TRUE(game.ReloadPlugins({newPluginName}, true));
+
+  EXPECT_NE(nullptr, game.GetPlugin(newPluginName));
+  EXPECT_NE(nullptr, game.GetPlugin(blankEsp));
+}
+
+TEST_P(GameTest,
+       reloadPluginsShouldResolvePluginsAddedAfterDataPathsWereChecked) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+
+  // Check for the plugin before it's added, with a different case to the
+  // file that's added, so that it can only be found using a new snapshot on
+  // case-sensitive filesystems.
+  ASSERT_FALSE(game.FileExists("NewPlugin.esm"));
+
+  std::filesystem::copy(dataPath / blankEsm, dataPath / "newplugin.esm");
+
+  EXPECT_TRUE(game.ReloadPlugins({"NewPlugin.esm"}, true));
+  EXPECT_NE(nullptr, game.GetPlugin("NewPlugin.esm"));
+}
+
+TEST_P(GameTest, reloadPluginsShouldReturnFalseIfAPluginIsNotInstalled) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+
+  EXPECT_FALSE(game.ReloadPlugins({blankEsm, missingEsp}, true));
+}
+
+TEST_P(GameTest, reloadPluginsShouldReturnFalseIfAPluginIsNotValid) {
+  const auto invalidPluginName = "invalid.esp";
+  loot::test::touch(dataPath / invalidPluginName);
+
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+
+  EXPECT_FALSE(game.ReloadPlugins({invalidPluginName}, true));
+}
+
 TEST_P(GameTest, pluginsShouldNotBeFullyLoadedByDefault) {
   Game game = CreateInitialisedGame();
 
@@ -1009,6 +1284,140 @@ TEST_P(GameTest, pluginsShouldBeFullyLoadedAfterFullyLoadingThem) {
   EXPECT_TRUE(game.ArePluginsFullyLoaded());
 }
 
+TEST_P(GameTest, releasePluginRecordDataShouldLeaveOnlyHeadersLoaded) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(false);
+
+  EXPECT_TRUE(game.ReleasePluginRecordData());
+
+  EXPECT_FALSE(game.ArePluginsFullyLoaded());
+  EXPECT_FALSE(game.GetPlugin(blankEsm)->GetCRC());
+  EXPECT_NE(nullptr, game.GetPlugin(blankEsp));
+}
+
+TEST_P(GameTest, releasePluginRecordDataShouldKeepThePluginsCrcsKnown) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(false);
+
+  ASSERT_TRUE(game.ReleasePluginRecordData());
+
+  EXPECT_EQ(blankEsmCrc, game.GetPluginCrc(*game.GetPlugin(blankEsm)));
+}
+
+TEST_P(GameTest, getActivePluginsSnapshotShouldMatchTheLoadOrderState) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+
+  const auto snapshot = game.GetActivePluginsSnapshot();
+
+  for (const auto& pluginName : game.GetLoadOrder()) {
+    EXPECT_EQ(game.IsPluginActive(pluginName), snapshot->IsActive(pluginName))
+        << pluginName;
+  }
+  EXPECT_EQ(snapshot, game.GetActivePluginsSnapshot());
+}
+
+TEST_P(GameTest,
+       loadCurrentLoadOrderStateShouldReloadTheLoadOrderIfItsFilesHaveChanged) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+
+  ASSERT_FALSE(game.IsPluginActive(blankEsp));
+
+  auto loadOrder = getInitialLoadOrder();
+  for (auto& plugin : loadOrder) {
+    if (plugin.first == blankEsp) {
+      plugin.second = true;
+    }
+  }
+  setLoadOrder(loadOrder);
+
+  game.LoadCurrentLoadOrderState();
+
+  EXPECT_TRUE(game.IsPluginActive(blankEsp));
+  EXPECT_TRUE(game.GetActivePluginsSnapshot()->IsActive(blankEsp));
+}
+
+TEST_P(GameTest,
+       loadCurrentLoadOrderStateShouldKeepTheLoadOrderIfItsFilesAreUnchanged) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+
+  const auto loadOrder = game.GetLoadOrder();
+  const auto snapshot = game.GetActivePluginsSnapshot();
+
+  game.LoadCurrentLoadOrderState();
+
+  EXPECT_EQ(loadOrder, game.GetLoadOrder());
+  EXPECT_EQ(snapshot, game.GetActivePluginsSnapshot());
+}
+
+TEST_P(GameTest, getPluginCrcShouldReturnNulloptIfOnlyHeadersHaveBeenLoaded) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+
+  EXPECT_FALSE(game.GetPluginCrc(*game.GetPlugin(blankEsm)));
+}
+
+TEST_P(GameTest,
+       getPluginCrcShouldNotCalculateCrcsNeededByCleaningDataForHeadersOnly) {
+  Game game = CreateInitialisedGame();
+
+  std::ofstream out(game.MasterlistPath());
+  out << "plugins:\n"
+      << "  - name: " << blankEsm << "\n"
+      << "    dirty:\n"
+      << "      - crc: " << blankEsmCrc << "\n"
+      << "        util: TES5Edit\n";
+  out.close();
+
+  game.LoadMetadata();
+  game.LoadAllInstalledPlugins(true);
+
+  EXPECT_FALSE(game.GetPluginCrc(*game.GetPlugin(blankEsm)));
+}
+
+TEST_P(GameTest, getPluginCrcShouldReturnTheCrcOfAFullyLoadedPlugin) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(false);
+
+  EXPECT_EQ(blankEsmCrc, game.GetPluginCrc(*game.GetPlugin(blankEsm)));
+}
+
+TEST_P(GameTest,
+       getPluginCrcShouldReturnTheCachedCrcIfOnlyHeadersHaveBeenLoaded) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(false);
+
+  Game otherGame = CreateInitialisedGame();
+  otherGame.LoadAllInstalledPlugins(true);
+
+  const auto plugin = otherGame.GetPlugin(blankEsm);
+
+  EXPECT_FALSE(plugin->GetCRC());
+  EXPECT_EQ(blankEsmCrc, otherGame.GetPluginCrc(*plugin));
+}
+
+TEST_P(GameTest,
+       getPluginCrcShouldNotReturnACachedCrcIfThePluginHasChangedSince) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(false);
+
+  detachFromSnapshot(dataPath / blankEsm);
+  std::filesystem::copy_file(dataPath / blankDifferentEsm,
+                             dataPath / blankEsm,
+                             std::filesystem::copy_options::overwrite_existing);
+  std::filesystem::last_write_time(
+      dataPath / blankEsm,
+      std::filesystem::last_write_time(dataPath / blankEsm) +
+          std::chrono::seconds(1));
+
+  Game otherGame = CreateInitialisedGame();
+  otherGame.LoadAllInstalledPlugins(true);
+
+  EXPECT_FALSE(otherGame.GetPluginCrc(*otherGame.GetPlugin(blankEsm)));
+}
+
 TEST_P(GameTest,
        supportsLightPluginsShouldReturnTrueForSkyrimVRIfSKSEPluginIsInstalled) {
   Game game = CreateInitialisedGame();
@@ -1037,8 +1446,7 @@ TEST_P(GameTest,
   Game game = CreateInitialisedGame();
   game.LoadAllInstalledPlugins(true);
 
-  auto index = game.GetActiveLoadOrderIndex(*game.GetPlugin(blankEsp),
-                                            game.GetLoadOrder());
+  auto index = game.GetActiveLoadOrderIndex(*game.GetPlugin(blankEsp));
   EXPECT_FALSE(index.has_value());
 }
 
@@ -1048,28 +1456,86 @@ TEST_P(
   Game game = CreateInitialisedGame();
   game.LoadAllInstalledPlugins(true);
 
-  auto index = game.GetActiveLoadOrderIndex(*game.GetPlugin(masterFile),
-                                            game.GetLoadOrder());
+  auto index = game.GetActiveLoadOrderIndex(*game.GetPlugin(masterFile));
   EXPECT_EQ(0, index);
 
-  index = game.GetActiveLoadOrderIndex(*game.GetPlugin(blankEsm),
-                                       game.GetLoadOrder());
+  index = game.GetActiveLoadOrderIndex(*game.GetPlugin(blankEsm));
   EXPECT_EQ(1, index.value());
 
   index = game.GetActiveLoadOrderIndex(
-      *game.GetPlugin(blankDifferentMasterDependentEsp), game.GetLoadOrder());
+      *game.GetPlugin(blankDifferentMasterDependentEsp));
   EXPECT_EQ(2, index.value());
 }
 
-TEST_P(
-    GameTest,
-    GetActiveLoadOrderIndexShouldCaseInsensitivelyCompareNonAsciiPluginNamesCorrectly) {
+TEST_P(GameTest, GetActiveLoadOrderIndexShouldFindNonAsciiPluginNames) {
   Game game = CreateInitialisedGame();
   game.LoadAllInstalledPlugins(true);
 
-  auto index = game.GetActiveLoadOrderIndex(*game.GetPlugin(nonAsciiEsp),
-                                            {u8"non\u00E1scii.esp"});
-  EXPECT_EQ(0, index.value());
+  const auto plugin = game.GetPlugin(nonAsciiEsp);
+  const auto expected =
+      CountActivePluginsBefore(game, *plugin, game.GetLoadOrder());
+  ASSERT_TRUE(expected.has_value());
+
+  EXPECT_EQ(expected, game.GetActiveLoadOrderIndex(*plugin));
+}
+
+TEST_P(GameTest, GetActiveLoadOrderIndexShouldUseTheCurrentLoadOrder) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+
+  const auto loadOrder = game.GetLoadOrder();
+  for (const auto& pluginName : loadOrder) {
+    const auto plugin = game.GetPlugin(pluginName);
+    if (plugin) {
+      EXPECT_EQ(CountActivePluginsBefore(game, *plugin, loadOrder),
+                game.GetActiveLoadOrderIndex(*plugin))
+          << pluginName;
+    }
+  }
+}
+
+TEST_P(GameTest, GetActiveLoadOrderIndexShouldReflectLoadOrderChanges) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+
+  ASSERT_EQ(2,
+            game.GetActiveLoadOrderIndex(
+                *game.GetPlugin(blankDifferentMasterDependentEsp)));
+
+  ASSERT_NO_THROW(game.SetLoadOrder(loadOrderToSet_));
+
+  for (const auto& pluginName : loadOrderToSet_) {
+    const auto plugin = game.GetPlugin(pluginName);
+    if (plugin) {
+      EXPECT_EQ(CountActivePluginsBefore(game, *plugin, loadOrderToSet_),
+                game.GetActiveLoadOrderIndex(*plugin))
+          << pluginName;
+    }
+  }
+}
+
+TEST_P(GameTest, isLoadOrderAmbiguousShouldReflectLoadOrderChanges) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+
+  // Check the load order before setting it so that the result is cached.
+  game.IsLoadOrderAmbiguous();
+
+  ASSERT_NO_THROW(game.SetLoadOrder(game.GetLoadOrder()));
+
+  EXPECT_FALSE(game.IsLoadOrderAmbiguous());
+}
+
+TEST_P(GameTest, getEvaluationStateHashShouldChangeIfAFileIsAdded) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+
+  const auto hash = game.GetEvaluationStateHash();
+  ASSERT_EQ(hash, game.GetEvaluationStateHash());
+
+  loot::test::touch(dataPath / "new.txt");
+
+  EXPECT_NE(hash, game.GetEvaluationStateHash());
 }
 
 TEST_P(GameTest, setLoadOrderWithoutLoadedPluginsShouldIgnoreCurrentState) {
@@ -1078,22 +1544,17 @@ TEST_P(GameTest, setLoadOrderWithoutLoadedPluginsShouldIgnoreCurrentState) {
 
   auto lootGamePath =
       lootDataPath / "games" / u8path(game.GetSettings().FolderName());
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile0));
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile1));
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile2));
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile3));
+  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderJournalFile));
 
   auto initialLoadOrder = getLoadOrder();
   ASSERT_NO_THROW(game.SetLoadOrder(loadOrderToSet_));
 
-  EXPECT_TRUE(std::filesystem::exists(lootGamePath / loadOrderBackupFile0));
-  EXPECT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile1));
-  EXPECT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile2));
-  EXPECT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile3));
+  EXPECT_TRUE(std::filesystem::exists(lootGamePath / loadOrderJournalFile));
 
-  auto loadOrder = readFileLines(lootGamePath / loadOrderBackupFile0);
+  auto journal = ReadLoadOrderJournal(lootGamePath);
 
-  EXPECT_TRUE(loadOrder.empty());
+  ASSERT_EQ(1, journal.size());
+  EXPECT_TRUE(journal[0].loadOrder.empty());
 }
 
 TEST_P(GameTest, setLoadOrderShouldCreateABackupOfTheCurrentLoadOrder) {
@@ -1103,35 +1564,28 @@ TEST_P(GameTest, setLoadOrderShouldCreateABackupOfTheCurrentLoadOrder) {
 
   auto lootGamePath =
       lootDataPath / "games" / u8path(game.GetSettings().FolderName());
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile0));
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile1));
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile2));
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile3));
+  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderJournalFile));
 
   auto initialLoadOrder = getLoadOrder();
   ASSERT_NO_THROW(game.SetLoadOrder(loadOrderToSet_));
 
-  EXPECT_TRUE(std::filesystem::exists(lootGamePath / loadOrderBackupFile0));
-  EXPECT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile1));
-  EXPECT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile2));
-  EXPECT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile3));
+  EXPECT_TRUE(std::filesystem::exists(lootGamePath / loadOrderJournalFile));
 
-  auto loadOrder = readFileLines(lootGamePath / loadOrderBackupFile0);
+  auto journal = ReadLoadOrderJournal(lootGamePath);
 
-  EXPECT_EQ(initialLoadOrder, loadOrder);
+  ASSERT_EQ(1, journal.size());
+  EXPECT_EQ(initialLoadOrder, journal[0].loadOrder);
+  EXPECT_LT(0, journal[0].timestamp);
 }
 
-TEST_P(GameTest, setLoadOrderShouldRollOverExistingBackups) {
+TEST_P(GameTest, setLoadOrderShouldAppendToExistingBackups) {
   using std::filesystem::u8path;
   Game game = CreateInitialisedGame();
   game.LoadAllInstalledPlugins(true);
 
   auto lootGamePath =
       lootDataPath / "games" / u8path(game.GetSettings().FolderName());
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile0));
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile1));
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile2));
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile3));
+  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderJournalFile));
 
   auto initialLoadOrder = getLoadOrder();
   ASSERT_NO_THROW(game.SetLoadOrder(loadOrderToSet_));
@@ -1145,33 +1599,25 @@ TEST_P(GameTest, setLoadOrderShouldRollOverExistingBackups) {
 
   ASSERT_NO_THROW(game.SetLoadOrder(loadOrderToSet_));
 
-  EXPECT_TRUE(std::filesystem::exists(lootGamePath / loadOrderBackupFile0));
-  EXPECT_TRUE(std::filesystem::exists(lootGamePath / loadOrderBackupFile1));
-  EXPECT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile2));
-  EXPECT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile3));
+  auto journal = ReadLoadOrderJournal(lootGamePath);
 
-  auto loadOrder = readFileLines(lootGamePath / loadOrderBackupFile0);
-  EXPECT_EQ(firstSetLoadOrder, loadOrder);
-
-  loadOrder = readFileLines(lootGamePath / loadOrderBackupFile1);
-  EXPECT_EQ(initialLoadOrder, loadOrder);
+  ASSERT_EQ(2, journal.size());
+  EXPECT_EQ(initialLoadOrder, journal[0].loadOrder);
+  EXPECT_EQ(firstSetLoadOrder, journal[1].loadOrder);
 }
 
-TEST_P(GameTest, setLoadOrderShouldKeepUpToThreeBackups) {
+TEST_P(GameTest, setLoadOrderShouldOnlyStoreTheChangedPartOfTheLoadOrder) {
   using std::filesystem::u8path;
   Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
 
   auto lootGamePath =
       lootDataPath / "games" / u8path(game.GetSettings().FolderName());
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile0));
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile1));
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile2));
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile3));
 
-  auto initialLoadOrder = getLoadOrder();
+  // The first backup records the whole initial load order.
   ASSERT_NO_THROW(game.SetLoadOrder(loadOrderToSet_));
-
-  auto firstSetLoadOrder = loadOrderToSet_;
+  const auto sizeAfterFirstBackup =
+      std::filesystem::file_size(lootGamePath / loadOrderJournalFile);
 
   ASSERT_NE(blankPluginDependentEsp, loadOrderToSet_[9]);
   ASSERT_NE(blankDifferentMasterDependentEsp, loadOrderToSet_[10]);
@@ -1179,38 +1625,16 @@ TEST_P(GameTest, setLoadOrderShouldKeepUpToThreeBackups) {
   loadOrderToSet_[10] = blankDifferentMasterDependentEsp;
 
   ASSERT_NO_THROW(game.SetLoadOrder(loadOrderToSet_));
+  const auto sizeAfterSecondBackup =
+      std::filesystem::file_size(lootGamePath / loadOrderJournalFile);
 
-  auto secondSetLoadOrder = loadOrderToSet_;
-
-  ASSERT_NE(blankMasterDependentEsp, loadOrderToSet_[7]);
-  ASSERT_NE(blankEsp, loadOrderToSet_[8]);
-  loadOrderToSet_[7] = blankMasterDependentEsp;
-  loadOrderToSet_[8] = blankEsp;
-
+  // The third backup only differs from the second by two plugins.
   ASSERT_NO_THROW(game.SetLoadOrder(loadOrderToSet_));
+  const auto sizeAfterThirdBackup =
+      std::filesystem::file_size(lootGamePath / loadOrderJournalFile);
 
-  auto thirdSetLoadOrder = loadOrderToSet_;
-
-  ASSERT_NE(blankDifferentEsm, loadOrderToSet_[2]);
-  ASSERT_NE(blankMasterDependentEsm, loadOrderToSet_[3]);
-  loadOrderToSet_[2] = blankDifferentEsm;
-  loadOrderToSet_[3] = blankMasterDependentEsm;
-
-  ASSERT_NO_THROW(game.SetLoadOrder(loadOrderToSet_));
-
-  EXPECT_TRUE(std::filesystem::exists(lootGamePath / loadOrderBackupFile0));
-  EXPECT_TRUE(std::filesystem::exists(lootGamePath / loadOrderBackupFile1));
-  EXPECT_TRUE(std::filesystem::exists(lootGamePath / loadOrderBackupFile2));
-  EXPECT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile3));
-
-  auto loadOrder = readFileLines(lootGamePath / loadOrderBackupFile0);
-  EXPECT_EQ(thirdSetLoadOrder, loadOrder);
-
-  loadOrder = readFileLines(lootGamePath / loadOrderBackupFile1);
-  EXPECT_EQ(secondSetLoadOrder, loadOrder);
-
-  loadOrder = readFileLines(lootGamePath / loadOrderBackupFile2);
-  EXPECT_EQ(firstSetLoadOrder, loadOrder);
+  EXPECT_LT(sizeAfterThirdBackup - sizeAfterSecondBackup,
+            sizeAfterFirstBackup);
 }
 
 TEST_P(GameTest, aMessageShouldBeCachedByDefault) {
@@ -1256,6 +1680,209 @@ TEST_P(GameTest, sortPluginsShouldSupportPluginsAtExternalPaths) {
             loadOrder);
 }
 
+TEST_P(GameTest, reloadMetadataShouldReturnThePluginsWhoseMetadataChanged) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+  game.LoadMetadata();
+
+  std::ofstream out(game.MasterlistPath());
+  out << "plugins:\n"
+      << "  - name: " << blankEsp << "\n"
+      << "    msg:\n"
+      << "      - type: say\n"
+      << "        content: 'test message'\n";
+  out.close();
+
+  const auto changedPluginNames = game.ReloadMetadata();
+
+  ASSERT_TRUE(changedPluginNames.has_value());
+  EXPECT_EQ(std::unordered_set<std::string>({blankEsp}),
+            changedPluginNames.value());
+}
+
+TEST_P(GameTest, reloadMetadataShouldReturnNulloptIfTheGroupsChanged) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+  game.LoadMetadata();
+
+  std::ofstream out(game.MasterlistPath());
+  out << "groups:\n"
+      << "  - name: group1\n";
+  out.close();
+
+  EXPECT_FALSE(game.ReloadMetadata().has_value());
+}
+
+TEST_P(GameTest, loadMetadataShouldReloadTheListsIfTheyHaveChanged) {
+  Game game = CreateInitialisedGame();
+  game.LoadMetadata();
+
+  ASSERT_FALSE(game.GetMasterlistMetadata(blankEsp).has_value());
+
+  std::ofstream out(game.MasterlistPath());
+  out << "plugins:\n"
+      << "  - name: " << blankEsp << "\n"
+      << "    group: group1\n"
+      << "groups:\n"
+      << "  - name: group1\n";
+  out.close();
+
+  game.LoadMetadata();
+
+  EXPECT_TRUE(game.GetMasterlistMetadata(blankEsp).has_value());
+}
+
+TEST_P(GameTest,
+       loadMetadataShouldDiscardUnsavedUserMetadataIfTheListsAreUnchanged) {
+  Game game = CreateInitialisedGame();
+  game.LoadMetadata();
+
+  PluginMetadata metadata(blankEsp);
+  metadata.SetGroup("group1");
+  game.AddUserMetadata(metadata);
+
+  game.LoadMetadata();
+
+  EXPECT_FALSE(game.GetUserMetadata(blankEsp).has_value());
+}
+
+TEST_P(GameTest, getPreSortLoadOrderShouldBeNullBeforeSorting) {
+  Game game = CreateInitialisedGame();
+
+  EXPECT_EQ(nullptr, game.GetPreSortLoadOrder());
+}
+
+TEST_P(GameTest, sortPluginsShouldRecordTheLoadOrderThatItStartedFrom) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+
+  const auto loadOrder = game.GetLoadOrder();
+  game.SortPlugins();
+
+  Game::LoadOrderIndices expected;
+  for (const auto& pluginName : loadOrder) {
+    const auto plugin = game.GetPlugin(pluginName);
+    if (plugin) {
+      expected.emplace_back(plugin->GetName(),
+                            CountActivePluginsBefore(game, *plugin, loadOrder));
+    }
+  }
+
+  const auto preSortLoadOrder = game.GetPreSortLoadOrder();
+  ASSERT_NE(nullptr, preSortLoadOrder);
+  EXPECT_EQ(expected, *preSortLoadOrder);
+}
+
+TEST_P(GameTest, sortPluginsShouldSaveTheSortResult) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+
+  const auto loadOrder = game.SortPlugins();
+
+  const auto cachedResult = LoadCachedSortResult(game.SortResultCachePath());
+
+  ASSERT_TRUE(cachedResult.has_value());
+  EXPECT_EQ(loadOrder, cachedResult.value().sortedPlugins);
+}
+
+TEST_P(GameTest,
+       sortPluginsShouldReuseTheLastSortResultIfTheInputsAreUnchanged) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+  game.SortPlugins();
+
+  auto cachedResult = LoadCachedSortResult(game.SortResultCachePath()).value();
+  cachedResult.sortedPlugins = {blankEsm};
+  SaveCachedSortResult(game.SortResultCachePath(), cachedResult);
+
+  game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+
+  EXPECT_EQ(std::vector<std::string>({blankEsm}), game.SortPlugins());
+  EXPECT_TRUE(game.GetPlugin(blankEsm)->GetCRC().has_value());
+}
+
+TEST_P(GameTest,
+       sortPluginsShouldNotReuseTheLastSortResultIfAPluginHasChanged) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+  const auto loadOrder = game.SortPlugins();
+
+  auto cachedResult = LoadCachedSortResult(game.SortResultCachePath()).value();
+  cachedResult.sortedPlugins = {blankEsm};
+  SaveCachedSortResult(game.SortResultCachePath(), cachedResult);
+
+  const auto pluginPath = dataPath / blankEsp;
+  std::filesystem::last_write_time(
+      pluginPath,
+      std::filesystem::last_write_time(pluginPath) + std::chrono::hours(1));
+
+  game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+
+  EXPECT_EQ(loadOrder, game.SortPlugins());
+}
+
+TEST_P(GameTest,
+       sortPluginsShouldNotReuseTheLastSortResultIfAConditionSubdirChanged) {
+  Game game = CreateInitialisedGame();
+
+  std::ofstream out(game.MasterlistPath());
+  out << "plugins:\n"
+      << "  - name: " << blankEsp << "\n"
+      << "    after:\n"
+      << "      - name: " << blankEsm << "\n"
+      << "        condition: 'file(\"textures/sub/test.dds\")'\n";
+  out.close();
+
+  // Adding a file changes its directory's last write time, which is hashed
+  // as part of its parent directory's listing, so nest the file deeper than
+  // that.
+  std::filesystem::create_directories(dataPath / "textures" / "sub");
+
+  game.LoadAllInstalledPlugins(true);
+  game.SortPlugins();
+
+  auto cachedResult = LoadCachedSortResult(game.SortResultCachePath()).value();
+  cachedResult.sortedPlugins = {blankEsm};
+  SaveCachedSortResult(game.SortResultCachePath(), cachedResult);
+
+  std::ofstream(dataPath / "textures" / "sub" / "test.dds").close();
+
+  game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+
+  EXPECT_NE(std::vector<std::string>({blankEsm}), game.SortPlugins());
+}
+
+TEST_P(GameTest, precomputeSortResultShouldSaveTheSortResult) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+  game.PrecomputeSortResult();
+
+  const auto cachedResult = LoadCachedSortResult(game.SortResultCachePath());
+
+  ASSERT_TRUE(cachedResult.has_value());
+
+  const auto loadOrder = game.SortPlugins();
+
+  EXPECT_EQ(cachedResult.value().sortedPlugins, loadOrder);
+  EXPECT_TRUE(game.GetPlugin(blankEsm)->GetCRC().has_value());
+}
+
+TEST_P(GameTest, precomputeSortResultShouldNotChangeTheGameState) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+  const auto messages =
+      game.GetMessages(MessageContent::DEFAULT_LANGUAGE, false);
+
+  game.PrecomputeSortResult();
+
+  EXPECT_FALSE(game.GetPlugin(blankEsm)->GetCRC().has_value());
+  EXPECT_EQ(messages,
+            game.GetMessages(MessageContent::DEFAULT_LANGUAGE, false));
+}
+
 TEST_P(GameTest,
        incrementLoadOrderSortCountShouldSupressTheDefaultCachedMessage) {
   Game game = CreateInitialisedGame();
@@ -1316,9 +1943,10 @@ TEST_P(GameTest,
   EXPECT_EQ("You have not sorted your load order this session\\.",
             messages[0].text);
   EXPECT_TRUE(boost::contains(
-      messages[1].text, "is installed in a case\\-sensitive location\\."));
+      messages[1].text.str(),
+      "is installed in a case\\-sensitive location\\."));
   EXPECT_TRUE(boost::contains(
-      messages[2].text,
+      messages[2].text.str(),
       "local application data is stored in a case\\-sensitive location\\."));
 }
 
@@ -1370,6 +1998,124 @@ TEST_P(GameTest, clearingMessagesShouldRemoveAllAppendedMessages) {
   EXPECT_EQ(previousSize - messages.size(),
             game.GetMessages(MessageContent::DEFAULT_LANGUAGE, false).size());
 }
+
+TEST_P(GameTest,
+       writeMetadataAsYamlShouldWriteAnEmptyListIfNoPluginsHaveMetadata) {
+  Game game = CreateInitialisedGame();
+
+  std::ostringstream out;
+  WriteMetadataAsYaml(game, {blankEsm, blankEsp}, out);
+
+  EXPECT_EQ("plugins: []\n", out.str());
+}
+
+TEST_P(GameTest, writeMetadataAsYamlShouldOnlyWritePluginsThatHaveMetadata) {
+  Game game = CreateInitialisedGame();
+
+  PluginMetadata metadata(blankEsp);
+  metadata.SetGroup("group1");
+  game.AddUserMetadata(metadata);
+
+  std::ostringstream out;
+  WriteMetadataAsYaml(game, {blankEsm, blankEsp}, out);
+
+  const auto yaml = out.str();
+  EXPECT_EQ(0, yaml.find("plugins:\n  - name: "));
+  EXPECT_EQ(std::string::npos, yaml.find(blankEsm));
+  EXPECT_NE(std::string::npos, yaml.find(blankEsp));
+  EXPECT_NE(std::string::npos, yaml.find("\n    group: "));
+}
+
+TEST_P(GameTest, getDataSnapshotShouldBeEmptyUntilOneIsPublished) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+
+  EXPECT_TRUE(game.GetDataSnapshot()->GetLoadOrder().empty());
+
+  game.PublishDataSnapshot();
+
+  EXPECT_EQ(game.GetLoadOrder(), game.GetDataSnapshot()->GetLoadOrder());
+}
+
+TEST_P(GameTest, publishedDataSnapshotShouldNotChangeWhenTheGameChanges) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+  game.PublishDataSnapshot();
+
+  const auto snapshot = game.GetDataSnapshot();
+  const auto loadOrder = snapshot->GetLoadOrder();
+
+  game.Unload();
+
+  EXPECT_EQ(loadOrder, snapshot->GetLoadOrder());
+  EXPECT_TRUE(game.GetDataSnapshot()->GetLoadOrder().empty());
+}
+
+TEST_P(GameTest, addingUserMetadataShouldUpdateThePublishedDataSnapshot) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+  game.PublishDataSnapshot();
+
+  PluginMetadata metadata(blankEsp);
+  metadata.SetGroup("group1");
+  game.AddUserMetadata(metadata);
+
+  const auto snapshot = game.GetDataSnapshot();
+  ASSERT_NE(nullptr, snapshot->GetPlugin(blankEsp));
+  EXPECT_EQ("group1", snapshot->GetMergedMetadata(blankEsp).GetGroup());
+
+  game.ClearAllUserMetadata();
+
+  EXPECT_FALSE(
+      game.GetDataSnapshot()->GetPlugin(blankEsp)->userMetadata.has_value());
+}
+
+TEST_P(GameTest, writeMetadataAsYamlShouldBeAbleToReadFromASnapshot) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(true);
+  game.PublishDataSnapshot();
+
+  PluginMetadata metadata(blankEsp);
+  metadata.SetGroup("group1");
+  game.AddUserMetadata(metadata);
+
+  std::ostringstream out;
+  WriteMetadataAsYaml(*game.GetDataSnapshot(), {blankEsm, blankEsp}, out);
+
+  const auto yaml = out.str();
+  EXPECT_EQ(std::string::npos, yaml.find(blankEsm));
+  EXPECT_NE(std::string::npos, yaml.find(blankEsp));
+}
+
+TEST_P(GameTest, getPluginDependentsIndexShouldListPluginsThatHaveAMaster) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(false);
+
+  const auto dependents =
+      game.GetPluginDependentsIndex()->GetDependents("BLANK.ESM");
+
+  EXPECT_NE(dependents.end(),
+            std::find(dependents.begin(),
+                      dependents.end(),
+                      blankMasterDependentEsp));
+  EXPECT_EQ(dependents.end(),
+            std::find(dependents.begin(), dependents.end(), blankEsp));
+}
+
+TEST_P(GameTest,
+       getPluginDependentsIndexShouldBeRebuiltWhenUserMetadataIsAdded) {
+  Game game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(false);
+  ASSERT_TRUE(
+      game.GetPluginDependentsIndex()->GetDependents(missingEsp).empty());
+
+  PluginMetadata metadata(blankEsm);
+  metadata.SetRequirements({File(missingEsp)});
+  game.AddUserMetadata(metadata);
+
+  EXPECT_EQ(std::vector<std::string>{blankEsm},
+            game.GetPluginDependentsIndex()->GetDependents(missingEsp));
+}
 }
 }
 }
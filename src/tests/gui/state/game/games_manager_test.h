@@ -280,6 +280,113 @@ TEST(GamesManager, setCurrentGameShouldNotInitialiseGameData) {
   EXPECT_EQ(0, manager.GetInitialiseCount(TEST_GAMES_SETTINGS[1].FolderName()));
 }
 
+TEST(GamesManager,
+     retainCurrentGameShouldNotMakeAnUninitialisedGameResident) {
+  TestGamesManager manager;
+  manager.LoadInstalledGames(
+      TEST_GAMES_SETTINGS, std::filesystem::path(), std::filesystem::path());
+
+  manager.SetCurrentGame(TEST_GAMES_SETTINGS[1].FolderName());
+  manager.RetainCurrentGame({}, "en", 1);
+
+  manager.SetCurrentGame(TEST_GAMES_SETTINGS[2].FolderName());
+  manager.SetCurrentGame(TEST_GAMES_SETTINGS[1].FolderName());
+
+  EXPECT_FALSE(manager.TakeResidentPluginItems("en").has_value());
+}
+
+TEST(GamesManager,
+     takeResidentPluginItemsShouldReturnNulloptIfTheGameIsNotResident) {
+  TestGamesManager manager;
+  manager.LoadInstalledGames(
+      TEST_GAMES_SETTINGS, std::filesystem::path(), std::filesystem::path());
+
+  manager.SetCurrentGame(TEST_GAMES_SETTINGS[1].FolderName());
+
+  EXPECT_FALSE(manager.TakeResidentPluginItems("en").has_value());
+}
+
+TEST(GamesManager,
+     beginPreloadingGameShouldReturnNulloptIfTheGameIsNotInstalled) {
+  TestGamesManager manager;
+  manager.LoadInstalledGames(
+      TEST_GAMES_SETTINGS, std::filesystem::path(), std::filesystem::path());
+
+  EXPECT_FALSE(manager.BeginPreloadingGame(TEST_GAMES_SETTINGS[0].FolderName())
+                   .has_value());
+}
+
+TEST(GamesManager, beginPreloadingGameShouldReturnNulloptIfTheGameIsCurrent) {
+  TestGamesManager manager;
+  manager.LoadInstalledGames(
+      TEST_GAMES_SETTINGS, std::filesystem::path(), std::filesystem::path());
+
+  manager.SetCurrentGame(TEST_GAMES_SETTINGS[1].FolderName());
+
+  EXPECT_FALSE(manager.BeginPreloadingGame(TEST_GAMES_SETTINGS[1].FolderName())
+                   .has_value());
+}
+
+TEST(GamesManager,
+     beginPreloadingGameShouldReturnACopyOfAnInstalledGameThatIsNotCurrent) {
+  TestGamesManager manager;
+  manager.LoadInstalledGames(
+      TEST_GAMES_SETTINGS, std::filesystem::path(), std::filesystem::path());
+
+  manager.SetCurrentGame(TEST_GAMES_SETTINGS[1].FolderName());
+
+  const auto game =
+      manager.BeginPreloadingGame(TEST_GAMES_SETTINGS[2].FolderName());
+
+  ASSERT_TRUE(game.has_value());
+  EXPECT_EQ(TEST_GAMES_SETTINGS[2].FolderName(),
+            game->GetSettings().FolderName());
+  EXPECT_FALSE(game->IsInitialised());
+}
+
+TEST(GamesManager,
+     beginPreloadingGameShouldReturnNulloptIfTheGameIsAlreadyBeingPreloaded) {
+  TestGamesManager manager;
+  manager.LoadInstalledGames(
+      TEST_GAMES_SETTINGS, std::filesystem::path(), std::filesystem::path());
+
+  const auto folderName = TEST_GAMES_SETTINGS[2].FolderName();
+  ASSERT_TRUE(manager.BeginPreloadingGame(folderName).has_value());
+
+  EXPECT_FALSE(manager.BeginPreloadingGame(folderName).has_value());
+
+  manager.EndPreloadingGame(folderName);
+
+  EXPECT_TRUE(manager.BeginPreloadingGame(folderName).has_value());
+}
+
+TEST(GamesManager,
+     loadInstalledGamesShouldNotWaitForAGameThatIsBeingPreloaded) {
+  TestGamesManager manager;
+  manager.LoadInstalledGames(
+      TEST_GAMES_SETTINGS, std::filesystem::path(), std::filesystem::path());
+
+  const auto folderName = TEST_GAMES_SETTINGS[2].FolderName();
+  ASSERT_TRUE(manager.BeginPreloadingGame(folderName).has_value());
+
+  manager.LoadInstalledGames(
+      TEST_GAMES_SETTINGS, std::filesystem::path(), std::filesystem::path());
+
+  EXPECT_TRUE(manager.IsGameInstalled(folderName));
+}
+
+TEST(GamesManager,
+     waitForPreloadingGameShouldNotWaitIfTheGameIsNotBeingPreloaded) {
+  TestGamesManager manager;
+  manager.LoadInstalledGames(
+      TEST_GAMES_SETTINGS, std::filesystem::path(), std::filesystem::path());
+
+  ASSERT_TRUE(manager.BeginPreloadingGame(TEST_GAMES_SETTINGS[2].FolderName())
+                  .has_value());
+
+  manager.WaitForPreloadingGame(TEST_GAMES_SETTINGS[1].FolderName());
+}
+
 TEST(GamesManager,
      getFirstInstalledGameFolderNameShouldReturnNulloptIfNoGamesAreInstalled) {
   TestGamesManager manager;
@@ -0,0 +1,112 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_GAME_GROUP_GRAPH_TEST
+#define LOOT_TESTS_GUI_STATE_GAME_GROUP_GRAPH_TEST
+
+#include <gtest/gtest.h>
+
+#include "gui/state/game/group_graph.h"
+
+namespace loot {
+namespace test {
+TEST(GroupGraph, shouldBeEmptyIfDefaultConstructed) {
+  GroupGraph graph;
+
+  EXPECT_TRUE(graph.GetGroups().empty());
+  EXPECT_TRUE(graph.GetGroupNames().empty());
+  EXPECT_FALSE(graph.GetGroupId("default").has_value());
+  EXPECT_FALSE(graph.IsDefined("default"));
+  EXPECT_TRUE(graph.GetGroupsLoadingAfter("default").empty());
+}
+
+TEST(GroupGraph, getGroupsShouldReturnTheMasterlistGroupsThenTheUserGroups) {
+  GroupGraph graph({Group("default"), Group("a", {"default"})},
+                   {Group("b", {"a"})});
+
+  ASSERT_EQ(3, graph.GetGroups().size());
+  EXPECT_EQ("default", graph.GetGroups().at(0).GetName());
+  EXPECT_EQ("a", graph.GetGroups().at(1).GetName());
+  EXPECT_EQ("b", graph.GetGroups().at(2).GetName());
+
+  EXPECT_EQ(2, graph.GetMasterlistGroups().size());
+  EXPECT_EQ(1, graph.GetUserGroups().size());
+}
+
+TEST(GroupGraph, getGroupNamesShouldReturnSortedUniqueDefinedGroupNames) {
+  GroupGraph graph({Group("default"), Group("b", {"default"})},
+                   {Group("b", {"c"}), Group("a")});
+
+  EXPECT_EQ(std::vector<std::string>({"a", "b", "default"}),
+            graph.GetGroupNames());
+}
+
+TEST(GroupGraph, isDefinedShouldBeFalseForGroupsThatAreOnlyLoadedAfter) {
+  GroupGraph graph({Group("a", {"b"})}, {});
+
+  EXPECT_TRUE(graph.IsDefined("a"));
+  EXPECT_FALSE(graph.IsDefined("b"));
+  EXPECT_TRUE(graph.GetGroupId("b").has_value());
+}
+
+TEST(GroupGraph, getAfterGroupIdsShouldCombineAfterGroupsOfSameNamedGroups) {
+  GroupGraph graph({Group("default"), Group("a"), Group("b", {"default"})},
+                   {Group("b", {"a", "default"})});
+
+  const auto groupId = graph.GetGroupId("b");
+  ASSERT_TRUE(groupId.has_value());
+
+  std::vector<std::string> afterGroupNames;
+  for (const auto afterGroupId : graph.GetAfterGroupIds(groupId.value())) {
+    afterGroupNames.push_back(graph.GetGroupName(afterGroupId));
+  }
+
+  EXPECT_EQ(std::vector<std::string>({"default", "a"}), afterGroupNames);
+}
+
+TEST(GroupGraph, getGroupsLoadingAfterShouldIncludeIndirectlyLaterGroups) {
+  GroupGraph graph({Group("default"),
+                    Group("a", {"default"}),
+                    Group("b", {"a"}),
+                    Group("c", {"default"})},
+                   {Group("d", {"b"})});
+
+  EXPECT_EQ(std::set<std::string>({"a", "b", "c", "d"}),
+            graph.GetGroupsLoadingAfter("default"));
+  EXPECT_EQ(std::set<std::string>({"b", "d"}),
+            graph.GetGroupsLoadingAfter("a"));
+  EXPECT_TRUE(graph.GetGroupsLoadingAfter("d").empty());
+}
+
+TEST(GroupGraph, getGroupsLoadingAfterShouldNotLoopForeverIfThereIsACycle) {
+  GroupGraph graph({Group("a", {"b"})}, {Group("b", {"a"})});
+
+  EXPECT_EQ(std::set<std::string>({"a", "b"}),
+            graph.GetGroupsLoadingAfter("a"));
+}
+}
+}
+
+#endif
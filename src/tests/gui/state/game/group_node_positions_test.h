@@ -78,6 +78,10 @@ class LoadGroupNodePositionsTest : public GroupNodePositionsFixture {};
 
 class SaveGroupNodePositionsTest : public GroupNodePositionsFixture {};
 
+class LoadGroupLayoutsTest : public GroupNodePositionsFixture {};
+
+class SaveGroupLayoutsTest : public GroupNodePositionsFixture {};
+
 TEST_F(LoadGroupNodePositionsTest,
        shouldReturnAnEmptyVectorIfFileDoesNotExist) {
   const auto positions = LoadGroupNodePositions(rootPath_ / "missing.bin");
@@ -151,6 +155,32 @@ TEST_F(LoadGroupNodePositionsTest, shouldAcceptDataWrittenBySave) {
   EXPECT_EQ(originalPositions[1].y, positions[1].y);
 }
 
+TEST_F(LoadGroupNodePositionsTest, shouldSkipTheGraphHashInFormatVersionTwo) {
+  const auto path = rootPath_ / "positions.bin";
+
+  writeBytes(path,
+             {'\x4C', '\x47', '\x4E', '\x50', '\x2', '\x1', '\x2', '\x3',
+              '\x4', '\x5', '\x6', '\x7', '\x8', '\x1', '\x0', 'a',
+              '\x0', '\x0', '\x0', '\x0', '\x0', '\x0', '\x0', '\x0',
+              '\x0', '\x0', '\x0', '\x0', '\x0', '\x0', '\x0', '\x0'});
+
+  const auto positions = LoadGroupNodePositions(path);
+
+  ASSERT_EQ(1, positions.size());
+
+  EXPECT_EQ("a", positions[0].groupName);
+  EXPECT_EQ(0.0, positions[0].x);
+  EXPECT_EQ(0.0, positions[0].y);
+}
+
+TEST_F(LoadGroupNodePositionsTest, shouldThrowIfFileHoldsCachedLayouts) {
+  const auto path = rootPath_ / "positions.bin";
+
+  SaveGroupLayouts(path, {GroupLayout{0x1234, {}}});
+
+  EXPECT_THROW(LoadGroupNodePositions(path), std::runtime_error);
+}
+
 TEST_F(SaveGroupNodePositionsTest, shouldThrowIfFileCannotBeOpened) {
   const auto path = rootPath_ / "missing.dir";
 
@@ -208,6 +238,113 @@ TEST_F(SaveGroupNodePositionsTest, shouldWriteNamesPrefixedWithTheirLengths) {
   EXPECT_EQ(-3.0, *reinterpret_cast<const double*>(&bytes[35]));
   EXPECT_EQ(-4.5, *reinterpret_cast<const double*>(&bytes[43]));
 }
+
+TEST_F(LoadGroupLayoutsTest, shouldReturnAnEmptyVectorIfFileDoesNotExist) {
+  const auto layouts = LoadGroupLayouts(rootPath_ / "missing.bin");
+
+  EXPECT_TRUE(layouts.empty());
+}
+
+TEST_F(LoadGroupLayoutsTest, shouldReturnAnEmptyVectorIfFileHasNoGraphHash) {
+  const auto path = rootPath_ / "positions.bin";
+
+  SaveGroupNodePositions(path, {GroupNodePosition{"default", 1.1, 2.2}});
+
+  const auto layouts = LoadGroupLayouts(path);
+
+  EXPECT_TRUE(layouts.empty());
+}
+
+TEST_F(LoadGroupLayoutsTest, shouldThrowIfGraphHashIsIncomplete) {
+  const auto path = rootPath_ / "positions.bin";
+
+  writeBytes(path, {'\x4C', '\x47', '\x4E', '\x50', '\x3', '\x1'});
+
+  EXPECT_THROW(LoadGroupLayouts(path), std::runtime_error);
+}
+
+TEST_F(LoadGroupLayoutsTest, shouldThrowIfNodePositionsAreIncomplete) {
+  const auto path = rootPath_ / "positions.bin";
+
+  writeBytes(path,
+             {'\x4C', '\x47', '\x4E', '\x50', '\x3', '\x1', '\x2', '\x3',
+              '\x4', '\x5', '\x6', '\x7', '\x8', '\x2', '\x0', '\x0', '\x0'});
+
+  EXPECT_THROW(LoadGroupLayouts(path), std::runtime_error);
+}
+
+TEST_F(LoadGroupLayoutsTest, shouldReadASingleLayoutFromFormatVersionTwo) {
+  const auto path = rootPath_ / "positions.bin";
+
+  writeBytes(path,
+             {'\x4C', '\x47', '\x4E', '\x50', '\x2', '\x8', '\x7', '\x6',
+              '\x5', '\x4', '\x3', '\x2', '\x1', '\x1', '\x0', 'a',
+              '\x0', '\x0', '\x0', '\x0', '\x0', '\x0', '\x0', '\x0',
+              '\x0', '\x0', '\x0', '\x0', '\x0', '\x0', '\x0', '\x0'});
+
+  const auto layouts = LoadGroupLayouts(path);
+
+  ASSERT_EQ(1, layouts.size());
+  EXPECT_EQ(0x0102030405060708, layouts[0].graphHash);
+  ASSERT_EQ(1, layouts[0].positions.size());
+  EXPECT_EQ("a", layouts[0].positions[0].groupName);
+}
+
+TEST_F(LoadGroupLayoutsTest, shouldAcceptDataWrittenBySave) {
+  const auto path = rootPath_ / "positions.bin";
+
+  const std::vector<GroupLayout> originalLayouts{
+      GroupLayout{0x0123456789ABCDEF,
+                  {GroupNodePosition{"default", 1.1, 2.2},
+                   GroupNodePosition{"DLC", -3.0, -4.5}}},
+      GroupLayout{0x1234, {}},
+      GroupLayout{0x5678, {GroupNodePosition{"default", 5.0, 6.0}}}};
+
+  SaveGroupLayouts(path, originalLayouts);
+
+  const auto layouts = LoadGroupLayouts(path);
+
+  ASSERT_EQ(3, layouts.size());
+
+  EXPECT_EQ(originalLayouts[0].graphHash, layouts[0].graphHash);
+  ASSERT_EQ(2, layouts[0].positions.size());
+  EXPECT_EQ(originalLayouts[0].positions[0].groupName,
+            layouts[0].positions[0].groupName);
+  EXPECT_EQ(originalLayouts[0].positions[0].x, layouts[0].positions[0].x);
+  EXPECT_EQ(originalLayouts[0].positions[0].y, layouts[0].positions[0].y);
+  EXPECT_EQ(originalLayouts[0].positions[1].groupName,
+            layouts[0].positions[1].groupName);
+  EXPECT_EQ(originalLayouts[0].positions[1].x, layouts[0].positions[1].x);
+  EXPECT_EQ(originalLayouts[0].positions[1].y, layouts[0].positions[1].y);
+
+  EXPECT_EQ(originalLayouts[1].graphHash, layouts[1].graphHash);
+  EXPECT_TRUE(layouts[1].positions.empty());
+
+  EXPECT_EQ(originalLayouts[2].graphHash, layouts[2].graphHash);
+  ASSERT_EQ(1, layouts[2].positions.size());
+  EXPECT_EQ(originalLayouts[2].positions[0].x, layouts[2].positions[0].x);
+  EXPECT_EQ(originalLayouts[2].positions[0].y, layouts[2].positions[0].y);
+}
+
+TEST_F(SaveGroupLayoutsTest,
+       shouldWriteFormatVersionThreeAndEachGraphHashAndPositionCount) {
+  const auto path = rootPath_ / "positions.bin";
+
+  SaveGroupLayouts(path, {GroupLayout{0x0102030405060708, {}}});
+
+  const auto bytes = readBytes(path);
+
+  ASSERT_EQ(17, bytes.size());
+
+  EXPECT_EQ(0x4C, bytes[0]);
+  EXPECT_EQ(0x47, bytes[1]);
+  EXPECT_EQ(0x4E, bytes[2]);
+  EXPECT_EQ(0x50, bytes[3]);
+  EXPECT_EQ(0x3, bytes[4]);
+  EXPECT_EQ(0x0102030405060708,
+            *reinterpret_cast<const uint64_t*>(&bytes[5]));
+  EXPECT_EQ(0, *reinterpret_cast<const uint32_t*>(&bytes[13]));
+}
 }
 }
 
@@ -134,6 +134,32 @@ C.Location, -C.LockList
   EXPECT_EQ(expectedTags, tags);
 }
 
+TEST(ReadBashTagsFile, shouldIgnoreCarriageReturnsAndEmptyEntries) {
+  std::stringstream in("Delev,,\r\n\r\n -Relev , C.Water\r\n");
+
+  const auto tags = ReadBashTagsFile(in);
+  const std::vector<Tag> expectedTags{
+      Tag("Delev"), Tag("Relev", false), Tag("C.Water")};
+
+  EXPECT_EQ(expectedTags, tags);
+}
+
+TEST(ReadBashTagsFileTagSet, shouldReadTheSameTagsAsReadBashTagsFile) {
+  std::stringstream in("Delev, -Relev # Comment\nC.Water");
+
+  const auto tags = ReadBashTagsFileTagSet(in);
+  const TagSet oppositeTags(
+      {Tag("Delev", false), Tag("Relev"), Tag("C.Water", false)});
+
+  EXPECT_EQ(std::vector<std::string>({"C.Water", "Delev", "Relev"}),
+            tags.GetConflicts(oppositeTags));
+}
+
+TEST(GetBashTagsFilename, shouldReplaceThePluginFileExtensionWithTxt) {
+  EXPECT_EQ("Blank.txt", GetBashTagsFilename("Blank.esp"));
+  EXPECT_EQ("Blank.esm.txt", GetBashTagsFilename("Blank.esm.esp"));
+}
+
 TEST(ReadBashTagsFile, shouldReturnAnEmptyVectorIfThePathDoesNotExist) {
   EXPECT_TRUE(
       ReadBashTagsFile(std::filesystem::temp_directory_path() / "missing",
@@ -161,6 +187,158 @@ TEST(ReadBashTagsFile, shouldReadFromAPluginFile) {
   std::filesystem::remove_all(dataPath);
 }
 
+TEST(ReadLoadOrderJournal, shouldReturnNothingIfThereIsNoJournal) {
+  const auto backupPath = getTempPath();
+
+  EXPECT_TRUE(ReadLoadOrderJournal(backupPath).empty());
+}
+
+TEST(ReadLoadOrderJournal, shouldReturnEachLoadOrderBackedUpFromOldestFirst) {
+  const auto backupPath = getTempPath();
+  std::filesystem::create_directories(backupPath);
+
+  const std::vector<std::string> loadOrder1{"A.esm", "B.esp", "C.esp"};
+  const std::vector<std::string> loadOrder2{"A.esm", "C.esp", "B.esp"};
+  const std::vector<std::string> loadOrder3{"A.esm", "C.esp"};
+
+  BackupLoadOrder(loadOrder1, backupPath);
+  BackupLoadOrder(loadOrder2, backupPath);
+  BackupLoadOrder(loadOrder3, backupPath);
+
+  const auto journal = ReadLoadOrderJournal(backupPath);
+
+  ASSERT_EQ(3, journal.size());
+  EXPECT_EQ(loadOrder1, journal[0].loadOrder);
+  EXPECT_EQ(loadOrder2, journal[1].loadOrder);
+  EXPECT_EQ(loadOrder3, journal[2].loadOrder);
+
+  std::filesystem::remove_all(backupPath);
+}
+
+TEST(ReadLoadOrderJournal, shouldIgnoreATruncatedFinalEntry) {
+  const auto backupPath = getTempPath();
+  std::filesystem::create_directories(backupPath);
+
+  const std::vector<std::string> loadOrder1{"A.esm", "B.esp"};
+  const std::vector<std::string> loadOrder2{"A.esm", "C.esp"};
+
+  BackupLoadOrder(loadOrder1, backupPath);
+  BackupLoadOrder(loadOrder2, backupPath);
+
+  const auto journalPath = backupPath / "loadorder.journal";
+  std::filesystem::resize_file(journalPath,
+                               std::filesystem::file_size(journalPath) - 2);
+
+  auto journal = ReadLoadOrderJournal(backupPath);
+
+  ASSERT_EQ(1, journal.size());
+  EXPECT_EQ(loadOrder1, journal[0].loadOrder);
+
+  // The next backup should replace the truncated entry.
+  BackupLoadOrder(loadOrder2, backupPath);
+
+  journal = ReadLoadOrderJournal(backupPath);
+
+  ASSERT_EQ(2, journal.size());
+  EXPECT_EQ(loadOrder1, journal[0].loadOrder);
+  EXPECT_EQ(loadOrder2, journal[1].loadOrder);
+
+  std::filesystem::remove_all(backupPath);
+}
+
+TEST(BackupLoadOrder, shouldDiscardTheOldestEntriesOnceTheJournalIsFull) {
+  const auto backupPath = getTempPath();
+  std::filesystem::create_directories(backupPath);
+
+  for (size_t i = 0; i < 105; i += 1) {
+    BackupLoadOrder({"A.esm", std::to_string(i) + ".esp"}, backupPath);
+  }
+
+  const auto journal = ReadLoadOrderJournal(backupPath);
+
+  ASSERT_EQ(100, journal.size());
+  EXPECT_EQ(std::vector<std::string>({"A.esm", "5.esp"}),
+            journal.front().loadOrder);
+  EXPECT_EQ(std::vector<std::string>({"A.esm", "104.esp"}),
+            journal.back().loadOrder);
+
+  std::filesystem::remove_all(backupPath);
+}
+
+TEST(BackupLoadOrder, shouldWriteTheLoadOrderAsAPlainTextFile) {
+  const auto backupPath = getTempPath();
+  std::filesystem::create_directories(backupPath);
+
+  BackupLoadOrder({"A.esm", "B.esp"}, backupPath);
+  BackupLoadOrder({"A.esm", "C.esp"}, backupPath);
+
+  std::ifstream in(backupPath / "loadorder.bak.0");
+  const std::string content((std::istreambuf_iterator<char>(in)),
+                            std::istreambuf_iterator<char>());
+
+  EXPECT_EQ("A.esm\nC.esp\n", content);
+
+  in.close();
+  std::filesystem::remove_all(backupPath);
+}
+
+TEST(BackupLoadOrder,
+     shouldWriteTheSameJournalWhetherOrNotJournalStateIsGiven) {
+  const auto backupPath1 = getTempPath();
+  const auto backupPath2 = getTempPath();
+  std::filesystem::create_directories(backupPath1);
+  std::filesystem::create_directories(backupPath2);
+
+  const std::vector<std::vector<std::string>> loadOrders{
+      {"A.esm", "B.esp", "C.esp"}, {"A.esm", "C.esp", "B.esp"}, {"A.esm"}};
+
+  LoadOrderJournalState state;
+  for (const auto& loadOrder : loadOrders) {
+    BackupLoadOrder(loadOrder, backupPath1);
+    BackupLoadOrder(loadOrder, backupPath2, &state);
+  }
+
+  EXPECT_EQ(3, state.entryCount);
+  EXPECT_EQ(loadOrders.back(), state.lastLoadOrder);
+  EXPECT_EQ(std::filesystem::file_size(backupPath2 / "loadorder.journal"),
+            state.fileSize);
+
+  const auto journal1 = ReadLoadOrderJournal(backupPath1);
+  const auto journal2 = ReadLoadOrderJournal(backupPath2);
+
+  ASSERT_EQ(journal1.size(), journal2.size());
+  for (size_t i = 0; i < journal1.size(); i += 1) {
+    EXPECT_EQ(journal1[i].loadOrder, journal2[i].loadOrder);
+  }
+
+  std::filesystem::remove_all(backupPath1);
+  std::filesystem::remove_all(backupPath2);
+}
+
+TEST(BackupLoadOrder, shouldReadTheJournalIfItHasChangedSinceTheLastBackup) {
+  const auto backupPath = getTempPath();
+  std::filesystem::create_directories(backupPath);
+
+  const std::vector<std::string> loadOrder1{"A.esm", "B.esp"};
+  const std::vector<std::string> loadOrder2{"A.esm", "C.esp"};
+
+  LoadOrderJournalState state;
+  BackupLoadOrder(loadOrder1, backupPath, &state);
+  BackupLoadOrder(loadOrder2, backupPath, &state);
+
+  std::filesystem::remove(backupPath / "loadorder.journal");
+
+  BackupLoadOrder(loadOrder2, backupPath, &state);
+
+  const auto journal = ReadLoadOrderJournal(backupPath);
+
+  ASSERT_EQ(1, journal.size());
+  EXPECT_EQ(loadOrder2, journal[0].loadOrder);
+  EXPECT_EQ(1, state.entryCount);
+
+  std::filesystem::remove_all(backupPath);
+}
+
 TEST(GetTagConflicts,
      shouldReturnTagNamesAddedByOneSourceAndRemovedByTheOther) {
   const auto conflicts =
@@ -249,6 +427,100 @@ TEST(GetExternalDataPaths,
                             "(PC)/Content/Data"}),
             paths);
 }
+
+TEST(GetMinimalPluginMoves, shouldReturnNoMovesIfTheLoadOrdersAreEqual) {
+  const std::vector<std::string> loadOrder{"A.esm", "B.esp", "C.esp"};
+
+  EXPECT_TRUE(GetMinimalPluginMoves(loadOrder, loadOrder).empty());
+}
+
+TEST(GetMinimalPluginMoves, shouldReturnOneMoveIfOnePluginHasMoved) {
+  const auto moves =
+      GetMinimalPluginMoves({"D.esp", "A.esm", "B.esp", "C.esp"},
+                            {"A.esm", "B.esp", "C.esp", "D.esp"});
+
+  ASSERT_EQ(1, moves.size());
+  EXPECT_EQ("D.esp", moves[0].name);
+  EXPECT_EQ(0, moves[0].currentIndex);
+  EXPECT_EQ(3, moves[0].newIndex);
+}
+
+TEST(GetMinimalPluginMoves, shouldReturnMovesInNewLoadOrder) {
+  const auto moves = GetMinimalPluginMoves({"A.esm", "B.esp", "C.esp"},
+                                           {"C.esp", "B.esp", "A.esm"});
+
+  ASSERT_EQ(2, moves.size());
+  EXPECT_LT(moves[0].newIndex, moves[1].newIndex);
+}
+
+TEST(GetMinimalPluginMoves,
+     shouldIgnorePluginsThatAreOnlyInOneOfTheLoadOrders) {
+  const auto moves = GetMinimalPluginMoves({"A.esm", "B.esp", "C.esp"},
+                                           {"A.esm", "D.esp", "C.esp"});
+
+  EXPECT_TRUE(moves.empty());
+}
+
+TEST(HasPossiblyGhostedPluginFileExtension,
+     shouldBeTrueForPluginsAndGhostedPlugins) {
+  EXPECT_TRUE(HasPossiblyGhostedPluginFileExtension("Blank.esp"));
+  EXPECT_TRUE(HasPossiblyGhostedPluginFileExtension("Blank.ESM"));
+  EXPECT_TRUE(HasPossiblyGhostedPluginFileExtension("Blank.esl.ghost"));
+  EXPECT_TRUE(HasPossiblyGhostedPluginFileExtension("Blank.esm.GHOST"));
+}
+
+TEST(HasPossiblyGhostedPluginFileExtension, shouldBeFalseForOtherFiles) {
+  EXPECT_FALSE(HasPossiblyGhostedPluginFileExtension("Blank.bsa"));
+  EXPECT_FALSE(HasPossiblyGhostedPluginFileExtension("Blank.ini"));
+  EXPECT_FALSE(HasPossiblyGhostedPluginFileExtension("Blank.bsa.ghost"));
+  EXPECT_FALSE(HasPossiblyGhostedPluginFileExtension(".ghost"));
+}
+
+TEST(IsOfficialPlugin, shouldCaseInsensitivelyMatchTheGamesOfficialPlugins) {
+  EXPECT_TRUE(IsOfficialPlugin(GameId::tes5se, "Skyrim.esm"));
+  EXPECT_TRUE(IsOfficialPlugin(GameId::tes5se, "ccBGSSSE001-Fish.esm"));
+  EXPECT_TRUE(IsOfficialPlugin(GameId::nehrim, "Nehrim.esm"));
+}
+
+TEST(IsOfficialPlugin, shouldReturnFalseForOtherPlugins) {
+  EXPECT_FALSE(IsOfficialPlugin(GameId::tes5se, "Blank.esp"));
+  EXPECT_FALSE(IsOfficialPlugin(GameId::tes5se, "Oblivion.esm"));
+  EXPECT_FALSE(IsOfficialPlugin(GameId::nehrim, "Blank.esp"));
+  EXPECT_FALSE(IsOfficialPlugin(GameId::tes5vr, "Blank.esp"));
+}
+
+TEST(GetGroupsLoadingAfter, shouldReturnAnEmptySetIfNoGroupsLoadAfterTheGroup) {
+  const std::vector<Group> groups{Group("default"), Group("a", {"default"})};
+
+  EXPECT_TRUE(GetGroupsLoadingAfter(groups, "a").empty());
+}
+
+TEST(GetGroupsLoadingAfter, shouldIncludeGroupsThatLoadAfterLaterGroups) {
+  const std::vector<Group> groups{Group("default"),
+                                  Group("a", {"default"}),
+                                  Group("b", {"a"}),
+                                  Group("c", {"default"})};
+
+  EXPECT_EQ(std::set<std::string>({"a", "b", "c"}),
+            GetGroupsLoadingAfter(groups, "default"));
+  EXPECT_EQ(std::set<std::string>({"b"}), GetGroupsLoadingAfter(groups, "a"));
+}
+
+TEST(GetGroupsLoadingAfter, shouldCombineAfterGroupsOfSameNamedGroups) {
+  const std::vector<Group> groups{Group("default"),
+                                  Group("a", {"default"}),
+                                  Group("b"),
+                                  Group("b", {"a"})};
+
+  EXPECT_EQ(std::set<std::string>({"b"}), GetGroupsLoadingAfter(groups, "a"));
+}
+
+TEST(GetGroupsLoadingAfter, shouldNotLoopForeverIfTheGroupsHaveACycle) {
+  const std::vector<Group> groups{Group("a", {"b"}), Group("b", {"a"})};
+
+  EXPECT_EQ(std::set<std::string>({"a", "b"}),
+            GetGroupsLoadingAfter(groups, "a"));
+}
 }
 }
 
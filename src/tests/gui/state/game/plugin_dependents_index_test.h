@@ -0,0 +1,91 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_GAME_PLUGIN_DEPENDENTS_INDEX_TEST
+#define LOOT_TESTS_GUI_STATE_GAME_PLUGIN_DEPENDENTS_INDEX_TEST
+
+#include <gtest/gtest.h>
+
+#include <boost/locale.hpp>
+
+#include "gui/state/game/plugin_dependents_index.h"
+
+namespace loot {
+namespace test {
+class PluginDependentsIndexTest : public ::testing::Test {
+protected:
+  PluginDependentsIndexTest() {
+    // Lowercasing file names uses boost::locale.
+    boost::locale::generator gen;
+    std::locale::global(gen("en.UTF-8"));
+  }
+};
+
+TEST_F(PluginDependentsIndexTest,
+       getDependentsShouldReturnAnEmptyVectorIfDefaultConstructed) {
+  PluginDependentsIndex index;
+
+  EXPECT_TRUE(index.GetDependents("Blank.esm").empty());
+}
+
+TEST_F(PluginDependentsIndexTest,
+       getDependentsShouldReturnThePluginsThatDependOnTheGivenFile) {
+  PluginDependentsIndex index;
+  index.AddDependencies("Blank.esp", {"Blank.esm"});
+  index.AddDependencies("Blank - Different.esp",
+                        {"Blank.esm", "Blank - Different.esm"});
+  index.AddDependencies("Blank - Plugin Dependent.esp", {"Blank.esp"});
+
+  EXPECT_EQ(std::vector<std::string>({"Blank.esp", "Blank - Different.esp"}),
+            index.GetDependents("Blank.esm"));
+  EXPECT_EQ(std::vector<std::string>({"Blank - Different.esp"}),
+            index.GetDependents("Blank - Different.esm"));
+  EXPECT_EQ(std::vector<std::string>({"Blank - Plugin Dependent.esp"}),
+            index.GetDependents("Blank.esp"));
+  EXPECT_TRUE(index.GetDependents("Blank - Different.esp").empty());
+}
+
+TEST_F(PluginDependentsIndexTest,
+       getDependentsShouldListAPluginOnceIfItDependsOnAFileTwice) {
+  PluginDependentsIndex index;
+  index.AddDependencies("Blank.esp", {"Blank.esm", "blank.esm"});
+
+  EXPECT_EQ(std::vector<std::string>({"Blank.esp"}),
+            index.GetDependents("Blank.esm"));
+}
+
+TEST_F(PluginDependentsIndexTest, getDependentsShouldBeCaseInsensitive) {
+  PluginDependentsIndex index;
+  index.AddDependencies("Blank.esp", {"Blank.esm", u8"nonÁscii.esm"});
+
+  EXPECT_EQ(std::vector<std::string>({"Blank.esp"}),
+            index.GetDependents("blank.ESM"));
+  EXPECT_EQ(std::vector<std::string>({"Blank.esp"}),
+            index.GetDependents(u8"NONáSCII.esm"));
+}
+}
+}
+
+#endif
@@ -0,0 +1,222 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_GAME_PLUGIN_FILE_CACHE_TEST
+#define LOOT_TESTS_GUI_STATE_GAME_PLUGIN_FILE_CACHE_TEST
+
+#include <gtest/gtest.h>
+
+#include "gui/state/game/plugin_file_cache.h"
+#include "tests/gui/test_helpers.h"
+
+namespace loot {
+namespace test {
+class PluginFileCacheTest : public ::testing::Test {
+protected:
+  PluginFileCacheTest() :
+      rootPath_(getTempPath()),
+      filePath_(rootPath_ / "plugin_file_cache.bin"),
+      pluginPath_(rootPath_ / "Blank.esm"),
+      lastWriteTime_(std::filesystem::file_time_type::clock::now()) {}
+
+  void SetUp() override { std::filesystem::create_directories(rootPath_); }
+
+  void TearDown() override { std::filesystem::remove_all(rootPath_); }
+
+  void writeBytes(const std::filesystem::path& path,
+                  const std::vector<char>& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios_base::trunc);
+
+    for (const auto byte : bytes) {
+      out.put(byte);
+    }
+  }
+
+  const std::filesystem::path rootPath_;
+  const std::filesystem::path filePath_;
+  const std::filesystem::path pluginPath_;
+  const std::filesystem::file_time_type lastWriteTime_;
+};
+
+TEST_F(PluginFileCacheTest, isValidPluginShouldReturnNulloptIfPathIsNotCached) {
+  PluginFileCache cache;
+
+  EXPECT_FALSE(cache.IsValidPlugin(pluginPath_, 1, lastWriteTime_));
+}
+
+TEST_F(PluginFileCacheTest,
+       isValidPluginShouldReturnTheCachedValueIfSizeAndTimeMatch) {
+  PluginFileCache cache;
+  cache.SetIsValidPlugin(pluginPath_, 1, lastWriteTime_, true);
+
+  EXPECT_EQ(true, cache.IsValidPlugin(pluginPath_, 1, lastWriteTime_));
+
+  cache.SetIsValidPlugin(pluginPath_, 1, lastWriteTime_, false);
+
+  EXPECT_EQ(false, cache.IsValidPlugin(pluginPath_, 1, lastWriteTime_));
+}
+
+TEST_F(PluginFileCacheTest, isValidPluginShouldReturnNulloptIfSizeHasChanged) {
+  PluginFileCache cache;
+  cache.SetIsValidPlugin(pluginPath_, 1, lastWriteTime_, true);
+
+  EXPECT_FALSE(cache.IsValidPlugin(pluginPath_, 2, lastWriteTime_));
+}
+
+TEST_F(PluginFileCacheTest,
+       isValidPluginShouldReturnNulloptIfLastWriteTimeHasChanged) {
+  PluginFileCache cache;
+  cache.SetIsValidPlugin(pluginPath_, 1, lastWriteTime_, true);
+
+  EXPECT_FALSE(cache.IsValidPlugin(
+      pluginPath_, 1, lastWriteTime_ + std::chrono::seconds(1)));
+}
+
+TEST_F(PluginFileCacheTest, getCrcShouldReturnNulloptIfNoCrcHasBeenSet) {
+  PluginFileCache cache;
+  cache.SetIsValidPlugin(pluginPath_, 1, lastWriteTime_, true);
+
+  EXPECT_FALSE(cache.GetCrc(pluginPath_, 1, lastWriteTime_));
+}
+
+TEST_F(PluginFileCacheTest, setCrcShouldKeepAnEntrysValidityIfItMatches) {
+  PluginFileCache cache;
+  cache.SetIsValidPlugin(pluginPath_, 1, lastWriteTime_, false);
+  cache.SetCrc(pluginPath_, 1, lastWriteTime_, 0x12345678);
+
+  EXPECT_EQ(0x12345678, cache.GetCrc(pluginPath_, 1, lastWriteTime_));
+  EXPECT_EQ(false, cache.IsValidPlugin(pluginPath_, 1, lastWriteTime_));
+}
+
+TEST_F(PluginFileCacheTest,
+       setCrcShouldReplaceAnEntryForADifferentSizeAndRecordAValidPlugin) {
+  PluginFileCache cache;
+  cache.SetIsValidPlugin(pluginPath_, 1, lastWriteTime_, false);
+  cache.SetCrc(pluginPath_, 2, lastWriteTime_, 0x12345678);
+
+  EXPECT_FALSE(cache.GetCrc(pluginPath_, 1, lastWriteTime_));
+  EXPECT_FALSE(cache.IsValidPlugin(pluginPath_, 1, lastWriteTime_));
+  EXPECT_EQ(0x12345678, cache.GetCrc(pluginPath_, 2, lastWriteTime_));
+  EXPECT_EQ(true, cache.IsValidPlugin(pluginPath_, 2, lastWriteTime_));
+}
+
+TEST_F(PluginFileCacheTest, getCrcShouldReturnNulloptIfSizeHasChanged) {
+  PluginFileCache cache;
+  cache.SetCrc(pluginPath_, 1, lastWriteTime_, 0x12345678);
+
+  EXPECT_FALSE(cache.GetCrc(pluginPath_, 2, lastWriteTime_));
+}
+
+TEST_F(PluginFileCacheTest,
+       loadPluginFileCacheShouldReturnAnEmptyCacheIfFileDoesNotExist) {
+  const auto cache = LoadPluginFileCache(filePath_);
+
+  EXPECT_TRUE(cache.GetEntries().empty());
+}
+
+TEST_F(PluginFileCacheTest,
+       loadPluginFileCacheShouldThrowIfFileMagicNumberIsUnexpected) {
+  writeBytes(filePath_, {'\xDE', '\xAD', '\xBE', '\xEF'});
+
+  EXPECT_THROW(LoadPluginFileCache(filePath_), std::runtime_error);
+}
+
+TEST_F(PluginFileCacheTest,
+       loadPluginFileCacheShouldThrowIfFileFormatVersionIsUnrecognised) {
+  writeBytes(filePath_, {'\x4C', '\x50', '\x46', '\x43', '\x0'});
+
+  EXPECT_THROW(LoadPluginFileCache(filePath_), std::runtime_error);
+}
+
+TEST_F(PluginFileCacheTest,
+       loadPluginFileCacheShouldThrowIfAnEntryIsTruncated) {
+  writeBytes(filePath_, {'\x4C', '\x50', '\x46', '\x43', '\x1', '\x5', '\x0'});
+
+  EXPECT_THROW(LoadPluginFileCache(filePath_), std::runtime_error);
+}
+
+TEST_F(PluginFileCacheTest, loadPluginFileCacheShouldAcceptDataWrittenBySave) {
+  const auto otherPluginPath =
+      rootPath_ / std::filesystem::u8path(u8"non\u00C1scii.esp");
+
+  PluginFileCache cache;
+  cache.SetIsValidPlugin(pluginPath_, 1, lastWriteTime_, true);
+  cache.SetIsValidPlugin(otherPluginPath, 2, lastWriteTime_, false);
+
+  SavePluginFileCache(filePath_, cache);
+
+  const auto loadedCache = LoadPluginFileCache(filePath_);
+
+  EXPECT_EQ(2, loadedCache.GetEntries().size());
+  EXPECT_EQ(true, loadedCache.IsValidPlugin(pluginPath_, 1, lastWriteTime_));
+  EXPECT_EQ(false,
+            loadedCache.IsValidPlugin(otherPluginPath, 2, lastWriteTime_));
+}
+
+TEST_F(PluginFileCacheTest, loadPluginFileCacheShouldAcceptCrcsWrittenBySave) {
+  const auto otherPluginPath = rootPath_ / "Blank.esp";
+
+  PluginFileCache cache;
+  cache.SetCrc(pluginPath_, 1, lastWriteTime_, 0x12345678);
+  cache.SetIsValidPlugin(otherPluginPath, 2, lastWriteTime_, true);
+
+  SavePluginFileCache(filePath_, cache);
+
+  const auto loadedCache = LoadPluginFileCache(filePath_);
+
+  EXPECT_EQ(0x12345678, loadedCache.GetCrc(pluginPath_, 1, lastWriteTime_));
+  EXPECT_FALSE(loadedCache.GetCrc(otherPluginPath, 2, lastWriteTime_));
+}
+
+TEST_F(PluginFileCacheTest,
+       loadPluginFileCacheShouldAcceptDataInTheFirstFormatVersion) {
+  // One entry for the path "a", with a size of 1 and a timestamp of 0.
+  writeBytes(filePath_, {'\x4C', '\x50', '\x46', '\x43', '\x1', '\x1', '\x0',
+                         'a',    '\x1', '\x0', '\x0', '\x0', '\x0', '\x0',
+                         '\x0', '\x0', '\x0', '\x0', '\x0', '\x0', '\x0',
+                         '\x0', '\x0', '\x0', '\x1'});
+
+  const auto loadedCache = LoadPluginFileCache(filePath_);
+  const auto path = std::filesystem::u8path("a");
+  const auto lastWriteTime = std::filesystem::file_time_type();
+
+  EXPECT_EQ(1, loadedCache.GetEntries().size());
+  EXPECT_EQ(true, loadedCache.IsValidPlugin(path, 1, lastWriteTime));
+  EXPECT_FALSE(loadedCache.GetCrc(path, 1, lastWriteTime));
+}
+
+TEST_F(PluginFileCacheTest,
+       savePluginFileCacheShouldThrowIfFileCannotBeOpened) {
+  const auto path = rootPath_ / "missing.dir";
+
+  std::filesystem::create_directory(path);
+
+  EXPECT_THROW(SavePluginFileCache(path, PluginFileCache()),
+               std::runtime_error);
+}
+}
+}
+
+#endif
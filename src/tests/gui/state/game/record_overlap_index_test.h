@@ -0,0 +1,204 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_GAME_RECORD_OVERLAP_INDEX_TEST
+#define LOOT_TESTS_GUI_STATE_GAME_RECORD_OVERLAP_INDEX_TEST
+
+#include <gtest/gtest.h>
+
+#include "gui/state/game/record_overlap_index.h"
+#include "tests/gui/test_helpers.h"
+
+namespace loot {
+namespace test {
+class RecordOverlapIndexTest : public ::testing::Test {
+protected:
+  RecordOverlapIndexTest() :
+      rootPath_(getTempPath()),
+      filePath_(rootPath_ / "record_overlap_index.bin") {}
+
+  void SetUp() override { std::filesystem::create_directories(rootPath_); }
+
+  void TearDown() override { std::filesystem::remove_all(rootPath_); }
+
+  void writeBytes(const std::filesystem::path& path,
+                  const std::vector<char>& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios_base::trunc);
+
+    for (const auto byte : bytes) {
+      out.put(byte);
+    }
+  }
+
+  const std::filesystem::path rootPath_;
+  const std::filesystem::path filePath_;
+};
+
+TEST_F(RecordOverlapIndexTest,
+       doRecordsOverlapShouldReturnNulloptIfEitherPluginIsNotIndexed) {
+  RecordOverlapIndex index;
+  index.AddIndexedPlugin("A.esp", 1);
+
+  EXPECT_FALSE(index.DoRecordsOverlap("A.esp", 1, "B.esp", 2));
+  EXPECT_FALSE(index.DoRecordsOverlap("B.esp", 2, "A.esp", 1));
+}
+
+TEST_F(RecordOverlapIndexTest,
+       doRecordsOverlapShouldReturnNulloptIfAPluginWasIndexedWithAnotherCrc) {
+  RecordOverlapIndex index;
+  index.AddIndexedPlugin("A.esp", 1);
+  index.AddIndexedPlugin("B.esp", 2);
+  index.AddOverlap("A.esp", "B.esp");
+
+  EXPECT_FALSE(index.DoRecordsOverlap("A.esp", 1, "B.esp", 3));
+}
+
+TEST_F(RecordOverlapIndexTest,
+       doRecordsOverlapShouldReturnWhetherAnOverlapWasAddedInEitherOrder) {
+  RecordOverlapIndex index;
+  index.AddIndexedPlugin("A.esp", 1);
+  index.AddIndexedPlugin("B.esp", 2);
+  index.AddIndexedPlugin("C.esp", 3);
+  index.AddOverlap("B.esp", "A.esp");
+
+  EXPECT_EQ(true, index.DoRecordsOverlap("A.esp", 1, "B.esp", 2));
+  EXPECT_EQ(true, index.DoRecordsOverlap("B.esp", 2, "A.esp", 1));
+  EXPECT_EQ(false, index.DoRecordsOverlap("A.esp", 1, "C.esp", 3));
+  EXPECT_EQ(false, index.DoRecordsOverlap("C.esp", 3, "C.esp", 3));
+}
+
+TEST_F(RecordOverlapIndexTest,
+       doRecordsOverlapShouldDistinguishPluginsThatHaveTheSameCrc) {
+  RecordOverlapIndex index;
+  index.AddIndexedPlugin("A.esp", 1);
+  index.AddIndexedPlugin("B.esp", 1);
+  index.AddIndexedPlugin("C.esp", 2);
+  index.AddOverlap("A.esp", "C.esp");
+
+  EXPECT_EQ(true, index.DoRecordsOverlap("A.esp", 1, "C.esp", 2));
+  EXPECT_EQ(false, index.DoRecordsOverlap("B.esp", 1, "C.esp", 2));
+}
+
+TEST_F(RecordOverlapIndexTest,
+       getOverlapCountsShouldCountTheOtherPluginsThatEachPluginOverlaps) {
+  RecordOverlapIndex index;
+  index.AddIndexedPlugin("A.esp", 1);
+  index.AddIndexedPlugin("B.esp", 2);
+  index.AddIndexedPlugin("C.esp", 3);
+  index.AddIndexedPlugin("D.esp", 3);
+  index.AddOverlap("A.esp", "B.esp");
+  index.AddOverlap("C.esp", "A.esp");
+  index.AddOverlap("B.esp", "B.esp");
+
+  const auto counts = index.GetOverlapCounts();
+
+  EXPECT_EQ(4, counts.size());
+  EXPECT_EQ(2, counts.at("A.esp").count);
+  EXPECT_EQ(1, counts.at("B.esp").count);
+  EXPECT_EQ(1, counts.at("C.esp").count);
+  EXPECT_EQ(0, counts.at("D.esp").count);
+  EXPECT_EQ(3, counts.at("D.esp").crc);
+}
+
+TEST_F(RecordOverlapIndexTest, updateShouldIgnoreAnEmptyListOfPlugins) {
+  RecordOverlapIndex index;
+
+  index.Update({});
+
+  EXPECT_TRUE(index.GetIndexedPlugins().empty());
+  EXPECT_TRUE(index.GetOverlappingPairs().empty());
+}
+
+TEST_F(RecordOverlapIndexTest, updateShouldDropPluginsThatAreNotGiven) {
+  RecordOverlapIndex index;
+  index.AddIndexedPlugin("A.esp", 1);
+  index.AddOverlap("A.esp", "A.esp");
+
+  index.Update({});
+
+  EXPECT_TRUE(index.GetIndexedPlugins().empty());
+  EXPECT_TRUE(index.GetOverlappingPairs().empty());
+}
+
+TEST_F(RecordOverlapIndexTest,
+       loadRecordOverlapIndexShouldReturnAnEmptyIndexIfFileDoesNotExist) {
+  const auto index = LoadRecordOverlapIndex(filePath_);
+
+  EXPECT_TRUE(index.GetIndexedPlugins().empty());
+  EXPECT_TRUE(index.GetOverlappingPairs().empty());
+}
+
+TEST_F(RecordOverlapIndexTest,
+       loadRecordOverlapIndexShouldThrowIfFileMagicNumberIsUnexpected) {
+  writeBytes(filePath_, {'\xDE', '\xAD', '\xBE', '\xEF'});
+
+  EXPECT_THROW(LoadRecordOverlapIndex(filePath_), std::runtime_error);
+}
+
+TEST_F(RecordOverlapIndexTest,
+       loadRecordOverlapIndexShouldThrowIfFileFormatVersionIsUnrecognised) {
+  writeBytes(filePath_, {'\x4C', '\x52', '\x4F', '\x49', '\x0'});
+
+  EXPECT_THROW(LoadRecordOverlapIndex(filePath_), std::runtime_error);
+}
+
+TEST_F(RecordOverlapIndexTest,
+       loadRecordOverlapIndexShouldThrowIfTheFileIsTruncated) {
+  writeBytes(filePath_,
+             {'\x4C', '\x52', '\x4F', '\x49', '\x2', '\x2', '\x0', '\x0'});
+
+  EXPECT_THROW(LoadRecordOverlapIndex(filePath_), std::runtime_error);
+}
+
+TEST_F(RecordOverlapIndexTest,
+       loadRecordOverlapIndexShouldAcceptDataWrittenBySave) {
+  RecordOverlapIndex index;
+  index.AddIndexedPlugin("A.esp", 1);
+  index.AddIndexedPlugin("B.esp", 1);
+  index.AddIndexedPlugin("C.esp", 0xDEADBEEF);
+  index.AddOverlap("A.esp", "C.esp");
+  index.AddOverlap("B.esp", "B.esp");
+
+  SaveRecordOverlapIndex(filePath_, index);
+
+  const auto loadedIndex = LoadRecordOverlapIndex(filePath_);
+
+  EXPECT_EQ(index.GetIndexedPlugins(), loadedIndex.GetIndexedPlugins());
+  EXPECT_EQ(index.GetOverlappingPairs(), loadedIndex.GetOverlappingPairs());
+}
+
+TEST_F(RecordOverlapIndexTest,
+       saveRecordOverlapIndexShouldThrowIfFileCannotBeOpened) {
+  const auto path = rootPath_ / "missing.dir";
+
+  std::filesystem::create_directory(path);
+
+  EXPECT_THROW(SaveRecordOverlapIndex(path, RecordOverlapIndex()),
+               std::runtime_error);
+}
+}
+}
+
+#endif
@@ -0,0 +1,157 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_GAME_SORT_RESULT_CACHE_TEST
+#define LOOT_TESTS_GUI_STATE_GAME_SORT_RESULT_CACHE_TEST
+
+#include <gtest/gtest.h>
+
+#include "gui/state/game/sort_result_cache.h"
+#include "tests/gui/test_helpers.h"
+
+namespace loot {
+namespace test {
+class SortResultCacheTest : public ::testing::Test {
+protected:
+  SortResultCacheTest() :
+      rootPath_(getTempPath()),
+      filePath_(rootPath_ / "sort_result_cache.bin") {}
+
+  void SetUp() override { std::filesystem::create_directories(rootPath_); }
+
+  void TearDown() override { std::filesystem::remove_all(rootPath_); }
+
+  void writeBytes(const std::filesystem::path& path,
+                  const std::vector<char>& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios_base::trunc);
+
+    for (const auto byte : bytes) {
+      out.put(byte);
+    }
+  }
+
+  const std::filesystem::path rootPath_;
+  const std::filesystem::path filePath_;
+};
+
+TEST_F(SortResultCacheTest, sortInputsHasherShouldBeDeterministic) {
+  SortInputsHasher hasher1;
+  hasher1.Add("Blank.esm");
+  hasher1.Add(uint64_t{1});
+
+  SortInputsHasher hasher2;
+  hasher2.Add("Blank.esm");
+  hasher2.Add(uint64_t{1});
+
+  EXPECT_EQ(hasher1.GetHash(), hasher2.GetHash());
+}
+
+TEST_F(SortResultCacheTest,
+       sortInputsHasherShouldDistinguishValuesSplitDifferently) {
+  SortInputsHasher hasher1;
+  hasher1.Add("ab");
+  hasher1.Add("c");
+
+  SortInputsHasher hasher2;
+  hasher2.Add("a");
+  hasher2.Add("bc");
+
+  EXPECT_NE(hasher1.GetHash(), hasher2.GetHash());
+}
+
+TEST_F(SortResultCacheTest,
+       getConditionSubdirectoriesShouldReturnTheParentsOfPathsInConditions) {
+  const auto subdirectories = GetConditionSubdirectories(
+      "condition: 'file(\"meshes/a.nif\") and "
+      "not many(\"SKSE/Plugins/.*\\.dll\")'\n"
+      "condition: \"checksum(\\\"textures/b.dds\\\", DEADBEEF)\"\n"
+      "condition: 'product_version(\"../bin/c.exe\", \"1.0\", >)'\n");
+
+  EXPECT_EQ(std::set<std::string>(
+                {"../bin", "SKSE/Plugins", "meshes", "textures"}),
+            subdirectories);
+}
+
+TEST_F(SortResultCacheTest,
+       getConditionSubdirectoriesShouldIgnoreTopLevelPathsAndOtherFunctions) {
+  const auto subdirectories = GetConditionSubdirectories(
+      "condition: 'file(\"a.esp\") or active(\"b/c.esp\")'\n"
+      "content: 'See (\"d/e.txt\")'\n");
+
+  EXPECT_TRUE(subdirectories.empty());
+}
+
+TEST_F(SortResultCacheTest,
+       loadCachedSortResultShouldReturnNulloptIfFileDoesNotExist) {
+  EXPECT_FALSE(LoadCachedSortResult(filePath_).has_value());
+}
+
+TEST_F(SortResultCacheTest,
+       loadCachedSortResultShouldThrowIfFileMagicNumberIsUnexpected) {
+  writeBytes(filePath_, {'\xDE', '\xAD', '\xBE', '\xEF'});
+
+  EXPECT_THROW(LoadCachedSortResult(filePath_), std::runtime_error);
+}
+
+TEST_F(SortResultCacheTest,
+       loadCachedSortResultShouldThrowIfFileFormatVersionIsUnrecognised) {
+  writeBytes(filePath_, {'\x4C', '\x53', '\x52', '\x43', '\x0'});
+
+  EXPECT_THROW(LoadCachedSortResult(filePath_), std::runtime_error);
+}
+
+TEST_F(SortResultCacheTest, loadCachedSortResultShouldThrowIfFileIsTruncated) {
+  writeBytes(filePath_, {'\x4C', '\x53', '\x52', '\x43', '\x1', '\x5'});
+
+  EXPECT_THROW(LoadCachedSortResult(filePath_), std::runtime_error);
+}
+
+TEST_F(SortResultCacheTest,
+       loadCachedSortResultShouldAcceptDataWrittenBySave) {
+  const CachedSortResult result{
+      0x123456789, {"Blank.esm", u8"non\u00C1scii.esp", "Blank.esp"}};
+
+  SaveCachedSortResult(filePath_, result);
+
+  const auto loadedResult = LoadCachedSortResult(filePath_);
+
+  ASSERT_TRUE(loadedResult.has_value());
+  EXPECT_EQ(result.inputsHash, loadedResult.value().inputsHash);
+  EXPECT_EQ(result.sortedPlugins, loadedResult.value().sortedPlugins);
+}
+
+TEST_F(SortResultCacheTest,
+       saveCachedSortResultShouldThrowIfFileCannotBeOpened) {
+  const auto path = rootPath_ / "missing.dir";
+
+  std::filesystem::create_directory(path);
+
+  EXPECT_THROW(SaveCachedSortResult(path, CachedSortResult()),
+               std::runtime_error);
+}
+}
+}
+
+#endif
@@ -0,0 +1,159 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_GAME_SYNTHETIC_LOAD_ORDER_TEST
+#define LOOT_TESTS_GUI_STATE_GAME_SYNTHETIC_LOAD_ORDER_TEST
+
+#include <gtest/gtest.h>
+
+#include <boost/locale.hpp>
+
+#include "gui/state/game/game.h"
+#include "tests/gui/synthetic_load_order.h"
+#include "tests/gui/test_helpers.h"
+
+namespace loot {
+namespace test {
+class SyntheticLoadOrderTest : public ::testing::TestWithParam<GameId> {
+protected:
+  SyntheticLoadOrderTest() :
+      rootPath_(getTempPath()),
+      gamePath_(rootPath_ / "game"),
+      localPath_(rootPath_ / "local"),
+      lootDataPath_(rootPath_ / "LOOT"),
+      syntheticLoadOrder_(GetParam(), PLUGIN_COUNT) {
+    boost::locale::generator gen;
+    std::locale::global(gen("en.UTF-8"));
+  }
+
+  void SetUp() override {
+    std::filesystem::create_directories(lootDataPath_);
+    syntheticLoadOrder_.write(gamePath_, localPath_);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(rootPath_); }
+
+  gui::Game CreateInitialisedGame() {
+    gui::Game game(GameSettings(GetParam(), "game")
+                       .SetMinimumHeaderVersion(0.0f)
+                       .SetGamePath(gamePath_)
+                       .SetGameLocalPath(localPath_),
+                   lootDataPath_,
+                   "");
+    game.Init();
+    return game;
+  }
+
+  static constexpr size_t PLUGIN_COUNT = 500;
+
+  const std::filesystem::path rootPath_;
+  const std::filesystem::path gamePath_;
+  const std::filesystem::path localPath_;
+  const std::filesystem::path lootDataPath_;
+  const SyntheticLoadOrder syntheticLoadOrder_;
+};
+
+// Pass an empty first argument, as it's a prefix for the test instantiation,
+// but we only have the one so no prefix is necessary.
+INSTANTIATE_TEST_SUITE_P(,
+                         SyntheticLoadOrderTest,
+                         ::testing::Values(GameId::tes5,
+                                           GameId::tes5se,
+                                           GameId::tes5vr,
+                                           GameId::fo4,
+                                           GameId::fo4vr));
+
+TEST(SyntheticLoadOrder,
+     constructorShouldThrowIfTheGameUsesTimestampBasedLoadOrdering) {
+  EXPECT_THROW(SyntheticLoadOrder(GameId::tes4, 1), std::invalid_argument);
+  EXPECT_THROW(SyntheticLoadOrder(GameId::fonv, 1), std::invalid_argument);
+}
+
+TEST_P(SyntheticLoadOrderTest, writeShouldGhostSomePlugins) {
+  const auto dataPath =
+      GameSettings(GetParam(), "game").SetGamePath(gamePath_).DataPath();
+  const auto ghostedPlugins = syntheticLoadOrder_.ghostedPlugins();
+
+  ASSERT_FALSE(ghostedPlugins.empty());
+  for (const auto& plugin : ghostedPlugins) {
+    EXPECT_TRUE(std::filesystem::exists(
+        dataPath / std::filesystem::u8path(plugin + ".ghost")));
+    EXPECT_FALSE(
+        std::filesystem::exists(dataPath / std::filesystem::u8path(plugin)));
+  }
+}
+
+TEST_P(SyntheticLoadOrderTest, gameShouldReadTheWrittenLoadOrder) {
+  auto game = CreateInitialisedGame();
+  game.LoadCurrentLoadOrderState();
+
+  EXPECT_EQ(syntheticLoadOrder_.loadOrder(), game.GetLoadOrder());
+
+  const auto activePlugins = syntheticLoadOrder_.activePlugins();
+  ASSERT_FALSE(activePlugins.empty());
+  for (const auto& plugin : activePlugins) {
+    EXPECT_TRUE(game.IsPluginActive(plugin)) << plugin;
+  }
+}
+
+TEST_P(SyntheticLoadOrderTest, gameShouldLoadAllTheWrittenPlugins) {
+  auto game = CreateInitialisedGame();
+  game.LoadAllInstalledPlugins(false);
+
+  EXPECT_EQ(syntheticLoadOrder_.loadOrder().size(), game.GetPlugins().size());
+}
+
+TEST_P(SyntheticLoadOrderTest, gameShouldLoadTheWrittenMetadata) {
+  auto game = CreateInitialisedGame();
+  syntheticLoadOrder_.writeMasterlist(game.MasterlistPath());
+  syntheticLoadOrder_.writeUserlist(game.UserlistPath());
+
+  ASSERT_NO_THROW(game.LoadMetadata());
+
+  EXPECT_EQ(4, game.GetMasterlistGroups().size());
+  EXPECT_EQ(1, game.GetUserGroups().size());
+
+  const auto& lastPlugin = syntheticLoadOrder_.loadOrder().back();
+  const auto userMetadata = game.GetUserMetadata(lastPlugin);
+  ASSERT_TRUE(userMetadata.has_value());
+  EXPECT_EQ("Synthetic User Group", userMetadata->GetGroup().value_or(""));
+}
+
+TEST_P(SyntheticLoadOrderTest, sortingShouldSucceedWithTheWrittenMetadata) {
+  auto game = CreateInitialisedGame();
+  syntheticLoadOrder_.writeMasterlist(game.MasterlistPath());
+  syntheticLoadOrder_.writeUserlist(game.UserlistPath());
+
+  game.LoadAllInstalledPlugins(false);
+  game.LoadMetadata();
+
+  std::vector<std::string> sorted;
+  ASSERT_NO_THROW(sorted = game.SortPlugins());
+  EXPECT_EQ(syntheticLoadOrder_.loadOrder().size(), sorted.size());
+}
+}
+}
+
+#endif
@@ -0,0 +1,163 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_LOG_ARCHIVE_TEST
+#define LOOT_TESTS_GUI_STATE_LOG_ARCHIVE_TEST
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "gui/state/log_archive.h"
+#include "tests/gui/test_helpers.h"
+
+namespace loot::test {
+class LogArchiveTest : public ::testing::Test {
+public:
+  LogArchiveTest() :
+      rootPath_(getTempPath()),
+      logPath_(rootPath_ / "LOOTDebugLog.txt"),
+      archiveDir_(rootPath_ / "logs") {}
+
+protected:
+  void SetUp() override { std::filesystem::create_directories(archiveDir_); }
+
+  void TearDown() override { std::filesystem::remove_all(rootPath_); }
+
+  std::filesystem::path writeSegment(unsigned int sequenceNumber) {
+    const auto path =
+        getLogSegmentPath(logPath_, archiveDir_, time_, sequenceNumber);
+    write(path, "segment " + std::to_string(sequenceNumber));
+
+    return path;
+  }
+
+  static void write(const std::filesystem::path& path,
+                    const std::string& content) {
+    std::ofstream out(path, std::ios::binary);
+    out << content;
+  }
+
+  const std::filesystem::path rootPath_;
+  const std::filesystem::path logPath_;
+  const std::filesystem::path archiveDir_;
+  const std::chrono::system_clock::time_point time_{
+      std::chrono::system_clock::now()};
+};
+
+TEST_F(LogArchiveTest,
+       getLogSegmentPathShouldIncludeTheLogNameAndPaddedSequenceNumber) {
+  const auto path = getLogSegmentPath(logPath_, archiveDir_, time_, 7);
+
+  EXPECT_EQ(archiveDir_, path.parent_path());
+
+  const auto filename = path.filename().u8string();
+  EXPECT_EQ(0, filename.rfind("LOOTDebugLog-", 0));
+  EXPECT_EQ(filename.size() - 8, filename.rfind("-007.txt"));
+}
+
+TEST_F(LogArchiveTest, findLogArchivesShouldReturnSegmentsAndArchivesInOrder) {
+  const auto second = writeSegment(2);
+  const auto first = writeSegment(1);
+  const auto third = writeSegment(3);
+  auto archive = third;
+  archive += ".zip";
+  std::filesystem::rename(third, archive);
+
+  write(archiveDir_ / "other.txt", "");
+  write(archiveDir_ / "LOOTDebugLog-other.log", "");
+
+  const std::vector<std::filesystem::path> expected{first, second, archive};
+  EXPECT_EQ(expected, findLogArchives(logPath_, archiveDir_));
+}
+
+TEST_F(LogArchiveTest,
+       findLogArchivesShouldReturnAnEmptyVectorIfTheDirectoryDoesNotExist) {
+  EXPECT_TRUE(findLogArchives(logPath_, rootPath_ / "missing").empty());
+}
+
+TEST_F(LogArchiveTest, compressLogSegmentShouldReplaceTheSegmentWithAZip) {
+  const auto segment = writeSegment(0);
+
+  const auto archive = compressLogSegment(segment);
+
+  EXPECT_FALSE(std::filesystem::exists(segment));
+  ASSERT_TRUE(std::filesystem::exists(archive));
+  EXPECT_EQ(".zip", archive.extension().u8string());
+  EXPECT_LT(0, std::filesystem::file_size(archive));
+}
+
+TEST_F(LogArchiveTest, pruneLogArchivesShouldDeleteTheOldestFiles) {
+  const auto first = writeSegment(0);
+  const auto second = writeSegment(1);
+  const auto third = writeSegment(2);
+
+  EXPECT_EQ(1, pruneLogArchives(logPath_, archiveDir_, 2));
+
+  EXPECT_FALSE(std::filesystem::exists(first));
+  EXPECT_TRUE(std::filesystem::exists(second));
+  EXPECT_TRUE(std::filesystem::exists(third));
+}
+
+TEST_F(LogArchiveTest, pruneLogArchivesShouldDeleteAllFilesIfMaxCountIsZero) {
+  writeSegment(0);
+  writeSegment(1);
+
+  EXPECT_EQ(2, pruneLogArchives(logPath_, archiveDir_, 0));
+  EXPECT_TRUE(findLogArchives(logPath_, archiveDir_).empty());
+}
+
+TEST_F(LogArchiveTest, rotateShouldMoveTheLogFileIntoTheArchiveDirectory) {
+  write(logPath_, "content");
+
+  LogArchiver archiver(logPath_, archiveDir_, 5);
+  EXPECT_TRUE(archiver.rotate());
+  archiver.stop();
+
+  EXPECT_FALSE(std::filesystem::exists(logPath_));
+  EXPECT_EQ(1, findLogArchives(logPath_, archiveDir_).size());
+}
+
+TEST_F(LogArchiveTest, rotateShouldDoNothingIfTheLogFileDoesNotExist) {
+  LogArchiver archiver(logPath_, archiveDir_, 5);
+  EXPECT_TRUE(archiver.rotate());
+  archiver.stop();
+
+  EXPECT_TRUE(findLogArchives(logPath_, archiveDir_).empty());
+}
+
+TEST_F(LogArchiveTest, rotateShouldDoNothingIfTheLogFileIsEmpty) {
+  write(logPath_, "");
+
+  LogArchiver archiver(logPath_, archiveDir_, 5);
+  EXPECT_TRUE(archiver.rotate());
+  archiver.stop();
+
+  EXPECT_TRUE(std::filesystem::exists(logPath_));
+  EXPECT_TRUE(findLogArchives(logPath_, archiveDir_).empty());
+}
+}
+
+#endif
@@ -70,6 +70,12 @@ TEST(LootPaths, getLogPathShouldUseLootDataPath) {
   EXPECT_EQ(paths.getLootDataPath() / "LOOTDebugLog.txt", paths.getLogPath());
 }
 
+TEST(LootPaths, getLogArchivePathShouldUseLootDataPath) {
+  LootPaths paths("", "");
+
+  EXPECT_EQ(paths.getLootDataPath() / "logs", paths.getLogArchivePath());
+}
+
 TEST(LootPaths, getPreludePathShouldUseLootDataPath) {
   LootPaths paths("", "");
 
@@ -77,6 +83,27 @@ TEST(LootPaths, getPreludePathShouldUseLootDataPath) {
             paths.getPreludePath());
 }
 
+TEST(LootPaths, getGameInstallsCachePathShouldUseLootDataPath) {
+  LootPaths paths("", "");
+
+  EXPECT_EQ(paths.getLootDataPath() / "game_installs.toml",
+            paths.getGameInstallsCachePath());
+}
+
+TEST(LootPaths, getUpdateCheckCachePathShouldUseLootDataPath) {
+  LootPaths paths("", "");
+
+  EXPECT_EQ(paths.getLootDataPath() / "update_check.toml",
+            paths.getUpdateCheckCachePath());
+}
+
+TEST(LootPaths, getPerformanceHistoryPathShouldUseLootDataPath) {
+  LootPaths paths("", "");
+
+  EXPECT_EQ(paths.getLootDataPath() / "performance_history.bin",
+            paths.getPerformanceHistoryPath());
+}
+
 TEST(LootPaths,
      constructorShouldSetAppPathToExecutableDirectoryIfGivenPathIsEmpty) {
   LootPaths paths("", "");
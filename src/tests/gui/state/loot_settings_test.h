@@ -43,7 +43,7 @@ namespace test {
 class LootSettingsTest : public CommonGameTestFixture {
 protected:
   LootSettingsTest() :
-      CommonGameTestFixture(GameId::tes5),
+      CommonGameTestFixture(GameId::tes5, FixtureFiles::sharedSnapshot),
       settingsFile_(lootDataPath / "settings_.toml"),
       unicodeSettingsFile_(lootDataPath / "Andr\xc3\xa9_settings_.toml"),
       gitRepoPath_(getTempPath()) {}
@@ -87,8 +87,19 @@ TEST_F(LootSettingsTest, defaultConstructorShouldSetDefaultValues) {
   EXPECT_FALSE(settings_.isDebugLoggingEnabled());
   EXPECT_TRUE(settings_.isMasterlistUpdateBeforeSortEnabled());
   EXPECT_TRUE(settings_.isLootUpdateCheckEnabled());
+  EXPECT_FALSE(settings_.isAutoRefreshEnabled());
+  EXPECT_FALSE(settings_.isSpeculativeSortEnabled());
+  EXPECT_FALSE(settings_.isPreviousGamePreloadEnabled());
+  EXPECT_FALSE(settings_.isPluginRecordDataReleaseEnabled());
+  EXPECT_EQ(0, settings_.getBackupCompressionLevel());
+  EXPECT_EQ(1, settings_.getMaxResidentGames());
+  EXPECT_EQ(0, settings_.getMaxWorkerThreads());
+  EXPECT_EQ(10, settings_.getBackupRetention().maxCount);
+  EXPECT_EQ(0, settings_.getBackupRetention().maxTotalSizeMiB);
+  EXPECT_EQ(0, settings_.getBackupRetention().maxAgeDays);
   EXPECT_EQ("auto", settings_.getGame());
   EXPECT_EQ("auto", settings_.getLastGame());
+  EXPECT_TRUE(settings_.getPreviousGame().empty());
   EXPECT_TRUE(settings_.getLastVersion().empty());
   EXPECT_EQ("en", settings_.getLanguage());
   EXPECT_EQ("default", settings_.getTheme());
@@ -102,7 +113,10 @@ TEST_F(LootSettingsTest, defaultConstructorShouldSetDefaultValues) {
   EXPECT_FALSE(settings_.getFilters().hideMessagelessPlugins);
   EXPECT_EQ("https://raw.githubusercontent.com/loot/prelude/v0.21/prelude.yaml",
             settings_.getPreludeSource());
+  EXPECT_TRUE(settings_.getSharedDownloadCachePath().empty());
+  EXPECT_TRUE(settings_.getRunMetricsPath().empty());
   EXPECT_TRUE(settings_.getGameSettings().empty());
+  EXPECT_TRUE(settings_.getXboxGamingRootPaths().empty());
 
   auto actualLanguages = settings_.getLanguages();
   EXPECT_EQ(19, actualLanguages.size());
@@ -136,12 +150,22 @@ TEST_F(LootSettingsTest, loadingShouldReadFromATomlFile) {
   out << "enableDebugLogging = true" << endl
       << "updateMasterlist = true" << endl
       << "enableLootUpdateCheck = false" << endl
+      << "enableAutoRefresh = true" << endl
+      << "enableSpeculativeSort = true" << endl
+      << "enablePreviousGamePreload = true" << endl
+      << "releasePluginRecordData = true" << endl
+      << "backupCompressionLevel = 6" << endl
+      << "maxResidentGames = 3" << endl
+      << "maxWorkerThreads = 4" << endl
       << "game = \"Oblivion\"" << endl
       << "lastGame = \"Skyrim\"" << endl
+      << "previousGame = \"Fallout4\"" << endl
       << "language = \"fr\"" << endl
       << "theme = \"dark\"" << endl
       << "lastVersion = \"0.7.1\"" << endl
       << "preludeSource = \"../prelude.yaml\"" << endl
+      << "sharedDownloadCachePath = \"../cache\"" << endl
+      << "runMetricsPath = \"../metrics.jsonl\"" << endl
       << endl
       << "[window]" << endl
       << "top = 1" << endl
@@ -165,6 +189,11 @@ TEST_F(LootSettingsTest, loadingShouldReadFromATomlFile) {
       << "[filters]" << endl
       << "hideBashTags = false" << endl
       << "hideCRCs = true" << endl
+      << endl
+      << "[backupRetention]" << endl
+      << "maxCount = 3" << endl
+      << "maxTotalSizeMiB = 100" << endl
+      << "maxAgeDays = 30" << endl
       << "[[languages]]" << endl
       << "locale = \"en\"" << endl
       << "name = \"English\"" << endl;
@@ -175,12 +204,24 @@ TEST_F(LootSettingsTest, loadingShouldReadFromATomlFile) {
   EXPECT_TRUE(settings_.isDebugLoggingEnabled());
   EXPECT_TRUE(settings_.isMasterlistUpdateBeforeSortEnabled());
   EXPECT_FALSE(settings_.isLootUpdateCheckEnabled());
+  EXPECT_TRUE(settings_.isAutoRefreshEnabled());
+  EXPECT_TRUE(settings_.isSpeculativeSortEnabled());
+  EXPECT_TRUE(settings_.isPreviousGamePreloadEnabled());
+  EXPECT_TRUE(settings_.isPluginRecordDataReleaseEnabled());
+  EXPECT_EQ(6, settings_.getBackupCompressionLevel());
+  EXPECT_EQ(3, settings_.getMaxResidentGames());
+  EXPECT_EQ(4, settings_.getMaxWorkerThreads());
   EXPECT_EQ("Oblivion", settings_.getGame());
   EXPECT_EQ("Skyrim", settings_.getLastGame());
+  EXPECT_EQ("Fallout4", settings_.getPreviousGame());
   EXPECT_EQ("0.7.1", settings_.getLastVersion());
   EXPECT_EQ("fr", settings_.getLanguage());
   EXPECT_EQ("dark", settings_.getTheme());
   EXPECT_EQ("../prelude.yaml", settings_.getPreludeSource());
+  EXPECT_EQ(std::filesystem::u8path("../cache"),
+            settings_.getSharedDownloadCachePath());
+  EXPECT_EQ(std::filesystem::u8path("../metrics.jsonl"),
+            settings_.getRunMetricsPath());
 
   ASSERT_TRUE(settings_.getMainWindowPosition().has_value());
   EXPECT_EQ(1, settings_.getMainWindowPosition().value().top);
@@ -201,11 +242,107 @@ TEST_F(LootSettingsTest, loadingShouldReadFromATomlFile) {
   EXPECT_FALSE(settings_.getFilters().hideBashTags);
   EXPECT_TRUE(settings_.getFilters().hideCRCs);
 
+  EXPECT_EQ(3, settings_.getBackupRetention().maxCount);
+  EXPECT_EQ(100, settings_.getBackupRetention().maxTotalSizeMiB);
+  EXPECT_EQ(30, settings_.getBackupRetention().maxAgeDays);
+
   EXPECT_EQ(1, settings_.getLanguages().size());
   EXPECT_EQ(LootSettings::Language({"en", "English"}),
             settings_.getLanguages()[0]);
 }
 
+TEST_F(LootSettingsTest, loadingShouldClampTheBackupCompressionLevel) {
+  std::ofstream out(settingsFile_);
+  out << "backupCompressionLevel = 12" << std::endl;
+  out.close();
+
+  settings_.load(settingsFile_);
+
+  EXPECT_EQ(9, settings_.getBackupCompressionLevel());
+}
+
+TEST_F(LootSettingsTest, loadingShouldClampTheMaxResidentGames) {
+  std::ofstream out(settingsFile_);
+  out << "maxResidentGames = -1" << std::endl;
+  out.close();
+
+  settings_.load(settingsFile_);
+
+  EXPECT_EQ(0, settings_.getMaxResidentGames());
+}
+
+TEST_F(LootSettingsTest, loadingShouldClampTheMaxWorkerThreads) {
+  std::ofstream out(settingsFile_);
+  out << "maxWorkerThreads = 1000" << std::endl;
+  out.close();
+
+  settings_.load(settingsFile_);
+
+  EXPECT_EQ(LootSettings::MAX_WORKER_THREADS,
+            settings_.getMaxWorkerThreads());
+}
+
+TEST_F(LootSettingsTest, loadingShouldClampNegativeLogRotationValuesToZero) {
+  std::ofstream out(settingsFile_);
+  out << "[logRotation]" << std::endl
+      << "maxFileSizeMiB = -1" << std::endl
+      << "maxArchives = -2" << std::endl;
+  out.close();
+
+  settings_.load(settingsFile_);
+
+  EXPECT_EQ(0, settings_.getLogRotation().maxFileSizeMiB);
+  EXPECT_EQ(0, settings_.getLogRotation().maxArchives);
+}
+
+TEST_F(LootSettingsTest, logLevelsShouldBeLoadedAndSaved) {
+  std::ofstream out(settingsFile_);
+  out << "[logLevels]" << std::endl
+      << "sorting = \"trace\"" << std::endl
+      << "network = \"warning\"" << std::endl;
+  out.close();
+
+  settings_.load(settingsFile_);
+
+  const std::map<std::string, std::string> expected{{"network", "warning"},
+                                                    {"sorting", "trace"}};
+  EXPECT_EQ(expected, settings_.getLogLevels());
+
+  settings_.save(settingsFile_);
+
+  LootSettings settings;
+  settings.load(settingsFile_);
+
+  EXPECT_EQ(expected, settings.getLogLevels());
+}
+
+TEST_F(LootSettingsTest, downloadMirrorsShouldBeLoadedAndSaved) {
+  std::ofstream out(settingsFile_);
+  out << "[downloadMirrors]" << std::endl
+      << "\"https://example.com/a.yaml\" = "
+      << "[\"https://mirror1.example.com/a.yaml\", "
+      << "\"https://mirror2.example.com/a.yaml\"]" << std::endl;
+  out.close();
+
+  settings_.load(settingsFile_);
+
+  const std::vector<std::string> expected{
+      "https://mirror1.example.com/a.yaml",
+      "https://mirror2.example.com/a.yaml"};
+  EXPECT_EQ(expected,
+            settings_.getDownloadMirrors("https://example.com/a.yaml"));
+  EXPECT_TRUE(
+      settings_.getDownloadMirrors("https://example.com/b.yaml").empty());
+
+  settings_.save(settingsFile_);
+
+  LootSettings settings;
+  settings.load(settingsFile_);
+
+  EXPECT_EQ(expected,
+            settings.getDownloadMirrors("https://example.com/a.yaml"));
+}
+
 TEST_F(LootSettingsTest, loadingShouldMapGameIds) {
   using std::endl;
   std::ofstream out(settingsFile_);
@@ -1366,6 +1503,50 @@ TEST_F(LootSettingsTest,
   EXPECT_EQ(expectedSource, settings_.getPreludeSource());
 }
 
+TEST_F(LootSettingsTest,
+       loadingTomlShouldNotMigrateRepoSettingsIfTheSettingsVersionIsCurrent) {
+  using std::endl;
+  std::ofstream out(settingsFile_);
+  out << "settingsVersion = 1" << endl
+      << "preludeRepo = \"https://github.com/my-forks/prelude-test.git\""
+      << endl
+      << "preludeBranch = \"custom\"" << endl
+      << "[[games]]" << endl
+      << "gameId = \"Skyrim\"" << endl
+      << "folder = \"Skyrim\"" << endl
+      << "repo = \"https://github.com/my-forks/skyrim.git\"" << endl
+      << "branch = \"custom\"";
+  out.close();
+
+  settings_.load(settingsFile_);
+
+  EXPECT_EQ(getDefaultPreludeSource(), settings_.getPreludeSource());
+  ASSERT_EQ(1, settings_.getGameSettings().size());
+  EXPECT_EQ(GameSettings(GameId::tes5, "Skyrim").MasterlistSource(),
+            settings_.getGameSettings()[0].MasterlistSource());
+}
+
+TEST_F(LootSettingsTest,
+       checkSettingsFileShouldWarnIfRepoSettingsCannotBeMigrated) {
+  std::ofstream out(settingsFile_);
+  out << "preludeRepo = \"https://example.com/loot/prelude-test.git\"";
+  out.close();
+
+  EXPECT_EQ(1, checkSettingsFile(settingsFile_).size());
+}
+
+TEST_F(
+    LootSettingsTest,
+    checkSettingsFileShouldNotCheckRepoSettingsIfTheSettingsVersionIsCurrent) {
+  using std::endl;
+  std::ofstream out(settingsFile_);
+  out << "settingsVersion = 1" << endl
+      << "preludeRepo = \"https://example.com/loot/prelude-test.git\"";
+  out.close();
+
+  EXPECT_TRUE(checkSettingsFile(settingsFile_).empty());
+}
+
 TEST_F(LootSettingsTest, loadingShouldSkipGameIfGameFolderIsNotPresent) {
   using std::endl;
   std::ofstream out(settingsFile_);
@@ -1458,11 +1639,23 @@ TEST_F(LootSettingsTest, saveShouldWriteSettingsToPassedTomlFile) {
   settings_.enableDebugLogging(true);
   settings_.enableMasterlistUpdateBeforeSort(true);
   settings_.enableLootUpdateCheck(false);
+  settings_.enableAutoRefresh(true);
+  settings_.enableSpeculativeSort(true);
+  settings_.enablePreviousGamePreload(true);
+  settings_.enablePluginRecordDataRelease(true);
+  settings_.setBackupCompressionLevel(9);
+  settings_.setMaxResidentGames(2);
+  settings_.setMaxWorkerThreads(6);
+  settings_.storeBackupRetention({5, 200, 60});
+  settings_.storeLogRotation({20, 3});
   settings_.setDefaultGame(game);
   settings_.storeLastGame(lastGame);
+  settings_.storePreviousGame("Fallout4");
   settings_.setLanguage(language);
   settings_.setTheme(theme);
   settings_.setPreludeSource(preludeSource);
+  settings_.setSharedDownloadCachePath("../cache");
+  settings_.setRunMetricsPath("../metrics.jsonl");
 
   settings_.storeMainWindowPosition(windowPosition);
   settings_.storeGroupsEditorWindowPosition(groupsEditorWindowPosition);
@@ -1477,11 +1670,28 @@ TEST_F(LootSettingsTest, saveShouldWriteSettingsToPassedTomlFile) {
   EXPECT_TRUE(settings.isDebugLoggingEnabled());
   EXPECT_TRUE(settings.isMasterlistUpdateBeforeSortEnabled());
   EXPECT_FALSE(settings.isLootUpdateCheckEnabled());
+  EXPECT_TRUE(settings.isAutoRefreshEnabled());
+  EXPECT_TRUE(settings.isSpeculativeSortEnabled());
+  EXPECT_TRUE(settings.isPreviousGamePreloadEnabled());
+  EXPECT_TRUE(settings.isPluginRecordDataReleaseEnabled());
+  EXPECT_EQ(9, settings.getBackupCompressionLevel());
+  EXPECT_EQ(2, settings.getMaxResidentGames());
+  EXPECT_EQ(6, settings.getMaxWorkerThreads());
+  EXPECT_EQ(5, settings.getBackupRetention().maxCount);
+  EXPECT_EQ(200, settings.getBackupRetention().maxTotalSizeMiB);
+  EXPECT_EQ(60, settings.getBackupRetention().maxAgeDays);
+  EXPECT_EQ(20, settings.getLogRotation().maxFileSizeMiB);
+  EXPECT_EQ(3, settings.getLogRotation().maxArchives);
   EXPECT_EQ(game, settings.getGame());
   EXPECT_EQ(lastGame, settings.getLastGame());
+  EXPECT_EQ("Fallout4", settings.getPreviousGame());
   EXPECT_EQ(language, settings.getLanguage());
   EXPECT_EQ(theme, settings.getTheme());
   EXPECT_EQ(preludeSource, settings.getPreludeSource());
+  EXPECT_EQ(std::filesystem::u8path("../cache"),
+            settings.getSharedDownloadCachePath());
+  EXPECT_EQ(std::filesystem::u8path("../metrics.jsonl"),
+            settings.getRunMetricsPath());
 
   ASSERT_TRUE(settings_.getMainWindowPosition().has_value());
   EXPECT_EQ(1, settings_.getMainWindowPosition().value().top);
@@ -1523,6 +1733,112 @@ TEST_F(LootSettingsTest, saveShouldWriteNonAsciiPathsAsUtf8) {
   EXPECT_NE(std::string::npos, contents.find(u8"non\u00C1sciiGameLocalPath"));
 }
 
+TEST_F(LootSettingsTest, saveShouldRoundTripXboxGamingRootPaths) {
+  using std::filesystem::u8path;
+  const std::vector<std::filesystem::path> paths{
+      u8path("C:\\XboxGames"), u8path(u8"D:\\non\u00C1sciiXboxGames")};
+  settings_.storeXboxGamingRootPaths(paths);
+  settings_.save(settingsFile_);
+
+  LootSettings settings;
+  settings.load(settingsFile_);
+
+  EXPECT_EQ(paths, settings.getXboxGamingRootPaths());
+}
+
+TEST_F(LootSettingsTest, saveShouldWriteTheCurrentSettingsVersion) {
+  settings_.save(settingsFile_);
+
+  std::ifstream in(settingsFile_);
+  std::stringstream buffer;
+  buffer << in.rdbuf();
+
+  EXPECT_NE(std::string::npos, buffer.str().find("settingsVersion = 1"));
+}
+
+TEST_F(LootSettingsTest, saveShouldNotLeaveATemporaryFileBehind) {
+  settings_.save(settingsFile_);
+
+  auto tempPath = settingsFile_;
+  tempPath += ".tmp";
+
+  EXPECT_TRUE(std::filesystem::exists(settingsFile_));
+  EXPECT_FALSE(std::filesystem::exists(tempPath));
+}
+
+TEST_F(LootSettingsTest, saveShouldNotWriteToTheFileIfNothingHasChanged) {
+  settings_.save(settingsFile_);
+  const auto writeTime = std::filesystem::last_write_time(settingsFile_);
+
+  // Replace the file's content without changing its write time, so that
+  // a second write can be detected.
+  std::ofstream out(settingsFile_);
+  out << "marker = true";
+  out.close();
+  std::filesystem::last_write_time(settingsFile_, writeTime);
+
+  settings_.save(settingsFile_);
+
+  std::ifstream in(settingsFile_);
+  std::stringstream buffer;
+  buffer << in.rdbuf();
+  EXPECT_EQ("marker = true", buffer.str());
+}
+
+TEST_F(LootSettingsTest, saveShouldWriteToTheFileIfASettingHasChanged) {
+  settings_.save(settingsFile_);
+
+  settings_.storeLastGame("Fallout3");
+  settings_.save(settingsFile_);
+
+  LootSettings settings;
+  settings.load(settingsFile_);
+
+  EXPECT_EQ("Fallout3", settings.getLastGame());
+}
+
+TEST_F(LootSettingsTest,
+       saveShouldWriteToTheFileIfItHasBeenChangedSinceItWasLastSaved) {
+  settings_.storeLastGame("Fallout3");
+  settings_.save(settingsFile_);
+  const auto writeTime = std::filesystem::last_write_time(settingsFile_);
+
+  std::ofstream out(settingsFile_);
+  out << "lastGame = \"Oblivion\"";
+  out.close();
+  std::filesystem::last_write_time(settingsFile_,
+                                   writeTime - std::chrono::seconds(10));
+
+  settings_.save(settingsFile_);
+
+  LootSettings settings;
+  settings.load(settingsFile_);
+
+  EXPECT_EQ("Fallout3", settings.getLastGame());
+}
+
+TEST_F(LootSettingsTest,
+       saveShouldNotWriteToTheFileIfItIsUnchangedSinceItWasLoaded) {
+  settings_.storeLastGame("Fallout3");
+  settings_.save(settingsFile_);
+
+  LootSettings settings;
+  settings.load(settingsFile_);
+  const auto writeTime = std::filesystem::last_write_time(settingsFile_);
+
+  std::ofstream out(settingsFile_, std::ios::app);
+  out << "\n# marker";
+  out.close();
+  std::filesystem::last_write_time(settingsFile_, writeTime);
+
+  settings.save(settingsFile_);
+
+  std::ifstream in(settingsFile_);
+  std::stringstream buffer;
+  buffer << in.rdbuf();
+  EXPECT_NE(std::string::npos, buffer.str().find("# marker"));
+}
+
 TEST_F(LootSettingsTest, storeGameSettingsShouldReplaceExistingGameSettings) {
   ASSERT_EQ(0, settings_.getGameSettings().size());
 
@@ -0,0 +1,202 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_PERFORMANCE_HISTORY_TEST
+#define LOOT_TESTS_GUI_STATE_PERFORMANCE_HISTORY_TEST
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "gui/state/performance_history.h"
+#include "tests/common_game_test_fixture.h"
+
+namespace loot::test {
+PerformanceRecord createPerformanceRecord(const std::string& gameFolderName,
+                                          PerformanceMetric metric,
+                                          std::chrono::milliseconds duration) {
+  PerformanceRecord record;
+  record.recordedAt =
+      std::chrono::system_clock::time_point(std::chrono::seconds(1000));
+  record.gameFolderName = gameFolderName;
+  record.metric = metric;
+  record.duration = duration;
+  record.pluginCount = 42;
+
+  return record;
+}
+
+class PerformanceHistoryTest : public ::testing::Test {
+public:
+  PerformanceHistoryTest() :
+      rootPath_(getTempPath()),
+      historyPath_(rootPath_ / "performance_history.bin") {}
+
+protected:
+  void SetUp() override { std::filesystem::create_directories(rootPath_); }
+
+  void TearDown() override { std::filesystem::remove_all(rootPath_); }
+
+  const std::filesystem::path rootPath_;
+  const std::filesystem::path historyPath_;
+};
+
+TEST_F(PerformanceHistoryTest,
+       loadPerformanceHistoryShouldReturnAnEmptyVectorIfTheFileDoesNotExist) {
+  EXPECT_TRUE(LoadPerformanceHistory(historyPath_).empty());
+}
+
+TEST_F(PerformanceHistoryTest,
+       loadPerformanceHistoryShouldThrowIfTheFileIsInvalid) {
+  std::ofstream out(historyPath_);
+  out << "invalid";
+  out.close();
+
+  EXPECT_THROW(LoadPerformanceHistory(historyPath_), std::runtime_error);
+}
+
+TEST_F(PerformanceHistoryTest,
+       loadPerformanceHistoryShouldReturnTheSavedRecords) {
+  const std::vector<PerformanceRecord> expected{
+      createPerformanceRecord(
+          "Skyrim", PerformanceMetric::sort, std::chrono::milliseconds(100)),
+      createPerformanceRecord("Oblivion",
+                              PerformanceMetric::overlapQuery,
+                              std::chrono::milliseconds(200)),
+      createPerformanceRecord("Skyrim",
+                              PerformanceMetric::startup,
+                              std::chrono::milliseconds(300)),
+  };
+  SavePerformanceHistory(historyPath_, expected);
+
+  const auto records = LoadPerformanceHistory(historyPath_);
+
+  ASSERT_EQ(expected.size(), records.size());
+  for (size_t i = 0; i < records.size(); i += 1) {
+    EXPECT_EQ(expected[i].recordedAt, records[i].recordedAt);
+    EXPECT_EQ(expected[i].gameFolderName, records[i].gameFolderName);
+    EXPECT_EQ(expected[i].metric, records[i].metric);
+    EXPECT_EQ(expected[i].duration, records[i].duration);
+    EXPECT_EQ(expected[i].pluginCount, records[i].pluginCount);
+  }
+}
+
+TEST_F(PerformanceHistoryTest,
+       appendPerformanceRecordShouldDropTheOldestRecordsWhenFull) {
+  for (size_t i = 0; i < PERFORMANCE_HISTORY_MAX_RECORDS + 1; i += 1) {
+    AppendPerformanceRecord(
+        historyPath_,
+        createPerformanceRecord("Skyrim",
+                                PerformanceMetric::sort,
+                                std::chrono::milliseconds(i)));
+  }
+
+  const auto records = LoadPerformanceHistory(historyPath_);
+
+  ASSERT_EQ(PERFORMANCE_HISTORY_MAX_RECORDS, records.size());
+  EXPECT_EQ(std::chrono::milliseconds(1), records.front().duration);
+  EXPECT_EQ(std::chrono::milliseconds(PERFORMANCE_HISTORY_MAX_RECORDS),
+            records.back().duration);
+}
+
+TEST_F(PerformanceHistoryTest,
+       appendPerformanceRecordShouldReplaceAnInvalidFile) {
+  std::ofstream out(historyPath_);
+  out << "invalid";
+  out.close();
+
+  AppendPerformanceRecord(
+      historyPath_,
+      createPerformanceRecord(
+          "Skyrim", PerformanceMetric::sort, std::chrono::milliseconds(1)));
+
+  EXPECT_EQ(1, LoadPerformanceHistory(historyPath_).size());
+}
+
+TEST(GetPerformanceSeries, shouldGroupRecordsByGameAndMetricInOrder) {
+  const std::vector<PerformanceRecord> records{
+      createPerformanceRecord(
+          "Skyrim", PerformanceMetric::sort, std::chrono::milliseconds(1)),
+      createPerformanceRecord(
+          "Oblivion", PerformanceMetric::sort, std::chrono::milliseconds(2)),
+      createPerformanceRecord(
+          "Skyrim", PerformanceMetric::startup, std::chrono::milliseconds(3)),
+      createPerformanceRecord(
+          "Skyrim", PerformanceMetric::sort, std::chrono::milliseconds(4)),
+  };
+
+  const auto series = GetPerformanceSeries(records);
+
+  ASSERT_EQ(3, series.size());
+  EXPECT_EQ("Oblivion", series[0].gameFolderName);
+  EXPECT_EQ("Skyrim", series[1].gameFolderName);
+  EXPECT_EQ(PerformanceMetric::startup, series[1].metric);
+  EXPECT_EQ("Skyrim", series[2].gameFolderName);
+  EXPECT_EQ(PerformanceMetric::sort, series[2].metric);
+  ASSERT_EQ(2, series[2].records.size());
+  EXPECT_EQ(std::chrono::milliseconds(1), series[2].records[0].duration);
+  EXPECT_EQ(std::chrono::milliseconds(4), series[2].records[1].duration);
+}
+
+TEST(GetRelativeDuration, shouldReturnNulloptForTheFirstRecord) {
+  PerformanceSeries series;
+  series.records.push_back(createPerformanceRecord(
+      "Skyrim", PerformanceMetric::sort, std::chrono::milliseconds(1)));
+
+  EXPECT_FALSE(GetRelativeDuration(series, 0).has_value());
+}
+
+TEST(GetRelativeDuration, shouldCompareAgainstTheMedianOfEarlierRecords) {
+  PerformanceSeries series;
+  for (const auto duration : {100, 300, 200, 400}) {
+    series.records.push_back(
+        createPerformanceRecord("Skyrim",
+                                PerformanceMetric::sort,
+                                std::chrono::milliseconds(duration)));
+  }
+
+  const auto relativeDuration = GetRelativeDuration(series, 3);
+
+  ASSERT_TRUE(relativeDuration.has_value());
+  EXPECT_DOUBLE_EQ(2.0, relativeDuration.value());
+}
+
+TEST(GetRelativeDuration, shouldUseTheMeanOfTheMiddleTwoEarlierDurations) {
+  PerformanceSeries series;
+  for (const auto duration : {100, 300, 400}) {
+    series.records.push_back(
+        createPerformanceRecord("Skyrim",
+                                PerformanceMetric::sort,
+                                std::chrono::milliseconds(duration)));
+  }
+
+  const auto relativeDuration = GetRelativeDuration(series, 2);
+
+  ASSERT_TRUE(relativeDuration.has_value());
+  EXPECT_DOUBLE_EQ(2.0, relativeDuration.value());
+}
+}
+
+#endif
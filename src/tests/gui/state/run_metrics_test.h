@@ -0,0 +1,165 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_RUN_METRICS_TEST
+#define LOOT_TESTS_GUI_STATE_RUN_METRICS_TEST
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "gui/state/run_metrics.h"
+#include "tests/common_game_test_fixture.h"
+
+namespace loot::test {
+RunMetricsRecord createRunMetricsRecord(PerformanceMetric operation) {
+  RunMetricsRecord record;
+  record.recordedAt =
+      std::chrono::system_clock::time_point(std::chrono::seconds(1000));
+  record.lootVersion = "0.22.4";
+  record.gameFolderName = "Skyrim";
+  record.operation = operation;
+  record.duration = std::chrono::milliseconds(1500);
+  record.pluginCount = 42;
+
+  return record;
+}
+
+std::vector<std::string> readLines(const std::filesystem::path& filePath) {
+  std::ifstream in(filePath);
+  std::vector<std::string> lines;
+  std::string line;
+  while (std::getline(in, line)) {
+    lines.push_back(line);
+  }
+
+  return lines;
+}
+
+TEST(GetMetricId, shouldReturnADistinctIdForEachMetric) {
+  EXPECT_EQ("startup", GetMetricId(PerformanceMetric::startup));
+  EXPECT_EQ("sort", GetMetricId(PerformanceMetric::sort));
+  EXPECT_EQ("masterlistUpdate",
+            GetMetricId(PerformanceMetric::masterlistUpdate));
+  EXPECT_EQ("overlapQuery", GetMetricId(PerformanceMetric::overlapQuery));
+  EXPECT_EQ("refresh", GetMetricId(PerformanceMetric::refresh));
+}
+
+TEST(ToJsonLine, shouldWriteAllFieldsOfTheRecord) {
+  auto record = createRunMetricsRecord(PerformanceMetric::sort);
+  record.peakMemoryBytes = 1024;
+  record.cacheStats = {CacheStats{"Card sizes", 3, 1},
+                       CacheStats{"Empty", 0, 0}};
+
+  OperationTiming timing;
+  timing.operationName = "Game::SortPlugins";
+  timing.count = 2;
+  timing.totalDuration = std::chrono::microseconds(2500);
+  timing.maxDuration = std::chrono::microseconds(2000);
+  record.operationTimings = {timing};
+
+  EXPECT_EQ(
+      R"({"recordedAt":"1970-01-01T00:16:40Z","lootVersion":"0.22.4",)"
+      R"("game":"Skyrim","operation":"sort","durationMs":1500,)"
+      R"("pluginCount":42,"peakMemoryBytes":1024,"caches":[)"
+      R"({"name":"Card sizes","hits":3,"misses":1,"hitRate":0.7500},)"
+      R"({"name":"Empty","hits":0,"misses":0,"hitRate":0.0000}],)"
+      R"("timings":[{"name":"Game::SortPlugins","count":2,"totalMs":2,)"
+      R"("maxMs":2}]})",
+      ToJsonLine(record));
+}
+
+TEST(ToJsonLine, shouldWriteNullIfThePeakMemoryUseIsUnknown) {
+  const auto record = createRunMetricsRecord(PerformanceMetric::startup);
+
+  const auto json = ToJsonLine(record);
+
+  EXPECT_NE(std::string::npos, json.find(R"("peakMemoryBytes":null,)"));
+  EXPECT_NE(std::string::npos, json.find(R"("caches":[],"timings":[])"));
+}
+
+TEST(ToJsonLine, shouldEscapeStrings) {
+  auto record = createRunMetricsRecord(PerformanceMetric::startup);
+  record.gameFolderName = "a\"b\\c\nd";
+
+  const auto json = ToJsonLine(record);
+
+  EXPECT_NE(std::string::npos, json.find(R"("game":"a\"b\\c\u000ad",)"));
+}
+
+class RunMetricsWriterTest : public ::testing::Test {
+public:
+  RunMetricsWriterTest() :
+      rootPath_(getTempPath()),
+      metricsPath_(rootPath_ / "metrics" / "loot.jsonl") {}
+
+protected:
+  void TearDown() override { std::filesystem::remove_all(rootPath_); }
+
+  const std::filesystem::path rootPath_;
+  const std::filesystem::path metricsPath_;
+};
+
+TEST_F(RunMetricsWriterTest, stopShouldWriteQueuedRecordsAsJsonLines) {
+  const auto first = createRunMetricsRecord(PerformanceMetric::startup);
+  const auto second = createRunMetricsRecord(PerformanceMetric::sort);
+
+  RunMetricsWriter writer(metricsPath_);
+  writer.append(first);
+  writer.append(second);
+  writer.stop();
+
+  const auto lines = readLines(metricsPath_);
+  ASSERT_EQ(2, lines.size());
+  EXPECT_EQ(ToJsonLine(first), lines[0]);
+  EXPECT_EQ(ToJsonLine(second), lines[1]);
+}
+
+TEST_F(RunMetricsWriterTest, shouldAppendToAnExistingFile) {
+  std::filesystem::create_directories(metricsPath_.parent_path());
+  std::ofstream(metricsPath_) << "existing" << std::endl;
+
+  const auto record = createRunMetricsRecord(PerformanceMetric::refresh);
+  {
+    RunMetricsWriter writer(metricsPath_);
+    writer.append(record);
+  }
+
+  const auto lines = readLines(metricsPath_);
+  ASSERT_EQ(2, lines.size());
+  EXPECT_EQ("existing", lines[0]);
+  EXPECT_EQ(ToJsonLine(record), lines[1]);
+}
+
+TEST_F(RunMetricsWriterTest, shouldDiscardRecordsAppendedAfterStopping) {
+  RunMetricsWriter writer(metricsPath_);
+  writer.stop();
+  writer.append(createRunMetricsRecord(PerformanceMetric::startup));
+
+  EXPECT_FALSE(std::filesystem::exists(metricsPath_));
+}
+}
+
+#endif
@@ -0,0 +1,119 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_THREAD_POOL_TEST
+#define LOOT_TESTS_GUI_STATE_THREAD_POOL_TEST
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+
+#include "gui/state/thread_pool.h"
+
+namespace loot {
+namespace test {
+TEST(parallelFor, shouldCallTheFunctionOnceForEachIndex) {
+  std::vector<int> calls(100, 0);
+
+  parallelFor(calls.size(), [&](size_t index) { calls[index] += 1; });
+
+  for (const auto count : calls) {
+    EXPECT_EQ(1, count);
+  }
+}
+
+TEST(parallelFor, shouldNotRunMoreCallsAtOnceThanTheMaxConcurrency) {
+  std::atomic<int> running{0};
+  std::atomic<int> maxRunning{0};
+
+  parallelFor(
+      50,
+      [&](size_t) {
+        const auto current = ++running;
+        auto previousMax = maxRunning.load();
+        while (current > previousMax &&
+               !maxRunning.compare_exchange_weak(previousMax, current)) {
+        }
+        --running;
+      },
+      2);
+
+  EXPECT_LE(maxRunning.load(), 2);
+}
+
+TEST(parallelFor, shouldRethrowAnExceptionThrownByTheFunction) {
+  EXPECT_THROW(parallelFor(10,
+                           [](size_t index) {
+                             if (index == 5) {
+                               throw std::runtime_error("error");
+                             }
+                           }),
+               std::runtime_error);
+}
+
+TEST(parallelFor, shouldBeSafeToNestCalls) {
+  std::atomic<size_t> total{0};
+
+  parallelFor(8, [&](size_t) {
+    parallelFor(8, [&](size_t index) { total += index; });
+  });
+
+  EXPECT_EQ(8 * 28, total.load());
+}
+
+TEST(parallelTransform, shouldWriteOutputsInInputOrder) {
+  std::vector<int> input{1, 2, 3, 4, 5};
+  std::vector<int> output(input.size());
+
+  parallelTransform(input.begin(), input.end(), output.begin(), [](int value) {
+    return value * 2;
+  });
+
+  EXPECT_EQ(std::vector<int>({2, 4, 6, 8, 10}), output);
+}
+
+TEST(runConcurrently, shouldRunAllTheGivenFunctions) {
+  std::atomic<int> calls{0};
+
+  runConcurrently({[&]() { ++calls; }, [&]() { ++calls; }, [&]() { ++calls; }});
+
+  EXPECT_EQ(3, calls.load());
+}
+
+TEST(runConcurrently, shouldRethrowTheExceptionFromTheFirstFunctionToFail) {
+  try {
+    runConcurrently({[]() {},
+                     []() { throw std::runtime_error("first"); },
+                     []() { throw std::logic_error("second"); }});
+    FAIL();
+  } catch (const std::runtime_error& e) {
+    EXPECT_STREQ("first", e.what());
+  }
+}
+}
+}
+
+#endif
@@ -0,0 +1,127 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_UPDATE_CHECK_CACHE_TEST
+#define LOOT_TESTS_GUI_STATE_UPDATE_CHECK_CACHE_TEST
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "gui/state/update_check_cache.h"
+#include "tests/common_game_test_fixture.h"
+
+namespace loot::test {
+class UpdateCheckCacheTest : public ::testing::Test {
+public:
+  UpdateCheckCacheTest() :
+      rootPath_(getTempPath()), cachePath_(rootPath_ / "update_check.toml") {}
+
+protected:
+  void SetUp() override { std::filesystem::create_directories(rootPath_); }
+
+  void TearDown() override { std::filesystem::remove_all(rootPath_); }
+
+  static UpdateCheckCache createCache() {
+    UpdateCheckCache cache;
+    cache.revision = "abc123";
+    cache.checkedAt =
+        std::chrono::system_clock::time_point(std::chrono::seconds(1000));
+    cache.isUpdateAvailable = true;
+    cache.latestReleaseETag = "W/\"etag\"";
+    cache.latestReleaseLastModified = "Wed, 01 Jan 2025 00:00:00 GMT";
+
+    return cache;
+  }
+
+  const std::filesystem::path rootPath_;
+  const std::filesystem::path cachePath_;
+};
+
+TEST_F(UpdateCheckCacheTest,
+       loadUpdateCheckCacheShouldReturnNulloptIfTheCacheDoesNotExist) {
+  EXPECT_FALSE(LoadUpdateCheckCache(cachePath_, "abc123").has_value());
+}
+
+TEST_F(UpdateCheckCacheTest,
+       loadUpdateCheckCacheShouldReturnNulloptIfTheCacheIsInvalid) {
+  std::ofstream out(cachePath_);
+  out << "revision = 'abc123'";
+  out.close();
+
+  EXPECT_FALSE(LoadUpdateCheckCache(cachePath_, "abc123").has_value());
+}
+
+TEST_F(UpdateCheckCacheTest,
+       loadUpdateCheckCacheShouldReturnNulloptIfTheRevisionIsDifferent) {
+  SaveUpdateCheckCache(cachePath_, createCache());
+
+  EXPECT_FALSE(LoadUpdateCheckCache(cachePath_, "def456").has_value());
+}
+
+TEST_F(UpdateCheckCacheTest,
+       loadUpdateCheckCacheShouldReturnTheSavedCacheIfTheRevisionIsTheSame) {
+  const auto expected = createCache();
+  SaveUpdateCheckCache(cachePath_, expected);
+
+  const auto cache = LoadUpdateCheckCache(cachePath_, expected.revision);
+
+  ASSERT_TRUE(cache.has_value());
+  EXPECT_EQ(expected.revision, cache.value().revision);
+  EXPECT_EQ(expected.checkedAt, cache.value().checkedAt);
+  EXPECT_EQ(expected.isUpdateAvailable, cache.value().isUpdateAvailable);
+  EXPECT_EQ(expected.latestReleaseETag, cache.value().latestReleaseETag);
+  EXPECT_EQ(expected.latestReleaseLastModified,
+            cache.value().latestReleaseLastModified);
+}
+
+TEST(IsUpdateCheckCacheFresh, shouldBeTrueIfTheCacheIsYoungerThanTheMaxAge) {
+  UpdateCheckCache cache;
+  cache.checkedAt = std::chrono::system_clock::now();
+
+  EXPECT_TRUE(IsUpdateCheckCacheFresh(cache, cache.checkedAt));
+  EXPECT_TRUE(IsUpdateCheckCacheFresh(
+      cache,
+      cache.checkedAt + UPDATE_CHECK_CACHE_MAX_AGE - std::chrono::seconds(1)));
+}
+
+TEST(IsUpdateCheckCacheFresh, shouldBeFalseIfTheCacheIsAtLeastTheMaxAge) {
+  UpdateCheckCache cache;
+  cache.checkedAt = std::chrono::system_clock::now();
+
+  EXPECT_FALSE(IsUpdateCheckCacheFresh(
+      cache, cache.checkedAt + UPDATE_CHECK_CACHE_MAX_AGE));
+}
+
+TEST(IsUpdateCheckCacheFresh, shouldBeFalseIfTheCacheIsFromTheFuture) {
+  UpdateCheckCache cache;
+  cache.checkedAt = std::chrono::system_clock::now();
+
+  EXPECT_FALSE(IsUpdateCheckCacheFresh(
+      cache, cache.checkedAt - std::chrono::seconds(1)));
+}
+}
+
+#endif
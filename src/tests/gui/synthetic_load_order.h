@@ -0,0 +1,469 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_SYNTHETIC_LOAD_ORDER
+#define LOOT_TESTS_GUI_SYNTHETIC_LOAD_ORDER
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gui/state/game/game_settings.h"
+#include "tests/gui/test_helpers.h"
+
+namespace loot {
+namespace test {
+// Generates a load order of any size for a game that uses textfile-based load
+// ordering, along with masterlist and userlist metadata for it. The generated
+// plugins are a mix of masters, light plugins, medium plugins, ghosted
+// plugins, copies of the testing plugins (which have overlapping records) and
+// header-only plugins that have several masters.
+//
+// Every plugin is assigned a group that's no earlier than the groups of the
+// plugins that load before it, so the generated load order can be sorted
+// without encountering a cycle.
+class SyntheticLoadOrder {
+public:
+  SyntheticLoadOrder(GameId gameId, size_t pluginCount) :
+      settings_(gameId, "") {
+    if (!isSupportedGameType(settings_.Type())) {
+      throw std::invalid_argument(
+          "Synthetic load orders can only be generated for games that use "
+          "textfile-based load ordering");
+    }
+
+    createPlugins(pluginCount);
+  }
+
+  // Writes the plugins, load order and active plugins files, and the game
+  // executable if the game needs one to be detected.
+  void write(const std::filesystem::path& gamePath,
+             const std::filesystem::path& localPath) const {
+    const auto dataPath =
+        gamePath / std::filesystem::u8path(settings_.PluginsFolderName());
+    std::filesystem::create_directories(dataPath);
+    std::filesystem::create_directories(localPath);
+
+    const auto executable = getGameExecutable();
+    if (!executable.empty()) {
+      touch(gamePath / executable);
+    }
+
+    for (const auto& plugin : plugins_) {
+      writePlugin(dataPath, plugin);
+    }
+
+    writeLoadOrder(localPath);
+  }
+
+  void writeMasterlist(const std::filesystem::path& path) const {
+    std::ofstream out(path);
+
+    out << "groups:" << std::endl << "  - name: default" << std::endl;
+    for (size_t i = 1; i < GROUP_COUNT; i += 1) {
+      out << "  - name: '" << getGroupName(i) << "'" << std::endl
+          << "    after: ['" << getGroupName(i - 1) << "']" << std::endl;
+    }
+
+    out << "globals:" << std::endl
+        << "  - type: say" << std::endl
+        << "    content: 'A synthetic global message.'" << std::endl
+        << "    condition: 'file(\"" << settings_.Master() << "\")'"
+        << std::endl
+        << "plugins:" << std::endl;
+
+    for (size_t i = 0; i < plugins_.size(); i += 1) {
+      const auto& plugin = plugins_.at(i);
+      const auto hasMessage = i % MASTERLIST_MESSAGE_INTERVAL == 0;
+      if (plugin.group == 0 && !hasMessage) {
+        continue;
+      }
+
+      out << "  - name: '" << plugin.filename << "'" << std::endl;
+
+      if (plugin.group != 0) {
+        out << "    group: '" << getGroupName(plugin.group) << "'"
+            << std::endl;
+      }
+
+      if (hasMessage) {
+        // Alternate between conditions that are true and false, and that
+        // check files and active plugins.
+        out << "    tag: [Relev, Delev]" << std::endl
+            << "    msg:" << std::endl
+            << "      - type: say" << std::endl
+            << "        content: 'A synthetic note.'" << std::endl
+            << "        condition: 'file(\"" << plugins_.front().filename
+            << "\")'" << std::endl
+            << "      - type: warn" << std::endl
+            << "        content: 'A synthetic warning.'" << std::endl
+            << "        condition: 'active(\"" << plugin.filename
+            << "\") and not file(\"Synthetic Missing.esp\")'" << std::endl
+            << "      - type: error" << std::endl
+            << "        content: 'A synthetic error.'" << std::endl
+            << "        condition: 'file(\"Synthetic Missing.esp\")'"
+            << std::endl;
+      }
+    }
+  }
+
+  void writeUserlist(const std::filesystem::path& path) const {
+    std::ofstream out(path);
+
+    out << "groups:" << std::endl
+        << "  - name: '" << USER_GROUP_NAME << "'" << std::endl
+        << "    after: ['" << getGroupName(GROUP_COUNT - 1) << "']"
+        << std::endl
+        << "plugins:" << std::endl;
+
+    // The last plugins are put in a group that loads after all the masterlist
+    // groups, and some of the others are made to load after the non-master
+    // plugin that precedes them.
+    const auto userGroupStart =
+        plugins_.size() - plugins_.size() / USER_GROUP_DIVISOR;
+    for (size_t i = 1; i < plugins_.size(); i += 1) {
+      const auto& plugin = plugins_.at(i);
+      const auto& previous = plugins_.at(i - 1);
+      const auto isInUserGroup = i >= userGroupStart && !plugin.isMaster;
+      const auto hasLoadAfter = i % USERLIST_ENTRY_INTERVAL == 0 &&
+                                !plugin.isMaster && !previous.isMaster;
+      if (!isInUserGroup && !hasLoadAfter) {
+        continue;
+      }
+
+      out << "  - name: '" << plugin.filename << "'" << std::endl;
+
+      if (isInUserGroup) {
+        out << "    group: '" << USER_GROUP_NAME << "'" << std::endl;
+      }
+
+      if (hasLoadAfter) {
+        out << "    after: ['" << previous.filename << "']" << std::endl
+            << "    msg:" << std::endl
+            << "      - type: say" << std::endl
+            << "        content: 'A synthetic user note.'" << std::endl
+            << "        condition: 'active(\"" << previous.filename << "\")'"
+            << std::endl;
+      }
+    }
+  }
+
+  std::vector<std::string> loadOrder() const {
+    std::vector<std::string> loadOrder;
+    for (const auto& plugin : plugins_) {
+      loadOrder.push_back(plugin.filename);
+    }
+
+    return loadOrder;
+  }
+
+  std::vector<std::string> activePlugins() const {
+    std::vector<std::string> activePlugins;
+    for (const auto& plugin : plugins_) {
+      if (plugin.isActive) {
+        activePlugins.push_back(plugin.filename);
+      }
+    }
+
+    return activePlugins;
+  }
+
+  std::vector<std::string> ghostedPlugins() const {
+    std::vector<std::string> ghostedPlugins;
+    for (const auto& plugin : plugins_) {
+      if (plugin.isGhosted) {
+        ghostedPlugins.push_back(plugin.filename);
+      }
+    }
+
+    return ghostedPlugins;
+  }
+
+private:
+  struct Plugin {
+    std::string filename;
+    // If empty, a plugin that only has a header is written.
+    std::string sourceFilename;
+    std::vector<std::string> masters;
+    uint32_t flags{0};
+    bool isMaster{false};
+    bool isActive{false};
+    bool isGhosted{false};
+    size_t group{0};
+  };
+
+  // This is relative to the current working directory, as for the tests.
+  static constexpr const char* SOURCE_PLUGINS_PATH = "./Skyrim/Data";
+  static constexpr const char* USER_GROUP_NAME = "Synthetic User Group";
+  static constexpr size_t GROUP_COUNT = 4;
+  static constexpr size_t MAX_ACTIVE_FULL_PLUGINS = 250;
+  static constexpr size_t MAX_MASTERS = 3;
+  static constexpr size_t GHOST_INTERVAL = 7;
+  static constexpr size_t MASTERLIST_MESSAGE_INTERVAL = 10;
+  static constexpr size_t USERLIST_ENTRY_INTERVAL = 25;
+  static constexpr size_t USER_GROUP_DIVISOR = 50;
+  static constexpr uint32_t MASTER_FLAG = 0x1;
+  static constexpr uint32_t MEDIUM_FLAG = 0x400;
+
+  GameSettings settings_;
+  std::vector<Plugin> plugins_;
+
+  static bool isSupportedGameType(GameType gameType) {
+    return gameType == GameType::tes5 || gameType == GameType::tes5se ||
+           gameType == GameType::tes5vr || gameType == GameType::fo4 ||
+           gameType == GameType::fo4vr || gameType == GameType::starfield;
+  }
+
+  static bool isLightPlugin(const std::string& filename) {
+    static constexpr const char* LIGHT_PLUGIN_EXTENSION = ".esl";
+    return filename.size() >= 4 &&
+           filename.compare(filename.size() - 4, 4, LIGHT_PLUGIN_EXTENSION) ==
+               0;
+  }
+
+  static std::string getGroupName(size_t index) {
+    return index == 0 ? "default"
+                      : "Synthetic Group " + std::to_string(index);
+  }
+
+  static void appendUint16(std::string& buffer, uint16_t value) {
+    buffer.push_back(static_cast<char>(value & 0xFF));
+    buffer.push_back(static_cast<char>((value >> 8) & 0xFF));
+  }
+
+  static void appendUint32(std::string& buffer, uint32_t value) {
+    for (size_t i = 0; i < sizeof(value); i += 1) {
+      buffer.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+  }
+
+  static void appendSubrecord(std::string& buffer,
+                              const char* type,
+                              const std::string& data) {
+    buffer.append(type, 4);
+    appendUint16(buffer, static_cast<uint16_t>(data.size()));
+    buffer.append(data);
+  }
+
+  static std::string getPluginHeader(const Plugin& plugin) {
+    // This is high enough to satisfy all the supported games' minimum header
+    // versions.
+    static constexpr float HEADER_VERSION = 1.71f;
+    uint32_t version = 0;
+    std::memcpy(&version, &HEADER_VERSION, sizeof(version));
+
+    std::string hedr;
+    appendUint32(hedr, version);
+    appendUint32(hedr, 0);
+    appendUint32(hedr, 0x800);
+
+    std::string subrecords;
+    appendSubrecord(subrecords, "HEDR", hedr);
+    appendSubrecord(subrecords, "CNAM", std::string("LOOT\0", 5));
+    for (const auto& master : plugin.masters) {
+      appendSubrecord(subrecords, "MAST", master + '\0');
+      appendSubrecord(subrecords, "DATA", std::string(8, '\0'));
+    }
+
+    std::string header("TES4");
+    appendUint32(header, static_cast<uint32_t>(subrecords.size()));
+    appendUint32(header, plugin.flags);
+    appendUint32(header, 0);
+    appendUint32(header, 0);
+    appendUint16(header, 44);
+    appendUint16(header, 0);
+    header.append(subrecords);
+
+    return header;
+  }
+
+  static void writePlugin(const std::filesystem::path& dataPath,
+                          const Plugin& plugin) {
+    auto path = dataPath / std::filesystem::u8path(plugin.filename);
+    if (plugin.isGhosted) {
+      path += ".ghost";
+    }
+
+    if (!plugin.sourceFilename.empty()) {
+      std::filesystem::copy_file(
+          std::filesystem::path(SOURCE_PLUGINS_PATH) / plugin.sourceFilename,
+          path);
+      return;
+    }
+
+    std::ofstream out(path, std::ios_base::binary);
+    out << getPluginHeader(plugin);
+  }
+
+  bool supportsLightPlugins() const {
+    const auto gameType = settings_.Type();
+    return gameType == GameType::tes5se || gameType == GameType::fo4 ||
+           gameType == GameType::starfield;
+  }
+
+  std::string getGameExecutable() const {
+    switch (settings_.Type()) {
+      case GameType::tes5:
+        return "TESV.exe";
+      case GameType::tes5se:
+        return "SkyrimSE.exe";
+      case GameType::tes5vr:
+        return "SkyrimVR.exe";
+      case GameType::fo4:
+        return "Fallout4.exe";
+      case GameType::fo4vr:
+        return "Fallout4VR.exe";
+      default:
+        return "";
+    }
+  }
+
+  void createPlugins(size_t pluginCount) {
+    std::vector<Plugin> masters{
+        Plugin{settings_.Master(), "Blank.esm", {}, 0, true},
+        Plugin{"Blank.esm", "Blank.esm", {}, 0, true},
+    };
+    std::vector<Plugin> nonMasters{
+        Plugin{"Blank.esp", "Blank.esp"},
+    };
+
+    // Copies of these testing plugins override records in Blank.esm or depend
+    // on Blank.esp, so they overlap with one another and add edges to the
+    // plugin graph.
+    static const std::vector<std::string> sourceFilenames{
+        "Blank - Master Dependent.esp",
+        "Blank - Different.esp",
+        "Blank - Plugin Dependent.esp",
+        "Blank.esp",
+    };
+
+    for (size_t i = 0; i < pluginCount; i += 1) {
+      const auto basename = "Synthetic Plugin " + std::to_string(i);
+      Plugin plugin;
+
+      switch (i % 10) {
+        case 0:
+        case 1:
+          plugin.filename = basename + ".esm";
+          plugin.flags = MASTER_FLAG;
+          break;
+        case 2:
+          if (supportsLightPlugins()) {
+            plugin.filename = basename + ".esl";
+          } else {
+            plugin.filename = basename + ".esm";
+            plugin.flags = MASTER_FLAG;
+          }
+          break;
+        case 3:
+          plugin.filename = basename + ".esp";
+          if (settings_.Type() == GameType::starfield) {
+            plugin.flags = MEDIUM_FLAG;
+          }
+          break;
+        default:
+          plugin.filename = basename + ".esp";
+          if (i % 2 == 0) {
+            plugin.sourceFilename =
+                sourceFilenames.at((i / 2) % sourceFilenames.size());
+          }
+          break;
+      }
+
+      plugin.isMaster =
+          (plugin.flags & MASTER_FLAG) != 0 || isLightPlugin(plugin.filename);
+
+      if (plugin.sourceFilename.empty()) {
+        // Depend on up to MAX_MASTERS of the masters created so far.
+        for (size_t j = 0; j < MAX_MASTERS && j < masters.size(); j += 1) {
+          const auto index = (i + j * 7) % masters.size();
+          const auto& master = masters.at(index).filename;
+          if (std::find(plugin.masters.begin(),
+                        plugin.masters.end(),
+                        master) == plugin.masters.end()) {
+            plugin.masters.push_back(master);
+          }
+        }
+      }
+
+      // Masters always load before non-masters, so ghost only non-masters
+      // so that their masters are always present unghosted.
+      plugin.isGhosted = !plugin.isMaster && i % GHOST_INTERVAL == 0;
+
+      if (plugin.isMaster) {
+        masters.push_back(plugin);
+      } else {
+        nonMasters.push_back(plugin);
+      }
+    }
+
+    plugins_ = masters;
+    plugins_.insert(plugins_.end(), nonMasters.begin(), nonMasters.end());
+
+    size_t activeFullPlugins = 0;
+    for (size_t i = 0; i < plugins_.size(); i += 1) {
+      auto& plugin = plugins_.at(i);
+      if (isLightPlugin(plugin.filename)) {
+        plugin.isActive = true;
+      } else if (activeFullPlugins < MAX_ACTIVE_FULL_PLUGINS) {
+        plugin.isActive = true;
+        activeFullPlugins += 1;
+      }
+
+      plugin.group = i * GROUP_COUNT / plugins_.size();
+    }
+  }
+
+  void writeLoadOrder(const std::filesystem::path& localPath) const {
+    std::ofstream activePlugins(localPath / "Plugins.txt");
+    for (const auto& plugin : plugins_) {
+      if (settings_.Type() == GameType::tes5) {
+        if (!plugin.isActive) {
+          continue;
+        }
+      } else if (plugin.isActive) {
+        activePlugins << '*';
+      }
+
+      activePlugins << plugin.filename << std::endl;
+    }
+
+    if (settings_.Type() == GameType::tes5) {
+      std::ofstream loadOrder(localPath / "loadorder.txt");
+      for (const auto& plugin : plugins_) {
+        loadOrder << plugin.filename << std::endl;
+      }
+    }
+  }
+};
+}
+}
+
+#endif
@@ -0,0 +1,81 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_TAG_SET_TEST
+#define LOOT_TESTS_GUI_TAG_SET_TEST
+
+#include <gtest/gtest.h>
+
+#include "gui/tag_set.h"
+
+namespace loot::test {
+TEST(TagSet, defaultConstructorShouldCreateAnEmptySet) {
+  EXPECT_TRUE(TagSet().empty());
+}
+
+TEST(TagSet, addShouldAddATagToTheSet) {
+  TagSet tags;
+  tags.Add("Delev", false);
+
+  EXPECT_FALSE(tags.empty());
+}
+
+TEST(TagSet, getConflictsShouldReturnTagsAddedByOneSetAndRemovedByTheOther) {
+  const TagSet tags1({Tag("Relev"), Tag("Delev"), Tag("C.Water", false)});
+  const TagSet tags2({Tag("C.Water"), Tag("Delev", false), Tag("Relev")});
+
+  const std::vector<std::string> expected{"C.Water", "Delev"};
+
+  EXPECT_EQ(expected, tags1.GetConflicts(tags2));
+  EXPECT_EQ(expected, tags2.GetConflicts(tags1));
+}
+
+TEST(TagSet, getConflictsShouldReturnAnEmptyVectorIfThereAreNoConflicts) {
+  const TagSet tags1({Tag("Delev"), Tag("Relev", false)});
+  const TagSet tags2({Tag("Delev"), Tag("C.Water", false)});
+
+  EXPECT_TRUE(tags1.GetConflicts(tags2).empty());
+  EXPECT_TRUE(tags1.GetConflicts(TagSet()).empty());
+}
+
+TEST(TagSet, getConflictsShouldBeCaseSensitive) {
+  const TagSet tags1({Tag("Delev")});
+  const TagSet tags2({Tag("delev", false)});
+
+  EXPECT_TRUE(tags1.GetConflicts(tags2).empty());
+}
+
+TEST(TagSet, getConflictsShouldIgnoreDuplicateTags) {
+  TagSet tags1;
+  tags1.Add("Delev", true);
+  tags1.Add("Delev", true);
+  const TagSet tags2({InternedString("Relev")},
+                     {InternedString("Delev"), InternedString("Delev")});
+
+  EXPECT_EQ(std::vector<std::string>{"Delev"}, tags1.GetConflicts(tags2));
+}
+}
+
+#endif
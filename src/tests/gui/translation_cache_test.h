@@ -0,0 +1,71 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_TRANSLATION_CACHE_TEST
+#define LOOT_TESTS_GUI_TRANSLATION_CACHE_TEST
+
+#include <gtest/gtest.h>
+
+#include <boost/locale.hpp>
+
+#include "gui/translation_cache.h"
+
+namespace loot {
+namespace test {
+class TranslationCacheTest : public ::testing::Test {
+protected:
+  TranslationCacheTest() {
+    boost::locale::generator gen;
+    std::locale::global(gen("en.UTF-8"));
+  }
+
+  void TearDown() override { ClearTranslationCache(); }
+};
+
+TEST_F(TranslationCacheTest,
+       translateCachedShouldReturnTheMessageIfItHasNoTranslation) {
+  EXPECT_EQ("Location", TranslateCached("Location"));
+}
+
+TEST_F(TranslationCacheTest,
+       translateCachedShouldReturnTheSameStringForTheSameMessage) {
+  const auto message = "Location";
+
+  EXPECT_EQ(&TranslateCached(message), &TranslateCached(message));
+}
+
+TEST_F(TranslationCacheTest,
+       translateCachedShouldTranslateAgainAfterTheCacheIsCleared) {
+  const auto message = "Location";
+  TranslateCached(message);
+
+  ClearTranslationCache();
+
+  EXPECT_EQ("Location", TranslateCached(message));
+}
+}
+}
+
+#endif
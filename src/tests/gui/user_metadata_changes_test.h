@@ -0,0 +1,123 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_USER_METADATA_CHANGES_TEST
+#define LOOT_TESTS_GUI_USER_METADATA_CHANGES_TEST
+
+#include <gtest/gtest.h>
+
+#include "gui/user_metadata_changes.h"
+
+namespace loot::test {
+TEST(UserMetadataChanges, shouldBeEmptyByDefault) {
+  EXPECT_TRUE(UserMetadataChanges().isEmpty());
+}
+
+TEST(UserMetadataChanges, shouldNotBeEmptyIfTheGroupHasChanged) {
+  UserMetadataChanges changes;
+  changes.isGroupChanged = true;
+
+  EXPECT_FALSE(changes.isEmpty());
+}
+
+TEST(UserMetadataChanges, shouldNotBeEmptyIfAListHasChanged) {
+  UserMetadataChanges changes;
+  changes.tags = std::vector<Tag>();
+
+  EXPECT_FALSE(changes.isEmpty());
+}
+
+TEST(ApplyUserMetadataChanges,
+     shouldReturnNameOnlyMetadataIfThereIsNoMetadataOrChanges) {
+  UserMetadataChanges changes;
+  changes.pluginName = "Blank.esp";
+
+  const auto metadata = ApplyUserMetadataChanges(std::nullopt, changes);
+
+  EXPECT_EQ("Blank.esp", metadata.GetName());
+  EXPECT_TRUE(metadata.HasNameOnly());
+}
+
+TEST(ApplyUserMetadataChanges, shouldReplaceOnlyTheFieldsThatHaveChanged) {
+  PluginMetadata existing("Blank.esp");
+  existing.SetGroup("group1");
+  existing.SetLoadAfterFiles({File("Blank.esm")});
+  existing.SetTags({Tag("Relev")});
+
+  UserMetadataChanges changes;
+  changes.pluginName = "Blank.esp";
+  changes.tags = std::vector<Tag>({Tag("Delev")});
+  changes.requirements = std::vector<File>({File("Blank - Different.esm")});
+
+  const auto metadata = ApplyUserMetadataChanges(existing, changes);
+
+  EXPECT_EQ("Blank.esp", metadata.GetName());
+  EXPECT_EQ(std::optional<std::string>("group1"), metadata.GetGroup());
+  EXPECT_EQ(std::vector<File>({File("Blank.esm")}),
+            metadata.GetLoadAfterFiles());
+  EXPECT_EQ(std::vector<File>({File("Blank - Different.esm")}),
+            metadata.GetRequirements());
+  EXPECT_EQ(std::vector<Tag>({Tag("Delev")}), metadata.GetTags());
+}
+
+TEST(ApplyUserMetadataChanges, shouldClearAListThatHasChangedToBeEmpty) {
+  PluginMetadata existing("Blank.esp");
+  existing.SetTags({Tag("Relev")});
+
+  UserMetadataChanges changes;
+  changes.pluginName = "Blank.esp";
+  changes.tags = std::vector<Tag>();
+
+  const auto metadata = ApplyUserMetadataChanges(existing, changes);
+
+  EXPECT_TRUE(metadata.HasNameOnly());
+}
+
+TEST(ApplyUserMetadataChanges, shouldUnsetTheGroupIfItHasChangedToNullopt) {
+  PluginMetadata existing("Blank.esp");
+  existing.SetGroup("group1");
+
+  UserMetadataChanges changes;
+  changes.pluginName = "Blank.esp";
+  changes.isGroupChanged = true;
+
+  const auto metadata = ApplyUserMetadataChanges(existing, changes);
+
+  EXPECT_FALSE(metadata.GetGroup().has_value());
+}
+
+TEST(ApplyUserMetadataChanges, shouldSetTheGroupIfItHasChanged) {
+  UserMetadataChanges changes;
+  changes.pluginName = "Blank.esp";
+  changes.isGroupChanged = true;
+  changes.group = "group2";
+
+  const auto metadata = ApplyUserMetadataChanges(std::nullopt, changes);
+
+  EXPECT_EQ(std::optional<std::string>("group2"), metadata.GetGroup());
+}
+}
+
+#endif
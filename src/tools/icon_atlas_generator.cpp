@@ -0,0 +1,110 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2022    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+// Pre-renders LOOT's icons into an atlas that is embedded in LOOT's
+// resources, so that IconFactory doesn't need to rasterise their SVGs at
+// runtime for the most common sizes and device pixel ratios.
+//
+// Usage: loot_icon_atlas_generator <resources dir> <output image path>
+//            <output index path> <icon path>...
+//
+// Icon paths are relative to the resources directory, as they are in
+// resources.qrc.
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "gui/qt/icon_atlas.h"
+
+namespace {
+// The extent that IconFactory uses for each icon's natural size, which is
+// always rendered with a device pixel ratio of 1.
+constexpr int NATURAL_EXTENT = 48;
+
+// The small icon size of Qt's built-in styles, and the height of the
+// attribute icons in plugin cards.
+constexpr int SCALED_EXTENTS[] = {16, 18};
+
+// Common display scaling factors.
+constexpr qreal PIXEL_RATIOS[] = {1.0, 1.25, 1.5, 1.75, 2.0};
+}
+
+int main(int argc, char* argv[]) {
+  QCoreApplication app(argc, argv);
+
+  const auto arguments = QCoreApplication::arguments();
+  if (arguments.size() < 5) {
+    std::cerr << "Usage: loot_icon_atlas_generator <resources dir> <output "
+                 "image path> <output index path> <icon path>..."
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const QDir resourcesDir(arguments.at(1));
+  const auto& imagePath = arguments.at(2);
+  const auto& indexPath = arguments.at(3);
+
+  std::vector<loot::IconAtlasEntry> entries;
+  for (qsizetype i = 4; i < arguments.size(); i += 1) {
+    const auto& relativePath = arguments.at(i);
+    const auto filePath = resourcesDir.filePath(relativePath);
+    const auto resourcePath = ":/" + relativePath;
+
+    const auto addEntry = [&](int extent, qreal pixelRatio) {
+      auto image = loot::rasteriseIcon(filePath, extent, pixelRatio);
+      if (image.isNull()) {
+        std::cerr << "Failed to rasterise " << filePath.toStdString()
+                  << std::endl;
+        return false;
+      }
+
+      entries.push_back(
+          loot::IconAtlasEntry{resourcePath, extent, pixelRatio, image});
+      return true;
+    };
+
+    if (!addEntry(NATURAL_EXTENT, 1.0)) {
+      return EXIT_FAILURE;
+    }
+
+    for (const auto extent : SCALED_EXTENTS) {
+      for (const auto pixelRatio : PIXEL_RATIOS) {
+        if (!addEntry(extent, pixelRatio)) {
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  if (!loot::writeIconAtlas(entries, imagePath, indexPath)) {
+    std::cerr << "Failed to write the icon atlas" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}